@@ -67,6 +67,12 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
       [1])
   ])
 
+  dnl Headers included in libewf/libewf_segment_file_io_handle.c
+  AC_CHECK_HEADERS([errno.h fcntl.h sys/stat.h unistd.h])
+
+  dnl Functions used in libewf/libewf_segment_file_io_handle.c
+  AC_CHECK_FUNCS([fallocate ftruncate open posix_fallocate posix_memalign pread pwrite])
+
   dnl Check for internationalization functions in libewf/libewf_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 ])
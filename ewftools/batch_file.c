@@ -0,0 +1,836 @@
+/*
+ * Batch file, that contains the jobs of a batch acquiry
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "batch_file.h"
+#include "ewftools_libcerror.h"
+
+/* Creates a batch job
+ * Make sure the value batch_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int batch_job_initialize(
+     batch_job_t **batch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_job_initialize";
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*batch_job = memory_allocate_structure(
+	              batch_job_t );
+
+	if( *batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *batch_job,
+	     0,
+	     sizeof( batch_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch job.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *batch_job != NULL )
+	{
+		memory_free(
+		 *batch_job );
+
+		*batch_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a batch job
+ * The device and imaging handle of the job must be freed before
+ * Returns 1 if successful or -1 on error
+ */
+int batch_job_free(
+     batch_job_t **batch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_job_free";
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_job != NULL )
+	{
+		if( ( *batch_job )->source_filename != NULL )
+		{
+			memory_free(
+			 ( *batch_job )->source_filename );
+		}
+		if( ( *batch_job )->target_filename != NULL )
+		{
+			memory_free(
+			 ( *batch_job )->target_filename );
+		}
+		if( ( *batch_job )->evidence_number != NULL )
+		{
+			memory_free(
+			 ( *batch_job )->evidence_number );
+		}
+		if( ( *batch_job )->description != NULL )
+		{
+			memory_free(
+			 ( *batch_job )->description );
+		}
+		memory_free(
+		 *batch_job );
+
+		*batch_job = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets a string of a batch job
+ * An empty string leaves the internal string unset
+ * Returns 1 if successful or -1 on error
+ */
+int batch_job_set_string(
+     batch_job_t *batch_job,
+     const system_character_t *string,
+     size_t string_length,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_job_set_string";
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( system_character_t ) ) - 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal string.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *internal_string != NULL )
+	{
+		memory_free(
+		 *internal_string );
+
+		*internal_string      = NULL;
+		*internal_string_size = 0;
+	}
+	if( string_length > 0 )
+	{
+		*internal_string = system_string_allocate(
+		                    string_length + 1 );
+
+		if( *internal_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create internal string.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     *internal_string,
+		     string,
+		     string_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy string.",
+			 function );
+
+			goto on_error;
+		}
+		( *internal_string )[ string_length ] = 0;
+
+		*internal_string_size = string_length + 1;
+	}
+	return( 1 );
+
+on_error:
+	if( *internal_string != NULL )
+	{
+		memory_free(
+		 *internal_string );
+
+		*internal_string = NULL;
+	}
+	*internal_string_size = 0;
+
+	return( -1 );
+}
+
+/* Creates a batch file
+ * Make sure the value batch_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_initialize(
+     batch_file_t **batch_file,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_file_initialize";
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*batch_file = memory_allocate_structure(
+	               batch_file_t );
+
+	if( *batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *batch_file,
+	     0,
+	     sizeof( batch_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *batch_file != NULL )
+	{
+		memory_free(
+		 *batch_file );
+
+		*batch_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a batch file
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_free(
+     batch_file_t **batch_file,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_file_free";
+	int job_index         = 0;
+	int result            = 1;
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *batch_file != NULL )
+	{
+		for( job_index = 0;
+		     job_index < ( *batch_file )->number_of_jobs;
+		     job_index++ )
+		{
+			if( batch_job_free(
+			     &( ( *batch_file )->jobs[ job_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free job: %d.",
+				 function,
+				 job_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *batch_file );
+
+		*batch_file = NULL;
+	}
+	return( result );
+}
+
+/* Parses a line of a batch file
+ * A line contains the source and target filename and optionally the evidence number
+ * and description of a job, separated by tabs. Empty lines and lines starting with #
+ * are ignored.
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_parse_line(
+     batch_file_t *batch_file,
+     const system_character_t *line,
+     size_t line_length,
+     int line_number,
+     libcerror_error_t **error )
+{
+	batch_job_t *batch_job                = NULL;
+	system_character_t **internal_string  = NULL;
+	static char *function                 = "batch_file_parse_line";
+	size_t *internal_string_size          = NULL;
+	size_t field_start                    = 0;
+	size_t line_index                     = 0;
+	int field_index                       = 0;
+	int job_index                         = 0;
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( line == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid line.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( line_length == 0 )
+	 || ( line[ 0 ] == (system_character_t) '#' ) )
+	{
+		return( 1 );
+	}
+	if( batch_file->number_of_jobs >= BATCH_FILE_MAXIMUM_NUMBER_OF_JOBS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: line: %d exceeds the maximum number of jobs: %d.",
+		 function,
+		 line_number,
+		 BATCH_FILE_MAXIMUM_NUMBER_OF_JOBS );
+
+		return( -1 );
+	}
+	if( batch_job_initialize(
+	     &batch_job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create batch job.",
+		 function );
+
+		goto on_error;
+	}
+	for( line_index = 0;
+	     line_index <= line_length;
+	     line_index++ )
+	{
+		if( ( line_index < line_length )
+		 && ( line[ line_index ] != (system_character_t) '\t' ) )
+		{
+			continue;
+		}
+		switch( field_index )
+		{
+			case 0:
+				internal_string      = &( batch_job->source_filename );
+				internal_string_size = &( batch_job->source_filename_size );
+				break;
+
+			case 1:
+				internal_string      = &( batch_job->target_filename );
+				internal_string_size = &( batch_job->target_filename_size );
+				break;
+
+			case 2:
+				internal_string      = &( batch_job->evidence_number );
+				internal_string_size = &( batch_job->evidence_number_size );
+				break;
+
+			case 3:
+				internal_string      = &( batch_job->description );
+				internal_string_size = &( batch_job->description_size );
+				break;
+
+			default:
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: line: %d contains too many values.",
+				 function,
+				 line_number );
+
+				goto on_error;
+		}
+		if( batch_job_set_string(
+		     batch_job,
+		     &( line[ field_start ] ),
+		     line_index - field_start,
+		     internal_string,
+		     internal_string_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set value: %d of line: %d.",
+			 function,
+			 field_index,
+			 line_number );
+
+			goto on_error;
+		}
+		field_index += 1;
+		field_start  = line_index + 1;
+	}
+	if( ( batch_job->source_filename == NULL )
+	 || ( batch_job->target_filename == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: line: %d is missing a source or target filename.",
+		 function,
+		 line_number );
+
+		goto on_error;
+	}
+	/* Jobs that write the same target would overwrite each other's segment files
+	 */
+	for( job_index = 0;
+	     job_index < batch_file->number_of_jobs;
+	     job_index++ )
+	{
+		if( ( batch_file->jobs[ job_index ]->target_filename_size == batch_job->target_filename_size )
+		 && ( system_string_compare(
+		       batch_file->jobs[ job_index ]->target_filename,
+		       batch_job->target_filename,
+		       batch_job->target_filename_size - 1 ) == 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: target filename of line: %d is already used by job: %d.",
+			 function,
+			 line_number,
+			 job_index );
+
+			goto on_error;
+		}
+	}
+	batch_file->jobs[ batch_file->number_of_jobs ] = batch_job;
+
+	batch_file->number_of_jobs += 1;
+
+	return( 1 );
+
+on_error:
+	if( batch_job != NULL )
+	{
+		batch_job_free(
+		 &batch_job,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the jobs from a batch file
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_read(
+     batch_file_t *batch_file,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t line[ BATCH_FILE_MAXIMUM_LINE_SIZE ];
+
+	FILE *stream          = NULL;
+	static char *function = "batch_file_read";
+	size_t line_length    = 0;
+	int line_number       = 0;
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	stream = file_stream_open_wide(
+	          filename,
+	          _SYSTEM_STRING( FILE_STREAM_OPEN_READ ) );
+#else
+	stream = file_stream_open(
+	          filename,
+	          FILE_STREAM_OPEN_READ );
+#endif
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		return( -1 );
+	}
+	while( 1 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( file_stream_get_string_wide(
+		     stream,
+		     line,
+		     BATCH_FILE_MAXIMUM_LINE_SIZE ) == NULL )
+#else
+		if( file_stream_get_string(
+		     stream,
+		     line,
+		     BATCH_FILE_MAXIMUM_LINE_SIZE ) == NULL )
+#endif
+		{
+			break;
+		}
+		line_number += 1;
+
+		line_length = system_string_length(
+		               line );
+
+		/* A line that fills the buffer without an end of line character does not fit
+		 */
+		if( ( line_length == ( BATCH_FILE_MAXIMUM_LINE_SIZE - 1 ) )
+		 && ( line[ line_length - 1 ] != (system_character_t) '\n' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: line: %d exceeds maximum size.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		while( ( line_length > 0 )
+		    && ( ( line[ line_length - 1 ] == (system_character_t) '\n' )
+		     ||  ( line[ line_length - 1 ] == (system_character_t) '\r' ) ) )
+		{
+			line_length -= 1;
+		}
+		if( batch_file_parse_line(
+		     batch_file,
+		     line,
+		     line_length,
+		     line_number,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to parse line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+	}
+	if( file_stream_close(
+	     stream ) != 0 )
+	{
+		stream = NULL;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch_file->number_of_jobs == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing jobs.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( stream != NULL )
+	{
+		file_stream_close(
+		 stream );
+	}
+	return( -1 );
+}
+
+/* Retrieves the number of jobs
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_get_number_of_jobs(
+     batch_file_t *batch_file,
+     int *number_of_jobs,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_file_get_number_of_jobs";
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of jobs.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_jobs = batch_file->number_of_jobs;
+
+	return( 1 );
+}
+
+/* Retrieves a specific job
+ * Returns 1 if successful or -1 on error
+ */
+int batch_file_get_job_by_index(
+     batch_file_t *batch_file,
+     int job_index,
+     batch_job_t **batch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "batch_file_get_job_by_index";
+
+	if( batch_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( job_index < 0 )
+	 || ( job_index >= batch_file->number_of_jobs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid job index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	*batch_job = batch_file->jobs[ job_index ];
+
+	return( 1 );
+}
+
@@ -0,0 +1,158 @@
+/*
+ * Batch file, that contains the jobs of a batch acquiry
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BATCH_FILE_H )
+#define _BATCH_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "device_handle.h"
+#include "ewftools_libcerror.h"
+#include "imaging_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of jobs in a batch file
+ */
+#define BATCH_FILE_MAXIMUM_NUMBER_OF_JOBS	64
+
+/* The maximum size of a line in a batch file, including the end of line characters
+ */
+#define BATCH_FILE_MAXIMUM_LINE_SIZE		4096
+
+typedef struct batch_job batch_job_t;
+
+struct batch_job
+{
+	/* The source filename
+	 */
+	system_character_t *source_filename;
+
+	/* The source filename size
+	 */
+	size_t source_filename_size;
+
+	/* The target filename
+	 */
+	system_character_t *target_filename;
+
+	/* The target filename size
+	 */
+	size_t target_filename_size;
+
+	/* The evidence number
+	 */
+	system_character_t *evidence_number;
+
+	/* The evidence number size
+	 */
+	size_t evidence_number_size;
+
+	/* The description
+	 */
+	system_character_t *description;
+
+	/* The description size
+	 */
+	size_t description_size;
+
+	/* The device handle, which is not owned by the job
+	 */
+	device_handle_t *device_handle;
+
+	/* The imaging handle, which is not owned by the job
+	 */
+	imaging_handle_t *imaging_handle;
+
+	/* The result of the job
+	 */
+	int result;
+};
+
+typedef struct batch_file batch_file_t;
+
+struct batch_file
+{
+	/* The jobs
+	 */
+	batch_job_t *jobs[ BATCH_FILE_MAXIMUM_NUMBER_OF_JOBS ];
+
+	/* The number of jobs
+	 */
+	int number_of_jobs;
+};
+
+int batch_job_initialize(
+     batch_job_t **batch_job,
+     libcerror_error_t **error );
+
+int batch_job_free(
+     batch_job_t **batch_job,
+     libcerror_error_t **error );
+
+int batch_job_set_string(
+     batch_job_t *batch_job,
+     const system_character_t *string,
+     size_t string_length,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
+     libcerror_error_t **error );
+
+int batch_file_initialize(
+     batch_file_t **batch_file,
+     libcerror_error_t **error );
+
+int batch_file_free(
+     batch_file_t **batch_file,
+     libcerror_error_t **error );
+
+int batch_file_parse_line(
+     batch_file_t *batch_file,
+     const system_character_t *line,
+     size_t line_length,
+     int line_number,
+     libcerror_error_t **error );
+
+int batch_file_read(
+     batch_file_t *batch_file,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int batch_file_get_number_of_jobs(
+     batch_file_t *batch_file,
+     int *number_of_jobs,
+     libcerror_error_t **error );
+
+int batch_file_get_job_by_index(
+     batch_file_t *batch_file,
+     int job_index,
+     batch_job_t **batch_job,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BATCH_FILE_H ) */
+
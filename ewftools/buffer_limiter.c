@@ -0,0 +1,646 @@
+/*
+ * Buffer limiter, that adapts the number of storage media buffers in flight
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "buffer_limiter.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+#include "system_resources.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a buffer limiter
+ * Make sure the value buffer_limiter is referencing, is set to NULL
+ * The maximum number of buffers must be the number of buffers in the storage media buffer queue,
+ * the buffer limiter starts with the minimum number of buffers in flight
+ * Returns 1 if successful or -1 on error
+ */
+int buffer_limiter_initialize(
+     buffer_limiter_t **buffer_limiter,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     stage_profiler_t *stage_profiler,
+     int minimum_number_of_buffers,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "buffer_limiter_initialize";
+	size_t reserved_size  = 0;
+
+	if( buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_limiter != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid buffer limiter value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( minimum_number_of_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid minimum number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_buffers < minimum_number_of_buffers )
+	 || ( (size_t) maximum_number_of_buffers > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( storage_media_buffer_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*buffer_limiter = memory_allocate_structure(
+	                   buffer_limiter_t );
+
+	if( *buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer limiter.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *buffer_limiter,
+	     0,
+	     sizeof( buffer_limiter_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer limiter.",
+		 function );
+
+		memory_free(
+		 *buffer_limiter );
+
+		*buffer_limiter = NULL;
+
+		return( -1 );
+	}
+	reserved_size = sizeof( storage_media_buffer_t * ) * (size_t) maximum_number_of_buffers;
+
+	( *buffer_limiter )->reserved_buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                                     reserved_size );
+
+	if( ( *buffer_limiter )->reserved_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reserved buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *buffer_limiter )->reserved_buffers,
+	     0,
+	     reserved_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reserved buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *buffer_limiter )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	( *buffer_limiter )->storage_media_buffer_queue = storage_media_buffer_queue;
+	( *buffer_limiter )->stage_profiler             = stage_profiler;
+	( *buffer_limiter )->number_of_buffers          = maximum_number_of_buffers;
+	( *buffer_limiter )->minimum_number_of_buffers  = minimum_number_of_buffers;
+	( *buffer_limiter )->maximum_number_of_buffers  = maximum_number_of_buffers;
+	( *buffer_limiter )->adjustment_interval        = BUFFER_LIMITER_ADJUSTMENT_INTERVAL;
+
+	/* All the storage media buffers are in the queue at this point,
+	 * hence reserving them does not block
+	 */
+	if( buffer_limiter_set_number_of_buffers(
+	     *buffer_limiter,
+	     minimum_number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of buffers.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 buffer_limiter,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a buffer limiter
+ * The reserved storage media buffers are released back onto the storage media buffer queue,
+ * hence the buffer limiter must be freed before the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int buffer_limiter_free(
+     buffer_limiter_t **buffer_limiter,
+     libcerror_error_t **error )
+{
+	static char *function = "buffer_limiter_free";
+	int result            = 1;
+
+	if( buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer_limiter != NULL )
+	{
+		if( ( *buffer_limiter )->reserved_buffers != NULL )
+		{
+			while( ( *buffer_limiter )->number_of_reserved_buffers > 0 )
+			{
+				( *buffer_limiter )->number_of_reserved_buffers -= 1;
+
+				if( storage_media_buffer_queue_release_buffer(
+				     ( *buffer_limiter )->storage_media_buffer_queue,
+				     ( *buffer_limiter )->reserved_buffers[ ( *buffer_limiter )->number_of_reserved_buffers ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release reserved storage media buffer: %d.",
+					 function,
+					 ( *buffer_limiter )->number_of_reserved_buffers );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *buffer_limiter )->reserved_buffers );
+		}
+		if( ( *buffer_limiter )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *buffer_limiter )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *buffer_limiter );
+
+		*buffer_limiter = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of storage media buffers that can be in flight
+ * Returns 1 if successful or -1 on error
+ */
+int buffer_limiter_get_number_of_buffers(
+     buffer_limiter_t *buffer_limiter,
+     int *number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "buffer_limiter_get_number_of_buffers";
+
+	if( buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_buffers = buffer_limiter->number_of_buffers;
+
+	if( libcthreads_mutex_release(
+	     buffer_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the number of storage media buffers that can be in flight
+ * Lowering the number reserves free storage media buffers from the queue, which blocks
+ * until enough buffers in flight were released. Raising the number releases reserved
+ * storage media buffers back onto the queue.
+ * Returns 1 if successful or -1 on error
+ */
+int buffer_limiter_set_number_of_buffers(
+     buffer_limiter_t *buffer_limiter,
+     int number_of_buffers,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "buffer_limiter_set_number_of_buffers";
+	int result                                   = 1;
+
+	if( buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer limiter.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers < buffer_limiter->minimum_number_of_buffers )
+	 || ( number_of_buffers > buffer_limiter->maximum_number_of_buffers ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     buffer_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_limiter->number_of_buffers > number_of_buffers )
+	{
+		if( storage_media_buffer_queue_grab_buffer(
+		     buffer_limiter->storage_media_buffer_queue,
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer_limiter->reserved_buffers[ buffer_limiter->number_of_reserved_buffers ] = storage_media_buffer;
+
+		buffer_limiter->number_of_reserved_buffers += 1;
+		buffer_limiter->number_of_buffers          -= 1;
+	}
+	while( ( result == 1 )
+	    && ( buffer_limiter->number_of_buffers < number_of_buffers ) )
+	{
+		storage_media_buffer = buffer_limiter->reserved_buffers[ buffer_limiter->number_of_reserved_buffers - 1 ];
+
+		if( storage_media_buffer_queue_release_buffer(
+		     buffer_limiter->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		buffer_limiter->reserved_buffers[ buffer_limiter->number_of_reserved_buffers - 1 ] = NULL;
+
+		buffer_limiter->number_of_reserved_buffers -= 1;
+		buffer_limiter->number_of_buffers          += 1;
+	}
+	if( libcthreads_mutex_release(
+	     buffer_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Adjusts the number of storage media buffers that can be in flight
+ * The adjustment is based on the read stalls and the in flight queue depth that
+ * the stage profiler sampled since the previous adjustment
+ * This function is called by the reader before grabbing a storage media buffer,
+ * if another reader is adjusting at the same time the adjustment is skipped
+ * Returns 1 if adjusted, 0 if not or -1 on error
+ */
+int buffer_limiter_adjust(
+     buffer_limiter_t *buffer_limiter,
+     libcerror_error_t **error )
+{
+	stage_profiler_stage_t stages[ STAGE_PROFILER_NUMBER_OF_STAGES ];
+	stage_profiler_queue_t queues[ STAGE_PROFILER_NUMBER_OF_QUEUES ];
+
+	static char *function      = "buffer_limiter_adjust";
+	uint64_t average_depth     = 0;
+	uint64_t elapsed_time      = 0;
+	uint64_t number_of_samples = 0;
+	uint64_t number_of_stalls  = 0;
+	int number_of_buffers      = 0;
+	int result                 = 0;
+
+	if( buffer_limiter == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer limiter.",
+		 function );
+
+		return( -1 );
+	}
+	result = libcthreads_mutex_try_grab(
+	          buffer_limiter->mutex,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to try grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = 0;
+
+	if( stage_profiler_get_samples(
+	     buffer_limiter->stage_profiler,
+	     stages,
+	     queues,
+	     &elapsed_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stage profiler samples.",
+		 function );
+
+		goto on_error;
+	}
+	/* Restarting the stage profiler resets its samples
+	 */
+	if( ( elapsed_time < buffer_limiter->previous_elapsed_time )
+	 || ( stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls < buffer_limiter->previous_number_of_stalls )
+	 || ( queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].number_of_samples < buffer_limiter->previous_number_of_samples )
+	 || ( queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].total_depth < buffer_limiter->previous_total_depth ) )
+	{
+		buffer_limiter->previous_elapsed_time      = elapsed_time;
+		buffer_limiter->previous_number_of_stalls  = stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls;
+		buffer_limiter->previous_number_of_samples = queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].number_of_samples;
+		buffer_limiter->previous_total_depth       = queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].total_depth;
+	}
+	number_of_samples = queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].number_of_samples - buffer_limiter->previous_number_of_samples;
+
+	/* Wait for the interval to pass and for at least a buffer to be read since the previous adjustment
+	 */
+	if( ( ( elapsed_time - buffer_limiter->previous_elapsed_time ) >= buffer_limiter->adjustment_interval )
+	 && ( number_of_samples > 0 ) )
+	{
+		number_of_stalls = stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls - buffer_limiter->previous_number_of_stalls;
+		average_depth    = ( queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].total_depth - buffer_limiter->previous_total_depth ) / number_of_samples;
+
+		if( system_resources_get_adaptive_number_of_buffers(
+		     buffer_limiter->number_of_buffers,
+		     buffer_limiter->minimum_number_of_buffers,
+		     buffer_limiter->maximum_number_of_buffers,
+		     number_of_stalls,
+		     average_depth,
+		     &number_of_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine adaptive number of buffers.",
+			 function );
+
+			goto on_error;
+		}
+		buffer_limiter->previous_elapsed_time      = elapsed_time;
+		buffer_limiter->previous_number_of_stalls  = stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls;
+		buffer_limiter->previous_number_of_samples = queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].number_of_samples;
+		buffer_limiter->previous_total_depth       = queues[ STAGE_PROFILER_QUEUE_IN_FLIGHT ].total_depth;
+
+		if( number_of_buffers != buffer_limiter->number_of_buffers )
+		{
+			result = 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     buffer_limiter->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		if( buffer_limiter_set_number_of_buffers(
+		     buffer_limiter,
+		     number_of_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of buffers.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+
+on_error:
+	libcthreads_mutex_release(
+	 buffer_limiter->mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
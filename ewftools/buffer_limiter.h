@@ -0,0 +1,134 @@
+/*
+ * Buffer limiter, that adapts the number of storage media buffers in flight
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BUFFER_LIMITER_H )
+#define _BUFFER_LIMITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The default interval between adjustments in nano seconds
+ */
+#define BUFFER_LIMITER_ADJUSTMENT_INTERVAL	100000000
+
+typedef struct buffer_limiter buffer_limiter_t;
+
+struct buffer_limiter
+{
+	/* The storage media buffer queue, which is not owned by the buffer limiter
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* The stage profiler, which is not owned by the buffer limiter
+	 */
+	stage_profiler_t *stage_profiler;
+
+	/* The storage media buffers that are held back from the storage media buffer queue
+	 */
+	storage_media_buffer_t **reserved_buffers;
+
+	/* The number of reserved storage media buffers
+	 */
+	int number_of_reserved_buffers;
+
+	/* The number of storage media buffers that can be in flight
+	 */
+	int number_of_buffers;
+
+	/* The minimum number of storage media buffers that can be in flight
+	 */
+	int minimum_number_of_buffers;
+
+	/* The maximum number of storage media buffers that can be in flight,
+	 * which is the number of buffers in the storage media buffer queue
+	 */
+	int maximum_number_of_buffers;
+
+	/* The interval between adjustments in nano seconds
+	 */
+	uint64_t adjustment_interval;
+
+	/* The elapsed time of the previous adjustment in nano seconds
+	 */
+	uint64_t previous_elapsed_time;
+
+	/* The number of read stalls at the previous adjustment
+	 */
+	uint64_t previous_number_of_stalls;
+
+	/* The number of in flight queue depth samples at the previous adjustment
+	 */
+	uint64_t previous_number_of_samples;
+
+	/* The sum of the in flight queue depths at the previous adjustment
+	 */
+	uint64_t previous_total_depth;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+int buffer_limiter_initialize(
+     buffer_limiter_t **buffer_limiter,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     stage_profiler_t *stage_profiler,
+     int minimum_number_of_buffers,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error );
+
+int buffer_limiter_free(
+     buffer_limiter_t **buffer_limiter,
+     libcerror_error_t **error );
+
+int buffer_limiter_get_number_of_buffers(
+     buffer_limiter_t *buffer_limiter,
+     int *number_of_buffers,
+     libcerror_error_t **error );
+
+int buffer_limiter_set_number_of_buffers(
+     buffer_limiter_t *buffer_limiter,
+     int number_of_buffers,
+     libcerror_error_t **error );
+
+int buffer_limiter_adjust(
+     buffer_limiter_t *buffer_limiter,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BUFFER_LIMITER_H ) */
+
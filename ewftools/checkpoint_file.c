@@ -0,0 +1,1426 @@
+/*
+ * Checkpoint file
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_STDIO_H ) || defined( WINAPI )
+#include <stdio.h>
+#endif
+
+#include "checkpoint_file.h"
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+
+/* The checkpoint file contains:
+ *   a header of 40 bytes: signature "ewfchkpt", format version, number of entries,
+ *   acquiry offset, acquiry size, digest flags and an Adler-32 checksum of the entries
+ *   followed by the entries: a 64-bit offset and the MD5, SHA1 and SHA256 digest states
+ *
+ * All values are stored in little-endian
+ */
+
+#define CHECKPOINT_FILE_FORMAT_VERSION	1
+
+#define CHECKPOINT_FILE_EXTENSION	".checkpoint"
+#define CHECKPOINT_FILE_EXTENSION_SIZE	12
+
+/* The checkpoint file is written to a temporary file, which then replaces the checkpoint file
+ */
+#define CHECKPOINT_FILE_TEMPORARY_EXTENSION		".tmp"
+#define CHECKPOINT_FILE_TEMPORARY_EXTENSION_SIZE	5
+
+static const uint8_t checkpoint_file_signature[ 8 ] = { 'e', 'w', 'f', 'c', 'h', 'k', 'p', 't' };
+
+/* Calculates the Adler-32 of a buffer
+ */
+static uint32_t checkpoint_file_calculate_checksum(
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	size_t buffer_offset = 0;
+	uint32_t lower_word  = 1;
+	uint32_t upper_word  = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		lower_word = ( lower_word + buffer[ buffer_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Replaces a file with another file
+ * Returns 1 if successful or -1 on error
+ */
+static int checkpoint_file_replace(
+            const system_character_t *source_filename,
+            const system_character_t *destination_filename,
+            libcerror_error_t **error )
+{
+	static char *function = "checkpoint_file_replace";
+
+#if defined( WINAPI )
+	DWORD error_code      = 0;
+#endif
+
+#if defined( WINAPI ) && defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( MoveFileExW(
+	     source_filename,
+	     destination_filename,
+	     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) == 0 )
+#elif defined( WINAPI )
+	if( MoveFileExA(
+	     source_filename,
+	     destination_filename,
+	     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH ) == 0 )
+#endif
+#if defined( WINAPI )
+	{
+		error_code = GetLastError();
+
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 error_code,
+		 "%s: unable to replace file.",
+		 function );
+
+		return( -1 );
+	}
+#elif defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: wide system character not supported.",
+	 function );
+
+	return( -1 );
+#else
+	/* rename replaces the destination atomically, so the destination
+	 * is either the previous or the new file
+	 */
+	if( rename(
+	     source_filename,
+	     destination_filename ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to replace file.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Creates a checkpoint file
+ * Make sure the value checkpoint_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_initialize(
+     checkpoint_file_t **checkpoint_file,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_file_initialize";
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *checkpoint_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid checkpoint file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*checkpoint_file = memory_allocate_structure(
+	                    checkpoint_file_t );
+
+	if( *checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *checkpoint_file,
+	     0,
+	     sizeof( checkpoint_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *checkpoint_file != NULL )
+	{
+		memory_free(
+		 *checkpoint_file );
+
+		*checkpoint_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a checkpoint file
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_free(
+     checkpoint_file_t **checkpoint_file,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_file_free";
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *checkpoint_file != NULL )
+	{
+		if( ( *checkpoint_file )->filename != NULL )
+		{
+			memory_free(
+			 ( *checkpoint_file )->filename );
+		}
+		memory_free(
+		 *checkpoint_file );
+
+		*checkpoint_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the filename
+ * The filename is the image path and filename without extension, to which the checkpoint extension is added
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_set_filename(
+     checkpoint_file_t *checkpoint_file,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function  = "checkpoint_file_set_filename";
+	size_t extension_index = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - CHECKPOINT_FILE_EXTENSION_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_file->filename != NULL )
+	{
+		memory_free(
+		 checkpoint_file->filename );
+
+		checkpoint_file->filename      = NULL;
+		checkpoint_file->filename_size = 0;
+	}
+	checkpoint_file->filename_size = filename_length + CHECKPOINT_FILE_EXTENSION_SIZE;
+
+	checkpoint_file->filename = system_string_allocate(
+	                             checkpoint_file->filename_size );
+
+	if( checkpoint_file->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     checkpoint_file->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	/* The extension is copied per character since it cannot be assumed
+	 * that the system character is a narrow character
+	 */
+	for( extension_index = 0;
+	     extension_index < CHECKPOINT_FILE_EXTENSION_SIZE;
+	     extension_index++ )
+	{
+		checkpoint_file->filename[ filename_length + extension_index ] = (system_character_t) CHECKPOINT_FILE_EXTENSION[ extension_index ];
+	}
+	return( 1 );
+
+on_error:
+	if( checkpoint_file->filename != NULL )
+	{
+		memory_free(
+		 checkpoint_file->filename );
+
+		checkpoint_file->filename = NULL;
+	}
+	checkpoint_file->filename_size = 0;
+
+	return( -1 );
+}
+
+/* Sets the values that identify the acquiry the checkpoints apply to
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_set_values(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t acquiry_offset,
+     uint64_t acquiry_size,
+     uint32_t digest_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_file_set_values";
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( digest_flags & ~( CHECKPOINT_FILE_DIGEST_FLAG_MD5 | CHECKPOINT_FILE_DIGEST_FLAG_SHA1 | CHECKPOINT_FILE_DIGEST_FLAG_SHA256 ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported digest flags: 0x%08" PRIx32 ".",
+		 function,
+		 digest_flags );
+
+		return( -1 );
+	}
+	checkpoint_file->acquiry_offset    = acquiry_offset;
+	checkpoint_file->acquiry_size      = acquiry_size;
+	checkpoint_file->digest_flags      = digest_flags;
+	checkpoint_file->number_of_entries = 0;
+
+	return( 1 );
+}
+
+/* Appends an entry with the current state of the digest contexts
+ * If the maximum number of entries has been reached the oldest entry is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_append_entry(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t offset,
+     digest_context_t *md5_context,
+     digest_context_t *sha1_context,
+     digest_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	checkpoint_file_entry_t *entry = NULL;
+	static char *function          = "checkpoint_file_append_entry";
+	int entry_index                = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( checkpoint_file->number_of_entries < 0 )
+	 || ( checkpoint_file->number_of_entries > CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid checkpoint file - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_file->number_of_entries > 0 )
+	{
+		if( offset <= checkpoint_file->entries[ checkpoint_file->number_of_entries - 1 ].offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( checkpoint_file->number_of_entries == CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES )
+	{
+		for( entry_index = 1;
+		     entry_index < CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES;
+		     entry_index++ )
+		{
+			if( memory_copy(
+			     &( checkpoint_file->entries[ entry_index - 1 ] ),
+			     &( checkpoint_file->entries[ entry_index ] ),
+			     sizeof( checkpoint_file_entry_t ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to discard oldest entry.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		checkpoint_file->number_of_entries -= 1;
+	}
+	entry = &( checkpoint_file->entries[ checkpoint_file->number_of_entries ] );
+
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( checkpoint_file_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		return( -1 );
+	}
+	entry->offset = offset;
+
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_MD5 ) != 0 )
+	{
+		if( digest_context_get_state(
+		     md5_context,
+		     entry->digest_states[ 0 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve MD5 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_SHA1 ) != 0 )
+	{
+		if( digest_context_get_state(
+		     sha1_context,
+		     entry->digest_states[ 1 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve SHA1 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_SHA256 ) != 0 )
+	{
+		if( digest_context_get_state(
+		     sha256_context,
+		     entry->digest_states[ 2 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve SHA256 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	checkpoint_file->number_of_entries += 1;
+
+	return( 1 );
+}
+
+/* Restores the digest contexts from the last entry with an offset that does not exceed the maximum offset
+ * Entries beyond the maximum offset are discarded
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int checkpoint_file_restore_entry(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t maximum_offset,
+     uint64_t *offset,
+     digest_context_t *md5_context,
+     digest_context_t *sha1_context,
+     digest_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	checkpoint_file_entry_t *entry = NULL;
+	static char *function          = "checkpoint_file_restore_entry";
+	int entry_index                = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( checkpoint_file->number_of_entries < 0 )
+	 || ( checkpoint_file->number_of_entries > CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid checkpoint file - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = checkpoint_file->number_of_entries - 1;
+
+	while( entry_index >= 0 )
+	{
+		if( checkpoint_file->entries[ entry_index ].offset <= maximum_offset )
+		{
+			break;
+		}
+		entry_index--;
+	}
+	checkpoint_file->number_of_entries = entry_index + 1;
+
+	if( entry_index < 0 )
+	{
+		return( 0 );
+	}
+	entry = &( checkpoint_file->entries[ entry_index ] );
+
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_MD5 ) != 0 )
+	{
+		if( digest_context_set_state(
+		     md5_context,
+		     entry->digest_states[ 0 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_SHA1 ) != 0 )
+	{
+		if( digest_context_set_state(
+		     sha1_context,
+		     entry->digest_states[ 1 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( checkpoint_file->digest_flags & CHECKPOINT_FILE_DIGEST_FLAG_SHA256 ) != 0 )
+	{
+		if( digest_context_set_state(
+		     sha256_context,
+		     entry->digest_states[ 2 ],
+		     DIGEST_CONTEXT_STATE_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 digest state.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*offset = entry->offset;
+
+	return( 1 );
+}
+
+/* Reads the checkpoint file
+ * Returns 1 if successful, 0 if the checkpoint file does not exist or does not apply or -1 on error
+ */
+int checkpoint_file_read(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error )
+{
+	uint8_t header_data[ CHECKPOINT_FILE_HEADER_SIZE ];
+
+	checkpoint_file_entry_t *entry = NULL;
+	libcfile_file_t *file          = NULL;
+	uint8_t *entries_data          = NULL;
+	static char *function          = "checkpoint_file_read";
+	size64_t file_size             = 0;
+	size_t data_offset             = 0;
+	size_t entries_data_size       = 0;
+	ssize_t read_count             = 0;
+	uint64_t acquiry_offset        = 0;
+	uint64_t acquiry_size          = 0;
+	uint32_t calculated_checksum   = 0;
+	uint32_t digest_flags          = 0;
+	uint32_t format_version        = 0;
+	uint32_t number_of_entries     = 0;
+	uint32_t stored_checksum       = 0;
+	int digest_index               = 0;
+	int entry_index                = 0;
+	int result                     = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_file->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid checkpoint file - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	checkpoint_file->number_of_entries = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          checkpoint_file->filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          checkpoint_file->filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if checkpoint file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          checkpoint_file->filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          checkpoint_file->filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve checkpoint file size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( file_size >= CHECKPOINT_FILE_HEADER_SIZE )
+	{
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              header_data,
+		              CHECKPOINT_FILE_HEADER_SIZE,
+		              error );
+
+		if( read_count != (ssize_t) CHECKPOINT_FILE_HEADER_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read checkpoint file header.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 8 ] ),
+		 format_version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 12 ] ),
+		 number_of_entries );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( header_data[ 16 ] ),
+		 acquiry_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( header_data[ 24 ] ),
+		 acquiry_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 32 ] ),
+		 digest_flags );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 36 ] ),
+		 stored_checksum );
+
+		/* A checkpoint file that was created for a different acquiry does not apply
+		 */
+		if( ( memory_compare(
+		       header_data,
+		       checkpoint_file_signature,
+		       8 ) == 0 )
+		 && ( format_version == CHECKPOINT_FILE_FORMAT_VERSION )
+		 && ( number_of_entries > 0 )
+		 && ( number_of_entries <= CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES )
+		 && ( acquiry_offset == checkpoint_file->acquiry_offset )
+		 && ( acquiry_size == checkpoint_file->acquiry_size )
+		 && ( digest_flags == checkpoint_file->digest_flags )
+		 && ( file_size == (size64_t) ( CHECKPOINT_FILE_HEADER_SIZE + ( number_of_entries * CHECKPOINT_FILE_ENTRY_SIZE ) ) ) )
+		{
+			result = 1;
+		}
+	}
+	if( result != 0 )
+	{
+		entries_data_size = (size_t) number_of_entries * CHECKPOINT_FILE_ENTRY_SIZE;
+
+		entries_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * entries_data_size );
+
+		if( entries_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              entries_data,
+		              entries_data_size,
+		              error );
+
+		if( read_count != (ssize_t) entries_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read checkpoint file entries.",
+			 function );
+
+			goto on_error;
+		}
+		calculated_checksum = checkpoint_file_calculate_checksum(
+		                       entries_data,
+		                       entries_data_size );
+
+		if( stored_checksum != calculated_checksum )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		for( entry_index = 0;
+		     entry_index < (int) number_of_entries;
+		     entry_index++ )
+		{
+			entry = &( checkpoint_file->entries[ entry_index ] );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( entries_data[ data_offset ] ),
+			 entry->offset );
+
+			data_offset += 8;
+
+			for( digest_index = 0;
+			     digest_index < CHECKPOINT_FILE_NUMBER_OF_DIGESTS;
+			     digest_index++ )
+			{
+				if( memory_copy(
+				     entry->digest_states[ digest_index ],
+				     &( entries_data[ data_offset ] ),
+				     DIGEST_CONTEXT_STATE_SIZE ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy digest state.",
+					 function );
+
+					goto on_error;
+				}
+				data_offset += DIGEST_CONTEXT_STATE_SIZE;
+			}
+			if( ( entry_index > 0 )
+			 && ( entry->offset <= checkpoint_file->entries[ entry_index - 1 ].offset ) )
+			{
+				result = 0;
+
+				break;
+			}
+		}
+		if( result != 0 )
+		{
+			checkpoint_file->number_of_entries = (int) number_of_entries;
+		}
+	}
+	if( entries_data != NULL )
+	{
+		memory_free(
+		 entries_data );
+
+		entries_data = NULL;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( entries_data != NULL )
+	{
+		memory_free(
+		 entries_data );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	checkpoint_file->number_of_entries = 0;
+
+	return( -1 );
+}
+
+/* Writes the checkpoint file
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_write(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error )
+{
+	checkpoint_file_entry_t *entry         = NULL;
+	libcfile_file_t *file                  = NULL;
+	system_character_t *temporary_filename = NULL;
+	uint8_t *data                          = NULL;
+	static char *function                  = "checkpoint_file_write";
+	size_t data_offset                     = 0;
+	size_t data_size                       = 0;
+	size_t extension_index                 = 0;
+	size_t filename_length                 = 0;
+	ssize_t write_count                    = 0;
+	uint32_t checksum                      = 0;
+	int digest_index                       = 0;
+	int entry_index                        = 0;
+	int result                             = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_file->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid checkpoint file - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( checkpoint_file->number_of_entries < 0 )
+	 || ( checkpoint_file->number_of_entries > CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid checkpoint file - number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = CHECKPOINT_FILE_HEADER_SIZE + ( (size_t) checkpoint_file->number_of_entries * CHECKPOINT_FILE_ENTRY_SIZE );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = CHECKPOINT_FILE_HEADER_SIZE;
+
+	for( entry_index = 0;
+	     entry_index < checkpoint_file->number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( checkpoint_file->entries[ entry_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 entry->offset );
+
+		data_offset += 8;
+
+		for( digest_index = 0;
+		     digest_index < CHECKPOINT_FILE_NUMBER_OF_DIGESTS;
+		     digest_index++ )
+		{
+			if( memory_copy(
+			     &( data[ data_offset ] ),
+			     entry->digest_states[ digest_index ],
+			     DIGEST_CONTEXT_STATE_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy digest state.",
+				 function );
+
+				goto on_error;
+			}
+			data_offset += DIGEST_CONTEXT_STATE_SIZE;
+		}
+	}
+	checksum = checkpoint_file_calculate_checksum(
+	            &( data[ CHECKPOINT_FILE_HEADER_SIZE ] ),
+	            data_size - CHECKPOINT_FILE_HEADER_SIZE );
+
+	if( memory_copy(
+	     data,
+	     checkpoint_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 8 ] ),
+	 CHECKPOINT_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 12 ] ),
+	 (uint32_t) checkpoint_file->number_of_entries );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 16 ] ),
+	 checkpoint_file->acquiry_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 24 ] ),
+	 checkpoint_file->acquiry_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 32 ] ),
+	 checkpoint_file->digest_flags );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 36 ] ),
+	 checksum );
+
+	/* The checkpoint file is not rewritten in place, since an interruption
+	 * during the write would leave a checkpoint file that no longer applies
+	 */
+	filename_length = checkpoint_file->filename_size - 1;
+
+	temporary_filename = system_string_allocate(
+	                      filename_length + CHECKPOINT_FILE_TEMPORARY_EXTENSION_SIZE );
+
+	if( temporary_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     temporary_filename,
+	     checkpoint_file->filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy temporary filename.",
+		 function );
+
+		goto on_error;
+	}
+	for( extension_index = 0;
+	     extension_index < CHECKPOINT_FILE_TEMPORARY_EXTENSION_SIZE;
+	     extension_index++ )
+	{
+		temporary_filename[ filename_length + extension_index ] = (system_character_t) CHECKPOINT_FILE_TEMPORARY_EXTENSION[ extension_index ];
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          temporary_filename,
+	          LIBCFILE_OPEN_WRITE_TRUNCATE,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          temporary_filename,
+	          LIBCFILE_OPEN_WRITE_TRUNCATE,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open temporary checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write temporary checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_sync(
+	     file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to sync temporary checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close temporary checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	if( checkpoint_file_replace(
+	     temporary_filename,
+	     checkpoint_file->filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to replace checkpoint file with temporary checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 temporary_filename );
+
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( temporary_filename != NULL )
+	{
+		memory_free(
+		 temporary_filename );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
+/* Removes the checkpoint file
+ * Returns 1 if successful or -1 on error
+ */
+int checkpoint_file_remove(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error )
+{
+	static char *function = "checkpoint_file_remove";
+	int result            = 0;
+
+	if( checkpoint_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint file.",
+		 function );
+
+		return( -1 );
+	}
+	if( checkpoint_file->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid checkpoint file - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          checkpoint_file->filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          checkpoint_file->filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if checkpoint file exists.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libcfile_file_remove_wide(
+		          checkpoint_file->filename,
+		          error );
+#else
+		result = libcfile_file_remove(
+		          checkpoint_file->filename,
+		          error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove checkpoint file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	checkpoint_file->number_of_entries = 0;
+
+	return( 1 );
+}
+
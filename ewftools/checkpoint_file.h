@@ -0,0 +1,155 @@
+/*
+ * Checkpoint file
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CHECKPOINT_FILE_H )
+#define _CHECKPOINT_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of checkpoints stored in a checkpoint file
+ * Older checkpoints are discarded when the maximum is reached
+ */
+#define CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES	64
+
+/* The number of digest states stored per checkpoint: MD5, SHA1 and SHA256
+ */
+#define CHECKPOINT_FILE_NUMBER_OF_DIGESTS		3
+
+#define CHECKPOINT_FILE_HEADER_SIZE			40
+#define CHECKPOINT_FILE_ENTRY_SIZE			( 8 + ( CHECKPOINT_FILE_NUMBER_OF_DIGESTS * DIGEST_CONTEXT_STATE_SIZE ) )
+
+enum CHECKPOINT_FILE_DIGEST_FLAGS
+{
+	CHECKPOINT_FILE_DIGEST_FLAG_MD5			= 0x01,
+	CHECKPOINT_FILE_DIGEST_FLAG_SHA1		= 0x02,
+	CHECKPOINT_FILE_DIGEST_FLAG_SHA256		= 0x04
+};
+
+typedef struct checkpoint_file_entry checkpoint_file_entry_t;
+
+struct checkpoint_file_entry
+{
+	/* The offset relative to the start of the acquiry
+	 */
+	uint64_t offset;
+
+	/* The digest states
+	 */
+	uint8_t digest_states[ CHECKPOINT_FILE_NUMBER_OF_DIGESTS ][ DIGEST_CONTEXT_STATE_SIZE ];
+};
+
+typedef struct checkpoint_file checkpoint_file_t;
+
+struct checkpoint_file
+{
+	/* The filename
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The acquiry offset
+	 */
+	uint64_t acquiry_offset;
+
+	/* The acquiry size
+	 */
+	uint64_t acquiry_size;
+
+	/* The digest flags
+	 */
+	uint32_t digest_flags;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The entries
+	 */
+	checkpoint_file_entry_t entries[ CHECKPOINT_FILE_MAXIMUM_NUMBER_OF_ENTRIES ];
+};
+
+int checkpoint_file_initialize(
+     checkpoint_file_t **checkpoint_file,
+     libcerror_error_t **error );
+
+int checkpoint_file_free(
+     checkpoint_file_t **checkpoint_file,
+     libcerror_error_t **error );
+
+int checkpoint_file_set_filename(
+     checkpoint_file_t *checkpoint_file,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int checkpoint_file_set_values(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t acquiry_offset,
+     uint64_t acquiry_size,
+     uint32_t digest_flags,
+     libcerror_error_t **error );
+
+int checkpoint_file_append_entry(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t offset,
+     digest_context_t *md5_context,
+     digest_context_t *sha1_context,
+     digest_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int checkpoint_file_restore_entry(
+     checkpoint_file_t *checkpoint_file,
+     uint64_t maximum_offset,
+     uint64_t *offset,
+     digest_context_t *md5_context,
+     digest_context_t *sha1_context,
+     digest_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int checkpoint_file_read(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error );
+
+int checkpoint_file_write(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error );
+
+int checkpoint_file_remove(
+     checkpoint_file_t *checkpoint_file,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CHECKPOINT_FILE_H ) */
+
@@ -19,6 +19,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+/* SEEK_DATA and SEEK_HOLE require _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <narrow_string.h>
@@ -26,6 +32,18 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
 #include "byte_size_string.h"
 #include "device_handle.h"
 #include "ewfinput.h"
@@ -35,6 +53,8 @@
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
 #include "ewftools_system_string.h"
+#include "read_queue.h"
+#include "rescue_map.h"
 #include "storage_media_buffer.h"
 
 #define DEVICE_HANDLE_INPUT_BUFFER_SIZE		64
@@ -42,6 +62,17 @@
 #define DEVICE_HANDLE_VALUE_SIZE		512
 #define DEVICE_HANDLE_NOTIFY_STREAM		stdout
 
+/* The size of the area that is rescued at a time, the block size of the copy passes
+ * and the maximum size of the data skipped after a read error
+ */
+#define DEVICE_HANDLE_RESCUE_BUFFER_SIZE		( 64 * 1024 * 1024 )
+#define DEVICE_HANDLE_RESCUE_BLOCK_SIZE			( 64 * 1024 )
+#define DEVICE_HANDLE_RESCUE_MAXIMUM_SKIP_SIZE		( 4 * 1024 * 1024 )
+
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( SEEK_DATA ) && defined( SEEK_HOLE )
+#define DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT
+#endif
+
 /* Retrieves the track type
  * Returns a string represenation of the track type
  */
@@ -180,6 +211,7 @@ int device_handle_initialize(
 		goto on_error;
 	}
 	( *device_handle )->number_of_error_retries = 2;
+	( *device_handle )->sparse_file_descriptor  = -1;
 	( *device_handle )->notify_stream           = DEVICE_HANDLE_NOTIFY_STREAM;
 
 	return( 1 );
@@ -231,6 +263,50 @@ int device_handle_free(
 			memory_free(
 			 ( *device_handle )->toc_filename );
 		}
+		if( ( *device_handle )->rescue_map != NULL )
+		{
+			if( rescue_map_free(
+			     &( ( *device_handle )->rescue_map ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free rescue map.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *device_handle )->rescue_buffer != NULL )
+		{
+			memory_free(
+			 ( *device_handle )->rescue_buffer );
+		}
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+		if( ( *device_handle )->sparse_file_descriptor != -1 )
+		{
+			close(
+			 ( *device_handle )->sparse_file_descriptor );
+		}
+#endif
+		if( ( *device_handle )->read_queue != NULL )
+		{
+			if( read_queue_free(
+			     &( ( *device_handle )->read_queue ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read queue.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( *device_handle )->type == DEVICE_HANDLE_TYPE_DEVICE )
 		{
 			if( ( *device_handle )->smdev_input_handle != NULL )
@@ -316,6 +392,8 @@ int device_handle_signal_abort(
 
 		return( -1 );
 	}
+	device_handle->abort = 1;
+
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		if( device_handle->smdev_input_handle != NULL )
@@ -499,6 +577,40 @@ int device_handle_open_input(
 			return( -1 );
 		}
 	}
+	/* Direct IO is only used for a single device or raw input file, since the holes
+	 * of a sparse raw input file are not read
+	 */
+	if( ( device_handle->use_direct_io != 0 )
+	 && ( number_of_filenames == 1 )
+	 && ( device_handle->type != DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	 && ( device_handle->sparse_file_descriptor == -1 ) )
+	{
+		result = device_handle_open_read_queue(
+		          device_handle,
+		          filenames[ 0 ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open read queue.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( device_handle->notify_stream != NULL )
+			{
+				fprintf(
+				 device_handle->notify_stream,
+				 "Direct IO not supported for input, reading buffered.\n" );
+			}
+		}
+	}
 	return( 1 );
 }
 
@@ -895,93 +1007,1775 @@ int device_handle_open_smraw_input(
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open raw input handle.",
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open raw input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* Holes are only determined for a single raw input file
+	 */
+	if( number_of_filenames == 1 )
+	{
+		if( device_handle_open_sparse_input(
+		     device_handle,
+		     filenames[ 0 ],
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open sparse input.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( device_handle->smraw_input_handle != NULL )
+	{
+		libsmraw_handle_free(
+		 &( device_handle->smraw_input_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the sparse file descriptor of the device handle
+ * The sparse file descriptor is used to determine the holes in a raw input file
+ * Returns 1 if successful, 0 if the file does not contain holes or -1 on error
+ */
+int device_handle_open_sparse_input(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_open_sparse_input";
+
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+	off64_t file_size     = 0;
+	off64_t hole_offset   = 0;
+#endif
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->sparse_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - sparse file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+	device_handle->sparse_file_descriptor = open(
+	                                         filename,
+	                                         O_RDONLY );
+
+	if( device_handle->sparse_file_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	file_size = lseek(
+	             device_handle->sparse_file_descriptor,
+	             0,
+	             SEEK_END );
+
+	/* If the file system does not support SEEK_HOLE the end of the file is returned
+	 */
+	if( file_size > 0 )
+	{
+		hole_offset = lseek(
+		               device_handle->sparse_file_descriptor,
+		               0,
+		               SEEK_HOLE );
+	}
+	if( ( file_size <= 0 )
+	 || ( hole_offset < 0 )
+	 || ( hole_offset >= file_size ) )
+	{
+		close(
+		 device_handle->sparse_file_descriptor );
+
+		device_handle->sparse_file_descriptor = -1;
+
+		return( 0 );
+	}
+	device_handle->sparse_file_size = (size64_t) file_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT ) */
+}
+
+/* Opens the read queue of the device handle
+ * The read queue reads the input using direct IO, which bypasses the page cache,
+ * with a number of reads queued ahead
+ * Returns 1 if successful, 0 if direct IO is not supported for the input or -1 on error
+ */
+int device_handle_open_read_queue(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_open_read_queue";
+	int result            = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue_initialize(
+	     &( device_handle->read_queue ),
+	     READ_QUEUE_DEFAULT_NUMBER_OF_BUFFERS,
+	     READ_QUEUE_DEFAULT_BUFFER_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	result = read_queue_open(
+	          device_handle->read_queue,
+	          filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open read queue.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( read_queue_free(
+		     &( device_handle->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read queue.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( device_handle->read_queue != NULL )
+	{
+		read_queue_free(
+		 &( device_handle->read_queue ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines if the input of the device handle is a sparse file
+ * Returns 1 if sparse, 0 if not or -1 on error
+ */
+int device_handle_is_sparse(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_is_sparse";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->sparse_file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads a buffer from a sparse raw input file
+ * The holes in the file are filled with zero bytes without reading them
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_sparse_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function  = "device_handle_read_sparse_buffer";
+	off64_t current_offset = 0;
+	size_t buffer_offset   = 0;
+	size_t read_size       = 0;
+	ssize_t read_count     = 0;
+
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+	off64_t data_offset    = 0;
+	off64_t hole_offset    = 0;
+#endif
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->sparse_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing sparse file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	current_offset = libsmraw_handle_seek_offset(
+	                  device_handle->smraw_input_handle,
+	                  0,
+	                  SEEK_CUR,
+	                  error );
+
+	if( current_offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to retrieve current offset from raw input handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( (size64_t) current_offset >= device_handle->sparse_file_size )
+		{
+			break;
+		}
+		read_size = size - buffer_offset;
+
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+		data_offset = lseek(
+		               device_handle->sparse_file_descriptor,
+		               current_offset,
+		               SEEK_DATA );
+
+		if( data_offset == -1 )
+		{
+			/* ENXIO indicates there is no more data after the offset
+			 */
+			if( errno != ENXIO )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 errno,
+				 "%s: unable to seek data at offset: %" PRIi64 " in sparse file descriptor.",
+				 function,
+				 current_offset );
+
+				return( -1 );
+			}
+			data_offset = (off64_t) device_handle->sparse_file_size;
+		}
+		if( data_offset > current_offset )
+		{
+			if( (size64_t) read_size > (size64_t) ( data_offset - current_offset ) )
+			{
+				read_size = (size_t) ( data_offset - current_offset );
+			}
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear buffer.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset  += read_size;
+			current_offset += (off64_t) read_size;
+
+			continue;
+		}
+		hole_offset = lseek(
+		               device_handle->sparse_file_descriptor,
+		               current_offset,
+		               SEEK_HOLE );
+
+		if( hole_offset == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 errno,
+			 "%s: unable to seek hole at offset: %" PRIi64 " in sparse file descriptor.",
+			 function,
+			 current_offset );
+
+			return( -1 );
+		}
+		if( hole_offset > current_offset )
+		{
+			if( (size64_t) read_size > (size64_t) ( hole_offset - current_offset ) )
+			{
+				read_size = (size_t) ( hole_offset - current_offset );
+			}
+		}
+#endif /* defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT ) */
+
+		if( libsmraw_handle_seek_offset(
+		     device_handle->smraw_input_handle,
+		     current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in raw input handle.",
+			 function,
+			 current_offset );
+
+			return( -1 );
+		}
+		read_count = libsmraw_handle_read_buffer(
+		              device_handle->smraw_input_handle,
+		              &( buffer[ buffer_offset ] ),
+		              read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset  += (size_t) read_count;
+		current_offset += (off64_t) read_count;
+	}
+	if( libsmraw_handle_seek_offset(
+	     device_handle->smraw_input_handle,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in raw input handle.",
+		 function,
+		 current_offset );
+
+		return( -1 );
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads a buffer from the read queue
+ * The areas that could not be read by the read queue are read from the input handle
+ * so that the read error retries and error granularity still apply
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_queue_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function  = "device_handle_read_queue_buffer";
+	off64_t current_offset = 0;
+	size_t buffer_offset   = 0;
+	size_t read_size       = 0;
+	ssize_t read_count     = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_count = read_queue_read_buffer(
+		              device_handle->read_queue,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from read queue.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+
+		if( buffer_offset >= size )
+		{
+			break;
+		}
+		current_offset = device_handle->read_queue->current_offset;
+
+		if( (size64_t) current_offset >= device_handle->read_queue->media_size )
+		{
+			break;
+		}
+		/* The read queue could not read the data at the current offset
+		 */
+		if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+		{
+			current_offset = libsmdev_handle_seek_offset(
+			                  device_handle->smdev_input_handle,
+			                  current_offset,
+			                  SEEK_SET,
+			                  error );
+		}
+		else
+		{
+			current_offset = libsmraw_handle_seek_offset(
+			                  device_handle->smraw_input_handle,
+			                  current_offset,
+			                  SEEK_SET,
+			                  error );
+		}
+		if( current_offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in input handle.",
+			 function,
+			 device_handle->read_queue->current_offset );
+
+			return( -1 );
+		}
+		/* Only the remainder of the read queue buffer is read from the input handle
+		 * after which the read queue continues with the following buffer
+		 */
+		read_size = device_handle->read_queue->buffer_size - (size_t) ( current_offset % (off64_t) device_handle->read_queue->buffer_size );
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+		{
+			read_count = libsmdev_handle_read_buffer(
+			              device_handle->smdev_input_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              error );
+		}
+		else
+		{
+			read_count = libsmraw_handle_read_buffer(
+			              device_handle->smraw_input_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              error );
+		}
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from input handle.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		if( read_queue_seek_offset(
+		     device_handle->read_queue,
+		     (off64_t) read_count,
+		     SEEK_CUR,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in read queue.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Closes the device handle
+ * Returns the 0 if successful or -1 on error
+ */
+int device_handle_close(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_close";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_queue != NULL )
+	{
+		if( read_queue_free(
+		     &( device_handle->read_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close read queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		if( libsmdev_handle_close(
+		     device_handle->smdev_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close device input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
+	{
+		if( libodraw_handle_close(
+		     device_handle->odraw_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close optical disc raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	{
+		if( libsmraw_handle_close(
+		     device_handle->smraw_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+#if defined( DEVICE_HANDLE_HAVE_SPARSE_FILE_SUPPORT )
+		if( device_handle->sparse_file_descriptor != -1 )
+		{
+			if( close(
+			     device_handle->sparse_file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close sparse file descriptor.",
+				 function );
+
+				return( -1 );
+			}
+			device_handle->sparse_file_descriptor = -1;
+		}
+#endif
+	}
+	return( 0 );
+}
+
+/* Opens the rescue map of the device handle
+ * The rescue map is only supported for devices
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_open_rescue_map(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     size_t filename_length,
+     off64_t rescue_offset,
+     size64_t rescue_size,
+     uint8_t resume,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_open_rescue_map";
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - rescue map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->type != DEVICE_HANDLE_TYPE_DEVICE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported device handle type.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid rescue offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( rescue_size == 0 )
+	 || ( rescue_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid rescue size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map_initialize(
+	     &( device_handle->rescue_map ),
+	     (uint64_t) rescue_offset,
+	     (uint64_t) rescue_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create rescue map.",
+		 function );
+
+		goto on_error;
+	}
+	if( rescue_map_set_filename(
+	     device_handle->rescue_map,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set rescue map filename.",
+		 function );
+
+		goto on_error;
+	}
+	/* The ranges of a previous acquiry only apply when resuming
+	 */
+	if( resume != 0 )
+	{
+		if( rescue_map_read(
+		     device_handle->rescue_map,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read rescue map.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	device_handle->rescue_buffer = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * DEVICE_HANDLE_RESCUE_BUFFER_SIZE );
+
+	if( device_handle->rescue_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create rescue buffer.",
+		 function );
+
+		goto on_error;
+	}
+	device_handle->rescue_buffer_size      = DEVICE_HANDLE_RESCUE_BUFFER_SIZE;
+	device_handle->rescue_buffer_offset    = 0;
+	device_handle->rescue_buffer_data_size = 0;
+
+	return( 1 );
+
+on_error:
+	if( device_handle->rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &( device_handle->rescue_map ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads a single block from the device for a rescue pass
+ * The block is read without retries and zeroed if it could not be read
+ * Returns 1 if successful, 0 if the block could not be read or -1 on error
+ */
+int device_handle_read_rescue_block(
+     device_handle_t *device_handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "device_handle_read_rescue_block";
+	ssize_t read_count            = 0;
+	int number_of_errors          = 0;
+	int previous_number_of_errors = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_seek_offset(
+	     device_handle->smdev_input_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in device input handle.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* Make sure a failing read is recorded as a single error that spans the entire block
+	 */
+	if( libsmdev_handle_set_error_granularity(
+	     device_handle->smdev_input_handle,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set error granularity in device input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_get_number_of_errors(
+	     device_handle->smdev_input_handle,
+	     &previous_number_of_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of errors.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libsmdev_handle_read_buffer(
+	              device_handle->smdev_input_handle,
+	              buffer,
+	              size,
+	              &read_error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_free(
+		 &read_error );
+	}
+	if( libsmdev_handle_get_number_of_errors(
+	     device_handle->smdev_input_handle,
+	     &number_of_errors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_count == (ssize_t) size )
+	 && ( number_of_errors == previous_number_of_errors ) )
+	{
+		return( 1 );
+	}
+	if( memory_set(
+	     buffer,
+	     0,
+	     size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Runs a rescue pass over the ranges of an area in the rescue buffer that have a specific status
+ * If skip on error is set the pass skips ahead after a block could not be read, where the size
+ * of the skipped data doubles with every consecutive failed block
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_rescue_pass(
+     device_handle_t *device_handle,
+     off64_t area_offset,
+     size_t area_size,
+     uint8_t read_status,
+     size_t block_size,
+     uint8_t skip_on_error,
+     uint8_t failed_status,
+     libcerror_error_t **error )
+{
+	static char *function     = "device_handle_rescue_pass";
+	uint64_t area_end_offset  = 0;
+	uint64_t offset           = 0;
+	uint64_t range_end_offset = 0;
+	uint64_t range_offset     = 0;
+	uint64_t range_size       = 0;
+	size_t read_size          = 0;
+	size_t skip_size          = 0;
+	uint8_t range_status      = 0;
+	int result                = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing rescue buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( area_offset != device_handle->rescue_buffer_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid area offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( area_size > device_handle->rescue_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid area size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid block size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	offset          = (uint64_t) area_offset;
+	area_end_offset = offset + area_size;
+	skip_size       = block_size;
+
+	while( offset < area_end_offset )
+	{
+		if( device_handle->abort != 0 )
+		{
+			break;
+		}
+		result = rescue_map_get_range_at_offset(
+		          device_handle->rescue_map,
+		          offset,
+		          &range_offset,
+		          &range_size,
+		          &range_status,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIu64 " from rescue map.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		range_end_offset = range_offset + range_size;
+
+		if( range_end_offset > area_end_offset )
+		{
+			range_end_offset = area_end_offset;
+		}
+		if( range_status != read_status )
+		{
+			offset = range_end_offset;
+
+			continue;
+		}
+		read_size = block_size;
+
+		if( (uint64_t) read_size > ( range_end_offset - offset ) )
+		{
+			read_size = (size_t) ( range_end_offset - offset );
+		}
+		result = device_handle_read_rescue_block(
+		          device_handle,
+		          (off64_t) offset,
+		          &( device_handle->rescue_buffer[ offset - (uint64_t) area_offset ] ),
+		          read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block at offset: %" PRIu64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( rescue_map_set_range(
+		     device_handle->rescue_map,
+		     offset,
+		     (uint64_t) read_size,
+		     ( result != 0 ) ? RESCUE_MAP_STATUS_FINISHED : failed_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set range at offset: %" PRIu64 " in rescue map.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		offset += read_size;
+
+		if( result != 0 )
+		{
+			skip_size = block_size;
+		}
+		else if( ( skip_on_error != 0 )
+		      && ( offset < range_end_offset ) )
+		{
+			/* The skipped data is left untried for a subsequent pass
+			 */
+			if( (uint64_t) skip_size > ( range_end_offset - offset ) )
+			{
+				offset = range_end_offset;
+			}
+			else
+			{
+				offset += skip_size;
+			}
+			if( skip_size < DEVICE_HANDLE_RESCUE_MAXIMUM_SKIP_SIZE )
+			{
+				skip_size *= 2;
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Rescues an area of the device into the rescue buffer
+ * The area is first copied in large blocks, skipping ahead on read errors, after which the
+ * failed blocks are split with decreasing block sizes until the size of a sector is reached
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_rescue_area(
+     device_handle_t *device_handle,
+     off64_t area_offset,
+     size_t area_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "device_handle_rescue_area";
+	uint64_t area_end_offset  = 0;
+	uint64_t offset           = 0;
+	uint64_t range_end_offset = 0;
+	uint64_t range_offset     = 0;
+	uint64_t range_size       = 0;
+	size_t block_size         = 0;
+	size_t minimum_block_size = 0;
+	uint32_t bytes_per_sector = 0;
+	uint8_t failed_status     = 0;
+	uint8_t range_status      = 0;
+	uint8_t retry_iterator    = 0;
+	int pass_iterator         = 0;
+	int result                = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing rescue buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( area_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid area offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( area_size == 0 )
+	 || ( area_size > device_handle->rescue_buffer_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid area size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle_get_bytes_per_sector(
+	     device_handle,
+	     &bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		bytes_per_sector = 512;
+	}
+	minimum_block_size = (size_t) bytes_per_sector;
+
+	if( minimum_block_size >= DEVICE_HANDLE_RESCUE_BLOCK_SIZE )
+	{
+		block_size = minimum_block_size;
+	}
+	else
+	{
+		block_size = ( DEVICE_HANDLE_RESCUE_BLOCK_SIZE / minimum_block_size ) * minimum_block_size;
+	}
+	if( memory_set(
+	     device_handle->rescue_buffer,
+	     0,
+	     area_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear rescue buffer.",
+		 function );
+
+		return( -1 );
+	}
+	device_handle->rescue_buffer_offset    = area_offset;
+	device_handle->rescue_buffer_data_size = 0;
+
+	/* The passes do their own retries and the failed blocks are zeroed on read
+	 */
+	if( libsmdev_handle_set_number_of_error_retries(
+	     device_handle->smdev_input_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of error retries in device input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libsmdev_handle_set_error_flags(
+	     device_handle->smdev_input_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set error flags in device input handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The data of previously finished ranges is not retained and needs to be read again,
+	 * ranges that failed in a previous acquiry keep their status
+	 */
+	offset          = (uint64_t) area_offset;
+	area_end_offset = offset + area_size;
+
+	while( offset < area_end_offset )
+	{
+		result = rescue_map_get_range_at_offset(
+		          device_handle->rescue_map,
+		          offset,
+		          &range_offset,
+		          &range_size,
+		          &range_status,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIu64 " from rescue map.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		range_end_offset = range_offset + range_size;
+
+		if( range_end_offset > area_end_offset )
+		{
+			range_end_offset = area_end_offset;
+		}
+		if( range_status == RESCUE_MAP_STATUS_FINISHED )
+		{
+			if( rescue_map_set_range(
+			     device_handle->rescue_map,
+			     offset,
+			     range_end_offset - offset,
+			     RESCUE_MAP_STATUS_NON_TRIED,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set range at offset: %" PRIu64 " in rescue map.",
+				 function,
+				 offset );
+
+				return( -1 );
+			}
+		}
+		offset = range_end_offset;
+	}
+	/* The copy passes, the first skips ahead on errors and the second reads the skipped data
+	 */
+	if( block_size == minimum_block_size )
+	{
+		failed_status = RESCUE_MAP_STATUS_BAD;
+	}
+	else
+	{
+		failed_status = RESCUE_MAP_STATUS_NON_SPLIT;
+	}
+	for( pass_iterator = 0;
+	     pass_iterator < 2;
+	     pass_iterator++ )
+	{
+		if( device_handle_rescue_pass(
+		     device_handle,
+		     area_offset,
+		     area_size,
+		     RESCUE_MAP_STATUS_NON_TRIED,
+		     block_size,
+		     (uint8_t) ( pass_iterator == 0 ),
+		     failed_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run copy pass: %d.",
+			 function,
+			 pass_iterator );
+
+			return( -1 );
+		}
+	}
+	/* The split passes, bisect the failed blocks until the minimum block size is reached
+	 */
+	while( block_size > minimum_block_size )
+	{
+		block_size = ( ( block_size / 2 ) / minimum_block_size ) * minimum_block_size;
+
+		if( block_size <= minimum_block_size )
+		{
+			block_size    = minimum_block_size;
+			failed_status = RESCUE_MAP_STATUS_BAD;
+		}
+		if( device_handle_rescue_pass(
+		     device_handle,
+		     area_offset,
+		     area_size,
+		     RESCUE_MAP_STATUS_NON_SPLIT,
+		     block_size,
+		     0,
+		     failed_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run split pass with block size: %" PRIzd ".",
+			 function,
+			 block_size );
+
+			return( -1 );
+		}
+	}
+	/* The retry passes, only read the remaining bad sectors
+	 */
+	for( retry_iterator = 0;
+	     retry_iterator < device_handle->number_of_error_retries;
+	     retry_iterator++ )
+	{
+		if( device_handle_rescue_pass(
+		     device_handle,
+		     area_offset,
+		     area_size,
+		     RESCUE_MAP_STATUS_BAD,
+		     minimum_block_size,
+		     0,
+		     RESCUE_MAP_STATUS_BAD,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run retry pass: %" PRIu8 ".",
+			 function,
+			 retry_iterator );
+
+			return( -1 );
+		}
+	}
+	if( rescue_map_write(
+	     device_handle->rescue_map,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->abort == 0 )
+	{
+		device_handle->rescue_buffer_data_size = area_size;
+	}
+	return( 1 );
+}
+
+/* Reads a buffer from the device using the rescue passes
+ * The device is rescued in areas of the size of the rescue buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_rescue_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function   = "device_handle_read_rescue_buffer";
+	off64_t current_offset  = 0;
+	uint64_t map_end_offset = 0;
+	size_t area_size        = 0;
+	size_t buffer_offset    = 0;
+	size_t read_size        = 0;
+	size_t rescue_offset    = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid device handle - missing rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	current_offset = libsmdev_handle_seek_offset(
+	                  device_handle->smdev_input_handle,
+	                  0,
+	                  SEEK_CUR,
+	                  error );
+
+	if( current_offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to retrieve current offset from device input handle.",
 		 function );
 
-		goto on_error;
-	}
-	return( 1 );
-
-on_error:
-	if( device_handle->smraw_input_handle != NULL )
-	{
-		libsmraw_handle_free(
-		 &( device_handle->smraw_input_handle ),
-		 NULL );
+		return( -1 );
 	}
-	return( -1 );
-}
-
-/* Closes the device handle
- * Returns the 0 if successful or -1 on error
- */
-int device_handle_close(
-     device_handle_t *device_handle,
-     libcerror_error_t **error )
-{
-	static char *function = "device_handle_close";
-
-	if( device_handle == NULL )
+	if( (uint64_t) current_offset < device_handle->rescue_map->offset )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid device handle.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: current offset: %" PRIi64 " outside rescue map.",
+		 function,
+		 current_offset );
 
 		return( -1 );
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	map_end_offset = device_handle->rescue_map->offset + device_handle->rescue_map->size;
+
+	while( buffer_offset < size )
 	{
-		if( libsmdev_handle_close(
-		     device_handle->smdev_input_handle,
-		     error ) != 0 )
+		if( (uint64_t) current_offset >= map_end_offset )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close device input handle.",
-			 function );
+			break;
+		}
+		if( ( current_offset < device_handle->rescue_buffer_offset )
+		 || ( (size64_t) ( current_offset - device_handle->rescue_buffer_offset ) >= (size64_t) device_handle->rescue_buffer_data_size ) )
+		{
+			area_size = device_handle->rescue_buffer_size;
 
-			return( -1 );
+			if( (uint64_t) area_size > ( map_end_offset - current_offset ) )
+			{
+				area_size = (size_t) ( map_end_offset - current_offset );
+			}
+			if( device_handle_rescue_area(
+			     device_handle,
+			     current_offset,
+			     area_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to rescue area at offset: %" PRIi64 ".",
+				 function,
+				 current_offset );
+
+				return( -1 );
+			}
+			/* An aborted rescue leaves the area incomplete
+			 */
+			if( device_handle->rescue_buffer_data_size == 0 )
+			{
+				break;
+			}
 		}
-	}
-	else if( device_handle->type == DEVICE_HANDLE_TYPE_OPTICAL_DISC_FILE )
-	{
-		if( libodraw_handle_close(
-		     device_handle->odraw_input_handle,
-		     error ) != 0 )
+		rescue_offset = (size_t) ( current_offset - device_handle->rescue_buffer_offset );
+		read_size     = device_handle->rescue_buffer_data_size - rescue_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( device_handle->rescue_buffer[ rescue_offset ] ),
+		     read_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close optical disc raw input handle.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from rescue buffer.",
 			 function );
 
 			return( -1 );
 		}
+		buffer_offset  += read_size;
+		current_offset += (off64_t) read_size;
 	}
-	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	if( libsmdev_handle_seek_offset(
+	     device_handle->smdev_input_handle,
+	     current_offset,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
-		if( libsmraw_handle_close(
-		     device_handle->smraw_input_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close raw input handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in device input handle.",
+		 function,
+		 current_offset );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( 0 );
+	return( (ssize_t) buffer_offset );
 }
 
 /* Reads a storage media buffer from the input of the device handle
@@ -1019,7 +2813,48 @@ ssize_t device_handle_read_storage_media_buffer(
 
 		return( -1 );
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	if( ( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	 && ( device_handle->rescue_map != NULL ) )
+	{
+		read_count = device_handle_read_rescue_buffer(
+			      device_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read rescue buffer from device input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->read_queue != NULL )
+	{
+		read_count = device_handle_read_queue_buffer(
+			      device_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from read queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		read_count = libsmdev_handle_read_buffer(
 			      device_handle->smdev_input_handle,
@@ -1059,6 +2894,27 @@ ssize_t device_handle_read_storage_media_buffer(
 			return( -1 );
 		}
 	}
+	else if( ( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
+	      && ( device_handle->sparse_file_descriptor != -1 ) )
+	{
+		read_count = device_handle_read_sparse_buffer(
+			      device_handle,
+			      storage_media_buffer->raw_buffer,
+			      read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sparse buffer from raw input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	else if( device_handle->type == DEVICE_HANDLE_TYPE_FILE )
 	{
 		read_count = libsmraw_handle_read_buffer(
@@ -1119,6 +2975,30 @@ off64_t device_handle_seek_offset(
 
 		return( -1 );
 	}
+	/* The offset of the input handle does not advance when the read queue is read
+	 * hence the offset is determined by the read queue
+	 */
+	if( device_handle->read_queue != NULL )
+	{
+		offset = read_queue_seek_offset(
+		          device_handle->read_queue,
+		          offset,
+		          whence,
+		          error );
+
+		if( offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in read queue.",
+			 function );
+
+			return( -1 );
+		}
+		whence = SEEK_SET;
+	}
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		offset = libsmdev_handle_seek_offset(
@@ -2263,6 +4143,70 @@ int device_handle_set_number_of_error_retries(
 	return( result );
 }
 
+/* Sets the read options
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int device_handle_set_read_options(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_set_read_options";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "direct" ),
+		     6 ) == 0 )
+		{
+			device_handle->use_direct_io = 1;
+
+			result = 1;
+		}
+	}
+	else if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "none" ),
+		     4 ) == 0 )
+		{
+			device_handle->use_direct_io = 0;
+
+			result = 1;
+		}
+	}
+	return( result );
+}
+
 /* Sets the error values
  * Returns 1 if successful or -1 on error
  */
@@ -2358,7 +4302,27 @@ int device_handle_get_number_of_read_errors(
 
 		return( -1 );
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	if( device_handle->rescue_map != NULL )
+	{
+		/* The ranges that could not be read are tracked by the rescue map
+		 */
+		if( rescue_map_get_number_of_ranges_by_status(
+		     device_handle->rescue_map,
+		     RESCUE_MAP_STATUS_BAD,
+		     number_of_read_errors,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of bad ranges from rescue map.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		if( libsmdev_handle_get_number_of_errors(
 		     device_handle->smdev_input_handle,
@@ -2405,6 +4369,8 @@ int device_handle_get_read_error(
      libcerror_error_t **error )
 {
 	static char *function = "device_handle_get_read_error";
+	uint64_t range_offset = 0;
+	uint64_t range_size   = 0;
 
 	if( device_handle == NULL )
 	{
@@ -2417,7 +4383,52 @@ int device_handle_get_read_error(
 
 		return( -1 );
 	}
-	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
+	if( device_handle->rescue_map != NULL )
+	{
+		if( offset == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid offset.",
+			 function );
+
+			return( -1 );
+		}
+		if( size == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid size.",
+			 function );
+
+			return( -1 );
+		}
+		if( rescue_map_get_range_by_status(
+		     device_handle->rescue_map,
+		     RESCUE_MAP_STATUS_BAD,
+		     index,
+		     &range_offset,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve bad range: %d from rescue map.",
+			 function,
+			 index );
+
+			return( -1 );
+		}
+		*offset = (off64_t) range_offset;
+		*size   = (size64_t) range_size;
+	}
+	else if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		if( libsmdev_handle_get_error(
 		     device_handle->smdev_input_handle,
@@ -29,6 +29,8 @@
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
+#include "read_queue.h"
+#include "rescue_map.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -111,9 +113,49 @@ struct device_handle
 	 */
 	uint8_t zero_buffer_on_error;
 
+	/* The rescue map, used by the multi-pass read error strategy
+	 */
+	rescue_map_t *rescue_map;
+
+	/* The rescue buffer, contains the data of the area that was rescued last
+	 */
+	uint8_t *rescue_buffer;
+
+	/* The rescue buffer size
+	 */
+	size_t rescue_buffer_size;
+
+	/* The offset of the data in the rescue buffer
+	 */
+	off64_t rescue_buffer_offset;
+
+	/* The size of the data in the rescue buffer
+	 */
+	size_t rescue_buffer_data_size;
+
+	/* The file descriptor used to determine the holes in a sparse raw input file
+	 */
+	int sparse_file_descriptor;
+
+	/* The size of the sparse raw input file
+	 */
+	size64_t sparse_file_size;
+
+	/* Value to indicate the input should be read using direct IO
+	 */
+	uint8_t use_direct_io;
+
+	/* The read queue, that reads the input using direct IO with a number of reads queued ahead
+	 */
+	read_queue_t *read_queue;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
 };
 
 const char *device_handle_get_track_type(
@@ -155,10 +197,74 @@ int device_handle_open_smraw_input(
      int number_of_filenames,
      libcerror_error_t **error );
 
+int device_handle_open_sparse_input(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int device_handle_open_read_queue(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int device_handle_is_sparse(
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
+ssize_t device_handle_read_sparse_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t device_handle_read_queue_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 int device_handle_close(
      device_handle_t *device_handle,
      libcerror_error_t **error );
 
+int device_handle_open_rescue_map(
+     device_handle_t *device_handle,
+     const system_character_t *filename,
+     size_t filename_length,
+     off64_t rescue_offset,
+     size64_t rescue_size,
+     uint8_t resume,
+     libcerror_error_t **error );
+
+int device_handle_read_rescue_block(
+     device_handle_t *device_handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int device_handle_rescue_pass(
+     device_handle_t *device_handle,
+     off64_t area_offset,
+     size_t area_size,
+     uint8_t read_status,
+     size_t block_size,
+     uint8_t skip_on_error,
+     uint8_t failed_status,
+     libcerror_error_t **error );
+
+int device_handle_rescue_area(
+     device_handle_t *device_handle,
+     off64_t area_offset,
+     size_t area_size,
+     libcerror_error_t **error );
+
+ssize_t device_handle_read_rescue_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t device_handle_read_storage_media_buffer(
          device_handle_t *device_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -254,6 +360,11 @@ int device_handle_set_number_of_error_retries(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int device_handle_set_read_options(
+     device_handle_t *device_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int device_handle_set_error_values(
      device_handle_t *device_handle,
      size_t error_granularity,
@@ -0,0 +1,1710 @@
+/*
+ * Digest context functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_context.h"
+#include "ewftools_libcerror.h"
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#if defined( __clang__ ) || ( __GNUC__ >= 5 )
+#define HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS	1
+#define DIGEST_CONTEXT_SHA_EXTENSIONS_TARGET	__attribute__(( target( "sha,sse4.1,ssse3" ) ))
+
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1900 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS	1
+#define DIGEST_CONTEXT_SHA_EXTENSIONS_TARGET
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#elif defined( __aarch64__ ) && ( defined( __ARM_FEATURE_SHA2 ) || defined( __ARM_FEATURE_CRYPTO ) )
+#define HAVE_DIGEST_CONTEXT_ARMV8_CRYPTO	1
+
+#include <arm_neon.h>
+#endif
+
+/* The digest context is a self-contained MD5, SHA1 and SHA256 implementation
+ * of which the intermediate state can be stored and restored, which is used
+ * to checkpoint integrity hashes
+ */
+
+#define digest_context_rotate_left( value, number_of_bits ) \
+	( ( ( value ) << ( number_of_bits ) ) | ( ( value ) >> ( 32 - ( number_of_bits ) ) ) )
+
+#define digest_context_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+static const uint32_t digest_context_md5_initial_hash_values[ 4 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL };
+
+static const uint32_t digest_context_md5_sines[ 64 ] = {
+	0xd76aa478UL, 0xe8c7b756UL, 0x242070dbUL, 0xc1bdceeeUL, 0xf57c0fafUL, 0x4787c62aUL, 0xa8304613UL, 0xfd469501UL,
+	0x698098d8UL, 0x8b44f7afUL, 0xffff5bb1UL, 0x895cd7beUL, 0x6b901122UL, 0xfd987193UL, 0xa679438eUL, 0x49b40821UL,
+	0xf61e2562UL, 0xc040b340UL, 0x265e5a51UL, 0xe9b6c7aaUL, 0xd62f105dUL, 0x02441453UL, 0xd8a1e681UL, 0xe7d3fbc8UL,
+	0x21e1cde6UL, 0xc33707d6UL, 0xf4d50d87UL, 0x455a14edUL, 0xa9e3e905UL, 0xfcefa3f8UL, 0x676f02d9UL, 0x8d2a4c8aUL,
+	0xfffa3942UL, 0x8771f681UL, 0x6d9d6122UL, 0xfde5380cUL, 0xa4beea44UL, 0x4bdecfa9UL, 0xf6bb4b60UL, 0xbebfbc70UL,
+	0x289b7ec6UL, 0xeaa127faUL, 0xd4ef3085UL, 0x04881d05UL, 0xd9d4d039UL, 0xe6db99e5UL, 0x1fa27cf8UL, 0xc4ac5665UL,
+	0xf4292244UL, 0x432aff97UL, 0xab9423a7UL, 0xfc93a039UL, 0x655b59c3UL, 0x8f0ccc92UL, 0xffeff47dUL, 0x85845dd1UL,
+	0x6fa87e4fUL, 0xfe2ce6e0UL, 0xa3014314UL, 0x4e0811a1UL, 0xf7537e82UL, 0xbd3af235UL, 0x2ad7d2bbUL, 0xeb86d391UL };
+
+static const uint8_t digest_context_md5_bit_shifts[ 64 ] = {
+	7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+	5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+	4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+	6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21 };
+
+static const uint32_t digest_context_sha1_initial_hash_values[ 5 ] = {
+	0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL };
+
+static const uint32_t digest_context_sha256_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+static const uint32_t digest_context_sha256_prime_square_roots[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Calculates the MD5 of 64 byte blocks
+ */
+static void digest_context_md5_transform(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32_t values_32bit[ 16 ];
+
+	uint32_t hash_value1 = 0;
+	uint32_t hash_value2 = 0;
+	uint32_t hash_value3 = 0;
+	uint32_t hash_value4 = 0;
+	uint32_t value_32bit = 0;
+	uint8_t index        = 0;
+	uint8_t value_index  = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		for( index = 0;
+		     index < 16;
+		     index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( buffer[ index * 4 ] ),
+			 values_32bit[ index ] );
+		}
+		hash_value1 = hash_values[ 0 ];
+		hash_value2 = hash_values[ 1 ];
+		hash_value3 = hash_values[ 2 ];
+		hash_value4 = hash_values[ 3 ];
+
+		for( index = 0;
+		     index < 64;
+		     index++ )
+		{
+			if( index < 16 )
+			{
+				value_32bit = ( hash_value2 & hash_value3 ) | ( ~hash_value2 & hash_value4 );
+				value_index = index;
+			}
+			else if( index < 32 )
+			{
+				value_32bit = ( hash_value4 & hash_value2 ) | ( ~hash_value4 & hash_value3 );
+				value_index = ( ( 5 * index ) + 1 ) & 0x0f;
+			}
+			else if( index < 48 )
+			{
+				value_32bit = hash_value2 ^ hash_value3 ^ hash_value4;
+				value_index = ( ( 3 * index ) + 5 ) & 0x0f;
+			}
+			else
+			{
+				value_32bit = hash_value3 ^ ( hash_value2 | ~hash_value4 );
+				value_index = ( 7 * index ) & 0x0f;
+			}
+			value_32bit += hash_value1 + digest_context_md5_sines[ index ] + values_32bit[ value_index ];
+
+			hash_value1 = hash_value4;
+			hash_value4 = hash_value3;
+			hash_value3 = hash_value2;
+			hash_value2 = hash_value2 + digest_context_rotate_left(
+			                             value_32bit,
+			                             digest_context_md5_bit_shifts[ index ] );
+		}
+		hash_values[ 0 ] += hash_value1;
+		hash_values[ 1 ] += hash_value2;
+		hash_values[ 2 ] += hash_value3;
+		hash_values[ 3 ] += hash_value4;
+
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+}
+
+/* Calculates the SHA1 of 64 byte blocks
+ */
+static void digest_context_sha1_transform(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32_t values_32bit[ 80 ];
+
+	uint32_t hash_value1 = 0;
+	uint32_t hash_value2 = 0;
+	uint32_t hash_value3 = 0;
+	uint32_t hash_value4 = 0;
+	uint32_t hash_value5 = 0;
+	uint32_t value_32bit = 0;
+	uint8_t index        = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		for( index = 0;
+		     index < 16;
+		     index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( buffer[ index * 4 ] ),
+			 values_32bit[ index ] );
+		}
+		for( index = 16;
+		     index < 80;
+		     index++ )
+		{
+			value_32bit = values_32bit[ index - 3 ]
+			            ^ values_32bit[ index - 8 ]
+			            ^ values_32bit[ index - 14 ]
+			            ^ values_32bit[ index - 16 ];
+
+			values_32bit[ index ] = digest_context_rotate_left(
+			                         value_32bit,
+			                         1 );
+		}
+		hash_value1 = hash_values[ 0 ];
+		hash_value2 = hash_values[ 1 ];
+		hash_value3 = hash_values[ 2 ];
+		hash_value4 = hash_values[ 3 ];
+		hash_value5 = hash_values[ 4 ];
+
+		for( index = 0;
+		     index < 20;
+		     index++ )
+		{
+			value_32bit  = ( hash_value2 & hash_value3 ) | ( ~hash_value2 & hash_value4 );
+			value_32bit += digest_context_rotate_left(
+			                hash_value1,
+			                5 );
+			value_32bit += hash_value5 + values_32bit[ index ] + 0x5a827999UL;
+
+			hash_value5 = hash_value4;
+			hash_value4 = hash_value3;
+			hash_value3 = digest_context_rotate_left(
+			               hash_value2,
+			               30 );
+			hash_value2 = hash_value1;
+			hash_value1 = value_32bit;
+		}
+		for( index = 20;
+		     index < 40;
+		     index++ )
+		{
+			value_32bit  = hash_value2 ^ hash_value3 ^ hash_value4;
+			value_32bit += digest_context_rotate_left(
+			                hash_value1,
+			                5 );
+			value_32bit += hash_value5 + values_32bit[ index ] + 0x6ed9eba1UL;
+
+			hash_value5 = hash_value4;
+			hash_value4 = hash_value3;
+			hash_value3 = digest_context_rotate_left(
+			               hash_value2,
+			               30 );
+			hash_value2 = hash_value1;
+			hash_value1 = value_32bit;
+		}
+		for( index = 40;
+		     index < 60;
+		     index++ )
+		{
+			value_32bit  = ( hash_value2 & hash_value3 ) | ( hash_value2 & hash_value4 ) | ( hash_value3 & hash_value4 );
+			value_32bit += digest_context_rotate_left(
+			                hash_value1,
+			                5 );
+			value_32bit += hash_value5 + values_32bit[ index ] + 0x8f1bbcdcUL;
+
+			hash_value5 = hash_value4;
+			hash_value4 = hash_value3;
+			hash_value3 = digest_context_rotate_left(
+			               hash_value2,
+			               30 );
+			hash_value2 = hash_value1;
+			hash_value1 = value_32bit;
+		}
+		for( index = 60;
+		     index < 80;
+		     index++ )
+		{
+			value_32bit  = hash_value2 ^ hash_value3 ^ hash_value4;
+			value_32bit += digest_context_rotate_left(
+			                hash_value1,
+			                5 );
+			value_32bit += hash_value5 + values_32bit[ index ] + 0xca62c1d6UL;
+
+			hash_value5 = hash_value4;
+			hash_value4 = hash_value3;
+			hash_value3 = digest_context_rotate_left(
+			               hash_value2,
+			               30 );
+			hash_value2 = hash_value1;
+			hash_value1 = value_32bit;
+		}
+		hash_values[ 0 ] += hash_value1;
+		hash_values[ 1 ] += hash_value2;
+		hash_values[ 2 ] += hash_value3;
+		hash_values[ 3 ] += hash_value4;
+		hash_values[ 4 ] += hash_value5;
+
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+}
+
+/* Calculates the SHA256 of 64 byte blocks
+ */
+static void digest_context_sha256_transform(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32_t local_hash_values[ 8 ];
+	uint32_t values_32bit[ 64 ];
+
+	uint32_t s0          = 0;
+	uint32_t s1          = 0;
+	uint32_t value_32bit = 0;
+	uint8_t index        = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		for( index = 0;
+		     index < 16;
+		     index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( buffer[ index * 4 ] ),
+			 values_32bit[ index ] );
+		}
+		for( index = 16;
+		     index < 64;
+		     index++ )
+		{
+			value_32bit = values_32bit[ index - 15 ];
+
+			s0 = digest_context_rotate_right( value_32bit, 7 )
+			   ^ digest_context_rotate_right( value_32bit, 18 )
+			   ^ ( value_32bit >> 3 );
+
+			value_32bit = values_32bit[ index - 2 ];
+
+			s1 = digest_context_rotate_right( value_32bit, 17 )
+			   ^ digest_context_rotate_right( value_32bit, 19 )
+			   ^ ( value_32bit >> 10 );
+
+			values_32bit[ index ] = values_32bit[ index - 16 ] + s0 + values_32bit[ index - 7 ] + s1;
+		}
+		for( index = 0;
+		     index < 8;
+		     index++ )
+		{
+			local_hash_values[ index ] = hash_values[ index ];
+		}
+		for( index = 0;
+		     index < 64;
+		     index++ )
+		{
+			s1 = digest_context_rotate_right( local_hash_values[ 4 ], 6 )
+			   ^ digest_context_rotate_right( local_hash_values[ 4 ], 11 )
+			   ^ digest_context_rotate_right( local_hash_values[ 4 ], 25 );
+
+			value_32bit = ( local_hash_values[ 4 ] & local_hash_values[ 5 ] )
+			            ^ ( ~( local_hash_values[ 4 ] ) & local_hash_values[ 6 ] );
+
+			value_32bit += local_hash_values[ 7 ] + s1 + digest_context_sha256_prime_square_roots[ index ] + values_32bit[ index ];
+
+			s0 = digest_context_rotate_right( local_hash_values[ 0 ], 2 )
+			   ^ digest_context_rotate_right( local_hash_values[ 0 ], 13 )
+			   ^ digest_context_rotate_right( local_hash_values[ 0 ], 22 );
+
+			s0 += ( local_hash_values[ 0 ] & local_hash_values[ 1 ] )
+			    ^ ( local_hash_values[ 0 ] & local_hash_values[ 2 ] )
+			    ^ ( local_hash_values[ 1 ] & local_hash_values[ 2 ] );
+
+			local_hash_values[ 7 ] = local_hash_values[ 6 ];
+			local_hash_values[ 6 ] = local_hash_values[ 5 ];
+			local_hash_values[ 5 ] = local_hash_values[ 4 ];
+			local_hash_values[ 4 ] = local_hash_values[ 3 ] + value_32bit;
+			local_hash_values[ 3 ] = local_hash_values[ 2 ];
+			local_hash_values[ 2 ] = local_hash_values[ 1 ];
+			local_hash_values[ 1 ] = local_hash_values[ 0 ];
+			local_hash_values[ 0 ] = value_32bit + s0;
+		}
+		for( index = 0;
+		     index < 8;
+		     index++ )
+		{
+			hash_values[ index ] += local_hash_values[ index ];
+		}
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+}
+
+#if defined( HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS )
+
+/* Value to indicate if the CPU supports the SHA extensions
+ * -1 if not determined yet
+ */
+static int digest_context_cpu_has_sha_extensions = -1;
+
+/* Determines if the CPU supports the SHA extensions, SSSE3 and SSE4.1
+ * Returns 1 if supported or 0 if not
+ */
+static int digest_context_get_cpu_has_sha_extensions(
+            void )
+{
+	unsigned int registers[ 4 ] = { 0, 0, 0, 0 };
+	int result                  = 0;
+
+	if( digest_context_cpu_has_sha_extensions != -1 )
+	{
+		return( digest_context_cpu_has_sha_extensions );
+	}
+#if defined( _MSC_VER )
+	__cpuid(
+	 (int *) registers,
+	 0 );
+
+	if( registers[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 (int *) registers,
+		 1 );
+
+		/* ECX bit 9 is SSSE3 and bit 19 is SSE4.1
+		 */
+		if( ( registers[ 2 ] & 0x00080200UL ) == 0x00080200UL )
+		{
+			__cpuidex(
+			 (int *) registers,
+			 7,
+			 0 );
+
+			/* EBX bit 29 is SHA
+			 */
+			if( ( registers[ 1 ] & 0x20000000UL ) != 0 )
+			{
+				result = 1;
+			}
+		}
+	}
+#else
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) >= 7 )
+	{
+		__cpuid(
+		 1,
+		 registers[ 0 ],
+		 registers[ 1 ],
+		 registers[ 2 ],
+		 registers[ 3 ] );
+
+		/* ECX bit 9 is SSSE3 and bit 19 is SSE4.1
+		 */
+		if( ( registers[ 2 ] & 0x00080200UL ) == 0x00080200UL )
+		{
+			__cpuid_count(
+			 7,
+			 0,
+			 registers[ 0 ],
+			 registers[ 1 ],
+			 registers[ 2 ],
+			 registers[ 3 ] );
+
+			/* EBX bit 29 is SHA
+			 */
+			if( ( registers[ 1 ] & 0x20000000UL ) != 0 )
+			{
+				result = 1;
+			}
+		}
+	}
+#endif
+	digest_context_cpu_has_sha_extensions = result;
+
+	return( result );
+}
+
+/* Calculates the SHA1 of 64 byte blocks using the SHA extensions
+ */
+DIGEST_CONTEXT_SHA_EXTENSIONS_TARGET
+static void digest_context_sha1_transform_sha_extensions(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	__m128i messages[ 4 ];
+
+	__m128i abcd_values      = _mm_loadu_si128( (const __m128i *) hash_values );
+	__m128i abcd_values_save = _mm_setzero_si128();
+	__m128i byte_order_mask  = _mm_set_epi64x( 0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL );
+	__m128i e_values         = _mm_setzero_si128();
+	__m128i e_values0        = _mm_set_epi32( (int) hash_values[ 4 ], 0, 0, 0 );
+	__m128i e_values0_save   = _mm_setzero_si128();
+	__m128i e_values1        = _mm_setzero_si128();
+	uint8_t group_index      = 0;
+
+	abcd_values = _mm_shuffle_epi32( abcd_values, 0x1b );
+
+	while( number_of_blocks > 0 )
+	{
+		abcd_values_save = abcd_values;
+		e_values0_save   = e_values0;
+
+		for( group_index = 0;
+		     group_index < 4;
+		     group_index++ )
+		{
+			messages[ group_index ] = _mm_shuffle_epi8(
+			                           _mm_loadu_si128( (const __m128i *) &( buffer[ group_index * 16 ] ) ),
+			                           byte_order_mask );
+		}
+		/* Every group calculates 4 rounds, where the first group adds
+		 * the message to E instead of using sha1nexte
+		 */
+		e_values0   = _mm_add_epi32( e_values0, messages[ 0 ] );
+		e_values1   = abcd_values;
+		abcd_values = _mm_sha1rnds4_epu32( abcd_values, e_values0, 0 );
+
+		for( group_index = 1;
+		     group_index < 20;
+		     group_index++ )
+		{
+			if( ( group_index % 2 ) != 0 )
+			{
+				e_values1 = _mm_sha1nexte_epu32( e_values1, messages[ group_index % 4 ] );
+				e_values0 = abcd_values;
+				e_values  = e_values1;
+			}
+			else
+			{
+				e_values0 = _mm_sha1nexte_epu32( e_values0, messages[ group_index % 4 ] );
+				e_values1 = abcd_values;
+				e_values  = e_values0;
+			}
+			/* The message schedule of group + 4 is calculated over 3 groups
+			 */
+			if( ( group_index >= 3 )
+			 && ( group_index <= 18 ) )
+			{
+				messages[ ( group_index + 1 ) % 4 ] = _mm_sha1msg2_epu32( messages[ ( group_index + 1 ) % 4 ], messages[ group_index % 4 ] );
+			}
+			switch( group_index / 5 )
+			{
+				case 0:
+					abcd_values = _mm_sha1rnds4_epu32( abcd_values, e_values, 0 );
+					break;
+
+				case 1:
+					abcd_values = _mm_sha1rnds4_epu32( abcd_values, e_values, 1 );
+					break;
+
+				case 2:
+					abcd_values = _mm_sha1rnds4_epu32( abcd_values, e_values, 2 );
+					break;
+
+				default:
+					abcd_values = _mm_sha1rnds4_epu32( abcd_values, e_values, 3 );
+					break;
+			}
+			if( group_index <= 16 )
+			{
+				messages[ ( group_index + 3 ) % 4 ] = _mm_sha1msg1_epu32( messages[ ( group_index + 3 ) % 4 ], messages[ group_index % 4 ] );
+			}
+			if( ( group_index >= 2 )
+			 && ( group_index <= 17 ) )
+			{
+				messages[ ( group_index + 2 ) % 4 ] = _mm_xor_si128( messages[ ( group_index + 2 ) % 4 ], messages[ group_index % 4 ] );
+			}
+		}
+		e_values0   = _mm_sha1nexte_epu32( e_values0, e_values0_save );
+		abcd_values = _mm_add_epi32( abcd_values, abcd_values_save );
+
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	abcd_values = _mm_shuffle_epi32( abcd_values, 0x1b );
+
+	_mm_storeu_si128( (__m128i *) hash_values, abcd_values );
+
+	hash_values[ 4 ] = (uint32_t) _mm_extract_epi32( e_values0, 3 );
+}
+
+/* Calculates the SHA256 of 64 byte blocks using the SHA extensions
+ */
+DIGEST_CONTEXT_SHA_EXTENSIONS_TARGET
+static void digest_context_sha256_transform_sha_extensions(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	__m128i messages[ 4 ];
+
+	__m128i abef_values      = _mm_setzero_si128();
+	__m128i abef_values_save = _mm_setzero_si128();
+	__m128i byte_order_mask  = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+	__m128i cdgh_values      = _mm_setzero_si128();
+	__m128i cdgh_values_save = _mm_setzero_si128();
+	__m128i message          = _mm_setzero_si128();
+	__m128i values           = _mm_setzero_si128();
+	uint8_t group_index      = 0;
+
+	/* The SHA extensions operate on the hash values in ABEF and CDGH order
+	 */
+	values      = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *) &( hash_values[ 0 ] ) ), 0xb1 );
+	cdgh_values = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *) &( hash_values[ 4 ] ) ), 0x1b );
+	abef_values = _mm_alignr_epi8( values, cdgh_values, 8 );
+	cdgh_values = _mm_blend_epi16( cdgh_values, values, 0xf0 );
+
+	while( number_of_blocks > 0 )
+	{
+		abef_values_save = abef_values;
+		cdgh_values_save = cdgh_values;
+
+		for( group_index = 0;
+		     group_index < 4;
+		     group_index++ )
+		{
+			messages[ group_index ] = _mm_shuffle_epi8(
+			                           _mm_loadu_si128( (const __m128i *) &( buffer[ group_index * 16 ] ) ),
+			                           byte_order_mask );
+		}
+		/* Every group calculates 4 rounds
+		 */
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			message = _mm_add_epi32(
+			           messages[ group_index % 4 ],
+			           _mm_loadu_si128( (const __m128i *) &( digest_context_sha256_prime_square_roots[ group_index * 4 ] ) ) );
+
+			cdgh_values = _mm_sha256rnds2_epu32( cdgh_values, abef_values, message );
+			message     = _mm_shuffle_epi32( message, 0x0e );
+			abef_values = _mm_sha256rnds2_epu32( abef_values, cdgh_values, message );
+
+			/* Replace the message of this group by that of group + 4
+			 */
+			if( group_index < 12 )
+			{
+				values = _mm_sha256msg1_epu32( messages[ group_index % 4 ], messages[ ( group_index + 1 ) % 4 ] );
+				values = _mm_add_epi32( values, _mm_alignr_epi8( messages[ ( group_index + 3 ) % 4 ], messages[ ( group_index + 2 ) % 4 ], 4 ) );
+
+				messages[ group_index % 4 ] = _mm_sha256msg2_epu32( values, messages[ ( group_index + 3 ) % 4 ] );
+			}
+		}
+		abef_values = _mm_add_epi32( abef_values, abef_values_save );
+		cdgh_values = _mm_add_epi32( cdgh_values, cdgh_values_save );
+
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	values      = _mm_shuffle_epi32( abef_values, 0x1b );
+	cdgh_values = _mm_shuffle_epi32( cdgh_values, 0xb1 );
+	abef_values = _mm_blend_epi16( values, cdgh_values, 0xf0 );
+	cdgh_values = _mm_alignr_epi8( cdgh_values, values, 8 );
+
+	_mm_storeu_si128( (__m128i *) &( hash_values[ 0 ] ), abef_values );
+	_mm_storeu_si128( (__m128i *) &( hash_values[ 4 ] ), cdgh_values );
+}
+
+#endif /* defined( HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS ) */
+
+#if defined( HAVE_DIGEST_CONTEXT_ARMV8_CRYPTO )
+
+/* Calculates the SHA256 of 64 byte blocks using the ARMv8 cryptographic extension
+ */
+static void digest_context_sha256_transform_armv8_crypto(
+             uint32_t *hash_values,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	uint32x4_t messages[ 4 ];
+
+	uint32x4_t abcd_values      = vld1q_u32( &( hash_values[ 0 ] ) );
+	uint32x4_t abcd_values_save = abcd_values;
+	uint32x4_t efgh_values      = vld1q_u32( &( hash_values[ 4 ] ) );
+	uint32x4_t efgh_values_save = efgh_values;
+	uint32x4_t message          = abcd_values;
+	uint32x4_t values           = abcd_values;
+	uint8_t group_index         = 0;
+
+	while( number_of_blocks > 0 )
+	{
+		abcd_values_save = abcd_values;
+		efgh_values_save = efgh_values;
+
+		for( group_index = 0;
+		     group_index < 4;
+		     group_index++ )
+		{
+			messages[ group_index ] = vreinterpretq_u32_u8(
+			                           vrev32q_u8(
+			                            vld1q_u8( &( buffer[ group_index * 16 ] ) ) ) );
+		}
+		/* Every group calculates 4 rounds
+		 */
+		for( group_index = 0;
+		     group_index < 16;
+		     group_index++ )
+		{
+			message = vaddq_u32(
+			           messages[ group_index % 4 ],
+			           vld1q_u32( &( digest_context_sha256_prime_square_roots[ group_index * 4 ] ) ) );
+
+			/* Replace the message of this group by that of group + 4
+			 */
+			if( group_index < 12 )
+			{
+				messages[ group_index % 4 ] = vsha256su1q_u32(
+				                               vsha256su0q_u32( messages[ group_index % 4 ], messages[ ( group_index + 1 ) % 4 ] ),
+				                               messages[ ( group_index + 2 ) % 4 ],
+				                               messages[ ( group_index + 3 ) % 4 ] );
+			}
+			values      = abcd_values;
+			abcd_values = vsha256hq_u32( abcd_values, efgh_values, message );
+			efgh_values = vsha256h2q_u32( efgh_values, values, message );
+		}
+		abcd_values = vaddq_u32( abcd_values, abcd_values_save );
+		efgh_values = vaddq_u32( efgh_values, efgh_values_save );
+
+		buffer           += DIGEST_CONTEXT_BLOCK_SIZE;
+		number_of_blocks -= 1;
+	}
+	vst1q_u32( &( hash_values[ 0 ] ), abcd_values );
+	vst1q_u32( &( hash_values[ 4 ] ), efgh_values );
+}
+
+#endif /* defined( HAVE_DIGEST_CONTEXT_ARMV8_CRYPTO ) */
+
+/* Calculates the digest hash of 64 byte blocks
+ */
+static void digest_context_transform(
+             digest_context_t *digest_context,
+             const uint8_t *buffer,
+             size_t number_of_blocks )
+{
+	switch( digest_context->type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			digest_context_md5_transform(
+			 digest_context->hash_values,
+			 buffer,
+			 number_of_blocks );
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+#if defined( HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS )
+			if( digest_context->backend == DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS )
+			{
+				digest_context_sha1_transform_sha_extensions(
+				 digest_context->hash_values,
+				 buffer,
+				 number_of_blocks );
+
+				break;
+			}
+#endif
+			digest_context_sha1_transform(
+			 digest_context->hash_values,
+			 buffer,
+			 number_of_blocks );
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+#if defined( HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS )
+			if( digest_context->backend == DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS )
+			{
+				digest_context_sha256_transform_sha_extensions(
+				 digest_context->hash_values,
+				 buffer,
+				 number_of_blocks );
+
+				break;
+			}
+#endif
+#if defined( HAVE_DIGEST_CONTEXT_ARMV8_CRYPTO )
+			if( digest_context->backend == DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO )
+			{
+				digest_context_sha256_transform_armv8_crypto(
+				 digest_context->hash_values,
+				 buffer,
+				 number_of_blocks );
+
+				break;
+			}
+#endif
+			digest_context_sha256_transform(
+			 digest_context->hash_values,
+			 buffer,
+			 number_of_blocks );
+			break;
+	}
+}
+
+/* Creates a digest context
+ * Make sure the value digest_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_initialize(
+     digest_context_t **digest_context,
+     int type,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_initialize";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( type != DIGEST_CONTEXT_TYPE_MD5 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA1 )
+	 && ( type != DIGEST_CONTEXT_TYPE_SHA256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported type.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_context = memory_allocate_structure(
+	                   digest_context_t );
+
+	if( *digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest context.",
+		 function );
+
+		goto on_error;
+	}
+	( *digest_context )->type    = type;
+	( *digest_context )->backend = DIGEST_CONTEXT_BACKEND_GENERIC;
+
+	if( digest_context_set_backend(
+	     *digest_context,
+	     DIGEST_CONTEXT_BACKEND_AUTO,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set backend.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest_context_reset(
+	     *digest_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to reset digest context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_context != NULL )
+	{
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_free(
+     digest_context_t **digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_free";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_context != NULL )
+	{
+		memory_free(
+		 *digest_context );
+
+		*digest_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Resets a digest context to its initial state
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_reset(
+     digest_context_t *digest_context,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_reset";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     digest_context->hash_values,
+	     0,
+	     sizeof( uint32_t ) * 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash values.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_context->type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			if( memory_copy(
+			     digest_context->hash_values,
+			     digest_context_md5_initial_hash_values,
+			     sizeof( uint32_t ) * 4 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy initial hash values.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+			if( memory_copy(
+			     digest_context->hash_values,
+			     digest_context_sha1_initial_hash_values,
+			     sizeof( uint32_t ) * 5 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy initial hash values.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+			if( memory_copy(
+			     digest_context->hash_values,
+			     digest_context_sha256_initial_hash_values,
+			     sizeof( uint32_t ) * 8 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy initial hash values.",
+				 function );
+
+				return( -1 );
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid digest context - unsupported type.",
+			 function );
+
+			return( -1 );
+	}
+	digest_context->number_of_bytes_hashed = 0;
+	digest_context->block_offset           = 0;
+
+	return( 1 );
+}
+
+/* Determines if a backend is supported
+ * Returns 1 if supported or 0 if not
+ */
+int digest_context_backend_is_supported(
+     int backend )
+{
+	switch( backend )
+	{
+		case DIGEST_CONTEXT_BACKEND_AUTO:
+		case DIGEST_CONTEXT_BACKEND_GENERIC:
+			return( 1 );
+
+#if defined( HAVE_DIGEST_CONTEXT_SHA_EXTENSIONS )
+		case DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS:
+			return( digest_context_get_cpu_has_sha_extensions() );
+#endif
+
+#if defined( HAVE_DIGEST_CONTEXT_ARMV8_CRYPTO )
+		case DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO:
+			return( 1 );
+#endif
+
+		default:
+			break;
+	}
+	return( 0 );
+}
+
+/* Retrieves the backend
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_get_backend(
+     digest_context_t *digest_context,
+     int *backend,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_get_backend";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid backend.",
+		 function );
+
+		return( -1 );
+	}
+	*backend = digest_context->backend;
+
+	return( 1 );
+}
+
+/* Sets the backend
+ * The auto backend selects the fastest backend supported by the CPU
+ * MD5 has no accelerated backend and is always calculated by the generic backend
+ * The backend does not affect the (intermediate) state so it can be changed at any time
+ * Returns 1 if successful, 0 if the backend is not supported or -1 on error
+ */
+int digest_context_set_backend(
+     digest_context_t *digest_context,
+     int backend,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_set_backend";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( backend != DIGEST_CONTEXT_BACKEND_AUTO )
+	 && ( backend != DIGEST_CONTEXT_BACKEND_GENERIC )
+	 && ( backend != DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS )
+	 && ( backend != DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported backend.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context_backend_is_supported(
+	     backend ) == 0 )
+	{
+		return( 0 );
+	}
+	if( backend == DIGEST_CONTEXT_BACKEND_AUTO )
+	{
+		backend = DIGEST_CONTEXT_BACKEND_GENERIC;
+
+		if( digest_context_backend_is_supported(
+		     DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS ) != 0 )
+		{
+			backend = DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS;
+		}
+		else if( digest_context_backend_is_supported(
+		          DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO ) != 0 )
+		{
+			backend = DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO;
+		}
+	}
+	digest_context->backend = backend;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the digest hash
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_get_hash_size(
+     digest_context_t *digest_context,
+     size_t *hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_get_hash_size";
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash size.",
+		 function );
+
+		return( -1 );
+	}
+	switch( digest_context->type )
+	{
+		case DIGEST_CONTEXT_TYPE_MD5:
+			*hash_size = DIGEST_CONTEXT_MD5_HASH_SIZE;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA1:
+			*hash_size = DIGEST_CONTEXT_SHA1_HASH_SIZE;
+			break;
+
+		case DIGEST_CONTEXT_TYPE_SHA256:
+			*hash_size = DIGEST_CONTEXT_SHA256_HASH_SIZE;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: invalid digest context - unsupported type.",
+			 function );
+
+			return( -1 );
+	}
+	return( 1 );
+}
+
+/* Updates the digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_update(
+     digest_context_t *digest_context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function   = "digest_context_update";
+	size_t buffer_offset    = 0;
+	size_t number_of_blocks = 0;
+	size_t remaining_size   = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->block_offset >= DIGEST_CONTEXT_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest context - block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	digest_context->number_of_bytes_hashed += size;
+
+	if( digest_context->block_offset > 0 )
+	{
+		remaining_size = DIGEST_CONTEXT_BLOCK_SIZE - digest_context->block_offset;
+
+		if( remaining_size > size )
+		{
+			remaining_size = size;
+		}
+		if( memory_copy(
+		     &( digest_context->block[ digest_context->block_offset ] ),
+		     buffer,
+		     remaining_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context->block_offset += remaining_size;
+		buffer_offset                += remaining_size;
+
+		if( digest_context->block_offset < DIGEST_CONTEXT_BLOCK_SIZE )
+		{
+			return( 1 );
+		}
+		digest_context_transform(
+		 digest_context,
+		 digest_context->block,
+		 1 );
+
+		digest_context->block_offset = 0;
+	}
+	number_of_blocks = ( size - buffer_offset ) / DIGEST_CONTEXT_BLOCK_SIZE;
+
+	if( number_of_blocks > 0 )
+	{
+		digest_context_transform(
+		 digest_context,
+		 &( buffer[ buffer_offset ] ),
+		 number_of_blocks );
+
+		buffer_offset += number_of_blocks * DIGEST_CONTEXT_BLOCK_SIZE;
+	}
+	remaining_size = size - buffer_offset;
+
+	if( remaining_size > 0 )
+	{
+		if( memory_copy(
+		     digest_context->block,
+		     &( buffer[ buffer_offset ] ),
+		     remaining_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context->block_offset = remaining_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes the digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_finalize(
+     digest_context_t *digest_context,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "digest_context_finalize";
+	size_t block_offset     = 0;
+	size_t calculated_size  = 0;
+	size_t hash_index       = 0;
+	uint64_t number_of_bits = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context_get_hash_size(
+	     digest_context,
+	     &calculated_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve hash size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_size < calculated_size )
+	 || ( hash_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->block_offset >= DIGEST_CONTEXT_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest context - block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_bits = digest_context->number_of_bytes_hashed * 8;
+	block_offset   = digest_context->block_offset;
+
+	/* Add the padding: a 1-bit, zero bytes and the 64-bit number of bits
+	 */
+	digest_context->block[ block_offset++ ] = 0x80;
+
+	if( block_offset > ( DIGEST_CONTEXT_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( digest_context->block[ block_offset ] ),
+		     0,
+		     DIGEST_CONTEXT_BLOCK_SIZE - block_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block.",
+			 function );
+
+			return( -1 );
+		}
+		digest_context_transform(
+		 digest_context,
+		 digest_context->block,
+		 1 );
+
+		block_offset = 0;
+	}
+	if( memory_set(
+	     &( digest_context->block[ block_offset ] ),
+	     0,
+	     ( DIGEST_CONTEXT_BLOCK_SIZE - 8 ) - block_offset ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_context->type == DIGEST_CONTEXT_TYPE_MD5 )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( digest_context->block[ DIGEST_CONTEXT_BLOCK_SIZE - 8 ] ),
+		 number_of_bits );
+	}
+	else
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( digest_context->block[ DIGEST_CONTEXT_BLOCK_SIZE - 8 ] ),
+		 number_of_bits );
+	}
+	digest_context_transform(
+	 digest_context,
+	 digest_context->block,
+	 1 );
+
+	for( hash_index = 0;
+	     hash_index < ( calculated_size / 4 );
+	     hash_index++ )
+	{
+		if( digest_context->type == DIGEST_CONTEXT_TYPE_MD5 )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( hash[ hash_index * 4 ] ),
+			 digest_context->hash_values[ hash_index ] );
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( hash[ hash_index * 4 ] ),
+			 digest_context->hash_values[ hash_index ] );
+		}
+	}
+	if( digest_context_reset(
+	     digest_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to reset digest context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the intermediate state of the digest context
+ * The state is stored in a platform independent format of DIGEST_CONTEXT_STATE_SIZE bytes
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_get_state(
+     digest_context_t *digest_context,
+     uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_context_get_state";
+	size_t hash_index     = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size < DIGEST_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid state size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( state[ 0 ] ),
+	 (uint32_t) digest_context->type );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( state[ 4 ] ),
+	 (uint32_t) digest_context->block_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( state[ 8 ] ),
+	 digest_context->number_of_bytes_hashed );
+
+	for( hash_index = 0;
+	     hash_index < 8;
+	     hash_index++ )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( state[ 16 + ( hash_index * 4 ) ] ),
+		 digest_context->hash_values[ hash_index ] );
+	}
+	if( memory_copy(
+	     &( state[ 48 ] ),
+	     digest_context->block,
+	     DIGEST_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the intermediate state of the digest context
+ * Returns 1 if successful or -1 on error
+ */
+int digest_context_set_state(
+     digest_context_t *digest_context,
+     const uint8_t *state,
+     size_t state_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "digest_context_set_state";
+	size_t hash_index               = 0;
+	uint64_t number_of_bytes_hashed = 0;
+	uint32_t block_offset           = 0;
+	uint32_t type                   = 0;
+
+	if( digest_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest context.",
+		 function );
+
+		return( -1 );
+	}
+	if( state == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_size < DIGEST_CONTEXT_STATE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid state size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( state[ 0 ] ),
+	 type );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( state[ 4 ] ),
+	 block_offset );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( state[ 8 ] ),
+	 number_of_bytes_hashed );
+
+	if( type != (uint32_t) digest_context->type )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported state type: %" PRIu32 ".",
+		 function,
+		 type );
+
+		return( -1 );
+	}
+	if( ( block_offset >= DIGEST_CONTEXT_BLOCK_SIZE )
+	 || ( block_offset != (uint32_t) ( number_of_bytes_hashed % DIGEST_CONTEXT_BLOCK_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid state - block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( hash_index = 0;
+	     hash_index < 8;
+	     hash_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( state[ 16 + ( hash_index * 4 ) ] ),
+		 digest_context->hash_values[ hash_index ] );
+	}
+	if( memory_copy(
+	     digest_context->block,
+	     &( state[ 48 ] ),
+	     DIGEST_CONTEXT_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy block.",
+		 function );
+
+		return( -1 );
+	}
+	digest_context->number_of_bytes_hashed = number_of_bytes_hashed;
+	digest_context->block_offset           = (size_t) block_offset;
+
+	return( 1 );
+}
+
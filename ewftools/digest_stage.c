@@ -0,0 +1,1022 @@
+/*
+ * Digest (hash) calculation stage
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_stage.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest stage
+ * Make sure the value digest_stage is referencing, is set to NULL
+ * The release function is called, from one of the digest threads, when all digests
+ * have been updated with a value. Values are released in the order they were pushed.
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_initialize(
+     digest_stage_t **digest_stage,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_initialize";
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_stage != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest stage value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_queued_values <= 0 )
+	 || ( maximum_number_of_queued_values > (int) ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of queued values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( release_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid release function.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_stage = memory_allocate_structure(
+	                 digest_stage_t );
+
+	if( *digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest stage.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_stage,
+	     0,
+	     sizeof( digest_stage_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest stage.",
+		 function );
+
+		memory_free(
+		 *digest_stage );
+
+		*digest_stage = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_stage )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *digest_stage )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *digest_stage )->maximum_number_of_queued_values = maximum_number_of_queued_values;
+	( *digest_stage )->release_function                = release_function;
+	( *digest_stage )->release_function_arguments      = release_function_arguments;
+
+	return( 1 );
+
+on_error:
+	if( *digest_stage != NULL )
+	{
+		if( ( *digest_stage )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *digest_stage )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *digest_stage );
+
+		*digest_stage = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a digest stage
+ * The digest threads are joined if this was not done before
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_free(
+     digest_stage_t **digest_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_free";
+	int digest_index      = 0;
+	int result            = 1;
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_stage != NULL )
+	{
+		for( digest_index = 0;
+		     digest_index < ( *digest_stage )->number_of_digests;
+		     digest_index++ )
+		{
+			if( ( *digest_stage )->digests[ digest_index ].thread_pool != NULL )
+			{
+				if( libcthreads_thread_pool_join(
+				     &( ( *digest_stage )->digests[ digest_index ].thread_pool ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join digest: %d thread pool.",
+					 function,
+					 digest_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *digest_stage )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *digest_stage )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *digest_stage );
+
+		*digest_stage = NULL;
+	}
+	return( result );
+}
+
+/* Appends a digest to the digest stage
+ * Every digest is updated by its own thread, so that the digests are calculated concurrently
+ * This function should be called before any value is pushed onto the digest stage
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_append_digest(
+     digest_stage_t *digest_stage,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	digest_stage_digest_t *digest = NULL;
+	static char *function         = "digest_stage_append_digest";
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_stage->number_of_digests >= DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid digest stage - number of digests value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( update_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid update function.",
+		 function );
+
+		return( -1 );
+	}
+	digest = &( digest_stage->digests[ digest_stage->number_of_digests ] );
+
+	digest->digest_stage    = digest_stage;
+	digest->context         = context;
+	digest->update_function = update_function;
+
+	if( libcthreads_thread_pool_create(
+	     &( digest->thread_pool ),
+	     NULL,
+	     1,
+	     digest_stage->maximum_number_of_queued_values,
+	     (int (*)(intptr_t *, void *)) &digest_stage_update_callback,
+	     (void *) digest,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest thread pool.",
+		 function );
+
+		digest->digest_stage    = NULL;
+		digest->context         = NULL;
+		digest->update_function = NULL;
+
+		return( -1 );
+	}
+	digest_stage->number_of_digests += 1;
+
+	return( 1 );
+}
+
+/* Sets the stage profiler
+ * The digest updates are profiled as the hash stage
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_set_stage_profiler(
+     digest_stage_t *digest_stage,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_set_stage_profiler";
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	digest_stage->stage_profiler = stage_profiler;
+
+	return( 1 );
+}
+
+/* Pushes a value onto the digest stage
+ * The data is shared, read-only, by all digests and must not be modified until the value is released
+ * The value is always passed to the release function, also when pushing the value fails
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_push(
+     digest_stage_t *digest_stage,
+     intptr_t *value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	digest_stage_value_t *digest_stage_value = NULL;
+	static char *function                    = "digest_stage_push";
+	int64_t start_timestamp                  = 0;
+	int digest_index                         = 0;
+	int number_of_pending_values             = 0;
+	uint8_t has_failed                       = 0;
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	digest_stage->number_of_pending_values += 1;
+
+	number_of_pending_values = digest_stage->number_of_pending_values;
+	has_failed               = digest_stage->has_failed;
+
+	if( libcthreads_mutex_release(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate digest(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		goto on_error;
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	digest_stage_value = memory_allocate_structure(
+	                      digest_stage_value_t );
+
+	if( digest_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest stage value.",
+		 function );
+
+		goto on_error;
+	}
+	digest_stage_value->value                = value;
+	digest_stage_value->data                 = data;
+	digest_stage_value->data_size            = data_size;
+	digest_stage_value->number_of_references = digest_stage->number_of_digests;
+
+	/* Profiling is best effort and does not affect the digests
+	 */
+	if( digest_stage->stage_profiler != NULL )
+	{
+		stage_profiler_add_queue_depth(
+		 digest_stage->stage_profiler,
+		 STAGE_PROFILER_QUEUE_DIGEST,
+		 (uint64_t) number_of_pending_values,
+		 NULL );
+
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+	}
+	/* Note that the digest stage value can be released by the digest threads
+	 * as soon as it has been pushed onto the last digest thread pool
+	 */
+	for( digest_index = 0;
+	     digest_index < digest_stage->number_of_digests;
+	     digest_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     digest_stage->digests[ digest_index ].thread_pool,
+		     (intptr_t *) digest_stage_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push value onto digest: %d thread pool queue.",
+			 function,
+			 digest_index );
+
+			break;
+		}
+	}
+	/* Pushing blocks while the thread pool queue of a digest is full
+	 */
+	if( digest_stage->stage_profiler != NULL )
+	{
+		stage_profiler_add_wait(
+		 digest_stage->stage_profiler,
+		 STAGE_PROFILER_STAGE_HASH,
+		 start_timestamp,
+		 NULL );
+	}
+	if( ( digest_index < digest_stage->number_of_digests )
+	 || ( digest_stage->number_of_digests == 0 ) )
+	{
+		/* Drop the references of the digests the value was not pushed onto
+		 */
+		if( digest_stage_release_value(
+		     digest_stage,
+		     &digest_stage_value,
+		     digest_stage->number_of_digests - digest_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to release value.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_index < digest_stage->number_of_digests )
+		{
+			if( libcthreads_mutex_grab(
+			     digest_stage->mutex,
+			     NULL ) == 1 )
+			{
+				digest_stage->has_failed = 1;
+
+				libcthreads_mutex_release(
+				 digest_stage->mutex,
+				 NULL );
+			}
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	digest_stage->release_function(
+	 value,
+	 digest_stage->release_function_arguments );
+
+	if( libcthreads_mutex_grab(
+	     digest_stage->mutex,
+	     NULL ) == 1 )
+	{
+		digest_stage->number_of_pending_values -= 1;
+		digest_stage->has_failed                = 1;
+
+		if( digest_stage->number_of_pending_values == 0 )
+		{
+			libcthreads_condition_broadcast(
+			 digest_stage->condition,
+			 NULL );
+		}
+		libcthreads_mutex_release(
+		 digest_stage->mutex,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases references to a value of the digest stage
+ * The release function is called and the digest stage value is freed when no more references remain
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_release_value(
+     digest_stage_t *digest_stage,
+     digest_stage_value_t **digest_stage_value,
+     int number_of_references,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_release_value";
+	int is_released       = 0;
+	int result            = 1;
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing digest stage value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	( *digest_stage_value )->number_of_references -= number_of_references;
+
+	if( ( *digest_stage_value )->number_of_references <= 0 )
+	{
+		is_released = 1;
+	}
+	if( libcthreads_mutex_release(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_released == 0 )
+	{
+		*digest_stage_value = NULL;
+
+		return( 1 );
+	}
+	/* The release function is called before the value is no longer pending
+	 * so that digest_stage_wait also waits for the release function to complete
+	 */
+	if( digest_stage->release_function(
+	     ( *digest_stage_value )->value,
+	     digest_stage->release_function_arguments ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release value.",
+		 function );
+
+		result = -1;
+	}
+	memory_free(
+	 *digest_stage_value );
+
+	*digest_stage_value = NULL;
+
+	if( libcthreads_mutex_grab(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	digest_stage->number_of_pending_values -= 1;
+
+	if( result != 1 )
+	{
+		digest_stage->has_failed = 1;
+	}
+	if( digest_stage->number_of_pending_values == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     digest_stage->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits until all values pushed onto the digest stage have been released
+ * After this function returns the digest contexts can be accessed, until the next value is pushed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_wait(
+     digest_stage_t *digest_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_wait";
+	uint8_t has_failed    = 0;
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( digest_stage->number_of_pending_values > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     digest_stage->condition,
+		     digest_stage->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 digest_stage->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	has_failed = digest_stage->has_failed;
+
+	if( libcthreads_mutex_release(
+	     digest_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate digest(s).",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the digest threads
+ * The values that are still queued are processed before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_join(
+     digest_stage_t *digest_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_stage_join";
+	int digest_index      = 0;
+	int result            = 1;
+
+	if( digest_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_index = 0;
+	     digest_index < digest_stage->number_of_digests;
+	     digest_index++ )
+	{
+		if( digest_stage->digests[ digest_index ].thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( digest_stage->digests[ digest_index ].thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest: %d thread pool.",
+				 function,
+				 digest_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		result = digest_stage_wait(
+		          digest_stage,
+		          error );
+	}
+	return( result );
+}
+
+/* Updates a digest with a value
+ * Callback function for the digest thread pools
+ * Returns 1 if successful or -1 on error
+ */
+int digest_stage_update_callback(
+     digest_stage_value_t *digest_stage_value,
+     digest_stage_digest_t *digest )
+{
+	digest_stage_t *digest_stage = NULL;
+	libcerror_error_t *error     = NULL;
+	static char *function        = "digest_stage_update_callback";
+	int64_t start_timestamp      = 0;
+	int result                   = 1;
+
+	if( digest_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest stage value.",
+		 function );
+
+		goto on_error;
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		goto on_error;
+	}
+	digest_stage = digest->digest_stage;
+
+	/* Once a digest failed the remaining values are only released
+	 */
+	if( ( digest_stage->has_failed == 0 )
+	 && ( digest_stage_value->data_size > 0 ) )
+	{
+		if( digest_stage->stage_profiler != NULL )
+		{
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+		}
+		if( digest->update_function(
+		     digest->context,
+		     digest_stage_value->data,
+		     digest_stage_value->data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest.",
+			 function );
+
+			result = -1;
+
+			if( libcthreads_mutex_grab(
+			     digest_stage->mutex,
+			     NULL ) == 1 )
+			{
+				digest_stage->has_failed = 1;
+
+				libcthreads_mutex_release(
+				 digest_stage->mutex,
+				 NULL );
+			}
+		}
+		else if( digest_stage->stage_profiler != NULL )
+		{
+			stage_profiler_add_sample(
+			 digest_stage->stage_profiler,
+			 STAGE_PROFILER_STAGE_HASH,
+			 start_timestamp,
+			 (uint64_t) digest_stage_value->data_size,
+			 NULL );
+		}
+	}
+	if( digest_stage_release_value(
+	     digest_stage,
+	     &digest_stage_value,
+	     1,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release digest stage value.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,195 @@
+/*
+ * Digest (hash) calculation stage
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_STAGE_H )
+#define _DIGEST_STAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of digests calculated by a stage: MD5, SHA1 and SHA256
+ */
+#define DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS	3
+
+typedef struct digest_stage digest_stage_t;
+
+typedef struct digest_stage_digest digest_stage_digest_t;
+
+struct digest_stage_digest
+{
+	/* The digest stage
+	 */
+	digest_stage_t *digest_stage;
+
+	/* The digest context
+	 */
+	intptr_t *context;
+
+	/* The digest context update function
+	 */
+	int (*update_function)(
+	       intptr_t *context,
+	       const uint8_t *buffer,
+	       size_t size,
+	       libcerror_error_t **error );
+
+	/* The thread pool, that contains a single thread to keep the updates in order
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+typedef struct digest_stage_value digest_stage_value_t;
+
+struct digest_stage_value
+{
+	/* The value, which is passed to the release function
+	 */
+	intptr_t *value;
+
+	/* The data, which is shared by the digests and not modified
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The number of digests that still reference the value
+	 */
+	int number_of_references;
+};
+
+struct digest_stage
+{
+	/* The digests
+	 */
+	digest_stage_digest_t digests[ DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS ];
+
+	/* The number of digests
+	 */
+	int number_of_digests;
+
+	/* The maximum number of queued values per digest
+	 */
+	int maximum_number_of_queued_values;
+
+	/* The release function, which is called when all digests have been updated with a value
+	 */
+	int (*release_function)(
+	       intptr_t *value,
+	       void *arguments );
+
+	/* The release function arguments
+	 */
+	void *release_function_arguments;
+
+	/* The number of values that are pending to be released
+	 */
+	int number_of_pending_values;
+
+	/* Value to indicate updating a digest or releasing a value failed
+	 */
+	uint8_t has_failed;
+
+	/* The stage profiler, which is not owned by the digest stage
+	 */
+	stage_profiler_t *stage_profiler;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when there are no more pending values
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int digest_stage_initialize(
+     digest_stage_t **digest_stage,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error );
+
+int digest_stage_free(
+     digest_stage_t **digest_stage,
+     libcerror_error_t **error );
+
+int digest_stage_append_digest(
+     digest_stage_t *digest_stage,
+     intptr_t *context,
+     int (*update_function)(
+            intptr_t *context,
+            const uint8_t *buffer,
+            size_t size,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int digest_stage_set_stage_profiler(
+     digest_stage_t *digest_stage,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error );
+
+int digest_stage_push(
+     digest_stage_t *digest_stage,
+     intptr_t *value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int digest_stage_release_value(
+     digest_stage_t *digest_stage,
+     digest_stage_value_t **digest_stage_value,
+     int number_of_references,
+     libcerror_error_t **error );
+
+int digest_stage_wait(
+     digest_stage_t *digest_stage,
+     libcerror_error_t **error );
+
+int digest_stage_join(
+     digest_stage_t *digest_stage,
+     libcerror_error_t **error );
+
+int digest_stage_update_callback(
+     digest_stage_value_t *digest_stage_value,
+     digest_stage_digest_t *digest );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_STAGE_H ) */
+
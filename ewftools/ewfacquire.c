@@ -38,6 +38,8 @@
 #include <stdlib.h>
 #endif
 
+#include "batch_file.h"
+#include "buffer_limiter.h"
 #include "byte_size_string.h"
 #include "device_handle.h"
 #include "ewfcommon.h"
@@ -53,7 +55,9 @@
 #include "ewftools_unused.h"
 #include "imaging_handle.h"
 #include "log_handle.h"
+#include "process_pool.h"
 #include "process_status.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
@@ -66,6 +70,116 @@
 #define EWFACQUIRE_INPUT_BUFFER_SIZE			64
 #define EWFACQUIRE_MAXIMUM_PROCESS_BUFFERS_SIZE		64 * 1024 * 1024
 
+typedef struct ewfacquire_batch_options ewfacquire_batch_options_t;
+
+struct ewfacquire_batch_options
+{
+	/* The additional digest types
+	 */
+	system_character_t *additional_digest_types;
+
+	/* The bytes per sector
+	 */
+	system_character_t *bytes_per_sector;
+
+	/* The case number
+	 */
+	system_character_t *case_number;
+
+	/* The compression values
+	 */
+	system_character_t *compression_values;
+
+	/* The description, which is used when the job does not specify one
+	 */
+	system_character_t *description;
+
+	/* The evidence number, which is used when the job does not specify one
+	 */
+	system_character_t *evidence_number;
+
+	/* The examiner name
+	 */
+	system_character_t *examiner_name;
+
+	/* The format
+	 */
+	system_character_t *format;
+
+	/* The hash backend
+	 */
+	system_character_t *hash_backend;
+
+	/* The header codepage
+	 */
+	system_character_t *header_codepage;
+
+	/* The maximum segment size
+	 */
+	system_character_t *maximum_segment_size;
+
+	/* The media flags
+	 */
+	system_character_t *media_flags;
+
+	/* The media type
+	 */
+	system_character_t *media_type;
+
+	/* The notes
+	 */
+	system_character_t *notes;
+
+	/* The number of error retries
+	 */
+	system_character_t *number_of_error_retries;
+
+	/* The number of jobs (threads)
+	 */
+	system_character_t *number_of_jobs;
+
+	/* The offset
+	 */
+	system_character_t *offset;
+
+	/* The process buffer size
+	 */
+	system_character_t *process_buffer_size;
+
+	/* The read options
+	 */
+	system_character_t *read_options;
+
+	/* The sector error granularity
+	 */
+	system_character_t *sector_error_granularity;
+
+	/* The sectors per chunk
+	 */
+	system_character_t *sectors_per_chunk;
+
+	/* The size
+	 */
+	system_character_t *size;
+
+	/* The write options
+	 */
+	system_character_t *write_options;
+
+	/* Value to indicate if read errors should be isolated using multiple passes
+	 */
+	uint8_t isolate_read_errors;
+
+	/* Value to indicate if the data chunk functions should be used
+	 */
+	uint8_t use_data_chunk_functions;
+
+	/* Value to indicate if sectors should be zeroed on read error
+	 */
+	uint8_t zero_buffer_on_error;
+};
+
+batch_file_t *ewfacquire_batch_file         = NULL;
 device_handle_t *ewfacquire_device_handle   = NULL;
 imaging_handle_t *ewfacquire_imaging_handle = NULL;
 int ewfacquire_abort                        = 0;
@@ -127,14 +241,18 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -g number_of_sectors ] [ -H hash_backend ]\n"
+	                 "                  [ -I read_options ] [ -j jobs ]\n"
+	                 "                  [ -J metrics_filename ] [ -l log_filename ]\n"
+	                 "                  [ -L job_filename ] [ -m media_type ]\n"
+	                 "                  [ -M media_flags ] [ -N notes ] [ -o offset ]\n"
+	                 "                  [ -O write_options ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
-	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -S segment_file_size ] [ -t target ]\n"
+	                 "                  [ -T toc_file ] [ -2 secondary_target ]\n"
+	                 "                  [ -hqRsuvVwx ] source\n\n" );
 
-	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
+	fprintf( stream, "\tsource: the source file(s) or device, not used with -L\n\n" );
 
 	fprintf( stream, "\t-A:     codepage of header section, options: ascii (default),\n"
 	                 "\t        windows-874, windows-932, windows-936, windows-949,\n"
@@ -165,15 +283,35 @@ void ewfacquire_usage_fprint(
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-H:     specify the digest (hash) calculation backend, options: auto\n"
+	                 "\t        (default), generic, sha-ni or armv8\n" );
+	fprintf( stream, "\t-i:     isolate read errors using multiple passes, the good areas are\n"
+	                 "\t        read first after which the failed blocks are split, the areas\n"
+	                 "\t        still to do are stored in a rescue map next to the target\n" );
+	fprintf( stream, "\t-I:     specify the read options, options: none (default) or direct\n"
+	                 "\t        (read the source using direct IO, bypassing the page cache,\n"
+	                 "\t        with a number of reads queued ahead)\n" );
 	fprintf( stream, "\t-j:     the number of concurrent processing jobs (threads), where\n"
-	                 "\t        a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t        if multi-threaded mode is supported)\n" );
+	                 "\t        0 represents single-threaded mode, \"auto\" sizes the number\n"
+	                 "\t        of threads and buffers to the available processors and memory\n"
+	                 "\t        (default is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J:     writes metrics, as one JSON record per line, to the\n"
+	                 "\t        metrics_filename every second and when the acquiry stops,\n"
+	                 "\t        use /dev/fd/N to write to an open file descriptor\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
+	fprintf( stream, "\t-L:     acquire multiple sources in unattended mode, as specified by\n"
+	                 "\t        the job_filename, where every line contains the source, target\n"
+	                 "\t        and optionally the evidence number and description separated\n"
+	                 "\t        by tabs. The sources are acquired concurrently and share the\n"
+	                 "\t        processing jobs (threads) and buffers.\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     specify the write options as a comma separated list, options:\n"
+	                 "\t        none (default), preallocate (preallocate segment files) or\n"
+	                 "\t        direct (write segment files using direct IO)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -223,13 +361,59 @@ void ewfacquire_usage_fprint(
 void ewfacquire_signal_handler(
       ewftools_signal_t signal EWFTOOLS_ATTRIBUTE_UNUSED )
 {
+	batch_job_t *batch_job   = NULL;
 	libcerror_error_t *error = NULL;
 	static char *function   = "ewfacquire_signal_handler";
+	int job_index            = 0;
 
 	EWFTOOLS_UNREFERENCED_PARAMETER( signal )
 
 	ewfacquire_abort = 1;
 
+	if( ewfacquire_batch_file != NULL )
+	{
+		for( job_index = 0;
+		     job_index < ewfacquire_batch_file->number_of_jobs;
+		     job_index++ )
+		{
+			batch_job = ewfacquire_batch_file->jobs[ job_index ];
+
+			if( batch_job->device_handle != NULL )
+			{
+				if( device_handle_signal_abort(
+				     batch_job->device_handle,
+				     &error ) != 1 )
+				{
+					libcnotify_printf(
+					 "%s: unable to signal device handle of job: %d to abort.\n",
+					 function,
+					 job_index );
+
+					libcnotify_print_error_backtrace(
+					 error );
+					libcerror_error_free(
+					 &error );
+				}
+			}
+			if( batch_job->imaging_handle != NULL )
+			{
+				if( imaging_handle_signal_abort(
+				     batch_job->imaging_handle,
+				     &error ) != 1 )
+				{
+					libcnotify_printf(
+					 "%s: unable to signal imaging handle of job: %d to abort.\n",
+					 function,
+					 job_index );
+
+					libcnotify_print_error_backtrace(
+					 error );
+					libcerror_error_free(
+					 &error );
+				}
+			}
+		}
+	}
 	if( ewfacquire_device_handle != NULL )
 	{
 		if( device_handle_signal_abort(
@@ -586,12 +770,10 @@ int ewfacquire_read_input(
      uint8_t swap_byte_pairs,
      uint8_t print_status_information,
      uint8_t use_data_chunk_functions,
-     log_handle_t *log_handle,
      libcerror_error_t **error )
 {
 	storage_media_buffer_t *storage_media_buffer = NULL;
 	static char *function                        = "ewfacquire_read_input";
-	size64_t acquiry_count                       = 0;
 	size64_t read_error_size                     = 0;
 	size64_t remaining_aquiry_size               = 0;
 	size_t process_buffer_size                   = 0;
@@ -599,11 +781,14 @@ int ewfacquire_read_input(
 	ssize_t process_count                        = 0;
 	ssize_t read_count                           = 0;
 	ssize_t write_count                          = 0;
+	off64_t checkpoint_offset                    = 0;
 	off64_t read_error_offset                    = 0;
 	off64_t storage_media_offset                 = 0;
+	int64_t start_timestamp                      = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int number_of_read_errors                    = 0;
         int read_error_iterator                      = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -749,6 +934,17 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The secondary output is written by its own thread, the chunk data is packed
+	 * once by the process threads and shared by both outputs
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->secondary_output_handle != NULL ) )
+	{
+		use_data_chunk_functions = 1;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( imaging_handle_get_process_buffer_size(
 	     imaging_handle,
 	     use_data_chunk_functions,
@@ -828,6 +1024,48 @@ int ewfacquire_read_input(
 	}
 	remaining_aquiry_size = imaging_handle->acquiry_size;
 
+	if( resume_acquiry_offset > 0 )
+	{
+		/* Only the data after the last checkpoint needs to be read back
+		 * to restore the integrity hash(es)
+		 */
+		result = imaging_handle_restore_checkpoint(
+		          imaging_handle,
+		          resume_acquiry_offset,
+		          &checkpoint_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to restore checkpoint.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( imaging_handle_seek_offset(
+			     imaging_handle,
+			     checkpoint_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek imaging offset.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_offset   = checkpoint_offset;
+			remaining_aquiry_size -= (size64_t) checkpoint_offset;
+		}
+	}
 	while( remaining_aquiry_size > 0 )
 	{
 		if( imaging_handle->abort != 0 )
@@ -838,6 +1076,28 @@ int ewfacquire_read_input(
 		if( ( storage_media_buffer == NULL )
 		 && ( imaging_handle->number_of_threads > 0 ) )
 		{
+			if( imaging_handle->buffer_limiter != NULL )
+			{
+				if( buffer_limiter_adjust(
+				     imaging_handle->buffer_limiter,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to adjust buffer limiter.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* Grabbing blocks while all the storage media buffers are in flight
+			 */
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
 			     &storage_media_buffer,
@@ -852,6 +1112,11 @@ int ewfacquire_read_input(
 
 				goto on_error;
 			}
+			stage_profiler_add_wait(
+			 imaging_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_READ,
+			 start_timestamp,
+			 NULL );
 			if( storage_media_buffer == NULL )
 			{
 				libcerror_error_set(
@@ -872,13 +1137,17 @@ int ewfacquire_read_input(
 		{
 			read_size = (size_t) remaining_aquiry_size;
 		}
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
 		if( imaging_handle->last_offset_written < resume_acquiry_offset )
 		{
 			/* Align with resume acquiry offset if necessary
 			 */
-			if( ( resume_acquiry_offset - (off64_t) acquiry_count ) < (off64_t) read_size )
+			if( ( resume_acquiry_offset - storage_media_offset ) < (off64_t) read_size )
 			{
-				read_size = (size_t) ( resume_acquiry_offset - acquiry_count );
+				read_size = (size_t) ( resume_acquiry_offset - storage_media_offset );
 			}
 			read_count = storage_media_buffer_read_from_handle(
 			              storage_media_buffer,
@@ -965,6 +1234,12 @@ int ewfacquire_read_input(
 			}
 			else if( read_count == 0 )
 			{
+				/* An aborted multi-pass read does not return data
+				 */
+				if( device_handle->abort != 0 )
+				{
+					break;
+				}
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
@@ -975,6 +1250,13 @@ int ewfacquire_read_input(
 				goto on_error;
 			}
 		}
+		stage_profiler_add_sample(
+		 imaging_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+
 		storage_media_offset  += read_count;
 		remaining_aquiry_size -= read_count;
 
@@ -998,20 +1280,8 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
-				 function );
-
-				return( -1 );
-			}
+			/* The imaging handle has passed the storage media buffer on to the digest stage
+			 */
 			storage_media_buffer = NULL;
 		}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -1121,102 +1391,1555 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
-	if( imaging_handle->abort == 0 )
+	return( 1 );
+
+on_error:
+	if( imaging_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer != NULL )
+		{
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	else
+	{
+		imaging_handle_threads_stop(
+		 imaging_handle,
+		 NULL );
+	}
+#endif
+	if( imaging_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 imaging_handle->process_status,
+		 (size64_t) write_count,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+
+		process_status_free(
+		 &( imaging_handle->process_status ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prints the results of the acquiry
+ * Returns 1 if successful or -1 on error
+ */
+int ewfacquire_print_results(
+     imaging_handle_t *imaging_handle,
+     device_handle_t *device_handle,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfacquire_print_results";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle_read_errors_fprint(
+	     device_handle,
+	     imaging_handle->bytes_per_sector,
+	     imaging_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print device read errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_print_hashes(
+	     imaging_handle,
+	     imaging_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_handle != NULL )
 	{
 		if( device_handle_read_errors_fprint(
 		     device_handle,
 		     imaging_handle->bytes_per_sector,
-		     imaging_handle->notify_stream,
+		     log_handle->log_stream,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print device read errors.",
+			 "%s: unable to print device read errors in log handle.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 		if( imaging_handle_print_hashes(
 		     imaging_handle,
-		     imaging_handle->notify_stream,
+		     log_handle->log_stream,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print hashes.",
+			 "%s: unable to print hashes in log handle.",
 			 function );
 
-			goto on_error;
-		}
-		if( log_handle != NULL )
-		{
-			if( device_handle_read_errors_fprint(
-			     device_handle,
-			     imaging_handle->bytes_per_sector,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print device read errors in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( imaging_handle_print_hashes(
-			     imaging_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hashes in log handle.",
-				 function );
-
-				goto on_error;
-			}
+			return( -1 );
 		}
 	}
 	return( 1 );
+}
 
-on_error:
-	if( imaging_handle->number_of_threads == 0 )
-	{
-		if( storage_media_buffer != NULL )
-		{
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+/* Opens the device and imaging handle of a batch job
+ * The shared options are applied to every job, unsupported option values are
+ * considered an error since there is no user to confirm the defaults
+ * Returns 1 if successful or -1 on error
+ */
+int ewfacquire_batch_job_open(
+     batch_job_t *batch_job,
+     ewfacquire_batch_options_t *batch_options,
+     system_character_t *program,
+     libcerror_error_t **error )
+{
+	system_character_t media_information_model[ 64 ];
+	system_character_t media_information_serial_number[ 64 ];
+
+	imaging_handle_t *imaging_handle = NULL;
+	static char *function            = "ewfacquire_batch_job_open";
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( batch_job->device_handle != NULL )
+	 || ( batch_job->imaging_handle != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid batch job - handles already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch_options == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch options.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle_initialize(
+	     &( batch_job->device_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create device handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( batch_options->number_of_error_retries != NULL )
+	{
+		if( device_handle_set_number_of_error_retries(
+		     batch_job->device_handle,
+		     batch_options->number_of_error_retries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of error retries.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->zero_buffer_on_error != 0 )
+	{
+		batch_job->device_handle->zero_buffer_on_error = 1;
+	}
+	if( batch_options->read_options != NULL )
+	{
+		if( device_handle_set_read_options(
+		     batch_job->device_handle,
+		     batch_options->read_options,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read options.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( device_handle_open_input(
+	     batch_job->device_handle,
+	     &( batch_job->source_filename ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open source: %" PRIs_SYSTEM ".",
+		 function,
+		 batch_job->source_filename );
+
+		goto on_error;
+	}
+	if( imaging_handle_initialize(
+	     &( batch_job->imaging_handle ),
+	     1,
+	     batch_options->use_data_chunk_functions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create imaging handle.",
+		 function );
+
+		goto on_error;
+	}
+	imaging_handle = batch_job->imaging_handle;
+
+	if( device_handle_get_media_size(
+	     batch_job->device_handle,
+	     &( imaging_handle->input_media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( batch_options->header_codepage != NULL )
+	{
+		if( imaging_handle_set_header_codepage(
+		     imaging_handle,
+		     batch_options->header_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header codepage.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle_set_string(
+	     imaging_handle,
+	     batch_job->target_filename,
+	     &( imaging_handle->target_filename ),
+	     &( imaging_handle->target_filename_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set target filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( batch_options->case_number != NULL )
+	{
+		if( imaging_handle_set_string(
+		     imaging_handle,
+		     batch_options->case_number,
+		     &( imaging_handle->case_number ),
+		     &( imaging_handle->case_number_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set case number.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( batch_job->description != NULL )
+	 || ( batch_options->description != NULL ) )
+	{
+		if( imaging_handle_set_string(
+		     imaging_handle,
+		     ( batch_job->description != NULL ) ? batch_job->description : batch_options->description,
+		     &( imaging_handle->description ),
+		     &( imaging_handle->description_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set description.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( batch_job->evidence_number != NULL )
+	 || ( batch_options->evidence_number != NULL ) )
+	{
+		if( imaging_handle_set_string(
+		     imaging_handle,
+		     ( batch_job->evidence_number != NULL ) ? batch_job->evidence_number : batch_options->evidence_number,
+		     &( imaging_handle->evidence_number ),
+		     &( imaging_handle->evidence_number_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set evidence number.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->examiner_name != NULL )
+	{
+		if( imaging_handle_set_string(
+		     imaging_handle,
+		     batch_options->examiner_name,
+		     &( imaging_handle->examiner_name ),
+		     &( imaging_handle->examiner_name_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set examiner name.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->notes != NULL )
+	{
+		if( imaging_handle_set_string(
+		     imaging_handle,
+		     batch_options->notes,
+		     &( imaging_handle->notes ),
+		     &( imaging_handle->notes_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set notes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->format != NULL )
+	{
+		if( imaging_handle_set_format(
+		     imaging_handle,
+		     batch_options->format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set format.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->compression_values != NULL )
+	{
+		if( imaging_handle_set_compression_values(
+		     imaging_handle,
+		     batch_options->compression_values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression values.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* The holes of a sparse input file are stored as empty blocks
+		 * when no compression values were specified
+		 */
+		result = device_handle_is_sparse(
+		          batch_job->device_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if input is sparse.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE ) )
+		{
+			imaging_handle->compression_flags |= LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		}
+	}
+	if( batch_options->media_type != NULL )
+	{
+		if( imaging_handle_set_media_type(
+		     imaging_handle,
+		     batch_options->media_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media type.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( device_handle_get_media_type(
+	          batch_job->device_handle,
+	          &( imaging_handle->media_type ),
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media type from device.",
+		 function );
+
+		goto on_error;
+	}
+	if( batch_options->media_flags != NULL )
+	{
+		if( imaging_handle_set_media_flags(
+		     imaging_handle,
+		     batch_options->media_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media flags.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->bytes_per_sector != NULL )
+	{
+		if( imaging_handle_set_bytes_per_sector(
+		     imaging_handle,
+		     batch_options->bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set bytes per sector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		/* Not every device reports the bytes per sector, fall back to the default
+		 * like in single source mode
+		 */
+		result = device_handle_get_bytes_per_sector(
+		          batch_job->device_handle,
+		          &( imaging_handle->bytes_per_sector ),
+		          error );
+
+		if( result == -1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 *error );
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	if( batch_options->sectors_per_chunk != NULL )
+	{
+		if( imaging_handle_set_sectors_per_chunk(
+		     imaging_handle,
+		     batch_options->sectors_per_chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sectors per chunk.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->sector_error_granularity != NULL )
+	{
+		if( imaging_handle_set_sector_error_granularity(
+		     imaging_handle,
+		     batch_options->sector_error_granularity,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set sector error granularity.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->maximum_segment_size != NULL )
+	{
+		if( imaging_handle_set_maximum_segment_size(
+		     imaging_handle,
+		     batch_options->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->write_options != NULL )
+	{
+		if( imaging_handle_set_write_flags(
+		     imaging_handle,
+		     batch_options->write_options,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write options.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->offset != NULL )
+	{
+		result = imaging_handle_set_acquiry_offset(
+		          imaging_handle,
+		          batch_options->offset,
+		          error );
+
+		if( ( result != 1 )
+		 || ( ( imaging_handle->input_media_size != 0 )
+		  &&  ( imaging_handle->acquiry_offset >= imaging_handle->input_media_size ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set acquiry offset.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->size != NULL )
+	{
+		result = imaging_handle_set_acquiry_size(
+		          imaging_handle,
+		          batch_options->size,
+		          error );
+
+		if( ( result != 1 )
+		 || ( ( imaging_handle->input_media_size != 0 )
+		  &&  ( imaging_handle->acquiry_size > ( imaging_handle->input_media_size - imaging_handle->acquiry_offset ) ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set acquiry size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->process_buffer_size != NULL )
+	{
+		if( imaging_handle_set_process_buffer_size(
+		     imaging_handle,
+		     batch_options->process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set process buffer size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( batch_options->number_of_jobs != NULL )
+	{
+		result = imaging_handle_set_number_of_threads(
+		          imaging_handle,
+		          batch_options->number_of_jobs,
+		          error );
+
+		if( ( result != 1 )
+		 || ( imaging_handle->number_of_threads > (int) 32 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set number of jobs (threads).",
+			 function );
+
+			goto on_error;
+		}
+	}
+#else
+	imaging_handle->number_of_threads = 0;
+#endif
+	if( batch_options->additional_digest_types != NULL )
+	{
+		if( imaging_handle_set_additional_digest_types(
+		     imaging_handle,
+		     batch_options->additional_digest_types,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set additional digest types.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( batch_options->hash_backend != NULL )
+	{
+		if( imaging_handle_set_hash_backend(
+		     imaging_handle,
+		     batch_options->hash_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash backend.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( imaging_handle->acquiry_size == 0 )
+	 && ( imaging_handle->input_media_size != 0 ) )
+	{
+		imaging_handle->acquiry_size = imaging_handle->input_media_size
+		                             - imaging_handle->acquiry_offset;
+	}
+	if( ( imaging_handle->acquiry_size > EWFACQUIRE_2_TIB )
+	 && ( imaging_handle->ewf_format != LIBEWF_FORMAT_ENCASE6 )
+	 && ( imaging_handle->ewf_format != LIBEWF_FORMAT_EWFX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: cannot acquire more than 2 TiB in selected EWF file format.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_check_write_access(
+	     imaging_handle,
+	     imaging_handle->target_filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to write target: %" PRIs_SYSTEM ".",
+		 function,
+		 batch_job->target_filename );
+
+		goto on_error;
+	}
+	result = device_handle_get_information_value(
+	          batch_job->device_handle,
+	          (uint8_t *) "model",
+	          5,
+	          media_information_model,
+	          64,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_free(
+		 error );
+	}
+	if( result != 1 )
+	{
+		media_information_model[ 0 ] = 0;
+	}
+	result = device_handle_get_information_value(
+	          batch_job->device_handle,
+	          (uint8_t *) "serial_number",
+	          13,
+	          media_information_serial_number,
+	          64,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_free(
+		 error );
+	}
+	if( result != 1 )
+	{
+		media_information_serial_number[ 0 ] = 0;
+	}
+	if( imaging_handle_open_output(
+	     imaging_handle,
+	     imaging_handle->target_filename,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output file(s).",
+		 function );
+
+		goto on_error;
+	}
+	if( device_handle_set_error_values(
+	     batch_job->device_handle,
+	     imaging_handle->sector_error_granularity * imaging_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set error values.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle_set_output_values(
+	     imaging_handle,
+	     program,
+	     _SYSTEM_STRING( LIBEWF_VERSION_STRING ),
+	     media_information_model,
+	     media_information_serial_number,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set output values.",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->media_type == DEVICE_HANDLE_MEDIA_TYPE_OPTICAL )
+	{
+		if( ewfacquire_determine_sessions(
+		     imaging_handle,
+		     batch_job->device_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sessions.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( imaging_handle_open_checkpoint_file(
+	     imaging_handle,
+	     0,
+	     error ) != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "Unable to open checkpoint file of target: %" PRIs_SYSTEM " - continuing without checkpoints.\n",
+		 batch_job->target_filename );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libcnotify_print_error_backtrace(
+		 *error );
+#endif
+		libcerror_error_free(
+		 error );
+	}
+	if( batch_options->isolate_read_errors != 0 )
+	{
+		result = imaging_handle_get_target_basename_length(
+		          imaging_handle,
+		          0,
+		          &string_length,
+		          error );
+
+		if( result == 1 )
+		{
+			result = device_handle_open_rescue_map(
+			          batch_job->device_handle,
+			          imaging_handle->target_filename,
+			          string_length,
+			          (off64_t) imaging_handle->acquiry_offset,
+			          (size64_t) imaging_handle->acquiry_size,
+			          0,
+			          error );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stdout,
+			 "Unable to open rescue map of target: %" PRIs_SYSTEM " - continuing without multi-pass read error isolation.\n",
+			 batch_job->target_filename );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 *error );
+#endif
+			libcerror_error_free(
+			 error );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( batch_job->imaging_handle != NULL )
+	{
+		imaging_handle_close(
+		 batch_job->imaging_handle,
+		 NULL );
+		imaging_handle_free(
+		 &( batch_job->imaging_handle ),
+		 NULL );
+	}
+	if( batch_job->device_handle != NULL )
+	{
+		device_handle_close(
+		 batch_job->device_handle,
+		 NULL );
+		device_handle_free(
+		 &( batch_job->device_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the device and imaging handle of a batch job
+ * Returns 0 if successful or -1 on error
+ */
+int ewfacquire_batch_job_close(
+     batch_job_t *batch_job,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfacquire_batch_job_close";
+	int result            = 0;
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		return( -1 );
+	}
+	if( batch_job->imaging_handle != NULL )
+	{
+		if( imaging_handle_close(
+		     batch_job->imaging_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output file(s).",
+			 function );
+
+			result = -1;
+		}
+		if( imaging_handle_free(
+		     &( batch_job->imaging_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free imaging handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( batch_job->device_handle != NULL )
+	{
+		if( device_handle_close(
+		     batch_job->device_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input file or device.",
+			 function );
+
+			result = -1;
+		}
+		if( device_handle_free(
+		     &( batch_job->device_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free device handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Reads the input of a batch job
+ * Callback function for the job thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewfacquire_batch_job_callback(
+     batch_job_t *batch_job,
+     void *arguments EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewfacquire_batch_job_callback";
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( arguments )
+
+	if( batch_job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid batch job.",
+		 function );
+
+		goto on_error;
+	}
+	/* The status of concurrent jobs is not printed since the lines would interleave
+	 */
+	batch_job->result = ewfacquire_read_input(
+	                     batch_job->imaging_handle,
+	                     batch_job->device_handle,
+	                     0,
+	                     0,
+	                     0,
+	                     batch_job->imaging_handle->use_data_chunk_functions,
+	                     &error );
+
+	if( batch_job->result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to acquire source: %" PRIs_SYSTEM ".",
+		 function,
+		 batch_job->source_filename );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Acquiry of: %" PRIs_SYSTEM " completed.\n",
+	 batch_job->source_filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Acquires the sources of the jobs in a batch file
+ * In multi-threaded mode the jobs are read concurrently and share a single process pool,
+ * which processes the storage media buffers of the jobs in order of arrival and divides
+ * the maximum process buffers size between them
+ * Returns 1 if successful, 0 if one or more jobs failed or -1 on error
+ */
+int ewfacquire_batch_acquire(
+     batch_file_t *batch_file,
+     ewfacquire_batch_options_t *batch_options,
+     system_character_t *program,
+     const system_character_t *log_filename,
+     uint8_t print_status_information,
+     libcerror_error_t **error )
+{
+	batch_job_t *batch_job                       = NULL;
+	log_handle_t *log_handle                     = NULL;
+	static char *function                        = "ewfacquire_batch_acquire";
+	int job_index                                = 0;
+	int number_of_failed_jobs                    = 0;
+	int number_of_jobs                           = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	imaging_handle_t *imaging_handle             = NULL;
+	libcthreads_thread_pool_t *job_thread_pool   = NULL;
+	process_pool_t *process_pool                 = NULL;
+	size_t process_buffer_size                   = 0;
+	int maximum_number_of_queued_values          = 0;
+#endif
+
+	if( batch_file_get_number_of_jobs(
+	     batch_file,
+	     &number_of_jobs,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of jobs.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_jobs <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing jobs.",
+		 function );
+
+		goto on_error;
+	}
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		if( batch_file_get_job_by_index(
+		     batch_file,
+		     job_index,
+		     &batch_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve job: %d.",
+			 function,
+			 job_index );
+
+			goto on_error;
+		}
+		if( ewfacquire_batch_job_open(
+		     batch_job,
+		     batch_options,
+		     program,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open job: %d.",
+			 function,
+			 job_index );
+
+			goto on_error;
+		}
+		fprintf(
+		 stdout,
+		 "Job: %d acquiring: %" PRIs_SYSTEM " to: %" PRIs_SYSTEM "\n",
+		 job_index + 1,
+		 batch_job->source_filename,
+		 batch_job->target_filename );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( log_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &log_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create log handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     log_handle,
+		     log_filename,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open log file: %" PRIs_SYSTEM ".",
+			 function,
+			 log_filename );
+
+			goto on_error;
+		}
+	}
+	if( ewftools_signal_attach(
+	     ewfacquire_signal_handler,
+	     error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 *error );
+		libcerror_error_free(
+		 error );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	imaging_handle = batch_file->jobs[ 0 ]->imaging_handle;
+
+	if( imaging_handle->number_of_threads > 0 )
+	{
+		if( imaging_handle_get_process_buffer_size(
+		     imaging_handle,
+		     imaging_handle->use_data_chunk_functions,
+		     &process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve process buffer size.",
+			 function );
+
+			goto on_error;
+		}
+		/* Every job has at most its share of the buffers in flight, rounded up,
+		 * so the queue of the process pool never has to block a job
+		 */
+		maximum_number_of_queued_values = number_of_jobs
+		                                + (int) ( imaging_handle->maximum_process_buffers_size / process_buffer_size );
+
+		if( process_pool_initialize(
+		     &process_pool,
+		     imaging_handle->number_of_threads,
+		     maximum_number_of_queued_values,
+		     imaging_handle->maximum_process_buffers_size,
+		     number_of_jobs,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create process pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( job_index = 0;
+		     job_index < number_of_jobs;
+		     job_index++ )
+		{
+			if( imaging_handle_set_process_pool(
+			     batch_file->jobs[ job_index ]->imaging_handle,
+			     process_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set process pool of job: %d.",
+				 function,
+				 job_index );
+
+				goto on_error;
+			}
+		}
+		/* Every job is read by its own thread, so that a slow or failing source
+		 * does not hold back the other sources
+		 */
+		if( libcthreads_thread_pool_create(
+		     &job_thread_pool,
+		     NULL,
+		     number_of_jobs,
+		     number_of_jobs,
+		     (int (*)(intptr_t *, void *)) &ewfacquire_batch_job_callback,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create job thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( job_index = 0;
+		     job_index < number_of_jobs;
+		     job_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     job_thread_pool,
+			     (intptr_t *) batch_file->jobs[ job_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push job: %d onto job thread pool queue.",
+				 function,
+				 job_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &job_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join job thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( process_pool_free(
+		     &process_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free process pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	{
+		for( job_index = 0;
+		     job_index < number_of_jobs;
+		     job_index++ )
+		{
+			if( ewfacquire_abort != 0 )
+			{
+				break;
+			}
+			batch_job = batch_file->jobs[ job_index ];
+
+			batch_job->result = ewfacquire_read_input(
+			                     batch_job->imaging_handle,
+			                     batch_job->device_handle,
+			                     0,
+			                     0,
+			                     print_status_information,
+			                     batch_options->use_data_chunk_functions,
+			                     error );
+
+			if( batch_job->result != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to acquire source: %" PRIs_SYSTEM ".\n",
+				 batch_job->source_filename );
+
+				libcnotify_print_error_backtrace(
+				 *error );
+				libcerror_error_free(
+				 error );
+			}
+		}
+	}
+	if( ewftools_signal_detach(
+	     error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 *error );
+		libcerror_error_free(
+		 error );
+	}
+	/* The results are printed per job after all jobs have completed
+	 */
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		batch_job = batch_file->jobs[ job_index ];
+
+		fprintf(
+		 stdout,
+		 "\nJob: %d source: %" PRIs_SYSTEM " target: %" PRIs_SYSTEM "\n",
+		 job_index + 1,
+		 batch_job->source_filename,
+		 batch_job->target_filename );
+
+		if( log_handle != NULL )
+		{
+			log_handle_printf(
+			 log_handle,
+			 "Job: %d source: %" PRIs_SYSTEM " target: %" PRIs_SYSTEM "\n",
+			 job_index + 1,
+			 batch_job->source_filename,
+			 batch_job->target_filename );
+		}
+		if( ( batch_job->result == 1 )
+		 && ( batch_job->imaging_handle->abort == 0 ) )
+		{
+			batch_job->result = ewfacquire_print_results(
+			                     batch_job->imaging_handle,
+			                     batch_job->device_handle,
+			                     log_handle,
+			                     error );
+
+			if( batch_job->result != 1 )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+				libcerror_error_free(
+				 error );
+			}
+		}
+		if( batch_job->result != 1 )
+		{
+			fprintf(
+			 stdout,
+			 "Job: %d FAILURE\n",
+			 job_index + 1 );
+
+			number_of_failed_jobs += 1;
+		}
+	}
+	if( log_handle != NULL )
+	{
+		if( log_handle_close(
+		     log_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close log handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &log_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free log handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		if( ewfacquire_batch_job_close(
+		     batch_file->jobs[ job_index ],
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close job: %d.",
+			 function,
+			 job_index );
+
+			goto on_error;
 		}
 	}
+	if( number_of_failed_jobs != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	else
+	if( job_thread_pool != NULL )
 	{
-		imaging_handle_threads_stop(
-		 imaging_handle,
+		libcthreads_thread_pool_join(
+		 &job_thread_pool,
+		 NULL );
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
 		 NULL );
 	}
 #endif
-	if( imaging_handle->process_status != NULL )
+	if( log_handle != NULL )
 	{
-		process_status_stop(
-		 imaging_handle->process_status,
-		 (size64_t) write_count,
-		 PROCESS_STATUS_FAILED,
+		log_handle_close(
+		 log_handle,
 		 NULL );
-
-		process_status_free(
-		 &( imaging_handle->process_status ),
+		log_handle_free(
+		 &log_handle,
 		 NULL );
 	}
+	if( batch_file != NULL )
+	{
+		for( job_index = 0;
+		     job_index < batch_file->number_of_jobs;
+		     job_index++ )
+		{
+			ewfacquire_batch_job_close(
+			 batch_file->jobs[ job_index ],
+			 NULL );
+		}
+	}
 	return( -1 );
 }
 
@@ -1232,9 +2955,14 @@ int main( int argc, char * const argv[] )
 	system_character_t media_information_model[ 64 ];
 	system_character_t media_information_serial_number[ 64 ];
 
+	ewfacquire_batch_options_t batch_options;
+
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
+	log_handle_t *metrics_handle                         = NULL;
+	system_character_t *batch_filename                   = NULL;
 	system_character_t *log_filename                     = NULL;
+	system_character_t *metrics_filename                 = NULL;
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
@@ -1243,6 +2971,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_evidence_number           = NULL;
 	system_character_t *option_examiner_name             = NULL;
 	system_character_t *option_format                    = NULL;
+	system_character_t *option_hash_backend              = NULL;
 	system_character_t *option_header_codepage           = NULL;
 	system_character_t *option_maximum_segment_size      = NULL;
 	system_character_t *option_media_flags               = NULL;
@@ -1252,18 +2981,21 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
+	system_character_t *option_read_options              = NULL;
 	system_character_t *option_secondary_target_filename = NULL;
 	system_character_t *option_sector_error_granularity  = NULL;
 	system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
 	system_character_t *option_target_filename           = NULL;
 	system_character_t *option_toc_filename              = NULL;
+	system_character_t *option_write_options             = NULL;
 	system_character_t *program                          = _SYSTEM_STRING( "ewfacquire" );
 	system_character_t *request_string                   = NULL;
 	system_integer_t option                              = 0;
 	size_t string_length                                 = 0;
 	off64_t resume_acquiry_offset                        = 0;
 	uint8_t calculate_md5                                = 1;
+	uint8_t isolate_read_errors                          = 0;
 	uint8_t print_status_information                     = 1;
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
@@ -1312,7 +3044,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hH:iI:j:J:l:L:m:M:N:o:O:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1397,16 +3129,41 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_hash_backend = optarg;
+
+				break;
+
+			case (system_integer_t) 'i':
+				isolate_read_errors = 1;
+
+				break;
+
+			case (system_integer_t) 'I':
+				option_read_options = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				metrics_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
 				break;
 
+			case (system_integer_t) 'L':
+				batch_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'm':
 				option_media_type = optarg;
 
@@ -1427,6 +3184,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				option_write_options = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1508,7 +3270,8 @@ int main( int argc, char * const argv[] )
 				break;
 		}
 	}
-	if( optind == argc )
+	if( ( optind == argc )
+	 && ( batch_filename == NULL ) )
 	{
 		ewftools_output_version_fprint(
 		 stdout,
@@ -1538,6 +3301,122 @@ int main( int argc, char * const argv[] )
 	 NULL );
 #endif
 
+	if( batch_filename != NULL )
+	{
+		if( optind != argc )
+		{
+			fprintf(
+			 stderr,
+			 "Source file or device cannot be combined with a job file.\n" );
+
+			goto on_error;
+		}
+		if( ( resume_acquiry != 0 )
+		 || ( swap_byte_pairs != 0 )
+		 || ( metrics_filename != NULL )
+		 || ( option_secondary_target_filename != NULL )
+		 || ( option_target_filename != NULL )
+		 || ( option_toc_filename != NULL ) )
+		{
+			fprintf(
+			 stderr,
+			 "Options -J, -R, -s, -t, -T and -2 are not supported with a job file.\n" );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     &batch_options,
+		     0,
+		     sizeof( ewfacquire_batch_options_t ) ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to clear batch options.\n" );
+
+			goto on_error;
+		}
+		batch_options.additional_digest_types  = option_additional_digest_types;
+		batch_options.bytes_per_sector         = option_bytes_per_sector;
+		batch_options.case_number              = option_case_number;
+		batch_options.compression_values       = option_compression_values;
+		batch_options.description              = option_description;
+		batch_options.evidence_number          = option_evidence_number;
+		batch_options.examiner_name            = option_examiner_name;
+		batch_options.format                   = option_format;
+		batch_options.hash_backend             = option_hash_backend;
+		batch_options.header_codepage          = option_header_codepage;
+		batch_options.maximum_segment_size     = option_maximum_segment_size;
+		batch_options.media_flags              = option_media_flags;
+		batch_options.media_type               = option_media_type;
+		batch_options.notes                    = option_notes;
+		batch_options.number_of_error_retries  = option_number_of_error_retries;
+		batch_options.number_of_jobs           = option_number_of_jobs;
+		batch_options.offset                   = option_offset;
+		batch_options.process_buffer_size      = option_process_buffer_size;
+		batch_options.read_options             = option_read_options;
+		batch_options.sector_error_granularity = option_sector_error_granularity;
+		batch_options.sectors_per_chunk        = option_sectors_per_chunk;
+		batch_options.size                     = option_size;
+		batch_options.write_options            = option_write_options;
+		batch_options.isolate_read_errors      = isolate_read_errors;
+		batch_options.use_data_chunk_functions = use_data_chunk_functions;
+		batch_options.zero_buffer_on_error     = zero_buffer_on_error;
+
+		if( batch_file_initialize(
+		     &ewfacquire_batch_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create batch file.\n" );
+
+			goto on_error;
+		}
+		if( batch_file_read(
+		     ewfacquire_batch_file,
+		     batch_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read job file: %" PRIs_SYSTEM ".\n",
+			 batch_filename );
+
+			goto on_error;
+		}
+		/* The jobs are acquired in unattended mode
+		 */
+		result = ewfacquire_batch_acquire(
+		          ewfacquire_batch_file,
+		          &batch_options,
+		          program,
+		          log_filename,
+		          print_status_information,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to acquire jobs.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( batch_file_free(
+		     &ewfacquire_batch_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free batch file.\n" );
+
+			goto on_error;
+		}
+		goto on_batch_end;
+	}
 	/* Check if to read from stdin
 	 */
 	if( system_string_compare(
@@ -1638,6 +3517,28 @@ int main( int argc, char * const argv[] )
 	{
 		ewfacquire_device_handle->zero_buffer_on_error = 1;
 	}
+	if( option_read_options != NULL )
+	{
+		result = device_handle_set_read_options(
+			  ewfacquire_device_handle,
+			  option_read_options,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set read options.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported read options defaulting to: none.\n" );
+		}
+	}
 	/* Open the input file or device size
 	 */
 	if( device_handle_open_input(
@@ -1977,6 +3878,30 @@ int main( int argc, char * const argv[] )
 			 "Unsupported compression values defaulting to method: deflate with level: none.\n" );
 		}
 	}
+	else if( interactive_mode == 0 )
+	{
+		/* The holes of a sparse input file are stored as empty blocks
+		 * when no compression values were specified, in interactive mode
+		 * the user is prompted for the compression values instead
+		 */
+		result = device_handle_is_sparse(
+		          ewfacquire_device_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to determine if input is sparse.\n" );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( ewfacquire_imaging_handle->compression_level == LIBEWF_COMPRESSION_LEVEL_NONE ) )
+		{
+			ewfacquire_imaging_handle->compression_flags |= LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+		}
+	}
 	if( option_media_type != NULL )
 	{
 		result = imaging_handle_set_media_type(
@@ -2156,6 +4081,28 @@ int main( int argc, char * const argv[] )
 			 ewfacquire_imaging_handle->maximum_segment_size );
 		}
 	}
+	if( option_write_options != NULL )
+	{
+		result = imaging_handle_set_write_flags(
+			  ewfacquire_imaging_handle,
+			  option_write_options,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set write options.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported write options defaulting to: none.\n" );
+		}
+	}
 	if( option_offset != NULL )
 	{
 		result = imaging_handle_set_acquiry_offset(
@@ -2281,6 +4228,28 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_hash_backend != NULL )
+	{
+		result = imaging_handle_set_hash_backend(
+			  ewfacquire_imaging_handle,
+			  option_hash_backend,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set hash backend.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported hash backend defaulting to: auto.\n" );
+		}
+	}
 	/* Initialize values
 	 */
 	if( ( ewfacquire_imaging_handle->acquiry_size == 0 )
@@ -2938,6 +4907,55 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	if( imaging_handle_open_checkpoint_file(
+	     ewfacquire_imaging_handle,
+	     resume_acquiry,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "Unable to open checkpoint file - continuing without checkpoints.\n" );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libcnotify_print_error_backtrace(
+		 error );
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( isolate_read_errors != 0 )
+	{
+		result = imaging_handle_get_target_basename_length(
+		          ewfacquire_imaging_handle,
+		          resume_acquiry,
+		          &string_length,
+		          &error );
+
+		if( result == 1 )
+		{
+			result = device_handle_open_rescue_map(
+			          ewfacquire_device_handle,
+			          ewfacquire_imaging_handle->target_filename,
+			          string_length,
+			          (off64_t) ewfacquire_imaging_handle->acquiry_offset,
+			          (size64_t) ewfacquire_imaging_handle->acquiry_size,
+			          resume_acquiry,
+			          &error );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stdout,
+			 "Unable to open rescue map - continuing without multi-pass read error isolation.\n" );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 error );
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	if( ewftools_signal_attach(
 	     ewfacquire_signal_handler,
 	     &error ) != 1 )
@@ -2976,6 +4994,42 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     metrics_handle,
+		     metrics_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open metrics file: %" PRIs_SYSTEM ".\n",
+			 metrics_filename );
+
+			goto on_error;
+		}
+		if( imaging_handle_set_metrics_stream(
+		     ewfacquire_imaging_handle,
+		     metrics_handle->log_stream,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set metrics stream.\n" );
+
+			goto on_error;
+		}
+	}
 	result = ewfacquire_read_input(
 		  ewfacquire_imaging_handle,
 		  ewfacquire_device_handle,
@@ -2983,9 +5037,17 @@ int main( int argc, char * const argv[] )
 		  swap_byte_pairs,
 		  print_status_information,
 	          use_data_chunk_functions,
-		  log_handle,
 		  &error );
 
+	if( ( result == 1 )
+	 && ( ewfacquire_imaging_handle->abort == 0 ) )
+	{
+		result = ewfacquire_print_results(
+		          ewfacquire_imaging_handle,
+		          ewfacquire_device_handle,
+		          log_handle,
+		          &error );
+	}
 	if( result != 1 )
 	{
 		fprintf(
@@ -3020,6 +5082,29 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_handle != NULL )
+	{
+		if( log_handle_close(
+		     metrics_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free metrics handle.\n" );
+
+			goto on_error;
+		}
+	}
 on_abort:
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
@@ -3073,6 +5158,7 @@ on_abort:
 
 		goto on_error;
 	}
+on_batch_end:
 	if( ewfacquire_abort != 0 )
 	{
 		fprintf(
@@ -3115,6 +5201,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( metrics_handle != NULL )
+	{
+		log_handle_close(
+		 metrics_handle,
+		 NULL );
+		log_handle_free(
+		 &metrics_handle,
+		 NULL );
+	}
 	if( ewfacquire_imaging_handle != NULL )
 	{
 		imaging_handle_close(
@@ -3133,6 +5228,12 @@ on_error:
 		 &ewfacquire_device_handle,
 		 NULL );
 	}
+	if( ewfacquire_batch_file != NULL )
+	{
+		batch_file_free(
+		 &ewfacquire_batch_file,
+		 NULL );
+	}
 	return( EXIT_FAILURE );
 }
 
@@ -19,6 +19,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+/* F_SETPIPE_SZ requires _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
 #include <common.h>
 #include <memory.h>
 #include <narrow_string.h>
@@ -42,6 +48,15 @@
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "buffer_limiter.h"
 #include "byte_size_string.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -57,9 +72,33 @@
 #include "imaging_handle.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
 
+/* Reading a pipe in batches requires the pipe size to be adjustable and vectored reads
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( WINAPI ) && defined( F_SETPIPE_SZ ) && defined( HAVE_SYS_STAT_H )
+#define EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT
+#endif
+
+#if defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT )
+#include <sys/uio.h>
+
+/* The size the input pipe is enlarged to
+ */
+#define EWFACQUIRESTREAM_PIPE_SIZE			( 4 * 1024 * 1024 )
+
+/* The maximum size of the data read from the input pipe at once
+ */
+#define EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_SIZE	( 8 * 1024 * 1024 )
+
+/* The maximum number of storage media buffers that are read at once
+ */
+#define EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS	256
+
+#endif /* defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT ) */
+
 imaging_handle_t *ewfacquirestream_imaging_handle = NULL;
 int ewfacquirestream_abort                        = 0;
 
@@ -120,10 +159,13 @@ void usage_fprint(
 	                 "                        [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
-	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
-	                 "                        [ -l log_filename ] [ -m media_type ]\n"
+	                 "                        [ -E evidence_number ] [ -f format ]\n"
+	                 "                        [ -H hash_backend ] [ -j jobs ]\n"
+	                 "                        [ -J metrics_filename ] [ -l log_filename ]\n"
+	                 "                        [ -m media_type ]\n"
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
-	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                        [ -o offset ] [ -O write_options ]\n"
+	                 "                        [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
 	                 "                        [ -t target ] [ -2 secondary_target ]\n"
 	                 "                        [ -hqsvVx ]\n\n" );
@@ -158,15 +200,24 @@ void usage_fprint(
 	                 "\t    encase3, encase4, encase5, encase6 (default), encase7, linen5,\n"
 	                 "\t    linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-H: specify the digest (hash) calculation backend, options: auto\n"
+	                 "\t    (default), generic, sha-ni or armv8\n" );
 	fprintf( stream, "\t-j: the number of concurrent processing jobs (threads), where\n"
-	                 "\t    a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t    if multi-threaded mode is supported)\n" );
+	                 "\t    0 represents single-threaded mode, \"auto\" sizes the number\n"
+	                 "\t    of threads and buffers to the available processors and memory\n"
+	                 "\t    (default is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J: writes metrics, as one JSON record per line, to the\n"
+	                 "\t    metrics_filename every second and when the acquiry stops,\n"
+	                 "\t    use /dev/fd/N to write to an open file descriptor\n" );
 	fprintf( stream, "\t-l: logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m: specify the media type, options: fixed (default), removable,\n"
 	                 "\t    optical, memory\n" );
 	fprintf( stream, "\t-M: specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N: specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o: specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O: specify the write options as a comma separated list, options:\n"
+	                 "\t    none (default), preallocate (preallocate segment files) or\n"
+	                 "\t    direct (write segment files using direct IO)\n" );
 	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
@@ -487,6 +538,482 @@ ssize_t ewfacquirestream_read_chunk(
 	return( (ssize_t) buffer_offset );
 }
 
+#if defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT )
+
+/* Prepares the input file descriptor to be read in batches
+ * The pipe is enlarged so that a single read can return multiple chunks of data
+ * Returns 1 if the input is a pipe, 0 if not or -1 on error
+ */
+int ewfacquirestream_prepare_pipe(
+     int input_file_descriptor,
+     size_t *pipe_size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "ewfacquirestream_prepare_pipe";
+	int requested_size    = 0;
+	int result            = 0;
+
+	if( input_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( pipe_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pipe size.",
+		 function );
+
+		return( -1 );
+	}
+	if( fstat(
+	     input_file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to retrieve input file statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( !S_ISFIFO( file_statistics.st_mode ) )
+	{
+		return( 0 );
+	}
+	/* An unprivileged process cannot exceed the system maximum pipe size,
+	 * hence try smaller sizes until the pipe size can be set
+	 */
+	for( requested_size = EWFACQUIRESTREAM_PIPE_SIZE;
+	     requested_size > 64 * 1024;
+	     requested_size /= 2 )
+	{
+		result = fcntl(
+		          input_file_descriptor,
+		          F_SETPIPE_SZ,
+		          requested_size );
+
+		if( result != -1 )
+		{
+			break;
+		}
+		if( ( errno != EPERM )
+		 && ( errno != EBUSY ) )
+		{
+			break;
+		}
+	}
+	result = fcntl(
+	          input_file_descriptor,
+	          F_GETPIPE_SZ );
+
+	if( result == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to retrieve pipe size.",
+		 function );
+
+		return( -1 );
+	}
+	*pipe_size = (size_t) result;
+
+	return( 1 );
+}
+
+/* Reads a batch of data from the input pipe into the storage media buffers
+ * A single vectored read fills as many storage media buffers as there is data in the pipe
+ * Unlike with a device, a short read from a pipe is not a read error
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t ewfacquirestream_read_pipe_batch(
+         int input_file_descriptor,
+         storage_media_buffer_t **storage_media_buffers,
+         int number_of_storage_media_buffers,
+         off64_t storage_media_offset,
+         size_t buffer_read_size,
+         libcerror_error_t **error )
+{
+	struct iovec io_vectors[ EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS ];
+
+	static char *function    = "ewfacquirestream_read_pipe_batch";
+	size_t batch_offset      = 0;
+	size_t batch_size        = 0;
+	size_t buffer_data_size  = 0;
+	size_t remaining_size    = 0;
+	ssize_t read_count       = 0;
+	int buffer_index         = 0;
+	int first_buffer_index   = 0;
+	int number_of_io_vectors = 0;
+
+	if( input_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_storage_media_buffers <= 0 )
+	 || ( number_of_storage_media_buffers > EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of storage media buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_read_size == 0 )
+	 || ( buffer_read_size > (size_t) ( SSIZE_MAX / number_of_storage_media_buffers ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_storage_media_buffers;
+	     buffer_index++ )
+	{
+		if( ( storage_media_buffers[ buffer_index ] == NULL )
+		 || ( storage_media_buffers[ buffer_index ]->raw_buffer_size < buffer_read_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		storage_media_buffers[ buffer_index ]->storage_media_offset = storage_media_offset + (off64_t) ( buffer_index * buffer_read_size );
+		storage_media_buffers[ buffer_index ]->requested_size       = buffer_read_size;
+		storage_media_buffers[ buffer_index ]->raw_buffer_data_size = 0;
+	}
+	batch_size = buffer_read_size * number_of_storage_media_buffers;
+
+	while( batch_offset < batch_size )
+	{
+		if( ewfacquirestream_imaging_handle->abort != 0 )
+		{
+			break;
+		}
+		/* Read into the remainder of the partially filled storage media buffer
+		 * and the storage media buffers that follow it
+		 */
+		first_buffer_index   = (int) ( batch_offset / buffer_read_size );
+		buffer_data_size     = batch_offset % buffer_read_size;
+		number_of_io_vectors = 0;
+
+		for( buffer_index = first_buffer_index;
+		     buffer_index < number_of_storage_media_buffers;
+		     buffer_index++ )
+		{
+			io_vectors[ number_of_io_vectors ].iov_base = &( ( storage_media_buffers[ buffer_index ]->raw_buffer )[ buffer_data_size ] );
+			io_vectors[ number_of_io_vectors ].iov_len  = buffer_read_size - buffer_data_size;
+
+			buffer_data_size = 0;
+
+			number_of_io_vectors++;
+		}
+		read_count = readv(
+		              input_file_descriptor,
+		              io_vectors,
+		              number_of_io_vectors );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: error reading data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			break;
+		}
+		batch_offset += (size_t) read_count;
+	}
+	remaining_size = batch_offset;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_storage_media_buffers;
+	     buffer_index++ )
+	{
+		if( remaining_size >= buffer_read_size )
+		{
+			buffer_data_size = buffer_read_size;
+		}
+		else
+		{
+			buffer_data_size = remaining_size;
+		}
+		storage_media_buffers[ buffer_index ]->raw_buffer_data_size = buffer_data_size;
+
+		remaining_size -= buffer_data_size;
+	}
+	return( (ssize_t) batch_offset );
+}
+
+/* Reads a batch of data from the input pipe and passes the storage media buffers on to the imaging handle
+ * The first storage media buffer is provided by the caller, the others are grabbed from the queue
+ * Returns the number of bytes read, 0 if at end of input or -1 on error
+ */
+ssize_t ewfacquirestream_process_pipe_batch(
+         imaging_handle_t *imaging_handle,
+         int input_file_descriptor,
+         storage_media_buffer_t *storage_media_buffer,
+         int number_of_storage_media_buffers,
+         off64_t storage_media_offset,
+         size_t buffer_read_size,
+         uint8_t swap_byte_pairs,
+         libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffers[ EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS ];
+
+	static char *function         = "ewfacquirestream_process_pipe_batch";
+	ssize_t read_count            = 0;
+	int64_t start_timestamp       = 0;
+	int buffer_index              = 0;
+	int number_of_grabbed_buffers = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_storage_media_buffers <= 0 )
+	 || ( number_of_storage_media_buffers > EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of storage media buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffers[ 0 ] = storage_media_buffer;
+	number_of_grabbed_buffers  = 1;
+
+	/* Grabbing blocks while all the storage media buffers are in flight
+	 */
+	stage_profiler_get_timestamp(
+	 &start_timestamp,
+	 NULL );
+
+	for( buffer_index = 1;
+	     buffer_index < number_of_storage_media_buffers;
+	     buffer_index++ )
+	{
+		storage_media_buffers[ buffer_index ] = NULL;
+
+		if( storage_media_buffer_queue_grab_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     &( storage_media_buffers[ buffer_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffers[ buffer_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_grabbed_buffers++;
+	}
+	stage_profiler_add_wait(
+	 imaging_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_READ,
+	 start_timestamp,
+	 NULL );
+
+	stage_profiler_get_timestamp(
+	 &start_timestamp,
+	 NULL );
+
+	read_count = ewfacquirestream_read_pipe_batch(
+	              input_file_descriptor,
+	              storage_media_buffers,
+	              number_of_storage_media_buffers,
+	              storage_media_offset,
+	              buffer_read_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read batch from input pipe.",
+		 function );
+
+		goto on_error;
+	}
+	stage_profiler_add_sample(
+	 imaging_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_READ,
+	 start_timestamp,
+	 (uint64_t) read_count,
+	 NULL );
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_storage_media_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffers[ buffer_index ]->raw_buffer_data_size == 0 )
+		{
+			break;
+		}
+		/* The imaging handle passes the storage media buffer on to the digest stage
+		 */
+		storage_media_buffer                  = storage_media_buffers[ buffer_index ];
+		storage_media_buffers[ buffer_index ] = NULL;
+
+		if( imaging_handle_update(
+		     imaging_handle,
+		     storage_media_buffer,
+		     (ssize_t) storage_media_buffer->raw_buffer_data_size,
+		     0,
+		     swap_byte_pairs,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update imaging handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Return the storage media buffers that were not filled at the end of the input
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_grabbed_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffers[ buffer_index ] != NULL )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     imaging_handle->storage_media_buffer_queue,
+			     storage_media_buffers[ buffer_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_buffers[ buffer_index ] = NULL;
+		}
+	}
+	return( read_count );
+
+on_error:
+	for( buffer_index = 0;
+	     buffer_index < number_of_grabbed_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffers[ buffer_index ] != NULL )
+		{
+			storage_media_buffer_queue_release_buffer(
+			 imaging_handle->storage_media_buffer_queue,
+			 storage_media_buffers[ buffer_index ],
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+#endif /* defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT ) */
+
 /* Reads the input
  * Returns 1 if successful or -1 on error
  */
@@ -509,9 +1036,19 @@ int ewfacquirestream_read_input(
 	size_t read_size                             = 0;
 	ssize_t read_count                           = 0;
 	ssize_t write_count                          = 0;
+	int64_t start_timestamp                      = 0;
 	uint8_t storage_media_buffer_mode            = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
+#if defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT )
+	size_t pipe_size                             = 0;
+	int maximum_number_of_batch_buffers          = 0;
+	int number_of_batch_buffers                  = 0;
+	int number_of_limited_buffers                = 0;
+	int number_of_queued_buffers                 = 0;
+	int result                                   = 0;
+#endif
+
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
@@ -559,6 +1096,17 @@ int ewfacquirestream_read_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The secondary output is written by its own thread, the chunk data is packed
+	 * once by the process threads and shared by both outputs
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->secondary_output_handle != NULL ) )
+	{
+		use_data_chunk_functions = 1;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	if( imaging_handle_get_process_buffer_size(
 	     imaging_handle,
 	     use_data_chunk_functions,
@@ -622,6 +1170,57 @@ int ewfacquirestream_read_input(
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT )
+	/* A pipe is read in batches of storage media buffers, so that the read is not limited
+	 * to a chunk of data per system call
+	 */
+	if( imaging_handle->number_of_threads > 0 )
+	{
+		result = ewfacquirestream_prepare_pipe(
+		          input_file_descriptor,
+		          &pipe_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to prepare input pipe.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: input pipe size: %" PRIzd ".\n",
+				 function,
+				 pipe_size );
+			}
+#endif
+			maximum_number_of_batch_buffers = (int) ( EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_SIZE / process_buffer_size );
+
+			/* Leave at least half of the storage media buffers to the stages that follow
+			 */
+			number_of_queued_buffers = 1 + (int) ( imaging_handle->maximum_process_buffers_size / process_buffer_size );
+
+			if( maximum_number_of_batch_buffers > ( number_of_queued_buffers / 2 ) )
+			{
+				maximum_number_of_batch_buffers = number_of_queued_buffers / 2;
+			}
+			if( maximum_number_of_batch_buffers > EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS )
+			{
+				maximum_number_of_batch_buffers = EWFACQUIRESTREAM_MAXIMUM_PIPE_BATCH_BUFFERS;
+			}
+		}
+	}
+#endif /* defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT ) */
+
 	if( imaging_handle_start(
 	     imaging_handle,
 	     print_status_information,
@@ -649,6 +1248,28 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
+			if( imaging_handle->buffer_limiter != NULL )
+			{
+				if( buffer_limiter_adjust(
+				     imaging_handle->buffer_limiter,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to adjust buffer limiter.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* Grabbing blocks while all the storage media buffers are in flight
+			 */
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			if( storage_media_buffer_queue_grab_buffer(
 			     imaging_handle->storage_media_buffer_queue,
 			     &storage_media_buffer,
@@ -663,6 +1284,11 @@ int ewfacquirestream_read_input(
 
 				goto on_error;
 			}
+			stage_profiler_add_wait(
+			 imaging_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_READ,
+			 start_timestamp,
+			 NULL );
 			if( storage_media_buffer == NULL )
 			{
 				libcerror_error_set(
@@ -677,6 +1303,85 @@ int ewfacquirestream_read_input(
 		}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT )
+		number_of_batch_buffers = 0;
+
+		if( ( maximum_number_of_batch_buffers > 1 )
+		 && ( skip_aquiry_size == 0 ) )
+		{
+			number_of_batch_buffers = maximum_number_of_batch_buffers;
+
+			if( ( imaging_handle->acquiry_size != 0 )
+			 && ( remaining_aquiry_size < ( (size64_t) number_of_batch_buffers * process_buffer_size ) ) )
+			{
+				number_of_batch_buffers = (int) ( remaining_aquiry_size / process_buffer_size );
+			}
+		}
+		/* A batch holds on to its storage media buffers until it was read, hence it is
+		 * bounded by the number of buffers the buffer limiter currently allows in flight
+		 */
+		if( ( number_of_batch_buffers > 1 )
+		 && ( imaging_handle->buffer_limiter != NULL ) )
+		{
+			if( buffer_limiter_get_number_of_buffers(
+			     imaging_handle->buffer_limiter,
+			     &number_of_limited_buffers,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of buffers from buffer limiter.",
+				 function );
+
+				goto on_error;
+			}
+			if( number_of_batch_buffers > ( number_of_limited_buffers / 2 ) )
+			{
+				number_of_batch_buffers = number_of_limited_buffers / 2;
+			}
+		}
+		if( number_of_batch_buffers > 1 )
+		{
+			/* The storage media buffers are passed on to the imaging handle or released onto the queue
+			 */
+			read_count = ewfacquirestream_process_pipe_batch(
+			              imaging_handle,
+			              input_file_descriptor,
+			              storage_media_buffer,
+			              number_of_batch_buffers,
+			              storage_media_offset,
+			              process_buffer_size,
+			              swap_byte_pairs,
+			              error );
+
+			storage_media_buffer = NULL;
+
+			if( read_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: error reading data from input.",
+				 function );
+
+				goto on_error;
+			}
+			storage_media_offset  += read_count;
+			remaining_aquiry_size -= read_count;
+
+			/* The batch is only partially filled at the end of the input
+			 */
+			if( (size_t) read_count < ( (size_t) number_of_batch_buffers * process_buffer_size ) )
+			{
+				break;
+			}
+			continue;
+		}
+#endif /* defined( EWFACQUIRESTREAM_HAVE_PIPE_BATCH_SUPPORT ) */
+
 		read_size = process_buffer_size;
 
 		/* Align with acquiry offset if necessary
@@ -691,6 +1396,10 @@ int ewfacquirestream_read_input(
 		{
 			read_size = (size_t) remaining_aquiry_size;
 		}
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
 		/* Read a chunk from the file descriptor
 		 */
 		read_count = ewfacquirestream_read_chunk(
@@ -718,6 +1427,13 @@ int ewfacquirestream_read_input(
 		{
 			break;
 		}
+		stage_profiler_add_sample(
+		 imaging_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+
 		storage_media_offset += read_count;
 
 		/* Skip a certain number of bytes if necessary
@@ -751,20 +1467,8 @@ int ewfacquirestream_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( imaging_handle->number_of_threads > 0 )
 		{
-			if( libcthreads_thread_pool_push(
-			     imaging_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
-				 function );
-
-				return( -1 );
-			}
+			/* The imaging handle has passed the storage media buffer on to the digest stage
+			 */
 			storage_media_buffer = NULL;
 		}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
@@ -898,7 +1602,9 @@ int main( int argc, char * const argv[] )
 {
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
+	log_handle_t *metrics_handle                         = NULL;
 	system_character_t *log_filename                     = NULL;
+	system_character_t *metrics_filename                 = NULL;
 	system_character_t *option_additional_digest_types   = NULL;
 	system_character_t *option_bytes_per_sector          = NULL;
 	system_character_t *option_case_number               = NULL;
@@ -907,6 +1613,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_evidence_number           = NULL;
 	system_character_t *option_examiner_name             = NULL;
 	system_character_t *option_format                    = NULL;
+	system_character_t *option_hash_backend              = NULL;
 	system_character_t *option_header_codepage           = NULL;
 	system_character_t *option_maximum_segment_size      = NULL;
 	system_character_t *option_media_flags               = NULL;
@@ -919,6 +1626,7 @@ int main( int argc, char * const argv[] )
         system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
         system_character_t *option_target_filename           = NULL;
+	system_character_t *option_write_options             = NULL;
 	system_character_t *program                          = _SYSTEM_STRING( "ewfacquirestream" );
 	system_integer_t option                              = 0;
 	size_t string_length                                 = 0;
@@ -996,7 +1704,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hH:j:J:l:m:M:N:o:O:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1076,11 +1784,21 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_hash_backend = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				metrics_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -1106,6 +1824,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				option_write_options = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1573,6 +2296,28 @@ int main( int argc, char * const argv[] )
 			 ewfacquirestream_imaging_handle->maximum_segment_size );
 		}
 	}
+	if( option_write_options != NULL )
+	{
+		result = imaging_handle_set_write_flags(
+			  ewfacquirestream_imaging_handle,
+			  option_write_options,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set write options.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported write options defaulting to: none.\n" );
+		}
+	}
 	if( option_offset != NULL )
 	{
 		result = imaging_handle_set_acquiry_offset(
@@ -1695,6 +2440,28 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_hash_backend != NULL )
+	{
+		result = imaging_handle_set_hash_backend(
+			  ewfacquirestream_imaging_handle,
+			  option_hash_backend,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set hash backend.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported hash backend defaulting to: auto.\n" );
+		}
+	}
 	fprintf(
 	 stdout,
 	 "Using the following acquiry parameters:\n" );
@@ -1792,6 +2559,42 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     metrics_handle,
+		     metrics_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open metrics file: %" PRIs_SYSTEM ".\n",
+			 metrics_filename );
+
+			goto on_error;
+		}
+		if( imaging_handle_set_metrics_stream(
+		     ewfacquirestream_imaging_handle,
+		     metrics_handle->log_stream,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set metrics stream.\n" );
+
+			goto on_error;
+		}
+	}
 	result = ewfacquirestream_read_input(
 	          ewfacquirestream_imaging_handle,
 	          0,
@@ -1836,6 +2639,29 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_handle != NULL )
+	{
+		if( log_handle_close(
+		     metrics_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free metrics handle.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
 	{
@@ -1910,6 +2736,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( metrics_handle != NULL )
+	{
+		log_handle_close(
+		 metrics_handle,
+		 NULL );
+		log_handle_free(
+		 &metrics_handle,
+		 NULL );
+	}
 	if( ewfacquirestream_imaging_handle != NULL )
 	{
 		imaging_handle_close(
@@ -122,8 +122,9 @@ void usage_fprint(
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
-	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -o offset ] [ -p process_buffer_size ] [ -r readers ]\n"
+	                 "                 [ -S segment_file_size ] [ -t target ]\n"
+	                 "                 [ -W number_of_writers ] [ -hqsuvVwxz ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -154,12 +155,16 @@ void usage_fprint(
 	                 "\t           encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
-	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t           if multi-threaded mode is supported)\n" );
+	                 "\t           0 represents single-threaded mode, \"auto\" sizes the number\n"
+	                 "\t           of threads and buffers to the available processors and memory\n"
+	                 "\t           (default is 4 if multi-threaded mode is supported)\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-r:        the number of readers that read the input in parallel, each\n"
+	                 "\t           with its own file handles, where a number of 1 represents a\n"
+	                 "\t           single reader (default is 1, requires multi-threaded mode)\n" );
 	fprintf( stream, "\t-s:        swap byte pairs of the media data (from AB to BA)\n"
 	                 "\t           (use this for big to little endian conversion and vice\n"
 	                 "\t           versa)\n" );
@@ -194,8 +199,20 @@ void usage_fprint(
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
+	fprintf( stream, "\t-W:        the number of concurrent writer threads of the raw output,\n"
+	                 "\t           where the segment files are written with positioned writes\n"
+	                 "\t           (default is 0, which writes the raw output in order)\n"
+	                 "\t           (only supported for raw, not for stdout, and requires\n"
+	                 "\t           multi-threaded mode)\n" );
 	fprintf( stream, "\t-x:        use the data chunk functions instead of the buffered read and\n"
-	                 "\t           write functions.\n" );
+	                 "\t           write functions. When exporting to EWF with the same chunk\n"
+	                 "\t           size and compression method, chunks are copied without\n"
+	                 "\t           recompression. A different number of sectors per chunk\n"
+	                 "\t           requires multi-threaded mode and a multiple, or a divisor,\n"
+	                 "\t           of the number of sectors per chunk of the input.\n" );
+	fprintf( stream, "\t-z:        write sparse raw output, ranges of zero bytes are left as\n"
+	                 "\t           holes in the output files instead of being written (not used\n"
+	                 "\t           for stdout)\n" );
 }
 
 /* Signal handler for ewfexport
@@ -267,6 +284,8 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_header_codepage         = NULL;
 	system_character_t *option_maximum_segment_size    = NULL;
 	system_character_t *option_number_of_jobs          = NULL;
+	system_character_t *option_number_of_raw_writers   = NULL;
+	system_character_t *option_number_of_readers       = NULL;
 	system_character_t *option_offset                  = NULL;
 	system_character_t *option_process_buffer_size     = NULL;
 	system_character_t *option_sectors_per_chunk       = NULL;
@@ -277,6 +296,7 @@ int main( int argc, char * const argv[] )
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
 	uint8_t print_status_information                   = 1;
+	uint8_t sparse_output                              = 0;
 	uint8_t swap_byte_pairs                            = 0;
 	uint8_t use_data_chunk_functions                   = 0;
 	uint8_t verbose                                    = 0;
@@ -351,7 +371,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qr:sS:t:uvVwW:xz" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -436,6 +456,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'r':
+				option_number_of_readers = optarg;
+
+				break;
+
 			case (system_integer_t) 's':
 				swap_byte_pairs = 1;
 
@@ -476,9 +501,19 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'W':
+				option_number_of_raw_writers = optarg;
+
+				break;
+
 			case (system_integer_t) 'x':
 				use_data_chunk_functions = 1;
 
+				break;
+
+			case (system_integer_t) 'z':
+				sparse_output = 1;
+
 				break;
 		}
 	}
@@ -567,6 +602,8 @@ int main( int argc, char * const argv[] )
 #if defined( __clang_analyzer__ )
 	__builtin_assume( ewfexport_export_handle != NULL );
 #endif
+	ewfexport_export_handle->sparse_output = sparse_output;
+
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -610,6 +647,77 @@ int main( int argc, char * const argv[] )
 		libcerror_error_free(
 		 &error );
 	}
+	/* The number of jobs (threads) and readers are needed to open the readers with the input
+	 */
+	if( option_number_of_jobs != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = export_handle_set_number_of_threads(
+			  ewfexport_export_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		{
+			ewfexport_export_handle->number_of_threads = 4;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfexport_export_handle->number_of_threads );
+		}
+#else
+		ewfexport_export_handle->number_of_threads = 0;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+		 ewfexport_export_handle->number_of_threads );
+#endif
+	}
+	if( option_number_of_readers != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = export_handle_set_number_of_readers(
+			  ewfexport_export_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfexport_export_handle->number_of_readers = 1;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: %d.\n",
+			 ewfexport_export_handle->number_of_readers );
+		}
+#else
+		ewfexport_export_handle->number_of_readers = 1;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of readers defaulting to: %d.\n",
+		 ewfexport_export_handle->number_of_readers );
+#endif
+	}
 	result = export_handle_open_input(
 	          ewfexport_export_handle,
 	          source_filenames,
@@ -785,17 +893,6 @@ int main( int argc, char * const argv[] )
 			 "Unsupported sectors per chunk defaulting to: %" PRIu32 ".\n",
 			 ewfexport_export_handle->output_sectors_per_chunk );
 		}
-		if( use_data_chunk_functions != 0 )
-		{
-			fprintf(
-			 stderr,
-			 "Setting sectors per chunk when using data chunk functions currently not supported defaulting to: %" PRIu32 ".\n",
-			 ewfexport_export_handle->input_sectors_per_chunk );
-		}
-	}
-	if( use_data_chunk_functions != 0 )
-	{
-		ewfexport_export_handle->output_sectors_per_chunk = ewfexport_export_handle->input_sectors_per_chunk;
 	}
 	if( option_maximum_segment_size != NULL )
 	{
@@ -892,39 +989,45 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
-	if( option_number_of_jobs != NULL )
+	if( option_number_of_raw_writers != NULL )
 	{
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-		result = export_handle_set_number_of_threads(
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+		result = export_handle_set_number_of_raw_writers(
 			  ewfexport_export_handle,
-			  option_number_of_jobs,
+			  option_number_of_raw_writers,
 			  &error );
 
 		if( result == -1 )
 		{
 			fprintf(
 			 stderr,
-			 "Unable to set number of jobs (threads).\n" );
+			 "Unable to set number of raw writers.\n" );
 
 			goto on_error;
 		}
-		else if( ( result == 0 )
-		      || ( ewfexport_export_handle->number_of_threads > (int) 32 ) )
+		else if( result == 0 )
 		{
-			ewfexport_export_handle->number_of_threads = 4;
+			ewfexport_export_handle->number_of_raw_writers = 0;
 
 			fprintf(
 			 stderr,
-			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
-			 ewfexport_export_handle->number_of_threads );
+			 "Unsupported number of raw writers defaulting to: %d.\n",
+			 ewfexport_export_handle->number_of_raw_writers );
 		}
-#else
-		ewfexport_export_handle->number_of_threads = 0;
+		else if( ( ewfexport_export_handle->number_of_raw_writers != 0 )
+		      && ( ewfexport_export_handle->number_of_threads == 0 ) )
+		{
+			ewfexport_export_handle->number_of_raw_writers = 0;
 
+			fprintf(
+			 stderr,
+			 "Raw writers require multi-threaded mode defaulting to: %d.\n",
+			 ewfexport_export_handle->number_of_raw_writers );
+		}
+#else
 		fprintf(
 		 stderr,
-		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
-		 ewfexport_export_handle->number_of_threads );
+		 "Unsupported number of raw writers defaulting to: 0.\n" );
 #endif
 	}
 	if( option_additional_digest_types != NULL )
@@ -1220,6 +1323,31 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
+	/* With the data chunk functions the chunks can only be written with a different chunk size
+	 * when the process threads repack them, see export_handle_determine_parallel_repack
+	 */
+	if( ( use_data_chunk_functions != 0 )
+	 && ( ewfexport_export_handle->output_sectors_per_chunk != ewfexport_export_handle->input_sectors_per_chunk ) )
+	{
+		if( ( ewfexport_export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+		 || ( ewfexport_export_handle->number_of_threads == 0 )
+		 || ( swap_byte_pairs != 0 )
+		 || ( ewfexport_export_handle->input_sectors_per_chunk == 0 )
+		 || ( ewfexport_export_handle->input_chunk_size == 0 )
+		 || ( ( ( ewfexport_export_handle->output_sectors_per_chunk % ewfexport_export_handle->input_sectors_per_chunk ) != 0 )
+		  &&  ( ( ewfexport_export_handle->input_sectors_per_chunk % ewfexport_export_handle->output_sectors_per_chunk ) != 0 ) )
+		 || ( ( ewfexport_export_handle->export_offset % ewfexport_export_handle->input_chunk_size ) != 0 ) )
+		{
+			if( ewfexport_export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+			{
+				fprintf(
+				 stderr,
+				 "Unsupported sectors per chunk when using data chunk functions defaulting to: %" PRIu32 ".\n",
+				 ewfexport_export_handle->input_sectors_per_chunk );
+			}
+			ewfexport_export_handle->output_sectors_per_chunk = ewfexport_export_handle->input_sectors_per_chunk;
+		}
+	}
 	fprintf(
 	 stderr,
 	 "\n" );
@@ -1334,6 +1462,30 @@ int main( int argc, char * const argv[] )
 			libcerror_error_free(
 			 &error );
 		}
+		else if( ewfexport_abort == 0 )
+		{
+			result = export_handle_verify_integrity_hash(
+			          ewfexport_export_handle,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to verify integrity hash(es).\n" );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Integrity hash(es) stored in the input do not match the exported data.\n" );
+			}
+		}
 	}
 	if( log_handle != NULL )
 	{
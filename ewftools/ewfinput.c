@@ -36,6 +36,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "digest_context.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
@@ -1080,6 +1081,90 @@ int ewfinput_determine_header_codepage(
 	return( result );
 }
 
+/* Determines the hash backend from a string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int ewfinput_determine_hash_backend(
+     const system_character_t *string,
+     int *hash_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfinput_determine_hash_backend";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash backend.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "auto" ),
+		     4 ) == 0 )
+		{
+			*hash_backend = DIGEST_CONTEXT_BACKEND_AUTO;
+			result        = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "armv8" ),
+		     5 ) == 0 )
+		{
+			*hash_backend = DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO;
+			result        = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sha-ni" ),
+		     6 ) == 0 )
+		{
+			*hash_backend = DIGEST_CONTEXT_BACKEND_SHA_EXTENSIONS;
+			result        = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "generic" ),
+		     7 ) == 0 )
+		{
+			*hash_backend = DIGEST_CONTEXT_BACKEND_GENERIC;
+			result        = 1;
+		}
+	}
+	return( result );
+}
+
 /* Determines the yes or no value from a string
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
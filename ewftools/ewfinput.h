@@ -101,6 +101,11 @@ int ewfinput_determine_header_codepage(
      int *header_codepage,
      libcerror_error_t **error );
 
+int ewfinput_determine_hash_backend(
+     const system_character_t *string,
+     int *hash_backend,
+     libcerror_error_t **error );
+
 int ewfinput_determine_yes_no(
      const system_character_t *string,
      uint8_t *yes_no_value,
@@ -76,8 +76,11 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -j jobs ] [ -l log_filename ] [ -p process_buffer_size ]\n"
-	                 "                 [ -hqvVwx ] ewf_files\n\n" );
+	                 "                 [ -H hash_backend ] [ -j jobs ] [ -J metrics_filename ]\n"
+	                 "                 [ -l log_filename ]\n"
+	                 "                 [ -p process_buffer_size ] [ -r readers ]\n"
+	                 "                 [ -R offset:size[,offset:size] ] [ -S sample_size ]\n"
+	                 "                 [ -CchqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -86,19 +89,37 @@ void usage_fprint(
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
 	                 "\t           windows-1253, windows-1254, windows-1255, windows-1256,\n"
 	                 "\t           windows-1257 or windows-1258\n" );
+	fprintf( stream, "\t-C:        only verify the chunks, validates the checksum or compressed\n"
+	                 "\t           data of every chunk without calculating the digest (hash)\n" );
+	fprintf( stream, "\t-c:        periodically store a checkpoint of the verification next\n"
+	                 "\t           to the first EWF segment file and resume an interrupted\n"
+	                 "\t           verification from its last checkpoint\n" );
 	fprintf( stream, "\t-d:        calculate digest (hash) types, options: md5, sha1, sha256.\n"
 	                 "\t           By default ewfverify will calculate the digest (hash) types\n"
 	                 "\t           that are stored in the EWF segment files or MD5 if none.\n" );
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-H:        specify the digest (hash) calculation backend, options:\n"
+	                 "\t           auto (default), generic, sha-ni or armv8\n" );
 	fprintf( stream, "\t-j:        the number of concurrent processing jobs (threads), where\n"
-	                 "\t           a number of 0 represents single-threaded mode (default is 4\n"
-	                 "\t           if multi-threaded mode is supported)\n" );
+	                 "\t           0 represents single-threaded mode, \"auto\" sizes the number\n"
+	                 "\t           of threads and buffers to the available processors and memory\n"
+	                 "\t           (default is 4 if multi-threaded mode is supported)\n" );
+	fprintf( stream, "\t-J:        writes metrics, as one JSON record per line, to the\n"
+	                 "\t           metrics_filename every second and when the verification\n"
+	                 "\t           stops, use /dev/fd/N to write to an open file descriptor\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-r:        the number of readers that read the input in parallel, each\n"
+	                 "\t           with its own file handles, where a number of 1 represents a\n"
+	                 "\t           single reader (default is 1, requires multi-threaded mode)\n" );
+	fprintf( stream, "\t-R:        only verify the chunks in the ranges of the media, where a range\n"
+	                 "\t           is specified as offset:size in bytes\n" );
+	fprintf( stream, "\t-S:        only verify a random sample of the chunks, where the sample\n"
+	                 "\t           size is a number of chunks or a percentage, e.g. 5%%\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -165,17 +186,25 @@ int main( int argc, char * const argv[] )
 	system_character_t * const *source_filenames   = NULL;
 	libcerror_error_t *error                       = NULL;
 	log_handle_t *log_handle                       = NULL;
+	log_handle_t *metrics_handle                   = NULL;
 	system_character_t *log_filename               = NULL;
+	system_character_t *metrics_filename           = NULL;
 	system_character_t *option_digest_types        = NULL;
 	system_character_t *option_format              = NULL;
+	system_character_t *option_hash_backend        = NULL;
 	system_character_t *option_header_codepage     = NULL;
 	system_character_t *option_number_of_jobs      = NULL;
+	system_character_t *option_number_of_readers   = NULL;
 	system_character_t *option_process_buffer_size = NULL;
+	system_character_t *option_sample_ranges       = NULL;
+	system_character_t *option_sample_size         = NULL;
 	system_character_t *program                    = _SYSTEM_STRING( "ewfverify" );
 	system_integer_t option                        = 0;
 	uint8_t print_status_information               = 1;
+	uint8_t use_checkpoints                        = 0;
 	uint8_t use_data_chunk_functions               = 0;
 	uint8_t verbose                                = 0;
+	uint8_t verify_chunks_only                     = 0;
 	uint8_t zero_chunk_on_error                    = 0;
 	int number_of_filenames                        = 0;
 	int result                                     = 0;
@@ -222,7 +251,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:d:f:j:hl:p:qvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:Ccd:f:hH:j:J:l:p:qr:R:S:vVwx" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -243,6 +272,16 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'C':
+				verify_chunks_only = 1;
+
+				break;
+
+			case (system_integer_t) 'c':
+				use_checkpoints = 1;
+
+				break;
+
 			case (system_integer_t) 'd':
 				option_digest_types = optarg;
 
@@ -259,11 +298,21 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'H':
+				option_hash_backend = optarg;
+
+				break;
+
 			case (system_integer_t) 'j':
 				option_number_of_jobs = optarg;
 
 				break;
 
+			case (system_integer_t) 'J':
+				metrics_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -279,6 +328,21 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'r':
+				option_number_of_readers = optarg;
+
+				break;
+
+			case (system_integer_t) 'R':
+				option_sample_ranges = optarg;
+
+				break;
+
+			case (system_integer_t) 'S':
+				option_sample_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -438,6 +502,40 @@ int main( int argc, char * const argv[] )
 		 stderr,
 		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
 		 ewfverify_verification_handle->number_of_threads );
+#endif
+	}
+	if( option_number_of_readers != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = verification_handle_set_number_of_readers(
+			  ewfverify_verification_handle,
+			  option_number_of_readers,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of readers.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfverify_verification_handle->number_of_readers = 1;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of readers defaulting to: %d.\n",
+			 ewfverify_verification_handle->number_of_readers );
+		}
+#else
+		ewfverify_verification_handle->number_of_readers = 1;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of readers defaulting to: %d.\n",
+		 ewfverify_verification_handle->number_of_readers );
 #endif
 	}
 	if( option_digest_types != NULL )
@@ -456,6 +554,28 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_hash_backend != NULL )
+	{
+		result = verification_handle_set_hash_backend(
+			  ewfverify_verification_handle,
+			  option_hash_backend,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set hash backend.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported hash backend defaulting to: auto.\n" );
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_initialize(
 	     &glob,
@@ -557,6 +677,30 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	/* Checkpoints only apply to the verification of the entire media
+	 */
+	if( ( use_checkpoints != 0 )
+	 && ( verify_chunks_only == 0 )
+	 && ( option_sample_size == NULL )
+	 && ( option_sample_ranges == NULL ) )
+	{
+		if( verification_handle_open_checkpoint_file(
+		     ewfverify_verification_handle,
+		     source_filenames[ 0 ],
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stdout,
+			 "Unable to open checkpoint file - continuing without checkpoints.\n" );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+			libcnotify_print_error_backtrace(
+			 error );
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+	}
 #if !defined( HAVE_GLOB_H )
 	if( ewftools_glob_free(
 	     &glob,
@@ -580,6 +724,56 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	/* The sample depends on the media size and chunk size of the input
+	 */
+	if( option_sample_size != NULL )
+	{
+		result = verification_handle_set_sample_size(
+			  ewfverify_verification_handle,
+			  option_sample_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sample size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sample size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_sample_ranges != NULL )
+	{
+		result = verification_handle_set_sample_ranges(
+			  ewfverify_verification_handle,
+			  option_sample_ranges,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set sample ranges.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported sample ranges.\n" );
+
+			goto on_error;
+		}
+	}
 	if( log_filename != NULL )
 	{
 		if( log_handle_initialize(
@@ -605,6 +799,42 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_filename != NULL )
+	{
+		if( log_handle_initialize(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_open(
+		     metrics_handle,
+		     metrics_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open metrics file: %" PRIs_SYSTEM ".\n",
+			 metrics_filename );
+
+			goto on_error;
+		}
+		if( verification_handle_set_metrics_stream(
+		     ewfverify_verification_handle,
+		     metrics_handle->log_stream,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set metrics stream.\n" );
+
+			goto on_error;
+		}
+	}
 	if( ewfverify_verification_handle->input_format == VERIFICATION_HANDLE_INPUT_FORMAT_FILES )
 	{
 		result = verification_handle_verify_single_files(
@@ -625,6 +855,46 @@ int main( int argc, char * const argv[] )
 			 &error );
 		}
 	}
+	else if( ewfverify_verification_handle->sample_scheduler != NULL )
+	{
+		result = verification_handle_verify_sample(
+		          ewfverify_verification_handle,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify sample.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	else if( verify_chunks_only != 0 )
+	{
+		result = verification_handle_verify_chunks(
+		          ewfverify_verification_handle,
+		          print_status_information,
+		          log_handle,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to verify chunks.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
 	else
 	{
 		result = verification_handle_verify_input(
@@ -668,6 +938,29 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( metrics_handle != NULL )
+	{
+		if( log_handle_close(
+		     metrics_handle,
+		     &error ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to close metrics handle.\n" );
+
+			goto on_error;
+		}
+		if( log_handle_free(
+		     &metrics_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free metrics handle.\n" );
+
+			goto on_error;
+		}
+	}
 on_abort:
 	if( ewftools_signal_detach(
 	     &error ) != 1 )
@@ -744,6 +1037,15 @@ on_error:
 		 &log_handle,
 		 NULL );
 	}
+	if( metrics_handle != NULL )
+	{
+		log_handle_close(
+		 metrics_handle,
+		 NULL );
+		log_handle_free(
+		 &metrics_handle,
+		 NULL );
+	}
 	if( ewfverify_verification_handle != NULL )
 	{
 		verification_handle_close(
@@ -41,6 +41,7 @@
 #include <uuid/uuid.h>
 #endif
 
+#include "buffer_limiter.h"
 #include "byte_size_string.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
@@ -57,8 +58,10 @@
 #include "export_handle.h"
 #include "guid.h"
 #include "process_status.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "system_resources.h"
 
 #define EXPORT_HANDLE_BUFFER_SIZE			8192
 #define EXPORT_HANDLE_INPUT_BUFFER_SIZE			64
@@ -174,6 +177,19 @@ int export_handle_initialize(
 
 		goto on_error;
 	}
+	if( stage_profiler_initialize(
+	     &( ( *export_handle )->stage_profiler ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stage profiler.",
+		 function );
+
+		goto on_error;
+	}
 	if( calculate_md5 != 0 )
 	{
 		( *export_handle )->calculated_md5_hash_string = narrow_string_allocate(
@@ -203,13 +219,20 @@ int export_handle_initialize(
 	( *export_handle )->notify_stream            = EXPORT_HANDLE_NOTIFY_STREAM;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	( *export_handle )->number_of_threads        = 4;
+	( *export_handle )->number_of_threads            = 4;
+	( *export_handle )->maximum_process_buffers_size = EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE;
 #endif
 	return( 1 );
 
 on_error:
 	if( *export_handle != NULL )
 	{
+		if( ( *export_handle )->stage_profiler != NULL )
+		{
+			stage_profiler_free(
+			 &( ( *export_handle )->stage_profiler ),
+			 NULL );
+		}
 		if( ( *export_handle )->input_buffer != NULL )
 		{
 			memory_free(
@@ -246,6 +269,24 @@ int export_handle_free(
 	}
 	if( *export_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->readers != NULL )
+		{
+			if( export_handle_free_readers(
+			     *export_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free readers.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 ( *export_handle )->input_buffer );
 
@@ -302,6 +343,24 @@ int export_handle_free(
 				result = -1;
 			}
 		}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+		if( ( *export_handle )->split_raw_writer != NULL )
+		{
+			if( split_raw_writer_free(
+			     &( ( *export_handle )->split_raw_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free split raw writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *export_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -365,6 +424,19 @@ int export_handle_free(
 			memory_free(
 			 ( *export_handle )->calculated_sha256_hash_string );
 		}
+		if( stage_profiler_free(
+		     &( ( *export_handle )->stage_profiler ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stage profiler.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *export_handle );
 
@@ -382,6 +454,10 @@ int export_handle_signal_abort(
 {
 	static char *function = "export_handle_signal_abort";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_index      = 0;
+#endif
+
 	if( export_handle == NULL )
 	{
 		libcerror_error_set(
@@ -409,6 +485,34 @@ int export_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->readers != NULL )
+	{
+		for( reader_index = 0;
+		     reader_index < export_handle->number_of_readers;
+		     reader_index++ )
+		{
+			if( export_handle->readers[ reader_index ].input_handle == NULL )
+			{
+				continue;
+			}
+			if( libewf_handle_signal_abort(
+			     export_handle->readers[ reader_index ].input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal reader: %d input handle to abort.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
+#endif
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
 		if( libewf_handle_signal_abort(
@@ -425,8 +529,7 @@ int export_handle_signal_abort(
 			return( -1 );
 		}
 	}
-	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
-	      && ( export_handle->use_stdout == 0 ) )
+	else if( export_handle->raw_output_handle != NULL )
 	{
 		if( libsmraw_handle_signal_abort(
 		     export_handle->raw_output_handle,
@@ -482,6 +585,8 @@ int export_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	export_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
@@ -604,6 +709,41 @@ int export_handle_open_input(
 		}
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( export_handle->number_of_readers > 1 ) )
+	{
+		if( export_handle_open_readers(
+		     export_handle,
+		     filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open readers.",
+			 function );
+
+			if( libewf_filenames != NULL )
+			{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				libewf_glob_wide_free(
+				 libewf_filenames,
+				 number_of_filenames,
+				 NULL );
+#else
+				libewf_glob_free(
+				 libewf_filenames,
+				 number_of_filenames,
+				 NULL );
+#endif
+			}
+			return( -1 );
+		}
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -937,6 +1077,28 @@ int export_handle_open_output(
 		{
 			export_handle->use_stdout = 1;
 		}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+		else if( ( export_handle->number_of_raw_writers > 0 )
+		      && ( export_handle->number_of_threads > 0 ) )
+		{
+			/* The segment files are created by the writer threads
+			 */
+			if( split_raw_writer_initialize(
+			     &( export_handle->split_raw_writer ),
+			     filename,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create split raw writer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 		else
 		{
 			if( export_handle->raw_output_handle != NULL )
@@ -1065,19 +1227,40 @@ int export_handle_close(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle_close_readers(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close readers.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 0 );
 }
 
-/* Prepares a storage media buffer before writing the output of the export handle
- * Returns the resulting buffer size or -1 on error
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the readers on the input files
+ * Every reader has its own libewf input handle, and with it its own file handles,
+ * so that the readers can read the input in parallel
+ * Returns 1 if successful or -1 on error
  */
-ssize_t export_handle_prepare_write_storage_media_buffer(
-         export_handle_t *export_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         libcerror_error_t **error )
+int export_handle_open_readers(
+     export_handle_t *export_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
 {
-	static char *function = "export_handle_prepare_write_storage_media_buffer";
-	ssize_t process_count = 0;
+	static char *function              = "export_handle_open_readers";
+	int maximum_number_of_open_handles = 0;
+	int reader_index                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1090,178 +1273,174 @@ ssize_t export_handle_prepare_write_storage_media_buffer(
 
 		return( -1 );
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( export_handle->readers != NULL )
 	{
-		process_count = storage_media_buffer_write_process(
-		                 storage_media_buffer,
-		                 error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - readers value already set.",
+		 function );
 
-		if( process_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to prepare storage media buffer before writing.",
-			 function );
+		return( -1 );
+	}
+	if( ( export_handle->number_of_readers <= 1 )
+	 || ( export_handle->number_of_readers > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_READERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - number of readers value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	maximum_number_of_open_handles = export_handle->maximum_number_of_open_handles;
+
+	if( maximum_number_of_open_handles > 0 )
 	{
-		if( storage_media_buffer == NULL )
+		/* The input handle and the readers share the maximum number of open file handles
+		 */
+		maximum_number_of_open_handles /= export_handle->number_of_readers + 1;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     export_handle->input_handle,
+		     maximum_number_of_open_handles,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid storage media buffer.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in input handle.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		process_count = (ssize_t) storage_media_buffer->raw_buffer_data_size;
 	}
-	return( process_count );
-}
-
-/* Writes a storage media buffer to the output of the export handle
- * Returns the number of bytes written or -1 on error
- */
-ssize_t export_handle_write_storage_media_buffer(
-         export_handle_t *export_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         size_t write_size,
-         libcerror_error_t **error )
-{
-	static char *function = "export_handle_write_storage_media_buffer";
-	ssize_t write_count   = 0;
+	export_handle->readers = (export_handle_reader_t *) memory_allocate(
+	                                                     sizeof( export_handle_reader_t ) * export_handle->number_of_readers );
 
-	if( export_handle == NULL )
+	if( export_handle->readers == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readers.",
 		 function );
 
-		return( -1 );
-	}
-	if( write_size == 0 )
-	{
-		return( 0 );
+		goto on_error;
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( memory_set(
+	     export_handle->readers,
+	     0,
+	     sizeof( export_handle_reader_t ) * export_handle->number_of_readers ) == NULL )
 	{
-		write_count = storage_media_buffer_write_to_handle(
-			       storage_media_buffer,
-			       export_handle->ewf_output_handle,
-			       write_size,
-			       error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readers.",
+		 function );
+
+		memory_free(
+		 export_handle->readers );
+
+		export_handle->readers = NULL;
+
+		goto on_error;
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_readers;
+	     reader_index++ )
 	{
-		if( storage_media_buffer == NULL )
+		if( libewf_handle_initialize(
+		     &( export_handle->readers[ reader_index ].input_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid storage media buffer.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create reader: %d input handle.",
+			 function,
+			 reader_index );
 
-			return( -1 );
-		}
-		if( export_handle->use_stdout != 0 )
-		{
-#if defined( WINAPI ) && !defined( __CYGWIN__ )
-			write_count = _write(
-			               1,
-				       storage_media_buffer->raw_buffer,
-				       (unsigned int) write_size );
-#else
-			write_count = write(
-			               1,
-				       storage_media_buffer->raw_buffer,
-				       write_size );
-#endif
+			goto on_error;
 		}
-		else
+		if( maximum_number_of_open_handles > 0 )
 		{
-			write_count = libsmraw_handle_write_buffer(
-				       export_handle->raw_output_handle,
-				       storage_media_buffer->raw_buffer,
-				       write_size,
-				       error );
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     export_handle->readers[ reader_index ].input_handle,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in reader: %d input handle.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
 		}
-	}
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write storage media buffer.",
-		 function );
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     export_handle->readers[ reader_index ].input_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     export_handle->readers[ reader_index ].input_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open files in reader: %d input handle.",
+			 function,
+			 reader_index );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	return( write_count );
-}
-
-/* Seeks the offset
- * Returns the resulting offset or -1 on error
- */
-off64_t export_handle_seek_offset(
-         export_handle_t *export_handle,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function = "export_handle_seek_offset";
-
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
+	return( 1 );
 
-		return( -1 );
-	}
-	if( libewf_handle_seek_offset(
-	     export_handle->input_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+on_error:
+	if( export_handle->readers != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
-
-		return( -1 );
+		export_handle_free_readers(
+		 export_handle,
+		 NULL );
 	}
-	return( offset );
+	return( -1 );
 }
 
-/* Swaps the byte order of byte pairs within a buffer of a certain size
- * Returns 1 if successful, -1 on error
+/* Closes the readers
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_swap_byte_pairs(
+int export_handle_close_readers(
      export_handle_t *export_handle,
-     uint8_t *buffer,
-     size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_swap_byte_pairs";
-	size_t buffer_offset  = 0;
-	uint8_t byte_value    = 0;
+	static char *function = "export_handle_close_readers";
+	int reader_index      = 0;
+	int result            = 1;
 
 	if( export_handle == NULL )
 	{
@@ -1274,61 +1453,46 @@ int export_handle_swap_byte_pairs(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( export_handle->readers == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	/* If the last bit is set the value is odd
-	 */
-	if( ( buffer_size & 0x01 ) != 0 )
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_readers;
+	     reader_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid buffer size value is odd.",
-		 function );
+		if( export_handle->readers[ reader_index ].input_handle == NULL )
+		{
+			continue;
+		}
+		if( libewf_handle_close(
+		     export_handle->readers[ reader_index ].input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader: %d input handle.",
+			 function,
+			 reader_index );
 
-		return( -1 );
-	}
-	for( buffer_offset = 0;
-	     buffer_offset < buffer_size;
-	     buffer_offset += 2 )
-	{
-		byte_value                  = buffer[ buffer_offset ];
-		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
-		buffer[ buffer_offset + 1 ] = byte_value;
+			result = -1;
+		}
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Initializes the integrity hash(es)
+/* Frees the readers
  * Returns 1 if successful or -1 on error
  */
-int export_handle_initialize_integrity_hash(
+int export_handle_free_readers(
      export_handle_t *export_handle,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_initialize_integrity_hash";
+	static char *function = "export_handle_free_readers";
+	int reader_index      = 0;
+	int result            = 1;
 
 	if( export_handle == NULL )
 	{
@@ -1341,85 +1505,59 @@ int export_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( export_handle->readers == NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( export_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		export_handle->md5_context_initialized = 1;
+		return( 1 );
 	}
-	if( export_handle->calculate_sha1 != 0 )
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_readers;
+	     reader_index++ )
 	{
-		if( libhmac_sha1_initialize(
-		     &( export_handle->sha1_context ),
-		     error ) != 1 )
+		if( export_handle->readers[ reader_index ].input_handle == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA1 context.",
-			 function );
-
-			goto on_error;
+			continue;
 		}
-		export_handle->sha1_context_initialized = 1;
-	}
-	if( export_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_initialize(
-		     &( export_handle->sha256_context ),
+		if( libewf_handle_free(
+		     &( export_handle->readers[ reader_index ].input_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create SHA256 context.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader: %d input handle.",
+			 function,
+			 reader_index );
 
-			goto on_error;
+			result = -1;
 		}
-		export_handle->sha256_context_initialized = 1;
 	}
-	return( 1 );
+	memory_free(
+	 export_handle->readers );
 
-on_error:
-	if( export_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( export_handle->sha1_context ),
-		 NULL );
-	}
-	if( export_handle->md5_context != NULL )
-	{
-		libhmac_md5_free(
-		 &( export_handle->md5_context ),
-		 NULL );
-	}
-	return( -1 );
+	export_handle->readers = NULL;
+
+	return( result );
 }
 
-/* Updates the integrity hash(es)
- * Returns 1 if successful or -1 on error
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads a group of storage media buffers from an input handle
+ * In chunk data mode every storage media buffer in the group is filled with a single input chunk
+ * Returns the number of bytes read or -1 on error
  */
-int export_handle_update_integrity_hash(
-     export_handle_t *export_handle,
-     const uint8_t *buffer,
-     size_t buffer_size,
-     libcerror_error_t **error )
+ssize_t export_handle_read_storage_media_buffers(
+         export_handle_t *export_handle,
+         libewf_handle_t *input_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_update_integrity_hash";
+	static char *function    = "export_handle_read_storage_media_buffers";
+	size_t buffer_read_size  = 0;
+	ssize_t read_count       = 0;
+	ssize_t total_read_count = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1432,98 +1570,114 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( read_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	while( ( storage_media_buffer != NULL )
+	    && ( read_size > 0 ) )
 	{
-		if( libhmac_md5_update(
-		     export_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
+		buffer_read_size = read_size;
+
+		if( ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		 && ( buffer_read_size > (size_t) export_handle->input_chunk_size ) )
+		{
+			buffer_read_size = (size_t) export_handle->input_chunk_size;
+		}
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              input_handle,
+		              buffer_read_size,
+		              error );
+
+		if( read_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
 			 function );
 
 			return( -1 );
 		}
-	}
-	if( export_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     export_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
+		if( read_count == 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
 			 function );
 
 			return( -1 );
 		}
-	}
-	if( export_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_update(
-		     export_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
+		/* The stored chunk data is also used to detect empty chunks for sparse output
+		 */
+		if( ( export_handle->use_chunk_pass_through != 0 )
+		 || ( ( export_handle->sparse_output != 0 )
+		  && ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
-			 function );
+			/* The stored chunk data needs to be retrieved before it is unpacked
+			 */
+			if( storage_media_buffer_read_stored_data(
+			     storage_media_buffer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read stored chunk data.",
+				 function );
 
-			return( -1 );
+				return( -1 );
+			}
+		}
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+
+		storage_media_offset += read_count;
+		total_read_count     += read_count;
+
+		if( (size_t) read_count >= read_size )
+		{
+			break;
 		}
+		read_size -= (size_t) read_count;
+
+		storage_media_buffer = storage_media_buffer->next_buffer;
 	}
-	return( 1 );
+	return( total_read_count );
 }
 
-/* Finalizes the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Prepares a storage media buffer before writing the output of the export handle
+ * Returns the resulting buffer size or -1 on error
  */
-int export_handle_finalize_integrity_hash(
-     export_handle_t *export_handle,
-     libcerror_error_t **error )
+ssize_t export_handle_prepare_write_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
-	static char *function = "export_handle_finalize_integrity_hash";
+	static char *function = "export_handle_prepare_write_storage_media_buffer";
+	ssize_t process_count = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1536,120 +1690,53 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_finalize(
-		     export_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     export_handle->calculated_md5_hash_string,
-		     33,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( export_handle->calculate_sha1 != 0 )
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		if( libhmac_sha1_finalize(
-		     export_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
+		process_count = storage_media_buffer_write_process(
+		                 storage_media_buffer,
+		                 error );
 
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     export_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
+		if( process_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to prepare storage media buffer before writing.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
 	{
-		if( libhmac_sha256_finalize(
-		     export_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
-
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     export_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
+		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer.",
 			 function );
 
 			return( -1 );
 		}
+		process_count = (ssize_t) storage_media_buffer->raw_buffer_data_size;
 	}
-	return( 1 );
+	return( process_count );
 }
 
-/* Determines if the input is corrupted
- * Returns 1 if corrupted, 0 if not or -1 on error
+/* Writes a storage media buffer to the output of the export handle
+ * Returns the number of bytes written or -1 on error
  */
-int export_handle_input_is_corrupted(
-     export_handle_t *export_handle,
-     libcerror_error_t **error )
+ssize_t export_handle_write_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_input_is_corrupted";
-	int result            = 0;
+	static char *function = "export_handle_write_storage_media_buffer";
+	ssize_t write_count   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1662,33 +1749,82 @@ int export_handle_input_is_corrupted(
 
 		return( -1 );
 	}
-	result = libewf_handle_segment_files_corrupted(
-	          export_handle->input_handle,
-	          error );
+	if( write_size == 0 )
+	{
+		return( 0 );
+	}
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		write_count = storage_media_buffer_write_to_handle(
+			       storage_media_buffer,
+			       export_handle->ewf_output_handle,
+			       write_size,
+			       error );
+	}
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	{
+		if( storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid storage media buffer.",
+			 function );
 
-	if( result == -1 )
+			return( -1 );
+		}
+		if( export_handle->use_stdout != 0 )
+		{
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+			write_count = _write(
+			               1,
+				       storage_media_buffer->raw_buffer,
+				       (unsigned int) write_size );
+#else
+			write_count = write(
+			               1,
+				       storage_media_buffer->raw_buffer,
+				       write_size );
+#endif
+		}
+		else
+		{
+			write_count = libsmraw_handle_write_buffer(
+				       export_handle->raw_output_handle,
+				       storage_media_buffer->raw_buffer,
+				       write_size,
+				       error );
+		}
+	}
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if segment files are corrupted.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to write storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
+	return( write_count );
 }
 
-/* Retrieves the chunk size
- * Returns 1 if successful or -1 on error
+/* Skips a range of zero bytes in the raw output by seeking over it, which leaves a hole in the output file
+ * A range that contains the first or last byte of a segment file is written instead,
+ * so that every segment file is created with its full size
+ * Returns the number of bytes skipped, 0 if the range needs to be written or -1 on error
  */
-int export_handle_get_output_chunk_size(
-     export_handle_t *export_handle,
-     size32_t *chunk_size,
-     libcerror_error_t **error )
+ssize_t export_handle_skip_sparse_range(
+         export_handle_t *export_handle,
+         off64_t offset,
+         size_t size,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_get_output_chunk_size";
+	static char *function = "export_handle_skip_sparse_range";
+	size64_t segment_size = 0;
+	off64_t end_offset    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -1701,64 +1837,81 @@ int export_handle_get_output_chunk_size(
 
 		return( -1 );
 	}
-	if( chunk_size == NULL )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk size.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( size > (size_t) SSIZE_MAX )
 	{
-		if( export_handle->ewf_output_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing ewf output handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
 
-			return( -1 );
-		}
-		if( libewf_handle_get_chunk_size(
-		     export_handle->ewf_output_handle,
-		     chunk_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk size.",
-			 function );
+		return( -1 );
+	}
+	if( ( export_handle->sparse_output == 0 )
+	 || ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 || ( export_handle->use_stdout != 0 )
+	 || ( size == 0 ) )
+	{
+		return( 0 );
+	}
+	segment_size = export_handle->maximum_segment_size;
 
-			return( -1 );
-		}
+	if( ( segment_size == 0 )
+	 || ( segment_size > export_handle->export_size ) )
+	{
+		segment_size = export_handle->export_size;
 	}
-	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	end_offset = offset + (off64_t) size;
+
+	if( ( segment_size == 0 )
+	 || ( (size64_t) end_offset >= export_handle->export_size ) )
 	{
-		*chunk_size = export_handle->input_chunk_size;
+		return( 0 );
 	}
-	return( 1 );
+	if( ( ( (size64_t) offset % segment_size ) == 0 )
+	 || ( ( (size64_t) offset / segment_size ) != ( (size64_t) end_offset / segment_size ) ) )
+	{
+		return( 0 );
+	}
+	if( libsmraw_handle_seek_offset(
+	     export_handle->raw_output_handle,
+	     (off64_t) size,
+	     SEEK_CUR,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek over range of zero bytes in raw output.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) size );
 }
 
-/* Prompts the user for a string
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Seeks the offset
+ * Returns the resulting offset or -1 on error
  */
-int export_handle_prompt_for_string(
-     export_handle_t *export_handle,
-     const system_character_t *request_string,
-     system_character_t **internal_string,
-     size_t *internal_string_size,
-     libcerror_error_t **error )
+off64_t export_handle_seek_offset(
+         export_handle_t *export_handle,
+         off64_t offset,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_prompt_for_string";
-	int result            = 0;
+	static char *function = "export_handle_seek_offset";
 
 	if( export_handle == NULL )
 	{
@@ -1771,111 +1924,103 @@ int export_handle_prompt_for_string(
 
 		return( -1 );
 	}
-	if( internal_string == NULL )
+	if( libewf_handle_seek_offset(
+	     export_handle->input_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_string_size == NULL )
+	return( offset );
+}
+
+/* Swaps the byte order of byte pairs within a buffer of a certain size
+ * Returns 1 if successful, -1 on error
+ */
+int export_handle_swap_byte_pairs(
+     export_handle_t *export_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_swap_byte_pairs";
+	size_t buffer_offset  = 0;
+	uint8_t byte_value    = 0;
+
+	if( export_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string size.",
+		 "%s: invalid export handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( *internal_string != NULL )
-	{
-		memory_free(
-		 *internal_string );
-
-		*internal_string      = NULL;
-		*internal_string_size = 0;
-	}
-	*internal_string_size = EXPORT_HANDLE_STRING_SIZE;
-
-	*internal_string = system_string_allocate(
-	                    *internal_string_size );
-
-	if( *internal_string == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create internal string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     *internal_string,
-	     0,
-	     *internal_string_size ) == NULL )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear internal string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	result = ewfinput_get_string_variable(
-	          export_handle->notify_stream,
-	          request_string,
-	          *internal_string,
-	          *internal_string_size,
-	          error );
-
-	if( result == -1 )
+	/* If the last bit is set the value is odd
+	 */
+	if( ( buffer_size & 0x01 ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve string variable.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid buffer size value is odd.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( result );
-
-on_error:
-	if( *internal_string != NULL )
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset += 2 )
 	{
-		memory_free(
-		 *internal_string );
-
-		*internal_string = NULL;
+		byte_value                  = buffer[ buffer_offset ];
+		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
+		buffer[ buffer_offset + 1 ] = byte_value;
 	}
-	*internal_string_size = 0;
-
-	return( -1 );
+	return( 1 );
 }
 
-/* Prompts the user for the compression method
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_prompt_for_compression_method(
+int export_handle_initialize_integrity_hash(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "export_handle_prompt_for_compression_method";
-	uint8_t compression_methods_amount        = 0;
-	int result                                = 0;
+	static char *function = "export_handle_initialize_integrity_hash";
 
 	if( export_handle == NULL )
 	{
@@ -1888,69 +2033,85 @@ int export_handle_prompt_for_compression_method(
 
 		return( -1 );
 	}
-	if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
-	{
-		compression_methods_amount = 1;
-	}
-	else
+	if( export_handle->calculate_md5 != 0 )
 	{
-		compression_methods_amount = EWFINPUT_COMPRESSION_METHODS_AMOUNT;
-	}
-	result = ewfinput_get_fixed_string_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_compression_methods,
-	          compression_methods_amount,
-	          EWFINPUT_COMPRESSION_METHODS_DEFAULT,
-	          &fixed_string_variable,
-	          error );
+		if( libhmac_md5_initialize(
+		     &( export_handle->md5_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 context.",
+			 function );
 
-	if( result == -1 )
+			goto on_error;
+		}
+		export_handle->md5_context_initialized = 1;
+	}
+	if( export_handle->calculate_sha1 != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
-		 function );
+		if( libhmac_sha1_initialize(
+		     &( export_handle->sha1_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 context.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		export_handle->sha1_context_initialized = 1;
 	}
-	else if( result != 0 )
+	if( export_handle->calculate_sha256 != 0 )
 	{
-		result = ewfinput_determine_compression_method(
-			  fixed_string_variable,
-			  &( export_handle->compression_method ),
-			  error );
-
-		if( result == -1 )
+		if( libhmac_sha256_initialize(
+		     &( export_handle->sha256_context ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine compression method.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 context.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
+		export_handle->sha256_context_initialized = 1;
 	}
-	return( result );
-}
+	return( 1 );
 
-/* Prompts the user for the compression level
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+on_error:
+	if( export_handle->sha1_context != NULL )
+	{
+		libhmac_sha1_free(
+		 &( export_handle->sha1_context ),
+		 NULL );
+	}
+	if( export_handle->md5_context != NULL )
+	{
+		libhmac_md5_free(
+		 &( export_handle->md5_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_prompt_for_compression_level(
+int export_handle_update_integrity_hash(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
+     const uint8_t *buffer,
+     size_t buffer_size,
      libcerror_error_t **error )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "export_handle_prompt_for_compression_level";
-	int result                                = 0;
+	static char *function = "export_handle_update_integrity_hash";
 
 	if( export_handle == NULL )
 	{
@@ -1963,82 +2124,98 @@ int export_handle_prompt_for_compression_level(
 
 		return( -1 );
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_compression_levels,
-	          EWFINPUT_COMPRESSION_LEVELS_AMOUNT,
-	          EWFINPUT_COMPRESSION_LEVELS_DEFAULT,
-	          &fixed_string_variable,
-	          error );
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-	if( result == -1 )
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	if( export_handle->calculate_md5 != 0 )
 	{
-		result = ewfinput_determine_compression_values(
-			  fixed_string_variable,
-			  &( export_handle->compression_level ),
-			  &( export_handle->compression_flags ),
-			  error );
+		if( libhmac_md5_update(
+		     export_handle->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
+			 function );
 
-		if( result == -1 )
+			return( -1 );
+		}
+	}
+	if( export_handle->calculate_sha1 != 0 )
+	{
+		if( libhmac_sha1_update(
+		     export_handle->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine compression values.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	return( result );
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_update(
+		     export_handle->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
 }
 
-/* Prompts the user for the output format
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Finalizes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_prompt_for_output_format(
+int export_handle_finalize_integrity_hash(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *format_types[ 17 ] = {
-		_SYSTEM_STRING( "raw" ),
-		_SYSTEM_STRING( "files" ),
-		_SYSTEM_STRING( "ewf" ),
-		_SYSTEM_STRING( "smart" ),
-		_SYSTEM_STRING( "ftk" ),
-		_SYSTEM_STRING( "encase1" ),
-		_SYSTEM_STRING( "encase2" ),
-		_SYSTEM_STRING( "encase3" ),
-		_SYSTEM_STRING( "encase4" ),
-		_SYSTEM_STRING( "encase5" ),
-		_SYSTEM_STRING( "encase6" ),
-		_SYSTEM_STRING( "encase7" ),
-		_SYSTEM_STRING( "encase7-v2" ),
-		_SYSTEM_STRING( "linen5" ),
-		_SYSTEM_STRING( "linen6" ),
-		_SYSTEM_STRING( "linen7" ),
-		_SYSTEM_STRING( "ewfx" ) };
+	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
 
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "export_handle_prompt_for_output_format";
-	size_t fixed_string_variable_length       = 0;
-	int result                                = 0;
+	static char *function = "export_handle_finalize_integrity_hash";
 
 	if( export_handle == NULL )
 	{
@@ -2051,92 +2228,121 @@ int export_handle_prompt_for_output_format(
 
 		return( -1 );
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          format_types,
-	          17,
-	          0,
-	          &fixed_string_variable,
-	          error );
-
-	if( result == -1 )
+	if( export_handle->calculate_md5 != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
-		 function );
+		if( libhmac_md5_finalize(
+		     export_handle->md5_context,
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     LIBHMAC_MD5_HASH_SIZE,
+		     export_handle->calculated_md5_hash_string,
+		     33,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	else if( result != 0 )
+	if( export_handle->calculate_sha1 != 0 )
 	{
-		result = 0;
-
-		fixed_string_variable_length = system_string_length(
-		                                fixed_string_variable );
-
-		if( fixed_string_variable_length == 3 )
+		if( libhmac_sha1_finalize(
+		     export_handle->sha1_context,
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     error ) != 1 )
 		{
-			if( system_string_compare(
-			     fixed_string_variable,
-			     _SYSTEM_STRING( "raw" ),
-			     3 ) == 0 )
-			{
-				export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
-				result                       = 1;
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
+			 function );
+
+			return( -1 );
 		}
-		else if( fixed_string_variable_length == 5 )
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     LIBHMAC_SHA1_HASH_SIZE,
+		     export_handle->calculated_sha1_hash_string,
+		     41,
+		     error ) != 1 )
 		{
-			if( system_string_compare(
-			     fixed_string_variable,
-			     _SYSTEM_STRING( "files" ),
-			     5 ) == 0 )
-			{
-				export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_FILES;
-				result                       = 1;
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA1 hash string.",
+			 function );
+
+			return( -1 );
 		}
-		if( result == 0 )
+	}
+	if( export_handle->calculate_sha256 != 0 )
+	{
+		if( libhmac_sha256_finalize(
+		     export_handle->sha256_context,
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
 		{
-			result = ewfinput_determine_ewf_format(
-				  fixed_string_variable,
-				  &( export_handle->ewf_format ),
-				  error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
+			 function );
 
-			if( result != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine format.",
-				 function );
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     export_handle->calculated_sha256_hash_string,
+		     65,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
+			 function );
 
-				return( -1 );
-			}
-			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_EWF;
+			return( -1 );
 		}
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Prompts the user for the number of sectors per chunk
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Retrieves the integrity hash(es) stored in the input
+ * The stored hashes only apply if the entire input is exported without byte swapping
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_prompt_for_sectors_per_chunk(
+int export_handle_get_integrity_hash_from_input(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "export_handle_prompt_for_sectors_per_chunk";
-	int result                                = 0;
+	static char *function = "export_handle_get_integrity_hash_from_input";
+	int result            = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2149,15 +2355,22 @@ int export_handle_prompt_for_sectors_per_chunk(
 
 		return( -1 );
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_sector_per_block_sizes,
-	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_AMOUNT,
-	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_DEFAULT,
-	          &fixed_string_variable,
+	export_handle->stored_md5_hash_available    = 0;
+	export_handle->stored_sha1_hash_available   = 0;
+	export_handle->stored_sha256_hash_available = 0;
+
+	if( ( export_handle->export_offset != 0 )
+	 || ( export_handle->export_size != (uint64_t) export_handle->input_media_size )
+	 || ( export_handle->swap_byte_pairs != 0 ) )
+	{
+		return( 1 );
+	}
+	result = libewf_handle_get_utf8_hash_value(
+	          export_handle->input_handle,
+	          (uint8_t *) "MD5",
+	          3,
+	          (uint8_t *) export_handle->stored_md5_hash_string,
+	          33,
 	          error );
 
 	if( result == -1 )
@@ -2166,47 +2379,110 @@ int export_handle_prompt_for_sectors_per_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
+		 "%s: unable to determine stored MD5 hash string.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	export_handle->stored_md5_hash_available = (uint8_t) result;
+
+	result = libewf_handle_get_utf8_hash_value(
+	          export_handle->input_handle,
+	          (uint8_t *) "SHA1",
+	          4,
+	          (uint8_t *) export_handle->stored_sha1_hash_string,
+	          41,
+	          error );
+
+	if( result == -1 )
 	{
-		result = ewfinput_determine_sectors_per_chunk(
-			  fixed_string_variable,
-			  &( export_handle->output_sectors_per_chunk ),
-			  error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored SHA1 hash string.",
+		 function );
 
-		if( result == -1 )
+		return( -1 );
+	}
+	export_handle->stored_sha1_hash_available = (uint8_t) result;
+
+	result = libewf_handle_get_utf8_hash_value(
+	          export_handle->input_handle,
+	          (uint8_t *) "SHA256",
+	          6,
+	          (uint8_t *) export_handle->stored_sha256_hash_string,
+	          65,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine stored SHA256 hash string.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->stored_sha256_hash_available = (uint8_t) result;
+
+	/* Make sure the hashes stored in the input are carried over to an EWF output
+	 */
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( ( export_handle->stored_sha1_hash_available != 0 )
+		 && ( export_handle->calculate_sha1 == 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine sectors per chunk.",
-			 function );
+			export_handle->calculated_sha1_hash_string = narrow_string_allocate(
+			                                              41 );
 
-			return( -1 );
+			if( export_handle->calculated_sha1_hash_string == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create calculated SHA1 digest hash string.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->calculate_sha1 = 1;
+		}
+		if( ( export_handle->stored_sha256_hash_available != 0 )
+		 && ( export_handle->calculate_sha256 == 0 ) )
+		{
+			export_handle->calculated_sha256_hash_string = narrow_string_allocate(
+			                                                65 );
+
+			if( export_handle->calculated_sha256_hash_string == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create calculated SHA256 digest hash string.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->calculate_sha256 = 1;
 		}
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Prompts the user for the maximum segment size
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Verifies the calculated integrity hash(es) against the integrity hash(es) stored in the input
+ * Returns 1 if the hashes match or no hashes are stored, 0 if not or -1 on error
  */
-int export_handle_prompt_for_maximum_segment_size(
+int export_handle_verify_integrity_hash(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function        = "export_handle_prompt_for_maximum_segment_size";
-	uint64_t default_input_size  = 0;
-	uint64_t input_size_variable = 0;
-	uint64_t maximum_input_size  = 0;
-	uint64_t minimum_input_size  = 0;
-	int result                   = 0;
+	static char *function = "export_handle_verify_integrity_hash";
+	int result            = 1;
 
 	if( export_handle == NULL )
 	{
@@ -2219,59 +2495,84 @@ int export_handle_prompt_for_maximum_segment_size(
 
 		return( -1 );
 	}
-	maximum_input_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT;
-
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( ( export_handle->calculate_md5 != 0 )
+	 && ( export_handle->stored_md5_hash_available != 0 ) )
 	{
-		if( export_handle->ewf_format != LIBEWF_FORMAT_ENCASE6 )
+		if( export_handle->calculated_md5_hash_string == NULL )
 		{
-			maximum_input_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT;
-		}
-		minimum_input_size = EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated MD5 hash string.",
+			 function );
 
-	       	if( default_input_size == 0 )
-       		{
-			default_input_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
-       		}
+			return( -1 );
+		}
+		if( narrow_string_compare(
+		     export_handle->stored_md5_hash_string,
+		     export_handle->calculated_md5_hash_string,
+		     33 ) != 0 )
+		{
+			result = 0;
+		}
 	}
-	result = ewfinput_get_byte_size_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          minimum_input_size,
-	          maximum_input_size,
-	          default_input_size,
-	          &input_size_variable,
-	          error );
-
-	if( result == -1 )
+	if( ( export_handle->calculate_sha1 != 0 )
+	 && ( export_handle->stored_sha1_hash_available != 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve byte size variable.",
-		 function );
+		if( export_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated SHA1 hash string.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		if( narrow_string_compare(
+		     export_handle->stored_sha1_hash_string,
+		     export_handle->calculated_sha1_hash_string,
+		     41 ) != 0 )
+		{
+			result = 0;
+		}
 	}
-	export_handle->maximum_segment_size = input_size_variable;
+	if( ( export_handle->calculate_sha256 != 0 )
+	 && ( export_handle->stored_sha256_hash_available != 0 ) )
+	{
+		if( export_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing calculated SHA256 hash string.",
+			 function );
 
+			return( -1 );
+		}
+		if( narrow_string_compare(
+		     export_handle->stored_sha256_hash_string,
+		     export_handle->calculated_sha256_hash_string,
+		     65 ) != 0 )
+		{
+			result = 0;
+		}
+	}
 	return( result );
 }
 
-/* Prompts the user for the export offset
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Determines if the input is corrupted
+ * Returns 1 if corrupted, 0 if not or -1 on error
  */
-int export_handle_prompt_for_export_offset(
+int export_handle_input_is_corrupted(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function        = "export_handle_prompt_for_export_offset";
-	uint64_t input_size_variable = 0;
-	int result                   = 0;
+	static char *function = "export_handle_input_is_corrupted";
+	int result            = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2284,15 +2585,8 @@ int export_handle_prompt_for_export_offset(
 
 		return( -1 );
 	}
-	result = ewfinput_get_size_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          0,
-	          export_handle->input_media_size,
-	          export_handle->export_offset,
-	          &input_size_variable,
+	result = libewf_handle_segment_files_corrupted(
+	          export_handle->input_handle,
 	          error );
 
 	if( result == -1 )
@@ -2301,29 +2595,23 @@ int export_handle_prompt_for_export_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 "%s: unable to determine if segment files are corrupted.",
 		 function );
 
 		return( -1 );
 	}
-	export_handle->export_offset = input_size_variable;
-
 	return( result );
 }
 
-/* Prompts the user for the export size
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Retrieves the chunk size
+ * Returns 1 if successful or -1 on error
  */
-int export_handle_prompt_for_export_size(
+int export_handle_get_output_chunk_size(
      export_handle_t *export_handle,
-     const system_character_t *request_string,
+     size32_t *chunk_size,
      libcerror_error_t **error )
 {
-	static char *function        = "export_handle_prompt_for_export_size";
-	uint64_t default_input_size  = 0;
-	uint64_t input_size_variable = 0;
-	uint64_t maximum_input_size  = 0;
-	int result                   = 0;
+	static char *function = "export_handle_get_output_chunk_size";
 
 	if( export_handle == NULL )
 	{
@@ -2336,57 +2624,132 @@ int export_handle_prompt_for_export_size(
 
 		return( -1 );
 	}
-	maximum_input_size = export_handle->input_media_size
-	                   - export_handle->export_offset;
-
-	if( ( export_handle->export_size == 0 )
-	 || ( export_handle->export_size > maximum_input_size ) )
+	if( chunk_size == NULL )
 	{
-		default_input_size = maximum_input_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk size.",
+		 function );
+
+		return( -1 );
 	}
-	else
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		default_input_size = export_handle->export_size;
+		if( export_handle->ewf_output_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing ewf output handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_get_chunk_size(
+		     export_handle->ewf_output_handle,
+		     chunk_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk size.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	result = ewfinput_get_size_variable(
-	          export_handle->notify_stream,
-	          export_handle->input_buffer,
-	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          0,
-	          maximum_input_size,
-	          default_input_size,
-	          &input_size_variable,
-	          error );
+	else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	{
+		*chunk_size = export_handle->input_chunk_size;
+	}
+	return( 1 );
+}
 
-	if( result == -1 )
+/* Determines if the stored chunk data can be copied to the output without recompression
+ * This requires an EWF output with the same chunk size and compression method as the input
+ * Returns 1 if the chunk data can be passed through, 0 if not or -1 on error
+ */
+int export_handle_determine_chunk_pass_through(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function       = "export_handle_determine_chunk_pass_through";
+	uint16_t compression_method = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->use_chunk_pass_through = 0;
+
+	if( ( export_handle->use_data_chunk_functions == 0 )
+	 || ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( export_handle->swap_byte_pairs != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( export_handle->input_chunk_size == 0 )
+	 || ( export_handle->input_chunk_size != export_handle->output_chunk_size )
+	 || ( ( export_handle->export_offset % export_handle->input_chunk_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	/* EWF-S01 (SMART) stores chunks differently and the EWF and SMART output formats
+	 * require every chunk to be compressed
+	 */
+	if( ( export_handle->input_format == LIBEWF_FORMAT_SMART )
+	 || ( export_handle->input_format == LIBEWF_FORMAT_FTK_IMAGER )
+	 || ( export_handle->ewf_format == LIBEWF_FORMAT_EWF )
+	 || ( export_handle->ewf_format == LIBEWF_FORMAT_SMART ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &compression_method,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 "%s: unable to retrieve input compression method.",
 		 function );
 
 		return( -1 );
 	}
-	export_handle->export_size = input_size_variable;
+	if( compression_method != export_handle->compression_method )
+	{
+		return( 0 );
+	}
+	export_handle->use_chunk_pass_through = 1;
 
-	return( result );
+	return( 1 );
 }
 
-/* Sets a string
- * Returns 1 if successful or -1 on error
+/* Determines if the chunks can be repacked for the output by the process threads
+ * This requires an EWF output with a chunk size that is a multiple of the input chunk size
+ * or the other way around. The chunks are then repacked in groups of the largest of both
+ * chunk sizes, that consist of a whole number of input chunks and of output chunks
+ * Returns 1 if the chunks can be repacked in parallel, 0 if not or -1 on error
  */
-int export_handle_set_string(
+int export_handle_determine_parallel_repack(
      export_handle_t *export_handle,
-     const system_character_t *string,
-     system_character_t **internal_string,
-     size_t *internal_string_size,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_string";
-	size_t string_length  = 0;
+	static char *function = "export_handle_determine_parallel_repack";
 
 	if( export_handle == NULL )
 	{
@@ -2399,13 +2762,64 @@ int export_handle_set_string(
 
 		return( -1 );
 	}
-	if( string == NULL )
+	export_handle->use_parallel_repack = 0;
+	export_handle->repack_group_size   = 0;
+
+	if( ( export_handle->number_of_threads == 0 )
+	 || ( export_handle->use_data_chunk_functions == 0 )
+	 || ( export_handle->use_chunk_pass_through != 0 )
+	 || ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( export_handle->swap_byte_pairs != 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( export_handle->input_chunk_size == 0 )
+	 || ( export_handle->output_chunk_size == 0 )
+	 || ( ( export_handle->export_offset % export_handle->input_chunk_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	if( export_handle->output_chunk_size >= export_handle->input_chunk_size )
+	{
+		if( ( export_handle->output_chunk_size % export_handle->input_chunk_size ) != 0 )
+		{
+			return( 0 );
+		}
+		export_handle->repack_group_size = (size_t) export_handle->output_chunk_size;
+	}
+	else
+	{
+		if( ( export_handle->input_chunk_size % export_handle->output_chunk_size ) != 0 )
+		{
+			return( 0 );
+		}
+		export_handle->repack_group_size = (size_t) export_handle->input_chunk_size;
+	}
+	export_handle->use_parallel_repack = 1;
+
+	return( 1 );
+}
+
+/* Prompts the user for a string
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int export_handle_prompt_for_string(
+     export_handle_t *export_handle,
+     const system_character_t *request_string,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_prompt_for_string";
+	int result            = 0;
+
+	if( export_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 "%s: invalid export handle.",
 		 function );
 
 		return( -1 );
@@ -2440,44 +2854,55 @@ int export_handle_set_string(
 		*internal_string      = NULL;
 		*internal_string_size = 0;
 	}
-	string_length = system_string_length(
-	                 string );
+	*internal_string_size = EXPORT_HANDLE_STRING_SIZE;
 
-	if( string_length > 0 )
+	*internal_string = system_string_allocate(
+	                    *internal_string_size );
+
+	if( *internal_string == NULL )
 	{
-		*internal_string = system_string_allocate(
-		                    string_length + 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create internal string.",
+		 function );
 
-		if( *internal_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create internal string.",
-			 function );
+		goto on_error;
+	}
+	if( memory_set(
+	     *internal_string,
+	     0,
+	     *internal_string_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear internal string.",
+		 function );
 
-			goto on_error;
-		}
-		if( system_string_copy(
-		     *internal_string,
-		     string,
-		     string_length ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy string.",
-			 function );
+		goto on_error;
+	}
+	result = ewfinput_get_string_variable(
+	          export_handle->notify_stream,
+	          request_string,
+	          *internal_string,
+	          *internal_string_size,
+	          error );
 
-			goto on_error;
-		}
-		( *internal_string )[ string_length ] = 0;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve string variable.",
+		 function );
 
-		*internal_string_size = string_length + 1;
+		goto on_error;
 	}
-	return( 1 );
+	return( result );
 
 on_error:
 	if( *internal_string != NULL )
@@ -2492,27 +2917,18 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the compression values
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Prompts the user for the compression method
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_compression_values(
+int export_handle_prompt_for_compression_method(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *string_segment               = NULL;
-	static char *function                            = "export_handle_set_compression_values";
-	size_t string_length                             = 0;
-	size_t string_segment_size                       = 0;
-	int number_of_segments                           = 0;
-	int result                                       = 0;
-	int segment_index                                = 0;
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	libcsplit_wide_split_string_t *string_elements   = NULL;
-#else
-	libcsplit_narrow_split_string_t *string_elements = NULL;
-#endif
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "export_handle_prompt_for_compression_method";
+	uint8_t compression_methods_amount        = 0;
+	int result                                = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2525,109 +2941,40 @@ int export_handle_set_compression_values(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_string_split(
-	     string,
-	     string_length + 1,
-	     (wchar_t) ':',
-	     &string_elements,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_string_split(
-	     string,
-	     string_length + 1,
-	     (char) ':',
-	     &string_elements,
-	     error ) != 1 )
-#endif
+	if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split string.",
-		 function );
-
-		goto on_error;
+		compression_methods_amount = 1;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_get_number_of_segments(
-	     string_elements,
-	     &number_of_segments,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_get_number_of_segments(
-	     string_elements,
-	     &number_of_segments,
-	     error ) != 1 )
-#endif
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
-		 function );
-
-		return( -1 );
+		compression_methods_amount = EWFINPUT_COMPRESSION_METHODS_AMOUNT;
 	}
-	if( ( number_of_segments != 1 )
-	 && ( number_of_segments != 2 ) )
+	result = ewfinput_get_fixed_string_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_compression_methods,
+	          compression_methods_amount,
+	          EWFINPUT_COMPRESSION_METHODS_DEFAULT,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of segments is out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 2 )
+	else if( result != 0 )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libcsplit_wide_split_string_get_segment_by_index(
-		     string_elements,
-		     segment_index,
-		     &string_segment,
-		     &string_segment_size,
-		     error ) != 1 )
-#else
-		if( libcsplit_narrow_split_string_get_segment_by_index(
-		     string_elements,
-		     segment_index,
-		     &string_segment,
-		     &string_segment_size,
-		     error ) != 1 )
-#endif
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve string segment: %d.",
-			 function,
-			 segment_index );
-
-			goto on_error;
-		}
-		if( string_segment == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing string segment: %d.",
-			 function,
-			 segment_index );
-
-			goto on_error;
-		}
 		result = ewfinput_determine_compression_method(
-			  string_segment,
+			  fixed_string_variable,
 			  &( export_handle->compression_method ),
 			  error );
 
@@ -2640,59 +2987,44 @@ int export_handle_set_compression_values(
 			 "%s: unable to determine compression method.",
 			 function );
 
-			goto on_error;
-		}
-		if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
-		{
-			if( export_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-			{
-				export_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-			}
+			return( -1 );
 		}
-		segment_index++;
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_get_segment_by_index(
-	     string_elements,
-	     segment_index,
-	     &string_segment,
-	     &string_segment_size,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_get_segment_by_index(
-	     string_elements,
-	     segment_index,
-	     &string_segment,
-	     &string_segment_size,
-	     error ) != 1 )
-#endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve string segment: %d.",
-		 function,
-		 segment_index );
+	return( result );
+}
 
-		goto on_error;
-	}
-	if( string_segment == NULL )
+/* Prompts the user for the compression level
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int export_handle_prompt_for_compression_level(
+     export_handle_t *export_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "export_handle_prompt_for_compression_level";
+	int result                                = 0;
+
+	if( export_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing string segment: %d.",
-		 function,
-		 segment_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	result = ewfinput_determine_compression_values(
-	          string_segment,
-	          &( export_handle->compression_level ),
-	          &( export_handle->compression_flags ),
+	result = ewfinput_get_fixed_string_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_compression_levels,
+	          EWFINPUT_COMPRESSION_LEVELS_AMOUNT,
+	          EWFINPUT_COMPRESSION_LEVELS_DEFAULT,
+	          &fixed_string_variable,
 	          error );
 
 	if( result == -1 )
@@ -2701,60 +3033,65 @@ int export_handle_set_compression_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine compression values.",
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#endif
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split string.",
-		 function );
+		result = ewfinput_determine_compression_values(
+			  fixed_string_variable,
+			  &( export_handle->compression_level ),
+			  &( export_handle->compression_flags ),
+			  error );
 
-		goto on_error;
-	}
-	return( result );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
 
-on_error:
-	if( string_elements != NULL )
-	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		libcsplit_wide_split_string_free(
-		 &string_elements,
-		 NULL );
-#else
-		libcsplit_narrow_split_string_free(
-		 &string_elements,
-		 NULL );
-#endif
+			return( -1 );
+		}
 	}
-	return( -1 );
+	return( result );
 }
 
-
-/* Sets the output format
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Prompts the user for the output format
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_output_format(
+int export_handle_prompt_for_output_format(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_output_format";
-	size_t string_length  = 0;
-	int result            = 0;
+	system_character_t *format_types[ 17 ] = {
+		_SYSTEM_STRING( "raw" ),
+		_SYSTEM_STRING( "files" ),
+		_SYSTEM_STRING( "ewf" ),
+		_SYSTEM_STRING( "smart" ),
+		_SYSTEM_STRING( "ftk" ),
+		_SYSTEM_STRING( "encase1" ),
+		_SYSTEM_STRING( "encase2" ),
+		_SYSTEM_STRING( "encase3" ),
+		_SYSTEM_STRING( "encase4" ),
+		_SYSTEM_STRING( "encase5" ),
+		_SYSTEM_STRING( "encase6" ),
+		_SYSTEM_STRING( "encase7" ),
+		_SYSTEM_STRING( "encase7-v2" ),
+		_SYSTEM_STRING( "linen5" ),
+		_SYSTEM_STRING( "linen6" ),
+		_SYSTEM_STRING( "linen7" ),
+		_SYSTEM_STRING( "ewfx" ) };
+
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "export_handle_prompt_for_output_format";
+	size_t fixed_string_variable_length       = 0;
+	int result                                = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2767,67 +3104,92 @@ int export_handle_set_output_format(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-	if( string_length == 3 )
-	{
-		if( system_string_compare(
-		     string,
-		     _SYSTEM_STRING( "raw" ),
-		     3 ) == 0 )
-		{
-			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
-			result                       = 1;
-		}
-	}
-	else if( string_length == 5 )
+	result = ewfinput_get_fixed_string_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          format_types,
+	          17,
+	          0,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
 	{
-		if( system_string_compare(
-		     string,
-		     _SYSTEM_STRING( "files" ),
-		     5 ) == 0 )
-		{
-			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_FILES;
-			result                       = 1;
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
+		 function );
+
+		return( -1 );
 	}
-	if( result == 0 )
+	else if( result != 0 )
 	{
-		result = ewfinput_determine_ewf_format(
-			  string,
-			  &( export_handle->ewf_format ),
-			  error );
+		result = 0;
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine format.",
-			 function );
+		fixed_string_variable_length = system_string_length(
+		                                fixed_string_variable );
 
-			return( -1 );
+		if( fixed_string_variable_length == 3 )
+		{
+			if( system_string_compare(
+			     fixed_string_variable,
+			     _SYSTEM_STRING( "raw" ),
+			     3 ) == 0 )
+			{
+				export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
+				result                       = 1;
+			}
 		}
-		else if( result != 0 )
+		else if( fixed_string_variable_length == 5 )
+		{
+			if( system_string_compare(
+			     fixed_string_variable,
+			     _SYSTEM_STRING( "files" ),
+			     5 ) == 0 )
+			{
+				export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_FILES;
+				result                       = 1;
+			}
+		}
+		if( result == 0 )
 		{
+			result = ewfinput_determine_ewf_format(
+				  fixed_string_variable,
+				  &( export_handle->ewf_format ),
+				  error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine format.",
+				 function );
+
+				return( -1 );
+			}
 			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_EWF;
 		}
 	}
 	return( result );
 }
 
-/* Sets the number of sectors per chunk
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Prompts the user for the number of sectors per chunk
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_sectors_per_chunk(
+int export_handle_prompt_for_sectors_per_chunk(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_sectors_per_chunk";
-	int result            = 0;
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "export_handle_prompt_for_sectors_per_chunk";
+	int result                                = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2840,9 +3202,15 @@ int export_handle_set_sectors_per_chunk(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_sectors_per_chunk(
-	          string,
-	          &( export_handle->output_sectors_per_chunk ),
+	result = ewfinput_get_fixed_string_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_sector_per_block_sizes,
+	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_AMOUNT,
+	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_DEFAULT,
+	          &fixed_string_variable,
 	          error );
 
 	if( result == -1 )
@@ -2851,25 +3219,47 @@ int export_handle_set_sectors_per_chunk(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sectors per chunk.",
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
 		return( -1 );
 	}
+	else if( result != 0 )
+	{
+		result = ewfinput_determine_sectors_per_chunk(
+			  fixed_string_variable,
+			  &( export_handle->output_sectors_per_chunk ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sectors per chunk.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( result );
 }
 
-/* Sets the maximum segment file size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Prompts the user for the maximum segment size
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_maximum_segment_size(
+int export_handle_prompt_for_maximum_segment_size(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_maximum_segment_size";
-	size_t string_length  = 0;
-	int result            = 0;
+	static char *function        = "export_handle_prompt_for_maximum_segment_size";
+	uint64_t default_input_size  = 0;
+	uint64_t input_size_variable = 0;
+	uint64_t maximum_input_size  = 0;
+	uint64_t minimum_input_size  = 0;
+	int result                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2882,13 +3272,30 @@ int export_handle_set_maximum_segment_size(
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
+	maximum_input_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT;
 
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &( export_handle->maximum_segment_size ),
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( export_handle->ewf_format != LIBEWF_FORMAT_ENCASE6 )
+		{
+			maximum_input_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT;
+		}
+		minimum_input_size = EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE;
+
+	       	if( default_input_size == 0 )
+       		{
+			default_input_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+       		}
+	}
+	result = ewfinput_get_byte_size_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          minimum_input_size,
+	          maximum_input_size,
+	          default_input_size,
+	          &input_size_variable,
 	          error );
 
 	if( result == -1 )
@@ -2897,51 +3304,27 @@ int export_handle_set_maximum_segment_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine maximum segment size.",
+		 "%s: unable to retrieve byte size variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( result != 0 )
-	{
-		if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
-		{
-			if( ( export_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
-			 || ( ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
-			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT ) )
-			 || ( ( export_handle->ewf_format != LIBEWF_FORMAT_ENCASE6 )
-			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT ) ) )
-			{
-				export_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
-
-				result = 0;
-			}
-		}
-		else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
-		{
-			if( ( ( export_handle->maximum_segment_size != 0 )
-			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT ) ) )
-			{
-				export_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+	export_handle->maximum_segment_size = input_size_variable;
 
-				result = 0;
-			}
-		}
-	}
 	return( result );
 }
 
-/* Sets the export offset
- * Returns 1 if successful or -1 on error
+/* Prompts the user for the export offset
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_export_offset(
+int export_handle_prompt_for_export_offset(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_export_offset";
-	size_t string_length  = 0;
-	int result            = 0;
+	static char *function        = "export_handle_prompt_for_export_offset";
+	uint64_t input_size_variable = 0;
+	int result                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -2954,53 +3337,46 @@ int export_handle_set_export_offset(
 
 		return( -1 );
 	}
-	if( string == NULL )
+	result = ewfinput_get_size_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          0,
+	          export_handle->input_media_size,
+	          export_handle->export_offset,
+	          &input_size_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( string[ 0 ] != (system_character_t) '-' )
-	{
-		string_length = system_string_length(
-				 string );
+	export_handle->export_offset = input_size_variable;
 
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &( export_handle->export_offset ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine export offset.",
-			 function );
-
-			return( -1 );
-		}
-		result = 1;
-	}
 	return( result );
 }
 
-/* Sets the export size
- * Returns 1 if successful or -1 on error
+/* Prompts the user for the export size
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int export_handle_set_export_size(
+int export_handle_prompt_for_export_size(
      export_handle_t *export_handle,
-     const system_character_t *string,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_export_size";
-	size_t string_length  = 0;
-	int result            = 0;
+	static char *function        = "export_handle_prompt_for_export_size";
+	uint64_t default_input_size  = 0;
+	uint64_t input_size_variable = 0;
+	uint64_t maximum_input_size  = 0;
+	int result                   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -3013,52 +3389,57 @@ int export_handle_set_export_size(
 
 		return( -1 );
 	}
-	if( string == NULL )
+	maximum_input_size = export_handle->input_media_size
+	                   - export_handle->export_offset;
+
+	if( ( export_handle->export_size == 0 )
+	 || ( export_handle->export_size > maximum_input_size ) )
+	{
+		default_input_size = maximum_input_size;
+	}
+	else
+	{
+		default_input_size = export_handle->export_size;
+	}
+	result = ewfinput_get_size_variable(
+	          export_handle->notify_stream,
+	          export_handle->input_buffer,
+	          EXPORT_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          0,
+	          maximum_input_size,
+	          default_input_size,
+	          &input_size_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( string[ 0 ] != (system_character_t) '-' )
-	{
-		string_length = system_string_length(
-				 string );
-
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &( export_handle->export_size ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine export size.",
-			 function );
+	export_handle->export_size = input_size_variable;
 
-			return( -1 );
-		}
-		result = 1;
-	}
 	return( result );
 }
 
-/* Sets the header codepage
+/* Sets a string
  * Returns 1 if successful or -1 on error
  */
-int export_handle_set_header_codepage(
+int export_handle_set_string(
      export_handle_t *export_handle,
      const system_character_t *string,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
      libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_header_codepage";
-	int result            = 0;
+	static char *function = "export_handle_set_string";
+	size_t string_length  = 0;
 
 	if( export_handle == NULL )
 	{
@@ -3071,157 +3452,111 @@ int export_handle_set_header_codepage(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_header_codepage(
-	          string,
-	          &export_handle->header_codepage,
-	          error );
-
-	if( result == -1 )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine header codepage.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-	return( result );
-}
-
-/* Sets the process buffer size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
- */
-int export_handle_set_process_buffer_size(
-     export_handle_t *export_handle,
-     const system_character_t *string,
-     libcerror_error_t **error )
-{
-	static char *function  = "export_handle_set_process_buffer_size";
-	size_t string_length   = 0;
-	uint64_t size_variable = 0;
-	int result             = 0;
-
-	if( export_handle == NULL )
+	if( internal_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-	string_length = system_string_length(
-	                 string );
-
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &size_variable,
-	          error );
-
-	if( result == -1 )
+	if( internal_string_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine process buffer size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
+	if( *internal_string != NULL )
 	{
-		if( size_variable > (uint64_t) SSIZE_MAX )
-		{
-			export_handle->process_buffer_size = 0;
+		memory_free(
+		 *internal_string );
 
-			result = 0;
-		}
-		else
-		{
-			export_handle->process_buffer_size = (size_t) size_variable;
-		}
+		*internal_string      = NULL;
+		*internal_string_size = 0;
 	}
-	return( result );
-}
-
-/* Sets the number of threads
- * Returns 1 if successful, 0 if unsupported value or -1 on error
- */
-int export_handle_set_number_of_threads(
-     export_handle_t *export_handle,
-     const system_character_t *string,
-     libcerror_error_t **error )
-{
-	static char *function      = "export_handle_set_number_of_threads";
-	size_t string_length       = 0;
-	uint64_t number_of_threads = 0;
-	int result                 = 0;
+	string_length = system_string_length(
+	                 string );
 
-	if( export_handle == NULL )
+	if( string_length > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
+		*internal_string = system_string_allocate(
+		                    string_length + 1 );
 
-		return( -1 );
-	}
-	if( string[ 0 ] != (system_character_t) '-' )
-	{
-		string_length = system_string_length(
-				 string );
+		if( *internal_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create internal string.",
+			 function );
 
-		if( ewftools_system_string_decimal_copy_to_64_bit(
+			goto on_error;
+		}
+		if( system_string_copy(
+		     *internal_string,
 		     string,
-		     string_length + 1,
-		     &number_of_threads,
-		     error ) != 1 )
+		     string_length ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine number of threads.",
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy string.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		result = 1;
+		( *internal_string )[ string_length ] = 0;
 
-		if( number_of_threads > 32 )
-		{
-			result = 0;
-		}
-		else
-		{
-			export_handle->number_of_threads = (int) number_of_threads;
-		}
+		*internal_string_size = string_length + 1;
 	}
-	return( result );
+	return( 1 );
+
+on_error:
+	if( *internal_string != NULL )
+	{
+		memory_free(
+		 *internal_string );
+
+		*internal_string = NULL;
+	}
+	*internal_string_size = 0;
+
+	return( -1 );
 }
 
-/* Sets the additional digest types
- * Returns 1 if successful or -1 on error
+/* Sets the compression values
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int export_handle_set_additional_digest_types(
+int export_handle_set_compression_values(
      export_handle_t *export_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
 	system_character_t *string_segment               = NULL;
-	static char *function                            = "export_handle_set_additional_digest_types";
+	static char *function                            = "export_handle_set_compression_values";
 	size_t string_length                             = 0;
 	size_t string_segment_size                       = 0;
-	uint8_t calculate_sha1                           = 0;
-	uint8_t calculate_sha256                         = 0;
 	int number_of_segments                           = 0;
 	int result                                       = 0;
 	int segment_index                                = 0;
@@ -3250,14 +3585,14 @@ int export_handle_set_additional_digest_types(
 	if( libcsplit_wide_string_split(
 	     string,
 	     string_length + 1,
-	     (wchar_t) ',',
+	     (wchar_t) ':',
 	     &string_elements,
 	     error ) != 1 )
 #else
 	if( libcsplit_narrow_string_split(
 	     string,
 	     string_length + 1,
-	     (char) ',',
+	     (char) ':',
 	     &string_elements,
 	     error ) != 1 )
 #endif
@@ -3290,11 +3625,21 @@ int export_handle_set_additional_digest_types(
 		 "%s: unable to retrieve number of segments.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( segment_index = 0;
-	     segment_index < number_of_segments;
-	     segment_index++ )
+	if( ( number_of_segments != 1 )
+	 && ( number_of_segments != 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of segments is out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 2 )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		if( libcsplit_wide_split_string_get_segment_by_index(
@@ -3334,140 +3679,85 @@ int export_handle_set_additional_digest_types(
 
 			goto on_error;
 		}
-		if( string_segment_size == 5 )
-		{
-			if( system_string_compare(
-			     string_segment,
-			     _SYSTEM_STRING( "sha1" ),
-			     4 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA1" ),
-			          4 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-		}
-		else if( string_segment_size == 6 )
-		{
-			if( system_string_compare(
-			     string_segment,
-			     _SYSTEM_STRING( "sha-1" ),
-			     5 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "sha_1" ),
-			          5 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA-1" ),
-			          5 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA_1" ),
-			          5 ) == 0 )
-			{
-				calculate_sha1 = 1;
-			}
-		}
-		else if( string_segment_size == 7 )
+		result = ewfinput_determine_compression_method(
+			  string_segment,
+			  &( export_handle->compression_method ),
+			  error );
+
+		if( result == -1 )
 		{
-			if( system_string_compare(
-			     string_segment,
-			     _SYSTEM_STRING( "sha256" ),
-			     6 ) == 0 )
-			{
-				calculate_sha256 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA256" ),
-			          6 ) == 0 )
-			{
-				calculate_sha256 = 1;
-			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression method.",
+			 function );
+
+			goto on_error;
 		}
-		else if( string_segment_size == 8 )
+		if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
 		{
-			if( system_string_compare(
-			     string_segment,
-			     _SYSTEM_STRING( "sha-256" ),
-			     7 ) == 0 )
-			{
-				calculate_sha256 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "sha_256" ),
-			          7 ) == 0 )
-			{
-				calculate_sha256 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA-256" ),
-			          7 ) == 0 )
-			{
-				calculate_sha256 = 1;
-			}
-			else if( system_string_compare(
-			          string_segment,
-			          _SYSTEM_STRING( "SHA_256" ),
-			          7 ) == 0 )
+			if( export_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
 			{
-				calculate_sha256 = 1;
+				export_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
 			}
 		}
+		segment_index++;
 	}
-	if( ( calculate_sha1 != 0 )
-	 && ( export_handle->calculate_sha1 == 0 ) )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#endif
 	{
-		export_handle->calculated_sha1_hash_string = narrow_string_allocate(
-		                                              41 );
-
-		if( export_handle->calculated_sha1_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create calculated SHA1 digest hash string.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve string segment: %d.",
+		 function,
+		 segment_index );
 
-			goto on_error;
-		}
-		export_handle->calculate_sha1 = 1;
+		goto on_error;
 	}
-	if( ( calculate_sha256 != 0 )
-	 && ( export_handle->calculate_sha256 == 0 ) )
+	if( string_segment == NULL )
 	{
-		export_handle->calculated_sha256_hash_string = narrow_string_allocate(
-		                                                65 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing string segment: %d.",
+		 function,
+		 segment_index );
 
-		if( export_handle->calculated_sha256_hash_string == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create calculated SHA256 digest hash string.",
-			 function );
+		goto on_error;
+	}
+	result = ewfinput_determine_compression_values(
+	          string_segment,
+	          &( export_handle->compression_level ),
+	          &( export_handle->compression_flags ),
+	          error );
 
-			goto on_error;
-		}
-		export_handle->calculate_sha256 = 1;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine compression values.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libcsplit_wide_split_string_free(
@@ -3506,26 +3796,18 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the output values of the export handle
- * Returns 1 if successful or -1 on error
+
+/* Sets the output format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int export_handle_set_output_values(
+int export_handle_set_output_format(
      export_handle_t *export_handle,
-     system_character_t *acquiry_operating_system,
-     system_character_t *acquiry_software,
-     system_character_t *acquiry_software_version,
-     uint8_t zero_chunk_on_error,
-     uint8_t copy_input_values,
+     const system_character_t *string,
      libcerror_error_t **error )
 {
-#if defined( HAVE_GUID_SUPPORT )
-	uint8_t guid[ GUID_SIZE ];
-
-	uint8_t guid_type          = 0;
-#endif
-	static char *function      = "export_handle_set_output_values";
-	size_t value_string_length = 0;
-	int result                 = 0;
+	static char *function = "export_handle_set_output_format";
+	size_t string_length  = 0;
+	int result            = 0;
 
 	if( export_handle == NULL )
 	{
@@ -3538,28 +3820,958 @@ int export_handle_set_output_values(
 
 		return( -1 );
 	}
-	if( libewf_handle_get_bytes_per_sector(
-	     export_handle->input_handle,
-	     &( export_handle->bytes_per_sector ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector from input handle.",
-		 function );
+	string_length = system_string_length(
+	                 string );
 
-		return( -1 );
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "raw" ),
+		     3 ) == 0 )
+		{
+			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_RAW;
+			result                       = 1;
+		}
 	}
-	if( libewf_handle_set_read_zero_chunk_on_error(
-	     export_handle->input_handle,
-	     zero_chunk_on_error,
-	     error ) != 1 )
+	else if( string_length == 5 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "files" ),
+		     5 ) == 0 )
+		{
+			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_FILES;
+			result                       = 1;
+		}
+	}
+	if( result == 0 )
+	{
+		result = ewfinput_determine_ewf_format(
+			  string,
+			  &( export_handle->ewf_format ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine format.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			export_handle->output_format = EXPORT_HANDLE_OUTPUT_FORMAT_EWF;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of sectors per chunk
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_sectors_per_chunk(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_sectors_per_chunk";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_sectors_per_chunk(
+	          string,
+	          &( export_handle->output_sectors_per_chunk ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sectors per chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the maximum segment file size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_maximum_segment_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_maximum_segment_size";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &( export_handle->maximum_segment_size ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 0 )
+	{
+		if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+		{
+			if( ( export_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
+			 || ( ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT ) )
+			 || ( ( export_handle->ewf_format != LIBEWF_FORMAT_ENCASE6 )
+			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT ) ) )
+			{
+				export_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+
+				result = 0;
+			}
+		}
+		else if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+		{
+			if( ( ( export_handle->maximum_segment_size != 0 )
+			  &&  ( export_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT ) ) )
+			{
+				export_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+
+				result = 0;
+			}
+		}
+	}
+	return( result );
+}
+
+/* Sets the export offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_export_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_export_offset";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &( export_handle->export_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine export offset.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+	}
+	return( result );
+}
+
+/* Sets the export size
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_export_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_export_size";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &( export_handle->export_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine export size.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+	}
+	return( result );
+}
+
+/* Sets the header codepage
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_header_codepage(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_header_codepage";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_header_codepage(
+	          string,
+	          &export_handle->header_codepage,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine header codepage.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the process buffer size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_process_buffer_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_set_process_buffer_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine process buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable > (uint64_t) SSIZE_MAX )
+		{
+			export_handle->process_buffer_size = 0;
+
+			result = 0;
+		}
+		else
+		{
+			export_handle->process_buffer_size = (size_t) size_variable;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "export_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( system_resources_get_automatic_number_of_threads(
+		     &( export_handle->number_of_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine automatic number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		if( system_resources_get_automatic_process_buffers_size(
+		     EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE,
+		     &( export_handle->maximum_process_buffers_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine automatic process buffers size.",
+			 function );
+
+			return( -1 );
+		}
+		/* The process buffers size is an upper bound, the number of buffers in flight
+		 * is adapted at runtime
+		 */
+		export_handle->adapt_number_of_buffers = 1;
+#endif
+		result = 1;
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
+	{
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			export_handle->number_of_threads       = (int) number_of_threads;
+			export_handle->adapt_number_of_buffers = 0;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of writer threads of the split raw output
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_raw_writers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function          = "export_handle_set_number_of_raw_writers";
+	size_t string_length           = 0;
+	uint64_t number_of_raw_writers = 0;
+	int result                     = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_raw_writers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of raw writers.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( number_of_raw_writers > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			export_handle->number_of_raw_writers = (int) number_of_raw_writers;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of readers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_number_of_readers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "export_handle_set_number_of_readers";
+	size_t string_length       = 0;
+	uint64_t number_of_readers = 0;
+	int result                 = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+		                 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of readers.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( ( number_of_readers == 0 )
+		 || ( number_of_readers > EXPORT_HANDLE_MAXIMUM_NUMBER_OF_READERS ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			export_handle->number_of_readers = (int) number_of_readers;
+		}
+	}
+	return( result );
+}
+
+/* Sets the additional digest types
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_additional_digest_types(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "export_handle_set_additional_digest_types";
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	uint8_t calculate_sha1                           = 0;
+	uint8_t calculate_sha256                         = 0;
+	int number_of_segments                           = 0;
+	int result                                       = 0;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ',',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ',',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment_size == 5 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha1" ),
+			     4 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA1" ),
+			          4 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+		}
+		else if( string_segment_size == 6 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha-1" ),
+			     5 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "sha_1" ),
+			          5 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA-1" ),
+			          5 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA_1" ),
+			          5 ) == 0 )
+			{
+				calculate_sha1 = 1;
+			}
+		}
+		else if( string_segment_size == 7 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha256" ),
+			     6 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA256" ),
+			          6 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+		}
+		else if( string_segment_size == 8 )
+		{
+			if( system_string_compare(
+			     string_segment,
+			     _SYSTEM_STRING( "sha-256" ),
+			     7 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "sha_256" ),
+			          7 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA-256" ),
+			          7 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+			else if( system_string_compare(
+			          string_segment,
+			          _SYSTEM_STRING( "SHA_256" ),
+			          7 ) == 0 )
+			{
+				calculate_sha256 = 1;
+			}
+		}
+	}
+	if( ( calculate_sha1 != 0 )
+	 && ( export_handle->calculate_sha1 == 0 ) )
+	{
+		export_handle->calculated_sha1_hash_string = narrow_string_allocate(
+		                                              41 );
+
+		if( export_handle->calculated_sha1_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA1 digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->calculate_sha1 = 1;
+	}
+	if( ( calculate_sha256 != 0 )
+	 && ( export_handle->calculate_sha256 == 0 ) )
+	{
+		export_handle->calculated_sha256_hash_string = narrow_string_allocate(
+		                                                65 );
+
+		if( export_handle->calculated_sha256_hash_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create calculated SHA256 digest hash string.",
+			 function );
+
+			goto on_error;
+		}
+		export_handle->calculate_sha256 = 1;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Sets the output values of the export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_output_values(
+     export_handle_t *export_handle,
+     system_character_t *acquiry_operating_system,
+     system_character_t *acquiry_software,
+     system_character_t *acquiry_software_version,
+     uint8_t zero_chunk_on_error,
+     uint8_t copy_input_values,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_GUID_SUPPORT )
+	uint8_t guid[ GUID_SIZE ];
+
+	uint8_t guid_type          = 0;
+#endif
+	static char *function      = "export_handle_set_output_values";
+	size_t value_string_length = 0;
+	int result                 = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_bytes_per_sector(
+	     export_handle->input_handle,
+	     &( export_handle->bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector from input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_set_read_zero_chunk_on_error(
+	     export_handle->input_handle,
+	     zero_chunk_on_error,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 		 "%s: unable to set zero chunk on error in input handle.",
 		 function );
@@ -3568,428 +4780,882 @@ int export_handle_set_output_values(
 	}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		if( export_handle->ewf_output_handle == NULL )
+		if( export_handle->ewf_output_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing ewf output handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_copy_header_values(
+		     export_handle->ewf_output_handle,
+		     export_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy header values.",
+			 function );
+
+			return( -1 );
+		}
+		/* Set acquiry operating system, software and software version
+		 */
+		if( acquiry_operating_system != NULL )
+		{
+			value_string_length = system_string_length(
+			                       acquiry_operating_system );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libewf_handle_set_utf16_header_value(
+			          export_handle->ewf_output_handle,
+			          (uint8_t *) "acquiry_operating_system",
+			          24,
+			          (uint16_t *) acquiry_operating_system,
+			          value_string_length,
+			          error );
+#else
+			result = libewf_handle_set_utf8_header_value(
+			          export_handle->ewf_output_handle,
+			          (uint8_t *) "acquiry_operating_system",
+			          24,
+			          (uint8_t *) acquiry_operating_system,
+			          value_string_length,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set header value: acquiry operating system.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		value_string_length = system_string_length(
+				       acquiry_software );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_set_utf16_header_value(
+			  export_handle->ewf_output_handle,
+			  (uint8_t *) "acquiry_software",
+			  16,
+			  (uint16_t *) acquiry_software,
+			  value_string_length,
+			  error );
+#else
+		result = libewf_handle_set_utf8_header_value(
+			  export_handle->ewf_output_handle,
+			  (uint8_t *) "acquiry_software",
+			  16,
+			  (uint8_t *) acquiry_software,
+			  value_string_length,
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header value: acquiry software.",
+			 function );
+
+			return( -1 );
+		}
+		value_string_length = system_string_length(
+				       acquiry_software_version );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libewf_handle_set_utf16_header_value(
+			  export_handle->ewf_output_handle,
+			  (uint8_t *) "acquiry_software_version",
+			  24,
+			  (uint16_t *) acquiry_software_version,
+			  value_string_length,
+			  error );
+#else
+		result = libewf_handle_set_utf8_header_value(
+			  export_handle->ewf_output_handle,
+			  (uint8_t *) "acquiry_software_version",
+			  24,
+			  (uint8_t *) acquiry_software_version,
+			  value_string_length,
+			  error );
+#endif
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header value: acquiry software version.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_header_codepage(
+		     export_handle->ewf_output_handle,
+		     export_handle->header_codepage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set header codepage.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_copy_media_values(
+		     export_handle->ewf_output_handle,
+		     export_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy media values.",
+			 function );
+
+			return( -1 );
+		}
+		if( copy_input_values == 0 )
+		{
+			if( libewf_handle_set_media_size(
+			     export_handle->ewf_output_handle,
+			     (size64_t) export_handle->export_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set media size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		/* Format needs to be set before segment file size and compression values
+		 */
+		if( copy_input_values != 0 )
+		{
+			if( libewf_handle_get_format(
+			     export_handle->input_handle,
+			     &( export_handle->ewf_format ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve format.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_handle_set_format(
+		     export_handle->ewf_output_handle,
+		     export_handle->ewf_format,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set format.",
+			 function );
+
+			return( -1 );
+		}
+		if( copy_input_values != 0 )
+		{
+			if( libewf_handle_get_compression_method(
+			     export_handle->input_handle,
+			     &( export_handle->compression_method ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compression method.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_handle_get_compression_values(
+			     export_handle->input_handle,
+			     &( export_handle->compression_level ),
+			     &( export_handle->compression_flags ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compression values.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+		{
+			if( export_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			{
+				export_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+			}
+		}
+		if( libewf_handle_set_compression_method(
+		     export_handle->ewf_output_handle,
+		     export_handle->compression_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression method.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_handle_set_compression_values(
+		     export_handle->ewf_output_handle,
+		     export_handle->compression_level,
+		     export_handle->compression_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set compression values.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( export_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+		 || ( ( export_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 ) )
+		{
+			export_handle->write_compressed = 1;
+		}
+		else
+		{
+			export_handle->write_compressed = 0;
+		}
+		if( copy_input_values != 0 )
+		{
+			if( libewf_handle_get_maximum_segment_size(
+			     export_handle->input_handle,
+			     &( export_handle->maximum_segment_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve maximum segment size.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_handle_set_maximum_segment_size(
+		     export_handle->ewf_output_handle,
+		     export_handle->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			return( -1 );
+		}
+		if( copy_input_values == 0 )
+		{
+			if( libewf_handle_set_sectors_per_chunk(
+			     export_handle->ewf_output_handle,
+			     export_handle->output_sectors_per_chunk,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sectors per chunk in output handle.",
+				 function );
+
+				return( -1 );
+			}
+#if defined( HAVE_GUID_SUPPORT )
+			if( ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE5 )
+			 || ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+			 || ( export_handle->ewf_format == LIBEWF_FORMAT_EWFX ) )
+			{
+				guid_type = GUID_TYPE_RANDOM;
+			}
+			else if( ( export_handle->ewf_format == LIBEWF_FORMAT_LINEN5 )
+			      || ( export_handle->ewf_format == LIBEWF_FORMAT_LINEN6 ) )
+			{
+				guid_type = GUID_TYPE_TIME;
+			}
+			if( guid_type != 0 )
+			{
+				/* Sets the GUID if necessary
+				 */
+				if( guid_generate(
+				     guid,
+				     GUID_SIZE,
+				     guid_type,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate GUID for set identifier.",
+					 function );
+
+					return( -1 );
+				}
+				if( libewf_handle_set_segment_file_set_identifier(
+				     export_handle->ewf_output_handle,
+				     guid,
+				     16,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set segment file set identifier.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#endif /* defined( HAVE_GUID_SUPPORT ) */
+		}
+	}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+	else if( export_handle->split_raw_writer != NULL )
+	{
+		if( split_raw_writer_set_media_values(
+		     export_handle->split_raw_writer,
+		     (size64_t) export_handle->export_size,
+		     export_handle->maximum_segment_size,
+		     export_handle->sparse_output,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set split raw writer media values.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	      && ( export_handle->use_stdout == 0 ) )
+	{
+		if( libsmraw_handle_set_media_size(
+		     export_handle->raw_output_handle,
+		     (size64_t) export_handle->export_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media size.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsmraw_handle_set_maximum_segment_size(
+		     export_handle->raw_output_handle,
+		     export_handle->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum segment size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the hash value in the output handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_hash_value(
+     export_handle_t *export_handle,
+     char *hash_value_identifier,
+     size_t hash_value_identifier_length,
+     char *hash_value,
+     size_t hash_value_length,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_hash_value";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( libewf_handle_set_utf8_hash_value(
+		     export_handle->ewf_output_handle,
+		     (uint8_t *) hash_value_identifier,
+		     hash_value_identifier_length,
+		     (uint8_t *) hash_value,
+		     hash_value_length,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing ewf output handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: %s.",
+			 function,
+			 hash_value_identifier );
 
 			return( -1 );
 		}
-		if( libewf_handle_copy_header_values(
-		     export_handle->ewf_output_handle,
-		     export_handle->input_handle,
+	}
+	else if( export_handle->raw_output_handle != NULL )
+	{
+		if( libsmraw_handle_set_utf8_integrity_hash_value(
+		     export_handle->raw_output_handle,
+		     (uint8_t *) hash_value_identifier,
+		     hash_value_identifier_length,
+		     (uint8_t *) hash_value,
+		     hash_value_length,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy header values.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set integrity hash value: %s.",
+			 function,
+			 hash_value_identifier );
 
 			return( -1 );
 		}
-		/* Set acquiry operating system, software and software version
-		 */
-		if( acquiry_operating_system != NULL )
-		{
-			value_string_length = system_string_length(
-			                       acquiry_operating_system );
+	}
+	return( 1 );
+}
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-			result = libewf_handle_set_utf16_header_value(
-			          export_handle->ewf_output_handle,
-			          (uint8_t *) "acquiry_operating_system",
-			          24,
-			          (uint16_t *) acquiry_operating_system,
-			          value_string_length,
-			          error );
-#else
-			result = libewf_handle_set_utf8_header_value(
-			          export_handle->ewf_output_handle,
-			          (uint8_t *) "acquiry_operating_system",
-			          24,
-			          (uint8_t *) acquiry_operating_system,
-			          value_string_length,
-			          error );
-#endif
-			if( result != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set header value: acquiry operating system.",
-				 function );
+/* Appends a read error to the output handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_read_error(
+      export_handle_t *export_handle,
+      off64_t start_offset,
+      size_t number_of_bytes,
+      libcerror_error_t **error )
+{
+	static char *function      = "export_handle_append_read_error";
+	uint64_t start_sector      = 0;
+	uint64_t number_of_sectors = 0;
 
-				return( -1 );
-			}
-		}
-		value_string_length = system_string_length(
-				       acquiry_software );
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libewf_handle_set_utf16_header_value(
-			  export_handle->ewf_output_handle,
-			  (uint8_t *) "acquiry_software",
-			  16,
-			  (uint16_t *) acquiry_software,
-			  value_string_length,
-			  error );
-#else
-		result = libewf_handle_set_utf8_header_value(
-			  export_handle->ewf_output_handle,
-			  (uint8_t *) "acquiry_software",
-			  16,
-			  (uint8_t *) acquiry_software,
-			  value_string_length,
-			  error );
-#endif
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set header value: acquiry software.",
-			 function );
+		return( -1 );
+	}
+	if( export_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - invalid bytes per sector value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
-		value_string_length = system_string_length(
-				       acquiry_software_version );
+		return( -1 );
+	}
+	start_sector      = start_offset / export_handle->bytes_per_sector;
+	number_of_sectors = number_of_bytes / export_handle->bytes_per_sector;
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libewf_handle_set_utf16_header_value(
-			  export_handle->ewf_output_handle,
-			  (uint8_t *) "acquiry_software_version",
-			  24,
-			  (uint16_t *) acquiry_software_version,
-			  value_string_length,
-			  error );
-#else
-		result = libewf_handle_set_utf8_header_value(
-			  export_handle->ewf_output_handle,
-			  (uint8_t *) "acquiry_software_version",
-			  24,
-			  (uint8_t *) acquiry_software_version,
-			  value_string_length,
-			  error );
-#endif
-		if( result != 1 )
+	if( ( number_of_bytes % export_handle->bytes_per_sector ) != 0 )
+	{
+		number_of_sectors += 1;
+	}
+	if( export_handle->use_data_chunk_functions != 0 )
+	{
+		if( libewf_handle_append_checksum_error(
+		     export_handle->input_handle,
+		     start_sector,
+		     number_of_sectors,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set header value: acquiry software version.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
 			 function );
 
 			return( -1 );
 		}
-		if( libewf_handle_set_header_codepage(
-		     export_handle->ewf_output_handle,
-		     export_handle->header_codepage,
-		     error ) != 1 )
+	}
+	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	{
+		if( export_handle->ewf_output_handle == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set header codepage.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid export handle - missing ewf output handle.",
 			 function );
 
 			return( -1 );
 		}
-		if( libewf_handle_copy_media_values(
+		if( libewf_handle_append_acquiry_error(
 		     export_handle->ewf_output_handle,
-		     export_handle->input_handle,
+		     start_sector,
+		     number_of_sectors,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy media values.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append acquiry error.",
 			 function );
 
 			return( -1 );
 		}
-		if( copy_input_values == 0 )
+	}
+	return( 1 );
+}
+
+/* Writes a storage media buffer to the export handle
+ * Returns the number of input bytes written or -1 on error
+ */
+ssize_t export_handle_write(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *input_storage_media_buffer,
+         storage_media_buffer_t *output_storage_media_buffer,
+         size_t input_size,
+         libcerror_error_t **error )
+{
+	storage_media_buffer_t *repacked_storage_media_buffer = NULL;
+	static char *function                                 = "export_handle_write";
+	size_t write_size                                     = 0;
+	ssize_t process_count                                 = 0;
+	ssize_t write_count                                   = 0;
+	off64_t write_offset                                  = 0;
+	uint8_t is_empty                                      = 0;
+	uint8_t pass_through                                  = 0;
+	int result                                            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Chunks that were repacked by a process thread only need to be written
+	 */
+	if( ( input_storage_media_buffer->output_buffer != NULL )
+	 && ( input_storage_media_buffer->output_buffer->processed_size > 0 ) )
+	{
+		for( repacked_storage_media_buffer = input_storage_media_buffer->output_buffer;
+		     repacked_storage_media_buffer != NULL;
+		     repacked_storage_media_buffer = repacked_storage_media_buffer->next_buffer )
 		{
-			if( libewf_handle_set_media_size(
-			     export_handle->ewf_output_handle,
-			     (size64_t) export_handle->export_size,
-			     error ) != 1 )
+			if( repacked_storage_media_buffer->processed_size == 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set media size.",
-				 function );
-
-				return( -1 );
+				break;
 			}
-		}
-		/* Format needs to be set before segment file size and compression values
-		 */
-		if( copy_input_values != 0 )
-		{
-			if( libewf_handle_get_format(
-			     export_handle->input_handle,
-			     &( export_handle->ewf_format ),
-			     error ) != 1 )
+			write_count = export_handle_write_storage_media_buffer(
+			               export_handle,
+			               repacked_storage_media_buffer,
+			               repacked_storage_media_buffer->processed_size,
+			               error );
+
+			if( write_count < 0 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve format.",
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write repacked storage media buffer.",
 				 function );
 
 				return( -1 );
 			}
 		}
-		if( libewf_handle_set_format(
-		     export_handle->ewf_output_handle,
-		     export_handle->ewf_format,
-		     error ) != 1 )
+		return( (ssize_t) input_size );
+	}
+	/* A chunk is passed through when it was read without errors and is stored
+	 * in a way the output would store it as well
+	 */
+	if( ( export_handle->use_chunk_pass_through != 0 )
+	 && ( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	 && ( input_storage_media_buffer->stored_buffer_data_size > 0 )
+	 && ( input_storage_media_buffer->is_corrupted == 0 )
+	 && ( input_size == input_storage_media_buffer->processed_size )
+	 && ( input_size <= (size_t) export_handle->output_chunk_size ) )
+	{
+		if( ( input_storage_media_buffer->stored_data_flags & LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			if( ( export_handle->write_compressed != 0 )
+			 && ( input_storage_media_buffer->stored_buffer_data_size < input_size ) )
+			{
+				pass_through = 1;
+			}
+			if( ( ( input_storage_media_buffer->stored_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 )
+			 && ( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 ) )
+			{
+				pass_through = 0;
+			}
+		}
+		else if( export_handle->write_compressed == 0 )
+		{
+			pass_through = 1;
+		}
+	}
+	if( ( export_handle->sparse_output != 0 )
+	 && ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	 && ( export_handle->use_stdout == 0 ) )
+	{
+		result = storage_media_buffer_is_empty(
+		          input_storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set format.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if input storage media buffer is empty.",
 			 function );
 
 			return( -1 );
 		}
-		if( copy_input_values != 0 )
+		is_empty = (uint8_t) result;
+	}
+	write_offset = input_storage_media_buffer->storage_media_offset;
+
+	while( input_size > 0 )
+	{
+		if( pass_through != 0 )
 		{
-			if( libewf_handle_get_compression_method(
-			     export_handle->input_handle,
-			     &( export_handle->compression_method ),
-			     error ) != 1 )
+			process_count = storage_media_buffer_write_stored_data(
+			                 output_storage_media_buffer,
+			                 input_storage_media_buffer->stored_buffer,
+			                 input_storage_media_buffer->stored_buffer_data_size,
+			                 input_storage_media_buffer->stored_data_flags,
+			                 input_size,
+			                 error );
+		}
+		else if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		{
+			if( input_size > (size_t) export_handle->output_chunk_size )
+			{
+				write_size = export_handle->output_chunk_size;
+			}
+			else
+			{
+				write_size = (size_t) input_size;
+			}
+			if( storage_media_buffer_add_data(
+			     output_storage_media_buffer,
+			     input_storage_media_buffer->raw_buffer,
+			     write_size,
+			     error ) == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve compression method.",
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to add data from input buffer to storage media buffer.",
 				 function );
 
 				return( -1 );
 			}
-			if( libewf_handle_get_compression_values(
-			     export_handle->input_handle,
-			     &( export_handle->compression_level ),
-			     &( export_handle->compression_flags ),
-			     error ) != 1 )
+			if( output_storage_media_buffer == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve compression values.",
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+				 "%s: invalid output storage media buffer.",
 				 function );
 
 				return( -1 );
 			}
-		}
-		if( export_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
-		{
-			if( export_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			/* Make sure the output chunk is filled upto the output chunk size
+			 */
+			if( ( export_handle->last_offset_hashed < (off64_t) export_handle->export_size )
+			 && ( output_storage_media_buffer->raw_buffer_data_size < export_handle->output_chunk_size ) )
 			{
-				export_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid export handle - output chunk size value out of bounds.",
+				 function );
+
+				return( -1 );
 			}
+			process_count = export_handle_prepare_write_storage_media_buffer(
+					 export_handle,
+					 output_storage_media_buffer,
+					 error );
 		}
-		if( libewf_handle_set_compression_method(
-		     export_handle->ewf_output_handle,
-		     export_handle->compression_method,
-		     error ) != 1 )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set compression method.",
-			 function );
-
-			return( -1 );
+			process_count = export_handle_prepare_write_storage_media_buffer(
+					 export_handle,
+					 input_storage_media_buffer,
+					 error );
 		}
-		if( libewf_handle_set_compression_values(
-		     export_handle->ewf_output_handle,
-		     export_handle->compression_level,
-		     export_handle->compression_flags,
-		     error ) != 1 )
+		if( process_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set compression values.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to prepare storage media buffer before write.",
 			 function );
 
 			return( -1 );
 		}
-		if( ( export_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
-		 || ( ( export_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 ) )
-		{
-			export_handle->write_compressed = 1;
-		}
-		else
+		write_count = 0;
+
+		if( is_empty != 0 )
 		{
-			export_handle->write_compressed = 0;
+			write_count = export_handle_skip_sparse_range(
+			               export_handle,
+			               write_offset,
+			               (size_t) process_count,
+			               error );
 		}
-		if( copy_input_values != 0 )
+		if( write_count == 0 )
 		{
-			if( libewf_handle_get_maximum_segment_size(
-			     export_handle->input_handle,
-			     &( export_handle->maximum_segment_size ),
-			     error ) != 1 )
+			if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve maximum segment size.",
-				 function );
-
-				return( -1 );
+				write_count = export_handle_write_storage_media_buffer(
+					       export_handle,
+					       output_storage_media_buffer,
+					       process_count,
+					       error );
+			}
+			else
+			{
+				write_count = export_handle_write_storage_media_buffer(
+					       export_handle,
+					       input_storage_media_buffer,
+					       process_count,
+					       error );
 			}
 		}
-		if( libewf_handle_set_maximum_segment_size(
-		     export_handle->ewf_output_handle,
-		     export_handle->maximum_segment_size,
-		     error ) != 1 )
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum segment size.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer.",
 			 function );
 
 			return( -1 );
 		}
-		if( copy_input_values == 0 )
+		input_size   -= process_count;
+		write_count  += process_count;
+		write_offset += process_count;
+
+		if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 		{
-			if( libewf_handle_set_sectors_per_chunk(
-			     export_handle->ewf_output_handle,
-			     export_handle->output_sectors_per_chunk,
-			     error ) != 1 )
+			if( storage_media_buffer_empty(
+			     output_storage_media_buffer,
+			     error ) == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set sectors per chunk in output handle.",
+				 "%s: unable to empty storage media buffer.",
 				 function );
 
 				return( -1 );
 			}
-#if defined( HAVE_GUID_SUPPORT )
-			if( ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE5 )
-			 || ( export_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
-			 || ( export_handle->ewf_format == LIBEWF_FORMAT_EWFX ) )
-			{
-				guid_type = GUID_TYPE_RANDOM;
-			}
-			else if( ( export_handle->ewf_format == LIBEWF_FORMAT_LINEN5 )
-			      || ( export_handle->ewf_format == LIBEWF_FORMAT_LINEN6 ) )
-			{
-				guid_type = GUID_TYPE_TIME;
-			}
-			if( guid_type != 0 )
-			{
-				/* Sets the GUID if necessary
-				 */
-				if( guid_generate(
-				     guid,
-				     GUID_SIZE,
-				     guid_type,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to generate GUID for set identifier.",
-					 function );
-
-					return( -1 );
-				}
-				if( libewf_handle_set_segment_file_set_identifier(
-				     export_handle->ewf_output_handle,
-				     guid,
-				     16,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set segment file set identifier.",
-					 function );
-
-					return( -1 );
-				}
-			}
-#endif /* defined( HAVE_GUID_SUPPORT ) */
-		}
-	}
-	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
-	      && ( export_handle->use_stdout == 0 ) )
-	{
-		if( libsmraw_handle_set_media_size(
-		     export_handle->raw_output_handle,
-		     (size64_t) export_handle->export_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set media size.",
-			 function );
-
-			return( -1 );
-		}
-		if( libsmraw_handle_set_maximum_segment_size(
-		     export_handle->raw_output_handle,
-		     export_handle->maximum_segment_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum segment size.",
-			 function );
-
-			return( -1 );
 		}
 	}
-	return( 1 );
+	return( write_count );
 }
 
-/* Sets the hash value in the output handle
- * Returns 1 if successful or -1 on error
+/* Finalizes the export handle
+ * Returns the number of input bytes written or -1 on error
  */
-int export_handle_set_hash_value(
-     export_handle_t *export_handle,
-     char *hash_value_identifier,
-     size_t hash_value_identifier_length,
-     char *hash_value,
-     size_t hash_value_length,
-     libcerror_error_t **error )
+ssize_t export_handle_finalize(
+         export_handle_t *export_handle,
+         libcerror_error_t **error )
 {
-	static char *function = "export_handle_set_hash_value";
+	static char *function = "export_handle_finalize";
+	ssize_t write_count   = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4002,107 +5668,61 @@ int export_handle_set_hash_value(
 
 		return( -1 );
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	if( export_handle->calculate_md5 != 0 )
 	{
-		if( libewf_handle_set_utf8_hash_value(
-		     export_handle->ewf_output_handle,
-		     (uint8_t *) hash_value_identifier,
-		     hash_value_identifier_length,
-		     (uint8_t *) hash_value,
-		     hash_value_length,
+		if( export_handle_set_hash_value(
+		     export_handle,
+		     "MD5",
+		     3,
+		     export_handle->calculated_md5_hash_string,
+		     32,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set hash value: %s.",
-			 function,
-			 hash_value_identifier );
+			 "%s: unable to set hash value: MD5.",
+			 function );
 
 			return( -1 );
 		}
 	}
-	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
-	      && ( export_handle->use_stdout == 0 ) )
+	if( export_handle->calculate_sha1 != 0 )
 	{
-		if( libsmraw_handle_set_utf8_integrity_hash_value(
-		     export_handle->raw_output_handle,
-		     (uint8_t *) hash_value_identifier,
-		     hash_value_identifier_length,
-		     (uint8_t *) hash_value,
-		     hash_value_length,
+		if( export_handle_set_hash_value(
+		     export_handle,
+		     "SHA1",
+		     4,
+		     export_handle->calculated_sha1_hash_string,
+		     40,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set integrity hash value: %s.",
-			 function,
-			 hash_value_identifier );
+			 "%s: unable to set hash value: SHA1.",
+			 function );
 
 			return( -1 );
 		}
 	}
-	return( 1 );
-}
-
-/* Appends a read error to the output handle
- * Returns 1 if successful or -1 on error
- */
-int export_handle_append_read_error(
-      export_handle_t *export_handle,
-      off64_t start_offset,
-      size_t number_of_bytes,
-      libcerror_error_t **error )
-{
-	static char *function      = "export_handle_append_read_error";
-	uint64_t start_sector      = 0;
-	uint64_t number_of_sectors = 0;
-
-	if( export_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid export handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( export_handle->bytes_per_sector == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid export handle - invalid bytes per sector value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	start_sector      = start_offset / export_handle->bytes_per_sector;
-	number_of_sectors = number_of_bytes / export_handle->bytes_per_sector;
-
-	if( ( number_of_bytes % export_handle->bytes_per_sector ) != 0 )
-	{
-		number_of_sectors += 1;
-	}
-	if( export_handle->use_data_chunk_functions != 0 )
+	if( export_handle->calculate_sha256 != 0 )
 	{
-		if( libewf_handle_append_checksum_error(
-		     export_handle->input_handle,
-		     start_sector,
-		     number_of_sectors,
+		if( export_handle_set_hash_value(
+		     export_handle,
+		     "SHA256",
+		     6,
+		     export_handle->calculated_sha256_hash_string,
+		     64,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append checksum error.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set hash value: SHA256.",
 			 function );
 
 			return( -1 );
@@ -4110,50 +5730,46 @@ int export_handle_append_read_error(
 	}
 	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
 	{
-		if( export_handle->ewf_output_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid export handle - missing ewf output handle.",
-			 function );
+		write_count = libewf_handle_write_finalize(
+		               export_handle->ewf_output_handle,
+	        	       error );
 
-			return( -1 );
-		}
-		if( libewf_handle_append_acquiry_error(
-		     export_handle->ewf_output_handle,
-		     start_sector,
-		     number_of_sectors,
-		     error ) != 1 )
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append acquiry error.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize EWF file(s).",
 			 function );
 
 			return( -1 );
 		}
 	}
-	return( 1 );
+	return( write_count );
 }
 
-/* Writes a storage media buffer to the export handle
- * Returns the number of input bytes written or -1 on error
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Grabs a group of storage media buffers to read the read size into
+ * When the chunks are repacked in parallel the group consists of a storage media buffer
+ * per input chunk, linked by the next buffer, and the first storage media buffer is given
+ * an output storage media buffer per output chunk, linked by the next buffer
+ * Returns 1 if successful or -1 on error
  */
-ssize_t export_handle_write(
-         export_handle_t *export_handle,
-         storage_media_buffer_t *input_storage_media_buffer,
-         storage_media_buffer_t *output_storage_media_buffer,
-         size_t input_size,
-         libcerror_error_t **error )
+int export_handle_grab_storage_media_buffers(
+     export_handle_t *export_handle,
+     size_t read_size,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
 {
-	static char *function = "export_handle_write";
-	size_t write_size     = 0;
-	ssize_t process_count = 0;
-	ssize_t write_count   = 0;
+	storage_media_buffer_t *first_storage_media_buffer   = NULL;
+	storage_media_buffer_t *grabbed_storage_media_buffer = NULL;
+	storage_media_buffer_t *last_storage_media_buffer    = NULL;
+	static char *function                                = "export_handle_grab_storage_media_buffers";
+	int buffer_index                                     = 0;
+	int number_of_buffers                                = 1;
+	int number_of_output_buffers                         = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4166,151 +5782,165 @@ ssize_t export_handle_write(
 
 		return( -1 );
 	}
-	if( input_storage_media_buffer == NULL )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid input storage media buffer.",
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	while( input_size > 0 )
+	if( export_handle->use_parallel_repack != 0 )
 	{
-		if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		if( ( export_handle->input_chunk_size == 0 )
+		 || ( export_handle->output_chunk_size == 0 ) )
 		{
-			if( input_size > (size_t) export_handle->output_chunk_size )
-			{
-				write_size = export_handle->output_chunk_size;
-			}
-			else
-			{
-				write_size = (size_t) input_size;
-			}
-			if( storage_media_buffer_add_data(
-			     output_storage_media_buffer,
-			     input_storage_media_buffer->raw_buffer,
-			     write_size,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-				 "%s: unable to add data from input buffer to storage media buffer.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid export handle - chunk size value out of bounds.",
+			 function );
 
-				return( -1 );
-			}
-			if( output_storage_media_buffer == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-				 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-				 "%s: invalid output storage media buffer.",
-				 function );
+			return( -1 );
+		}
+		number_of_buffers        = (int) ( ( read_size + export_handle->input_chunk_size - 1 ) / export_handle->input_chunk_size );
+		number_of_output_buffers = (int) ( ( read_size + export_handle->output_chunk_size - 1 ) / export_handle->output_chunk_size );
+	}
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffer_queue_grab_buffer(
+		     export_handle->storage_media_buffer_queue,
+		     &grabbed_storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer: %d from queue.",
+			 function,
+			 buffer_index );
 
-				return( -1 );
-			}
-			/* Make sure the output chunk is filled upto the output chunk size
-			 */
-			if( ( export_handle->last_offset_hashed < (off64_t) export_handle->export_size )
-			 && ( output_storage_media_buffer->raw_buffer_data_size < export_handle->output_chunk_size ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: invalid export handle - output chunk size value out of bounds.",
-				 function );
+			goto on_error;
+		}
+		if( grabbed_storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer: %d.",
+			 function,
+			 buffer_index );
 
-				return( -1 );
-			}
-			process_count = export_handle_prepare_write_storage_media_buffer(
-					 export_handle,
-					 output_storage_media_buffer,
-					 error );
+			goto on_error;
+		}
+		grabbed_storage_media_buffer->output_buffer = NULL;
+		grabbed_storage_media_buffer->next_buffer   = NULL;
+
+		if( first_storage_media_buffer == NULL )
+		{
+			first_storage_media_buffer = grabbed_storage_media_buffer;
 		}
 		else
 		{
-			process_count = export_handle_prepare_write_storage_media_buffer(
-					 export_handle,
-					 input_storage_media_buffer,
-					 error );
+			last_storage_media_buffer->next_buffer = grabbed_storage_media_buffer;
 		}
-		if( process_count < 0 )
+		last_storage_media_buffer = grabbed_storage_media_buffer;
+	}
+	last_storage_media_buffer = NULL;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_output_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffer_queue_grab_buffer(
+		     export_handle->output_storage_media_buffer_queue,
+		     &grabbed_storage_media_buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to prepare storage media buffer before write.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab output storage media buffer: %d from queue.",
+			 function,
+			 buffer_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( grabbed_storage_media_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing output storage media buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
 		}
-		if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		grabbed_storage_media_buffer->next_buffer = NULL;
+
+		if( last_storage_media_buffer == NULL )
 		{
-			write_count = export_handle_write_storage_media_buffer(
-				       export_handle,
-				       output_storage_media_buffer,
-				       process_count,
-				       error );
+			first_storage_media_buffer->output_buffer = grabbed_storage_media_buffer;
 		}
 		else
 		{
-			write_count = export_handle_write_storage_media_buffer(
-				       export_handle,
-				       input_storage_media_buffer,
-				       process_count,
-				       error );
+			last_storage_media_buffer->next_buffer = grabbed_storage_media_buffer;
 		}
-		if( write_count < 0 )
+		last_storage_media_buffer = grabbed_storage_media_buffer;
+
+		if( storage_media_buffer_empty(
+		     grabbed_storage_media_buffer,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to empty output storage media buffer: %d.",
+			 function,
+			 buffer_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		input_size  -= process_count;
-		write_count += process_count;
+	}
+	*storage_media_buffer = first_storage_media_buffer;
 
-		if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
-		{
-			if( storage_media_buffer_empty(
-			     output_storage_media_buffer,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to empty storage media buffer.",
-				 function );
+	return( 1 );
 
-				return( -1 );
-			}
-		}
+on_error:
+	if( first_storage_media_buffer != NULL )
+	{
+		export_handle_release_storage_media_buffers(
+		 export_handle,
+		 first_storage_media_buffer,
+		 NULL );
 	}
-	return( write_count );
+	return( -1 );
 }
 
-/* Finalizes the export handle
- * Returns the number of input bytes written or -1 on error
+/* Releases a group of storage media buffers, including its output storage media buffers, onto the queues
+ * Returns 1 if successful or -1 on error
  */
-ssize_t export_handle_finalize(
-         export_handle_t *export_handle,
-         libcerror_error_t **error )
+int export_handle_release_storage_media_buffers(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
 {
-	static char *function = "export_handle_finalize";
-	ssize_t write_count   = 0;
+	storage_media_buffer_t *next_storage_media_buffer   = NULL;
+	storage_media_buffer_t *output_storage_media_buffer = NULL;
+	static char *function                               = "export_handle_release_storage_media_buffers";
+	int result                                          = 1;
 
 	if( export_handle == NULL )
 	{
@@ -4323,89 +5953,216 @@ ssize_t export_handle_finalize(
 
 		return( -1 );
 	}
-	if( export_handle->calculate_md5 != 0 )
+	if( storage_media_buffer == NULL )
 	{
-		if( export_handle_set_hash_value(
-		     export_handle,
-		     "MD5",
-		     3,
-		     export_handle->calculated_md5_hash_string,
-		     32,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	output_storage_media_buffer = storage_media_buffer->output_buffer;
+
+	storage_media_buffer->output_buffer = NULL;
+
+	while( output_storage_media_buffer != NULL )
+	{
+		next_storage_media_buffer = output_storage_media_buffer->next_buffer;
+
+		output_storage_media_buffer->next_buffer = NULL;
+
+		if( storage_media_buffer_queue_release_buffer(
+		     export_handle->output_storage_media_buffer_queue,
+		     output_storage_media_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set hash value: MD5.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release output storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &output_storage_media_buffer,
+			 NULL );
+
+			result = -1;
 		}
+		output_storage_media_buffer = next_storage_media_buffer;
 	}
-	if( export_handle->calculate_sha1 != 0 )
+	while( storage_media_buffer != NULL )
 	{
-		if( export_handle_set_hash_value(
-		     export_handle,
-		     "SHA1",
-		     4,
-		     export_handle->calculated_sha1_hash_string,
-		     40,
+		next_storage_media_buffer = storage_media_buffer->next_buffer;
+
+		storage_media_buffer->next_buffer = NULL;
+
+		if( storage_media_buffer_queue_release_buffer(
+		     export_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set hash value: SHA1.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+
+			result = -1;
 		}
+		storage_media_buffer = next_storage_media_buffer;
 	}
-	if( export_handle->calculate_sha256 != 0 )
+	return( result );
+}
+
+/* Repacks the data of a group of storage media buffers into the output storage media buffers of the group
+ * The input chunks are gathered into output chunks that are packed for the output handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_repack_storage_media_buffers(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *output_storage_media_buffer = NULL;
+	uint8_t *data                                       = NULL;
+	static char *function                               = "export_handle_repack_storage_media_buffers";
+	size_t data_size                                    = 0;
+	ssize_t copy_count                                  = 0;
+	ssize_t process_count                               = 0;
+
+	if( export_handle == NULL )
 	{
-		if( export_handle_set_hash_value(
-		     export_handle,
-		     "SHA256",
-		     6,
-		     export_handle->calculated_sha256_hash_string,
-		     64,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	output_storage_media_buffer = storage_media_buffer->output_buffer;
+
+	while( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set hash value: SHA256.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage media buffer data.",
 			 function );
 
 			return( -1 );
 		}
+		data_size = storage_media_buffer->processed_size;
+
+		while( data_size > 0 )
+		{
+			if( output_storage_media_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing output storage media buffer.",
+				 function );
+
+				return( -1 );
+			}
+			copy_count = storage_media_buffer_add_data(
+			              output_storage_media_buffer,
+			              data,
+			              data_size,
+			              error );
+
+			if( copy_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to add data to output storage media buffer.",
+				 function );
+
+				return( -1 );
+			}
+			data      += copy_count;
+			data_size -= (size_t) copy_count;
+
+			/* An output chunk is packed as soon as it is filled
+			 */
+			if( output_storage_media_buffer->raw_buffer_data_size >= output_storage_media_buffer->raw_buffer_size )
+			{
+				process_count = storage_media_buffer_write_process(
+				                 output_storage_media_buffer,
+				                 error );
+
+				if( process_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to repack output storage media buffer.",
+					 function );
+
+					return( -1 );
+				}
+				output_storage_media_buffer = output_storage_media_buffer->next_buffer;
+			}
+		}
+		storage_media_buffer = storage_media_buffer->next_buffer;
 	}
-	if( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	/* The last output chunk of the export can be smaller than the output chunk size
+	 */
+	if( ( output_storage_media_buffer != NULL )
+	 && ( output_storage_media_buffer->raw_buffer_data_size > 0 ) )
 	{
-		write_count = libewf_handle_write_finalize(
-		               export_handle->ewf_output_handle,
-	        	       error );
+		process_count = storage_media_buffer_write_process(
+		                 output_storage_media_buffer,
+		                 error );
 
-		if( write_count < 0 )
+		if( process_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize EWF file(s).",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to repack output storage media buffer.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	return( write_count );
+	return( 1 );
 }
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-
 /* Prepares a storage media buffer for export
  * Callback function for the process thread pool
  * Returns 1 if successful or -1 on error
@@ -4414,9 +6171,12 @@ int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-        libcerror_error_t *error = NULL;
-        static char *function    = "export_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+	storage_media_buffer_t *group_storage_media_buffer = NULL;
+        libcerror_error_t *error                           = NULL;
+        static char *function                              = "export_handle_process_storage_media_buffer_callback";
+	size_t processed_size                              = 0;
+	ssize_t process_count                              = 0;
+	int64_t start_timestamp                            = 0;
 
 	if( storage_media_buffer == NULL )
 	{
@@ -4429,31 +6189,124 @@ int export_handle_process_storage_media_buffer_callback(
 
 		goto on_error;
 	}
-	if( export_handle->abort != 0 )
+	/* On abort the storage media buffer is still pushed onto the output window
+	 * so that the output window releases it, and the storage media buffers that follow it
+	 */
+	if( export_handle->abort == 0 )
 	{
-		return( 1 );
-	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
+		/* Profiling is best effort and does not affect the export
+		 */
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		for( group_storage_media_buffer = storage_media_buffer;
+		     group_storage_media_buffer != NULL;
+		     group_storage_media_buffer = group_storage_media_buffer->next_buffer )
+		{
+			process_count = storage_media_buffer_read_process(
+					 group_storage_media_buffer,
+					 &error );
+
+			if( process_count < 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+#endif
+				libcerror_error_free(
+				 &error );
+
+				group_storage_media_buffer->is_corrupted = 1;
+
+				/* A chunk that cannot be unpacked is repacked as zero bytes
+				 * so that the chunks that follow it in the group keep their offset in the output
+				 */
+				if( export_handle->use_parallel_repack != 0 )
+				{
+					if( group_storage_media_buffer->requested_size > group_storage_media_buffer->raw_buffer_size )
+					{
+						libcerror_error_set(
+						 &error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+						 "%s: invalid storage media buffer - requested size value out of bounds.",
+						 function );
+
+						goto on_error;
+					}
+					if( memory_set(
+					     group_storage_media_buffer->raw_buffer,
+					     0,
+					     group_storage_media_buffer->requested_size ) == NULL )
+					{
+						libcerror_error_set(
+						 &error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear storage media buffer.",
+						 function );
+
+						goto on_error;
+					}
+					group_storage_media_buffer->raw_buffer_data_size = group_storage_media_buffer->requested_size;
+					group_storage_media_buffer->processed_size       = group_storage_media_buffer->requested_size;
+				}
+			}
+			processed_size += group_storage_media_buffer->processed_size;
+		}
+		stage_profiler_add_sample(
+		 export_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_UNPACK,
+		 start_timestamp,
+		 (uint64_t) processed_size,
+		 NULL );
 
-	if( process_count < 0 )
-	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( ( libcnotify_verbose != 0 )
-		 && ( error != NULL ) )
+		/* Repack the chunks for the output, so that the output window only needs to write them
+		 */
+		if( ( export_handle->use_parallel_repack != 0 )
+		 && ( storage_media_buffer->output_buffer != NULL ) )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
-		}
-#endif
-		libcerror_error_free(
-		 &error );
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			if( export_handle_repack_storage_media_buffers(
+			     export_handle,
+			     storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to repack storage media buffers.",
+				 function );
 
-		storage_media_buffer->is_corrupted = 1;
+				goto on_error;
+			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_PACK,
+			 start_timestamp,
+			 (uint64_t) processed_size,
+			 NULL );
+		}
 	}
-	if( libcthreads_thread_pool_push(
-	     export_handle->output_thread_pool,
+	stage_profiler_get_timestamp(
+	 &( storage_media_buffer->output_window_timestamp ),
+	 NULL );
+
+	/* The output window passes the storage media buffer on, from this or another process thread,
+	 * when all the preceding storage media buffers have been passed on
+	 */
+	if( reorder_window_push(
+	     export_handle->output_window,
+	     storage_media_buffer->sequence_number,
 	     (intptr_t *) storage_media_buffer,
 	     &error ) != 1 )
 	{
@@ -4461,7 +6314,7 @@ int export_handle_process_storage_media_buffer_callback(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 "%s: unable to push storage media buffer onto output window.",
 		 function );
 
 		goto on_error;
@@ -4471,25 +6324,6 @@ int export_handle_process_storage_media_buffer_callback(
 	return( 1 );
 
 on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
-
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
-	}
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -4508,25 +6342,47 @@ on_error:
 		 export_handle,
 		 NULL );
 	}
+	if( storage_media_buffer != NULL )
+	{
+		/* The storage media buffer is still pushed onto the output window, which releases it on abort,
+		 * so that the output window keeps passing on, and releasing, the storage media buffers that follow it
+		 */
+		if( reorder_window_push(
+		     export_handle->output_window,
+		     storage_media_buffer->sequence_number,
+		     (intptr_t *) storage_media_buffer,
+		     NULL ) == 1 )
+		{
+			storage_media_buffer = NULL;
+		}
+		if( storage_media_buffer != NULL )
+		{
+			export_handle_release_storage_media_buffers(
+			 export_handle,
+			 storage_media_buffer,
+			 NULL );
+		}
+	}
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for export
- * Callback function for the process thread pool
+/* Writes a storage media buffer to the export output
+ * Callback function for the output window, that is called for the storage media buffers in order
  * Returns 1 if successful or -1 on error
  */
 int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle )
 {
-	libcdata_list_element_t *element                    = NULL;
-	libcdata_list_element_t *next_element               = NULL;
         libcerror_error_t *error                            = NULL;
+	storage_media_buffer_t *group_storage_media_buffer  = NULL;
 	storage_media_buffer_t *output_storage_media_buffer = NULL;
 	uint8_t *data                                       = NULL;
         static char *function                               = "export_handle_output_storage_media_buffer_callback";
 	size_t data_size                                    = 0;
+	size_t processed_size                               = 0;
 	ssize_t write_count                                 = 0;
+	int64_t start_timestamp                             = 0;
 	int result                                          = 0;
 
 	if( export_handle == NULL )
@@ -4549,353 +6405,631 @@ int export_handle_output_storage_media_buffer_callback(
 		 "%s: invalid storage media buffer.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( export_handle->abort != 0 )
+	/* The time the storage media buffer was held in the output window
+	 */
+	stage_profiler_add_sample(
+	 export_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_REORDER,
+	 storage_media_buffer->output_window_timestamp,
+	 (uint64_t) storage_media_buffer->processed_size,
+	 NULL );
+
+	if( export_handle->abort == 0 )
 	{
-		return( 1 );
+		/* The storage media buffers of a group are hashed in order of the input
+		 */
+		for( group_storage_media_buffer = storage_media_buffer;
+		     group_storage_media_buffer != NULL;
+		     group_storage_media_buffer = group_storage_media_buffer->next_buffer )
+		{
+			result = storage_media_buffer_is_corrupted(
+			          group_storage_media_buffer,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if storage media buffer is corrupted.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				/* Append a read error
+				 */
+				if( export_handle_append_read_error(
+				     export_handle,
+				     group_storage_media_buffer->storage_media_offset,
+				     (size_t) export_handle->input_chunk_size,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append read error.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( storage_media_buffer_get_data(
+			     group_storage_media_buffer,
+			     &data,
+			     &data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine storage media buffer data.",
+				 function );
+
+				goto on_error;
+			}
+			/* Swap byte pairs
+			 */
+			if( export_handle->swap_byte_pairs == 1 )
+			{
+				if( export_handle_swap_byte_pairs(
+				     export_handle,
+				     data,
+				     group_storage_media_buffer->processed_size,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+					 LIBCERROR_CONVERSION_ERROR_GENERIC,
+					 "%s: unable to swap byte pairs.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			/* Digest hashes are calcultated after swap
+			 */
+			if( export_handle_update_integrity_hash(
+			     export_handle,
+			     data,
+			     group_storage_media_buffer->processed_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_HASH,
+			 start_timestamp,
+			 (uint64_t) group_storage_media_buffer->processed_size,
+			 NULL );
+
+			export_handle->last_offset_hashed = group_storage_media_buffer->storage_media_offset + group_storage_media_buffer->processed_size;
+
+			processed_size += group_storage_media_buffer->processed_size;
+		}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+		if( export_handle->split_raw_writer != NULL )
+		{
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			/* The split raw writer releases the storage media buffer once it was written
+			 */
+			if( split_raw_writer_push(
+			     export_handle->split_raw_writer,
+			     storage_media_buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto split raw writer.",
+				 function );
+
+				goto on_error;
+			}
+			/* Pushing blocks while the queue of the writer threads is full
+			 */
+			stage_profiler_add_wait(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_WRITE,
+			 start_timestamp,
+			 NULL );
+
+			storage_media_buffer = NULL;
+		}
+		else
+#endif
+		{
+			/* Chunks that were repacked by a process thread do not need an output storage media buffer
+			 */
+			if( ( export_handle->use_data_chunk_functions != 0 )
+			 && ( ( storage_media_buffer->output_buffer == NULL )
+			  || ( storage_media_buffer->output_buffer->processed_size == 0 ) ) )
+			{
+				if( storage_media_buffer_initialize(
+				     &output_storage_media_buffer,
+				     export_handle->ewf_output_handle,
+				     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+				     export_handle->output_chunk_size,
+				     &error ) != 1 )
+				{
+					libcerror_error_set(
+					 &error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create output storage media buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			write_count = export_handle_write(
+				       export_handle,
+				       storage_media_buffer,
+				       output_storage_media_buffer,
+				       processed_size,
+				       &error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write to export handle.",
+				 function );
+
+				goto on_error;
+			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_WRITE,
+			 start_timestamp,
+			 (uint64_t) write_count,
+			 NULL );
+		}
 	}
-	if( libcdata_list_insert_value(
-	     export_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+/* TODO: if storage media buffer can be passed on do not release it */
+	if( storage_media_buffer != NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
+		result = export_handle_release_storage_media_buffers(
+		          export_handle,
+		          storage_media_buffer,
+		          &error );
 
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
+		storage_media_buffer = NULL;
 
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffers onto queues.",
+			 function );
+
+			goto on_error;
+		}
+	}
+/* TODO: if storage media buffer can be passed on do not free it */
+	if( output_storage_media_buffer != NULL )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
+		if( storage_media_buffer_free(
+		     &output_storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output storage media buffer.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
-	while( element != NULL )
+	if( ( export_handle->abort == 0 )
+	 && ( export_handle->process_status != NULL ) )
 	{
-		if( export_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
+		if( process_status_update(
+		     export_handle->process_status,
+		     export_handle->last_offset_hashed,
+		     export_handle->input_media_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( export_handle_release_storage_media_buffers(
+		     export_handle,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffers onto queues.",
 			 function );
-
-			return( -1 );
 		}
-		if( storage_media_buffer->storage_media_offset != export_handle->last_offset_hashed )
+	}
+/* TODO move to queue */
+	if( output_storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &output_storage_media_buffer,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			break;
+			libcnotify_print_error_backtrace(
+			 error );
 		}
-		result = storage_media_buffer_is_corrupted(
-		          storage_media_buffer,
-		          &error );
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( export_handle->abort == 0 )
+	{
+		export_handle_signal_abort(
+		 export_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties the output window
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_empty_output_window(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "export_handle_empty_output_window";
+	int result                                   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = reorder_window_remove_value(
+		          export_handle->output_window,
+		          (intptr_t **) &storage_media_buffer,
+		          error );
 
 		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if storage media buffer is corrupted.",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output window.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			return( -1 );
 		}
 		else if( result != 0 )
 		{
-			/* Append a read error
-			 */
-			if( export_handle_append_read_error(
+			if( export_handle_release_storage_media_buffers(
 			     export_handle,
-			     storage_media_buffer->storage_media_offset,
-			     (size_t) export_handle->input_chunk_size,
-			     &error ) != 1 )
+			     storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
-				 &error,
+				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append read error.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffers onto queues.",
 				 function );
 
-				storage_media_buffer = NULL;
-
-				goto on_error;
+				return( -1 );
 			}
+			storage_media_buffer = NULL;
 		}
-		if( storage_media_buffer_get_data(
-		     storage_media_buffer,
-		     &data,
-		     &data_size,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
-			 function );
+	}
+	while( result != 0 );
 
-			storage_media_buffer = NULL;
+	return( 1 );
+}
 
-			goto on_error;
-		}
-		/* Swap byte pairs
-		 */
-		if( export_handle->swap_byte_pairs == 1 )
+/* Reads groups of storage media buffers from the input
+ * The readers claim the groups of storage media buffers in order of the input, so that the
+ * groups in flight always fit in the output window
+ * Callback function for the reader thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_reader_callback(
+     export_handle_reader_t *reader,
+     export_handle_t *export_handle )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        libcerror_error_t *error                     = NULL;
+        static char *function                        = "export_handle_reader_callback";
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	off64_t storage_media_offset                 = 0;
+	int64_t start_timestamp                      = 0;
+	uint64_t number_of_pending_values            = 0;
+	uint64_t sequence_number                     = 0;
+	uint8_t has_sequence_number                  = 0;
+	int is_done                                  = 0;
+	int result                                   = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	while( export_handle->abort == 0 )
+	{
+		if( export_handle->buffer_limiter != NULL )
 		{
-			if( export_handle_swap_byte_pairs(
-			     export_handle,
-			     data,
-			     storage_media_buffer->processed_size,
-			     &error ) != 1 )
+			if( buffer_limiter_adjust(
+			     export_handle->buffer_limiter,
+			     &error ) == -1 )
 			{
 				libcerror_error_set(
 				 &error,
-				 LIBCERROR_ERROR_DOMAIN_CONVERSION,
-				 LIBCERROR_CONVERSION_ERROR_GENERIC,
-				 "%s: unable to swap byte pairs.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to adjust buffer limiter.",
 				 function );
 
-				storage_media_buffer = NULL;
-
 				goto on_error;
 			}
 		}
-		/* Digest hashes are calcultated after swap
-		 */
-		if( export_handle_update_integrity_hash(
-		     export_handle,
-		     data,
-		     storage_media_buffer->processed_size,
+		if( libcthreads_mutex_grab(
+		     export_handle->reader_mutex,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab reader mutex.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		export_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( export_handle->use_data_chunk_functions != 0 )
+		if( ( export_handle->abort != 0 )
+		 || ( (size64_t) export_handle->read_offset >= export_handle->export_size ) )
 		{
-			if( storage_media_buffer_initialize(
-			     &output_storage_media_buffer,
-			     export_handle->ewf_output_handle,
-			     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
-			     export_handle->output_chunk_size,
-			     &error ) != 1 )
+			is_done = 1;
+		}
+		else
+		{
+			storage_media_offset = export_handle->read_offset;
+			read_size            = export_handle->read_buffer_size;
+
+			if( (size64_t) read_size > ( export_handle->export_size - (size64_t) storage_media_offset ) )
 			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create output storage media buffer.",
-				 function );
+				read_size = (size_t) ( export_handle->export_size - (size64_t) storage_media_offset );
+			}
+			/* The storage media buffers are grabbed while the offset is claimed so that the readers
+			 * do not each hold part of the storage media buffers of a group, and so that a reader
+			 * cannot claim an offset that does not fit in the output window
+			 * Profiling is best effort and does not affect the export
+			 * Grabbing blocks while all the storage media buffers are in flight
+			 */
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
 
-				storage_media_buffer = NULL;
+			result = export_handle_grab_storage_media_buffers(
+			          export_handle,
+			          read_size,
+			          &storage_media_buffer,
+			          &error );
 
-				goto on_error;
+			stage_profiler_add_wait(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_READ,
+			 start_timestamp,
+			 NULL );
+
+			if( result == 1 )
+			{
+				export_handle->read_offset += (off64_t) read_size;
+
+				if( reorder_window_get_next_sequence_number(
+				     export_handle->output_window,
+				     &sequence_number,
+				     &error ) == 1 )
+				{
+					has_sequence_number = 1;
+				}
 			}
 		}
-		write_count = export_handle_write(
-			       export_handle,
-			       storage_media_buffer,
-			       output_storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
+		if( libcthreads_mutex_release(
+		     export_handle->reader_mutex,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write to export handle.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release reader mutex.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
+		if( is_done != 0 )
+		{
+			break;
+		}
+		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 "%s: unable to grab storage media buffers.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		if( has_sequence_number == 0 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media buffer sequence number.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
+		storage_media_buffer->sequence_number = sequence_number;
+
+		/* The storage media offsets are relative to the export offset
 		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
+		if( libewf_handle_seek_offset(
+		     reader->input_handle,
+		     (off64_t) export_handle->export_offset + storage_media_offset,
+		     SEEK_SET,
+		     &error ) == -1 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 storage_media_offset,
+			 storage_media_offset );
 
 			goto on_error;
 		}
-/* TODO: if storage media buffer can be passed on do not release it */
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		read_count = export_handle_read_storage_media_buffers(
+		              export_handle,
+		              reader->input_handle,
+		              storage_media_buffer,
+		              storage_media_offset,
+		              read_size,
+		              &error );
+
+		if( read_count < 0 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
 			 function );
 
 			goto on_error;
 		}
-		storage_media_buffer = NULL;
-
-/* TODO: if storage media buffer can be passed on do not free it */
-		if( output_storage_media_buffer != NULL )
-		{
-			if( storage_media_buffer_free(
-			     &output_storage_media_buffer,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free output storage media buffer.",
-				 function );
-
-				goto on_error;
-			}
-		}
-		element = next_element;
+		stage_profiler_add_sample(
+		 export_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
 
-		if( export_handle->process_status != NULL )
+		if( reorder_window_get_number_of_pending_values(
+		     export_handle->output_window,
+		     &number_of_pending_values,
+		     NULL ) == 1 )
 		{
-			if( process_status_update(
-			     export_handle->process_status,
-			     export_handle->last_offset_hashed,
-			     export_handle->input_media_size,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to update process status.",
-				 function );
-
-				goto on_error;
-			}
+			stage_profiler_add_queue_depth(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_QUEUE_IN_FLIGHT,
+			 number_of_pending_values,
+			 NULL );
 		}
-	}
-	return( 1 );
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
 
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( libcthreads_thread_pool_push(
+		     export_handle->input_process_thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     &error ) == -1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto input process thread pool queue.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
-	}
-/* TODO move to queue */
-	if( output_storage_media_buffer != NULL )
-	{
-		storage_media_buffer_free(
-		 &output_storage_media_buffer,
+		/* Pushing blocks while the queue of the process threads is full
+		 */
+		stage_profiler_add_wait(
+		 export_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_UNPACK,
+		 start_timestamp,
 		 NULL );
+
+		storage_media_buffer = NULL;
+		has_sequence_number  = 0;
 	}
+	return( 1 );
+
+on_error:
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -4908,26 +7042,55 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( reader != NULL )
+	{
+		reader->has_failed = 1;
+	}
 	if( export_handle->abort == 0 )
 	{
 		export_handle_signal_abort(
 		 export_handle,
 		 NULL );
 	}
+	if( storage_media_buffer != NULL )
+	{
+		/* A claimed sequence number is filled in with the storage media buffer
+		 * so that the output window keeps passing on, and releasing, the storage media buffers
+		 */
+		if( has_sequence_number != 0 )
+		{
+			storage_media_buffer->sequence_number = sequence_number;
+
+			if( reorder_window_push(
+			     export_handle->output_window,
+			     storage_media_buffer->sequence_number,
+			     (intptr_t *) storage_media_buffer,
+			     NULL ) == 1 )
+			{
+				storage_media_buffer = NULL;
+			}
+		}
+		if( storage_media_buffer != NULL )
+		{
+			export_handle_release_storage_media_buffers(
+			 export_handle,
+			 storage_media_buffer,
+			 NULL );
+		}
+	}
 	return( -1 );
 }
 
-/* Empties the output list
+/* Reads the input with the readers
  * Returns 1 if successful or -1 on error
  */
-int export_handle_empty_output_list(
+int export_handle_read_input_with_readers(
      export_handle_t *export_handle,
+     size_t process_buffer_size,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "export_handle_empty_output_list";
+	static char *function = "export_handle_read_input_with_readers";
+	int reader_index      = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4940,114 +7103,213 @@ int export_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     export_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( export_handle->readers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing readers.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	if( process_buffer_size == 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid process buffer size value zero or less.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		return( -1 );
+	}
+	export_handle->read_offset      = 0;
+	export_handle->read_buffer_size = process_buffer_size;
 
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     export_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+	if( libcthreads_mutex_initialize(
+	     &( export_handle->reader_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader mutex.",
+		 function );
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( export_handle->reader_thread_pool ),
+	     NULL,
+	     export_handle->number_of_readers,
+	     export_handle->number_of_readers,
+	     (int (*)(intptr_t *, void *)) &export_handle_reader_callback,
+	     (void *) export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader thread pool.",
+		 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_readers;
+	     reader_index++ )
+	{
+		export_handle->readers[ reader_index ].has_failed = 0;
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     export_handle->output_list,
-		     element,
-		     error ) != 1 )
+		if( libcthreads_thread_pool_push(
+		     export_handle->reader_thread_pool,
+		     (intptr_t *) &( export_handle->readers[ reader_index ] ),
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader: %d onto reader thread pool queue.",
+			 function,
+			 reader_index );
 
-			return( -1 );
+			export_handle_signal_abort(
+			 export_handle,
+			 NULL );
+
+			break;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+	}
+	if( libcthreads_thread_pool_join(
+	     &( export_handle->reader_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join reader thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_free(
+	     &( export_handle->reader_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free reader mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( reader_index < export_handle->number_of_readers )
+	{
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < export_handle->number_of_readers;
+	     reader_index++ )
+	{
+		if( export_handle->readers[ reader_index ].has_failed != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: reader: %d unable to read data.",
+			 function,
+			 reader_index );
 
 			return( -1 );
 		}
-		element = next_element;
 	}
 	return( 1 );
+
+on_error:
+	if( export_handle->reader_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->reader_thread_pool ),
+		 NULL );
+	}
+	if( export_handle->reader_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( export_handle->reader_mutex ),
+		 NULL );
+	}
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+/* Releases a storage media buffer that was written by the split raw writer
+ * Callback function for the split raw writer, that is called from the writer threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_split_raw_writer_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_split_raw_writer_release_callback";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     export_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
 /* Exports the input
  * Returns 1 if successful or -1 on error
  */
@@ -5065,17 +7327,23 @@ int export_handle_export_input(
 	size64_t remaining_export_size                      = 0;
 	size_t data_size                                    = 0;
 	size_t process_buffer_size                          = 0;
+	size_t read_buffer_size                             = 0;
 	size_t read_size                                    = 0;
 	ssize_t process_count                               = 0;
 	ssize_t read_count                                  = 0;
 	ssize_t write_count                                 = 0;
 	off64_t input_storage_media_offset                  = 0;
+	int64_t start_timestamp                             = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int result                                          = 0;
 	int status                                          = PROCESS_STATUS_COMPLETED;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t number_of_pending_values                   = 0;
 	int maximum_number_of_queued_items                  = 0;
+	int minimum_number_of_buffers                       = 0;
+	int number_of_group_buffers                         = 1;
+	int number_of_output_group_buffers                  = 0;
 #endif
 
 	if( export_handle == NULL )
@@ -5215,12 +7483,82 @@ int export_handle_export_input(
 		{
 			process_buffer_size = export_handle->process_buffer_size;
 		}
-		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
-	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( export_handle->number_of_threads != 0 )
-	{
-		maximum_number_of_queued_items = 1 + (int) ( EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
+	}
+	export_handle->swap_byte_pairs = swap_byte_pairs;
+
+	if( export_handle_determine_chunk_pass_through(
+	     export_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk data can be passed through.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_determine_parallel_repack(
+	     export_handle,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunks can be repacked in parallel.",
+		 function );
+
+		goto on_error;
+	}
+	/* Without the process threads an input chunk can only be written as a single output chunk
+	 */
+	if( ( export_handle->use_data_chunk_functions != 0 )
+	 && ( export_handle->use_parallel_repack == 0 )
+	 && ( export_handle->input_chunk_size != export_handle->output_chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported output chunk size that differs from the input chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	/* In chunk data mode a storage media buffer holds a single input chunk
+	 * and the chunks are read in groups when they are repacked in parallel
+	 */
+	if( export_handle->use_parallel_repack != 0 )
+	{
+		read_buffer_size = export_handle->repack_group_size;
+	}
+	else if( export_handle->use_data_chunk_functions != 0 )
+	{
+		read_buffer_size = (size_t) export_handle->input_chunk_size;
+	}
+	else
+	{
+		read_buffer_size = process_buffer_size;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads != 0 )
+	{
+		maximum_number_of_queued_items = 1 + (int) ( export_handle->maximum_process_buffers_size / process_buffer_size );
+
+		if( export_handle->use_parallel_repack != 0 )
+		{
+			number_of_group_buffers = (int) ( export_handle->repack_group_size / export_handle->input_chunk_size );
+
+			/* The storage media buffer queue needs to fit at least one group
+			 */
+			if( maximum_number_of_queued_items < number_of_group_buffers )
+			{
+				maximum_number_of_queued_items = number_of_group_buffers;
+			}
+		}
 
 		if( libcthreads_thread_pool_create(
 		     &( export_handle->input_process_thread_pool ),
@@ -5240,10 +7578,14 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( libcthreads_thread_pool_create(
-		     &( export_handle->output_thread_pool ),
-		     NULL,
-		     1,
+		/* The output window has a slot for every storage media buffer in the queue.
+		 * The number of slots must be at least the number of buffers in the storage media
+		 * buffer queue, since every buffer in flight holds a sequence number that was not yet
+		 * output. Both are sized by maximum_number_of_queued_items and must never diverge,
+		 * otherwise reorder_window_push fails with a slot value already set error.
+		 */
+		if( reorder_window_initialize(
+		     &( export_handle->output_window ),
 		     maximum_number_of_queued_items,
 		     (int (*)(intptr_t *, void *)) &export_handle_output_storage_media_buffer_callback,
 		     (void *) export_handle,
@@ -5253,20 +7595,7 @@ int export_handle_export_input(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
-			 function );
-
-			goto on_error;
-		}
-		if( libcdata_list_initialize(
-		     &( export_handle->output_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
+			 "%s: unable to create output window.",
 			 function );
 
 			goto on_error;
@@ -5288,10 +7617,105 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
+		if( export_handle->use_parallel_repack != 0 )
+		{
+			/* Every group that fits in the storage media buffer queue has its output storage media buffers
+			 */
+			number_of_output_group_buffers = (int) ( export_handle->repack_group_size / export_handle->output_chunk_size );
+
+			if( storage_media_buffer_queue_initialize(
+			     &( export_handle->output_storage_media_buffer_queue ),
+			     export_handle->ewf_output_handle,
+			     ( maximum_number_of_queued_items / number_of_group_buffers ) * number_of_output_group_buffers,
+			     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+			     (size_t) export_handle->output_chunk_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output storage media buffer queue.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( export_handle->adapt_number_of_buffers != 0 )
+		{
+			/* Reading starts with a group of storage media buffers per thread and per reader and
+			 * the buffer limiter adds buffers while reading stalls, up to the number of buffers in the queue
+			 */
+			if( export_handle->readers != NULL )
+			{
+				minimum_number_of_buffers = export_handle->number_of_threads + export_handle->number_of_readers;
+			}
+			else
+			{
+				minimum_number_of_buffers = export_handle->number_of_threads + 1;
+			}
+			minimum_number_of_buffers *= number_of_group_buffers;
+
+			if( minimum_number_of_buffers > maximum_number_of_queued_items )
+			{
+				minimum_number_of_buffers = maximum_number_of_queued_items;
+			}
+			if( buffer_limiter_initialize(
+			     &( export_handle->buffer_limiter ),
+			     export_handle->storage_media_buffer_queue,
+			     export_handle->stage_profiler,
+			     minimum_number_of_buffers,
+			     maximum_number_of_queued_items,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize buffer limiter.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+		if( export_handle->split_raw_writer != NULL )
+		{
+			if( split_raw_writer_start(
+			     export_handle->split_raw_writer,
+			     export_handle->number_of_raw_writers,
+			     maximum_number_of_queued_items,
+			     (int (*)(storage_media_buffer_t *, void *)) &export_handle_split_raw_writer_release_callback,
+			     (void *) export_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to start split raw writer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
 	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-	export_handle->swap_byte_pairs = swap_byte_pairs;
+	if( export_handle_get_integrity_hash_from_input(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve integrity hash(es) from input.",
+		 function );
+
+		goto on_error;
+	}
 
 	if( export_handle_initialize_integrity_hash(
 	     export_handle,
@@ -5324,6 +7748,20 @@ int export_handle_export_input(
 
 		goto on_error;
 	}
+	if( process_status_set_stage_profiler(
+	     export_handle->process_status,
+	     export_handle->stage_profiler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status stage profiler.",
+		 function );
+
+		goto on_error;
+	}
 	if( process_status_start(
 	     export_handle->process_status,
 	     error ) != 1 )
@@ -5358,52 +7796,98 @@ int export_handle_export_input(
 	}
 	remaining_export_size = (size64_t) export_handle->export_size;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->readers != NULL )
+	{
+		/* The readers read the input instead of this thread
+		 */
+		if( export_handle_read_input_with_readers(
+		     export_handle,
+		     read_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read input with readers.",
+			 function );
+
+			goto on_error;
+		}
+		remaining_export_size = 0;
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 	while( remaining_export_size > 0 )
 	{
 		if( export_handle->abort != 0 )
 		{
 			break;
 		}
+		read_size = read_buffer_size;
+
+		if( remaining_export_size < read_size )
+		{
+			read_size = (size_t) remaining_export_size;
+		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
-			if( storage_media_buffer_queue_grab_buffer(
-			     export_handle->storage_media_buffer_queue,
-			     &input_storage_media_buffer,
-			     error ) != 1 )
+			if( export_handle->buffer_limiter != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to grab input storage media buffer from queue.",
-				 function );
+				if( buffer_limiter_adjust(
+				     export_handle->buffer_limiter,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to adjust buffer limiter.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
 			}
-			if( input_storage_media_buffer == NULL )
+			/* Grabbing blocks while all the storage media buffers are in flight
+			 */
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			if( export_handle_grab_storage_media_buffers(
+			     export_handle,
+			     read_size,
+			     &input_storage_media_buffer,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing input storage media buffer.",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab input storage media buffers.",
 				 function );
 
 				goto on_error;
 			}
+			stage_profiler_add_wait(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_READ,
+			 start_timestamp,
+			 NULL );
 		}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-		read_size = process_buffer_size;
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
 
-		if( remaining_export_size < read_size )
-		{
-			read_size = (size_t) remaining_export_size;
-		}
-		read_count = storage_media_buffer_read_from_handle(
-		              input_storage_media_buffer,
+		read_count = export_handle_read_storage_media_buffers(
+		              export_handle,
 		              export_handle->input_handle,
+		              input_storage_media_buffer,
+		              input_storage_media_offset,
 		              read_size,
 		              error );
 
@@ -5418,18 +7902,12 @@ int export_handle_export_input(
 
 			goto on_error;
 		}
-		if( read_count == 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unexpected end of data.",
-			 function );
-
-			goto on_error;
-		}
-		input_storage_media_buffer->storage_media_offset = input_storage_media_offset;
+		stage_profiler_add_sample(
+		 export_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
 
 		input_storage_media_offset += read_count;
 		remaining_export_size      -= read_count;
@@ -5437,6 +7915,35 @@ int export_handle_export_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 		if( export_handle->number_of_threads != 0 )
 		{
+			if( reorder_window_get_next_sequence_number(
+			     export_handle->output_window,
+			     &( input_storage_media_buffer->sequence_number ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve storage media buffer sequence number.",
+				 function );
+
+				goto on_error;
+			}
+			if( reorder_window_get_number_of_pending_values(
+			     export_handle->output_window,
+			     &number_of_pending_values,
+			     NULL ) == 1 )
+			{
+				stage_profiler_add_queue_depth(
+				 export_handle->stage_profiler,
+				 STAGE_PROFILER_QUEUE_IN_FLIGHT,
+				 number_of_pending_values,
+				 NULL );
+			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			if( libcthreads_thread_pool_push(
 			     export_handle->input_process_thread_pool,
 			     (intptr_t *) input_storage_media_buffer,
@@ -5451,11 +7958,23 @@ int export_handle_export_input(
 
 				goto on_error;
 			}
+			/* Pushing blocks while the queue of the process threads is full
+			 */
+			stage_profiler_add_wait(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_UNPACK,
+			 start_timestamp,
+			 NULL );
+
 			input_storage_media_buffer = NULL;
 		}
 		else
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 		{
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			process_count = storage_media_buffer_read_process(
 			                 input_storage_media_buffer,
 			                 error );
@@ -5475,6 +7994,13 @@ int export_handle_export_input(
 
 				input_storage_media_buffer->is_corrupted = 1;
 			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_UNPACK,
+			 start_timestamp,
+			 (uint64_t) input_storage_media_buffer->processed_size,
+			 NULL );
+
 			result = storage_media_buffer_is_corrupted(
 			          input_storage_media_buffer,
 			          error );
@@ -5545,6 +8071,10 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			/* Digest hashes are calcultated after swap
 			 */
 			if( export_handle_update_integrity_hash(
@@ -5562,6 +8092,13 @@ int export_handle_export_input(
 
 				goto on_error;
 			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_HASH,
+			 start_timestamp,
+			 (uint64_t) input_storage_media_buffer->processed_size,
+			 NULL );
+
 			export_handle->last_offset_hashed += input_storage_media_buffer->processed_size;
 
 			if( ( export_handle->use_data_chunk_functions != 0 )
@@ -5584,6 +8121,10 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
 			write_count = export_handle_write(
 			               export_handle,
 			               input_storage_media_buffer,
@@ -5602,6 +8143,13 @@ int export_handle_export_input(
 
 				goto on_error;
 			}
+			stage_profiler_add_sample(
+			 export_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_WRITE,
+			 start_timestamp,
+			 (uint64_t) write_count,
+			 NULL );
+
 			if( process_status_update(
 			     export_handle->process_status,
 			     export_handle->last_offset_hashed,
@@ -5668,47 +8216,66 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->output_thread_pool != NULL )
+	if( export_handle->output_window != NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( export_handle->output_thread_pool ),
+		if( export_handle_empty_output_window(
+		     export_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 "%s: unable to empty output window.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( export_handle->output_list != NULL )
-	{
-		if( export_handle_empty_output_list(
-		     export_handle,
+		if( reorder_window_free(
+		     &( export_handle->output_window ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to free output window.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( export_handle->output_list ),
-		     NULL,
+	}
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+	if( export_handle->split_raw_writer != NULL )
+	{
+		/* The storage media buffers are released onto the queue by the writer threads
+		 */
+		if( split_raw_writer_join(
+		     export_handle->split_raw_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to join split raw writer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( export_handle->buffer_limiter != NULL )
+	{
+		if( buffer_limiter_free(
+		     &( export_handle->buffer_limiter ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free buffer limiter.",
 			 function );
 
 			goto on_error;
@@ -5730,6 +8297,22 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
+	if( export_handle->output_storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( export_handle->output_storage_media_buffer_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	if( export_handle_finalize_integrity_hash(
@@ -5882,26 +8465,41 @@ on_error:
 		 NULL );
 	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( input_storage_media_buffer != NULL ) )
+	{
+		export_handle_release_storage_media_buffers(
+		 export_handle,
+		 input_storage_media_buffer,
+		 NULL );
+	}
 	if( export_handle->input_process_thread_pool != NULL )
 	{
 		libcthreads_thread_pool_join(
 		 &( export_handle->input_process_thread_pool ),
 		 NULL );
 	}
-	if( export_handle->output_thread_pool != NULL )
+	if( export_handle->output_window != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( export_handle->output_thread_pool ),
+		export_handle_empty_output_window(
+		 export_handle,
+		 NULL );
+		reorder_window_free(
+		 &( export_handle->output_window ),
 		 NULL );
 	}
-	if( export_handle->output_list != NULL )
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+	if( export_handle->split_raw_writer != NULL )
 	{
-		export_handle_empty_output_list(
-		 export_handle,
+		split_raw_writer_join(
+		 export_handle->split_raw_writer,
 		 NULL );
-		libcdata_list_free(
-		 &( export_handle->output_list ),
-		 NULL,
+	}
+#endif
+	if( export_handle->buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &( export_handle->buffer_limiter ),
 		 NULL );
 	}
 	if( export_handle->storage_media_buffer_queue != NULL )
@@ -5910,6 +8508,12 @@ on_error:
 		 &( export_handle->storage_media_buffer_queue ),
 		 NULL );
 	}
+	if( export_handle->output_storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( export_handle->output_storage_media_buffer_queue ),
+		 NULL );
+	}
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	return( -1 );
@@ -6951,6 +9555,13 @@ int export_handle_hash_values_fprint(
 
 			return( -1 );
 		}
+		if( export_handle->stored_md5_hash_available != 0 )
+		{
+			fprintf(
+			 stream,
+			 "MD5 hash stored in file:\t\t%s\n",
+			 export_handle->stored_md5_hash_string );
+		}
 		fprintf(
 		 stream,
 		 "MD5 hash calculated over data:\t\t%s\n",
@@ -6969,6 +9580,13 @@ int export_handle_hash_values_fprint(
 
 			return( -1 );
 		}
+		if( export_handle->stored_sha1_hash_available != 0 )
+		{
+			fprintf(
+			 stream,
+			 "SHA1 hash stored in file:\t\t%s\n",
+			 export_handle->stored_sha1_hash_string );
+		}
 		fprintf(
 		 stream,
 		 "SHA1 hash calculated over data:\t\t%s\n",
@@ -6987,6 +9605,13 @@ int export_handle_hash_values_fprint(
 
 			return( -1 );
 		}
+		if( export_handle->stored_sha256_hash_available != 0 )
+		{
+			fprintf(
+			 stream,
+			 "SHA256 hash stored in file:\t\t%s\n",
+			 export_handle->stored_sha256_hash_string );
+		}
 		fprintf(
 		 stream,
 		 "SHA256 hash calculated over data:\t%s\n",
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "buffer_limiter.h"
 #include "digest_hash.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
@@ -34,6 +35,9 @@
 #include "ewftools_libsmraw.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "reorder_window.h"
+#include "split_raw_writer.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -47,6 +51,27 @@ enum EXPORT_HANDLE_OUTPUT_FORMATS
 	EXPORT_HANDLE_OUTPUT_FORMAT_RAW		= (int) 'r'
 };
 
+/* The maximum number of readers
+ */
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_READERS	32
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct export_handle_reader export_handle_reader_t;
+
+struct export_handle_reader
+{
+	/* The libewf input handle, that is opened on the same files as the input handle of the export handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* Value to indicate the reader has failed
+	 */
+	uint8_t has_failed;
+};
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 typedef struct export_handle export_handle_t;
 
 struct export_handle
@@ -155,10 +180,47 @@ struct export_handle
 	 */
 	char *calculated_sha256_hash_string;
 
+	/* The MD5 digest hash string stored in the input
+	 */
+	char stored_md5_hash_string[ 33 ];
+
+	/* Value to indicate the stored MD5 digest hash is available
+	 */
+	uint8_t stored_md5_hash_available;
+
+	/* The SHA1 digest hash string stored in the input
+	 */
+	char stored_sha1_hash_string[ 41 ];
+
+	/* Value to indicate the stored SHA1 digest hash is available
+	 */
+	uint8_t stored_sha1_hash_available;
+
+	/* The SHA256 digest hash string stored in the input
+	 */
+	char stored_sha256_hash_string[ 65 ];
+
+	/* Value to indicate the stored SHA256 digest hash is available
+	 */
+	uint8_t stored_sha256_hash_available;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
 
+	/* Value to indicate if the stored chunk data is copied to the output without recompression
+	 */
+	uint8_t use_chunk_pass_through;
+
+	/* Value to indicate if the chunks are repacked for the output by the process threads
+	 */
+	uint8_t use_parallel_repack;
+
+	/* The size of the input data that is repacked as a group by a process thread,
+	 * which is a whole number of input chunks and of output chunks
+	 */
+	size_t repack_group_size;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -167,26 +229,78 @@ struct export_handle
 	 */
 	int number_of_threads;
 
+	/* The number of writer threads of the split raw output, where 0 represents writing the raw output in order
+	 */
+	int number_of_raw_writers;
+
+	/* The number of readers, that read the input in parallel
+	 */
+	int number_of_readers;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The maximum size of the process buffers that can be in flight
+	 */
+	size64_t maximum_process_buffers_size;
+
+	/* Value to indicate the number of storage media buffers in flight should be adapted at runtime
+	 */
+	uint8_t adapt_number_of_buffers;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The input process thread pool
 	 */
 	libcthreads_thread_pool_t *input_process_thread_pool;
 
-	/* The output thread pool
+	/* The output window, that passes the processed storage media buffers on in order
 	 */
-	libcthreads_thread_pool_t *output_thread_pool;
-
-	/* The output list
-	 */
-	libcdata_list_t *output_list;
+	reorder_window_t *output_window;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The buffer limiter, that adapts the number of storage media buffers in flight
+	 */
+	buffer_limiter_t *buffer_limiter;
+
+	/* The output storage media buffer queue, that contains the storage media buffers the chunks are repacked in
+	 */
+	libcthreads_queue_t *output_storage_media_buffer_queue;
+
+	/* The readers
+	 */
+	export_handle_reader_t *readers;
+
+	/* The reader thread pool, that contains a thread per reader
+	 */
+	libcthreads_thread_pool_t *reader_thread_pool;
+
+	/* The reader mutex, that protects the read offset
+	 */
+	libcthreads_mutex_t *reader_mutex;
+
+	/* The offset of the next storage media buffer to read, relative to the export offset
+	 */
+	off64_t read_offset;
+
+	/* The read buffer size
+	 */
+	size_t read_buffer_size;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+	/* The split raw writer, that writes the raw output segment files concurrently
+	 */
+	split_raw_writer_t *split_raw_writer;
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
 	/* The libewf input handle
 	 */
 	libewf_handle_t *input_handle;
@@ -199,6 +313,10 @@ struct export_handle
 	 */
 	uint8_t use_stdout;
 
+	/* Value to indicate if ranges of zero bytes should be left as holes in the raw output
+	 */
+	uint8_t sparse_output;
+
 	/* The libewf output handle
 	 */
 	libewf_handle_t *ewf_output_handle;
@@ -251,6 +369,10 @@ struct export_handle
 	 */
 	process_status_t *process_status;
 
+	/* The stage profiler
+	 */
+	stage_profiler_t *stage_profiler;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -295,6 +417,24 @@ int export_handle_close(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int export_handle_open_readers(
+     export_handle_t *export_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int export_handle_close_readers(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free_readers(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 ssize_t export_handle_read_storage_media_buffer(
          export_handle_t *export_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -302,6 +442,14 @@ ssize_t export_handle_read_storage_media_buffer(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t export_handle_read_storage_media_buffers(
+         export_handle_t *export_handle,
+         libewf_handle_t *input_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         off64_t storage_media_offset,
+         size_t read_size,
+         libcerror_error_t **error );
+
 ssize_t export_handle_prepare_write_storage_media_buffer(
          export_handle_t *export_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -313,6 +461,12 @@ ssize_t export_handle_write_storage_media_buffer(
          size_t write_size,
          libcerror_error_t **error );
 
+ssize_t export_handle_skip_sparse_range(
+         export_handle_t *export_handle,
+         off64_t offset,
+         size_t size,
+         libcerror_error_t **error );
+
 off64_t export_handle_seek_offset(
          export_handle_t *export_handle,
          off64_t offset,
@@ -338,6 +492,14 @@ int export_handle_finalize_integrity_hash(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_get_integrity_hash_from_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_verify_integrity_hash(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_input_is_corrupted(
      export_handle_t *export_handle,
      libcerror_error_t **error );
@@ -347,6 +509,14 @@ int export_handle_get_output_chunk_size(
      size32_t *chunk_size,
      libcerror_error_t **error );
 
+int export_handle_determine_chunk_pass_through(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_determine_parallel_repack(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_prompt_for_string(
      export_handle_t *export_handle,
      const system_character_t *request_string,
@@ -441,6 +611,16 @@ int export_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_number_of_raw_writers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_readers(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int export_handle_set_additional_digest_types(
      export_handle_t *export_handle,
      const system_character_t *string,
@@ -482,6 +662,22 @@ ssize_t export_handle_finalize(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int export_handle_grab_storage_media_buffers(
+     export_handle_t *export_handle,
+     size_t read_size,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+int export_handle_release_storage_media_buffers(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int export_handle_repack_storage_media_buffers(
+     export_handle_t *export_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 int export_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
@@ -490,12 +686,29 @@ int export_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      export_handle_t *export_handle );
 
-int export_handle_empty_output_list(
+int export_handle_empty_output_window(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_reader_callback(
+     export_handle_reader_t *reader,
+     export_handle_t *export_handle );
+
+int export_handle_read_input_with_readers(
      export_handle_t *export_handle,
+     size_t process_buffer_size,
      libcerror_error_t **error );
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+int export_handle_split_raw_writer_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     export_handle_t *export_handle );
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
 int export_handle_export_input(
      export_handle_t *export_handle,
      uint8_t swap_byte_pairs,
@@ -33,7 +33,10 @@
 #include <uuid/uuid.h>
 #endif
 
+#include "buffer_limiter.h"
 #include "byte_size_string.h"
+#include "checkpoint_file.h"
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -42,7 +45,6 @@
 #include "ewftools_libcnotify.h"
 #include "ewftools_libcsplit.h"
 #include "ewftools_libewf.h"
-#include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
 #include "guid.h"
 #include "imaging_handle.h"
@@ -50,11 +52,13 @@
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "system_resources.h"
 
 #define IMAGING_HANDLE_INPUT_BUFFER_SIZE		64
 #define IMAGING_HANDLE_STRING_SIZE			1024
 #define IMAGING_HANDLE_NOTIFY_STREAM			stdout
 #define IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	256 * 1024 * 1024
+#define IMAGING_HANDLE_CHECKPOINT_INTERVAL		( 256 * 1024 * 1024 )
 
 /* Creates an imaging handle
  * Make sure the value imaging_handle is referencing, is set to NULL
@@ -164,6 +168,19 @@ int imaging_handle_initialize(
 
 		goto on_error;
 	}
+	if( stage_profiler_initialize(
+	     &( ( *imaging_handle )->stage_profiler ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stage profiler.",
+		 function );
+
+		goto on_error;
+	}
 	if( calculate_md5 != 0 )
 	{
 		( *imaging_handle )->calculated_md5_hash_string = narrow_string_allocate(
@@ -197,13 +214,20 @@ int imaging_handle_initialize(
 	( *imaging_handle )->notify_stream            = IMAGING_HANDLE_NOTIFY_STREAM;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	( *imaging_handle )->number_of_threads        = 4;
+	( *imaging_handle )->number_of_threads            = 4;
+	( *imaging_handle )->maximum_process_buffers_size = IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE;
 #endif
 	return( 1 );
 
 on_error:
 	if( *imaging_handle != NULL )
 	{
+		if( ( *imaging_handle )->stage_profiler != NULL )
+		{
+			stage_profiler_free(
+			 &( ( *imaging_handle )->stage_profiler ),
+			 NULL );
+		}
 		if( ( *imaging_handle )->output_handle != NULL )
 		{
 			libewf_handle_free(
@@ -286,7 +310,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
-			if( libhmac_md5_free(
+			if( digest_context_free(
 			     &( ( *imaging_handle )->md5_context ),
 			     error ) != 1 )
 			{
@@ -307,7 +331,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( digest_context_free(
 			     &( ( *imaging_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -328,7 +352,7 @@ int imaging_handle_free(
 		}
 		if( ( *imaging_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( digest_context_free(
 			     &( ( *imaging_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -347,6 +371,22 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->calculated_sha256_hash_string );
 		}
+		if( ( *imaging_handle )->checkpoint_file != NULL )
+		{
+			if( checkpoint_file_free(
+			     &( ( *imaging_handle )->checkpoint_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free checkpoint file.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libewf_handle_free(
 		     &( ( *imaging_handle )->output_handle ),
 		     error ) != 1 )
@@ -376,6 +416,19 @@ int imaging_handle_free(
 				result = -1;
 			}
 		}
+		if( stage_profiler_free(
+		     &( ( *imaging_handle )->stage_profiler ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stage profiler.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *imaging_handle );
 
@@ -958,14 +1011,19 @@ on_error:
 	return( -1 );
 }
 
-/* Closes the imaging handle
- * Returns the 0 if successful or -1 on error
+/* Retrieves the length of the target filename without the segment file extension
+ * On resume the target filename contains the segment file extension e.g. image.E01
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_close(
+int imaging_handle_get_target_basename_length(
      imaging_handle_t *imaging_handle,
+     uint8_t resume,
+     size_t *basename_length,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_close";
+	static char *function  = "imaging_handle_get_target_basename_length";
+	size_t filename_length = 0;
+	size_t string_index    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -978,50 +1036,71 @@ int imaging_handle_close(
 
 		return( -1 );
 	}
-	if( libewf_handle_close(
-	     imaging_handle->output_handle,
-	     error ) != 0 )
+	if( ( imaging_handle->target_filename == NULL )
+	 || ( imaging_handle->target_filename_size <= 1 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-		 "%s: unable to close output handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing target filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( basename_length == NULL )
 	{
-		if( libewf_handle_close(
-		     imaging_handle->secondary_output_handle,
-		     error ) != 0 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename length.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = imaging_handle->target_filename_size - 1;
+
+	if( resume != 0 )
+	{
+		string_index = filename_length;
+
+		while( string_index > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close secondary output handle.",
-			 function );
+			string_index--;
 
-			return( -1 );
+			if( ( imaging_handle->target_filename[ string_index ] == (system_character_t) '/' )
+			 || ( imaging_handle->target_filename[ string_index ] == (system_character_t) '\\' ) )
+			{
+				break;
+			}
+			if( imaging_handle->target_filename[ string_index ] == (system_character_t) '.' )
+			{
+				filename_length = string_index;
+
+				break;
+			}
 		}
 	}
-	return( 0 );
+	*basename_length = filename_length;
+
+	return( 1 );
 }
 
-/* Writes a storage media buffer to the output of the imaging handle
- * Returns the number of bytes written or -1 on error
+/* Opens the checkpoint file of the imaging handle
+ * The checkpoint file is stored next to the target using the target filename without extension
+ * When resuming, previously stored checkpoints are read from the checkpoint file
+ * Returns 1 if successful or -1 on error
  */
-ssize_t imaging_handle_write_storage_media_buffer(
-         imaging_handle_t *imaging_handle,
-         storage_media_buffer_t *storage_media_buffer,
-         size_t write_size,
-         libcerror_error_t **error )
+int imaging_handle_open_checkpoint_file(
+     imaging_handle_t *imaging_handle,
+     uint8_t resume,
+     libcerror_error_t **error )
 {
-	static char *function         = "imaging_handle_write_buffer";
-	ssize_t secondary_write_count = 0;
-	ssize_t write_count           = 0;
+	static char *function  = "imaging_handle_open_checkpoint_file";
+	size_t filename_length = 0;
+	uint32_t digest_flags  = 0;
+	int result             = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1034,136 +1113,131 @@ ssize_t imaging_handle_write_storage_media_buffer(
 
 		return( -1 );
 	}
-	write_count = storage_media_buffer_write_to_handle(
-	               storage_media_buffer,
-	               imaging_handle->output_handle,
-	               write_size,
-	               error );
-
-	if( write_count < 0 )
+	if( imaging_handle->checkpoint_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write storage media buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - checkpoint file value already set.",
 		 function );
 
-/* TODO ask for alternative segment file location and try again
-		if( ( error != NULL )
-		 && ( libcerror_error_matches(
-		       *error,
-		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) != 0 ) )
-		{
-			return( -1 );
-		}
-*/
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( imaging_handle_get_target_basename_length(
+	     imaging_handle,
+	     resume,
+	     &filename_length,
+	     error ) != 1 )
 	{
-		secondary_write_count = storage_media_buffer_write_to_handle(
-		                         storage_media_buffer,
-		                         imaging_handle->secondary_output_handle,
-		                         write_size,
-		                         error );
-
-		if( secondary_write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer to secondary output handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve target basename length.",
+		 function );
 
-			if( ( error != NULL )
-			 && ( libcerror_error_matches(
-			       *error,
-			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
-			{
-				return( -1 );
-			}
-/* TODO ask for alternative segment file location and try again */
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( write_count );
-}
-
-/* Seeks the offset in the input file
- * Returns the new offset if successful or -1 on error
- */
-off64_t imaging_handle_seek_offset(
-         imaging_handle_t *imaging_handle,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function    = "imaging_handle_seek_offset";
-	off64_t secondary_offset = 0;
-
-	if( imaging_handle == NULL )
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_MD5;
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_SHA1;
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_SHA256;
+	}
+	if( checkpoint_file_initialize(
+	     &( imaging_handle->checkpoint_file ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create checkpoint file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	offset = libewf_handle_seek_offset(
-	          imaging_handle->output_handle,
-	          offset,
-	          SEEK_SET,
-	          error );
+	if( checkpoint_file_set_filename(
+	     imaging_handle->checkpoint_file,
+	     imaging_handle->target_filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint filename.",
+		 function );
 
-	if( offset == -1 )
+		goto on_error;
+	}
+	if( checkpoint_file_set_values(
+	     imaging_handle->checkpoint_file,
+	     imaging_handle->acquiry_offset,
+	     imaging_handle->acquiry_size,
+	     digest_flags,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in output handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint file values.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( resume != 0 )
 	{
-		secondary_offset = libewf_handle_seek_offset(
-		                    imaging_handle->secondary_output_handle,
-		                    offset,
-		                    SEEK_SET,
-		                    error );
+		result = checkpoint_file_read(
+		          imaging_handle->checkpoint_file,
+		          error );
 
-		if( secondary_offset == -1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_SEEK_FAILED,
-			 "%s: unable to seek offset in secondary output handle.",
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read checkpoint file.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
 	}
-	return( offset );
+	return( 1 );
+
+on_error:
+	if( imaging_handle->checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &( imaging_handle->checkpoint_file ),
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the offset size
- * Returns 1 if successful or -1 on error
+/* Restores the integrity hash(es) from the last checkpoint before the resume acquiry offset
+ * This function should be called after imaging_handle_start
+ * Returns 1 if successful, 0 if no applicable checkpoint is available or -1 on error
  */
-int imaging_handle_get_offset(
+int imaging_handle_restore_checkpoint(
      imaging_handle_t *imaging_handle,
-     off64_t *offset,
+     off64_t resume_acquiry_offset,
+     off64_t *checkpoint_offset,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_get_offset";
+	static char *function = "imaging_handle_restore_checkpoint";
+	uint64_t entry_offset = 0;
+	int result            = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1176,113 +1250,73 @@ int imaging_handle_get_offset(
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( resume_acquiry_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid resume acquiry offset value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_offset(
-	     imaging_handle->output_handle,
-	     offset,
-	     error ) != 1 )
+	if( checkpoint_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint offset.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
+	if( imaging_handle->checkpoint_file == NULL )
+	{
+		return( 0 );
+	}
+	/* The checkpoint cannot be beyond the resume acquiry offset since
+	 * the data after it has not been stored in the output
+	 */
+	result = checkpoint_file_restore_entry(
+	          imaging_handle->checkpoint_file,
+	          (uint64_t) resume_acquiry_offset,
+	          &entry_offset,
+	          imaging_handle->md5_context,
+	          imaging_handle->sha1_context,
+	          imaging_handle->sha256_context,
+	          error );
 
-/* Swaps the byte order of byte pairs within a buffer of a certain size
- * Returns 1 if successful, -1 on error
- */
-int imaging_handle_swap_byte_pairs(
-     imaging_handle_t *imaging_handle,
-     uint8_t *buffer,
-     size_t buffer_size,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_swap_byte_pairs";
-	size_t buffer_offset  = 0;
-	uint8_t byte_value    = 0;
-
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid read size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to restore checkpoint.",
 		 function );
 
 		return( -1 );
 	}
-	/* If the last bit is set the value is odd
-	 */
-	if( ( buffer_size & 0x01 ) != 0 )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: invalid read size value is odd.",
-		 function );
+		imaging_handle->last_offset_written = (off64_t) entry_offset;
+		imaging_handle->last_offset_hashed  = (off64_t) entry_offset;
 
-		return( -1 );
-	}
-	for( buffer_offset = 0;
-	     buffer_offset < buffer_size;
-	     buffer_offset += 2 )
-	{
-		byte_value                  = buffer[ buffer_offset ];
-		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
-		buffer[ buffer_offset + 1 ] = byte_value;
+		*checkpoint_offset = (off64_t) entry_offset;
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Initializes the integrity hash(es)
+/* Updates the checkpoint file if the integrity hash(es) passed a checkpoint interval
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_initialize_integrity_hash(
+int imaging_handle_update_checkpoint(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_initialize_integrity_hash";
+	static char *function = "imaging_handle_update_checkpoint";
 
 	if( imaging_handle == NULL )
 	{
@@ -1295,85 +1329,82 @@ int imaging_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
+	if( imaging_handle->checkpoint_file == NULL )
 	{
-		if( libhmac_md5_initialize(
-		     &( imaging_handle->md5_context ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
-			 function );
-
-			goto on_error;
-		}
-		imaging_handle->md5_context_initialized = 1;
+		return( 1 );
 	}
-	if( imaging_handle->calculate_sha1 != 0 )
+	if( imaging_handle->checkpoint_file->number_of_entries > 0 )
 	{
-		if( libhmac_sha1_initialize(
-		     &( imaging_handle->sha1_context ),
-		     error ) != 1 )
+		if( (uint64_t) imaging_handle->last_offset_hashed < ( imaging_handle->checkpoint_file->entries[ imaging_handle->checkpoint_file->number_of_entries - 1 ].offset + IMAGING_HANDLE_CHECKPOINT_INTERVAL ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
-
-			goto on_error;
+			return( 1 );
 		}
-		imaging_handle->sha1_context_initialized = 1;
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	else if( imaging_handle->last_offset_hashed < IMAGING_HANDLE_CHECKPOINT_INTERVAL )
 	{
-		if( libhmac_sha256_initialize(
-		     &( imaging_handle->sha256_context ),
+		return( 1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_stage != NULL )
+	{
+		/* Wait for the digest threads so that the digest states match the last offset hashed
+		 */
+		if( digest_stage_wait(
+		     imaging_handle->digest_stage,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for digest stage.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		imaging_handle->sha256_context_initialized = 1;
 	}
-	return( 1 );
-
-on_error:
-	if( imaging_handle->sha1_context != NULL )
+#endif
+	if( checkpoint_file_append_entry(
+	     imaging_handle->checkpoint_file,
+	     (uint64_t) imaging_handle->last_offset_hashed,
+	     imaging_handle->md5_context,
+	     imaging_handle->sha1_context,
+	     imaging_handle->sha256_context,
+	     error ) != 1 )
 	{
-		libhmac_sha1_free(
-		 &( imaging_handle->sha1_context ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append checkpoint.",
+		 function );
+
+		return( -1 );
 	}
-	if( imaging_handle->md5_context != NULL )
+	if( checkpoint_file_write(
+	     imaging_handle->checkpoint_file,
+	     error ) != 1 )
 	{
-		libhmac_md5_free(
-		 &( imaging_handle->md5_context ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoint file.",
+		 function );
+
+		return( -1 );
 	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Updates the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Closes the imaging handle
+ * Returns the 0 if successful or -1 on error
  */
-int imaging_handle_update_integrity_hash(
+int imaging_handle_close(
      imaging_handle_t *imaging_handle,
-     const uint8_t *buffer,
-     size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_update_integrity_hash";
+	static char *function = "imaging_handle_close";
 
 	if( imaging_handle == NULL )
 	{
@@ -1386,98 +1417,50 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	if( libewf_handle_close(
+	     imaging_handle->output_handle,
+	     error ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_update(
-		     imaging_handle->md5_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update MD5 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
-	{
-		if( libhmac_sha1_update(
-		     imaging_handle->sha1_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA1 digest hash.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( imaging_handle->secondary_output_handle != NULL )
 	{
-		if( libhmac_sha256_update(
-		     imaging_handle->sha256_context,
-		     buffer,
-		     buffer_size,
-		     error ) != 1 )
+		if( libewf_handle_close(
+		     imaging_handle->secondary_output_handle,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to update SHA256 digest hash.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close secondary output handle.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	return( 1 );
+	return( 0 );
 }
 
-/* Finalizes the integrity hash(es)
- * Returns 1 if successful or -1 on error
+/* Writes a storage media buffer to the output of the imaging handle
+ * Returns the number of bytes written or -1 on error
  */
-int imaging_handle_finalize_integrity_hash(
-     imaging_handle_t *imaging_handle,
-     libcerror_error_t **error )
+ssize_t imaging_handle_write_storage_media_buffer(
+         imaging_handle_t *imaging_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t write_size,
+         libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
-
-	static char *function = "imaging_handle_finalize_integrity_hash";
+	static char *function         = "imaging_handle_write_buffer";
+	ssize_t secondary_write_count = 0;
+	ssize_t write_count           = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1490,124 +1473,75 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
-	if( imaging_handle->calculate_md5 != 0 )
-	{
-		if( libhmac_md5_finalize(
-		     imaging_handle->md5_context,
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize MD5 hash.",
-			 function );
+	write_count = storage_media_buffer_write_to_handle(
+	               storage_media_buffer,
+	               imaging_handle->output_handle,
+	               write_size,
+	               error );
 
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
-		     imaging_handle->calculated_md5_hash_string,
-		     33,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set calculated MD5 hash string.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( imaging_handle->calculate_sha1 != 0 )
+	if( write_count < 0 )
 	{
-		if( libhmac_sha1_finalize(
-		     imaging_handle->sha1_context,
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA1 hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
 
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
-		     imaging_handle->calculated_sha1_hash_string,
-		     41,
-		     error ) != 1 )
+/* TODO ask for alternative segment file location and try again
+		if( ( error != NULL )
+		 && ( libcerror_error_matches(
+		       *error,
+		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) != 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA1 hash string.",
-			 function );
-
 			return( -1 );
 		}
+*/
+		return( -1 );
 	}
-	if( imaging_handle->calculate_sha256 != 0 )
+	if( imaging_handle->secondary_output_handle != NULL )
 	{
-		if( libhmac_sha256_finalize(
-		     imaging_handle->sha256_context,
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to finalize SHA256 hash.",
-			 function );
+		secondary_write_count = storage_media_buffer_write_to_handle(
+		                         storage_media_buffer,
+		                         imaging_handle->secondary_output_handle,
+		                         write_size,
+		                         error );
 
-			return( -1 );
-		}
-		if( digest_hash_copy_to_string(
-		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     imaging_handle->calculated_sha256_hash_string,
-		     65,
-		     error ) != 1 )
+		if( secondary_write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create calculated SHA256 hash string.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
 			 function );
 
+			if( ( error != NULL )
+			 && ( libcerror_error_matches(
+			       *error,
+			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
+			{
+				return( -1 );
+			}
+/* TODO ask for alternative segment file location and try again */
 			return( -1 );
 		}
 	}
-	return( 1 );
+	return( write_count );
 }
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-
-/* Starts the threads
- * Returns 1 if successful or -1 on error
+/* Seeks the offset in the input file
+ * Returns the new offset if successful or -1 on error
  */
-int imaging_handle_threads_start(
-     imaging_handle_t *imaging_handle,
-     size_t process_buffer_size,
-     uint8_t storage_media_buffer_mode,
-     libcerror_error_t **error )
+off64_t imaging_handle_seek_offset(
+         imaging_handle_t *imaging_handle,
+         off64_t offset,
+         libcerror_error_t **error )
 {
-	static char *function              = "imaging_handle_threads_start";
-	int maximum_number_of_queued_items = 0;
+	static char *function    = "imaging_handle_seek_offset";
+	off64_t secondary_offset = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1620,117 +1554,107 @@ int imaging_handle_threads_start(
 
 		return( -1 );
 	}
-	maximum_number_of_queued_items = 1 + (int) ( IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
+	offset = libewf_handle_seek_offset(
+	          imaging_handle->output_handle,
+	          offset,
+	          SEEK_SET,
+	          error );
 
-	if( libcthreads_thread_pool_create(
-	     &( imaging_handle->process_thread_pool ),
-	     NULL,
-	     imaging_handle->number_of_threads,
-	     maximum_number_of_queued_items,
-	     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
-	     (void *) imaging_handle,
-	     error ) != 1 )
+	if( offset == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize process thread pool.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset in output handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcthreads_thread_pool_create(
-	     &( imaging_handle->output_thread_pool ),
-	     NULL,
-	     1,
-	     maximum_number_of_queued_items,
-	     (int (*)(intptr_t *, void *)) &imaging_handle_output_storage_media_buffer_callback,
-	     (void *) imaging_handle,
-	     error ) != 1 )
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		secondary_offset = libewf_handle_seek_offset(
+		                    imaging_handle->secondary_output_handle,
+		                    offset,
+		                    SEEK_SET,
+		                    error );
+
+		if( secondary_offset == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( offset );
+}
+
+/* Retrieves the offset size
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_get_offset(
+     imaging_handle_t *imaging_handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_get_offset";
+
+	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize output thread pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_list_initialize(
-	     &( imaging_handle->output_list ),
-	     error ) != 1 )
+	if( offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create output list.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( storage_media_buffer_queue_initialize(
-	     &( imaging_handle->storage_media_buffer_queue ),
+	if( libewf_handle_get_offset(
 	     imaging_handle->output_handle,
-	     maximum_number_of_queued_items,
-	     storage_media_buffer_mode,
-	     process_buffer_size,
+	     offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize storage media buffer queue.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	return( 1 );
-
-on_error:
-	if( imaging_handle->process_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->process_thread_pool ),
-		 NULL );
-	}
-	if( imaging_handle->output_thread_pool != NULL )
-	{
-		libcthreads_thread_pool_join(
-		 &( imaging_handle->output_thread_pool ),
-		 NULL );
-	}
-	if( imaging_handle->output_list != NULL )
-	{
-		imaging_handle_empty_output_list(
-		 imaging_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( imaging_handle->output_list ),
-		 NULL,
-		 NULL );
-	}
-	if( imaging_handle->storage_media_buffer_queue != NULL )
-	{
-		storage_media_buffer_queue_free(
-		 &( imaging_handle->storage_media_buffer_queue ),
-		 NULL );
-	}
-	return( -1 );
 }
 
-/* Stops the threads
- * Returns 1 if successful or -1 on error
+/* Swaps the byte order of byte pairs within a buffer of a certain size
+ * Returns 1 if successful, -1 on error
  */
-int imaging_handle_threads_stop(
+int imaging_handle_swap_byte_pairs(
      imaging_handle_t *imaging_handle,
+     uint8_t *buffer,
+     size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_threads_stop";
-	int result            = 1;
+	static char *function = "imaging_handle_swap_byte_pairs";
+	size_t buffer_offset  = 0;
+	uint8_t byte_value    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1743,207 +1667,220 @@ int imaging_handle_threads_stop(
 
 		return( -1 );
 	}
-	if( imaging_handle->process_thread_pool != NULL )
+	if( buffer == NULL )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->process_thread_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-			result = -1;
-		}
+		return( -1 );
 	}
-	if( imaging_handle->output_thread_pool != NULL )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( imaging_handle->output_thread_pool ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* If the last bit is set the value is odd
+	 */
+	if( ( buffer_size & 0x01 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid read size value is odd.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < buffer_size;
+	     buffer_offset += 2 )
+	{
+		byte_value                  = buffer[ buffer_offset ];
+		buffer[ buffer_offset ]     = buffer[ buffer_offset + 1 ];
+		buffer[ buffer_offset + 1 ] = byte_value;
+	}
+	return( 1 );
+}
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_initialize_integrity_hash";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->calculate_md5 != 0 )
+	{
+		if( digest_context_initialize(
+		     &( imaging_handle->md5_context ),
+		     DIGEST_CONTEXT_TYPE_MD5,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
 			 function );
 
-			result = -1;
+			goto on_error;
+		}
+		if( digest_context_set_backend(
+		     imaging_handle->md5_context,
+		     imaging_handle->hash_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 context backend.",
+			 function );
+
+			goto on_error;
 		}
+		imaging_handle->md5_context_initialized = 1;
 	}
-	if( imaging_handle->output_list != NULL )
+	if( imaging_handle->calculate_sha1 != 0 )
 	{
-		if( imaging_handle_empty_output_list(
-		     imaging_handle,
+		if( digest_context_initialize(
+		     &( imaging_handle->sha1_context ),
+		     DIGEST_CONTEXT_TYPE_SHA1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( imaging_handle->output_list ),
-		     NULL,
+		if( digest_context_set_backend(
+		     imaging_handle->sha1_context,
+		     imaging_handle->hash_backend,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 context backend.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
+		imaging_handle->sha1_context_initialized = 1;
 	}
-	if( imaging_handle->storage_media_buffer_queue != NULL )
+	if( imaging_handle->calculate_sha256 != 0 )
 	{
-		if( storage_media_buffer_queue_free(
-		     &( imaging_handle->storage_media_buffer_queue ),
+		if( digest_context_initialize(
+		     &( imaging_handle->sha256_context ),
+		     DIGEST_CONTEXT_TYPE_SHA256,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
 			 function );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	return( result );
-}
-
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
- */
-int imaging_handle_process_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     imaging_handle_t *imaging_handle )
-{
-        libcerror_error_t *error = NULL;
-        static char *function    = "imaging_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
-
-	if( storage_media_buffer == NULL )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
-		 function );
-
-		goto on_error;
-	}
-	if( imaging_handle->abort != 0 )
-	{
-		return( 1 );
-	}
-	process_count = storage_media_buffer_write_process(
-			 storage_media_buffer,
-			 &error );
-
-	if( process_count < 0 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to prepare storage media buffer before write.",
-		 function );
-
-		goto on_error;
-	}
-	if( libcthreads_thread_pool_push(
-	     imaging_handle->output_thread_pool,
-	     (intptr_t *) storage_media_buffer,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
-		 function );
-
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
-
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
-	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( digest_context_set_backend(
+		     imaging_handle->sha256_context,
+		     imaging_handle->hash_backend,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 context backend.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
+		imaging_handle->sha256_context_initialized = 1;
 	}
-	if( error != NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_stage != NULL )
 	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		if( imaging_handle_append_digest_stage_digests(
+		     imaging_handle,
+		     error ) != 1 )
 		{
-			libcnotify_print_error_backtrace(
-			 error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digests to digest stage.",
+			 function );
+
+			goto on_error;
 		}
+	}
 #endif
-		libcerror_error_free(
-		 &error );
+	return( 1 );
+
+on_error:
+	if( imaging_handle->sha1_context != NULL )
+	{
+		digest_context_free(
+		 &( imaging_handle->sha1_context ),
+		 NULL );
 	}
-	if( imaging_handle->abort == 0 )
+	if( imaging_handle->md5_context != NULL )
 	{
-		imaging_handle_signal_abort(
-		 imaging_handle,
+		digest_context_free(
+		 &( imaging_handle->md5_context ),
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for writing to image file
- * Callback function for the process thread pool
+/* Updates the integrity hash(es)
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_output_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     imaging_handle_t *imaging_handle )
+int imaging_handle_update_integrity_hash(
+     imaging_handle_t *imaging_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-        static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
-	int result                            = 0;
+	static char *function = "imaging_handle_update_integrity_hash";
 
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid imaging handle.",
@@ -1951,261 +1888,98 @@ int imaging_handle_output_storage_media_buffer_callback(
 
 		return( -1 );
 	}
-	if( storage_media_buffer == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->abort != 0 )
-	{
-		return( 1 );
-	}
-	if( libcdata_list_insert_value(
-	     imaging_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	storage_media_buffer = NULL;
-
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	if( imaging_handle->calculate_md5 != 0 )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		goto on_error;
-	}
-	while( element != NULL )
-	{
-		if( imaging_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( storage_media_buffer == NULL )
+		if( digest_context_update(
+		     imaging_handle->md5_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update MD5 digest hash.",
 			 function );
 
 			return( -1 );
 		}
-		if( storage_media_buffer->storage_media_offset != imaging_handle->last_offset_written )
-		{
-			break;
-		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     &error ) != 1 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
-
-			goto on_error;
-		}
-		element = next_element;
-
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( digest_context_update(
+		     imaging_handle->sha1_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA1 digest hash.",
 			 function );
 
-			goto on_error;
-		}
-		storage_media_buffer = NULL;
-
-		if( imaging_handle->process_status != NULL )
-		{
-			if( imaging_handle->acquiry_size == 0 )
-			{
-				result = process_status_update_unknown_total(
-				          imaging_handle->process_status,
-				          imaging_handle->last_offset_written,
-				          &error );
-			}
-			else
-			{
-				result = process_status_update(
-				          imaging_handle->process_status,
-				          imaging_handle->last_offset_written,
-				          imaging_handle->acquiry_size,
-				          &error );
-			}
-			if( result != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to update process status.",
-				 function );
-
-				goto on_error;
-			}
+			return( -1 );
 		}
 	}
-	return( 1 );
-
-on_error:
-	if( storage_media_buffer != NULL )
+	if( imaging_handle->calculate_sha256 != 0 )
 	{
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     &error ) != 1 )
+		if( digest_context_update(
+		     imaging_handle->sha256_context,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update SHA256 digest hash.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
-		}
-	}
-	if( error != NULL )
-	{
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_print_error_backtrace(
-			 error );
+			return( -1 );
 		}
-#endif
-		libcerror_error_free(
-		 &error );
-	}
-	if( imaging_handle->abort == 0 )
-	{
-		imaging_handle_signal_abort(
-		 imaging_handle,
-		 NULL );
 	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Empties the output list
+/* Finalizes the integrity hash(es)
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_empty_output_list(
+int imaging_handle_finalize_integrity_hash(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "imaging_handle_empty_output_list";
+	uint8_t calculated_md5_hash[ DIGEST_CONTEXT_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ DIGEST_CONTEXT_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ DIGEST_CONTEXT_SHA256_HASH_SIZE ];
+
+	static char *function = "imaging_handle_finalize_integrity_hash";
 
 	if( imaging_handle == NULL )
 	{
@@ -2218,125 +1992,126 @@ int imaging_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     imaging_handle->output_list,
-	     &element,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
-		 function );
-
-		return( -1 );
-	}
-	while( element != NULL )
+	if( imaging_handle->calculate_md5 != 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
+		if( digest_context_finalize(
+		     imaging_handle->md5_context,
+		     calculated_md5_hash,
+		     DIGEST_CONTEXT_MD5_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize MD5 hash.",
 			 function );
 
 			return( -1 );
 		}
-		if( storage_media_buffer == NULL )
+		if( digest_hash_copy_to_string(
+		     calculated_md5_hash,
+		     DIGEST_CONTEXT_MD5_HASH_SIZE,
+		     imaging_handle->calculated_md5_hash_string,
+		     33,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
+			 LIBEWF_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set calculated MD5 hash string.",
 			 function );
 
 			return( -1 );
 		}
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+	}
+	if( imaging_handle->calculate_sha1 != 0 )
+	{
+		if( digest_context_finalize(
+		     imaging_handle->sha1_context,
+		     calculated_sha1_hash,
+		     DIGEST_CONTEXT_SHA1_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA1 hash.",
 			 function );
 
 			return( -1 );
 		}
-		storage_media_buffer = NULL;
-
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+		if( digest_hash_copy_to_string(
+		     calculated_sha1_hash,
+		     DIGEST_CONTEXT_SHA1_HASH_SIZE,
+		     imaging_handle->calculated_sha1_hash_string,
+		     41,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA1 hash string.",
 			 function );
 
 			return( -1 );
 		}
-		if( libcdata_list_remove_element(
-		     imaging_handle->output_list,
-		     element,
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( digest_context_finalize(
+		     imaging_handle->sha256_context,
+		     calculated_sha256_hash,
+		     DIGEST_CONTEXT_SHA256_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize SHA256 hash.",
 			 function );
 
 			return( -1 );
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+		if( digest_hash_copy_to_string(
+		     calculated_sha256_hash,
+		     DIGEST_CONTEXT_SHA256_HASH_SIZE,
+		     imaging_handle->calculated_sha256_hash_string,
+		     65,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create calculated SHA256 hash string.",
 			 function );
 
 			return( -1 );
 		}
-		element = next_element;
 	}
 	return( 1 );
 }
 
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Retrieves the process buffer size
+/* Starts the threads
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_get_process_buffer_size(
+int imaging_handle_threads_start(
      imaging_handle_t *imaging_handle,
-     uint8_t use_data_chunk_functions,
-     size_t *process_buffer_size,
+     size_t process_buffer_size,
+     uint8_t storage_media_buffer_mode,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_get_process_buffer_size";
-	uint32_t chunk_size   = 0;
+	static char *function                 = "imaging_handle_threads_start";
+	size64_t maximum_process_buffers_size = 0;
+	int maximum_number_of_queued_items    = 0;
+	int minimum_number_of_buffers         = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -2349,186 +2124,290 @@ int imaging_handle_get_process_buffer_size(
 
 		return( -1 );
 	}
-	if( process_buffer_size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid process buffer size.",
-		 function );
+	maximum_process_buffers_size = imaging_handle->maximum_process_buffers_size;
 
-		return( -1 );
-	}
-	if( libewf_handle_get_chunk_size(
-	     imaging_handle->output_handle,
-	     &chunk_size,
-	     error ) != 1 )
+	if( imaging_handle->process_pool != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve output chunk size.",
-		 function );
+		/* The handle gets its share of the memory budget of the shared process pool,
+		 * which bounds the storage media buffers it can have in flight
+		 */
+		if( process_pool_get_client_buffers_size(
+		     imaging_handle->process_pool,
+		     &maximum_process_buffers_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve process pool client buffers size.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( chunk_size == 0 )
+	maximum_number_of_queued_items = 1 + (int) ( maximum_process_buffers_size / process_buffer_size );
+
+	if( imaging_handle->process_pool != NULL )
+	{
+		if( process_pool_client_initialize(
+		     &( imaging_handle->process_pool_client ),
+		     imaging_handle->process_pool,
+		     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
+		     (void *) imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process pool client.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( libcthreads_thread_pool_create(
+	          &( imaging_handle->process_thread_pool ),
+	          NULL,
+	          imaging_handle->number_of_threads,
+	          maximum_number_of_queued_items,
+	          (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer_callback,
+	          (void *) imaging_handle,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize process thread pool.",
 		 function );
 
-		return( -1 );
-	}
-	if( use_data_chunk_functions != 0 )
-	{
-		*process_buffer_size = (size_t) chunk_size;
-	}
-	else if( imaging_handle->process_buffer_size == 0 )
-	{
-		*process_buffer_size = (size_t) chunk_size;
-	}
-	else
-	{
-		*process_buffer_size = imaging_handle->process_buffer_size;
+		goto on_error;
 	}
-	return( 1 );
-}
-
-/* Prompts the user for a string
- * Returns 1 if successful, 0 if no input was provided or -1 on error
- */
-int imaging_handle_prompt_for_string(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     system_character_t **internal_string,
-     size_t *internal_string_size,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_prompt_for_string";
-	int result            = 0;
-
-	if( imaging_handle == NULL )
+	/* The output window has a slot for every storage media buffer in the queue.
+	 * The number of slots must be at least the number of buffers in the storage media
+	 * buffer queue, since every buffer in flight holds a sequence number that was not yet
+	 * output. Both are sized by maximum_number_of_queued_items and must never diverge,
+	 * otherwise reorder_window_push fails with a slot value already set error.
+	 */
+	if( reorder_window_initialize(
+	     &( imaging_handle->output_window ),
+	     maximum_number_of_queued_items,
+	     (int (*)(intptr_t *, void *)) &imaging_handle_output_storage_media_buffer_callback,
+	     (void *) imaging_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output window.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_string == NULL )
+	if( storage_media_buffer_queue_initialize(
+	     &( imaging_handle->storage_media_buffer_queue ),
+	     imaging_handle->output_handle,
+	     maximum_number_of_queued_items,
+	     storage_media_buffer_mode,
+	     process_buffer_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize storage media buffer queue.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_string_size == NULL )
+	if( imaging_handle->adapt_number_of_buffers != 0 )
+	{
+		/* Reading starts with a storage media buffer per thread and the buffer limiter
+		 * adds buffers while reading stalls, up to the number of buffers in the queue
+		 */
+		minimum_number_of_buffers = imaging_handle->number_of_threads + 1;
+
+		if( minimum_number_of_buffers > maximum_number_of_queued_items )
+		{
+			minimum_number_of_buffers = maximum_number_of_queued_items;
+		}
+		if( buffer_limiter_initialize(
+		     &( imaging_handle->buffer_limiter ),
+		     imaging_handle->storage_media_buffer_queue,
+		     imaging_handle->stage_profiler,
+		     minimum_number_of_buffers,
+		     maximum_number_of_queued_items,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize buffer limiter.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The digest threads are created when the integrity hash(es) are initialized
+	 */
+	if( digest_stage_initialize(
+	     &( imaging_handle->digest_stage ),
+	     maximum_number_of_queued_items,
+	     (int (*)(intptr_t *, void *)) &imaging_handle_digest_stage_release_callback,
+	     (void *) imaging_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize digest stage.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( *internal_string != NULL )
+	if( digest_stage_set_stage_profiler(
+	     imaging_handle->digest_stage,
+	     imaging_handle->stage_profiler,
+	     error ) != 1 )
 	{
-		memory_free(
-		 *internal_string );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set digest stage profiler.",
+		 function );
 
-		*internal_string      = NULL;
-		*internal_string_size = 0;
+		goto on_error;
 	}
-	*internal_string_size = IMAGING_HANDLE_STRING_SIZE;
-
-	*internal_string = system_string_allocate(
-	                    *internal_string_size );
-
-	if( *internal_string == NULL )
+	/* Every output handle is written by its own thread, so that writing to separate
+	 * targets is not limited by the sum of their write latencies
+	 */
+	if( write_stage_initialize(
+	     &( imaging_handle->write_stage ),
+	     maximum_number_of_queued_items,
+	     (int (*)(intptr_t *, uint8_t, void *)) &imaging_handle_write_stage_release_callback,
+	     (void *) imaging_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create internal string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize write stage.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_set(
-	     *internal_string,
-	     0,
-	     *internal_string_size ) == NULL )
+	if( write_stage_set_stage_profiler(
+	     imaging_handle->write_stage,
+	     imaging_handle->stage_profiler,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear internal string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write stage profiler.",
 		 function );
 
 		goto on_error;
 	}
-	result = ewfinput_get_string_variable(
-	          imaging_handle->notify_stream,
-	          request_string,
-	          *internal_string,
-	          *internal_string_size,
-	          error );
-
-	if( result == -1 )
+	if( write_stage_append_output(
+	     imaging_handle->write_stage,
+	     (intptr_t *) imaging_handle->output_handle,
+	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &imaging_handle_write_stage_write_callback,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve string variable.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append output to write stage.",
 		 function );
 
 		goto on_error;
 	}
-	return( result );
-
-on_error:
-	if( *internal_string != NULL )
+	if( imaging_handle->secondary_output_handle != NULL )
 	{
-		memory_free(
-		 *internal_string );
+		if( write_stage_append_output(
+		     imaging_handle->write_stage,
+		     (intptr_t *) imaging_handle->secondary_output_handle,
+		     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &imaging_handle_write_stage_write_callback,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append secondary output to write stage.",
+			 function );
 
-		*internal_string = NULL;
+			goto on_error;
+		}
 	}
-	*internal_string_size = 0;
+	return( 1 );
 
+on_error:
+	if( imaging_handle->write_stage != NULL )
+	{
+		write_stage_free(
+		 &( imaging_handle->write_stage ),
+		 NULL );
+	}
+	if( imaging_handle->digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &( imaging_handle->digest_stage ),
+		 NULL );
+	}
+	if( imaging_handle->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( imaging_handle->process_thread_pool ),
+		 NULL );
+	}
+	if( imaging_handle->process_pool_client != NULL )
+	{
+		process_pool_client_free(
+		 &( imaging_handle->process_pool_client ),
+		 NULL );
+	}
+	if( imaging_handle->output_window != NULL )
+	{
+		reorder_window_free(
+		 &( imaging_handle->output_window ),
+		 NULL );
+	}
+	if( imaging_handle->buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &( imaging_handle->buffer_limiter ),
+		 NULL );
+	}
+	if( imaging_handle->storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( imaging_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Prompts the user for the compression method
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Stops the threads
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_compression_method(
+int imaging_handle_threads_stop(
      imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_compression_method";
-	uint8_t compression_methods_amount        = 0;
-	int result                                = 0;
+	static char *function = "imaging_handle_threads_stop";
+	int result            = 1;
 
 	if( imaging_handle == NULL )
 	{
@@ -2541,137 +2420,174 @@ int imaging_handle_prompt_for_compression_method(
 
 		return( -1 );
 	}
-	if( imaging_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+	/* The digest stage is joined first since it pushes the storage media buffers
+	 * onto the process thread pool
+	 */
+	if( imaging_handle->digest_stage != NULL )
 	{
-		compression_methods_amount = 1;
+		if( digest_stage_join(
+		     imaging_handle->digest_stage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest stage.",
+			 function );
+
+			result = -1;
+		}
+		if( digest_stage_free(
+		     &( imaging_handle->digest_stage ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest stage.",
+			 function );
+
+			result = -1;
+		}
 	}
-	else
+	if( imaging_handle->process_thread_pool != NULL )
 	{
-		compression_methods_amount = EWFINPUT_COMPRESSION_METHODS_AMOUNT;
-	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_compression_methods,
-	          compression_methods_amount,
-	          EWFINPUT_COMPRESSION_METHODS_DEFAULT,
-	          &fixed_string_variable,
-	          error );
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
 
-	if( result == -1 )
+			result = -1;
+		}
+	}
+	if( imaging_handle->process_pool_client != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
-		 function );
+		if( process_pool_client_free(
+		     &( imaging_handle->process_pool_client ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free process pool client.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	else if( result != 0 )
+	if( imaging_handle->output_window != NULL )
 	{
-		result = ewfinput_determine_compression_method(
-			  fixed_string_variable,
-			  &( imaging_handle->compression_method ),
-			  error );
+		if( imaging_handle_empty_output_window(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty output window.",
+			 function );
 
-		if( result == -1 )
+			result = -1;
+		}
+		if( reorder_window_free(
+		     &( imaging_handle->output_window ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine compression method.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output window.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
-	return( result );
-}
-
-/* Prompts the user for the compression level
- * Returns 1 if successful, 0 if no input was provided or -1 on error
- */
-int imaging_handle_prompt_for_compression_level(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
-{
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_compression_level";
-	int result                                = 0;
-
-	if( imaging_handle == NULL )
+	/* The write stage is joined after the output window was emptied since
+	 * the output window pushes the storage media buffers onto the write stage
+	 */
+	if( imaging_handle->write_stage != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
+		if( write_stage_join(
+		     imaging_handle->write_stage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join write stage.",
+			 function );
 
-		return( -1 );
-	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_compression_levels,
-	          EWFINPUT_COMPRESSION_LEVELS_AMOUNT,
-	          EWFINPUT_COMPRESSION_LEVELS_DEFAULT,
-	          &fixed_string_variable,
-	          error );
+			result = -1;
+		}
+		if( write_stage_free(
+		     &( imaging_handle->write_stage ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write stage.",
+			 function );
 
-	if( result == -1 )
+			result = -1;
+		}
+	}
+	if( imaging_handle->buffer_limiter != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
-		 function );
+		if( buffer_limiter_free(
+		     &( imaging_handle->buffer_limiter ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffer limiter.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	else if( result != 0 )
+	if( imaging_handle->storage_media_buffer_queue != NULL )
 	{
-		result = ewfinput_determine_compression_values(
-			  fixed_string_variable,
-			  &( imaging_handle->compression_level ),
-			  &( imaging_handle->compression_flags ),
-			  error );
-
-		if( result == -1 )
+		if( storage_media_buffer_queue_free(
+		     &( imaging_handle->storage_media_buffer_queue ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine compression values.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
 	}
 	return( result );
 }
 
-/* Prompts the user for the format
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Appends the digests of the integrity hash(es) to the digest stage
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_format(
+int imaging_handle_append_digest_stage_digests(
      imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_format";
-	int result                                = 0;
+	static char *function = "imaging_handle_append_digest_stage_digests";
 
 	if( imaging_handle == NULL )
 	{
@@ -2684,227 +2600,329 @@ int imaging_handle_prompt_for_format(
 
 		return( -1 );
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_format_types,
-	          EWFINPUT_FORMAT_TYPES_AMOUNT,
-	          EWFINPUT_FORMAT_TYPES_DEFAULT,
-	          &fixed_string_variable,
-	          error );
-
-	if( result == -1 )
+	if( imaging_handle->calculate_md5 != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
-		 function );
+		if( digest_stage_append_digest(
+		     imaging_handle->digest_stage,
+		     (intptr_t *) imaging_handle->md5_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MD5 digest.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
 	}
-	else if( result != 0 )
+	if( imaging_handle->calculate_sha1 != 0 )
 	{
-		result = ewfinput_determine_ewf_format(
-			  fixed_string_variable,
-			  &( imaging_handle->ewf_format ),
-			  error );
+		if( digest_stage_append_digest(
+		     imaging_handle->digest_stage,
+		     (intptr_t *) imaging_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA1 digest.",
+			 function );
 
-		if( result != 1 )
+			return( -1 );
+		}
+	}
+	if( imaging_handle->calculate_sha256 != 0 )
+	{
+		if( digest_stage_append_digest(
+		     imaging_handle->digest_stage,
+		     (intptr_t *) imaging_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine format.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA256 digest.",
 			 function );
 
 			return( -1 );
 		}
 	}
-	return( result );
+	return( 1 );
 }
 
-/* Prompts the user for the media type
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Passes a storage media buffer, of which the integrity hash(es) were updated, on to the process thread pool
+ * Callback function for the digest stage
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_media_type(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
+int imaging_handle_digest_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_media_type";
-	uint8_t default_value                     = 0;
-	int result                                = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_digest_stage_release_callback";
 
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid imaging handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_REMOVABLE )
+	if( storage_media_buffer == NULL )
 	{
-		default_value = 1;
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
 	}
-	else if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_OPTICAL )
+	if( imaging_handle->process_pool_client != NULL )
 	{
-		default_value = 2;
+		if( process_pool_client_push(
+		     imaging_handle->process_pool_client,
+		     (intptr_t *) storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto process pool.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	else if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_MEMORY )
-	{
-		default_value = 3;
-	}
-	else
-	{
-		default_value = EWFINPUT_MEDIA_TYPES_DEFAULT;
-	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_media_types,
-	          EWFINPUT_MEDIA_TYPES_AMOUNT,
-	          default_value,
-	          &fixed_string_variable,
-	          error );
-
-	if( result == -1 )
+	else if( libcthreads_thread_pool_push(
+	          imaging_handle->process_thread_pool,
+	          (intptr_t *) storage_media_buffer,
+	          &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool queue.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
-	{
-		result = ewfinput_determine_media_type(
-			  fixed_string_variable,
-			  &( imaging_handle->media_type ),
-			  error );
+	return( 1 );
 
-		if( result == -1 )
+on_error:
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine media type.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 		}
 	}
-	return( result );
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( imaging_handle != NULL )
+	 && ( imaging_handle->abort == 0 ) )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Prompts the user for the media flags
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Prepares a storage media buffer for imaging
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_media_flags(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
+int imaging_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
 {
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_media_flags";
-	uint8_t default_value                     = 0;
-	int result                                = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_process_storage_media_buffer_callback";
+	size_t stored_data_size  = 0;
+	ssize_t process_count    = 0;
+	int64_t start_timestamp  = 0;
 
-	if( imaging_handle == NULL )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 "%s: invalid storage media buffer.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_REMOVABLE )
-	 || ( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_OPTICAL ) )
+	if( imaging_handle->abort != 0 )
 	{
-		default_value = 0;
+		return( 1 );
 	}
-	else
+	/* Profiling is best effort and does not affect the imaging
+	 */
+	stage_profiler_get_timestamp(
+	 &start_timestamp,
+	 NULL );
+
+	process_count = storage_media_buffer_write_process(
+			 storage_media_buffer,
+			 &error );
+
+	if( process_count < 0 )
 	{
-		default_value = 1;
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prepare storage media buffer before write.",
+		 function );
+
+		goto on_error;
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_media_flags,
-	          EWFINPUT_MEDIA_FLAGS_AMOUNT,
-	          default_value,
-	          &fixed_string_variable,
-	          error );
+	stage_profiler_add_sample(
+	 imaging_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_PACK,
+	 start_timestamp,
+	 (uint64_t) storage_media_buffer->raw_buffer_data_size,
+	 NULL );
 
-	if( result == -1 )
+	/* The size of the packed chunk data is used to determine the compression ratio
+	 */
+	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		if( libewf_data_chunk_get_stored_data_size(
+		     storage_media_buffer->data_chunk,
+		     &stored_data_size,
+		     NULL ) == 1 )
+		{
+			stage_profiler_add_output_bytes(
+			 imaging_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_PACK,
+			 (uint64_t) stored_data_size,
+			 NULL );
+		}
+	}
+
+	stage_profiler_get_timestamp(
+	 &( storage_media_buffer->output_window_timestamp ),
+	 NULL );
+
+	/* The output window writes the storage media buffer, from this or another process thread,
+	 * when all the preceding storage media buffers have been written
+	 */
+	if( reorder_window_push(
+	     imaging_handle->output_window,
+	     storage_media_buffer->sequence_number,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto output window.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
-	{
-		result = ewfinput_determine_media_flags(
-			  fixed_string_variable,
-			  &( imaging_handle->media_flags ),
-			  error );
+	storage_media_buffer = NULL;
 
-		if( result == -1 )
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine media flags.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 		}
 	}
-	return( result );
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( imaging_handle->abort == 0 )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Prompts the user for the bytes per sector
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Passes a storage media buffer on to the write stage
+ * Callback function for the output window, that is called for the storage media buffers in order
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_bytes_per_sector(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
+int imaging_handle_output_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
 {
-	static char *function  = "imaging_handle_prompt_for_bytes_per_sector";
-	uint64_t size_variable = 0;
-	int result             = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_output_storage_media_buffer_callback";
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid imaging handle.",
@@ -2912,288 +2930,319 @@ int imaging_handle_prompt_for_bytes_per_sector(
 
 		return( -1 );
 	}
-	result = ewfinput_get_size_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          1,
-	          UINT32_MAX,
-	          imaging_handle->bytes_per_sector,
-	          &size_variable,
-	          error );
-
-	if( result == -1 )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
+	/* The time the storage media buffer was held in the output window
+	 */
+	stage_profiler_add_sample(
+	 imaging_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_REORDER,
+	 storage_media_buffer->output_window_timestamp,
+	 (uint64_t) storage_media_buffer->processed_size,
+	 NULL );
+
+	/* On resume the data before the last offset written is already stored in the image file
+	 * and was only read back to restore the integrity hash(es)
+	 */
+	if( ( imaging_handle->abort == 0 )
+	 && ( storage_media_buffer->storage_media_offset >= imaging_handle->last_offset_written ) )
 	{
-		imaging_handle->bytes_per_sector = (uint32_t) size_variable;
-	}
-	return( result );
-}
+		/* The write stage releases the storage media buffer onto the queue
+		 * after it was written to all the output handles
+		 */
+		result = write_stage_push(
+		          imaging_handle->write_stage,
+		          (intptr_t *) storage_media_buffer,
+		          &error );
 
-/* Prompts the user for the number of sectors per chunk
- * Returns 1 if successful, 0 if no input was provided or -1 on error
- */
-int imaging_handle_prompt_for_sectors_per_chunk(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
-{
-	system_character_t *fixed_string_variable = NULL;
-	static char *function                     = "imaging_handle_prompt_for_sectors_per_chunk";
-	int result                                = 0;
+		storage_media_buffer = NULL;
 
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto write stage.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		return( 1 );
 	}
-	result = ewfinput_get_fixed_string_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          ewfinput_sector_per_block_sizes,
-	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_AMOUNT,
-	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_DEFAULT,
-	          &fixed_string_variable,
-	          error );
+	result = storage_media_buffer_queue_release_buffer(
+	          imaging_handle->storage_media_buffer_queue,
+	          storage_media_buffer,
+	          &error );
 
-	if( result == -1 )
+	storage_media_buffer = NULL;
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve fixed string variable.",
+		 "%s: unable to release storage media buffer onto queue.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
-	{
-		result = ewfinput_determine_sectors_per_chunk(
-			  fixed_string_variable,
-			  &( imaging_handle->sectors_per_chunk ),
-			  error );
+	return( 1 );
 
-		if( result == -1 )
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
-			 error,
+			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine sectors per chunk.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			return( -1 );
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 		}
 	}
-	return( result );
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( imaging_handle->abort == 0 )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Prompts the user for the sector error granularity
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Writes a storage media buffer to an output handle
+ * Callback function for the write stage, that is called from the thread of the output handle
+ * The storage media buffer is shared with the other output handle, in chunk data mode
+ * the chunk data is packed once and written to both output handles
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_sector_error_granularity(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
+int imaging_handle_write_stage_write_callback(
+     libewf_handle_t *output_handle,
+     storage_media_buffer_t *storage_media_buffer,
      libcerror_error_t **error )
 {
-	static char *function  = "imaging_handle_prompt_for_sector_error_granularity";
-	uint64_t size_variable = 0;
-	int result             = 0;
+	static char *function = "imaging_handle_write_stage_write_callback";
+	ssize_t write_count   = 0;
 
-	if( imaging_handle == NULL )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
+		 "%s: invalid storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	result = ewfinput_get_size_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          1,
-	          imaging_handle->sectors_per_chunk,
-	          (uint64_t) imaging_handle->sectors_per_chunk,
-	          &size_variable,
-	          error );
+	write_count = storage_media_buffer_write_to_handle(
+	               storage_media_buffer,
+	               output_handle,
+	               storage_media_buffer->processed_size,
+	               error );
 
-	if( result == -1 )
+	if( write_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		imaging_handle->sector_error_granularity = (uint32_t) size_variable;
-	}
-	else
-	{
-		imaging_handle->sector_error_granularity = imaging_handle->sectors_per_chunk;
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Prompts the user for the maximum segment size
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Releases a storage media buffer that was written to all output handles
+ * Callback function for the write stage, that is called for the storage media buffers in order
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_maximum_segment_size(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
+int imaging_handle_write_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     uint8_t is_written,
+     imaging_handle_t *imaging_handle )
 {
-	static char *function  = "imaging_handle_prompt_for_maximum_segment_size";
-	uint64_t default_size  = 0;
-	uint64_t size_variable = 0;
-	uint64_t maximum_size  = 0;
-	int result             = 0;
+        libcerror_error_t *error = NULL;
+        static char *function    = "imaging_handle_write_stage_release_callback";
+	int result               = 0;
 
 	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
 		 "%s: invalid imaging handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-/* TODO what about linen 7 */
-	if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
-	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE7 )
-	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+	if( storage_media_buffer == NULL )
 	{
-		maximum_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT;
-       	}
-	else
-       	{
-		maximum_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT;
-       	}
-       	if( default_size == 0 )
-       	{
-		default_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
-       	}
-	result = ewfinput_get_byte_size_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE,
-	          maximum_size,
-	          default_size,
-	          &size_variable,
-	          error );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
 
-	if( result == -1 )
+		goto on_error;
+	}
+	if( is_written == 0 )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	imaging_handle->maximum_segment_size = size_variable;
-
-	return( result );
-}
+	/* The write stage does not know the number of bytes written to the output handles
+	 */
+	stage_profiler_add_bytes(
+	 imaging_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_WRITE,
+	 (uint64_t) storage_media_buffer->processed_size * imaging_handle->write_stage->number_of_outputs,
+	 NULL );
 
-/* Prompts the user for the acquiry offset
- * Returns 1 if successful, 0 if no input was provided or -1 on error
- */
-int imaging_handle_prompt_for_acquiry_offset(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
-     libcerror_error_t **error )
-{
-	static char *function        = "imaging_handle_prompt_for_acquiry_offset";
-	uint64_t input_size_variable = 0;
-	int result                   = 0;
+	imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-	if( imaging_handle == NULL )
+	if( imaging_handle->process_status != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
+		if( imaging_handle->acquiry_size == 0 )
+		{
+			result = process_status_update_unknown_total(
+			          imaging_handle->process_status,
+			          imaging_handle->last_offset_written,
+			          &error );
+		}
+		else
+		{
+			result = process_status_update(
+			          imaging_handle->process_status,
+			          imaging_handle->last_offset_written,
+			          imaging_handle->acquiry_size,
+			          &error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	result = ewfinput_get_size_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          0,
-	          imaging_handle->input_media_size,
-	          imaging_handle->acquiry_offset,
-	          &input_size_variable,
-	          error );
+	result = storage_media_buffer_queue_release_buffer(
+	          imaging_handle->storage_media_buffer_queue,
+	          storage_media_buffer,
+	          &error );
 
-	if( result == -1 )
+	storage_media_buffer = NULL;
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
+		 "%s: unable to release storage media buffer onto queue.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	imaging_handle->acquiry_offset = input_size_variable;
+	return( 1 );
 
-	return( result );
+on_error:
+	if( ( imaging_handle != NULL )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     imaging_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( imaging_handle != NULL )
+	 && ( imaging_handle->abort == 0 ) )
+	{
+		imaging_handle_signal_abort(
+		 imaging_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Prompts the user for the acquiry size
- * Returns 1 if successful, 0 if no input was provided or -1 on error
+/* Empties the output window
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_prompt_for_acquiry_size(
+int imaging_handle_empty_output_window(
      imaging_handle_t *imaging_handle,
-     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function        = "imaging_handle_prompt_for_acquiry_size";
-	uint64_t default_input_size  = 0;
-	uint64_t input_size_variable = 0;
-	uint64_t maximum_input_size  = 0;
-	int result                   = 0;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "imaging_handle_empty_output_window";
+	int result                                   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -3206,53 +3255,61 @@ int imaging_handle_prompt_for_acquiry_size(
 
 		return( -1 );
 	}
-	maximum_input_size = imaging_handle->input_media_size
-	                   - imaging_handle->acquiry_offset;
-
-	if( ( imaging_handle->acquiry_size == 0 )
-	 || ( imaging_handle->acquiry_size > maximum_input_size ) )
-	{
-		default_input_size = maximum_input_size;
-	}
-	else
+	do
 	{
-		default_input_size = imaging_handle->acquiry_size;
-	}
-	result = ewfinput_get_size_variable(
-	          imaging_handle->notify_stream,
-	          imaging_handle->input_buffer,
-	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
-	          request_string,
-	          0,
-	          maximum_input_size,
-	          default_input_size,
-	          &input_size_variable,
-	          error );
+		result = reorder_window_remove_value(
+		          imaging_handle->output_window,
+		          (intptr_t **) &storage_media_buffer,
+		          error );
 
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size variable.",
-		 function );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output window.",
+			 function );
 
-		return( -1 );
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     imaging_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
+
+				return( -1 );
+			}
+			storage_media_buffer = NULL;
+		}
 	}
-	imaging_handle->acquiry_size = input_size_variable;
+	while( result != 0 );
 
-	return( result );
+	return( 1 );
 }
 
-/* Retrieves the output values of the imaging handle
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the process buffer size
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_get_output_values(
+int imaging_handle_get_process_buffer_size(
      imaging_handle_t *imaging_handle,
+     uint8_t use_data_chunk_functions,
+     size_t *process_buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_get_output_values";
+	static char *function = "imaging_handle_get_process_buffer_size";
+	uint32_t chunk_size   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -3265,233 +3322,261 @@ int imaging_handle_get_output_values(
 
 		return( -1 );
 	}
-	if( imaging_handle_get_header_value(
-	     imaging_handle,
-	     (uint8_t *) "case_number",
-	     11,
-	     &( imaging_handle->case_number ),
-	     &( imaging_handle->case_number_size ),
-	     error ) != 1 )
+	if( process_buffer_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve header value: case_number.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process buffer size.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle_get_header_value(
-	     imaging_handle,
-	     (uint8_t *) "description",
-	     11,
-	     &( imaging_handle->description ),
-	     &( imaging_handle->description_size ),
+	if( libewf_handle_get_chunk_size(
+	     imaging_handle->output_handle,
+	     &chunk_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve header value: description.",
+		 "%s: unable to retrieve output chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle_get_header_value(
-	     imaging_handle,
-	     (uint8_t *) "evidence_number",
-	     15,
-	     &( imaging_handle->evidence_number ),
-	     &( imaging_handle->evidence_number_size ),
-	     error ) != 1 )
+	if( chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve header value: evidence_number.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle_get_header_value(
-	     imaging_handle,
-	     (uint8_t *) "examiner_name",
-	     13,
-	     &( imaging_handle->examiner_name ),
-	     &( imaging_handle->examiner_name_size ),
-	     error ) != 1 )
+	if( use_data_chunk_functions != 0 )
+	{
+		*process_buffer_size = (size_t) chunk_size;
+	}
+	else if( imaging_handle->process_buffer_size == 0 )
+	{
+		*process_buffer_size = (size_t) chunk_size;
+	}
+	else
+	{
+		*process_buffer_size = imaging_handle->process_buffer_size;
+	}
+	return( 1 );
+}
+
+/* Prompts the user for a string
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_string(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_prompt_for_string";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve header value: examiner_name.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle_get_header_value(
-	     imaging_handle,
-	     (uint8_t *) "notes",
-	     5,
-	     &( imaging_handle->notes ),
-	     &( imaging_handle->notes_size ),
-	     error ) != 1 )
+	if( internal_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve header value: notes.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_bytes_per_sector(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->bytes_per_sector ),
-	     error ) != 1 )
+	if( internal_string_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve bytes per sector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_media_size(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->acquiry_size ),
-	     error ) != 1 )
+	if( *internal_string != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media size.",
-		 function );
+		memory_free(
+		 *internal_string );
 
-		return( -1 );
+		*internal_string      = NULL;
+		*internal_string_size = 0;
 	}
-	if( libewf_handle_get_media_type(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->media_type ),
-	     error ) != 1 )
+	*internal_string_size = IMAGING_HANDLE_STRING_SIZE;
+
+	*internal_string = system_string_allocate(
+	                    *internal_string_size );
+
+	if( *internal_string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media type.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create internal string.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libewf_handle_get_media_flags(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->media_flags ),
-	     error ) != 1 )
+	if( memory_set(
+	     *internal_string,
+	     0,
+	     *internal_string_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media flags.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear internal string.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libewf_handle_get_compression_values(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->compression_level ),
-	     &( imaging_handle->compression_flags ),
-	     error ) != 1 )
+	result = ewfinput_get_string_variable(
+	          imaging_handle->notify_stream,
+	          request_string,
+	          *internal_string,
+	          *internal_string_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve compression values.",
+		 "%s: unable to retrieve string variable.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libewf_handle_get_format(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->ewf_format ),
-	     error ) != 1 )
+	return( result );
+
+on_error:
+	if( *internal_string != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve format.",
-		 function );
+		memory_free(
+		 *internal_string );
 
-		return( -1 );
+		*internal_string = NULL;
 	}
-	if( libewf_handle_get_maximum_segment_size(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->maximum_segment_size ),
-	     error ) != 1 )
+	*internal_string_size = 0;
+
+	return( -1 );
+}
+
+/* Prompts the user for the compression method
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_compression_method(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_compression_method";
+	uint8_t compression_methods_amount        = 0;
+	int result                                = 0;
+
+	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve maximum segment size.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_sectors_per_chunk(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->sectors_per_chunk ),
-	     error ) != 1 )
+	if( imaging_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+	{
+		compression_methods_amount = 1;
+	}
+	else
+	{
+		compression_methods_amount = EWFINPUT_COMPRESSION_METHODS_AMOUNT;
+	}
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_compression_methods,
+	          compression_methods_amount,
+	          EWFINPUT_COMPRESSION_METHODS_DEFAULT,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve sectors per chunk.",
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_error_granularity(
-	     imaging_handle->output_handle,
-	     &( imaging_handle->sector_error_granularity ),
-	     error ) != 1 )
+	else if( result != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve error granularity.",
-		 function );
+		result = ewfinput_determine_compression_method(
+			  fixed_string_variable,
+			  &( imaging_handle->compression_method ),
+			  error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression method.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	return( 1 );
+	return( result );
 }
 
-/* Sets a string
- * Returns 1 if successful or -1 on error
+/* Prompts the user for the compression level
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
  */
-int imaging_handle_set_string(
+int imaging_handle_prompt_for_compression_level(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
-     system_character_t **internal_string,
-     size_t *internal_string_size,
+     const system_character_t *request_string,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_string";
-	size_t string_length  = 0;
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_compression_level";
+	int result                                = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -3504,120 +3589,1472 @@ int imaging_handle_set_string(
 
 		return( -1 );
 	}
-	if( string == NULL )
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_compression_levels,
+	          EWFINPUT_COMPRESSION_LEVELS_AMOUNT,
+	          EWFINPUT_COMPRESSION_LEVELS_DEFAULT,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_string == NULL )
+	else if( result != 0 )
+	{
+		result = ewfinput_determine_compression_values(
+			  fixed_string_variable,
+			  &( imaging_handle->compression_level ),
+			  &( imaging_handle->compression_flags ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression values.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Prompts the user for the format
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_format(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_format";
+	int result                                = 0;
+
+	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
+		 "%s: invalid imaging handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_string_size == NULL )
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_format_types,
+	          EWFINPUT_FORMAT_TYPES_AMOUNT,
+	          EWFINPUT_FORMAT_TYPES_DEFAULT,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
 		 function );
 
 		return( -1 );
 	}
-	if( *internal_string != NULL )
-	{
-		memory_free(
-		 *internal_string );
-
-		*internal_string      = NULL;
-		*internal_string_size = 0;
-	}
-	string_length = system_string_length(
-	                 string );
-
-	if( string_length > 0 )
+	else if( result != 0 )
 	{
-		*internal_string = system_string_allocate(
-		                    string_length + 1 );
+		result = ewfinput_determine_ewf_format(
+			  fixed_string_variable,
+			  &( imaging_handle->ewf_format ),
+			  error );
 
-		if( *internal_string == NULL )
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create internal string.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine format.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( system_string_copy(
-		     *internal_string,
-		     string,
-		     string_length ) == NULL )
+	}
+	return( result );
+}
+
+/* Prompts the user for the media type
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_media_type(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_media_type";
+	uint8_t default_value                     = 0;
+	int result                                = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_REMOVABLE )
+	{
+		default_value = 1;
+	}
+	else if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_OPTICAL )
+	{
+		default_value = 2;
+	}
+	else if( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_MEMORY )
+	{
+		default_value = 3;
+	}
+	else
+	{
+		default_value = EWFINPUT_MEDIA_TYPES_DEFAULT;
+	}
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_media_types,
+	          EWFINPUT_MEDIA_TYPES_AMOUNT,
+	          default_value,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		result = ewfinput_determine_media_type(
+			  fixed_string_variable,
+			  &( imaging_handle->media_type ),
+			  error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
-			 "%s: unable to copy string.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine media type.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		( *internal_string )[ string_length ] = 0;
+	}
+	return( result );
+}
 
-		*internal_string_size = string_length + 1;
+/* Prompts the user for the media flags
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_media_flags(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_media_flags";
+	uint8_t default_value                     = 0;
+	int result                                = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
 	}
-	return( 1 );
+	if( ( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_REMOVABLE )
+	 || ( imaging_handle->media_type == LIBEWF_MEDIA_TYPE_OPTICAL ) )
+	{
+		default_value = 0;
+	}
+	else
+	{
+		default_value = 1;
+	}
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_media_flags,
+	          EWFINPUT_MEDIA_FLAGS_AMOUNT,
+	          default_value,
+	          &fixed_string_variable,
+	          error );
 
-on_error:
-	if( *internal_string != NULL )
+	if( result == -1 )
 	{
-		memory_free(
-		 *internal_string );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
+		 function );
 
-		*internal_string = NULL;
+		return( -1 );
 	}
-	*internal_string_size = 0;
+	else if( result != 0 )
+	{
+		result = ewfinput_determine_media_flags(
+			  fixed_string_variable,
+			  &( imaging_handle->media_flags ),
+			  error );
 
-	return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine media flags.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Prompts the user for the bytes per sector
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_bytes_per_sector(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_prompt_for_bytes_per_sector";
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_get_size_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          1,
+	          UINT32_MAX,
+	          imaging_handle->bytes_per_sector,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		imaging_handle->bytes_per_sector = (uint32_t) size_variable;
+	}
+	return( result );
+}
+
+/* Prompts the user for the number of sectors per chunk
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_sectors_per_chunk(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	system_character_t *fixed_string_variable = NULL;
+	static char *function                     = "imaging_handle_prompt_for_sectors_per_chunk";
+	int result                                = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_get_fixed_string_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          ewfinput_sector_per_block_sizes,
+	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_AMOUNT,
+	          EWFINPUT_SECTOR_PER_BLOCK_SIZES_DEFAULT,
+	          &fixed_string_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve fixed string variable.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		result = ewfinput_determine_sectors_per_chunk(
+			  fixed_string_variable,
+			  &( imaging_handle->sectors_per_chunk ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sectors per chunk.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Prompts the user for the sector error granularity
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_sector_error_granularity(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_prompt_for_sector_error_granularity";
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_get_size_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          1,
+	          imaging_handle->sectors_per_chunk,
+	          (uint64_t) imaging_handle->sectors_per_chunk,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		imaging_handle->sector_error_granularity = (uint32_t) size_variable;
+	}
+	else
+	{
+		imaging_handle->sector_error_granularity = imaging_handle->sectors_per_chunk;
+	}
+	return( result );
+}
+
+/* Prompts the user for the maximum segment size
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_maximum_segment_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_prompt_for_maximum_segment_size";
+	uint64_t default_size  = 0;
+	uint64_t size_variable = 0;
+	uint64_t maximum_size  = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO what about linen 7 */
+	if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE7 )
+	 || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+	{
+		maximum_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT;
+       	}
+	else
+       	{
+		maximum_size = EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT;
+       	}
+       	if( default_size == 0 )
+       	{
+		default_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+       	}
+	result = ewfinput_get_byte_size_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE,
+	          maximum_size,
+	          default_size,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->maximum_segment_size = size_variable;
+
+	return( result );
+}
+
+/* Prompts the user for the acquiry offset
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_acquiry_offset(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	static char *function        = "imaging_handle_prompt_for_acquiry_offset";
+	uint64_t input_size_variable = 0;
+	int result                   = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_get_size_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          0,
+	          imaging_handle->input_media_size,
+	          imaging_handle->acquiry_offset,
+	          &input_size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->acquiry_offset = input_size_variable;
+
+	return( result );
+}
+
+/* Prompts the user for the acquiry size
+ * Returns 1 if successful, 0 if no input was provided or -1 on error
+ */
+int imaging_handle_prompt_for_acquiry_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *request_string,
+     libcerror_error_t **error )
+{
+	static char *function        = "imaging_handle_prompt_for_acquiry_size";
+	uint64_t default_input_size  = 0;
+	uint64_t input_size_variable = 0;
+	uint64_t maximum_input_size  = 0;
+	int result                   = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_input_size = imaging_handle->input_media_size
+	                   - imaging_handle->acquiry_offset;
+
+	if( ( imaging_handle->acquiry_size == 0 )
+	 || ( imaging_handle->acquiry_size > maximum_input_size ) )
+	{
+		default_input_size = maximum_input_size;
+	}
+	else
+	{
+		default_input_size = imaging_handle->acquiry_size;
+	}
+	result = ewfinput_get_size_variable(
+	          imaging_handle->notify_stream,
+	          imaging_handle->input_buffer,
+	          IMAGING_HANDLE_INPUT_BUFFER_SIZE,
+	          request_string,
+	          0,
+	          maximum_input_size,
+	          default_input_size,
+	          &input_size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size variable.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->acquiry_size = input_size_variable;
+
+	return( result );
+}
+
+/* Retrieves the output values of the imaging handle
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_get_output_values(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_get_output_values";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_get_header_value(
+	     imaging_handle,
+	     (uint8_t *) "case_number",
+	     11,
+	     &( imaging_handle->case_number ),
+	     &( imaging_handle->case_number_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value: case_number.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_get_header_value(
+	     imaging_handle,
+	     (uint8_t *) "description",
+	     11,
+	     &( imaging_handle->description ),
+	     &( imaging_handle->description_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value: description.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_get_header_value(
+	     imaging_handle,
+	     (uint8_t *) "evidence_number",
+	     15,
+	     &( imaging_handle->evidence_number ),
+	     &( imaging_handle->evidence_number_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value: evidence_number.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_get_header_value(
+	     imaging_handle,
+	     (uint8_t *) "examiner_name",
+	     13,
+	     &( imaging_handle->examiner_name ),
+	     &( imaging_handle->examiner_name_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value: examiner_name.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle_get_header_value(
+	     imaging_handle,
+	     (uint8_t *) "notes",
+	     5,
+	     &( imaging_handle->notes ),
+	     &( imaging_handle->notes_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve header value: notes.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_bytes_per_sector(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->acquiry_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_type(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->media_type ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media type.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_flags(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->media_flags ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_compression_values(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->compression_level ),
+	     &( imaging_handle->compression_flags ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_format(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->ewf_format ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve format.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_maximum_segment_size(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->maximum_segment_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_sectors_per_chunk(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->sectors_per_chunk ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sectors per chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_error_granularity(
+	     imaging_handle->output_handle,
+	     &( imaging_handle->sector_error_granularity ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve error granularity.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets a string
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_set_string(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     system_character_t **internal_string,
+     size_t *internal_string_size,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_string";
+	size_t string_length  = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string size.",
+		 function );
+
+		return( -1 );
+	}
+	if( *internal_string != NULL )
+	{
+		memory_free(
+		 *internal_string );
+
+		*internal_string      = NULL;
+		*internal_string_size = 0;
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length > 0 )
+	{
+		*internal_string = system_string_allocate(
+		                    string_length + 1 );
+
+		if( *internal_string == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create internal string.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     *internal_string,
+		     string,
+		     string_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy string.",
+			 function );
+
+			goto on_error;
+		}
+		( *internal_string )[ string_length ] = 0;
+
+		*internal_string_size = string_length + 1;
+	}
+	return( 1 );
+
+on_error:
+	if( *internal_string != NULL )
+	{
+		memory_free(
+		 *internal_string );
+
+		*internal_string = NULL;
+	}
+	*internal_string_size = 0;
+
+	return( -1 );
+}
+
+/* Sets the compression values
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_compression_values(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "imaging_handle_set_compression_values";
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	int number_of_segments                           = 0;
+	int result                                       = 0;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ':',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ':',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments != 1 )
+	 && ( number_of_segments != 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of segments is out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 2 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		result = ewfinput_determine_compression_method(
+			  string_segment,
+			  &( imaging_handle->compression_method ),
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine compression method.",
+			 function );
+
+			goto on_error;
+		}
+		if( imaging_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
+		{
+			if( imaging_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+			{
+				imaging_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+			}
+		}
+		segment_index++;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_segment_by_index(
+	     string_elements,
+	     segment_index,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve string segment: %d.",
+		 function,
+		 segment_index );
+
+		goto on_error;
+	}
+	if( string_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing string segment: %d.",
+		 function,
+		 segment_index );
+
+		goto on_error;
+	}
+	result = ewfinput_determine_compression_values(
+	          string_segment,
+	          &( imaging_handle->compression_level ),
+	          &( imaging_handle->compression_flags ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine compression values.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Sets the format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_format(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_format";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_ewf_format(
+	          string,
+	          &( imaging_handle->ewf_format ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine format.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the media type
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_media_type(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_media_type";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_media_type(
+	          string,
+	          &( imaging_handle->media_type ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine media type.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the media flags
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_media_flags(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_media_flags";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_media_flags(
+	          string,
+	          &( imaging_handle->media_flags ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine media flags.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Sets the bytes per sector
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_bytes_per_sector(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "imaging_handle_set_bytes_per_sector";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( size_variable > (uint64_t) UINT32_MAX )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->bytes_per_sector = (uint32_t) size_variable;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of sectors per chunk
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_sectors_per_chunk(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_sectors_per_chunk";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_sectors_per_chunk(
+	          string,
+	          &( imaging_handle->sectors_per_chunk ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sectors per chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
 }
 
-/* Sets the compression values
+/* Sets the sector error granularity
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_compression_values(
+int imaging_handle_set_sector_error_granularity(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	system_character_t *string_segment               = NULL;
-	static char *function                            = "imaging_handle_set_compression_values";
-	size_t string_length                             = 0;
-	size_t string_segment_size                       = 0;
-	int number_of_segments                           = 0;
-	int result                                       = 0;
-	int segment_index                                = 0;
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	libcsplit_wide_split_string_t *string_elements   = NULL;
-#else
-	libcsplit_narrow_split_string_t *string_elements = NULL;
-#endif
+	static char *function  = "imaging_handle_set_sector_error_granularity";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -3633,171 +5070,67 @@ int imaging_handle_set_compression_values(
 	string_length = system_string_length(
 	                 string );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_string_split(
-	     string,
-	     string_length + 1,
-	     (wchar_t) ':',
-	     &string_elements,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_string_split(
-	     string,
-	     string_length + 1,
-	     (char) ':',
-	     &string_elements,
-	     error ) != 1 )
-#endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split string.",
-		 function );
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
 
-		goto on_error;
-	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_get_number_of_segments(
-	     string_elements,
-	     &number_of_segments,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_get_number_of_segments(
-	     string_elements,
-	     &number_of_segments,
-	     error ) != 1 )
-#endif
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( number_of_segments != 1 )
-	 && ( number_of_segments != 2 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of segments is out of bounds.",
+		 "%s: unable to determine sector error granularity.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 2 )
+	else if( result != 0 )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libcsplit_wide_split_string_get_segment_by_index(
-		     string_elements,
-		     segment_index,
-		     &string_segment,
-		     &string_segment_size,
-		     error ) != 1 )
-#else
-		if( libcsplit_narrow_split_string_get_segment_by_index(
-		     string_elements,
-		     segment_index,
-		     &string_segment,
-		     &string_segment_size,
-		     error ) != 1 )
-#endif
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve string segment: %d.",
-			 function,
-			 segment_index );
-
-			goto on_error;
-		}
-		if( string_segment == NULL )
+		if( ( size_variable > (uint64_t) UINT32_MAX )
+		 || ( size_variable > imaging_handle->sectors_per_chunk ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing string segment: %d.",
-			 function,
-			 segment_index );
+			size_variable = imaging_handle->sectors_per_chunk;
 
-			goto on_error;
+			result = 0;
 		}
-		result = ewfinput_determine_compression_method(
-			  string_segment,
-			  &( imaging_handle->compression_method ),
-			  error );
+		imaging_handle->sector_error_granularity = (uint32_t) size_variable;
+	}
+	return( result );
+}
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine compression method.",
-			 function );
+/* Sets the maximum segment file size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_maximum_segment_size(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_maximum_segment_size";
+	size_t string_length  = 0;
+	int result            = 0;
 
-			goto on_error;
-		}
-		if( imaging_handle->ewf_format != LIBEWF_FORMAT_V2_ENCASE7 )
-		{
-			if( imaging_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
-			{
-				imaging_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-			}
-		}
-		segment_index++;
-	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_get_segment_by_index(
-	     string_elements,
-	     segment_index,
-	     &string_segment,
-	     &string_segment_size,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_get_segment_by_index(
-	     string_elements,
-	     segment_index,
-	     &string_segment,
-	     &string_segment_size,
-	     error ) != 1 )
-#endif
+	if( imaging_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve string segment: %d.",
-		 function,
-		 segment_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( string_segment == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing string segment: %d.",
-		 function,
-		 segment_index );
+	string_length = system_string_length(
+	                 string );
 
-		goto on_error;
-	}
-	result = ewfinput_determine_compression_values(
-	          string_segment,
-	          &( imaging_handle->compression_level ),
-	          &( imaging_handle->compression_flags ),
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &( imaging_handle->maximum_segment_size ),
 	          error );
 
 	if( result == -1 )
@@ -3806,57 +5139,52 @@ int imaging_handle_set_compression_values(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine compression values.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libcsplit_wide_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#else
-	if( libcsplit_narrow_split_string_free(
-	     &string_elements,
-	     error ) != 1 )
-#endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split string.",
+		 "%s: unable to determine maximum segment size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	return( result );
-
-on_error:
-	if( string_elements != NULL )
+        else if( result != 0 )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		libcsplit_wide_split_string_free(
-		 &string_elements,
-		 NULL );
-#else
-		libcsplit_narrow_split_string_free(
-		 &string_elements,
-		 NULL );
-#endif
+		if( imaging_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
+		{
+			result = 0;
+		}
+/* TODO what about linen 7 */
+		else if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
+		      || ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE7 )
+		      || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
+		{
+			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT )
+			{
+				result = 0;
+			}
+		}
+		else
+		{
+			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT )
+			{
+				result = 0;
+			}
+		}
+		if( result == 0 )
+		{
+			imaging_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+		}
 	}
-	return( -1 );
+	return( result );
 }
 
-/* Sets the format
+/* Sets the acquiry offset
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_format(
+int imaging_handle_set_acquiry_offset(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_format";
+	static char *function = "imaging_handle_set_acquiry_offset";
+	size_t string_length  = 0;
 	int result            = 0;
 
 	if( imaging_handle == NULL )
@@ -3870,34 +5198,52 @@ int imaging_handle_set_format(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_ewf_format(
-	          string,
-	          &( imaging_handle->ewf_format ),
-	          error );
-
-	if( result == -1 )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine format.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &( imaging_handle->acquiry_offset ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine acquiry offset.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+	}
 	return( result );
 }
 
-/* Sets the media type
+/* Sets the acquiry size
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_media_type(
+int imaging_handle_set_acquiry_size(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_media_type";
+	static char *function = "imaging_handle_set_acquiry_size";
+	size_t string_length  = 0;
 	int result            = 0;
 
 	if( imaging_handle == NULL )
@@ -3911,34 +5257,51 @@ int imaging_handle_set_media_type(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_media_type(
-	          string,
-	          &( imaging_handle->media_type ),
-	          error );
-
-	if( result == -1 )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine media type.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+				 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &( imaging_handle->acquiry_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine acquiry size.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+	}
 	return( result );
 }
 
-/* Sets the media flags
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+/* Sets the header codepage
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_set_media_flags(
+int imaging_handle_set_header_codepage(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_media_flags";
+	static char *function = "imaging_handle_set_header_codepage";
 	int result            = 0;
 
 	if( imaging_handle == NULL )
@@ -3952,9 +5315,9 @@ int imaging_handle_set_media_flags(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_media_flags(
+	result = ewfinput_determine_header_codepage(
 	          string,
-	          &( imaging_handle->media_flags ),
+	          &imaging_handle->header_codepage,
 	          error );
 
 	if( result == -1 )
@@ -3963,7 +5326,7 @@ int imaging_handle_set_media_flags(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine media flags.",
+		 "%s: unable to determine header codepage.",
 		 function );
 
 		return( -1 );
@@ -3971,18 +5334,28 @@ int imaging_handle_set_media_flags(
 	return( result );
 }
 
-/* Sets the bytes per sector
+/* Sets the write flags
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_bytes_per_sector(
+int imaging_handle_set_write_flags(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function  = "imaging_handle_set_bytes_per_sector";
-	size_t string_length   = 0;
-	uint64_t size_variable = 0;
-	int result             = 0;
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "imaging_handle_set_write_flags";
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	uint8_t write_flags                              = 0;
+	int number_of_segments                           = 0;
+	int result                                       = 1;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -3998,87 +5371,173 @@ int imaging_handle_set_bytes_per_sector(
 	string_length = system_string_length(
 	                 string );
 
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &size_variable,
-	          error );
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ',',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ',',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
 
-	if( result == -1 )
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine bytes per sector.",
+		 "%s: unable to retrieve number of segments.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	else if( result != 0 )
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
 	{
-		if( size_variable > (uint64_t) UINT32_MAX )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
 		{
-			result = 0;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( ( string_segment_size == 7 )
+		 && ( system_string_compare(
+		       string_segment,
+		       _SYSTEM_STRING( "direct" ),
+		       6 ) == 0 ) )
+		{
+			write_flags |= LIBEWF_WRITE_FLAG_USE_DIRECT_IO;
+		}
+		else if( ( string_segment_size == 12 )
+		      && ( system_string_compare(
+		            string_segment,
+		            _SYSTEM_STRING( "preallocate" ),
+		            11 ) == 0 ) )
+		{
+			write_flags |= LIBEWF_WRITE_FLAG_PREALLOCATE;
+		}
+		else if( ( string_segment_size == 5 )
+		      && ( system_string_compare(
+		            string_segment,
+		            _SYSTEM_STRING( "none" ),
+		            4 ) == 0 ) )
+		{
+			write_flags = 0;
 		}
 		else
 		{
-			imaging_handle->bytes_per_sector = (uint32_t) size_variable;
+			result = 0;
 		}
 	}
-	return( result );
-}
-
-/* Sets the number of sectors per chunk
- * Returns 1 if successful, 0 if unsupported value or -1 on error
- */
-int imaging_handle_set_sectors_per_chunk(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *string,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_set_sectors_per_chunk";
-	int result            = 0;
-
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		return( -1 );
-	}
-	result = ewfinput_determine_sectors_per_chunk(
-	          string,
-	          &( imaging_handle->sectors_per_chunk ),
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sectors per chunk.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	if( result == 1 )
+	{
+		imaging_handle->write_flags = write_flags;
 	}
 	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
 }
 
-/* Sets the sector error granularity
+/* Sets the process buffer size
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_sector_error_granularity(
+int imaging_handle_set_process_buffer_size(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function  = "imaging_handle_set_sector_error_granularity";
+	static char *function  = "imaging_handle_set_process_buffer_size";
 	size_t string_length   = 0;
 	uint64_t size_variable = 0;
 	int result             = 0;
@@ -4109,110 +5568,39 @@ int imaging_handle_set_sector_error_granularity(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine sector error granularity.",
+		 "%s: unable to determine process buffer size.",
 		 function );
 
 		return( -1 );
 	}
 	else if( result != 0 )
 	{
-		if( ( size_variable > (uint64_t) UINT32_MAX )
-		 || ( size_variable > imaging_handle->sectors_per_chunk ) )
+		if( size_variable > (uint64_t) SSIZE_MAX )
 		{
-			size_variable = imaging_handle->sectors_per_chunk;
-
-			result = 0;
-		}
-		imaging_handle->sector_error_granularity = (uint32_t) size_variable;
-	}
-	return( result );
-}
-
-/* Sets the maximum segment file size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
- */
-int imaging_handle_set_maximum_segment_size(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *string,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_set_maximum_segment_size";
-	size_t string_length  = 0;
-	int result            = 0;
-
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		return( -1 );
-	}
-	string_length = system_string_length(
-	                 string );
-
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &( imaging_handle->maximum_segment_size ),
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine maximum segment size.",
-		 function );
+			imaging_handle->process_buffer_size = 0;
 
-		return( -1 );
-	}
-        else if( result != 0 )
-	{
-		if( imaging_handle->maximum_segment_size < EWFCOMMON_MINIMUM_SEGMENT_FILE_SIZE )
-		{
 			result = 0;
 		}
-/* TODO what about linen 7 */
-		else if( ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE6 )
-		      || ( imaging_handle->ewf_format == LIBEWF_FORMAT_ENCASE7 )
-		      || ( imaging_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 ) )
-		{
-			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT )
-			{
-				result = 0;
-			}
-		}
 		else
 		{
-			if( imaging_handle->maximum_segment_size >= (uint64_t) EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT )
-			{
-				result = 0;
-			}
-		}
-		if( result == 0 )
-		{
-			imaging_handle->maximum_segment_size = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
+			imaging_handle->process_buffer_size = (size_t) size_variable;
 		}
 	}
 	return( result );
 }
 
-/* Sets the acquiry offset
+/* Sets the number of threads
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_acquiry_offset(
+int imaging_handle_set_number_of_threads(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_acquiry_offset";
-	size_t string_length  = 0;
-	int result            = 0;
+	static char *function      = "imaging_handle_set_number_of_threads";
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+	int result                 = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -4225,111 +5613,92 @@ int imaging_handle_set_acquiry_offset(
 
 		return( -1 );
 	}
-	if( string == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
-		 function );
+	string_length = system_string_length(
+	                 string );
 
-		return( -1 );
-	}
-	if( string[ 0 ] != (system_character_t) '-' )
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
 	{
-		string_length = system_string_length(
-				 string );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( system_resources_get_automatic_number_of_threads(
+		     &( imaging_handle->number_of_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine automatic number of threads.",
+			 function );
 
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &( imaging_handle->acquiry_offset ),
+			return( -1 );
+		}
+		if( system_resources_get_automatic_process_buffers_size(
+		     IMAGING_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE,
+		     &( imaging_handle->maximum_process_buffers_size ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine acquiry offset.",
+			 "%s: unable to determine automatic process buffers size.",
 			 function );
 
 			return( -1 );
 		}
+		/* The process buffers size is an upper bound, the number of buffers in flight
+		 * is adapted at runtime
+		 */
+		imaging_handle->adapt_number_of_buffers = 1;
+#endif
 		result = 1;
 	}
-	return( result );
-}
-
-/* Sets the acquiry size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
- */
-int imaging_handle_set_acquiry_size(
-     imaging_handle_t *imaging_handle,
-     const system_character_t *string,
-     libcerror_error_t **error )
-{
-	static char *function = "imaging_handle_set_acquiry_size";
-	size_t string_length  = 0;
-	int result            = 0;
-
-	if( imaging_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid imaging handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( string == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid string.",
-		 function );
-
-		return( -1 );
-	}
-	if( string[ 0 ] != (system_character_t) '-' )
+	else if( string[ 0 ] != (system_character_t) '-' )
 	{
-		string_length = system_string_length(
-				 string );
-
 		if( ewftools_system_string_decimal_copy_to_64_bit(
 		     string,
 		     string_length + 1,
-		     &( imaging_handle->acquiry_size ),
+		     &number_of_threads,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine acquiry size.",
+			 "%s: unable to determine number of threads.",
 			 function );
 
 			return( -1 );
 		}
 		result = 1;
+
+		if( number_of_threads > 32 )
+		{
+			result = 0;
+		}
+		else
+		{
+			imaging_handle->number_of_threads       = (int) number_of_threads;
+			imaging_handle->adapt_number_of_buffers = 0;
+		}
 	}
 	return( result );
 }
 
-/* Sets the header codepage
+/* Sets the metrics stream
+ * The metrics stream is not owned by the imaging handle
  * Returns 1 if successful or -1 on error
  */
-int imaging_handle_set_header_codepage(
+int imaging_handle_set_metrics_stream(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
+     FILE *metrics_stream,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_set_header_codepage";
-	int result            = 0;
+	static char *function = "imaging_handle_set_metrics_stream";
 
 	if( imaging_handle == NULL )
 	{
@@ -4342,37 +5711,24 @@ int imaging_handle_set_header_codepage(
 
 		return( -1 );
 	}
-	result = ewfinput_determine_header_codepage(
-	          string,
-	          &imaging_handle->header_codepage,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine header codepage.",
-		 function );
+	imaging_handle->metrics_stream = metrics_stream;
 
-		return( -1 );
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Sets the process buffer size
- * Returns 1 if successful, 0 if unsupported value or -1 on error
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Sets the process pool
+ * The process pool is not owned by the imaging handle and replaces the process thread pool
+ * of the handle, so that multiple handles share the same process threads
+ * Returns 1 if successful or -1 on error
  */
-int imaging_handle_set_process_buffer_size(
+int imaging_handle_set_process_pool(
      imaging_handle_t *imaging_handle,
-     const system_character_t *string,
+     process_pool_t *process_pool,
      libcerror_error_t **error )
 {
-	static char *function  = "imaging_handle_set_process_buffer_size";
-	size_t string_length   = 0;
-	uint64_t size_variable = 0;
-	int result             = 0;
+	static char *function = "imaging_handle_set_process_pool";
 
 	if( imaging_handle == NULL )
 	{
@@ -4383,56 +5739,37 @@ int imaging_handle_set_process_buffer_size(
 		 "%s: invalid imaging handle.",
 		 function );
 
-		return( -1 );
-	}
-	string_length = system_string_length(
-	                 string );
-
-	result = byte_size_string_convert(
-	          string,
-	          string_length,
-	          &size_variable,
-	          error );
-
-	if( result == -1 )
+		return( -1 );
+	}
+	if( imaging_handle->process_pool_client != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine process buffer size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - process pool client value already set.",
 		 function );
 
 		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		if( size_variable > (uint64_t) SSIZE_MAX )
-		{
-			imaging_handle->process_buffer_size = 0;
+	imaging_handle->process_pool = process_pool;
 
-			result = 0;
-		}
-		else
-		{
-			imaging_handle->process_buffer_size = (size_t) size_variable;
-		}
-	}
-	return( result );
+	return( 1 );
 }
 
-/* Sets the number of threads
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Sets the digest (hash) calculation backend
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int imaging_handle_set_number_of_threads(
+int imaging_handle_set_hash_backend(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
      libcerror_error_t **error )
 {
-	static char *function      = "imaging_handle_set_number_of_threads";
-	size_t string_length       = 0;
-	uint64_t number_of_threads = 0;
-	int result                 = 0;
+	static char *function = "imaging_handle_set_hash_backend";
+	int hash_backend      = 0;
+	int result            = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -4445,35 +5782,32 @@ int imaging_handle_set_number_of_threads(
 
 		return( -1 );
 	}
-	if( string[ 0 ] != (system_character_t) '-' )
-	{
-		string_length = system_string_length(
-				 string );
+	result = ewfinput_determine_hash_backend(
+	          string,
+	          &hash_backend,
+	          error );
 
-		if( ewftools_system_string_decimal_copy_to_64_bit(
-		     string,
-		     string_length + 1,
-		     &number_of_threads,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine number of threads.",
-			 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine hash backend.",
+		 function );
 
-			return( -1 );
-		}
-		result = 1;
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The backend must be supported by the CPU
+		 */
+		result = digest_context_backend_is_supported(
+		          hash_backend );
 
-		if( number_of_threads > 32 )
-		{
-			result = 0;
-		}
-		else
+		if( result != 0 )
 		{
-			imaging_handle->number_of_threads = (int) number_of_threads;
+			imaging_handle->hash_backend = hash_backend;
 		}
 	}
 	return( result );
@@ -5164,6 +6498,20 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	if( libewf_handle_set_write_flags(
+	     imaging_handle->output_handle,
+	     imaging_handle->write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write flags.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_handle_set_sectors_per_chunk(
 	     imaging_handle->output_handle,
 	     imaging_handle->sectors_per_chunk,
@@ -5328,6 +6676,20 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_write_flags(
+		     imaging_handle->secondary_output_handle,
+		     imaging_handle->write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write flags in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
 		if( libewf_handle_set_sectors_per_chunk(
 		     imaging_handle->secondary_output_handle,
 		     imaging_handle->sectors_per_chunk,
@@ -5822,6 +7184,22 @@ int imaging_handle_append_read_error(
 			return( -1 );
 		}
 	}
+	if( imaging_handle->process_status != NULL )
+	{
+		if( process_status_add_read_error(
+		     imaging_handle->process_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add read error to process status.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -5993,6 +7371,38 @@ int imaging_handle_start(
 
 		goto on_error;
 	}
+	if( process_status_set_stage_profiler(
+	     imaging_handle->process_status,
+	     imaging_handle->stage_profiler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status stage profiler",
+		 function );
+
+		goto on_error;
+	}
+	if( imaging_handle->metrics_stream != NULL )
+	{
+		if( process_status_set_metrics_stream(
+		     imaging_handle->process_status,
+		     imaging_handle->metrics_stream,
+		     PROCESS_STATUS_METRICS_INTERVAL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set process status metrics stream",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( process_status_start(
 	     imaging_handle->process_status,
 	     error ) != 1 )
@@ -6011,13 +7421,13 @@ int imaging_handle_start(
 on_error:
 	if( imaging_handle->sha1_context != NULL )
 	{
-		libhmac_sha1_free(
+		digest_context_free(
 		 &( imaging_handle->sha1_context ),
 		 NULL );
 	}
 	if( imaging_handle->md5_context != NULL )
 	{
-		libhmac_md5_free(
+		digest_context_free(
 		 &( imaging_handle->md5_context ),
 		 NULL );
 	}
@@ -6031,6 +7441,7 @@ on_error:
 }
 
 /* Updates the imaging handle
+ * When threads are used the imaging handle takes over the storage media buffer
  * Returns 1 if successful or -1 on error
  */
 int imaging_handle_update(
@@ -6041,12 +7452,19 @@ int imaging_handle_update(
      uint8_t swap_byte_pairs,
      libcerror_error_t **error )
 {
-	uint8_t *data         = NULL;
-	static char *function = "imaging_handle_update";
-	size_t data_size      = 0;
-	ssize_t process_count = 0;
-	ssize_t write_count   = 0;
-	int result            = 0;
+	uint8_t *data                     = NULL;
+	static char *function             = "imaging_handle_update";
+	size_t data_size                  = 0;
+	size_t stored_data_size           = 0;
+	ssize_t process_count             = 0;
+	ssize_t write_count               = 0;
+	int64_t start_timestamp           = 0;
+	uint8_t is_stored                 = 0;
+	int result                        = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t number_of_pending_values = 0;
+#endif
 
 	if( imaging_handle == NULL )
 	{
@@ -6085,10 +7503,21 @@ int imaging_handle_update(
 
 		return( -1 );
 	}
+	/* On resume the data before the resume acquiry offset is already stored in the image file
+	 * and is only read back to restore the integrity hash(es). The last offset written is
+	 * updated before the storage media buffer is passed on, so that the output window does not
+	 * write the data again.
+	 */
+	if( imaging_handle->last_offset_written < resume_acquiry_offset )
+	{
+		imaging_handle->last_offset_written += (off64_t) read_count;
+
+		is_stored = 1;
+	}
 	/* Swap byte pairs
 	 */
 	if( ( swap_byte_pairs == 1 )
-	 && ( imaging_handle->last_offset_written >= resume_acquiry_offset ) )
+	 && ( is_stored == 0 ) )
 	{
 		if( imaging_handle_swap_byte_pairs(
 		     imaging_handle,
@@ -6108,27 +7537,107 @@ int imaging_handle_update(
 	}
 	/* Integrity (digest) hashes are calcultated after swap
 	 */
-	if( imaging_handle_update_integrity_hash(
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_stage != NULL )
+	{
+		if( reorder_window_get_next_sequence_number(
+		     imaging_handle->output_window,
+		     &( storage_media_buffer->sequence_number ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media buffer sequence number.",
+			 function );
+
+			return( -1 );
+		}
+		/* Profiling is best effort and does not affect the imaging
+		 */
+		if( reorder_window_get_number_of_pending_values(
+		     imaging_handle->output_window,
+		     &number_of_pending_values,
+		     NULL ) == 1 )
+		{
+			stage_profiler_add_queue_depth(
+			 imaging_handle->stage_profiler,
+			 STAGE_PROFILER_QUEUE_IN_FLIGHT,
+			 number_of_pending_values,
+			 NULL );
+		}
+		/* The digest stage passes the storage media buffer on to the process thread pool
+		 * after all the integrity hash(es) were updated
+		 */
+		if( digest_stage_push(
+		     imaging_handle->digest_stage,
+		     (intptr_t *) storage_media_buffer,
+		     data,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto digest stage.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+#endif
+	{
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		if( imaging_handle_update_integrity_hash(
+		     imaging_handle,
+		     data,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to update integrity hash(es).",
+			 function );
+
+			return( -1 );
+		}
+		stage_profiler_add_sample(
+		 imaging_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_HASH,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+	}
+	imaging_handle->last_offset_hashed += (off64_t) read_count;
+
+	if( imaging_handle_update_checkpoint(
 	     imaging_handle,
-	     data,
-	     (size_t) read_count,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to update integrity hash(es).",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update checkpoint.",
 		 function );
 
 		return( -1 );
 	}
-	if( imaging_handle->last_offset_written < resume_acquiry_offset )
-	{
-		imaging_handle->last_offset_written += (off64_t) read_count;
-	}
-	else if( imaging_handle->number_of_threads == 0 )
+	if( ( is_stored == 0 )
+	 && ( imaging_handle->number_of_threads == 0 ) )
 	{
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
 		process_count = storage_media_buffer_write_process(
 				 storage_media_buffer,
 				 error );
@@ -6144,6 +7653,32 @@ int imaging_handle_update(
 
 			return( -1 );
 		}
+		stage_profiler_add_sample(
+		 imaging_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_PACK,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+
+		if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		{
+			if( libewf_data_chunk_get_stored_data_size(
+			     storage_media_buffer->data_chunk,
+			     &stored_data_size,
+			     NULL ) == 1 )
+			{
+				stage_profiler_add_output_bytes(
+				 imaging_handle->stage_profiler,
+				 STAGE_PROFILER_STAGE_PACK,
+				 (uint64_t) stored_data_size,
+				 NULL );
+			}
+		}
+
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
 		write_count = imaging_handle_write_storage_media_buffer(
 			       imaging_handle,
 			       storage_media_buffer,
@@ -6161,9 +7696,16 @@ int imaging_handle_update(
 
 			return( -1 );
 		}
+		stage_profiler_add_sample(
+		 imaging_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_WRITE,
+		 start_timestamp,
+		 (uint64_t) write_count,
+		 NULL );
+
 		imaging_handle->last_offset_written += process_count;
 	}
-	if( ( imaging_handle->last_offset_written < resume_acquiry_offset )
+	if( ( is_stored != 0 )
 	 || ( imaging_handle->number_of_threads == 0 ) )
 	{
 		if( imaging_handle->acquiry_size == 0 )
@@ -6196,6 +7738,42 @@ int imaging_handle_update(
 	return( 1 );
 }
 
+/* Prints the progress of correcting the segment files on write finalize
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_write_finalize_progress_callback(
+     void *user_data,
+     uint64_t value,
+     uint64_t maximum_value )
+{
+	imaging_handle_t *imaging_handle = NULL;
+
+	if( user_data == NULL )
+	{
+		return( -1 );
+	}
+	imaging_handle = (imaging_handle_t *) user_data;
+
+	if( ( imaging_handle->notify_stream == NULL )
+	 || ( maximum_value == 0 ) )
+	{
+		return( 1 );
+	}
+	/* Only print the progress in steps of 10%
+	 */
+	if( ( value == maximum_value )
+	 || ( ( ( value * 10 ) / maximum_value ) != ( ( ( value - 1 ) * 10 ) / maximum_value ) ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 "Finalizing segment files: %" PRIu64 " of %" PRIu64 " (%" PRIu64 "%%).\n",
+		 value,
+		 maximum_value,
+		 ( value * 100 ) / maximum_value );
+	}
+	return( 1 );
+}
+
 /* Strops the imaging handle
  * Returns 1 if successful or -1 on error
  */
@@ -6295,6 +7873,21 @@ int imaging_handle_stop(
 				return( -1 );
 			}
 		}
+		if( libewf_handle_set_progress_callback(
+		     imaging_handle->output_handle,
+		     &imaging_handle_write_finalize_progress_callback,
+		     (void *) imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set progress callback.",
+			 function );
+
+			return( -1 );
+		}
 		write_count = libewf_handle_write_finalize(
 		               imaging_handle->output_handle,
 		               error );
@@ -6312,6 +7905,21 @@ int imaging_handle_stop(
 		}
 		if( imaging_handle->secondary_output_handle != NULL )
 		{
+			if( libewf_handle_set_progress_callback(
+			     imaging_handle->secondary_output_handle,
+			     &imaging_handle_write_finalize_progress_callback,
+			     (void *) imaging_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set progress callback of secondary output handle.",
+				 function );
+
+				return( -1 );
+			}
 			secondary_write_count = libewf_handle_write_finalize(
 			                         imaging_handle->secondary_output_handle,
 			                         error );
@@ -6334,6 +7942,25 @@ int imaging_handle_stop(
 	{
 		status = PROCESS_STATUS_ABORTED;
 	}
+	/* The checkpoints are no longer needed when the acquiry has completed
+	 */
+	if( ( imaging_handle->checkpoint_file != NULL )
+	 && ( status == PROCESS_STATUS_COMPLETED ) )
+	{
+		if( checkpoint_file_remove(
+		     imaging_handle->checkpoint_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove checkpoint file.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( process_status_stop(
 	     imaging_handle->process_status,
 	     imaging_handle->last_offset_written,
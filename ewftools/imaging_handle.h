@@ -26,13 +26,20 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "buffer_limiter.h"
+#include "checkpoint_file.h"
+#include "digest_context.h"
+#include "digest_stage.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
-#include "ewftools_libhmac.h"
+#include "process_pool.h"
 #include "process_status.h"
+#include "reorder_window.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
+#include "write_stage.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -146,6 +153,10 @@ struct imaging_handle
 	 */
 	size64_t maximum_segment_size;
 
+	/* The libewf write flags
+	 */
+	uint8_t write_flags;
+
 	/* The acquiry offset
 	 */
 	uint64_t acquiry_offset;
@@ -160,7 +171,7 @@ struct imaging_handle
 
 	/* The MD5 digest context
 	 */
-	libhmac_md5_context_t *md5_context;
+	digest_context_t *md5_context;
 
 	/* Value to indicate the MD5 digest context was initialized
 	 */
@@ -176,7 +187,7 @@ struct imaging_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	digest_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -192,7 +203,7 @@ struct imaging_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	digest_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -202,6 +213,10 @@ struct imaging_handle
 	 */
 	char *calculated_sha256_hash_string;
 
+	/* The digest (hash) calculation backend
+	 */
+	int hash_backend;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
@@ -214,24 +229,48 @@ struct imaging_handle
 	 */
 	int number_of_threads;
 
+	/* The maximum size of the process buffers that can be in flight
+	 */
+	size64_t maximum_process_buffers_size;
+
+	/* Value to indicate the number of storage media buffers in flight should be adapted at runtime
+	 */
+	uint8_t adapt_number_of_buffers;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
 	 */
 	libcthreads_thread_pool_t *process_thread_pool;
 
-	/* The output thread pool
+	/* The process pool, that is shared with other imaging handles, which is not owned by the handle
+	 */
+	process_pool_t *process_pool;
+
+	/* The client of the shared process pool
 	 */
-	libcthreads_thread_pool_t *output_thread_pool;
+	process_pool_client_t *process_pool_client;
 
-	/* The output list
+	/* The output window, that writes the processed storage media buffers in order
 	 */
-	libcdata_list_t *output_list;
+	reorder_window_t *output_window;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The buffer limiter, that adapts the number of storage media buffers in flight
+	 */
+	buffer_limiter_t *buffer_limiter;
+
+	/* The digest stage, that calculates the integrity hash(es) in separate threads
+	 */
+	digest_stage_t *digest_stage;
+
+	/* The write stage, that writes the primary and secondary output in separate threads
+	 */
+	write_stage_t *write_stage;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
@@ -250,14 +289,30 @@ struct imaging_handle
 	 */
 	off64_t last_offset_written;
 
+	/* The last offset of the data included in the integrity hash(es)
+	 */
+	off64_t last_offset_hashed;
+
+	/* The checkpoint file
+	 */
+	checkpoint_file_t *checkpoint_file;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
 
+	/* The metrics stream
+	 */
+	FILE *metrics_stream;
+
 	/* The process status information
 	 */
 	process_status_t *process_status;
 
+	/* The stage profiler
+	 */
+	stage_profiler_t *stage_profiler;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -300,6 +355,27 @@ int imaging_handle_open_output_resume(
      off64_t *resume_acquiry_offset,
      libcerror_error_t **error );
 
+int imaging_handle_get_target_basename_length(
+     imaging_handle_t *imaging_handle,
+     uint8_t resume,
+     size_t *basename_length,
+     libcerror_error_t **error );
+
+int imaging_handle_open_checkpoint_file(
+     imaging_handle_t *imaging_handle,
+     uint8_t resume,
+     libcerror_error_t **error );
+
+int imaging_handle_restore_checkpoint(
+     imaging_handle_t *imaging_handle,
+     off64_t resume_acquiry_offset,
+     off64_t *checkpoint_offset,
+     libcerror_error_t **error );
+
+int imaging_handle_update_checkpoint(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
 int imaging_handle_close(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
@@ -352,6 +428,14 @@ int imaging_handle_threads_stop(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_append_digest_stage_digests(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_digest_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
 int imaging_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
@@ -360,7 +444,17 @@ int imaging_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      imaging_handle_t *imaging_handle );
 
-int imaging_handle_empty_output_list(
+int imaging_handle_write_stage_write_callback(
+     libewf_handle_t *output_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_write_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     uint8_t is_written,
+     imaging_handle_t *imaging_handle );
+
+int imaging_handle_empty_output_window(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
@@ -500,6 +594,11 @@ int imaging_handle_set_header_codepage(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_write_flags(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_process_buffer_size(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -510,6 +609,25 @@ int imaging_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_metrics_stream(
+     imaging_handle_t *imaging_handle,
+     FILE *metrics_stream,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int imaging_handle_set_process_pool(
+     imaging_handle_t *imaging_handle,
+     process_pool_t *process_pool,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int imaging_handle_set_hash_backend(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_additional_digest_types(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
@@ -577,6 +695,11 @@ int imaging_handle_update(
      uint8_t swap_byte_pairs,
      libcerror_error_t **error );
 
+int imaging_handle_write_finalize_progress_callback(
+     void *user_data,
+     uint64_t value,
+     uint64_t maximum_value );
+
 int imaging_handle_stop(
      imaging_handle_t *imaging_handle,
      off64_t resume_acquiry_offset,
@@ -0,0 +1,789 @@
+/*
+ * Process pool, that shares the process threads between handles
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "process_pool.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a process pool
+ * Make sure the value process_pool is referencing, is set to NULL
+ * The maximum buffers size is the memory budget that is divided between the clients
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_initialize(
+     process_pool_t **process_pool,
+     int number_of_threads,
+     int maximum_number_of_queued_values,
+     size64_t maximum_buffers_size,
+     int number_of_clients,
+     libcerror_error_t **error )
+{
+	static char *function = "process_pool_initialize";
+
+	if( process_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid process pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_queued_values <= 0 )
+	 || ( maximum_number_of_queued_values > (int) ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of queued values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_clients <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of clients value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*process_pool = memory_allocate_structure(
+	                 process_pool_t );
+
+	if( *process_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create process pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *process_pool,
+	     0,
+	     sizeof( process_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear process pool.",
+		 function );
+
+		memory_free(
+		 *process_pool );
+
+		*process_pool = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *process_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	/* The values of all clients are processed in the order they were pushed,
+	 * since every client has a limited number of values in flight no client
+	 * can hold up the others
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *process_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_queued_values,
+	     (int (*)(intptr_t *, void *)) &process_pool_process_callback,
+	     (void *) *process_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize process thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *process_pool )->maximum_buffers_size = maximum_buffers_size;
+	( *process_pool )->number_of_clients    = number_of_clients;
+
+	return( 1 );
+
+on_error:
+	if( *process_pool != NULL )
+	{
+		if( ( *process_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *process_pool )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *process_pool );
+
+		*process_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a process pool
+ * The process threads are joined, the clients must have been freed before
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_free(
+     process_pool_t **process_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "process_pool_free";
+	int result            = 1;
+
+	if( process_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_pool != NULL )
+	{
+		if( ( *process_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *process_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join process thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *process_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *process_pool );
+
+		*process_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the size of the buffers a single client can have in flight
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_get_client_buffers_size(
+     process_pool_t *process_pool,
+     size64_t *client_buffers_size,
+     libcerror_error_t **error )
+{
+	static char *function = "process_pool_get_client_buffers_size";
+
+	if( process_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_pool->number_of_clients <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid process pool - number of clients value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( client_buffers_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client buffers size.",
+		 function );
+
+		return( -1 );
+	}
+	*client_buffers_size = process_pool->maximum_buffers_size / (size64_t) process_pool->number_of_clients;
+
+	return( 1 );
+}
+
+/* Processes a value of a client
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_process_callback(
+     process_pool_value_t *process_pool_value,
+     process_pool_t *process_pool )
+{
+	process_pool_client_t *process_pool_client = NULL;
+	libcerror_error_t *error                   = NULL;
+	static char *function                      = "process_pool_process_callback";
+	int result                                 = 1;
+
+	if( process_pool_value == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool value.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool.",
+		 function );
+
+		goto on_error;
+	}
+	process_pool_client = process_pool_value->client;
+
+	/* The process function is responsible for the value, also when processing fails
+	 */
+	result = process_pool_client->process_function(
+	          process_pool_value->value,
+	          process_pool_client->process_function_arguments );
+
+	memory_free(
+	 process_pool_value );
+
+	/* The value is no longer pending after the process function completed
+	 * so that process_pool_client_wait also waits for the process function
+	 */
+	if( libcthreads_mutex_grab(
+	     process_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	process_pool_client->number_of_pending_values -= 1;
+
+	if( process_pool_client->number_of_pending_values == 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     process_pool_client->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     process_pool->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Creates a process pool client
+ * Make sure the value process_pool_client is referencing, is set to NULL
+ * The process function is called, from one of the process threads of the process pool,
+ * for every value pushed by the client
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_client_initialize(
+     process_pool_client_t **process_pool_client,
+     process_pool_t *process_pool,
+     int (*process_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *process_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "process_pool_client_initialize";
+
+	if( process_pool_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool client.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_pool_client != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid process pool client value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process function.",
+		 function );
+
+		return( -1 );
+	}
+	*process_pool_client = memory_allocate_structure(
+	                        process_pool_client_t );
+
+	if( *process_pool_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create process pool client.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *process_pool_client,
+	     0,
+	     sizeof( process_pool_client_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear process pool client.",
+		 function );
+
+		memory_free(
+		 *process_pool_client );
+
+		*process_pool_client = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *process_pool_client )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *process_pool_client )->process_pool               = process_pool;
+	( *process_pool_client )->process_function           = process_function;
+	( *process_pool_client )->process_function_arguments = process_function_arguments;
+
+	return( 1 );
+
+on_error:
+	if( *process_pool_client != NULL )
+	{
+		memory_free(
+		 *process_pool_client );
+
+		*process_pool_client = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a process pool client
+ * The pending values are waited for if this was not done before
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_client_free(
+     process_pool_client_t **process_pool_client,
+     libcerror_error_t **error )
+{
+	static char *function = "process_pool_client_free";
+	int result            = 1;
+
+	if( process_pool_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool client.",
+		 function );
+
+		return( -1 );
+	}
+	if( *process_pool_client != NULL )
+	{
+		/* The process threads can still reference the client while values are pending
+		 */
+		if( process_pool_client_wait(
+		     *process_pool_client,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to wait for pending values.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_condition_free(
+		     &( ( *process_pool_client )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *process_pool_client );
+
+		*process_pool_client = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a value onto the process pool
+ * Pushing blocks while the process thread pool queue is full
+ * The value is not passed to the process function when pushing the value fails
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_client_push(
+     process_pool_client_t *process_pool_client,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	process_pool_value_t *process_pool_value = NULL;
+	process_pool_t *process_pool             = NULL;
+	static char *function                    = "process_pool_client_push";
+
+	if( process_pool_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool client.",
+		 function );
+
+		return( -1 );
+	}
+	process_pool = process_pool_client->process_pool;
+
+	process_pool_value = memory_allocate_structure(
+	                      process_pool_value_t );
+
+	if( process_pool_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create process pool value.",
+		 function );
+
+		return( -1 );
+	}
+	process_pool_value->client = process_pool_client;
+	process_pool_value->value  = value;
+
+	if( libcthreads_mutex_grab(
+	     process_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	process_pool_client->number_of_pending_values += 1;
+
+	if( libcthreads_mutex_release(
+	     process_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_push(
+	     process_pool->thread_pool,
+	     (intptr_t *) process_pool_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push value onto process thread pool queue.",
+		 function );
+
+		if( libcthreads_mutex_grab(
+		     process_pool->mutex,
+		     NULL ) == 1 )
+		{
+			process_pool_client->number_of_pending_values -= 1;
+
+			if( process_pool_client->number_of_pending_values == 0 )
+			{
+				libcthreads_condition_broadcast(
+				 process_pool_client->condition,
+				 NULL );
+			}
+			libcthreads_mutex_release(
+			 process_pool->mutex,
+			 NULL );
+		}
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( process_pool_value != NULL )
+	{
+		memory_free(
+		 process_pool_value );
+	}
+	return( -1 );
+}
+
+/* Waits until the process pool has processed all the values pushed by the client
+ * Returns 1 if successful or -1 on error
+ */
+int process_pool_client_wait(
+     process_pool_client_t *process_pool_client,
+     libcerror_error_t **error )
+{
+	process_pool_t *process_pool = NULL;
+	static char *function        = "process_pool_client_wait";
+
+	if( process_pool_client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process pool client.",
+		 function );
+
+		return( -1 );
+	}
+	process_pool = process_pool_client->process_pool;
+
+	if( libcthreads_mutex_grab(
+	     process_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( process_pool_client->number_of_pending_values > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     process_pool_client->condition,
+		     process_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 process_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     process_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
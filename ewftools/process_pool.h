@@ -0,0 +1,148 @@
+/*
+ * Process pool, that shares the process threads between handles
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PROCESS_POOL_H )
+#define _PROCESS_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct process_pool process_pool_t;
+
+struct process_pool
+{
+	/* The thread pool, that contains the process threads shared by the clients
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The maximum size of the buffers that can be in flight for all clients
+	 */
+	size64_t maximum_buffers_size;
+
+	/* The number of clients that share the maximum size of the buffers
+	 */
+	int number_of_clients;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+typedef struct process_pool_client process_pool_client_t;
+
+struct process_pool_client
+{
+	/* The process pool, which is not owned by the client
+	 */
+	process_pool_t *process_pool;
+
+	/* The process function, which is called from one of the process threads
+	 */
+	int (*process_function)(
+	       intptr_t *value,
+	       void *arguments );
+
+	/* The process function arguments
+	 */
+	void *process_function_arguments;
+
+	/* The number of values that are pending to be processed
+	 */
+	int number_of_pending_values;
+
+	/* The condition that is signalled when there are no more pending values
+	 */
+	libcthreads_condition_t *condition;
+};
+
+typedef struct process_pool_value process_pool_value_t;
+
+struct process_pool_value
+{
+	/* The client that pushed the value
+	 */
+	process_pool_client_t *client;
+
+	/* The value, which is passed to the process function
+	 */
+	intptr_t *value;
+};
+
+int process_pool_initialize(
+     process_pool_t **process_pool,
+     int number_of_threads,
+     int maximum_number_of_queued_values,
+     size64_t maximum_buffers_size,
+     int number_of_clients,
+     libcerror_error_t **error );
+
+int process_pool_free(
+     process_pool_t **process_pool,
+     libcerror_error_t **error );
+
+int process_pool_get_client_buffers_size(
+     process_pool_t *process_pool,
+     size64_t *client_buffers_size,
+     libcerror_error_t **error );
+
+int process_pool_process_callback(
+     process_pool_value_t *process_pool_value,
+     process_pool_t *process_pool );
+
+int process_pool_client_initialize(
+     process_pool_client_t **process_pool_client,
+     process_pool_t *process_pool,
+     int (*process_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *process_function_arguments,
+     libcerror_error_t **error );
+
+int process_pool_client_free(
+     process_pool_client_t **process_pool_client,
+     libcerror_error_t **error );
+
+int process_pool_client_push(
+     process_pool_client_t *process_pool_client,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int process_pool_client_wait(
+     process_pool_client_t *process_pool_client,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PROCESS_POOL_H ) */
+
@@ -36,6 +36,7 @@
 #include "ewftools_libclocale.h"
 #include "ewftools_libcnotify.h"
 #include "process_status.h"
+#include "stage_profiler.h"
 
 /* Creates process status information
  * Make sure the value process_status is referencing, is set to NULL
@@ -248,6 +249,100 @@ int process_status_free(
 	return( result );
 }
 
+/* Sets the stage profiler
+ * The stage profiler is started with the process status, its summary is printed when
+ * the process status is stopped and with every status update in verbose mode
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_stage_profiler(
+     process_status_t *process_status,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_stage_profiler";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->stage_profiler = stage_profiler;
+
+	return( 1 );
+}
+
+/* Sets the metrics stream
+ * A metrics record is written to the stream as a single line of JSON
+ * at most once every metrics interval, in seconds, and when the process stops
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_set_metrics_stream(
+     process_status_t *process_status,
+     FILE *metrics_stream,
+     int metrics_interval,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_set_metrics_stream";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( metrics_interval <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid metrics interval value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->metrics_stream   = metrics_stream;
+	process_status->metrics_interval = (int64_t) metrics_interval * 1000000000;
+
+	return( 1 );
+}
+
+/* Adds a read error to the process status
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_add_read_error(
+     process_status_t *process_status,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_add_read_error";
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->number_of_read_errors += 1;
+
+	return( 1 );
+}
+
 /* Starts the process status information
  * Returns 1 if successful or -1 on error
  */
@@ -272,6 +367,21 @@ int process_status_start(
 	}
 	process_status->last_parts_per_million = -1;
 
+	if( stage_profiler_get_timestamp(
+	     &( process_status->start_timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	process_status->last_metrics_timestamp = process_status->start_timestamp;
+
 	if( libcdatetime_elements_set_current_time_localtime(
 	     process_status->start_time_elements,
 	     error ) != 1 )
@@ -313,6 +423,22 @@ int process_status_start(
 
 		return( -1 );
 	}
+	if( process_status->stage_profiler != NULL )
+	{
+		if( stage_profiler_start(
+		     process_status->stage_profiler,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to start stage profiler.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -370,6 +496,21 @@ int process_status_update(
 
 		return( -1 );
 	}
+	if( process_status_update_metrics(
+	     process_status,
+	     bytes_read,
+	     bytes_total,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update metrics.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -501,6 +642,25 @@ int process_status_update(
 			fprintf(
 			 process_status->output_stream,
 			 "\n" );
+
+			if( ( libcnotify_verbose != 0 )
+			 && ( process_status->stage_profiler != NULL ) )
+			{
+				if( stage_profiler_fprint(
+				     process_status->stage_profiler,
+				     process_status->output_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print stage profile.",
+					 function );
+
+					return( -1 );
+				}
+			}
 		}
 	}
 	return( 1 );
@@ -528,6 +688,21 @@ int process_status_update_unknown_total(
 
 		return( -1 );
 	}
+	if( process_status_update_metrics(
+	     process_status,
+	     bytes_read,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update metrics.",
+		 function );
+
+		return( -1 );
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_update_string != NULL ) )
@@ -622,6 +797,25 @@ int process_status_update_unknown_total(
 			fprintf(
 			 process_status->output_stream,
 			 "\n\n" );
+
+			if( ( libcnotify_verbose != 0 )
+			 && ( process_status->stage_profiler != NULL ) )
+			{
+				if( stage_profiler_fprint(
+				     process_status->stage_profiler,
+				     process_status->output_stream,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+					 "%s: unable to print stage profile.",
+					 function );
+
+					return( -1 );
+				}
+			}
 		}
 	}
 	return( 1 );
@@ -639,6 +833,7 @@ int process_status_stop(
 	system_character_t time_string[ 32 ];
 
 	const system_character_t *status_string = _SYSTEM_STRING( "" );
+	const char *state_string                = NULL;
 	static char *function                   = "process_status_start";
 	int64_t total_number_of_seconds         = 0;
 
@@ -679,6 +874,37 @@ int process_status_stop(
 
 		return( -1 );
 	}
+	if( process_status->metrics_stream != NULL )
+	{
+		if( status == PROCESS_STATUS_ABORTED )
+		{
+			state_string = "aborted";
+		}
+		else if( status == PROCESS_STATUS_COMPLETED )
+		{
+			state_string = "completed";
+		}
+		else if( status == PROCESS_STATUS_FAILED )
+		{
+			state_string = "failed";
+		}
+		if( process_status_metrics_fprint(
+		     process_status,
+		     bytes_total,
+		     bytes_total,
+		     state_string,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print metrics.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	if( ( process_status->output_stream != NULL )
 	 && ( process_status->print_status_information != 0 )
 	 && ( process_status->status_process_string != NULL ) )
@@ -764,7 +990,343 @@ int process_status_stop(
 			 process_status->output_stream,
 			 "\n" );
 		}
+		if( process_status->stage_profiler != NULL )
+		{
+			fprintf(
+			 process_status->output_stream,
+			 "\n" );
+
+			if( stage_profiler_fprint(
+			     process_status->stage_profiler,
+			     process_status->output_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print stage profile.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the metrics
+ * A metrics record is only printed when the metrics interval has passed
+ * A bytes total of 0 represents an unknown total
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_update_metrics(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     libcerror_error_t **error )
+{
+	static char *function = "process_status_update_metrics";
+	int64_t timestamp     = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->metrics_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( timestamp - process_status->last_metrics_timestamp ) < process_status->metrics_interval )
+	{
+		return( 1 );
+	}
+	process_status->last_metrics_timestamp = timestamp;
+
+	if( process_status_metrics_fprint(
+	     process_status,
+	     bytes_read,
+	     bytes_total,
+	     "running",
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print metrics.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints a metrics record as a single line of JSON to the metrics stream
+ * Only integer values are printed so that the record does not depend on the locale
+ * The compression ratio is the packed size relative to the media size in per mille
+ * and the bytes written include every copy when there are multiple outputs
+ * A bytes total of 0 represents an unknown total
+ * Returns 1 if successful or -1 on error
+ */
+int process_status_metrics_fprint(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     const char *state_string,
+     libcerror_error_t **error )
+{
+	stage_profiler_queue_t queues[ STAGE_PROFILER_NUMBER_OF_QUEUES ];
+	stage_profiler_stage_t stages[ STAGE_PROFILER_NUMBER_OF_STAGES ];
+
+	static char *function          = "process_status_metrics_fprint";
+	uint64_t busy_time             = 0;
+	uint64_t bytes_per_second      = 0;
+	uint64_t elapsed_time          = 0;
+	uint64_t profiler_elapsed_time = 0;
+	int64_t timestamp              = 0;
+	int index                      = 0;
+	int is_first                   = 0;
+
+	if( process_status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process status.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->metrics_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid process status - missing metrics stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( state_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid state string.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( process_status->stage_profiler != NULL )
+	{
+		if( stage_profiler_get_samples(
+		     process_status->stage_profiler,
+		     stages,
+		     queues,
+		     &profiler_elapsed_time,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stage profiler samples.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( timestamp > process_status->start_timestamp )
+	{
+		elapsed_time = (uint64_t) ( timestamp - process_status->start_timestamp ) / 1000;
+	}
+	/* The rates are calculated in micro seconds to prevent overflow
+	 */
+	if( elapsed_time > 0 )
+	{
+		bytes_per_second = ( ( bytes_read / elapsed_time ) * 1000000 )
+		                 + ( ( ( bytes_read % elapsed_time ) * 1000000 ) / elapsed_time );
+	}
+	fprintf(
+	 process_status->metrics_stream,
+	 "{\"timestamp\": %" PRIi64 ", \"state\": \"%s\", \"elapsed_ms\": %" PRIu64 ", \"bytes_read\": %" PRIu64 ", \"bytes_total\": ",
+	 (int64_t) time( NULL ),
+	 state_string,
+	 elapsed_time / 1000,
+	 bytes_read );
+
+	if( bytes_total > 0 )
+	{
+		fprintf(
+		 process_status->metrics_stream,
+		 "%" PRIu64 "",
+		 bytes_total );
+	}
+	else
+	{
+		fprintf(
+		 process_status->metrics_stream,
+		 "null" );
+	}
+	fprintf(
+	 process_status->metrics_stream,
+	 ", \"bytes_per_second\": %" PRIu64 ", \"eta_seconds\": ",
+	 bytes_per_second );
+
+	if( ( bytes_total >= bytes_read )
+	 && ( bytes_per_second > 0 ) )
+	{
+		fprintf(
+		 process_status->metrics_stream,
+		 "%" PRIu64 "",
+		 ( bytes_total - bytes_read ) / bytes_per_second );
 	}
+	else
+	{
+		fprintf(
+		 process_status->metrics_stream,
+		 "null" );
+	}
+	fprintf(
+	 process_status->metrics_stream,
+	 ", \"read_errors\": %" PRIu64 "",
+	 process_status->number_of_read_errors );
+
+	if( process_status->stage_profiler != NULL )
+	{
+		fprintf(
+		 process_status->metrics_stream,
+		 ", \"bytes_written\": %" PRIu64 ", \"compression_ratio_permille\": ",
+		 stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_bytes );
+
+		if( ( stages[ STAGE_PROFILER_STAGE_PACK ].number_of_bytes > 0 )
+		 && ( stages[ STAGE_PROFILER_STAGE_PACK ].number_of_output_bytes > 0 ) )
+		{
+			fprintf(
+			 process_status->metrics_stream,
+			 "%" PRIu64 "",
+			 ( stages[ STAGE_PROFILER_STAGE_PACK ].number_of_output_bytes * 1000 ) / stages[ STAGE_PROFILER_STAGE_PACK ].number_of_bytes );
+		}
+		else
+		{
+			fprintf(
+			 process_status->metrics_stream,
+			 "null" );
+		}
+		fprintf(
+		 process_status->metrics_stream,
+		 ", \"stages\": {" );
+
+		is_first = 1;
+
+		for( index = 0;
+		     index < STAGE_PROFILER_NUMBER_OF_STAGES;
+		     index++ )
+		{
+			if( ( stages[ index ].number_of_samples == 0 )
+			 && ( stages[ index ].wait_time == 0 ) )
+			{
+				continue;
+			}
+			busy_time        = stages[ index ].busy_time / 1000;
+			bytes_per_second = 0;
+
+			if( busy_time > 0 )
+			{
+				bytes_per_second = ( ( stages[ index ].number_of_bytes / busy_time ) * 1000000 )
+				                 + ( ( ( stages[ index ].number_of_bytes % busy_time ) * 1000000 ) / busy_time );
+			}
+			fprintf(
+			 process_status->metrics_stream,
+			 "%s\"%s\": {\"samples\": %" PRIu64 ", \"bytes\": %" PRIu64 ", \"busy_ms\": %" PRIu64 ", \"bytes_per_second\": %" PRIu64 ", \"stalls\": %" PRIu64 ", \"wait_ms\": %" PRIu64 "}",
+			 ( is_first != 0 ) ? "" : ", ",
+			 stage_profiler_get_stage_name(
+			  index ),
+			 stages[ index ].number_of_samples,
+			 stages[ index ].number_of_bytes,
+			 busy_time / 1000,
+			 bytes_per_second,
+			 stages[ index ].number_of_stalls,
+			 stages[ index ].wait_time / 1000000 );
+
+			is_first = 0;
+		}
+		fprintf(
+		 process_status->metrics_stream,
+		 "}, \"queues\": {" );
+
+		is_first = 1;
+
+		for( index = 0;
+		     index < STAGE_PROFILER_NUMBER_OF_QUEUES;
+		     index++ )
+		{
+			if( queues[ index ].number_of_samples == 0 )
+			{
+				continue;
+			}
+			fprintf(
+			 process_status->metrics_stream,
+			 "%s\"%s\": {\"samples\": %" PRIu64 ", \"average\": %" PRIu64 ", \"maximum\": %" PRIu64 "}",
+			 ( is_first != 0 ) ? "" : ", ",
+			 stage_profiler_get_queue_name(
+			  index ),
+			 queues[ index ].number_of_samples,
+			 queues[ index ].total_depth / queues[ index ].number_of_samples,
+			 queues[ index ].maximum_depth );
+
+			is_first = 0;
+		}
+		fprintf(
+		 process_status->metrics_stream,
+		 "}" );
+	}
+	fprintf(
+	 process_status->metrics_stream,
+	 "}\n" );
+
+	/* Flush the record so that it can be read while the process is running
+	 */
+	fflush(
+	 process_status->metrics_stream );
+
 	return( 1 );
 }
 
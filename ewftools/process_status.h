@@ -27,11 +27,16 @@
 
 #include "ewftools_libcdatetime.h"
 #include "ewftools_libcerror.h"
+#include "stage_profiler.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The default interval of the metrics records in seconds
+ */
+#define PROCESS_STATUS_METRICS_INTERVAL		1
+
 enum PROCESS_STATUS
 {
 	PROCESS_STATUS_ABORTED		= (int) 'a',
@@ -86,6 +91,30 @@ struct process_status
 	/* The last parts per million
 	 */
 	int64_t last_parts_per_million;
+
+	/* The stage profiler, which is not owned by the process status
+	 */
+	stage_profiler_t *stage_profiler;
+
+	/* The metrics stream, which is not owned by the process status
+	 */
+	FILE *metrics_stream;
+
+	/* The interval of the metrics records in nano seconds
+	 */
+	int64_t metrics_interval;
+
+	/* The timestamp of the start of the process in nano seconds
+	 */
+	int64_t start_timestamp;
+
+	/* The timestamp of the last metrics record in nano seconds
+	 */
+	int64_t last_metrics_timestamp;
+
+	/* The number of read errors
+	 */
+	uint64_t number_of_read_errors;
 };
 
 int process_status_initialize(
@@ -101,6 +130,21 @@ int process_status_free(
      process_status_t **process_status,
      libcerror_error_t **error );
 
+int process_status_set_stage_profiler(
+     process_status_t *process_status,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error );
+
+int process_status_set_metrics_stream(
+     process_status_t *process_status,
+     FILE *metrics_stream,
+     int metrics_interval,
+     libcerror_error_t **error );
+
+int process_status_add_read_error(
+     process_status_t *process_status,
+     libcerror_error_t **error );
+
 int process_status_start(
      process_status_t *process_status,
      libcerror_error_t **error );
@@ -122,6 +166,19 @@ int process_status_stop(
      int status,
      libcerror_error_t **error );
 
+int process_status_update_metrics(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     libcerror_error_t **error );
+
+int process_status_metrics_fprint(
+     process_status_t *process_status,
+     size64_t bytes_read,
+     size64_t bytes_total,
+     const char *state_string,
+     libcerror_error_t **error );
+
 void process_status_timestamp_fprint(
       FILE *stream,
       int64_t number_of_seconds );
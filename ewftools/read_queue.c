@@ -0,0 +1,975 @@
+/*
+ * Read queue, that reads the input using direct IO with a number of reads queued ahead
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT requires _GNU_SOURCE on Linux
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "read_queue.h"
+
+/* Direct IO requires aligned buffers
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( O_DIRECT ) && defined( HAVE_POSIX_MEMALIGN ) && defined( HAVE_PREAD )
+#define READ_QUEUE_HAVE_DIRECT_IO	1
+#endif
+
+/* Creates a read queue
+ * Make sure the value read_queue is referencing, is set to NULL
+ * The buffer size must be a multiple of READ_QUEUE_ALIGNMENT
+ * Returns 1 if successful or -1 on error
+ */
+int read_queue_initialize(
+     read_queue_t **read_queue,
+     int number_of_buffers,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "read_queue_initialize";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( number_of_buffers > READ_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( ( buffer_size % READ_QUEUE_ALIGNMENT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_queue = memory_allocate_structure(
+	               read_queue_t );
+
+	if( *read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_queue,
+	     0,
+	     sizeof( read_queue_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read queue.",
+		 function );
+
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_queue )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *read_queue )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *read_queue )->file_descriptor   = -1;
+	( *read_queue )->buffer_size       = buffer_size;
+	( *read_queue )->number_of_buffers = number_of_buffers;
+
+	return( 1 );
+
+on_error:
+	if( *read_queue != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *read_queue )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_queue )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read queue
+ * Returns 1 if successful or -1 on error
+ */
+int read_queue_free(
+     read_queue_t **read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "read_queue_free";
+	int result            = 1;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_queue != NULL )
+	{
+		if( ( *read_queue )->file_descriptor != -1 )
+		{
+			if( read_queue_close(
+			     *read_queue,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close read queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *read_queue )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_queue )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_queue );
+
+		*read_queue = NULL;
+	}
+	return( result );
+}
+
+/* Opens the input of the read queue for direct IO
+ * Returns 1 if successful, 0 if direct IO is not supported for the input or -1 on error
+ */
+int read_queue_open(
+     read_queue_t *read_queue,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "read_queue_open";
+
+#if defined( READ_QUEUE_HAVE_DIRECT_IO )
+	off64_t media_size    = 0;
+	int buffer_index      = 0;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read queue - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( READ_QUEUE_HAVE_DIRECT_IO )
+	read_queue->file_descriptor = open(
+	                               filename,
+	                               O_RDONLY | O_DIRECT );
+
+	if( read_queue->file_descriptor == -1 )
+	{
+		/* Fall back to buffered IO if the file system or device does not support direct IO
+		 */
+		if( errno == EINVAL )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	media_size = lseek(
+	              read_queue->file_descriptor,
+	              0,
+	              SEEK_END );
+
+	/* Inputs of which the size cannot be determined, such as pipes, are not read ahead
+	 */
+	if( media_size <= 0 )
+	{
+		close(
+		 read_queue->file_descriptor );
+
+		read_queue->file_descriptor = -1;
+
+		return( 0 );
+	}
+	read_queue->media_size     = (size64_t) media_size;
+	read_queue->current_offset = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < read_queue->number_of_buffers;
+	     buffer_index++ )
+	{
+		if( posix_memalign(
+		     (void **) &( read_queue->buffers[ buffer_index ].data ),
+		     READ_QUEUE_ALIGNMENT,
+		     read_queue->buffer_size ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer: %d.",
+			 function,
+			 buffer_index );
+
+			read_queue->buffers[ buffer_index ].data = NULL;
+
+			goto on_error;
+		}
+		read_queue->buffers[ buffer_index ].offset    = -1;
+		read_queue->buffers[ buffer_index ].data_size = 0;
+		read_queue->buffers[ buffer_index ].state     = READ_QUEUE_BUFFER_STATE_EMPTY;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Every buffer has its own read thread so that all queued reads are outstanding on the input
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( read_queue->read_thread_pool ),
+	     NULL,
+	     read_queue->number_of_buffers,
+	     read_queue->number_of_buffers,
+	     (int (*)(intptr_t *, void *)) &read_queue_read_callback,
+	     (void *) read_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	for( buffer_index = 0;
+	     buffer_index < read_queue->number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_queue->buffers[ buffer_index ].data != NULL )
+		{
+			memory_free(
+			 read_queue->buffers[ buffer_index ].data );
+
+			read_queue->buffers[ buffer_index ].data = NULL;
+		}
+	}
+	close(
+	 read_queue->file_descriptor );
+
+	read_queue->file_descriptor = -1;
+
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( READ_QUEUE_HAVE_DIRECT_IO ) */
+}
+
+/* Closes the read queue
+ * The reads that are still queued are completed before the input is closed
+ * Returns the 0 if successful or -1 on error
+ */
+int read_queue_close(
+     read_queue_t *read_queue,
+     libcerror_error_t **error )
+{
+	static char *function = "read_queue_close";
+	int buffer_index      = 0;
+	int result            = 0;
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( read_queue->read_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( read_queue->read_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	for( buffer_index = 0;
+	     buffer_index < read_queue->number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_queue->buffers[ buffer_index ].data != NULL )
+		{
+			memory_free(
+			 read_queue->buffers[ buffer_index ].data );
+
+			read_queue->buffers[ buffer_index ].data = NULL;
+		}
+		read_queue->buffers[ buffer_index ].state = READ_QUEUE_BUFFER_STATE_EMPTY;
+	}
+#if defined( READ_QUEUE_HAVE_DIRECT_IO )
+	if( close(
+	     read_queue->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file descriptor.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	read_queue->file_descriptor = -1;
+
+	return( result );
+}
+
+/* Reads the data of a queued buffer
+ * Callback function for the read thread pool, in single-threaded mode it is called directly
+ * Returns 1 if successful or -1 on error
+ */
+int read_queue_read_callback(
+     read_queue_buffer_t *read_queue_buffer,
+     read_queue_t *read_queue )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "read_queue_read_callback";
+	ssize_t read_count       = -1;
+	int error_code           = 0;
+
+	if( read_queue_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( READ_QUEUE_HAVE_DIRECT_IO )
+	do
+	{
+		read_count = pread(
+		              read_queue->file_descriptor,
+		              read_queue_buffer->data,
+		              read_queue->buffer_size,
+		              (off_t) read_queue_buffer->offset );
+	}
+	while( ( read_count == -1 )
+	    && ( errno == EINTR ) );
+
+	if( read_count == -1 )
+	{
+		error_code = errno;
+	}
+#endif
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* A failed read is not an error of the read queue, the area is read again
+	 * by the device handle so that the read error retries are applied
+	 */
+	if( read_count < 0 )
+	{
+		read_queue_buffer->data_size  = 0;
+		read_queue_buffer->error_code = error_code;
+		read_queue_buffer->state      = READ_QUEUE_BUFFER_STATE_FAILED;
+	}
+	else
+	{
+		read_queue_buffer->data_size  = (size_t) read_count;
+		read_queue_buffer->error_code = 0;
+		read_queue_buffer->state      = READ_QUEUE_BUFFER_STATE_READ;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_condition_broadcast(
+	     read_queue->condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 read_queue->mutex,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     read_queue->mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Reads a buffer from the current offset of the read queue
+ * The reads of the buffers following the current offset are queued ahead
+ * Returns the number of bytes read, which is less than size if the end of the input
+ * was reached or if the input could not be read at the offset, or -1 on error
+ */
+ssize_t read_queue_read_buffer(
+         read_queue_t *read_queue,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	read_queue_buffer_t *read_queue_buffer = NULL;
+	static char *function                  = "read_queue_read_buffer";
+	size_t buffer_data_offset              = 0;
+	size_t buffer_offset                   = 0;
+	size_t read_size                       = 0;
+	off64_t base_offset                    = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	read_queue_buffer_t *queued_buffer     = NULL;
+	off64_t queued_offset                  = 0;
+	int buffer_index                       = 0;
+#endif
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_queue->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read queue - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( (size64_t) read_queue->current_offset >= read_queue->media_size )
+		{
+			break;
+		}
+		base_offset = read_queue->current_offset - ( read_queue->current_offset % (off64_t) read_queue->buffer_size );
+
+		/* The buffers are used as a ring, where the buffer of an offset is determined
+		 * by its position in the input
+		 */
+		read_queue_buffer = &( read_queue->buffers[ ( base_offset / (off64_t) read_queue->buffer_size ) % read_queue->number_of_buffers ] );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* Queue the reads of the buffer of the current offset and the buffers that follow
+		 * so that the input always has outstanding reads
+		 */
+		for( buffer_index = 0;
+		     buffer_index < read_queue->number_of_buffers;
+		     buffer_index++ )
+		{
+			queued_offset = base_offset + ( (off64_t) buffer_index * (off64_t) read_queue->buffer_size );
+
+			if( (size64_t) queued_offset >= read_queue->media_size )
+			{
+				break;
+			}
+			queued_buffer = &( read_queue->buffers[ ( queued_offset / (off64_t) read_queue->buffer_size ) % read_queue->number_of_buffers ] );
+
+			if( ( queued_buffer->state != READ_QUEUE_BUFFER_STATE_EMPTY )
+			 && ( queued_buffer->offset == queued_offset ) )
+			{
+				continue;
+			}
+			/* Wait for the read of a buffer that was queued for a preceding seek
+			 */
+			while( queued_buffer->state == READ_QUEUE_BUFFER_STATE_QUEUED )
+			{
+				if( libcthreads_condition_wait(
+				     read_queue->condition,
+				     read_queue->mutex,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to wait for condition.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			queued_buffer->offset    = queued_offset;
+			queued_buffer->data_size = 0;
+			queued_buffer->state     = READ_QUEUE_BUFFER_STATE_QUEUED;
+
+			if( libcthreads_thread_pool_push(
+			     read_queue->read_thread_pool,
+			     (intptr_t *) queued_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to push buffer: %d onto read thread pool queue.",
+				 function,
+				 buffer_index );
+
+				queued_buffer->state = READ_QUEUE_BUFFER_STATE_EMPTY;
+
+				goto on_error;
+			}
+		}
+		while( read_queue_buffer->state == READ_QUEUE_BUFFER_STATE_QUEUED )
+		{
+			if( libcthreads_condition_wait(
+			     read_queue->condition,
+			     read_queue->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     read_queue->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#else
+		if( ( read_queue_buffer->state == READ_QUEUE_BUFFER_STATE_EMPTY )
+		 || ( read_queue_buffer->offset != base_offset ) )
+		{
+			read_queue_buffer->offset = base_offset;
+			read_queue_buffer->state  = READ_QUEUE_BUFFER_STATE_QUEUED;
+
+			if( read_queue_read_callback(
+			     read_queue_buffer,
+			     read_queue ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 ".",
+				 function,
+				 base_offset );
+
+				read_queue_buffer->state = READ_QUEUE_BUFFER_STATE_EMPTY;
+
+				return( -1 );
+			}
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		/* A failed or short read is left to the caller, the buffer keeps its state
+		 * so that the area is not read again for the remainder of the buffer
+		 */
+		if( read_queue_buffer->state != READ_QUEUE_BUFFER_STATE_READ )
+		{
+			break;
+		}
+		buffer_data_offset = (size_t) ( read_queue->current_offset - base_offset );
+
+		if( buffer_data_offset >= read_queue_buffer->data_size )
+		{
+			break;
+		}
+		read_size = read_queue_buffer->data_size - buffer_data_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		/* The buffer is not reused while its data is copied since only the caller queues reads
+		 */
+		if( memory_copy(
+		     &( buffer[ buffer_offset ] ),
+		     &( read_queue_buffer->data[ buffer_data_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer data.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset              += read_size;
+		read_queue->current_offset += (off64_t) read_size;
+	}
+	return( (ssize_t) buffer_offset );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+on_error:
+	libcthreads_mutex_release(
+	 read_queue->mutex,
+	 NULL );
+
+	return( -1 );
+#endif
+}
+
+/* Seeks a certain offset in the read queue
+ * The reads of the buffers are queued when data is read from the offset
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t read_queue_seek_offset(
+         read_queue_t *read_queue,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "read_queue_seek_offset";
+
+	if( read_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += read_queue->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) read_queue->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_queue->current_offset = offset;
+
+	return( offset );
+}
+
@@ -0,0 +1,168 @@
+/*
+ * Read queue, that reads the input using direct IO with a number of reads queued ahead
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _READ_QUEUE_H )
+#define _READ_QUEUE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The alignment of the buffers, offsets and sizes required by direct IO
+ * 4096 is a multiple of both the 512 and 4096 bytes per sector
+ */
+#define READ_QUEUE_ALIGNMENT			4096
+
+/* The default size of a single read
+ */
+#define READ_QUEUE_DEFAULT_BUFFER_SIZE		( 1024 * 1024 )
+
+/* The default number of reads that are queued ahead
+ */
+#define READ_QUEUE_DEFAULT_NUMBER_OF_BUFFERS	4
+
+/* The maximum number of reads that are queued ahead
+ */
+#define READ_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS	32
+
+enum READ_QUEUE_BUFFER_STATES
+{
+	READ_QUEUE_BUFFER_STATE_EMPTY		= 0,
+	READ_QUEUE_BUFFER_STATE_QUEUED		= 1,
+	READ_QUEUE_BUFFER_STATE_READ		= 2,
+	READ_QUEUE_BUFFER_STATE_FAILED		= 3
+};
+
+typedef struct read_queue_buffer read_queue_buffer_t;
+
+struct read_queue_buffer
+{
+	/* The data, which is aligned for direct IO
+	 */
+	uint8_t *data;
+
+	/* The offset of the data in the input
+	 */
+	off64_t offset;
+
+	/* The size of the data that was read
+	 */
+	size_t data_size;
+
+	/* The state
+	 */
+	int state;
+
+	/* The system error code of a failed read
+	 */
+	int error_code;
+};
+
+typedef struct read_queue read_queue_t;
+
+struct read_queue
+{
+	/* The file descriptor, which is opened for direct IO
+	 */
+	int file_descriptor;
+
+	/* The size of the input
+	 */
+	size64_t media_size;
+
+	/* The size of a single read
+	 */
+	size_t buffer_size;
+
+	/* The buffers
+	 */
+	read_queue_buffer_t buffers[ READ_QUEUE_MAXIMUM_NUMBER_OF_BUFFERS ];
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read thread pool
+	 */
+	libcthreads_thread_pool_t *read_thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a queued read completed
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int read_queue_initialize(
+     read_queue_t **read_queue,
+     int number_of_buffers,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int read_queue_free(
+     read_queue_t **read_queue,
+     libcerror_error_t **error );
+
+int read_queue_open(
+     read_queue_t *read_queue,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int read_queue_close(
+     read_queue_t *read_queue,
+     libcerror_error_t **error );
+
+int read_queue_read_callback(
+     read_queue_buffer_t *read_queue_buffer,
+     read_queue_t *read_queue );
+
+ssize_t read_queue_read_buffer(
+         read_queue_t *read_queue,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t read_queue_seek_offset(
+         read_queue_t *read_queue,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _READ_QUEUE_H ) */
+
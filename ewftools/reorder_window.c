@@ -0,0 +1,634 @@
+/*
+ * Reorder window
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "reorder_window.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Define REORDER_WINDOW_USE_MUTEX to use the mutex instead of the atomic operations
+ */
+#if !defined( REORDER_WINDOW_USE_MUTEX )
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define HAVE_REORDER_WINDOW_ATOMICS
+
+#define reorder_window_atomic_compare_and_swap_pointer( pointer, expected_value, value ) \
+	__sync_bool_compare_and_swap( pointer, expected_value, value )
+
+#define reorder_window_atomic_exchange_pointer( pointer, value ) \
+	__atomic_exchange_n( pointer, value, __ATOMIC_SEQ_CST )
+
+#define reorder_window_atomic_load_pointer( pointer ) \
+	__atomic_load_n( pointer, __ATOMIC_SEQ_CST )
+
+#define reorder_window_atomic_compare_and_swap_long( pointer, expected_value, value ) \
+	__sync_bool_compare_and_swap( pointer, expected_value, value )
+
+#define reorder_window_atomic_store_long( pointer, value ) \
+	__atomic_store_n( pointer, value, __ATOMIC_SEQ_CST )
+
+#define reorder_window_atomic_load_uint64( pointer ) \
+	__atomic_load_n( pointer, __ATOMIC_SEQ_CST )
+
+#elif defined( _MSC_VER )
+#define HAVE_REORDER_WINDOW_ATOMICS
+
+#define reorder_window_atomic_compare_and_swap_pointer( pointer, expected_value, value ) \
+	( InterlockedCompareExchangePointer( (PVOID volatile *) pointer, (PVOID) value, (PVOID) expected_value ) == (PVOID) expected_value )
+
+#define reorder_window_atomic_exchange_pointer( pointer, value ) \
+	(intptr_t *) InterlockedExchangePointer( (PVOID volatile *) pointer, (PVOID) value )
+
+#define reorder_window_atomic_load_pointer( pointer ) \
+	(intptr_t *) InterlockedCompareExchangePointer( (PVOID volatile *) pointer, NULL, NULL )
+
+#define reorder_window_atomic_compare_and_swap_long( pointer, expected_value, value ) \
+	( InterlockedCompareExchange( (LONG volatile *) pointer, (LONG) value, (LONG) expected_value ) == (LONG) expected_value )
+
+#define reorder_window_atomic_store_long( pointer, value ) \
+	InterlockedExchange( (LONG volatile *) pointer, (LONG) value )
+
+#define reorder_window_atomic_load_uint64( pointer ) \
+	(uint64_t) InterlockedCompareExchange64( (LONGLONG volatile *) pointer, 0, 0 )
+
+#endif /* defined( __GNUC__ ) || defined( __clang__ ) */
+
+#endif /* !defined( REORDER_WINDOW_USE_MUTEX ) */
+
+/* Creates a reorder window
+ * Make sure the value reorder_window is referencing, is set to NULL
+ * The number of slots must be at least the maximum number of values that are in use at the same time
+ * The output function is called, from one of the threads that push values, for every value
+ * in sequence order. The output function takes over the value and, like a thread pool
+ * callback function, handles its own errors.
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_window_initialize(
+     reorder_window_t **reorder_window,
+     int number_of_slots,
+     int (*output_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *output_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_window_initialize";
+	size_t slots_size     = 0;
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_window != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reorder window value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_slots <= 0 )
+	 || ( (size_t) number_of_slots > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( intptr_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of slots value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output function.",
+		 function );
+
+		return( -1 );
+	}
+	*reorder_window = memory_allocate_structure(
+	                   reorder_window_t );
+
+	if( *reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reorder window.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reorder_window,
+	     0,
+	     sizeof( reorder_window_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reorder window.",
+		 function );
+
+		memory_free(
+		 *reorder_window );
+
+		*reorder_window = NULL;
+
+		return( -1 );
+	}
+	slots_size = sizeof( intptr_t * ) * number_of_slots;
+
+	( *reorder_window )->slots = (intptr_t **) memory_allocate(
+	                                            slots_size );
+
+	if( ( *reorder_window )->slots == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create slots.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *reorder_window )->slots,
+	     0,
+	     slots_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear slots.",
+		 function );
+
+		goto on_error;
+	}
+#if !defined( HAVE_REORDER_WINDOW_ATOMICS )
+	if( libcthreads_mutex_initialize(
+	     &( ( *reorder_window )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *reorder_window )->number_of_slots           = number_of_slots;
+	( *reorder_window )->output_function           = output_function;
+	( *reorder_window )->output_function_arguments = output_function_arguments;
+
+	return( 1 );
+
+on_error:
+	if( *reorder_window != NULL )
+	{
+		if( ( *reorder_window )->slots != NULL )
+		{
+			memory_free(
+			 ( *reorder_window )->slots );
+		}
+		memory_free(
+		 *reorder_window );
+
+		*reorder_window = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a reorder window
+ * Values that remain in the window are not freed, use reorder_window_remove_value to retrieve them
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_window_free(
+     reorder_window_t **reorder_window,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_window_free";
+	int result            = 1;
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reorder_window != NULL )
+	{
+		if( ( *reorder_window )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *reorder_window )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *reorder_window )->slots );
+
+		memory_free(
+		 *reorder_window );
+
+		*reorder_window = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the next sequence number
+ * Sequence numbers must be retrieved by a single thread in the order the values are to be output
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_window_get_next_sequence_number(
+     reorder_window_t *reorder_window,
+     uint64_t *sequence_number,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_window_get_next_sequence_number";
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( sequence_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sequence number.",
+		 function );
+
+		return( -1 );
+	}
+	*sequence_number = reorder_window->next_sequence_number;
+
+	reorder_window->next_sequence_number += 1;
+
+	return( 1 );
+}
+
+/* Retrieves the number of pending values
+ * These are the values of which the sequence number was retrieved but that were not yet output
+ * This function should only be called by the thread that retrieves the sequence numbers
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_window_get_number_of_pending_values(
+     reorder_window_t *reorder_window,
+     uint64_t *number_of_pending_values,
+     libcerror_error_t **error )
+{
+	static char *function           = "reorder_window_get_number_of_pending_values";
+	uint64_t output_sequence_number = 0;
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of pending values.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_REORDER_WINDOW_ATOMICS )
+	output_sequence_number = reorder_window_atomic_load_uint64(
+	                          &( reorder_window->output_sequence_number ) );
+#else
+	if( libcthreads_mutex_grab(
+	     reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	output_sequence_number = reorder_window->output_sequence_number;
+
+	if( libcthreads_mutex_release(
+	     reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_REORDER_WINDOW_ATOMICS ) */
+
+	*number_of_pending_values = reorder_window->next_sequence_number - output_sequence_number;
+
+	return( 1 );
+}
+
+/* Pushes a value onto the reorder window
+ * The value is stored in its slot, after which the thread that pushed the value, outputs
+ * all the values that are next in sequence unless another thread is already doing so.
+ * When atomic operations are available pushing does not lock.
+ * The reorder window only takes over the value if successful
+ * Returns 1 if successful or -1 on error
+ */
+int reorder_window_push(
+     reorder_window_t *reorder_window,
+     uint64_t sequence_number,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	intptr_t *output_value          = NULL;
+	static char *function           = "reorder_window_push";
+	uint64_t output_sequence_number = 0;
+	int slot_index                  = 0;
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	slot_index = (int) ( sequence_number % reorder_window->number_of_slots );
+
+#if defined( HAVE_REORDER_WINDOW_ATOMICS )
+	if( reorder_window_atomic_compare_and_swap_pointer(
+	     &( reorder_window->slots[ slot_index ] ),
+	     NULL,
+	     value ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid slot: %d value already set.",
+		 function,
+		 slot_index );
+
+		return( -1 );
+	}
+	do
+	{
+		/* If another thread is outputting values it will pick up the value
+		 */
+		if( reorder_window_atomic_compare_and_swap_long(
+		     &( reorder_window->is_outputting ),
+		     0,
+		     1 ) == 0 )
+		{
+			break;
+		}
+		do
+		{
+			slot_index = (int) ( reorder_window->output_sequence_number % reorder_window->number_of_slots );
+
+			output_value = reorder_window_atomic_exchange_pointer(
+			                &( reorder_window->slots[ slot_index ] ),
+			                NULL );
+
+			if( output_value != NULL )
+			{
+				reorder_window->output_sequence_number += 1;
+
+				reorder_window->output_function(
+				 output_value,
+				 reorder_window->output_function_arguments );
+			}
+		}
+		while( output_value != NULL );
+
+		output_sequence_number = reorder_window->output_sequence_number;
+
+		reorder_window_atomic_store_long(
+		 &( reorder_window->is_outputting ),
+		 0 );
+
+		/* A value that is next in sequence could have been pushed after the last slot
+		 * was checked but before the other thread could start outputting
+		 */
+		slot_index = (int) ( output_sequence_number % reorder_window->number_of_slots );
+	}
+	while( reorder_window_atomic_load_pointer(
+	        &( reorder_window->slots[ slot_index ] ) ) != NULL );
+
+#else
+	if( libcthreads_mutex_grab(
+	     reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( reorder_window->slots[ slot_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid slot: %d value already set.",
+		 function,
+		 slot_index );
+
+		libcthreads_mutex_release(
+		 reorder_window->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	reorder_window->slots[ slot_index ] = value;
+
+	do
+	{
+		slot_index = (int) ( reorder_window->output_sequence_number % reorder_window->number_of_slots );
+
+		output_value = reorder_window->slots[ slot_index ];
+
+		if( output_value != NULL )
+		{
+			reorder_window->slots[ slot_index ] = NULL;
+
+			reorder_window->output_sequence_number += 1;
+
+			reorder_window->output_function(
+			 output_value,
+			 reorder_window->output_function_arguments );
+		}
+	}
+	while( output_value != NULL );
+
+	if( libcthreads_mutex_release(
+	     reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif /* defined( HAVE_REORDER_WINDOW_ATOMICS ) */
+
+	return( 1 );
+}
+
+/* Removes a value that remains in the reorder window
+ * This function should only be called when no other thread pushes values
+ * Returns 1 if successful, 0 if no value remains or -1 on error
+ */
+int reorder_window_remove_value(
+     reorder_window_t *reorder_window,
+     intptr_t **value,
+     libcerror_error_t **error )
+{
+	static char *function = "reorder_window_remove_value";
+	int slot_index        = 0;
+
+	if( reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	for( slot_index = 0;
+	     slot_index < reorder_window->number_of_slots;
+	     slot_index++ )
+	{
+		if( reorder_window->slots[ slot_index ] != NULL )
+		{
+			*value = reorder_window->slots[ slot_index ];
+
+			reorder_window->slots[ slot_index ] = NULL;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,117 @@
+/*
+ * Reorder window
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _REORDER_WINDOW_H )
+#define _REORDER_WINDOW_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct reorder_window reorder_window_t;
+
+struct reorder_window
+{
+	/* The slots, a value is stored in the slot: sequence number % number of slots
+	 */
+	intptr_t **slots;
+
+	/* The number of slots
+	 */
+	int number_of_slots;
+
+	/* The next sequence number to assign
+	 */
+	uint64_t next_sequence_number;
+
+	/* The sequence number of the next value to output
+	 */
+	uint64_t output_sequence_number;
+
+	/* The output function, which is called for every value in sequence order
+	 */
+	int (*output_function)(
+	       intptr_t *value,
+	       void *arguments );
+
+	/* The output function arguments
+	 */
+	void *output_function_arguments;
+
+	/* Value to indicate a thread is outputting values
+	 */
+	long is_outputting;
+
+	/* The mutex, only used when atomic operations are not available
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+int reorder_window_initialize(
+     reorder_window_t **reorder_window,
+     int number_of_slots,
+     int (*output_function)(
+            intptr_t *value,
+            void *arguments ),
+     void *output_function_arguments,
+     libcerror_error_t **error );
+
+int reorder_window_free(
+     reorder_window_t **reorder_window,
+     libcerror_error_t **error );
+
+int reorder_window_get_next_sequence_number(
+     reorder_window_t *reorder_window,
+     uint64_t *sequence_number,
+     libcerror_error_t **error );
+
+int reorder_window_get_number_of_pending_values(
+     reorder_window_t *reorder_window,
+     uint64_t *number_of_pending_values,
+     libcerror_error_t **error );
+
+int reorder_window_push(
+     reorder_window_t *reorder_window,
+     uint64_t sequence_number,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int reorder_window_remove_value(
+     reorder_window_t *reorder_window,
+     intptr_t **value,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _REORDER_WINDOW_H ) */
+
@@ -0,0 +1,1386 @@
+/*
+ * Rescue map
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcfile.h"
+#include "rescue_map.h"
+
+/* The rescue map file contains:
+ *   a header of 40 bytes: signature "ewfrsmap", format version, number of ranges,
+ *   offset and size of the area, an Adler-32 checksum of the ranges and 4 bytes of padding
+ *   followed by the ranges: a 64-bit offset, a 64-bit size and a 32-bit status
+ *
+ * All values are stored in little-endian
+ */
+
+#define RESCUE_MAP_FORMAT_VERSION	1
+
+#define RESCUE_MAP_EXTENSION		".map"
+#define RESCUE_MAP_EXTENSION_SIZE	5
+
+static const uint8_t rescue_map_signature[ 8 ] = { 'e', 'w', 'f', 'r', 's', 'm', 'a', 'p' };
+
+/* Calculates the Adler-32 of a buffer
+ */
+static uint32_t rescue_map_calculate_checksum(
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	size_t buffer_offset = 0;
+	uint32_t lower_word  = 1;
+	uint32_t upper_word  = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		lower_word = ( lower_word + buffer[ buffer_offset ] ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Creates a rescue map
+ * Make sure the value rescue_map is referencing, is set to NULL
+ * The map initially consists of a single non-tried range that covers the area
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_initialize(
+     rescue_map_t **rescue_map,
+     uint64_t offset,
+     uint64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_initialize";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_map != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid rescue map value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (uint64_t) INT64_MAX )
+	 || ( offset > ( (uint64_t) INT64_MAX - size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*rescue_map = memory_allocate_structure(
+	               rescue_map_t );
+
+	if( *rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create rescue map.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *rescue_map,
+	     0,
+	     sizeof( rescue_map_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear rescue map.",
+		 function );
+
+		memory_free(
+		 *rescue_map );
+
+		*rescue_map = NULL;
+
+		return( -1 );
+	}
+	( *rescue_map )->ranges = memory_allocate_structure(
+	                           rescue_map_range_t );
+
+	if( ( *rescue_map )->ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ranges.",
+		 function );
+
+		goto on_error;
+	}
+	( *rescue_map )->ranges[ 0 ].offset = offset;
+	( *rescue_map )->ranges[ 0 ].size   = size;
+	( *rescue_map )->ranges[ 0 ].status = RESCUE_MAP_STATUS_NON_TRIED;
+
+	( *rescue_map )->offset           = offset;
+	( *rescue_map )->size             = size;
+	( *rescue_map )->number_of_ranges = 1;
+
+	return( 1 );
+
+on_error:
+	if( *rescue_map != NULL )
+	{
+		memory_free(
+		 *rescue_map );
+
+		*rescue_map = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a rescue map
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_free(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_free";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( *rescue_map != NULL )
+	{
+		if( ( *rescue_map )->filename != NULL )
+		{
+			memory_free(
+			 ( *rescue_map )->filename );
+		}
+		if( ( *rescue_map )->ranges != NULL )
+		{
+			memory_free(
+			 ( *rescue_map )->ranges );
+		}
+		memory_free(
+		 *rescue_map );
+
+		*rescue_map = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the filename
+ * The filename is the image path and filename without extension, to which the map extension is added
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_set_filename(
+     rescue_map_t *rescue_map,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	static char *function  = "rescue_map_set_filename";
+	size_t extension_index = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename_length == 0 )
+	 || ( filename_length > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE - RESCUE_MAP_EXTENSION_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map->filename != NULL )
+	{
+		memory_free(
+		 rescue_map->filename );
+
+		rescue_map->filename      = NULL;
+		rescue_map->filename_size = 0;
+	}
+	rescue_map->filename_size = filename_length + RESCUE_MAP_EXTENSION_SIZE;
+
+	rescue_map->filename = system_string_allocate(
+	                        rescue_map->filename_size );
+
+	if( rescue_map->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     rescue_map->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	for( extension_index = 0;
+	     extension_index < RESCUE_MAP_EXTENSION_SIZE;
+	     extension_index++ )
+	{
+		rescue_map->filename[ filename_length + extension_index ] = (system_character_t) RESCUE_MAP_EXTENSION[ extension_index ];
+	}
+	return( 1 );
+
+on_error:
+	if( rescue_map->filename != NULL )
+	{
+		memory_free(
+		 rescue_map->filename );
+
+		rescue_map->filename = NULL;
+	}
+	rescue_map->filename_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves a specific range
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_get_range_by_index(
+     rescue_map_t *rescue_map,
+     int range_index,
+     uint64_t *offset,
+     uint64_t *size,
+     uint8_t *status,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_range_by_index";
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( range_index < 0 )
+	 || ( range_index >= rescue_map->number_of_ranges ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid status.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = rescue_map->ranges[ range_index ].offset;
+	*size   = rescue_map->ranges[ range_index ].size;
+	*status = rescue_map->ranges[ range_index ].status;
+
+	return( 1 );
+}
+
+/* Retrieves the range that contains a specific offset
+ * Returns 1 if successful, 0 if the offset is outside the area of the map or -1 on error
+ */
+int rescue_map_get_range_at_offset(
+     rescue_map_t *rescue_map,
+     uint64_t offset,
+     uint64_t *range_offset,
+     uint64_t *range_size,
+     uint8_t *status,
+     libcerror_error_t **error )
+{
+	rescue_map_range_t *range = NULL;
+	static char *function     = "rescue_map_get_range_at_offset";
+	int first_range_index     = 0;
+	int last_range_index      = 0;
+	int range_index           = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( status == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid status.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_map->offset )
+	 || ( ( offset - rescue_map->offset ) >= rescue_map->size ) )
+	{
+		return( 0 );
+	}
+	/* The ranges are sorted and contiguous so a binary search is used
+	 */
+	last_range_index = rescue_map->number_of_ranges - 1;
+
+	while( first_range_index <= last_range_index )
+	{
+		range_index = first_range_index + ( ( last_range_index - first_range_index ) / 2 );
+
+		range = &( rescue_map->ranges[ range_index ] );
+
+		if( offset < range->offset )
+		{
+			last_range_index = range_index - 1;
+		}
+		else if( ( offset - range->offset ) >= range->size )
+		{
+			first_range_index = range_index + 1;
+		}
+		else
+		{
+			*range_offset = range->offset;
+			*range_size   = range->size;
+			*status       = range->status;
+
+			return( 1 );
+		}
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+	 "%s: missing range for offset: %" PRIu64 ".",
+	 function,
+	 offset );
+
+	return( -1 );
+}
+
+/* Sets the status of a range
+ * Existing ranges are split where necessary and adjacent ranges with the same status are merged
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_set_range(
+     rescue_map_t *rescue_map,
+     uint64_t offset,
+     uint64_t size,
+     uint8_t status,
+     libcerror_error_t **error )
+{
+	rescue_map_range_t *ranges = NULL;
+	rescue_map_range_t *range  = NULL;
+	static char *function      = "rescue_map_set_range";
+	uint64_t end_offset        = 0;
+	uint64_t range_end_offset  = 0;
+	int number_of_ranges       = 0;
+	int range_index            = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < rescue_map->offset )
+	 || ( size == 0 )
+	 || ( ( offset - rescue_map->offset ) > rescue_map->size )
+	 || ( size > ( rescue_map->size - ( offset - rescue_map->offset ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( status > RESCUE_MAP_STATUS_FINISHED )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported status: %" PRIu8 ".",
+		 function,
+		 status );
+
+		return( -1 );
+	}
+	if( rescue_map->number_of_ranges > ( INT_MAX - 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid rescue map - number of ranges value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = offset + size;
+
+	/* The new range can split a single existing range into 3 ranges
+	 */
+	ranges = (rescue_map_range_t *) memory_allocate(
+	                                 sizeof( rescue_map_range_t ) * (size_t) ( rescue_map->number_of_ranges + 2 ) );
+
+	if( ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create ranges.",
+		 function );
+
+		return( -1 );
+	}
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		range            = &( rescue_map->ranges[ range_index ] );
+		range_end_offset = range->offset + range->size;
+
+		/* The part of the range before the new range
+		 */
+		if( range->offset < offset )
+		{
+			ranges[ number_of_ranges ].offset = range->offset;
+			ranges[ number_of_ranges ].status = range->status;
+
+			if( range_end_offset < offset )
+			{
+				ranges[ number_of_ranges ].size = range->size;
+			}
+			else
+			{
+				ranges[ number_of_ranges ].size = offset - range->offset;
+			}
+			number_of_ranges++;
+		}
+		/* The new range is inserted in the place of the range that contains its end
+		 */
+		if( ( range->offset < end_offset )
+		 && ( range_end_offset >= end_offset ) )
+		{
+			ranges[ number_of_ranges ].offset = offset;
+			ranges[ number_of_ranges ].size   = size;
+			ranges[ number_of_ranges ].status = status;
+
+			number_of_ranges++;
+		}
+		/* The part of the range after the new range
+		 */
+		if( range_end_offset > end_offset )
+		{
+			if( range->offset < end_offset )
+			{
+				ranges[ number_of_ranges ].offset = end_offset;
+				ranges[ number_of_ranges ].size   = range_end_offset - end_offset;
+			}
+			else
+			{
+				ranges[ number_of_ranges ].offset = range->offset;
+				ranges[ number_of_ranges ].size   = range->size;
+			}
+			ranges[ number_of_ranges ].status = range->status;
+
+			number_of_ranges++;
+		}
+		/* Merge with the previous range if the status is the same
+		 */
+		while( ( number_of_ranges > 1 )
+		    && ( ranges[ number_of_ranges - 2 ].status == ranges[ number_of_ranges - 1 ].status ) )
+		{
+			ranges[ number_of_ranges - 2 ].size += ranges[ number_of_ranges - 1 ].size;
+
+			number_of_ranges--;
+		}
+	}
+	memory_free(
+	 rescue_map->ranges );
+
+	rescue_map->ranges           = ranges;
+	rescue_map->number_of_ranges = number_of_ranges;
+
+	return( 1 );
+}
+
+/* Retrieves the number of ranges with a specific status
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_get_number_of_ranges_by_status(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     int *number_of_ranges,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_number_of_ranges_by_status";
+	int range_index       = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_ranges == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of ranges.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_ranges = 0;
+
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		if( rescue_map->ranges[ range_index ].status == status )
+		{
+			*number_of_ranges += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific range with a specific status
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_get_range_by_status(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     int status_range_index,
+     uint64_t *offset,
+     uint64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "rescue_map_get_range_by_status";
+	int range_index       = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( status_range_index >= 0 )
+	{
+		for( range_index = 0;
+		     range_index < rescue_map->number_of_ranges;
+		     range_index++ )
+		{
+			if( rescue_map->ranges[ range_index ].status != status )
+			{
+				continue;
+			}
+			if( status_range_index == 0 )
+			{
+				*offset = rescue_map->ranges[ range_index ].offset;
+				*size   = rescue_map->ranges[ range_index ].size;
+
+				return( 1 );
+			}
+			status_range_index--;
+		}
+	}
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+	 "%s: invalid status range index value out of bounds.",
+	 function );
+
+	return( -1 );
+}
+
+/* Reads the rescue map file
+ * Returns 1 if successful, 0 if the rescue map file does not exist or does not apply or -1 on error
+ */
+int rescue_map_read(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error )
+{
+	uint8_t header_data[ RESCUE_MAP_HEADER_SIZE ];
+
+	libcfile_file_t *file        = NULL;
+	rescue_map_range_t *ranges   = NULL;
+	uint8_t *ranges_data         = NULL;
+	static char *function        = "rescue_map_read";
+	size64_t file_size           = 0;
+	size_t data_offset           = 0;
+	size_t ranges_data_size      = 0;
+	ssize_t read_count           = 0;
+	uint64_t area_offset         = 0;
+	uint64_t area_size           = 0;
+	uint64_t expected_offset     = 0;
+	uint32_t calculated_checksum = 0;
+	uint32_t format_version      = 0;
+	uint32_t number_of_ranges    = 0;
+	uint32_t status              = 0;
+	uint32_t stored_checksum     = 0;
+	int range_index              = 0;
+	int result                   = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue map - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          rescue_map->filename,
+	          error );
+#else
+	result = libcfile_file_exists(
+	          rescue_map->filename,
+	          error );
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if rescue map file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          rescue_map->filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          rescue_map->filename,
+	          LIBCFILE_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_get_size(
+	     file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve rescue map file size.",
+		 function );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( file_size >= RESCUE_MAP_HEADER_SIZE )
+	{
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              header_data,
+		              RESCUE_MAP_HEADER_SIZE,
+		              error );
+
+		if( read_count != (ssize_t) RESCUE_MAP_HEADER_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read rescue map file header.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 8 ] ),
+		 format_version );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 12 ] ),
+		 number_of_ranges );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( header_data[ 16 ] ),
+		 area_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( header_data[ 24 ] ),
+		 area_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( header_data[ 32 ] ),
+		 stored_checksum );
+
+		/* A rescue map file that was created for a different area does not apply
+		 */
+		if( ( memory_compare(
+		       header_data,
+		       rescue_map_signature,
+		       8 ) == 0 )
+		 && ( format_version == RESCUE_MAP_FORMAT_VERSION )
+		 && ( number_of_ranges > 0 )
+		 && ( number_of_ranges <= (uint32_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / RESCUE_MAP_RANGE_SIZE ) )
+		 && ( area_offset == rescue_map->offset )
+		 && ( area_size == rescue_map->size )
+		 && ( file_size == (size64_t) ( RESCUE_MAP_HEADER_SIZE + ( (size64_t) number_of_ranges * RESCUE_MAP_RANGE_SIZE ) ) ) )
+		{
+			result = 1;
+		}
+	}
+	if( result != 0 )
+	{
+		ranges_data_size = (size_t) number_of_ranges * RESCUE_MAP_RANGE_SIZE;
+
+		ranges_data = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * ranges_data_size );
+
+		if( ranges_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create ranges data.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libcfile_file_read_buffer(
+		              file,
+		              ranges_data,
+		              ranges_data_size,
+		              error );
+
+		if( read_count != (ssize_t) ranges_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read rescue map file ranges.",
+			 function );
+
+			goto on_error;
+		}
+		calculated_checksum = rescue_map_calculate_checksum(
+		                       ranges_data,
+		                       ranges_data_size );
+
+		if( stored_checksum != calculated_checksum )
+		{
+			result = 0;
+		}
+	}
+	if( result != 0 )
+	{
+		ranges = (rescue_map_range_t *) memory_allocate(
+		                                 sizeof( rescue_map_range_t ) * (size_t) number_of_ranges );
+
+		if( ranges == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create ranges.",
+			 function );
+
+			goto on_error;
+		}
+		expected_offset = area_offset;
+
+		/* The ranges must be contiguous and cover the entire area
+		 */
+		for( range_index = 0;
+		     range_index < (int) number_of_ranges;
+		     range_index++ )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( ranges_data[ data_offset ] ),
+			 ranges[ range_index ].offset );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 &( ranges_data[ data_offset + 8 ] ),
+			 ranges[ range_index ].size );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 &( ranges_data[ data_offset + 16 ] ),
+			 status );
+
+			data_offset += RESCUE_MAP_RANGE_SIZE;
+
+			if( ( ranges[ range_index ].offset != expected_offset )
+			 || ( ranges[ range_index ].size == 0 )
+			 || ( ranges[ range_index ].size > ( area_size - ( expected_offset - area_offset ) ) )
+			 || ( status > RESCUE_MAP_STATUS_FINISHED ) )
+			{
+				result = 0;
+
+				break;
+			}
+			ranges[ range_index ].status = (uint8_t) status;
+
+			expected_offset += ranges[ range_index ].size;
+		}
+		if( expected_offset != ( area_offset + area_size ) )
+		{
+			result = 0;
+		}
+		if( result != 0 )
+		{
+			memory_free(
+			 rescue_map->ranges );
+
+			rescue_map->ranges           = ranges;
+			rescue_map->number_of_ranges = (int) number_of_ranges;
+
+			ranges = NULL;
+		}
+	}
+	if( ranges != NULL )
+	{
+		memory_free(
+		 ranges );
+
+		ranges = NULL;
+	}
+	if( ranges_data != NULL )
+	{
+		memory_free(
+		 ranges_data );
+
+		ranges_data = NULL;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( ranges != NULL )
+	{
+		memory_free(
+		 ranges );
+	}
+	if( ranges_data != NULL )
+	{
+		memory_free(
+		 ranges_data );
+	}
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the rescue map file
+ * Returns 1 if successful or -1 on error
+ */
+int rescue_map_write(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *file     = NULL;
+	rescue_map_range_t *range = NULL;
+	uint8_t *data             = NULL;
+	static char *function     = "rescue_map_write";
+	size_t data_offset        = 0;
+	size_t data_size          = 0;
+	ssize_t write_count       = 0;
+	uint32_t checksum         = 0;
+	int range_index           = 0;
+	int result                = 0;
+
+	if( rescue_map == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid rescue map.",
+		 function );
+
+		return( -1 );
+	}
+	if( rescue_map->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid rescue map - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( rescue_map->number_of_ranges <= 0 )
+	 || ( (size_t) rescue_map->number_of_ranges > ( ( MEMORY_MAXIMUM_ALLOCATION_SIZE - RESCUE_MAP_HEADER_SIZE ) / RESCUE_MAP_RANGE_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid rescue map - number of ranges value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = RESCUE_MAP_HEADER_SIZE + ( (size_t) rescue_map->number_of_ranges * RESCUE_MAP_RANGE_SIZE );
+
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * data_size );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     RESCUE_MAP_HEADER_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear header.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = RESCUE_MAP_HEADER_SIZE;
+
+	for( range_index = 0;
+	     range_index < rescue_map->number_of_ranges;
+	     range_index++ )
+	{
+		range = &( rescue_map->ranges[ range_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ data_offset ] ),
+		 range->offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ data_offset + 8 ] ),
+		 range->size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( data[ data_offset + 16 ] ),
+		 (uint32_t) range->status );
+
+		data_offset += RESCUE_MAP_RANGE_SIZE;
+	}
+	checksum = rescue_map_calculate_checksum(
+	            &( data[ RESCUE_MAP_HEADER_SIZE ] ),
+	            data_size - RESCUE_MAP_HEADER_SIZE );
+
+	if( memory_copy(
+	     data,
+	     rescue_map_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 8 ] ),
+	 RESCUE_MAP_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 12 ] ),
+	 (uint32_t) rescue_map->number_of_ranges );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 16 ] ),
+	 rescue_map->offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 24 ] ),
+	 rescue_map->size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 32 ] ),
+	 checksum );
+
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          rescue_map->filename,
+	          LIBCFILE_OPEN_WRITE_TRUNCATE,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          rescue_map->filename,
+	          LIBCFILE_OPEN_WRITE_TRUNCATE,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libcfile_file_write_buffer(
+	               file,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close rescue map file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( -1 );
+}
+
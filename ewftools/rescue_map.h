@@ -0,0 +1,168 @@
+/*
+ * Rescue map
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _RESCUE_MAP_H )
+#define _RESCUE_MAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define RESCUE_MAP_HEADER_SIZE		40
+#define RESCUE_MAP_RANGE_SIZE		20
+
+enum RESCUE_MAP_STATUSES
+{
+	/* The range has not been read
+	 */
+	RESCUE_MAP_STATUS_NON_TRIED		= 0,
+
+	/* Reading the range failed and it still needs to be split into smaller blocks
+	 */
+	RESCUE_MAP_STATUS_NON_SPLIT		= 1,
+
+	/* Reading the range failed at the smallest block size
+	 */
+	RESCUE_MAP_STATUS_BAD			= 2,
+
+	/* The range was read successfully
+	 */
+	RESCUE_MAP_STATUS_FINISHED		= 3
+};
+
+typedef struct rescue_map_range rescue_map_range_t;
+
+struct rescue_map_range
+{
+	/* The offset
+	 */
+	uint64_t offset;
+
+	/* The size
+	 */
+	uint64_t size;
+
+	/* The status
+	 */
+	uint8_t status;
+};
+
+typedef struct rescue_map rescue_map_t;
+
+struct rescue_map
+{
+	/* The filename
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The offset of the area the map applies to
+	 */
+	uint64_t offset;
+
+	/* The size of the area the map applies to
+	 */
+	uint64_t size;
+
+	/* The ranges, these are sorted by offset and cover the entire area
+	 */
+	rescue_map_range_t *ranges;
+
+	/* The number of ranges
+	 */
+	int number_of_ranges;
+};
+
+int rescue_map_initialize(
+     rescue_map_t **rescue_map,
+     uint64_t offset,
+     uint64_t size,
+     libcerror_error_t **error );
+
+int rescue_map_free(
+     rescue_map_t **rescue_map,
+     libcerror_error_t **error );
+
+int rescue_map_set_filename(
+     rescue_map_t *rescue_map,
+     const system_character_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+int rescue_map_get_range_by_index(
+     rescue_map_t *rescue_map,
+     int range_index,
+     uint64_t *offset,
+     uint64_t *size,
+     uint8_t *status,
+     libcerror_error_t **error );
+
+int rescue_map_get_range_at_offset(
+     rescue_map_t *rescue_map,
+     uint64_t offset,
+     uint64_t *range_offset,
+     uint64_t *range_size,
+     uint8_t *status,
+     libcerror_error_t **error );
+
+int rescue_map_set_range(
+     rescue_map_t *rescue_map,
+     uint64_t offset,
+     uint64_t size,
+     uint8_t status,
+     libcerror_error_t **error );
+
+int rescue_map_get_number_of_ranges_by_status(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     int *number_of_ranges,
+     libcerror_error_t **error );
+
+int rescue_map_get_range_by_status(
+     rescue_map_t *rescue_map,
+     uint8_t status,
+     int status_range_index,
+     uint64_t *offset,
+     uint64_t *size,
+     libcerror_error_t **error );
+
+int rescue_map_read(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error );
+
+int rescue_map_write(
+     rescue_map_t *rescue_map,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _RESCUE_MAP_H ) */
+
@@ -0,0 +1,577 @@
+/*
+ * Sample scheduler
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "sample_scheduler.h"
+
+/* The number of chunk indexes that are allocated at once
+ */
+#define SAMPLE_SCHEDULER_ALLOCATION_SIZE	1024
+
+/* Creates a sample scheduler
+ * Make sure the value sample_scheduler is referencing, is set to NULL
+ * The seed is used to initialize the pseudo random number generator
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_initialize(
+     sample_scheduler_t **sample_scheduler,
+     uint64_t number_of_chunks,
+     uint64_t seed,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_initialize";
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sample_scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sample scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*sample_scheduler = memory_allocate_structure(
+	                     sample_scheduler_t );
+
+	if( *sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sample scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sample_scheduler,
+	     0,
+	     sizeof( sample_scheduler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sample scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	( *sample_scheduler )->number_of_chunks = number_of_chunks;
+
+	/* The state of the xorshift generator cannot be 0
+	 */
+	( *sample_scheduler )->random_state = seed ^ 0x9e3779b97f4a7c15ULL;
+
+	if( ( *sample_scheduler )->random_state == 0 )
+	{
+		( *sample_scheduler )->random_state = 0x9e3779b97f4a7c15ULL;
+	}
+	return( 1 );
+
+on_error:
+	if( *sample_scheduler != NULL )
+	{
+		memory_free(
+		 *sample_scheduler );
+
+		*sample_scheduler = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sample scheduler
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_free(
+     sample_scheduler_t **sample_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_free";
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sample_scheduler != NULL )
+	{
+		if( ( *sample_scheduler )->chunk_indexes != NULL )
+		{
+			memory_free(
+			 ( *sample_scheduler )->chunk_indexes );
+		}
+		memory_free(
+		 *sample_scheduler );
+
+		*sample_scheduler = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves a pseudo random value in the range 0 to maximum value - 1
+ * The values are generated with xorshift64*, which is not suitable for cryptographic use
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_get_random_value(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t maximum_value,
+     uint64_t *random_value,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_get_random_value";
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_value == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum value value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( random_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid random value.",
+		 function );
+
+		return( -1 );
+	}
+	sample_scheduler->random_state ^= sample_scheduler->random_state >> 12;
+	sample_scheduler->random_state ^= sample_scheduler->random_state << 25;
+	sample_scheduler->random_state ^= sample_scheduler->random_state >> 27;
+
+	*random_value = ( sample_scheduler->random_state * 0x2545f4914f6cdd1dULL ) % maximum_value;
+
+	return( 1 );
+}
+
+/* Appends a chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_append_chunk_index(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	uint64_t *reallocation                     = NULL;
+	static char *function                      = "sample_scheduler_append_chunk_index";
+	uint64_t number_of_allocated_chunk_indexes = 0;
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index >= sample_scheduler->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_scheduler->number_of_chunk_indexes >= sample_scheduler->number_of_allocated_chunk_indexes )
+	{
+		number_of_allocated_chunk_indexes = sample_scheduler->number_of_allocated_chunk_indexes + SAMPLE_SCHEDULER_ALLOCATION_SIZE;
+
+		if( number_of_allocated_chunk_indexes > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated chunk indexes value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		reallocation = (uint64_t *) memory_reallocate(
+		                             sample_scheduler->chunk_indexes,
+		                             sizeof( uint64_t ) * (size_t) number_of_allocated_chunk_indexes );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize chunk indexes.",
+			 function );
+
+			return( -1 );
+		}
+		sample_scheduler->chunk_indexes                     = reallocation;
+		sample_scheduler->number_of_allocated_chunk_indexes = number_of_allocated_chunk_indexes;
+	}
+	sample_scheduler->chunk_indexes[ sample_scheduler->number_of_chunk_indexes ] = chunk_index;
+
+	sample_scheduler->number_of_chunk_indexes += 1;
+
+	return( 1 );
+}
+
+/* Appends a random sample of chunk indexes
+ * The chunk indexes are selected without replacement, in ascending order,
+ * using selection sampling (Knuth's algorithm S)
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_append_random_sample(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t number_of_samples,
+     libcerror_error_t **error )
+{
+	static char *function       = "sample_scheduler_append_random_sample";
+	uint64_t chunk_index        = 0;
+	uint64_t number_of_selected = 0;
+	uint64_t random_value       = 0;
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_samples > sample_scheduler->number_of_chunks )
+	{
+		number_of_samples = sample_scheduler->number_of_chunks;
+	}
+	for( chunk_index = 0;
+	     chunk_index < sample_scheduler->number_of_chunks;
+	     chunk_index++ )
+	{
+		if( number_of_selected >= number_of_samples )
+		{
+			break;
+		}
+		if( sample_scheduler_get_random_value(
+		     sample_scheduler,
+		     sample_scheduler->number_of_chunks - chunk_index,
+		     &random_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve random value.",
+			 function );
+
+			return( -1 );
+		}
+		/* Select the chunk with probability: remaining samples / remaining chunks
+		 */
+		if( random_value < ( number_of_samples - number_of_selected ) )
+		{
+			if( sample_scheduler_append_chunk_index(
+			     sample_scheduler,
+			     chunk_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk index: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			number_of_selected++;
+		}
+	}
+	return( 1 );
+}
+
+/* Appends a range of chunk indexes
+ * The range is truncated to the number of chunks in the media
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_append_range(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t first_chunk_index,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_append_range";
+	uint64_t chunk_index  = 0;
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_chunk_index >= sample_scheduler->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid first chunk index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunks > ( sample_scheduler->number_of_chunks - first_chunk_index ) )
+	{
+		number_of_chunks = sample_scheduler->number_of_chunks - first_chunk_index;
+	}
+	for( chunk_index = first_chunk_index;
+	     chunk_index < ( first_chunk_index + number_of_chunks );
+	     chunk_index++ )
+	{
+		if( sample_scheduler_append_chunk_index(
+		     sample_scheduler,
+		     chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk index: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Compares two chunk indexes
+ * Returns -1 if the first is smaller, 1 if the first is larger or 0 if equal
+ */
+int sample_scheduler_compare_chunk_indexes(
+     const void *first_chunk_index,
+     const void *second_chunk_index )
+{
+	uint64_t first_value  = *( (const uint64_t *) first_chunk_index );
+	uint64_t second_value = *( (const uint64_t *) second_chunk_index );
+
+	if( first_value < second_value )
+	{
+		return( -1 );
+	}
+	else if( first_value > second_value )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sorts the chunk indexes and removes duplicates
+ * The chunks of an EWF image are stored in ascending order over the segment files,
+ * hence sorting the chunk indexes orders the reads by segment file and offset
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_sort(
+     sample_scheduler_t *sample_scheduler,
+     libcerror_error_t **error )
+{
+	static char *function    = "sample_scheduler_sort";
+	uint64_t index           = 0;
+	uint64_t number_of_items = 0;
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_scheduler->number_of_chunk_indexes > 1 )
+	{
+		qsort(
+		 sample_scheduler->chunk_indexes,
+		 (size_t) sample_scheduler->number_of_chunk_indexes,
+		 sizeof( uint64_t ),
+		 &sample_scheduler_compare_chunk_indexes );
+
+		number_of_items = 1;
+
+		for( index = 1;
+		     index < sample_scheduler->number_of_chunk_indexes;
+		     index++ )
+		{
+			if( sample_scheduler->chunk_indexes[ index ] != sample_scheduler->chunk_indexes[ number_of_items - 1 ] )
+			{
+				sample_scheduler->chunk_indexes[ number_of_items++ ] = sample_scheduler->chunk_indexes[ index ];
+			}
+		}
+		sample_scheduler->number_of_chunk_indexes = number_of_items;
+	}
+	sample_scheduler->next_chunk_index = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the number of chunk indexes
+ * Returns 1 if successful or -1 on error
+ */
+int sample_scheduler_get_number_of_chunk_indexes(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t *number_of_chunk_indexes,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_get_number_of_chunk_indexes";
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunk indexes.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_chunk_indexes = sample_scheduler->number_of_chunk_indexes;
+
+	return( 1 );
+}
+
+/* Retrieves the next chunk index to sample
+ * This function is not multi-thread safe
+ * Returns 1 if successful, 0 if no more chunk indexes are available or -1 on error
+ */
+int sample_scheduler_get_next_chunk_index(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t *chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "sample_scheduler_get_next_chunk_index";
+
+	if( sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( sample_scheduler->next_chunk_index >= sample_scheduler->number_of_chunk_indexes )
+	{
+		return( 0 );
+	}
+	*chunk_index = sample_scheduler->chunk_indexes[ sample_scheduler->next_chunk_index ];
+
+	sample_scheduler->next_chunk_index += 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,118 @@
+/*
+ * Sample scheduler
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SAMPLE_SCHEDULER_H )
+#define _SAMPLE_SCHEDULER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct sample_scheduler sample_scheduler_t;
+
+struct sample_scheduler
+{
+	/* The number of chunks in the media
+	 */
+	uint64_t number_of_chunks;
+
+	/* The chunk indexes to sample
+	 */
+	uint64_t *chunk_indexes;
+
+	/* The number of chunk indexes
+	 */
+	uint64_t number_of_chunk_indexes;
+
+	/* The number of allocated chunk indexes
+	 */
+	uint64_t number_of_allocated_chunk_indexes;
+
+	/* The index of the next chunk index to return
+	 */
+	uint64_t next_chunk_index;
+
+	/* The pseudo random number generator state
+	 */
+	uint64_t random_state;
+};
+
+int sample_scheduler_initialize(
+     sample_scheduler_t **sample_scheduler,
+     uint64_t number_of_chunks,
+     uint64_t seed,
+     libcerror_error_t **error );
+
+int sample_scheduler_free(
+     sample_scheduler_t **sample_scheduler,
+     libcerror_error_t **error );
+
+int sample_scheduler_get_random_value(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t maximum_value,
+     uint64_t *random_value,
+     libcerror_error_t **error );
+
+int sample_scheduler_append_chunk_index(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int sample_scheduler_append_random_sample(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t number_of_samples,
+     libcerror_error_t **error );
+
+int sample_scheduler_append_range(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t first_chunk_index,
+     uint64_t number_of_chunks,
+     libcerror_error_t **error );
+
+int sample_scheduler_compare_chunk_indexes(
+     const void *first_chunk_index,
+     const void *second_chunk_index );
+
+int sample_scheduler_sort(
+     sample_scheduler_t *sample_scheduler,
+     libcerror_error_t **error );
+
+int sample_scheduler_get_number_of_chunk_indexes(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t *number_of_chunk_indexes,
+     libcerror_error_t **error );
+
+int sample_scheduler_get_next_chunk_index(
+     sample_scheduler_t *sample_scheduler,
+     uint64_t *chunk_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SAMPLE_SCHEDULER_H ) */
+
@@ -0,0 +1,1507 @@
+/*
+ * Split raw output writer
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "split_raw_writer.h"
+#include "storage_media_buffer.h"
+
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+/* Creates a split raw writer
+ * Make sure the value split_raw_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_initialize(
+     split_raw_writer_t **split_raw_writer,
+     const char *basename,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_initialize";
+	size_t basename_size  = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *split_raw_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid split raw writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	basename_size = narrow_string_length(
+	                 basename ) + 1;
+
+	if( basename_size == 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid basename value too small.",
+		 function );
+
+		return( -1 );
+	}
+	*split_raw_writer = memory_allocate_structure(
+	                     split_raw_writer_t );
+
+	if( *split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create split raw writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *split_raw_writer,
+	     0,
+	     sizeof( split_raw_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear split raw writer.",
+		 function );
+
+		memory_free(
+		 *split_raw_writer );
+
+		*split_raw_writer = NULL;
+
+		return( -1 );
+	}
+	( *split_raw_writer )->basename = narrow_string_allocate(
+	                                   basename_size );
+
+	if( ( *split_raw_writer )->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     ( *split_raw_writer )->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	( *split_raw_writer )->basename[ basename_size - 1 ] = 0;
+
+	( *split_raw_writer )->basename_size = basename_size;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *split_raw_writer )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *split_raw_writer != NULL )
+	{
+		if( ( *split_raw_writer )->basename != NULL )
+		{
+			memory_free(
+			 ( *split_raw_writer )->basename );
+		}
+		memory_free(
+		 *split_raw_writer );
+
+		*split_raw_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a split raw writer
+ * The writer threads are joined and the segment files are closed if this was not done before
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_free(
+     split_raw_writer_t **split_raw_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_free";
+	int result            = 1;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *split_raw_writer != NULL )
+	{
+		if( ( *split_raw_writer )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *split_raw_writer )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join writer thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( split_raw_writer_close_segment_files(
+		     *split_raw_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close segment files.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *split_raw_writer )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *split_raw_writer )->segment_file_remaining_sizes != NULL )
+		{
+			memory_free(
+			 ( *split_raw_writer )->segment_file_remaining_sizes );
+		}
+		if( ( *split_raw_writer )->segment_file_descriptors != NULL )
+		{
+			memory_free(
+			 ( *split_raw_writer )->segment_file_descriptors );
+		}
+		memory_free(
+		 ( *split_raw_writer )->basename );
+
+		memory_free(
+		 *split_raw_writer );
+
+		*split_raw_writer = NULL;
+	}
+	return( result );
+}
+
+/* Sets the media values
+ * The media is split in segment files of the maximum segment size, where 0 represents a single segment file
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_set_media_values(
+     split_raw_writer_t *split_raw_writer,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     uint8_t sparse_output,
+     libcerror_error_t **error )
+{
+	static char *function           = "split_raw_writer_set_media_values";
+	size64_t number_of_segment_files = 0;
+	size64_t segment_file_size       = 0;
+	int segment_file_index           = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( split_raw_writer->thread_pool != NULL )
+	 || ( split_raw_writer->segment_file_descriptors != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid split raw writer - media values already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	segment_file_size = maximum_segment_size;
+
+	if( ( segment_file_size == 0 )
+	 || ( segment_file_size > media_size ) )
+	{
+		segment_file_size = media_size;
+	}
+	number_of_segment_files = media_size / segment_file_size;
+
+	if( ( media_size % segment_file_size ) != 0 )
+	{
+		number_of_segment_files += 1;
+	}
+	if( ( number_of_segment_files > (size64_t) INT_MAX )
+	 || ( number_of_segment_files > (size64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( size64_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segment files value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	split_raw_writer->segment_file_descriptors = (int *) memory_allocate(
+	                                                      sizeof( int ) * (size_t) number_of_segment_files );
+
+	if( split_raw_writer->segment_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	split_raw_writer->segment_file_remaining_sizes = (size64_t *) memory_allocate(
+	                                                               sizeof( size64_t ) * (size_t) number_of_segment_files );
+
+	if( split_raw_writer->segment_file_remaining_sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file remaining sizes.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_file_index = 0;
+	     segment_file_index < (int) number_of_segment_files;
+	     segment_file_index++ )
+	{
+		split_raw_writer->segment_file_descriptors[ segment_file_index ] = -1;
+
+		if( segment_file_index < (int) ( number_of_segment_files - 1 ) )
+		{
+			split_raw_writer->segment_file_remaining_sizes[ segment_file_index ] = segment_file_size;
+		}
+		else
+		{
+			split_raw_writer->segment_file_remaining_sizes[ segment_file_index ] = media_size - ( (size64_t) segment_file_index * segment_file_size );
+		}
+	}
+	split_raw_writer->media_size              = media_size;
+	split_raw_writer->segment_file_size       = segment_file_size;
+	split_raw_writer->number_of_segment_files = (int) number_of_segment_files;
+	split_raw_writer->sparse_output           = sparse_output;
+
+	return( 1 );
+
+on_error:
+	if( split_raw_writer->segment_file_descriptors != NULL )
+	{
+		memory_free(
+		 split_raw_writer->segment_file_descriptors );
+
+		split_raw_writer->segment_file_descriptors = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the filename of a specific segment file
+ * The segment files are named in the same way as by libsmraw: basename.raw for a single
+ * segment file, otherwise basename.raw.000, basename.raw.001, etc.
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_get_segment_filename(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_get_segment_filename";
+	int maximum_index     = 0;
+	int number_of_digits  = 3;
+	int print_count       = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file_index < 0 )
+	 || ( segment_file_index >= split_raw_writer->number_of_segment_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid filename size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->number_of_segment_files == 1 )
+	{
+		print_count = narrow_string_snprintf(
+		               filename,
+		               filename_size,
+		               "%s.raw",
+		               split_raw_writer->basename );
+	}
+	else
+	{
+		for( maximum_index = ( split_raw_writer->number_of_segment_files - 1 ) / 1000;
+		     maximum_index > 0;
+		     maximum_index /= 10 )
+		{
+			number_of_digits++;
+		}
+		print_count = narrow_string_snprintf(
+		               filename,
+		               filename_size,
+		               "%s.raw.%0*d",
+		               split_raw_writer->basename,
+		               number_of_digits,
+		               segment_file_index );
+	}
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment filename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Starts the writer threads
+ * The storage media buffers are written by the first available writer thread, so that
+ * multiple ranges of the output are written concurrently
+ * The release function is called, from one of the writer threads, when a storage media buffer was written
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_start(
+     split_raw_writer_t *split_raw_writer,
+     int number_of_writers,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            storage_media_buffer_t *storage_media_buffer,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_start";
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->segment_file_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid split raw writer - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid split raw writer - thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_writers <= 0 )
+	 || ( number_of_writers > SPLIT_RAW_WRITER_MAXIMUM_NUMBER_OF_WRITERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of writers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( release_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid release function.",
+		 function );
+
+		return( -1 );
+	}
+	split_raw_writer->release_function           = release_function;
+	split_raw_writer->release_function_arguments = release_function_arguments;
+
+	if( libcthreads_thread_pool_create(
+	     &( split_raw_writer->thread_pool ),
+	     NULL,
+	     number_of_writers,
+	     maximum_number_of_queued_values,
+	     (int (*)(intptr_t *, void *)) &split_raw_writer_write_callback,
+	     (void *) split_raw_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize writer thread pool.",
+		 function );
+
+		split_raw_writer->release_function           = NULL;
+		split_raw_writer->release_function_arguments = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Pushes a storage media buffer onto the split raw writer
+ * The storage media buffer is passed to the release function once it was written
+ * If pushing fails the storage media buffer is not released
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_push(
+     split_raw_writer_t *split_raw_writer,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_push";
+	uint8_t has_failed    = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid split raw writer - missing thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	has_failed = split_raw_writer->has_failed;
+
+	if( libcthreads_mutex_release(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write split raw output.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_pool_push(
+	     split_raw_writer->thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto writer thread pool queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the writer threads and closes the segment files
+ * The storage media buffers that are still queued are written before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_join(
+     split_raw_writer_t *split_raw_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_join";
+	int result            = 1;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( split_raw_writer->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join writer thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( split_raw_writer_close_segment_files(
+	     split_raw_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close segment files.",
+		 function );
+
+		result = -1;
+	}
+	if( ( result == 1 )
+	 && ( split_raw_writer->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write split raw output.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Closes the segment files that are still open
+ * A segment file is normally closed as soon as it was completely written, this closes
+ * the segment files of an incomplete output
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_close_segment_files(
+     split_raw_writer_t *split_raw_writer,
+     libcerror_error_t **error )
+{
+	static char *function  = "split_raw_writer_close_segment_files";
+	int segment_file_index = 0;
+	int result             = 1;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->segment_file_descriptors == NULL )
+	{
+		return( 1 );
+	}
+	for( segment_file_index = 0;
+	     segment_file_index < split_raw_writer->number_of_segment_files;
+	     segment_file_index++ )
+	{
+		if( split_raw_writer->segment_file_descriptors[ segment_file_index ] == -1 )
+		{
+			continue;
+		}
+		if( close(
+		     split_raw_writer->segment_file_descriptors[ segment_file_index ] ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close segment file: %d.",
+			 function,
+			 segment_file_index );
+
+			result = -1;
+		}
+		split_raw_writer->segment_file_descriptors[ segment_file_index ] = -1;
+	}
+	return( result );
+}
+
+/* Opens a specific segment file if it is not open
+ * This function should be called with the mutex grabbed
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_open_segment_file(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     libcerror_error_t **error )
+{
+	char *filename        = NULL;
+	static char *function = "split_raw_writer_open_segment_file";
+	size_t filename_size  = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file_index < 0 )
+	 || ( segment_file_index >= split_raw_writer->number_of_segment_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->segment_file_descriptors[ segment_file_index ] != -1 )
+	{
+		return( 1 );
+	}
+	/* The extension requires at most 4 + 1 + 10 characters
+	 */
+	filename_size = split_raw_writer->basename_size + 16;
+
+	filename = narrow_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( split_raw_writer_get_segment_filename(
+	     split_raw_writer,
+	     segment_file_index,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file: %d filename.",
+		 function,
+		 segment_file_index );
+
+		goto on_error;
+	}
+	split_raw_writer->segment_file_descriptors[ segment_file_index ] = open(
+	                                                                    filename,
+	                                                                    O_WRONLY | O_CREAT | O_TRUNC,
+	                                                                    0644 );
+
+	if( split_raw_writer->segment_file_descriptors[ segment_file_index ] == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	memory_free(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Retrieves the file descriptor of a specific segment file
+ * The segment file is opened when it is first written
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_get_segment_file_descriptor(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "split_raw_writer_get_segment_file_descriptor";
+	int result            = 1;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer_open_segment_file(
+	     split_raw_writer,
+	     segment_file_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open segment file: %d.",
+		 function,
+		 segment_file_index );
+
+		result = -1;
+	}
+	else
+	{
+		*file_descriptor = split_raw_writer->segment_file_descriptors[ segment_file_index ];
+	}
+	if( libcthreads_mutex_release(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Marks a range of a specific segment file as written
+ * The segment file is closed when it was completely written. For sparse output the segment file
+ * is created, if necessary, and extended to its full size, since the holes were never written
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_release_segment_range(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function      = "split_raw_writer_release_segment_range";
+	size64_t segment_file_size = 0;
+	int file_descriptor        = 0;
+	int result                 = 1;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_file_index < 0 )
+	 || ( segment_file_index >= split_raw_writer->number_of_segment_files ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > split_raw_writer->segment_file_remaining_sizes[ segment_file_index ] )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		split_raw_writer->segment_file_remaining_sizes[ segment_file_index ] -= size;
+	}
+	if( ( result == 1 )
+	 && ( split_raw_writer->segment_file_remaining_sizes[ segment_file_index ] == 0 ) )
+	{
+		if( split_raw_writer_open_segment_file(
+		     split_raw_writer,
+		     segment_file_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open segment file: %d.",
+			 function,
+			 segment_file_index );
+
+			result = -1;
+		}
+		else
+		{
+			file_descriptor = split_raw_writer->segment_file_descriptors[ segment_file_index ];
+
+			split_raw_writer->segment_file_descriptors[ segment_file_index ] = -1;
+
+			if( split_raw_writer->sparse_output != 0 )
+			{
+				segment_file_size = split_raw_writer->segment_file_size;
+
+				if( segment_file_index == ( split_raw_writer->number_of_segment_files - 1 ) )
+				{
+					segment_file_size = split_raw_writer->media_size - ( (size64_t) segment_file_index * split_raw_writer->segment_file_size );
+				}
+				if( ftruncate(
+				     file_descriptor,
+				     (off_t) segment_file_size ) != 0 )
+				{
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 errno,
+					 "%s: unable to set size of segment file: %d.",
+					 function,
+					 segment_file_index );
+
+					result = -1;
+				}
+			}
+			if( close(
+			     file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close segment file: %d.",
+				 function,
+				 segment_file_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     split_raw_writer->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Writes a range of the media to the segment files
+ * The data is written with positioned writes at segment file relative offsets, so that
+ * the writer threads do not share a file offset. An empty range is not written
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_write_range(
+     split_raw_writer_t *split_raw_writer,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t is_empty,
+     libcerror_error_t **error )
+{
+	static char *function  = "split_raw_writer_write_range";
+	size_t range_size      = 0;
+	ssize_t write_count    = 0;
+	off64_t segment_offset = 0;
+	int file_descriptor    = -1;
+	int segment_file_index = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( split_raw_writer->segment_file_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid split raw writer - missing segment file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > split_raw_writer->media_size )
+	 || ( (size64_t) data_size > ( split_raw_writer->media_size - (size64_t) offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+		segment_file_index = (int) ( (size64_t) offset / split_raw_writer->segment_file_size );
+		segment_offset     = (off64_t) ( (size64_t) offset % split_raw_writer->segment_file_size );
+		range_size         = data_size;
+
+		if( (size64_t) range_size > ( split_raw_writer->segment_file_size - (size64_t) segment_offset ) )
+		{
+			range_size = (size_t) ( split_raw_writer->segment_file_size - (size64_t) segment_offset );
+		}
+		if( is_empty == 0 )
+		{
+			if( split_raw_writer_get_segment_file_descriptor(
+			     split_raw_writer,
+			     segment_file_index,
+			     &file_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment file: %d descriptor.",
+				 function,
+				 segment_file_index );
+
+				return( -1 );
+			}
+			while( range_size > 0 )
+			{
+				write_count = pwrite(
+				               file_descriptor,
+				               data,
+				               range_size,
+				               (off_t) segment_offset );
+
+				if( write_count == -1 )
+				{
+					if( errno == EINTR )
+					{
+						continue;
+					}
+					libcerror_system_set_error(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 errno,
+					 "%s: unable to write segment file: %d at offset: %" PRIi64 ".",
+					 function,
+					 segment_file_index,
+					 segment_offset );
+
+					return( -1 );
+				}
+				if( write_count == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write segment file: %d at offset: %" PRIi64 ".",
+					 function,
+					 segment_file_index,
+					 segment_offset );
+
+					return( -1 );
+				}
+				if( split_raw_writer_release_segment_range(
+				     split_raw_writer,
+				     segment_file_index,
+				     (size64_t) write_count,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release range of segment file: %d.",
+					 function,
+					 segment_file_index );
+
+					return( -1 );
+				}
+				data           += write_count;
+				data_size      -= (size_t) write_count;
+				offset         += (off64_t) write_count;
+				segment_offset += (off64_t) write_count;
+				range_size     -= (size_t) write_count;
+			}
+		}
+		else
+		{
+			if( split_raw_writer_release_segment_range(
+			     split_raw_writer,
+			     segment_file_index,
+			     (size64_t) range_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release range of segment file: %d.",
+				 function,
+				 segment_file_index );
+
+				return( -1 );
+			}
+			data      += range_size;
+			data_size -= range_size;
+			offset    += (off64_t) range_size;
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a storage media buffer to the segment files
+ * Callback function for the writer thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int split_raw_writer_write_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     split_raw_writer_t *split_raw_writer )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	static char *function    = "split_raw_writer_write_callback";
+	size_t data_size         = 0;
+	uint8_t is_empty         = 0;
+	int result               = 1;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( split_raw_writer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid split raw writer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Once a write failed the remaining storage media buffers are only released
+	 */
+	if( split_raw_writer->has_failed == 0 )
+	{
+		if( storage_media_buffer_get_data(
+		     storage_media_buffer,
+		     &data,
+		     &data_size,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve storage media buffer data.",
+			 function );
+
+			result = -1;
+		}
+		else if( split_raw_writer->sparse_output != 0 )
+		{
+			result = storage_media_buffer_is_empty(
+			          storage_media_buffer,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if storage media buffer is empty.",
+				 function );
+			}
+			else
+			{
+				is_empty = (uint8_t) result;
+
+				result = 1;
+			}
+		}
+		if( result == 1 )
+		{
+			if( split_raw_writer_write_range(
+			     split_raw_writer,
+			     storage_media_buffer->storage_media_offset,
+			     data,
+			     storage_media_buffer->processed_size,
+			     is_empty,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write storage media buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( result == -1 )
+		{
+			if( libcthreads_mutex_grab(
+			     split_raw_writer->mutex,
+			     NULL ) == 1 )
+			{
+				split_raw_writer->has_failed = 1;
+
+				libcthreads_mutex_release(
+				 split_raw_writer->mutex,
+				 NULL );
+			}
+		}
+	}
+	if( split_raw_writer->release_function(
+	     storage_media_buffer,
+	     split_raw_writer->release_function_arguments ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
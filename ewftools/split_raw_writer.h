@@ -0,0 +1,189 @@
+/*
+ * Split raw output writer
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SPLIT_RAW_WRITER_H )
+#define _SPLIT_RAW_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The split raw writer uses positioned writes (pwrite) on file descriptors
+ */
+#if defined( HAVE_MULTI_THREAD_SUPPORT ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define SPLIT_RAW_WRITER_HAVE_SUPPORT
+#endif
+
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+/* The maximum number of writer threads
+ */
+#define SPLIT_RAW_WRITER_MAXIMUM_NUMBER_OF_WRITERS	32
+
+typedef struct split_raw_writer split_raw_writer_t;
+
+struct split_raw_writer
+{
+	/* The basename of the segment files
+	 */
+	char *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The number of segment files
+	 */
+	int number_of_segment_files;
+
+	/* The file descriptors of the segment files, -1 if not open
+	 */
+	int *segment_file_descriptors;
+
+	/* The number of bytes that remain to be written per segment file
+	 */
+	size64_t *segment_file_remaining_sizes;
+
+	/* Value to indicate if ranges of zero bytes should be left as holes
+	 */
+	uint8_t sparse_output;
+
+	/* The writer thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The release function, which is called when a storage media buffer was written
+	 */
+	int (*release_function)(
+	       storage_media_buffer_t *storage_media_buffer,
+	       void *arguments );
+
+	/* The release function arguments
+	 */
+	void *release_function_arguments;
+
+	/* Value to indicate writing a storage media buffer failed
+	 */
+	uint8_t has_failed;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+int split_raw_writer_initialize(
+     split_raw_writer_t **split_raw_writer,
+     const char *basename,
+     libcerror_error_t **error );
+
+int split_raw_writer_free(
+     split_raw_writer_t **split_raw_writer,
+     libcerror_error_t **error );
+
+int split_raw_writer_set_media_values(
+     split_raw_writer_t *split_raw_writer,
+     size64_t media_size,
+     size64_t maximum_segment_size,
+     uint8_t sparse_output,
+     libcerror_error_t **error );
+
+int split_raw_writer_get_segment_filename(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+int split_raw_writer_start(
+     split_raw_writer_t *split_raw_writer,
+     int number_of_writers,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            storage_media_buffer_t *storage_media_buffer,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error );
+
+int split_raw_writer_push(
+     split_raw_writer_t *split_raw_writer,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int split_raw_writer_join(
+     split_raw_writer_t *split_raw_writer,
+     libcerror_error_t **error );
+
+int split_raw_writer_close_segment_files(
+     split_raw_writer_t *split_raw_writer,
+     libcerror_error_t **error );
+
+int split_raw_writer_open_segment_file(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     libcerror_error_t **error );
+
+int split_raw_writer_get_segment_file_descriptor(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int split_raw_writer_release_segment_range(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     size64_t size,
+     libcerror_error_t **error );
+
+int split_raw_writer_write_range(
+     split_raw_writer_t *split_raw_writer,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t is_empty,
+     libcerror_error_t **error );
+
+int split_raw_writer_write_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     split_raw_writer_t *split_raw_writer );
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SPLIT_RAW_WRITER_H ) */
+
@@ -0,0 +1,1076 @@
+/*
+ * Stage profiler
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#endif
+
+#include <time.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+
+/* The names of the stages as printed in the summary and metrics
+ */
+static const char *stage_profiler_stage_names[ STAGE_PROFILER_NUMBER_OF_STAGES ] = {
+	"read",
+	"unpack",
+	"hash",
+	"pack",
+	"reorder",
+	"write" };
+
+/* The names of the queues as printed in the summary and metrics
+ */
+static const char *stage_profiler_queue_names[ STAGE_PROFILER_NUMBER_OF_QUEUES ] = {
+	"in_flight",
+	"digest",
+	"write" };
+
+/* Retrieves the name of a stage
+ * Returns a string representation of the stage
+ */
+const char *stage_profiler_get_stage_name(
+             int stage )
+{
+	if( ( stage < 0 )
+	 || ( stage >= STAGE_PROFILER_NUMBER_OF_STAGES ) )
+	{
+		return( "UNKNOWN" );
+	}
+	return( stage_profiler_stage_names[ stage ] );
+}
+
+/* Retrieves the name of a queue
+ * Returns a string representation of the queue
+ */
+const char *stage_profiler_get_queue_name(
+             int queue )
+{
+	if( ( queue < 0 )
+	 || ( queue >= STAGE_PROFILER_NUMBER_OF_QUEUES ) )
+	{
+		return( "UNKNOWN" );
+	}
+	return( stage_profiler_queue_names[ queue ] );
+}
+
+/* Creates a stage profiler
+ * Make sure the value stage_profiler is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_initialize(
+     stage_profiler_t **stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function = "stage_profiler_initialize";
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stage_profiler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stage profiler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*stage_profiler = memory_allocate_structure(
+	                   stage_profiler_t );
+
+	if( *stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stage profiler.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stage_profiler,
+	     0,
+	     sizeof( stage_profiler_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stage profiler.",
+		 function );
+
+		memory_free(
+		 *stage_profiler );
+
+		*stage_profiler = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *stage_profiler )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( stage_profiler_get_timestamp(
+	     &( ( *stage_profiler )->start_timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *stage_profiler != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *stage_profiler )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *stage_profiler )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *stage_profiler );
+
+		*stage_profiler = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stage profiler
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_free(
+     stage_profiler_t **stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function = "stage_profiler_free";
+	int result            = 1;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stage_profiler != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *stage_profiler )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *stage_profiler );
+
+		*stage_profiler = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves a monotonic timestamp in nano seconds
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+#else
+	time_t current_time   = 0;
+#endif
+
+	static char *function = "stage_profiler_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( ( ( counter.QuadPart % frequency.QuadPart ) * 1000000000 ) / frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+#if defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+#else
+	if( clock_gettime(
+	     CLOCK_REALTIME,
+	     &time_structure ) != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (int64_t) time_structure.tv_sec * 1000000000 ) + time_structure.tv_nsec;
+
+#else
+	current_time = time( NULL );
+
+	if( current_time == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (int64_t) current_time * 1000000000;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Starts the stage profiler
+ * Clears the samples taken so far
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_start(
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function   = "stage_profiler_start";
+	int64_t start_timestamp = 0;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	stage_profiler->start_timestamp = start_timestamp;
+
+	memory_set(
+	 stage_profiler->stages,
+	 0,
+	 sizeof( stage_profiler_stage_t ) * STAGE_PROFILER_NUMBER_OF_STAGES );
+
+	memory_set(
+	 stage_profiler->queues,
+	 0,
+	 sizeof( stage_profiler_queue_t ) * STAGE_PROFILER_NUMBER_OF_QUEUES );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a sample of a stage that started at the start timestamp and ends now
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_add_sample(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     int64_t start_timestamp,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error )
+{
+	stage_profiler_stage_t *profiler_stage = NULL;
+	static char *function                  = "stage_profiler_add_sample";
+	int64_t timestamp                      = 0;
+	uint64_t sample_time                   = 0;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= STAGE_PROFILER_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( timestamp > start_timestamp )
+	{
+		sample_time = (uint64_t) ( timestamp - start_timestamp );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	profiler_stage = &( stage_profiler->stages[ stage ] );
+
+	profiler_stage->number_of_samples += 1;
+	profiler_stage->number_of_bytes   += number_of_bytes;
+	profiler_stage->busy_time         += sample_time;
+
+	if( sample_time > profiler_stage->maximum_time )
+	{
+		profiler_stage->maximum_time = sample_time;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds bytes to a stage without adding a sample
+ * This is used when the stage is timed where the number of bytes is not known
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_add_bytes(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error )
+{
+	static char *function = "stage_profiler_add_bytes";
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= STAGE_PROFILER_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	stage_profiler->stages[ stage ].number_of_bytes += number_of_bytes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a number of bytes the stage produced
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_add_output_bytes(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error )
+{
+	static char *function = "stage_profiler_add_output_bytes";
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= STAGE_PROFILER_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	stage_profiler->stages[ stage ].number_of_output_bytes += number_of_bytes;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a wait on a stage that started at the start timestamp and ends now
+ * A wait longer than the stall threshold is counted as a stall
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_add_wait(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     int64_t start_timestamp,
+     libcerror_error_t **error )
+{
+	stage_profiler_stage_t *profiler_stage = NULL;
+	static char *function                  = "stage_profiler_add_wait";
+	int64_t timestamp                      = 0;
+	uint64_t wait_time                     = 0;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stage < 0 )
+	 || ( stage >= STAGE_PROFILER_NUMBER_OF_STAGES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( timestamp > start_timestamp )
+	{
+		wait_time = (uint64_t) ( timestamp - start_timestamp );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	profiler_stage = &( stage_profiler->stages[ stage ] );
+
+	profiler_stage->wait_time += wait_time;
+
+	if( wait_time >= STAGE_PROFILER_STALL_THRESHOLD )
+	{
+		profiler_stage->number_of_stalls += 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds a sample of the depth of a queue
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_add_queue_depth(
+     stage_profiler_t *stage_profiler,
+     int queue,
+     uint64_t depth,
+     libcerror_error_t **error )
+{
+	stage_profiler_queue_t *profiler_queue = NULL;
+	static char *function                  = "stage_profiler_add_queue_depth";
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue < 0 )
+	 || ( queue >= STAGE_PROFILER_NUMBER_OF_QUEUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	profiler_queue = &( stage_profiler->queues[ queue ] );
+
+	profiler_queue->number_of_samples += 1;
+	profiler_queue->total_depth       += depth;
+
+	if( depth > profiler_queue->maximum_depth )
+	{
+		profiler_queue->maximum_depth = depth;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a copy of the samples of the stages and queues
+ * The stages and queues must have room for the number of stages and queues,
+ * the elapsed time is in nano seconds since the profiling started
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_get_samples(
+     stage_profiler_t *stage_profiler,
+     stage_profiler_stage_t *stages,
+     stage_profiler_queue_t *queues,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error )
+{
+	static char *function = "stage_profiler_get_samples";
+	int64_t timestamp     = 0;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( stages == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stages.",
+		 function );
+
+		return( -1 );
+	}
+	if( queues == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queues.",
+		 function );
+
+		return( -1 );
+	}
+	if( elapsed_time == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid elapsed time.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_timestamp(
+	     &timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*elapsed_time = 0;
+
+	if( timestamp > stage_profiler->start_timestamp )
+	{
+		*elapsed_time = (uint64_t) ( timestamp - stage_profiler->start_timestamp );
+	}
+	memory_copy(
+	 stages,
+	 stage_profiler->stages,
+	 sizeof( stage_profiler_stage_t ) * STAGE_PROFILER_NUMBER_OF_STAGES );
+
+	memory_copy(
+	 queues,
+	 stage_profiler->queues,
+	 sizeof( stage_profiler_queue_t ) * STAGE_PROFILER_NUMBER_OF_QUEUES );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     stage_profiler->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints a summary table of the stages and queues
+ * The load is the busy time relative to the elapsed time, a load above 100%
+ * means the stage was busy in multiple threads at the same time
+ * Returns 1 if successful or -1 on error
+ */
+int stage_profiler_fprint(
+     stage_profiler_t *stage_profiler,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	stage_profiler_queue_t queues[ STAGE_PROFILER_NUMBER_OF_QUEUES ];
+	stage_profiler_stage_t stages[ STAGE_PROFILER_NUMBER_OF_STAGES ];
+
+	static char *function    = "stage_profiler_fprint";
+	uint64_t elapsed_time    = 0;
+	uint64_t busy_time       = 0;
+	int index                = 0;
+
+	if( stage_profiler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stage profiler.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( stage_profiler_get_samples(
+	     stage_profiler,
+	     stages,
+	     queues,
+	     &elapsed_time,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve samples.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Stage profile over: %" PRIu64 " ms\n",
+	 elapsed_time / 1000000 );
+
+	fprintf(
+	 stream,
+	 "%-9s %10s %14s %10s %10s %10s %8s %6s %8s %10s\n",
+	 "Stage",
+	 "Samples",
+	 "Bytes",
+	 "Busy (ms)",
+	 "Avg (us)",
+	 "Max (us)",
+	 "MiB/s",
+	 "Load",
+	 "Stalls",
+	 "Wait (ms)" );
+
+	for( index = 0;
+	     index < STAGE_PROFILER_NUMBER_OF_STAGES;
+	     index++ )
+	{
+		if( ( stages[ index ].number_of_samples == 0 )
+		 && ( stages[ index ].wait_time == 0 ) )
+		{
+			continue;
+		}
+		busy_time = stages[ index ].busy_time / 1000;
+
+		fprintf(
+		 stream,
+		 "%-9s %10" PRIu64 " %14" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %8" PRIu64 " %5" PRIu64 "%% %8" PRIu64 " %10" PRIu64 "\n",
+		 stage_profiler_stage_names[ index ],
+		 stages[ index ].number_of_samples,
+		 stages[ index ].number_of_bytes,
+		 busy_time / 1000,
+		 ( stages[ index ].number_of_samples > 0 ) ? busy_time / stages[ index ].number_of_samples : 0,
+		 stages[ index ].maximum_time / 1000,
+		 ( busy_time > 0 ) ? ( ( stages[ index ].number_of_bytes / 1024 ) * 1000000 / busy_time ) / 1024 : 0,
+		 ( elapsed_time > 0 ) ? ( stages[ index ].busy_time * 100 ) / elapsed_time : 0,
+		 stages[ index ].number_of_stalls,
+		 stages[ index ].wait_time / 1000000 );
+	}
+	fprintf(
+	 stream,
+	 "\n%-9s %10s %10s %10s\n",
+	 "Queue",
+	 "Samples",
+	 "Average",
+	 "Maximum" );
+
+	for( index = 0;
+	     index < STAGE_PROFILER_NUMBER_OF_QUEUES;
+	     index++ )
+	{
+		if( queues[ index ].number_of_samples == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 stream,
+		 "%-9s %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+		 stage_profiler_queue_names[ index ],
+		 queues[ index ].number_of_samples,
+		 queues[ index ].total_depth / queues[ index ].number_of_samples,
+		 queues[ index ].maximum_depth );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
@@ -0,0 +1,205 @@
+/*
+ * Stage profiler
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _STAGE_PROFILER_H )
+#define _STAGE_PROFILER_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum STAGE_PROFILER_STAGES
+{
+	STAGE_PROFILER_STAGE_READ		= 0,
+	STAGE_PROFILER_STAGE_UNPACK		= 1,
+	STAGE_PROFILER_STAGE_HASH		= 2,
+	STAGE_PROFILER_STAGE_PACK		= 3,
+	STAGE_PROFILER_STAGE_REORDER		= 4,
+	STAGE_PROFILER_STAGE_WRITE		= 5
+};
+
+#define STAGE_PROFILER_NUMBER_OF_STAGES		6
+
+enum STAGE_PROFILER_QUEUES
+{
+	STAGE_PROFILER_QUEUE_IN_FLIGHT		= 0,
+	STAGE_PROFILER_QUEUE_DIGEST		= 1,
+	STAGE_PROFILER_QUEUE_WRITE		= 2
+};
+
+#define STAGE_PROFILER_NUMBER_OF_QUEUES		3
+
+/* The minimum wait time in nano seconds that is counted as a stall
+ */
+#define STAGE_PROFILER_STALL_THRESHOLD		100000
+
+typedef struct stage_profiler_stage stage_profiler_stage_t;
+
+struct stage_profiler_stage
+{
+	/* The number of samples
+	 */
+	uint64_t number_of_samples;
+
+	/* The number of bytes processed
+	 */
+	uint64_t number_of_bytes;
+
+	/* The number of bytes the stage produced, such as the packed size of the chunks
+	 */
+	uint64_t number_of_output_bytes;
+
+	/* The time spent processing in nano seconds
+	 */
+	uint64_t busy_time;
+
+	/* The maximum time of a single sample in nano seconds
+	 */
+	uint64_t maximum_time;
+
+	/* The number of times a preceding stage waited on the stage longer than the stall threshold
+	 * For the read stage this is the number of times reading waited for a free buffer
+	 */
+	uint64_t number_of_stalls;
+
+	/* The time preceding stages spent waiting on the stage in nano seconds
+	 */
+	uint64_t wait_time;
+};
+
+typedef struct stage_profiler_queue stage_profiler_queue_t;
+
+struct stage_profiler_queue
+{
+	/* The number of samples
+	 */
+	uint64_t number_of_samples;
+
+	/* The sum of the sampled depths
+	 */
+	uint64_t total_depth;
+
+	/* The maximum sampled depth
+	 */
+	uint64_t maximum_depth;
+};
+
+typedef struct stage_profiler stage_profiler_t;
+
+struct stage_profiler
+{
+	/* The timestamp of the start of profiling in nano seconds
+	 */
+	int64_t start_timestamp;
+
+	/* The stages
+	 */
+	stage_profiler_stage_t stages[ STAGE_PROFILER_NUMBER_OF_STAGES ];
+
+	/* The queues
+	 */
+	stage_profiler_queue_t queues[ STAGE_PROFILER_NUMBER_OF_QUEUES ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+const char *stage_profiler_get_stage_name(
+             int stage );
+
+const char *stage_profiler_get_queue_name(
+             int queue );
+
+int stage_profiler_initialize(
+     stage_profiler_t **stage_profiler,
+     libcerror_error_t **error );
+
+int stage_profiler_free(
+     stage_profiler_t **stage_profiler,
+     libcerror_error_t **error );
+
+int stage_profiler_get_timestamp(
+     int64_t *timestamp,
+     libcerror_error_t **error );
+
+int stage_profiler_start(
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error );
+
+int stage_profiler_add_sample(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     int64_t start_timestamp,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error );
+
+int stage_profiler_add_bytes(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error );
+
+int stage_profiler_add_output_bytes(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     uint64_t number_of_bytes,
+     libcerror_error_t **error );
+
+int stage_profiler_add_wait(
+     stage_profiler_t *stage_profiler,
+     int stage,
+     int64_t start_timestamp,
+     libcerror_error_t **error );
+
+int stage_profiler_add_queue_depth(
+     stage_profiler_t *stage_profiler,
+     int queue,
+     uint64_t depth,
+     libcerror_error_t **error );
+
+int stage_profiler_get_samples(
+     stage_profiler_t *stage_profiler,
+     stage_profiler_stage_t *stages,
+     stage_profiler_queue_t *queues,
+     uint64_t *elapsed_time,
+     libcerror_error_t **error );
+
+int stage_profiler_fprint(
+     stage_profiler_t *stage_profiler,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _STAGE_PROFILER_H ) */
+
@@ -228,6 +228,11 @@ int storage_media_buffer_free(
 			memory_free(
 			 ( *buffer )->raw_buffer );
 		}
+		if( ( *buffer )->stored_buffer != NULL )
+		{
+			memory_free(
+			 ( *buffer )->stored_buffer );
+		}
 		if( ( *buffer )->data_chunk != NULL )
 		{
 			if( libewf_data_chunk_free(
@@ -272,7 +277,9 @@ int storage_media_buffer_empty(
 
 		return( -1 );
 	}
-	buffer->raw_buffer_data_size = 0;
+	buffer->raw_buffer_data_size    = 0;
+	buffer->stored_buffer_data_size = 0;
+	buffer->processed_size          = 0;
 
 	return( 1 );
 }
@@ -476,6 +483,95 @@ int storage_media_buffer_is_corrupted(
 	return( (int) storage_media_buffer->is_corrupted );
 }
 
+/* Determines if the processed data of the storage media buffer only contains zero bytes
+ * If the stored chunk data is available its flags and size are used to avoid scanning the data
+ * Returns 1 if the storage media buffer is empty, 0 if not or -1 on error
+ */
+int storage_media_buffer_is_empty(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_is_empty";
+	size_t data_offset    = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->raw_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid storage media buffer - missing raw buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->processed_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid storage media buffer - processed size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->processed_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	 && ( storage_media_buffer->stored_buffer_data_size > 0 )
+	 && ( storage_media_buffer->is_corrupted == 0 )
+	 && ( ( storage_media_buffer->stored_data_flags & LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED ) != 0 ) )
+	{
+		if( ( storage_media_buffer->stored_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			/* The stored data contains the 64-bit fill pattern
+			 */
+			for( data_offset = 0;
+			     data_offset < storage_media_buffer->stored_buffer_data_size;
+			     data_offset++ )
+			{
+				if( storage_media_buffer->stored_buffer[ data_offset ] != 0 )
+				{
+					return( 0 );
+				}
+			}
+			return( 1 );
+		}
+		/* A chunk of zero bytes compresses to a small fraction of its size
+		 */
+		if( storage_media_buffer->stored_buffer_data_size > ( storage_media_buffer->processed_size / 64 ) )
+		{
+			return( 0 );
+		}
+	}
+	if( storage_media_buffer->raw_buffer[ 0 ] != 0 )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     storage_media_buffer->raw_buffer,
+	     &( storage_media_buffer->raw_buffer[ 1 ] ),
+	     storage_media_buffer->processed_size - 1 ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Reads a storage media buffer from the input handle
  * Returns the number of bytes read, 0 when no longer data can be read or -1 on error
  */
@@ -505,6 +601,8 @@ ssize_t storage_media_buffer_read_from_handle(
 	}
 	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
 	{
+		storage_media_buffer->stored_buffer_data_size = 0;
+
 		read_count = libewf_handle_read_data_chunk(
 	                      handle,
 	                      storage_media_buffer->data_chunk,
@@ -618,6 +716,99 @@ ssize_t storage_media_buffer_read_process(
 	return( process_count );
 }
 
+/* Reads the stored (packed) chunk data of a storage media buffer into the stored buffer
+ * This function should be used after storage_media_buffer_read_from_handle and
+ * before storage_media_buffer_read_process
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t storage_media_buffer_read_stored_data(
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error )
+{
+	uint8_t *stored_buffer  = NULL;
+	static char *function   = "storage_media_buffer_read_stored_data";
+	size_t stored_data_size = 0;
+	ssize_t read_count      = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_data_chunk_get_stored_data_size(
+	     storage_media_buffer->data_chunk,
+	     &stored_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stored data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_data_size > storage_media_buffer->stored_buffer_size )
+	{
+		stored_buffer = (uint8_t *) memory_reallocate(
+		                             storage_media_buffer->stored_buffer,
+		                             sizeof( uint8_t ) * stored_data_size );
+
+		if( stored_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize stored buffer.",
+			 function );
+
+			return( -1 );
+		}
+		storage_media_buffer->stored_buffer      = stored_buffer;
+		storage_media_buffer->stored_buffer_size = stored_data_size;
+	}
+	read_count = libewf_data_chunk_read_stored_buffer(
+	              storage_media_buffer->data_chunk,
+	              storage_media_buffer->stored_buffer,
+	              storage_media_buffer->stored_buffer_size,
+	              &( storage_media_buffer->stored_data_flags ),
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read stored data from data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->stored_buffer_data_size = (size_t) read_count;
+
+	return( read_count );
+}
+
 /* Processes a storage media buffer after read
  * Returns the resulting buffer size or -1 on error
  */
@@ -668,6 +859,79 @@ ssize_t storage_media_buffer_write_process(
 	return( process_count );
 }
 
+/* Processes stored (packed) chunk data before write
+ * The stored data is passed to the data chunk as-is, without compression,
+ * data size contains the size of the media data the stored data represents
+ * Returns the resulting buffer size or -1 on error
+ */
+ssize_t storage_media_buffer_write_stored_data(
+         storage_media_buffer_t *storage_media_buffer,
+         const uint8_t *stored_data,
+         size_t stored_data_size,
+         uint32_t stored_data_flags,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	static char *function = "storage_media_buffer_write_stored_data";
+	ssize_t write_count   = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid storage media buffer - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_data_chunk_write_stored_buffer(
+	               storage_media_buffer->data_chunk,
+	               stored_data,
+	               stored_data_size,
+	               data_size,
+	               stored_data_flags,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write stored data to data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->processed_size = data_size;
+
+	return( (ssize_t) data_size );
+}
+
 /* Writes a storage media buffer to the input handle
  * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
@@ -50,6 +50,10 @@ struct storage_media_buffer
 	 */
 	off64_t storage_media_offset;
 
+	/* The sequence number, that determines the order in which buffers are output
+	 */
+	uint64_t sequence_number;
+
 	/* The raw buffer
 	 */
 	uint8_t *raw_buffer;
@@ -66,6 +70,22 @@ struct storage_media_buffer
 	 */
 	libewf_data_chunk_t *data_chunk;
 
+	/* The stored (packed) chunk data buffer
+	 */
+	uint8_t *stored_buffer;
+
+	/* The stored buffer size
+	 */
+	size_t stored_buffer_size;
+
+	/* The size of the stored chunk data in the stored buffer
+	 */
+	size_t stored_buffer_data_size;
+
+	/* The stored chunk data flags
+	 */
+	uint32_t stored_data_flags;
+
 	/* The requested size
 	 */
 	size_t requested_size;
@@ -77,6 +97,20 @@ struct storage_media_buffer
 	/* Value to indicate the data is corrupted
 	 */
 	uint8_t is_corrupted;
+
+	/* The timestamp at which the buffer was pushed onto the output window, used for profiling
+	 */
+	int64_t output_window_timestamp;
+
+	/* The first output storage media buffer, that contains the data repacked for an output handle
+	 * The output storage media buffer is not owned by the storage media buffer
+	 */
+	storage_media_buffer_t *output_buffer;
+
+	/* The next storage media buffer, in a group of storage media buffers that is processed together
+	 * The next storage media buffer is not owned by the storage media buffer
+	 */
+	storage_media_buffer_t *next_buffer;
 };
 
 int storage_media_buffer_initialize(
@@ -115,6 +149,10 @@ int storage_media_buffer_is_corrupted(
      storage_media_buffer_t *storage_media_buffer,
      libcerror_error_t **error );
 
+int storage_media_buffer_is_empty(
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
 ssize_t storage_media_buffer_read_from_handle(
          storage_media_buffer_t *storage_media_buffer,
          libewf_handle_t *handle,
@@ -125,10 +163,22 @@ ssize_t storage_media_buffer_read_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_read_stored_data(
+         storage_media_buffer_t *storage_media_buffer,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_write_process(
          storage_media_buffer_t *storage_media_buffer,
          libcerror_error_t **error );
 
+ssize_t storage_media_buffer_write_stored_data(
+         storage_media_buffer_t *storage_media_buffer,
+         const uint8_t *stored_data,
+         size_t stored_data_size,
+         uint32_t stored_data_flags,
+         size_t data_size,
+         libcerror_error_t **error );
+
 ssize_t storage_media_buffer_write_to_handle(
          storage_media_buffer_t *storage_media_buffer,
          libewf_handle_t *handle,
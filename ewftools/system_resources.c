@@ -0,0 +1,746 @@
+/*
+ * System resources functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* The processor affinity functions and macros in sched.h require _GNU_SOURCE
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_SCHED_H )
+#include <sched.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "system_resources.h"
+
+#if !defined( WINAPI )
+
+/* Copies a decimal value from the start of a string
+ * Leading white space is ignored
+ * Returns 1 if successful or 0 if the string does not start with a decimal value
+ */
+int system_resources_copy_from_decimal_string(
+     const char *string,
+     size_t string_size,
+     uint64_t *value,
+     size_t *string_index )
+{
+	size_t safe_string_index = 0;
+	int number_of_digits     = 0;
+
+	*value = 0;
+
+	while( ( safe_string_index < string_size )
+	    && ( ( string[ safe_string_index ] == ' ' )
+	     ||  ( string[ safe_string_index ] == '\t' ) ) )
+	{
+		safe_string_index++;
+	}
+	while( ( safe_string_index < string_size )
+	    && ( string[ safe_string_index ] >= '0' )
+	    && ( string[ safe_string_index ] <= '9' ) )
+	{
+		/* Ignore values that do not fit in 64-bit, these are considered unlimited
+		 */
+		if( *value > ( ( (uint64_t) UINT64_MAX - 9 ) / 10 ) )
+		{
+			return( 0 );
+		}
+		*value *= 10;
+		*value += (uint64_t) ( string[ safe_string_index ] - '0' );
+
+		safe_string_index++;
+		number_of_digits++;
+	}
+	if( string_index != NULL )
+	{
+		*string_index = safe_string_index;
+	}
+	if( number_of_digits == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the first line of a (pseudo) file
+ * Returns 1 if successful or 0 if the file could not be read
+ */
+int system_resources_read_line(
+     const char *filename,
+     const char *prefix,
+     char *line,
+     size_t line_size )
+{
+	FILE *file_stream  = NULL;
+	size_t prefix_size = 0;
+	int result         = 0;
+
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		return( 0 );
+	}
+	if( prefix != NULL )
+	{
+		prefix_size = narrow_string_length(
+		               prefix );
+	}
+	while( file_stream_get_string(
+	        file_stream,
+	        line,
+	        (int) line_size ) != NULL )
+	{
+		if( ( prefix == NULL )
+		 || ( narrow_string_compare(
+		       line,
+		       prefix,
+		       prefix_size ) == 0 ) )
+		{
+			result = 1;
+
+			break;
+		}
+	}
+	file_stream_close(
+	 file_stream );
+
+	return( result );
+}
+
+/* Determines the number of processors permitted by a CPU quota
+ * The number is rounded up so that a partial processor counts as a processor
+ * Returns 1 if successful or 0 if there is no quota
+ */
+int system_resources_get_number_of_processors_from_quota(
+     uint64_t quota,
+     uint64_t period,
+     int *number_of_processors )
+{
+	if( ( quota == 0 )
+	 || ( period == 0 ) )
+	{
+		return( 0 );
+	}
+	quota = ( quota / period ) + ( ( ( quota % period ) != 0 ) ? 1 : 0 );
+
+	if( quota > (uint64_t) INT_MAX )
+	{
+		return( 0 );
+	}
+	*number_of_processors = (int) quota;
+
+	return( 1 );
+}
+
+/* Determines the number of processors permitted by the contents of a control group version 2 cpu.max file
+ * The contents are "max 100000" if there is no quota or "200000 100000" for a quota and period
+ * Returns 1 if successful or 0 if there is no quota
+ */
+int system_resources_get_number_of_processors_from_cpu_max(
+     const char *string,
+     size_t string_size,
+     int *number_of_processors )
+{
+	uint64_t period     = 0;
+	uint64_t quota      = 0;
+	size_t string_index = 0;
+
+	if( system_resources_copy_from_decimal_string(
+	     string,
+	     string_size,
+	     &quota,
+	     &string_index ) != 1 )
+	{
+		return( 0 );
+	}
+	if( system_resources_copy_from_decimal_string(
+	     &( string[ string_index ] ),
+	     string_size - string_index,
+	     &period,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	return( system_resources_get_number_of_processors_from_quota(
+	         quota,
+	         period,
+	         number_of_processors ) );
+}
+
+/* Determines the number of processors permitted by the contents of the control group version 1
+ * cpu.cfs_quota_us and cpu.cfs_period_us files, where a quota of -1 represents no quota
+ * Returns 1 if successful or 0 if there is no quota
+ */
+int system_resources_get_number_of_processors_from_cfs_quota(
+     const char *quota_string,
+     size_t quota_string_size,
+     const char *period_string,
+     size_t period_string_size,
+     int *number_of_processors )
+{
+	uint64_t period = 0;
+	uint64_t quota  = 0;
+
+	if( system_resources_copy_from_decimal_string(
+	     quota_string,
+	     quota_string_size,
+	     &quota,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( system_resources_copy_from_decimal_string(
+	     period_string,
+	     period_string_size,
+	     &period,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	return( system_resources_get_number_of_processors_from_quota(
+	         quota,
+	         period,
+	         number_of_processors ) );
+}
+
+/* Determines the memory limit from the contents of a control group memory.max or memory.limit_in_bytes file
+ * Version 2 contains "max" and version 1 a very large value if there is no limit
+ * Returns 1 if successful or 0 if there is no limit
+ */
+int system_resources_get_memory_limit_from_string(
+     const char *string,
+     size_t string_size,
+     size64_t *memory_limit )
+{
+	uint64_t limit = 0;
+
+	if( system_resources_copy_from_decimal_string(
+	     string,
+	     string_size,
+	     &limit,
+	     NULL ) != 1 )
+	{
+		return( 0 );
+	}
+	if( ( limit == 0 )
+	 || ( limit >= ( (uint64_t) 1 << 60 ) ) )
+	{
+		return( 0 );
+	}
+	*memory_limit = (size64_t) limit;
+
+	return( 1 );
+}
+
+#endif /* !defined( WINAPI ) */
+
+#if defined( __linux__ )
+
+/* Retrieves the number of processors permitted by the CPU quota of the control group
+ * Returns 1 if successful or 0 if there is no quota
+ */
+int system_resources_get_control_group_number_of_processors(
+     int *number_of_processors )
+{
+	char period_line[ 64 ];
+	char quota_line[ 64 ];
+
+	if( system_resources_read_line(
+	     "/sys/fs/cgroup/cpu.max",
+	     NULL,
+	     quota_line,
+	     64 ) == 1 )
+	{
+		return( system_resources_get_number_of_processors_from_cpu_max(
+		         quota_line,
+		         narrow_string_length(
+		          quota_line ),
+		         number_of_processors ) );
+	}
+	if( system_resources_read_line(
+	     "/sys/fs/cgroup/cpu/cpu.cfs_quota_us",
+	     NULL,
+	     quota_line,
+	     64 ) != 1 )
+	{
+		return( 0 );
+	}
+	if( system_resources_read_line(
+	     "/sys/fs/cgroup/cpu/cpu.cfs_period_us",
+	     NULL,
+	     period_line,
+	     64 ) != 1 )
+	{
+		return( 0 );
+	}
+	return( system_resources_get_number_of_processors_from_cfs_quota(
+	         quota_line,
+	         narrow_string_length(
+	          quota_line ),
+	         period_line,
+	         narrow_string_length(
+	          period_line ),
+	         number_of_processors ) );
+}
+
+/* Retrieves the memory limit of the control group
+ * Returns 1 if successful or 0 if there is no limit
+ */
+int system_resources_get_control_group_memory_limit(
+     size64_t *memory_limit )
+{
+	char line[ 64 ];
+
+	if( system_resources_read_line(
+	     "/sys/fs/cgroup/memory.max",
+	     NULL,
+	     line,
+	     64 ) != 1 )
+	{
+		if( system_resources_read_line(
+		     "/sys/fs/cgroup/memory/memory.limit_in_bytes",
+		     NULL,
+		     line,
+		     64 ) != 1 )
+		{
+			return( 0 );
+		}
+	}
+	return( system_resources_get_memory_limit_from_string(
+	         line,
+	         narrow_string_length(
+	          line ),
+	         memory_limit ) );
+}
+
+#endif /* defined( __linux__ ) */
+
+/* Retrieves the number of processors available to the process
+ * On Linux the number is limited by the processor affinity and the CPU quota of the control group
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int system_resources_get_number_of_processors(
+     int *number_of_processors,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	SYSTEM_INFO system_info;
+#elif defined( HAVE_SCHED_GETAFFINITY ) && defined( CPU_COUNT )
+	cpu_set_t cpu_set;
+#endif
+
+	static char *function          = "system_resources_get_number_of_processors";
+	int safe_number_of_processors  = 0;
+
+#if defined( __linux__ )
+	int quota_number_of_processors = 0;
+#endif
+#if !defined( WINAPI ) && defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	long sysconf_value             = 0;
+#endif
+
+	if( number_of_processors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of processors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	GetSystemInfo(
+	 &system_info );
+
+	safe_number_of_processors = (int) system_info.dwNumberOfProcessors;
+
+#else
+#if defined( HAVE_SCHED_GETAFFINITY ) && defined( CPU_COUNT )
+	CPU_ZERO(
+	 &cpu_set );
+
+	if( sched_getaffinity(
+	     0,
+	     sizeof( cpu_set_t ),
+	     &cpu_set ) == 0 )
+	{
+		safe_number_of_processors = CPU_COUNT(
+		                             &cpu_set );
+	}
+#endif
+#if defined( HAVE_SYSCONF ) && defined( _SC_NPROCESSORS_ONLN )
+	if( safe_number_of_processors <= 0 )
+	{
+		sysconf_value = sysconf(
+		                 _SC_NPROCESSORS_ONLN );
+
+		if( ( sysconf_value > 0 )
+		 && ( sysconf_value <= (long) INT_MAX ) )
+		{
+			safe_number_of_processors = (int) sysconf_value;
+		}
+	}
+#endif
+#if defined( __linux__ )
+	if( system_resources_get_control_group_number_of_processors(
+	     &quota_number_of_processors ) == 1 )
+	{
+		if( ( safe_number_of_processors <= 0 )
+		 || ( quota_number_of_processors < safe_number_of_processors ) )
+		{
+			safe_number_of_processors = quota_number_of_processors;
+		}
+	}
+#endif
+#endif /* defined( WINAPI ) */
+
+	if( safe_number_of_processors <= 0 )
+	{
+		return( 0 );
+	}
+	*number_of_processors = safe_number_of_processors;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the memory available to the process
+ * On Linux the size is limited by the memory limit of the control group
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int system_resources_get_available_memory_size(
+     size64_t *memory_size,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	MEMORYSTATUSEX memory_status;
+#elif defined( __linux__ )
+	char line[ 128 ];
+#endif
+
+	static char *function         = "system_resources_get_available_memory_size";
+	size64_t safe_memory_size     = 0;
+
+#if defined( __linux__ )
+	size64_t memory_limit         = 0;
+	uint64_t value_64bit          = 0;
+#endif
+#if !defined( WINAPI ) && defined( HAVE_SYSCONF ) && defined( _SC_AVPHYS_PAGES ) && defined( _SC_PAGESIZE )
+	long number_of_pages          = 0;
+	long page_size                = 0;
+#endif
+
+	if( memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid memory size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	memory_status.dwLength = sizeof( MEMORYSTATUSEX );
+
+	if( GlobalMemoryStatusEx(
+	     &memory_status ) != 0 )
+	{
+		safe_memory_size = (size64_t) memory_status.ullAvailPhys;
+	}
+#else
+#if defined( __linux__ )
+	/* MemAvailable also accounts for reclaimable page cache, unlike the number of free pages
+	 */
+	if( system_resources_read_line(
+	     "/proc/meminfo",
+	     "MemAvailable:",
+	     line,
+	     128 ) == 1 )
+	{
+		if( system_resources_copy_from_decimal_string(
+		     &( line[ 13 ] ),
+		     narrow_string_length(
+		      line ) - 13,
+		     &value_64bit,
+		     NULL ) == 1 )
+		{
+			safe_memory_size = (size64_t) value_64bit * 1024;
+		}
+	}
+#endif
+#if defined( HAVE_SYSCONF ) && defined( _SC_AVPHYS_PAGES ) && defined( _SC_PAGESIZE )
+	if( safe_memory_size == 0 )
+	{
+		number_of_pages = sysconf(
+		                   _SC_AVPHYS_PAGES );
+
+		page_size = sysconf(
+		             _SC_PAGESIZE );
+
+		if( ( number_of_pages > 0 )
+		 && ( page_size > 0 ) )
+		{
+			safe_memory_size = (size64_t) number_of_pages * (size64_t) page_size;
+		}
+	}
+#endif
+#if defined( __linux__ )
+	if( system_resources_get_control_group_memory_limit(
+	     &memory_limit ) == 1 )
+	{
+		if( ( safe_memory_size == 0 )
+		 || ( memory_limit < safe_memory_size ) )
+		{
+			safe_memory_size = memory_limit;
+		}
+	}
+#endif
+#endif /* defined( WINAPI ) */
+
+	if( safe_memory_size == 0 )
+	{
+		return( 0 );
+	}
+	*memory_size = safe_memory_size;
+
+	return( 1 );
+}
+
+/* Determines the number of threads to use in automatic mode
+ * Returns 1 if successful or -1 on error
+ */
+int system_resources_get_automatic_number_of_threads(
+     int *number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function    = "system_resources_get_automatic_number_of_threads";
+	int number_of_processors = 0;
+	int result               = 0;
+
+	if( number_of_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	result = system_resources_get_number_of_processors(
+	          &number_of_processors,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of processors.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		number_of_processors = 1;
+	}
+	if( number_of_processors > SYSTEM_RESOURCES_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		number_of_processors = SYSTEM_RESOURCES_MAXIMUM_NUMBER_OF_THREADS;
+	}
+	*number_of_threads = number_of_processors;
+
+	return( 1 );
+}
+
+/* Determines the size of the process buffers to use in automatic mode
+ * The size is an eighth of the available memory within the automatic mode bounds
+ * Returns 1 if successful or -1 on error
+ */
+int system_resources_get_automatic_process_buffers_size(
+     size64_t default_process_buffers_size,
+     size64_t *process_buffers_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "system_resources_get_automatic_process_buffers_size";
+	size64_t available_memory    = 0;
+	size64_t safe_buffers_size   = 0;
+	int result                   = 0;
+
+	if( process_buffers_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid process buffers size.",
+		 function );
+
+		return( -1 );
+	}
+	result = system_resources_get_available_memory_size(
+	          &available_memory,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve available memory size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		safe_buffers_size = default_process_buffers_size;
+	}
+	else
+	{
+		safe_buffers_size = available_memory / 8;
+
+		if( safe_buffers_size < SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE )
+		{
+			safe_buffers_size = SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE;
+		}
+		else if( safe_buffers_size > SYSTEM_RESOURCES_MAXIMUM_PROCESS_BUFFERS_SIZE )
+		{
+			safe_buffers_size = SYSTEM_RESOURCES_MAXIMUM_PROCESS_BUFFERS_SIZE;
+		}
+	}
+	*process_buffers_size = safe_buffers_size;
+
+	return( 1 );
+}
+
+
+/* Determines the number of storage media buffers to have in flight in automatic mode
+ * The number is increased by a quarter when reading stalled waiting for a free buffer
+ * while most of the buffers were in flight, and decreased by one when reading did not
+ * stall and less than half of the buffers were in flight on average
+ * Returns 1 if successful or -1 on error
+ */
+int system_resources_get_adaptive_number_of_buffers(
+     int number_of_buffers,
+     int minimum_number_of_buffers,
+     int maximum_number_of_buffers,
+     uint64_t number_of_stalls,
+     uint64_t average_number_in_flight,
+     int *adaptive_number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function      = "system_resources_get_adaptive_number_of_buffers";
+	int safe_number_of_buffers = 0;
+
+	if( minimum_number_of_buffers <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid minimum number of buffers value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_buffers < minimum_number_of_buffers )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( adaptive_number_of_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid adaptive number of buffers.",
+		 function );
+
+		return( -1 );
+	}
+	safe_number_of_buffers = number_of_buffers;
+
+	if( safe_number_of_buffers < minimum_number_of_buffers )
+	{
+		safe_number_of_buffers = minimum_number_of_buffers;
+	}
+	else if( safe_number_of_buffers > maximum_number_of_buffers )
+	{
+		safe_number_of_buffers = maximum_number_of_buffers;
+	}
+	if( ( number_of_stalls > 0 )
+	 && ( ( average_number_in_flight * 4 ) >= ( (uint64_t) safe_number_of_buffers * 3 ) ) )
+	{
+		if( safe_number_of_buffers < 4 )
+		{
+			safe_number_of_buffers += 1;
+		}
+		else if( safe_number_of_buffers <= ( INT_MAX - ( safe_number_of_buffers / 4 ) ) )
+		{
+			safe_number_of_buffers += safe_number_of_buffers / 4;
+		}
+		if( safe_number_of_buffers > maximum_number_of_buffers )
+		{
+			safe_number_of_buffers = maximum_number_of_buffers;
+		}
+	}
+	else if( ( number_of_stalls == 0 )
+	      && ( ( average_number_in_flight * 2 ) < (uint64_t) safe_number_of_buffers ) )
+	{
+		if( safe_number_of_buffers > minimum_number_of_buffers )
+		{
+			safe_number_of_buffers -= 1;
+		}
+	}
+	*adaptive_number_of_buffers = safe_number_of_buffers;
+
+	return( 1 );
+}
@@ -0,0 +1,122 @@
+/*
+ * System resources functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SYSTEM_RESOURCES_H )
+#define _SYSTEM_RESOURCES_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of threads used in automatic mode
+ */
+#define SYSTEM_RESOURCES_MAXIMUM_NUMBER_OF_THREADS		32
+
+/* The minimum and maximum size of the process buffers used in automatic mode
+ */
+#define SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE		( 64 * 1024 * 1024 )
+#define SYSTEM_RESOURCES_MAXIMUM_PROCESS_BUFFERS_SIZE		( 1024 * 1024 * 1024 )
+
+#if !defined( WINAPI )
+
+int system_resources_copy_from_decimal_string(
+     const char *string,
+     size_t string_size,
+     uint64_t *value,
+     size_t *string_index );
+
+int system_resources_read_line(
+     const char *filename,
+     const char *prefix,
+     char *line,
+     size_t line_size );
+
+int system_resources_get_number_of_processors_from_quota(
+     uint64_t quota,
+     uint64_t period,
+     int *number_of_processors );
+
+int system_resources_get_number_of_processors_from_cpu_max(
+     const char *string,
+     size_t string_size,
+     int *number_of_processors );
+
+int system_resources_get_number_of_processors_from_cfs_quota(
+     const char *quota_string,
+     size_t quota_string_size,
+     const char *period_string,
+     size_t period_string_size,
+     int *number_of_processors );
+
+int system_resources_get_memory_limit_from_string(
+     const char *string,
+     size_t string_size,
+     size64_t *memory_limit );
+
+#endif /* !defined( WINAPI ) */
+
+#if defined( __linux__ )
+
+int system_resources_get_control_group_number_of_processors(
+     int *number_of_processors );
+
+int system_resources_get_control_group_memory_limit(
+     size64_t *memory_limit );
+
+#endif /* defined( __linux__ ) */
+
+int system_resources_get_number_of_processors(
+     int *number_of_processors,
+     libcerror_error_t **error );
+
+int system_resources_get_available_memory_size(
+     size64_t *memory_size,
+     libcerror_error_t **error );
+
+int system_resources_get_automatic_number_of_threads(
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+int system_resources_get_automatic_process_buffers_size(
+     size64_t default_process_buffers_size,
+     size64_t *process_buffers_size,
+     libcerror_error_t **error );
+
+int system_resources_get_adaptive_number_of_buffers(
+     int number_of_buffers,
+     int minimum_number_of_buffers,
+     int maximum_number_of_buffers,
+     uint64_t number_of_stalls,
+     uint64_t average_number_in_flight,
+     int *adaptive_number_of_buffers,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SYSTEM_RESOURCES_H ) */
+
@@ -26,7 +26,12 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include <time.h>
+
+#include "buffer_limiter.h"
 #include "byte_size_string.h"
+#include "checkpoint_file.h"
+#include "digest_context.h"
 #include "digest_hash.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
@@ -37,12 +42,14 @@
 #include "ewftools_libcsplit.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
-#include "ewftools_libhmac.h"
 #include "ewftools_system_string.h"
+#include "ewftools_unused.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "sample_scheduler.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
+#include "system_resources.h"
 #include "verification_handle.h"
 
 #define VERIFICATION_HANDLE_VALUE_SIZE				64
@@ -50,6 +57,10 @@
 #define VERIFICATION_HANDLE_NOTIFY_STREAM			stdout
 #define VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE	64 * 1024 * 1024
 
+/* The interval, in bytes, between the integrity hash checkpoints
+ */
+#define VERIFICATION_HANDLE_CHECKPOINT_INTERVAL			( 256 * 1024 * 1024 )
+
 /* Creates a verification handle
  * Make sure the value verification_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -171,6 +182,19 @@ int verification_handle_initialize(
 
 		goto on_error;
 	}
+	if( stage_profiler_initialize(
+	     &( ( *verification_handle )->stage_profiler ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create stage profiler.",
+		 function );
+
+		goto on_error;
+	}
 	( *verification_handle )->input_format             = VERIFICATION_HANDLE_INPUT_FORMAT_RAW;
 	( *verification_handle )->use_data_chunk_functions = use_data_chunk_functions;
 	( *verification_handle )->header_codepage          = LIBEWF_CODEPAGE_ASCII;
@@ -178,13 +202,19 @@ int verification_handle_initialize(
 	( *verification_handle )->notify_stream            = VERIFICATION_HANDLE_NOTIFY_STREAM;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	( *verification_handle )->number_of_threads        = 4;
+	( *verification_handle )->number_of_threads            = 4;
+	( *verification_handle )->maximum_process_buffers_size = VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE;
 #endif
 	return( 1 );
 
 on_error:
 	if( *verification_handle != NULL )
 	{
+		if( ( *verification_handle )->stored_sha256_hash_string != NULL )
+		{
+			memory_free(
+			 ( *verification_handle )->stored_sha256_hash_string );
+		}
 		if( ( *verification_handle )->stored_sha1_hash_string != NULL )
 		{
 			memory_free(
@@ -232,6 +262,56 @@ int verification_handle_free(
 	}
 	if( *verification_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verification_handle )->readers != NULL )
+		{
+			if( verification_handle_free_readers(
+			     *verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free readers.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *verification_handle )->checkpoint_file != NULL )
+		{
+			if( checkpoint_file_free(
+			     &( ( *verification_handle )->checkpoint_file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free checkpoint file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *verification_handle )->sample_scheduler != NULL )
+		{
+			if( sample_scheduler_free(
+			     &( ( *verification_handle )->sample_scheduler ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sample scheduler.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( ( ( *verification_handle )->input_handle != NULL )
 		 && ( libewf_handle_free(
 		       &( ( *verification_handle )->input_handle ),
@@ -248,7 +328,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->md5_context != NULL )
 		{
-			if( libhmac_md5_free(
+			if( digest_context_free(
 			     &( ( *verification_handle )->md5_context ),
 			     error ) != 1 )
 			{
@@ -274,7 +354,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha1_context != NULL )
 		{
-			if( libhmac_sha1_free(
+			if( digest_context_free(
 			     &( ( *verification_handle )->sha1_context ),
 			     error ) != 1 )
 			{
@@ -300,7 +380,7 @@ int verification_handle_free(
 		}
 		if( ( *verification_handle )->sha256_context != NULL )
 		{
-			if( libhmac_sha256_free(
+			if( digest_context_free(
 			     &( ( *verification_handle )->sha256_context ),
 			     error ) != 1 )
 			{
@@ -324,6 +404,19 @@ int verification_handle_free(
 			memory_free(
 			 ( *verification_handle )->stored_sha256_hash_string );
 		}
+		if( stage_profiler_free(
+		     &( ( *verification_handle )->stage_profiler ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stage profiler.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *verification_handle );
 
@@ -341,6 +434,10 @@ int verification_handle_signal_abort(
 {
 	static char *function = "verification_handle_signal_abort";
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int reader_index      = 0;
+#endif
+
 	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
@@ -368,6 +465,34 @@ int verification_handle_signal_abort(
 			return( -1 );
 		}
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->readers != NULL )
+	{
+		for( reader_index = 0;
+		     reader_index < verification_handle->number_of_readers;
+		     reader_index++ )
+		{
+			if( verification_handle->readers[ reader_index ].input_handle == NULL )
+			{
+				continue;
+			}
+			if( libewf_handle_signal_abort(
+			     verification_handle->readers[ reader_index ].input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal reader: %d input handle to abort.",
+				 function,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
+#endif
 	verification_handle->abort = 1;
 
 	return( 1 );
@@ -408,6 +533,8 @@ int verification_handle_set_maximum_number_of_open_handles(
 
 		return( -1 );
 	}
+	verification_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+
 	return( 1 );
 }
 
@@ -533,6 +660,27 @@ int verification_handle_open_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->number_of_threads != 0 )
+	 && ( verification_handle->number_of_readers > 1 ) )
+	{
+		if( verification_handle_open_readers(
+		     verification_handle,
+		     filenames,
+		     number_of_filenames,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open readers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( libewf_filenames != NULL )
 	{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -654,17 +802,40 @@ int verification_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle_close_readers(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close readers.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	return( 0 );
 }
 
-/* Initializes the integrity hash(es)
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Opens the readers on the input files
+ * Every reader has its own libewf input handle, and with it its own file handles,
+ * so that the readers can read the input in parallel
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_initialize_integrity_hash(
+int verification_handle_open_readers(
      verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_initialize_integrity_hash";
+	static char *function              = "verification_handle_open_readers";
+	int maximum_number_of_open_handles = 0;
+	int reader_index                   = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -677,97 +848,174 @@ int verification_handle_initialize_integrity_hash(
 
 		return( -1 );
 	}
-	if( verification_handle->digest_types_set == 0 )
+	if( verification_handle->readers != NULL )
 	{
-		verification_handle->calculate_md5    = verification_handle->stored_md5_hash_available;
-		verification_handle->calculate_sha1   = verification_handle->stored_sha1_hash_available;
-		verification_handle->calculate_sha256 = verification_handle->stored_sha256_hash_available;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - readers value already set.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( verification_handle->calculate_md5 == 0 )
-	 && ( verification_handle->calculate_sha1 == 0 )
-	 && ( verification_handle->calculate_sha256 == 0 ) )
+	if( ( verification_handle->number_of_readers <= 1 )
+	 || ( verification_handle->number_of_readers > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READERS ) )
 	{
-		verification_handle->calculate_md5 = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid verification handle - number of readers value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	if( verification_handle->calculate_md5 != 0 )
+	maximum_number_of_open_handles = verification_handle->maximum_number_of_open_handles;
+
+	if( maximum_number_of_open_handles > 0 )
 	{
-		if( libhmac_md5_initialize(
-		     &( verification_handle->md5_context ),
+		/* The input handle and the readers share the maximum number of open file handles
+		 */
+		maximum_number_of_open_handles /= verification_handle->number_of_readers + 1;
+
+		if( maximum_number_of_open_handles == 0 )
+		{
+			maximum_number_of_open_handles = 1;
+		}
+		if( libewf_handle_set_maximum_number_of_open_handles(
+		     verification_handle->input_handle,
+		     maximum_number_of_open_handles,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize MD5 context.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in input handle.",
 			 function );
 
 			goto on_error;
 		}
-		verification_handle->md5_context_initialized = 1;
 	}
-	if( verification_handle->calculate_sha1 != 0 )
+	verification_handle->readers = (verification_handle_reader_t *) memory_allocate(
+	                                                                 sizeof( verification_handle_reader_t ) * verification_handle->number_of_readers );
+
+	if( verification_handle->readers == NULL )
 	{
-		if( libhmac_sha1_initialize(
-		     &( verification_handle->sha1_context ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create readers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     verification_handle->readers,
+	     0,
+	     sizeof( verification_handle_reader_t ) * verification_handle->number_of_readers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear readers.",
+		 function );
+
+		memory_free(
+		 verification_handle->readers );
+
+		verification_handle->readers = NULL;
+
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < verification_handle->number_of_readers;
+	     reader_index++ )
+	{
+		if( libewf_handle_initialize(
+		     &( verification_handle->readers[ reader_index ].input_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA1 context.",
-			 function );
+			 "%s: unable to create reader: %d input handle.",
+			 function,
+			 reader_index );
 
 			goto on_error;
 		}
-		verification_handle->sha1_context_initialized = 1;
-	}
-	if( verification_handle->calculate_sha256 != 0 )
-	{
-		if( libhmac_sha256_initialize(
-		     &( verification_handle->sha256_context ),
+		if( maximum_number_of_open_handles > 0 )
+		{
+			if( libewf_handle_set_maximum_number_of_open_handles(
+			     verification_handle->readers[ reader_index ].input_handle,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in reader: %d input handle.",
+				 function,
+				 reader_index );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libewf_handle_open_wide(
+		     verification_handle->readers[ reader_index ].input_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
+		     error ) != 1 )
+#else
+		if( libewf_handle_open(
+		     verification_handle->readers[ reader_index ].input_handle,
+		     filenames,
+		     number_of_filenames,
+		     LIBEWF_OPEN_READ,
 		     error ) != 1 )
+#endif
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize SHA256 context.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open files in reader: %d input handle.",
+			 function,
+			 reader_index );
 
 			goto on_error;
 		}
-		verification_handle->sha256_context_initialized = 1;
 	}
 	return( 1 );
 
 on_error:
-	if( verification_handle->sha1_context != NULL )
-	{
-		libhmac_sha1_free(
-		 &( verification_handle->sha1_context ),
-		 NULL );
-	}
-	if( verification_handle->md5_context != NULL )
+	if( verification_handle->readers != NULL )
 	{
-		libhmac_md5_free(
-		 &( verification_handle->md5_context ),
+		verification_handle_free_readers(
+		 verification_handle,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Updates the integrity hash(es)
+/* Closes the readers
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_update_integrity_hash(
+int verification_handle_close_readers(
      verification_handle_t *verification_handle,
-     const uint8_t *buffer,
-     size_t buffer_size,
      libcerror_error_t **error )
 {
-	static char *function = "verification_handle_update_integrity_hash";
+	static char *function = "verification_handle_close_readers";
+	int reader_index      = 0;
+	int result            = 1;
 
 	if( verification_handle == NULL )
 	{
@@ -780,32 +1028,307 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( verification_handle->readers == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
+		return( 1 );
 	}
-	if( ( buffer_size == 0 )
-	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	for( reader_index = 0;
+	     reader_index < verification_handle->number_of_readers;
+	     reader_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid buffer size value out of bounds.",
-		 function );
+		if( verification_handle->readers[ reader_index ].input_handle == NULL )
+		{
+			continue;
+		}
+		if( libewf_handle_close(
+		     verification_handle->readers[ reader_index ].input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close reader: %d input handle.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Frees the readers
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_free_readers(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_free_readers";
+	int reader_index      = 0;
+	int result            = 1;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->readers == NULL )
+	{
+		return( 1 );
+	}
+	for( reader_index = 0;
+	     reader_index < verification_handle->number_of_readers;
+	     reader_index++ )
+	{
+		if( verification_handle->readers[ reader_index ].input_handle == NULL )
+		{
+			continue;
+		}
+		if( libewf_handle_free(
+		     &( verification_handle->readers[ reader_index ].input_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reader: %d input handle.",
+			 function,
+			 reader_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 verification_handle->readers );
+
+	verification_handle->readers = NULL;
+
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Initializes the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_initialize_integrity_hash(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_initialize_integrity_hash";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->digest_types_set == 0 )
+	{
+		verification_handle->calculate_md5    = verification_handle->stored_md5_hash_available;
+		verification_handle->calculate_sha1   = verification_handle->stored_sha1_hash_available;
+		verification_handle->calculate_sha256 = verification_handle->stored_sha256_hash_available;
+	}
+	if( ( verification_handle->calculate_md5 == 0 )
+	 && ( verification_handle->calculate_sha1 == 0 )
+	 && ( verification_handle->calculate_sha256 == 0 ) )
+	{
+		verification_handle->calculate_md5 = 1;
+	}
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		if( digest_context_initialize(
+		     &( verification_handle->md5_context ),
+		     DIGEST_CONTEXT_TYPE_MD5,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize MD5 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_context_set_backend(
+		     verification_handle->md5_context,
+		     verification_handle->hash_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set MD5 context backend.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->md5_context_initialized = 1;
+	}
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		if( digest_context_initialize(
+		     &( verification_handle->sha1_context ),
+		     DIGEST_CONTEXT_TYPE_SHA1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA1 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_context_set_backend(
+		     verification_handle->sha1_context,
+		     verification_handle->hash_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA1 context backend.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->sha1_context_initialized = 1;
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		if( digest_context_initialize(
+		     &( verification_handle->sha256_context ),
+		     DIGEST_CONTEXT_TYPE_SHA256,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize SHA256 context.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_context_set_backend(
+		     verification_handle->sha256_context,
+		     verification_handle->hash_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set SHA256 context backend.",
+			 function );
+
+			goto on_error;
+		}
+		verification_handle->sha256_context_initialized = 1;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_stage != NULL )
+	{
+		if( verification_handle_append_digest_stage_digests(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append digests to digest stage.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( verification_handle->sha1_context != NULL )
+	{
+		digest_context_free(
+		 &( verification_handle->sha1_context ),
+		 NULL );
+	}
+	if( verification_handle->md5_context != NULL )
+	{
+		digest_context_free(
+		 &( verification_handle->md5_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Updates the integrity hash(es)
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_update_integrity_hash(
+     verification_handle_t *verification_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_update_integrity_hash";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
 
 		return( -1 );
 	}
 	if( verification_handle->calculate_md5 != 0 )
 	{
-		if( libhmac_md5_update(
+		if( digest_context_update(
 		     verification_handle->md5_context,
 		     buffer,
 		     buffer_size,
@@ -823,7 +1346,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha1 != 0 )
 	{
-		if( libhmac_sha1_update(
+		if( digest_context_update(
 		     verification_handle->sha1_context,
 		     buffer,
 		     buffer_size,
@@ -841,7 +1364,7 @@ int verification_handle_update_integrity_hash(
 	}
 	if( verification_handle->calculate_sha256 != 0 )
 	{
-		if( libhmac_sha256_update(
+		if( digest_context_update(
 		     verification_handle->sha256_context,
 		     buffer,
 		     buffer_size,
@@ -867,9 +1390,9 @@ int verification_handle_finalize_integrity_hash(
      verification_handle_t *verification_handle,
      libcerror_error_t **error )
 {
-	uint8_t calculated_md5_hash[ LIBHMAC_MD5_HASH_SIZE ];
-	uint8_t calculated_sha1_hash[ LIBHMAC_SHA1_HASH_SIZE ];
-	uint8_t calculated_sha256_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+	uint8_t calculated_md5_hash[ DIGEST_CONTEXT_MD5_HASH_SIZE ];
+	uint8_t calculated_sha1_hash[ DIGEST_CONTEXT_SHA1_HASH_SIZE ];
+	uint8_t calculated_sha256_hash[ DIGEST_CONTEXT_SHA256_HASH_SIZE ];
 
 	static char *function = "verification_handle_finalize_integrity_hash";
 
@@ -905,10 +1428,10 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_md5_finalize(
+		if( digest_context_finalize(
 		     verification_handle->md5_context,
 		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
+		     DIGEST_CONTEXT_MD5_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -920,7 +1443,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_md5_free(
+		if( digest_context_free(
 		     &( verification_handle->md5_context ),
 		     error ) != 1 )
 		{
@@ -935,7 +1458,7 @@ int verification_handle_finalize_integrity_hash(
 		}
 		if( digest_hash_copy_to_string(
 		     calculated_md5_hash,
-		     LIBHMAC_MD5_HASH_SIZE,
+		     DIGEST_CONTEXT_MD5_HASH_SIZE,
 		     verification_handle->calculated_md5_hash_string,
 		     33,
 		     error ) != 1 )
@@ -971,10 +1494,10 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha1_finalize(
+		if( digest_context_finalize(
 		     verification_handle->sha1_context,
 		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
+		     DIGEST_CONTEXT_SHA1_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -986,7 +1509,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha1_free(
+		if( digest_context_free(
 		     &( verification_handle->sha1_context ),
 		     error ) != 1 )
 		{
@@ -1001,7 +1524,7 @@ int verification_handle_finalize_integrity_hash(
 		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha1_hash,
-		     LIBHMAC_SHA1_HASH_SIZE,
+		     DIGEST_CONTEXT_SHA1_HASH_SIZE,
 		     verification_handle->calculated_sha1_hash_string,
 		     41,
 		     error ) != 1 )
@@ -1037,10 +1560,10 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha256_finalize(
+		if( digest_context_finalize(
 		     verification_handle->sha256_context,
 		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
+		     DIGEST_CONTEXT_SHA256_HASH_SIZE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1052,7 +1575,7 @@ int verification_handle_finalize_integrity_hash(
 
 			goto on_error;
 		}
-		if( libhmac_sha256_free(
+		if( digest_context_free(
 		     &( verification_handle->sha256_context ),
 		     error ) != 1 )
 		{
@@ -1067,7 +1590,7 @@ int verification_handle_finalize_integrity_hash(
 		}
 		if( digest_hash_copy_to_string(
 		     calculated_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
+		     DIGEST_CONTEXT_SHA256_HASH_SIZE,
 		     verification_handle->calculated_sha256_hash_string,
 		     65,
 		     error ) != 1 )
@@ -1111,42 +1634,126 @@ on_error:
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
+/* Appends the digests of the integrity hash(es) to the digest stage
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_process_storage_media_buffer_callback(
-     storage_media_buffer_t *storage_media_buffer,
-     verification_handle_t *verification_handle )
+int verification_handle_append_digest_stage_digests(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
 {
-        libcerror_error_t *error = NULL;
-        static char *function    = "verification_handle_process_storage_media_buffer_callback";
-	ssize_t process_count    = 0;
+	static char *function = "verification_handle_append_digest_stage_digests";
 
-	if( storage_media_buffer == NULL )
+	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid storage media buffer.",
+		 "%s: invalid verification handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( verification_handle->abort != 0 )
+	if( verification_handle->calculate_md5 != 0 )
 	{
-		return( 1 );
+		if( digest_stage_append_digest(
+		     verification_handle->digest_stage,
+		     (intptr_t *) verification_handle->md5_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append MD5 digest.",
+			 function );
+
+			return( -1 );
+		}
 	}
-	process_count = storage_media_buffer_read_process(
-			 storage_media_buffer,
-			 &error );
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		if( digest_stage_append_digest(
+		     verification_handle->digest_stage,
+		     (intptr_t *) verification_handle->sha1_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA1 digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		if( digest_stage_append_digest(
+		     verification_handle->digest_stage,
+		     (intptr_t *) verification_handle->sha256_context,
+		     (int (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) &digest_context_update,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append SHA256 digest.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a storage media buffer, of which the integrity hash(es) were updated, onto the queue
+ * Callback function for the digest stage
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_digest_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "verification_handle_digest_stage_release_callback";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( storage_media_buffer_queue_release_buffer(
+	     verification_handle->storage_media_buffer_queue,
+	     storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to release storage media buffer onto queue.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
 
-	if( process_count < 0 )
+on_error:
+	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
-		if( ( libcnotify_verbose != 0 )
-		 && ( error != NULL ) )
+		if( libcnotify_verbose != 0 )
 		{
 			libcnotify_print_error_backtrace(
 			 error );
@@ -1154,11 +1761,88 @@ int verification_handle_process_storage_media_buffer_callback(
 #endif
 		libcerror_error_free(
 		 &error );
+	}
+	if( ( verification_handle != NULL )
+	 && ( verification_handle->abort == 0 ) )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Prepares a storage media buffer for verification
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_process_storage_media_buffer_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle )
+{
+        libcerror_error_t *error = NULL;
+        static char *function    = "verification_handle_process_storage_media_buffer_callback";
+	ssize_t process_count    = 0;
+	int64_t start_timestamp  = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* On abort the storage media buffer is still pushed onto the output window
+	 * so that the output window releases it, and the storage media buffers that follow it
+	 */
+	if( verification_handle->abort == 0 )
+	{
+		/* Profiling is best effort and does not affect the verification
+		 */
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		process_count = storage_media_buffer_read_process(
+				 storage_media_buffer,
+				 &error );
+
+		if( process_count < 0 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
 
-		storage_media_buffer->is_corrupted = 1;
+			storage_media_buffer->is_corrupted = 1;
+		}
+		stage_profiler_add_sample(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_UNPACK,
+		 start_timestamp,
+		 (uint64_t) storage_media_buffer->processed_size,
+		 NULL );
 	}
-	if( libcthreads_thread_pool_push(
-	     verification_handle->output_thread_pool,
+	stage_profiler_get_timestamp(
+	 &( storage_media_buffer->output_window_timestamp ),
+	 NULL );
+
+	/* The output window passes the storage media buffer on, from this or another process thread,
+	 * when all the preceding storage media buffers have been passed on
+	 */
+	if( reorder_window_push(
+	     verification_handle->output_window,
+	     storage_media_buffer->sequence_number,
 	     (intptr_t *) storage_media_buffer,
 	     &error ) != 1 )
 	{
@@ -1166,7 +1850,7 @@ int verification_handle_process_storage_media_buffer_callback(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to push storage media buffer onto output thread pool queue.",
+		 "%s: unable to push storage media buffer onto output window.",
 		 function );
 
 		goto on_error;
@@ -1216,21 +1900,19 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for verification
- * Callback function for the process thread pool
+/* Passes a storage media buffer on to the digest stage
+ * Callback function for the output window, that is called for the storage media buffers in order
  * Returns 1 if successful or -1 on error
  */
 int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle )
 {
-	libcdata_list_element_t *element      = NULL;
-	libcdata_list_element_t *next_element = NULL;
-        libcerror_error_t *error              = NULL;
-	uint8_t *data                         = NULL;
-        static char *function                 = "verification_handle_output_storage_media_buffer_callback";
-	size_t data_size                      = 0;
-	int result                            = 0;
+        libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+        static char *function    = "verification_handle_output_storage_media_buffer_callback";
+	size_t data_size         = 0;
+	int result               = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1252,244 +1934,494 @@ int verification_handle_output_storage_media_buffer_callback(
 		 "%s: invalid storage media buffer.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 	if( verification_handle->abort != 0 )
 	{
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer = NULL;
+
+			goto on_error;
+		}
 		return( 1 );
 	}
-	if( libcdata_list_insert_value(
-	     verification_handle->output_list,
-	     (intptr_t *) storage_media_buffer,
-	     (int (*)(intptr_t *, intptr_t *, libcerror_error_t **)) &storage_media_buffer_compare,
-	     LIBCDATA_INSERT_FLAG_UNIQUE_ENTRIES,
-	     &error ) != 1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert storage media buffer into output list.",
-		 function );
+	/* The time the storage media buffer was held in the output window
+	 */
+	stage_profiler_add_sample(
+	 verification_handle->stage_profiler,
+	 STAGE_PROFILER_STAGE_REORDER,
+	 storage_media_buffer->output_window_timestamp,
+	 (uint64_t) storage_media_buffer->processed_size,
+	 NULL );
 
-		goto on_error;
-	}
-	storage_media_buffer = NULL;
+	result = storage_media_buffer_is_corrupted(
+	          storage_media_buffer,
+	          &error );
 
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     &error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 "%s: unable to determine if storage media buffer is corrupted.",
 		 function );
 
 		goto on_error;
 	}
-	while( element != NULL )
+	else if( result != 0 )
 	{
-		if( verification_handle->abort != 0 )
-		{
-			break;
-		}
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
+		/* Append a read error
+		 */
+		if( verification_handle_append_read_error(
+		     verification_handle,
+		     storage_media_buffer->storage_media_offset,
+		     (size_t) verification_handle->chunk_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append read error.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+	}
+	if( storage_media_buffer_get_data(
+	     storage_media_buffer,
+	     &data,
+	     &data_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine storage media buffer data.",
+		 function );
 
-			goto on_error;
-		}
-		if( storage_media_buffer->storage_media_offset != verification_handle->last_offset_hashed )
-		{
-			break;
-		}
-		result = storage_media_buffer_is_corrupted(
-		          storage_media_buffer,
-		          &error );
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
 
-		if( result == -1 )
+	/* The digest stage releases the storage media buffer onto the queue
+	 * after all the integrity hash(es) were updated
+	 */
+	result = digest_stage_push(
+	          verification_handle->digest_stage,
+	          (intptr_t *) storage_media_buffer,
+	          data,
+	          storage_media_buffer->processed_size,
+	          &error );
+
+	storage_media_buffer = NULL;
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto digest stage.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_update_checkpoint(
+	     verification_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		if( process_status_update(
+		     verification_handle->process_status,
+		     verification_handle->last_offset_hashed,
+		     verification_handle->media_size,
+		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if storage media buffer is corrupted.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		else if( result != 0 )
-		{
-			/* Append a read error
-			 */
-			if( verification_handle_append_read_error(
-			     verification_handle,
-			     storage_media_buffer->storage_media_offset,
-			     (size_t) verification_handle->chunk_size,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to append read error.",
-				 function );
-
-				storage_media_buffer = NULL;
+	}
+	return( 1 );
 
-				goto on_error;
-			}
-		}
-		if( storage_media_buffer_get_data(
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     verification_handle->storage_media_buffer_queue,
 		     storage_media_buffer,
-		     &data,
-		     &data_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine storage media buffer data.",
+			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			storage_media_buffer = NULL;
-
-			goto on_error;
+			storage_media_buffer_free(
+			 &storage_media_buffer,
+			 NULL );
 		}
-		if( verification_handle_update_integrity_hash(
-		     verification_handle,
-		     data,
-		     storage_media_buffer->processed_size,
-		     &error ) != 1 )
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Empties the output window
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_empty_output_window(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        static char *function                        = "verification_handle_empty_output_window";
+	int result                                   = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = reorder_window_remove_value(
+		          verification_handle->output_window,
+		          (intptr_t **) &storage_media_buffer,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
-			 &error,
+			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to update integrity hash(es).",
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove storage media buffer from output window.",
 			 function );
 
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to release storage media buffer onto queue.",
+				 function );
+
+				return( -1 );
+			}
 			storage_media_buffer = NULL;
+		}
+	}
+	while( result != 0 );
 
-			goto on_error;
+	return( 1 );
+}
+
+/* Reads storage media buffers from the input
+ * The readers claim the storage media buffers in order of the input, so that the
+ * storage media buffers in flight always fit in the output window
+ * Callback function for the reader thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_reader_callback(
+     verification_handle_reader_t *reader,
+     verification_handle_t *verification_handle )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+        libcerror_error_t *error                     = NULL;
+        static char *function                        = "verification_handle_reader_callback";
+	size_t read_size                             = 0;
+	ssize_t read_count                           = 0;
+	off64_t storage_media_offset                 = 0;
+	int64_t start_timestamp                      = 0;
+	uint64_t sequence_number                     = 0;
+	uint8_t has_sequence_number                  = 0;
+	int is_done                                  = 0;
+
+	if( reader == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reader.",
+		 function );
+
+		goto on_error;
+	}
+	while( verification_handle->abort == 0 )
+	{
+		if( verification_handle->buffer_limiter != NULL )
+		{
+			if( buffer_limiter_adjust(
+			     verification_handle->buffer_limiter,
+			     &error ) == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to adjust buffer limiter.",
+				 function );
+
+				goto on_error;
+			}
 		}
-		verification_handle->last_offset_hashed = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+		/* Profiling is best effort and does not affect the verification
+		 * Grabbing blocks while all the storage media buffers are in flight
+		 */
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
+		if( storage_media_buffer_queue_grab_buffer(
+		     verification_handle->storage_media_buffer_queue,
+		     &storage_media_buffer,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
+			 "%s: unable to grab storage media buffer from queue.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     &error ) != 1 )
+		stage_profiler_add_wait(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 NULL );
+
+		if( storage_media_buffer == NULL )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing storage media buffer.",
 			 function );
 
-			storage_media_buffer = NULL;
-
 			goto on_error;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
+		/* The storage media buffer is grabbed before the offset is claimed
+		 * otherwise a reader could claim an offset that does not fit in the output window
 		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
+		if( libcthreads_mutex_grab(
+		     verification_handle->reader_mutex,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab reader mutex.",
 			 function );
 
 			goto on_error;
 		}
-		element = next_element;
+		if( ( verification_handle->abort != 0 )
+		 || ( (size64_t) verification_handle->read_offset >= verification_handle->media_size ) )
+		{
+			is_done = 1;
+		}
+		else
+		{
+			storage_media_offset = verification_handle->read_offset;
+			read_size            = verification_handle->read_buffer_size;
 
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
+			if( (size64_t) read_size > ( verification_handle->media_size - (size64_t) storage_media_offset ) )
+			{
+				read_size = (size_t) ( verification_handle->media_size - (size64_t) storage_media_offset );
+			}
+			verification_handle->read_offset += (off64_t) read_size;
+
+			if( reorder_window_get_next_sequence_number(
+			     verification_handle->output_window,
+			     &sequence_number,
+			     &error ) == 1 )
+			{
+				has_sequence_number = 1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     verification_handle->reader_mutex,
 		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release reader mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( is_done != 0 )
+		{
+			break;
+		}
+		if( has_sequence_number == 0 )
 		{
 			libcerror_error_set(
 			 &error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 "%s: unable to retrieve storage media buffer sequence number.",
 			 function );
 
 			goto on_error;
 		}
-		storage_media_buffer = NULL;
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+		storage_media_buffer->sequence_number      = sequence_number;
 
-		if( verification_handle->process_status != NULL )
+		if( libewf_handle_seek_offset(
+		     reader->input_handle,
+		     storage_media_offset,
+		     SEEK_SET,
+		     &error ) == -1 )
 		{
-			if( process_status_update(
-			     verification_handle->process_status,
-			     verification_handle->last_offset_hashed,
-			     verification_handle->media_size,
-			     &error ) != 1 )
-			{
-				libcerror_error_set(
-				 &error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to update process status.",
-				 function );
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 storage_media_offset,
+			 storage_media_offset );
 
-				goto on_error;
-			}
+			goto on_error;
 		}
-	}
-	return( 1 );
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
 
-on_error:
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              reader->input_handle,
+		              read_size,
+		              &error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
+			 function );
+
+			goto on_error;
+		}
+		stage_profiler_add_sample(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		if( libcthreads_thread_pool_push(
+		     verification_handle->process_thread_pool,
+		     (intptr_t *) storage_media_buffer,
+		     &error ) == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto process thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		/* Pushing blocks while the queue of the process threads is full
+		 */
+		stage_profiler_add_wait(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_UNPACK,
+		 start_timestamp,
+		 NULL );
+
+		storage_media_buffer = NULL;
+		has_sequence_number  = 0;
+	}
 	if( storage_media_buffer != NULL )
 	{
 		if( storage_media_buffer_queue_release_buffer(
@@ -1504,11 +2436,12 @@ on_error:
 			 "%s: unable to release storage media buffer onto queue.",
 			 function );
 
-			storage_media_buffer_free(
-			 &storage_media_buffer,
-			 NULL );
+			goto on_error;
 		}
 	}
+	return( 1 );
+
+on_error:
 	if( error != NULL )
 	{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1521,26 +2454,59 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( reader != NULL )
+	{
+		reader->has_failed = 1;
+	}
 	if( verification_handle->abort == 0 )
 	{
 		verification_handle_signal_abort(
 		 verification_handle,
 		 NULL );
 	}
+	if( storage_media_buffer != NULL )
+	{
+		/* A claimed sequence number is filled in with the storage media buffer
+		 * so that the output window keeps passing on, and releasing, the storage media buffers
+		 */
+		if( has_sequence_number != 0 )
+		{
+			if( reorder_window_push(
+			     verification_handle->output_window,
+			     storage_media_buffer->sequence_number,
+			     (intptr_t *) storage_media_buffer,
+			     NULL ) == 1 )
+			{
+				storage_media_buffer = NULL;
+			}
+		}
+		if( storage_media_buffer != NULL )
+		{
+			if( storage_media_buffer_queue_release_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     storage_media_buffer,
+			     NULL ) != 1 )
+			{
+				storage_media_buffer_free(
+				 &storage_media_buffer,
+				 NULL );
+			}
+		}
+	}
 	return( -1 );
 }
 
-/* Empties the output list
+/* Reads the input with the readers, starting at the storage media offset
  * Returns 1 if successful or -1 on error
  */
-int verification_handle_empty_output_list(
+int verification_handle_read_input_with_readers(
      verification_handle_t *verification_handle,
+     off64_t storage_media_offset,
+     size_t process_buffer_size,
      libcerror_error_t **error )
 {
-	libcdata_list_element_t *element             = NULL;
-	libcdata_list_element_t *next_element        = NULL;
-	storage_media_buffer_t *storage_media_buffer = NULL;
-        static char *function                        = "verification_handle_empty_output_list";
+	static char *function = "verification_handle_read_input_with_readers";
+	int reader_index      = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1553,145 +2519,178 @@ int verification_handle_empty_output_list(
 
 		return( -1 );
 	}
-	if( libcdata_list_get_first_element(
-	     verification_handle->output_list,
-	     &element,
-	     error ) != 1 )
+	if( verification_handle->readers == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve first element.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing readers.",
 		 function );
 
 		return( -1 );
 	}
-	while( element != NULL )
+	if( process_buffer_size == 0 )
 	{
-		if( libcdata_list_element_get_value(
-		     element,
-		     (intptr_t **) &storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve value from list element.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid process buffer size value zero or less.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing storage media buffer.",
-			 function );
+		return( -1 );
+	}
+	if( storage_media_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid storage media offset value less than zero.",
+		 function );
 
-			return( -1 );
-		}
-		if( storage_media_buffer_queue_release_buffer(
-		     verification_handle->storage_media_buffer_queue,
-		     storage_media_buffer,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
-			 function );
+		return( -1 );
+	}
+	verification_handle->read_offset      = storage_media_offset;
+	verification_handle->read_buffer_size = process_buffer_size;
 
-			return( -1 );
-		}
-		storage_media_buffer = NULL;
+	if( libcthreads_mutex_initialize(
+	     &( verification_handle->reader_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reader mutex.",
+		 function );
 
-		if( libcdata_list_element_get_next_element(
-		     element,
-		     &next_element,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve next list element.",
-			 function );
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( verification_handle->reader_thread_pool ),
+	     NULL,
+	     verification_handle->number_of_readers,
+	     verification_handle->number_of_readers,
+	     (int (*)(intptr_t *, void *)) &verification_handle_reader_callback,
+	     (void *) verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize reader thread pool.",
+		 function );
 
-			return( -1 );
-		}
-		if( libcdata_list_remove_element(
-		     verification_handle->output_list,
-		     element,
-		     error ) != 1 )
+		goto on_error;
+	}
+	for( reader_index = 0;
+	     reader_index < verification_handle->number_of_readers;
+	     reader_index++ )
+	{
+		verification_handle->readers[ reader_index ].has_failed = 0;
+
+		if( libcthreads_thread_pool_push(
+		     verification_handle->reader_thread_pool,
+		     (intptr_t *) &( verification_handle->readers[ reader_index ] ),
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
-			 "%s: unable to remove list element from output list.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader: %d onto reader thread pool queue.",
+			 function,
+			 reader_index );
 
-			return( -1 );
+			verification_handle_signal_abort(
+			 verification_handle,
+			 NULL );
+
+			break;
 		}
-		/* The output list no longer manages the list element and the storage media buffer it contains
-		 */
-		if( libcdata_list_element_free(
-		     &element,
-		     NULL,
-		     error ) != 1 )
+	}
+	if( libcthreads_thread_pool_join(
+	     &( verification_handle->reader_thread_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join reader thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_free(
+	     &( verification_handle->reader_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free reader mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( reader_index < verification_handle->number_of_readers )
+	{
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index < verification_handle->number_of_readers;
+	     reader_index++ )
+	{
+		if( verification_handle->readers[ reader_index ].has_failed != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free list element.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: reader: %d unable to read data.",
+			 function,
+			 reader_index );
 
 			return( -1 );
 		}
-		element = next_element;
 	}
 	return( 1 );
+
+on_error:
+	if( verification_handle->reader_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->reader_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->reader_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( verification_handle->reader_mutex ),
+		 NULL );
+	}
+	return( -1 );
 }
 
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
-/* Verifies the input
- * Returns 1 if successful, 0 if not or -1 on error
+/* Opens the checkpoint file of the verification handle
+ * The checkpoint file is stored next to the first segment file using the segment filename
+ * with the checkpoint extension, so that it does not conflict with the checkpoints of an acquiry
+ * Returns 1 if successful or -1 on error
  */
-int verification_handle_verify_input(
+int verification_handle_open_checkpoint_file(
      verification_handle_t *verification_handle,
-     uint8_t print_status_information,
-     log_handle_t *log_handle,
+     const system_character_t *filename,
      libcerror_error_t **error )
 {
-	storage_media_buffer_t *storage_media_buffer = NULL;
-	uint8_t *data                                = NULL;
-	static char *function                        = "verification_handle_verify_input";
-	size64_t remaining_media_size                = 0;
-	size_t data_size                             = 0;
-	size_t process_buffer_size                   = 0;
-	size_t read_size                             = 0;
-	ssize_t process_count                        = 0;
-	ssize_t read_count                           = 0;
-	off64_t storage_media_offset                 = 0;
-	uint32_t number_of_checksum_errors           = 0;
-	uint8_t storage_media_buffer_mode            = 0;
-	int is_corrupted                             = 0;
-	int md5_hash_compare                         = 0;
-	int result                                   = 0;
-	int sha1_hash_compare                        = 0;
-	int sha256_hash_compare                      = 0;
-	int status                                   = PROCESS_STATUS_COMPLETED;
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	int maximum_number_of_queued_items           = 0;
-#endif
+	static char *function  = "verification_handle_open_checkpoint_file";
+	size_t filename_length = 0;
 
 	if( verification_handle == NULL )
 	{
@@ -1704,566 +2703,3071 @@ int verification_handle_verify_input(
 
 		return( -1 );
 	}
-	if( verification_handle->chunk_size == 0 )
+	if( verification_handle->checkpoint_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - checkpoint file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	filename_length = system_string_length(
+	                   filename );
+
+	if( checkpoint_file_initialize(
+	     &( verification_handle->checkpoint_file ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid process buffer size value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create checkpoint file.",
+		 function );
+
+		goto on_error;
+	}
+	if( checkpoint_file_set_filename(
+	     verification_handle->checkpoint_file,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint filename.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( verification_handle->checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &( verification_handle->checkpoint_file ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Restores the integrity hash(es) from the last checkpoint of a previous verification
+ * This function should be called after the integrity hash(es) were initialized
+ * Returns 1 if successful, 0 if no applicable checkpoint is available or -1 on error
+ */
+int verification_handle_restore_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t *checkpoint_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_restore_checkpoint";
+	uint64_t entry_offset = 0;
+	uint32_t digest_flags = 0;
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
 		 function );
 
 		return( -1 );
 	}
-#if !defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->number_of_threads != 0 )
+	if( checkpoint_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: multi-threading not supported.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checkpoint offset.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libewf_handle_get_media_size(
-	     verification_handle->input_handle,
-	     &( verification_handle->media_size ),
+	if( verification_handle->checkpoint_file == NULL )
+	{
+		return( 0 );
+	}
+	if( verification_handle->calculate_md5 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_MD5;
+	}
+	if( verification_handle->calculate_sha1 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_SHA1;
+	}
+	if( verification_handle->calculate_sha256 != 0 )
+	{
+		digest_flags |= CHECKPOINT_FILE_DIGEST_FLAG_SHA256;
+	}
+	/* The checkpoint file only applies to a verification of the same media size and digest types
+	 */
+	if( checkpoint_file_set_values(
+	     verification_handle->checkpoint_file,
+	     0,
+	     (uint64_t) verification_handle->media_size,
+	     digest_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set checkpoint file values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( verification_handle->use_data_chunk_functions != 0 )
+	result = checkpoint_file_read(
+	          verification_handle->checkpoint_file,
+	          error );
+
+	if( result == -1 )
 	{
-		process_buffer_size       = verification_handle->chunk_size;
-		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read checkpoint file.",
+		 function );
 
-		if( ( verification_handle->format == LIBEWF_FORMAT_SMART )
-		 || ( verification_handle->format == LIBEWF_FORMAT_FTK_IMAGER ) )
-		{
-			/* In EWF-S01 (SMART) the size of a stored chunk can be larger than the chunk size
-			 */
-			process_buffer_size *= 2;
-		}
+		return( -1 );
 	}
-	else
+	else if( result == 0 )
 	{
-		if( verification_handle->process_buffer_size == 0 )
-		{
-			process_buffer_size = verification_handle->chunk_size;
-		}
-		else
-		{
-			process_buffer_size = verification_handle->process_buffer_size;
-		}
-		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
+		return( 0 );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->number_of_threads != 0 )
-	{
-		maximum_number_of_queued_items = 1 + (int) ( VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE / process_buffer_size );
+	result = checkpoint_file_restore_entry(
+	          verification_handle->checkpoint_file,
+	          (uint64_t) verification_handle->media_size,
+	          &entry_offset,
+	          verification_handle->md5_context,
+	          verification_handle->sha1_context,
+	          verification_handle->sha256_context,
+	          error );
 
-		if( libcthreads_thread_pool_create(
-		     &( verification_handle->process_thread_pool ),
-		     NULL,
-		     verification_handle->number_of_threads,
-		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
-		     (void *) verification_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize process thread pool.",
-			 function );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to restore checkpoint.",
+		 function );
 
-			goto on_error;
-		}
-		if( libcthreads_thread_pool_create(
-		     &( verification_handle->output_thread_pool ),
-		     NULL,
-		     1,
-		     maximum_number_of_queued_items,
-		     (int (*)(intptr_t *, void *)) &verification_handle_output_storage_media_buffer_callback,
-		     (void *) verification_handle,
-		     error ) != 1 )
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The data chunk functions can only continue at the start of a chunk
+		 */
+		if( ( verification_handle->use_data_chunk_functions != 0 )
+		 && ( ( entry_offset % verification_handle->chunk_size ) != 0 ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize output thread pool.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid checkpoint offset: %" PRIu64 " value not aligned with chunk size.",
+			 function,
+			 entry_offset );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libcdata_list_initialize(
-		     &( verification_handle->output_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create output list.",
-			 function );
+		verification_handle->last_offset_hashed = (off64_t) entry_offset;
 
-			goto on_error;
+		*checkpoint_offset = (off64_t) entry_offset;
+	}
+	return( result );
+}
+
+/* Writes a checkpoint of the integrity hash(es) at the last offset hashed
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_write_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_write_checkpoint";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->checkpoint_file == NULL )
+	{
+		return( 1 );
+	}
+	if( verification_handle->checkpoint_file->number_of_entries > 0 )
+	{
+		if( (uint64_t) verification_handle->last_offset_hashed <= verification_handle->checkpoint_file->entries[ verification_handle->checkpoint_file->number_of_entries - 1 ].offset )
+		{
+			return( 1 );
 		}
-		if( storage_media_buffer_queue_initialize(
-		     &( verification_handle->storage_media_buffer_queue ),
-		     verification_handle->input_handle,
-		     maximum_number_of_queued_items,
-		     storage_media_buffer_mode,
-		     process_buffer_size,
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_stage != NULL )
+	{
+		/* Wait for the digest threads so that the digest states match the last offset hashed
+		 */
+		if( digest_stage_wait(
+		     verification_handle->digest_stage,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create storage media buffer queue.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for digest stage.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
-	/* Get the integrity hashes from the input first to determine
-	 * which digest (hash) types are used.
-	 */
-	if( verification_handle_get_integrity_hash_from_input(
-	     verification_handle,
+#endif
+	if( checkpoint_file_append_entry(
+	     verification_handle->checkpoint_file,
+	     (uint64_t) verification_handle->last_offset_hashed,
+	     verification_handle->md5_context,
+	     verification_handle->sha1_context,
+	     verification_handle->sha256_context,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to retrieve integrity hash(es) from input.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append checkpoint.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( verification_handle_initialize_integrity_hash(
-	     verification_handle,
+	if( checkpoint_file_write(
+	     verification_handle->checkpoint_file,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize integrity hash(es).",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write checkpoint file.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( process_status_initialize(
-	     &( verification_handle->process_status ),
-	     _SYSTEM_STRING( "Verify" ),
-	     _SYSTEM_STRING( "verified" ),
-	     _SYSTEM_STRING( "Read" ),
-	     verification_handle->notify_stream,
-	     print_status_information,
-	     error ) != 1 )
+	return( 1 );
+}
+
+/* Updates the checkpoint file if the integrity hash(es) passed a checkpoint interval
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_update_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function  = "verification_handle_update_checkpoint";
+	uint64_t last_offset   = 0;
+
+	if( verification_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create process status.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( process_status_start(
-	     verification_handle->process_status,
+	if( verification_handle->checkpoint_file == NULL )
+	{
+		return( 1 );
+	}
+	if( verification_handle->checkpoint_file->number_of_entries > 0 )
+	{
+		last_offset = verification_handle->checkpoint_file->entries[ verification_handle->checkpoint_file->number_of_entries - 1 ].offset;
+	}
+	if( (uint64_t) verification_handle->last_offset_hashed < ( last_offset + VERIFICATION_HANDLE_CHECKPOINT_INTERVAL ) )
+	{
+		return( 1 );
+	}
+	if( verification_handle_write_checkpoint(
+	     verification_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to start process status.",
+		 "%s: unable to write checkpoint.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( verification_handle->number_of_threads == 0 )
-	{
-		if( storage_media_buffer_initialize(
-		     &storage_media_buffer,
-		     verification_handle->input_handle,
-		     storage_media_buffer_mode,
-		     process_buffer_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create storage media buffer.",
-			 function );
+	return( 1 );
+}
 
-			goto on_error;
-		}
-	}
-	remaining_media_size = verification_handle->media_size;
+/* Verifies the input
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_input(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	uint8_t *data                                = NULL;
+	static char *function                        = "verification_handle_verify_input";
+	size64_t remaining_media_size                = 0;
+	size_t data_size                             = 0;
+	size_t process_buffer_size                   = 0;
+	size_t read_size                             = 0;
+	ssize_t process_count                        = 0;
+	ssize_t read_count                           = 0;
+	off64_t storage_media_offset                 = 0;
+	int64_t start_timestamp                      = 0;
+	uint32_t number_of_checksum_errors           = 0;
+	uint8_t storage_media_buffer_mode            = 0;
+	int is_corrupted                             = 0;
+	int md5_hash_compare                         = 0;
+	int result                                   = 0;
+	int sha1_hash_compare                        = 0;
+	int sha256_hash_compare                      = 0;
+	int status                                   = PROCESS_STATUS_COMPLETED;
 
-	while( remaining_media_size > 0 )
-	{
-		if( verification_handle->abort != 0 )
-		{
-			break;
-		}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-		if( verification_handle->number_of_threads != 0 )
-		{
-			if( storage_media_buffer_queue_grab_buffer(
-			     verification_handle->storage_media_buffer_queue,
-			     &storage_media_buffer,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to grab storage media buffer from queue.",
-				 function );
-
-				goto on_error;
-			}
-			if( storage_media_buffer == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing storage media buffer.",
-				 function );
+	uint64_t number_of_pending_values            = 0;
+	int maximum_number_of_queued_items           = 0;
+	int minimum_number_of_buffers                = 0;
+#endif
 
-				goto on_error;
-			}
-		}
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
 
-		read_size = process_buffer_size;
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
 
-		if( remaining_media_size < read_size )
-		{
-			read_size = (size_t) remaining_media_size;
-		}
-		read_count = storage_media_buffer_read_from_handle(
-		              storage_media_buffer,
-		              verification_handle->input_handle,
-		              read_size,
-		              error );
+		return( -1 );
+	}
+	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk size value exceeds maximum.",
+		 function );
 
-		if( read_count < 0 )
+		return( -1 );
+	}
+	if( verification_handle->process_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid process buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->use_data_chunk_functions != 0 )
+	{
+		process_buffer_size       = verification_handle->chunk_size;
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
+
+		if( ( verification_handle->format == LIBEWF_FORMAT_SMART )
+		 || ( verification_handle->format == LIBEWF_FORMAT_FTK_IMAGER ) )
+		{
+			/* In EWF-S01 (SMART) the size of a stored chunk can be larger than the chunk size
+			 */
+			process_buffer_size *= 2;
+		}
+	}
+	else
+	{
+		if( verification_handle->process_buffer_size == 0 )
+		{
+			process_buffer_size = verification_handle->chunk_size;
+		}
+		else
+		{
+			process_buffer_size = verification_handle->process_buffer_size;
+		}
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		maximum_number_of_queued_items = 1 + (int) ( verification_handle->maximum_process_buffers_size / process_buffer_size );
+
+		if( libcthreads_thread_pool_create(
+		     &( verification_handle->process_thread_pool ),
+		     NULL,
+		     verification_handle->number_of_threads,
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_process_storage_media_buffer_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize process thread pool.",
 			 function );
 
 			goto on_error;
 		}
-		if( read_count == 0 )
+		/* The output window has a slot for every storage media buffer in the queue.
+		 * The number of slots must be at least the number of buffers in the storage media
+		 * buffer queue, since every buffer in flight holds a sequence number that was not yet
+		 * output. Both are sized by maximum_number_of_queued_items and must never diverge,
+		 * otherwise reorder_window_push fails with a slot value already set error.
+		 */
+		if( reorder_window_initialize(
+		     &( verification_handle->output_window ),
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_output_storage_media_buffer_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unexpected end of data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output window.",
 			 function );
 
 			goto on_error;
 		}
-		storage_media_buffer->storage_media_offset = storage_media_offset;
-
-		storage_media_offset += read_count;
-		remaining_media_size -= read_count;
-
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-		if( verification_handle->number_of_threads != 0 )
+		if( storage_media_buffer_queue_initialize(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     verification_handle->input_handle,
+		     maximum_number_of_queued_items,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
+		     error ) != 1 )
 		{
-			if( libcthreads_thread_pool_push(
-			     verification_handle->process_thread_pool,
-			     (intptr_t *) storage_media_buffer,
-			     error ) == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to push storage media buffer onto process thread pool queue.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer queue.",
+			 function );
 
-				goto on_error;
-			}
-			storage_media_buffer = NULL;
+			goto on_error;
 		}
-		else
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+		if( verification_handle->adapt_number_of_buffers != 0 )
 		{
-			process_count = storage_media_buffer_read_process(
-			                 storage_media_buffer,
-		        	         error );
-
-			if( process_count < 0 )
-			{
-#if defined( HAVE_VERBOSE_OUTPUT )
-				if( ( libcnotify_verbose != 0 )
-				 && ( *error != NULL ) )
-				{
-					libcnotify_print_error_backtrace(
-					 *error );
-				}
-#endif
-				libcerror_error_free(
-				 error );
-
-				process_count = verification_handle->chunk_size;
-
-				storage_media_buffer->is_corrupted = 1;
-			}
-			result = storage_media_buffer_is_corrupted(
-			          storage_media_buffer,
-			          error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if storage media buffer is corrupted.",
-				 function );
+			/* Reading starts with a storage media buffer per thread and the buffer limiter
+			 * adds buffers while reading stalls, up to the number of buffers in the queue
+			 */
+			minimum_number_of_buffers = verification_handle->number_of_threads + 1;
 
-				goto on_error;
-			}
-			else if( result != 0 )
+			if( verification_handle->number_of_readers > 1 )
 			{
-				/* Append a read error
-				 */
-				if( verification_handle_append_read_error(
-				     verification_handle,
-				     storage_media_buffer->storage_media_offset,
-				     (size_t) verification_handle->chunk_size,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to append read error.",
-					 function );
-
-					goto on_error;
-				}
+				minimum_number_of_buffers = verification_handle->number_of_threads + verification_handle->number_of_readers;
 			}
-			if( storage_media_buffer_get_data(
-			     storage_media_buffer,
-			     &data,
-			     &data_size,
-			     error ) != 1 )
+			if( minimum_number_of_buffers > maximum_number_of_queued_items )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine storage media buffer data.",
-				 function );
-
-				goto on_error;
+				minimum_number_of_buffers = maximum_number_of_queued_items;
 			}
-			if( verification_handle_update_integrity_hash(
-			     verification_handle,
-			     data,
-			     storage_media_buffer->processed_size,
+			if( buffer_limiter_initialize(
+			     &( verification_handle->buffer_limiter ),
+			     verification_handle->storage_media_buffer_queue,
+			     verification_handle->stage_profiler,
+			     minimum_number_of_buffers,
+			     maximum_number_of_queued_items,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to update integrity hash(es).",
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize buffer limiter.",
 				 function );
 
 				goto on_error;
 			}
-			verification_handle->last_offset_hashed += (off64_t) process_count;
+		}
+		/* The digest threads are created when the integrity hash(es) are initialized
+		 */
+		if( digest_stage_initialize(
+		     &( verification_handle->digest_stage ),
+		     maximum_number_of_queued_items,
+		     (int (*)(intptr_t *, void *)) &verification_handle_digest_stage_release_callback,
+		     (void *) verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest stage.",
+			 function );
 
-			if( process_status_update(
-			     verification_handle->process_status,
-			     verification_handle->last_offset_hashed,
-			     verification_handle->media_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to update process status.",
-				 function );
+			goto on_error;
+		}
+		if( digest_stage_set_stage_profiler(
+		     verification_handle->digest_stage,
+		     verification_handle->stage_profiler,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set digest stage profiler.",
+			 function );
 
-				goto on_error;
-			}
+			goto on_error;
 		}
-  	}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Get the integrity hashes from the input first to determine
+	 * which digest (hash) types are used.
+	 */
+	if( verification_handle_get_integrity_hash_from_input(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to retrieve integrity hash(es) from input.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle_initialize_integrity_hash(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = 0;
+
+	result = verification_handle_restore_checkpoint(
+	          verification_handle,
+	          &storage_media_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to restore checkpoint.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libewf_handle_seek_offset(
+		     verification_handle->input_handle,
+		     storage_media_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek checkpoint offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 storage_media_offset,
+			 storage_media_offset );
+
+			goto on_error;
+		}
+		fprintf(
+		 verification_handle->notify_stream,
+		 "Resuming verification at offset: %" PRIi64 ".\n\n",
+		 storage_media_offset );
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_set_stage_profiler(
+	     verification_handle->process_status,
+	     verification_handle->stage_profiler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status stage profiler.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->metrics_stream != NULL )
+	{
+		if( process_status_set_metrics_stream(
+		     verification_handle->process_status,
+		     verification_handle->metrics_stream,
+		     PROCESS_STATUS_METRICS_INTERVAL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set process status metrics stream.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
 	if( verification_handle->number_of_threads == 0 )
 	{
-		if( storage_media_buffer_free(
+		if( storage_media_buffer_initialize(
 		     &storage_media_buffer,
+		     verification_handle->input_handle,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	remaining_media_size = verification_handle->media_size - (size64_t) storage_media_offset;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->readers != NULL )
+	{
+		/* The readers read the input instead of this thread
+		 */
+		if( verification_handle_read_input_with_readers(
+		     verification_handle,
+		     storage_media_offset,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read input with readers.",
+			 function );
+
+			goto on_error;
+		}
+		remaining_media_size = 0;
+	}
+#endif
+	while( remaining_media_size > 0 )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			break;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->number_of_threads != 0 )
+		{
+			if( verification_handle->buffer_limiter != NULL )
+			{
+				if( buffer_limiter_adjust(
+				     verification_handle->buffer_limiter,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to adjust buffer limiter.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* Profiling is best effort and does not affect the verification
+			 * Grabbing blocks while all the storage media buffers are in flight
+			 */
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			if( storage_media_buffer_queue_grab_buffer(
+			     verification_handle->storage_media_buffer_queue,
+			     &storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab storage media buffer from queue.",
+				 function );
+
+				goto on_error;
+			}
+			stage_profiler_add_wait(
+			 verification_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_READ,
+			 start_timestamp,
+			 NULL );
+
+			if( storage_media_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		read_size = process_buffer_size;
+
+		if( remaining_media_size < read_size )
+		{
+			read_size = (size_t) remaining_media_size;
+		}
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		read_count = storage_media_buffer_read_from_handle(
+		              storage_media_buffer,
+		              verification_handle->input_handle,
+		              read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of data.",
+			 function );
+
+			goto on_error;
+		}
+		stage_profiler_add_sample(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_READ,
+		 start_timestamp,
+		 (uint64_t) read_count,
+		 NULL );
+
+		storage_media_buffer->storage_media_offset = storage_media_offset;
+
+		storage_media_offset += read_count;
+		remaining_media_size -= read_count;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->number_of_threads != 0 )
+		{
+			if( reorder_window_get_next_sequence_number(
+			     verification_handle->output_window,
+			     &( storage_media_buffer->sequence_number ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve storage media buffer sequence number.",
+				 function );
+
+				goto on_error;
+			}
+			if( reorder_window_get_number_of_pending_values(
+			     verification_handle->output_window,
+			     &number_of_pending_values,
+			     NULL ) == 1 )
+			{
+				stage_profiler_add_queue_depth(
+				 verification_handle->stage_profiler,
+				 STAGE_PROFILER_QUEUE_IN_FLIGHT,
+				 number_of_pending_values,
+				 NULL );
+			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			if( libcthreads_thread_pool_push(
+			     verification_handle->process_thread_pool,
+			     (intptr_t *) storage_media_buffer,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push storage media buffer onto process thread pool queue.",
+				 function );
+
+				goto on_error;
+			}
+			/* Pushing blocks while the queue of the process threads is full
+			 */
+			stage_profiler_add_wait(
+			 verification_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_UNPACK,
+			 start_timestamp,
+			 NULL );
+
+			storage_media_buffer = NULL;
+		}
+		else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+		{
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			process_count = storage_media_buffer_read_process(
+			                 storage_media_buffer,
+		        	         error );
+
+			if( process_count < 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				process_count = verification_handle->chunk_size;
+
+				storage_media_buffer->is_corrupted = 1;
+			}
+			stage_profiler_add_sample(
+			 verification_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_UNPACK,
+			 start_timestamp,
+			 (uint64_t) storage_media_buffer->processed_size,
+			 NULL );
+
+			result = storage_media_buffer_is_corrupted(
+			          storage_media_buffer,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if storage media buffer is corrupted.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				/* Append a read error
+				 */
+				if( verification_handle_append_read_error(
+				     verification_handle,
+				     storage_media_buffer->storage_media_offset,
+				     (size_t) verification_handle->chunk_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append read error.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( storage_media_buffer_get_data(
+			     storage_media_buffer,
+			     &data,
+			     &data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine storage media buffer data.",
+				 function );
+
+				goto on_error;
+			}
+			stage_profiler_get_timestamp(
+			 &start_timestamp,
+			 NULL );
+
+			if( verification_handle_update_integrity_hash(
+			     verification_handle,
+			     data,
+			     storage_media_buffer->processed_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to update integrity hash(es).",
+				 function );
+
+				goto on_error;
+			}
+			stage_profiler_add_sample(
+			 verification_handle->stage_profiler,
+			 STAGE_PROFILER_STAGE_HASH,
+			 start_timestamp,
+			 (uint64_t) storage_media_buffer->processed_size,
+			 NULL );
+
+			verification_handle->last_offset_hashed += (off64_t) process_count;
+
+			if( verification_handle_update_checkpoint(
+			     verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update checkpoint.",
+				 function );
+
+				goto on_error;
+			}
+			if( process_status_update(
+			     verification_handle->process_status,
+			     verification_handle->last_offset_hashed,
+			     verification_handle->media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to update process status.",
+				 function );
+
+				goto on_error;
+			}
+		}
+  	}
+	if( verification_handle->number_of_threads == 0 )
+	{
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( verification_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The digest stage is joined after the process thread pool since the output window,
+	 * that is drained by the process threads, pushes the storage media buffers onto the digest stage
+	 */
+	if( verification_handle->digest_stage != NULL )
+	{
+		if( digest_stage_join(
+		     verification_handle->digest_stage,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest stage.",
+			 function );
+
+			goto on_error;
+		}
+		if( digest_stage_free(
+		     &( verification_handle->digest_stage ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest stage.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->output_window != NULL )
+	{
+		if( verification_handle_empty_output_window(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty output window.",
+			 function );
+
+			goto on_error;
+		}
+		if( reorder_window_free(
+		     &( verification_handle->output_window ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output window.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->buffer_limiter != NULL )
+	{
+		if( buffer_limiter_free(
+		     &( verification_handle->buffer_limiter ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffer limiter.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		if( storage_media_buffer_queue_free(
+		     &( verification_handle->storage_media_buffer_queue ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* On abort a checkpoint is written at the last offset hashed so that the verification
+	 * can be resumed from where it was interrupted, the checkpoints are no longer needed
+	 * when the verification has completed
+	 */
+	if( verification_handle->checkpoint_file != NULL )
+	{
+		if( verification_handle->abort != 0 )
+		{
+			if( verification_handle_write_checkpoint(
+			     verification_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to write checkpoint.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( checkpoint_file_remove(
+		          verification_handle->checkpoint_file,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove checkpoint file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( verification_handle_finalize_integrity_hash(
+	     verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize integrity hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort != 0 )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->abort == 0 )
+	{
+		if( print_status_information != 0 )
+		{
+			fprintf(
+			 verification_handle->notify_stream,
+			 "\n" );
+		}
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_hash_values_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print hash values.",
+			 function );
+
+			goto on_error;
+		}
+		if( verification_handle_additional_hash_values_fprint(
+		     verification_handle,
+		     verification_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print additional hash values.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+
+		if( log_handle != NULL )
+		{
+			if( verification_handle_checksum_errors_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print checksum errors in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_hash_values_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print hash values in log handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( verification_handle_additional_hash_values_fprint(
+			     verification_handle,
+			     log_handle->log_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print additional hash values in log handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	is_corrupted = libewf_handle_segment_files_corrupted(
+	                verification_handle->input_handle,
+	                error );
+
+	if( is_corrupted == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( verification_handle->calculate_md5 != 0 )
+	 && ( verification_handle->stored_md5_hash_available != 0 ) )
+	{
+		md5_hash_compare = narrow_string_compare(
+		                    verification_handle->stored_md5_hash_string,
+		                    verification_handle->calculated_md5_hash_string,
+		                    33 );
+	}
+	if( ( verification_handle->calculate_sha1 != 0 )
+	 && ( verification_handle->stored_sha1_hash_available != 0 ) )
+	{
+		sha1_hash_compare = narrow_string_compare(
+		                     verification_handle->stored_sha1_hash_string,
+		                     verification_handle->calculated_sha1_hash_string,
+		                     41 );
+	}
+	if( ( verification_handle->calculate_sha256 != 0 )
+	 && ( verification_handle->stored_sha256_hash_available != 0 ) )
+	{
+		sha256_hash_compare = narrow_string_compare(
+		                       verification_handle->stored_sha256_hash_string,
+		                       verification_handle->calculated_sha256_hash_string,
+		                       65 );
+	}
+	/* Note that a set of EWF files can be verified without an integrity hash
+	 */
+	if( ( is_corrupted == 0 )
+	 && ( number_of_checksum_errors == 0 )
+	 && ( md5_hash_compare == 0 )
+	 && ( sha1_hash_compare == 0 )
+	 && ( sha256_hash_compare == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	if( ( verification_handle->number_of_threads == 0 )
+	 && ( storage_media_buffer != NULL ) )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->process_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( verification_handle->process_thread_pool ),
+		 NULL );
+	}
+	if( verification_handle->digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &( verification_handle->digest_stage ),
+		 NULL );
+	}
+	if( verification_handle->output_window != NULL )
+	{
+		verification_handle_empty_output_window(
+		 verification_handle,
+		 NULL );
+		reorder_window_free(
+		 &( verification_handle->output_window ),
+		 NULL );
+	}
+	if( verification_handle->buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &( verification_handle->buffer_limiter ),
+		 NULL );
+	}
+	if( verification_handle->storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &( verification_handle->storage_media_buffer_queue ),
+		 NULL );
+	}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( -1 );
+}
+
+/* Callback function to report the progress of verifying the chunks
+ * Returns 1 to continue or -1 to abort
+ */
+int verification_handle_verify_chunks_progress_callback(
+     verification_handle_t *verification_handle,
+     uint64_t number_of_verified_chunks,
+     uint64_t number_of_chunks EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_handle_verify_chunks_progress_callback";
+	size64_t bytes_verified  = 0;
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( number_of_chunks )
+
+	if( verification_handle == NULL )
+	{
+		return( -1 );
+	}
+	if( verification_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	bytes_verified = (size64_t) number_of_verified_chunks * verification_handle->chunk_size;
+
+	if( bytes_verified > verification_handle->media_size )
+	{
+		bytes_verified = verification_handle->media_size;
+	}
+	verification_handle->last_offset_hashed = (off64_t) bytes_verified;
+
+	if( process_status_update(
+	     verification_handle->process_status,
+	     bytes_verified,
+	     verification_handle->media_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update process status.",
+		 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		libcnotify_print_error_backtrace(
+		 error );
+#endif
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Verifies the chunks of the input
+ * Only the chunk checksums and compressed data are validated, no digest hashes are calculated
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	static char *function              = "verification_handle_verify_chunks";
+	uint32_t number_of_checksum_errors = 0;
+	int is_corrupted                   = 0;
+	int result                         = 0;
+	int status                         = PROCESS_STATUS_COMPLETED;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->metrics_stream != NULL )
+	{
+		if( process_status_set_metrics_stream(
+		     verification_handle->process_status,
+		     verification_handle->metrics_stream,
+		     PROCESS_STATUS_METRICS_INTERVAL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set process status metrics stream.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_progress_callback(
+	     verification_handle->input_handle,
+	     (int (*)(void *, uint64_t, uint64_t)) &verification_handle_verify_chunks_progress_callback,
+	     (void *) verification_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set progress callback.",
+		 function );
+
+		goto on_error;
+	}
+	verification_handle->last_offset_hashed = 0;
+
+	result = libewf_handle_verify_chunks(
+	          verification_handle->input_handle,
+	          verification_handle->number_of_threads,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_progress_callback(
+	     verification_handle->input_handle,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to unset progress callback.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result == 0 )
+	 || ( verification_handle->abort != 0 ) )
+	{
+		status = PROCESS_STATUS_ABORTED;
+	}
+	else
+	{
+		verification_handle->last_offset_hashed = (off64_t) verification_handle->media_size;
+	}
+	if( process_status_stop(
+	     verification_handle->process_status,
+	     verification_handle->last_offset_hashed,
+	     status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to stop process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_free(
+	     &( verification_handle->process_status ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		return( 0 );
+	}
+	if( print_status_information != 0 )
+	{
+		fprintf(
+		 verification_handle->notify_stream,
+		 "\n" );
+	}
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( log_handle != NULL )
+	{
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors in log handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	is_corrupted = libewf_handle_segment_files_corrupted(
+	                verification_handle->input_handle,
+	                error );
+
+	if( is_corrupted == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are corrupted.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_number_of_checksum_errors(
+	     verification_handle->input_handle,
+	     &number_of_checksum_errors,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( is_corrupted == 0 )
+	 && ( number_of_checksum_errors == 0 ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+
+on_error:
+	libewf_handle_set_progress_callback(
+	 verification_handle->input_handle,
+	 NULL,
+	 NULL,
+	 NULL );
+
+	if( verification_handle->process_status != NULL )
+	{
+		process_status_stop(
+		 verification_handle->process_status,
+		 verification_handle->last_offset_hashed,
+		 PROCESS_STATUS_FAILED,
+		 NULL );
+		process_status_free(
+		 &( verification_handle->process_status ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates the sample scheduler of the input
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_initialize_sample_scheduler(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error )
+{
+	static char *function     = "verification_handle_initialize_sample_scheduler";
+	uint64_t number_of_chunks = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sample_scheduler != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle - sample scheduler value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_media_size(
+	     verification_handle->input_handle,
+	     &( verification_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_chunks = verification_handle->media_size / verification_handle->chunk_size;
+
+	if( ( verification_handle->media_size % verification_handle->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	if( sample_scheduler_initialize(
+	     &( verification_handle->sample_scheduler ),
+	     number_of_chunks,
+	     (uint64_t) time( NULL ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the sample size
+ * The sample size is either a number of chunks or a percentage of the chunks, e.g. 5%
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_sample_size(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "verification_handle_set_sample_size";
+	size_t string_length       = 0;
+	uint64_t number_of_samples = 0;
+	uint8_t is_percentage      = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length > 0 )
+	 && ( string[ string_length - 1 ] == (system_character_t) '%' ) )
+	{
+		string_length -= 1;
+		is_percentage  = 1;
+	}
+	if( ( string_length == 0 )
+	 || ( string[ 0 ] == (system_character_t) '-' ) )
+	{
+		return( 0 );
+	}
+	if( ewftools_system_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length,
+	     &number_of_samples,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine sample size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_samples == 0 )
+	 || ( ( is_percentage != 0 )
+	  &&  ( number_of_samples > 100 ) ) )
+	{
+		return( 0 );
+	}
+	if( verification_handle->sample_scheduler == NULL )
+	{
+		if( verification_handle_initialize_sample_scheduler(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize sample scheduler.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( is_percentage != 0 )
+	{
+		number_of_samples = ( ( verification_handle->sample_scheduler->number_of_chunks * number_of_samples ) + 99 ) / 100;
+	}
+	if( sample_scheduler_append_random_sample(
+	     verification_handle->sample_scheduler,
+	     number_of_samples,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append random sample.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the sample ranges
+ * The sample ranges are formatted as: offset:size[,offset:size] in bytes
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_sample_ranges(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "verification_handle_set_sample_ranges";
+	size_t separator_index                           = 0;
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	uint64_t first_chunk_index                       = 0;
+	uint64_t last_chunk_index                        = 0;
+	uint64_t range_offset                            = 0;
+	uint64_t range_size                              = 0;
+	int number_of_segments                           = 0;
+	int result                                       = 1;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sample_scheduler == NULL )
+	{
+		if( verification_handle_initialize_sample_scheduler(
+		     verification_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize sample scheduler.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ',',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ',',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		for( separator_index = 0;
+		     separator_index < string_segment_size;
+		     separator_index++ )
+		{
+			if( ( string_segment[ separator_index ] == 0 )
+			 || ( string_segment[ separator_index ] == (system_character_t) ':' ) )
+			{
+				break;
+			}
+		}
+		if( ( separator_index == 0 )
+		 || ( separator_index >= string_segment_size )
+		 || ( string_segment[ separator_index ] != (system_character_t) ':' )
+		 || ( string_segment[ separator_index + 1 ] == 0 ) )
+		{
+			result = 0;
+
+			break;
+		}
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string_segment,
+		     separator_index,
+		     &range_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine range offset.",
+			 function );
+
+			goto on_error;
+		}
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     &( string_segment[ separator_index + 1 ] ),
+		     string_segment_size - ( separator_index + 1 ),
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine range size.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( range_size == 0 )
+		 || ( range_offset >= (uint64_t) verification_handle->media_size ) )
+		{
+			result = 0;
+
+			break;
+		}
+		if( range_size > ( verification_handle->media_size - range_offset ) )
+		{
+			range_size = verification_handle->media_size - range_offset;
+		}
+		first_chunk_index = range_offset / verification_handle->chunk_size;
+		last_chunk_index  = ( range_offset + range_size - 1 ) / verification_handle->chunk_size;
+
+		if( sample_scheduler_append_range(
+		     verification_handle->sample_scheduler,
+		     first_chunk_index,
+		     last_chunk_index - first_chunk_index + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append range: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Verifies sampled chunks until the sample scheduler has no chunks left
+ * The chunks are claimed and read in the order of the sample scheduler, which is the
+ * order in which the chunks are stored in the segment files, only the validation of
+ * the chunk data is done concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_sample_chunks(
+     verification_handle_t *verification_handle,
+     verification_handle_sampler_t *sampler,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *process_error = NULL;
+	static char *function            = "verification_handle_sample_chunks";
+	size64_t sample_size             = 0;
+	size64_t sampled_size            = 0;
+	size_t read_size                 = 0;
+	ssize_t process_count            = 0;
+	ssize_t read_count               = 0;
+	off64_t storage_media_offset     = 0;
+	int64_t start_timestamp          = 0;
+	uint64_t chunk_index             = 0;
+	uint64_t number_of_sectors       = 0;
+	int is_corrupted                 = 0;
+	int result                       = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sampler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sampler.",
+		 function );
+
+		return( -1 );
+	}
+	sample_size = (size64_t) verification_handle->sample_scheduler->number_of_chunk_indexes * verification_handle->chunk_size;
+
+	while( verification_handle->abort == 0 )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->sample_mutex != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     verification_handle->sample_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab sample mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		/* The chunks are read while holding the sample mutex so that the segment files
+		 * are read sequentially
+		 */
+		result = sample_scheduler_get_next_chunk_index(
+		          verification_handle->sample_scheduler,
+		          &chunk_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next chunk index.",
+			 function );
+		}
+		else if( result != 0 )
+		{
+			storage_media_offset = (off64_t) ( chunk_index * verification_handle->chunk_size );
+			read_size            = (size_t) verification_handle->chunk_size;
+
+			if( (size64_t) read_size > ( verification_handle->media_size - (size64_t) storage_media_offset ) )
+			{
+				read_size = (size_t) ( verification_handle->media_size - (size64_t) storage_media_offset );
+			}
+			sampler->storage_media_buffer->storage_media_offset = storage_media_offset;
+
+			if( libewf_handle_seek_offset(
+			     verification_handle->input_handle,
+			     storage_media_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 storage_media_offset,
+				 storage_media_offset );
+
+				result = -1;
+			}
+			else
+			{
+				/* Profiling is best effort and does not affect the verification
+				 */
+				stage_profiler_get_timestamp(
+				 &start_timestamp,
+				 NULL );
+
+				read_count = storage_media_buffer_read_from_handle(
+				              sampler->storage_media_buffer,
+				              verification_handle->input_handle,
+				              read_size,
+				              error );
+
+				if( read_count <= 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					result = -1;
+				}
+				else
+				{
+					stage_profiler_add_sample(
+					 verification_handle->stage_profiler,
+					 STAGE_PROFILER_STAGE_READ,
+					 start_timestamp,
+					 (uint64_t) read_count,
+					 NULL );
+				}
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->sample_mutex != NULL )
+		{
+			if( libcthreads_mutex_release(
+			     verification_handle->sample_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release sample mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( result == -1 )
+		{
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+
+		process_count = storage_media_buffer_read_process(
+		                 sampler->storage_media_buffer,
+		                 &process_error );
+
+		if( process_count < 0 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( ( libcnotify_verbose != 0 )
+			 && ( process_error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 process_error );
+			}
+#endif
+			libcerror_error_free(
+			 &process_error );
+
+			sampler->storage_media_buffer->is_corrupted = 1;
+		}
+		stage_profiler_add_sample(
+		 verification_handle->stage_profiler,
+		 STAGE_PROFILER_STAGE_UNPACK,
+		 start_timestamp,
+		 (uint64_t) sampler->storage_media_buffer->processed_size,
+		 NULL );
+
+		is_corrupted = storage_media_buffer_is_corrupted(
+		                sampler->storage_media_buffer,
+		                error );
+
+		if( is_corrupted == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if storage media buffer is corrupted.",
+			 function );
+
+			goto on_error;
+		}
+		else if( is_corrupted != 0 )
+		{
+			number_of_sectors = read_size / verification_handle->bytes_per_sector;
+
+			if( ( read_size % verification_handle->bytes_per_sector ) != 0 )
+			{
+				number_of_sectors += 1;
+			}
+			if( libewf_handle_append_checksum_error(
+			     verification_handle->input_handle,
+			     (uint64_t) storage_media_offset / verification_handle->bytes_per_sector,
+			     number_of_sectors,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->sample_mutex != NULL )
+		{
+			if( libcthreads_mutex_grab(
+			     verification_handle->sample_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab sample mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		verification_handle->number_of_sampled_chunks += 1;
+
+		if( is_corrupted != 0 )
+		{
+			verification_handle->number_of_corrupted_sampled_chunks += 1;
+		}
+		sampled_size = (size64_t) verification_handle->number_of_sampled_chunks * verification_handle->chunk_size;
+
+		verification_handle->last_offset_hashed = (off64_t) sampled_size;
+
+		result = process_status_update(
+		          verification_handle->process_status,
+		          sampled_size,
+		          sample_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update process status.",
+			 function );
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( verification_handle->sample_mutex != NULL )
+		{
+			if( libcthreads_mutex_release(
+			     verification_handle->sample_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release sample mutex.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	sampler->has_failed = 1;
+
+	return( -1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Verifies sampled chunks
+ * Callback function for the sample thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_sampler_callback(
+     verification_handle_sampler_t *sampler,
+     verification_handle_t *verification_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "verification_handle_sampler_callback";
+
+	if( verification_handle_sample_chunks(
+	     verification_handle,
+	     sampler,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify sampled chunks.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( verification_handle->abort == 0 )
+	{
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Verifies a sample of the chunks of the input
+ * Only the chunk checksums and compressed data of the sampled chunks are validated
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int verification_handle_verify_sample(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error )
+{
+	verification_handle_sampler_t *samplers = NULL;
+	static char *function                   = "verification_handle_verify_sample";
+	size_t chunk_data_size                  = 0;
+	int number_of_samplers                  = 1;
+	int sampler_index                       = 0;
+	int status                              = PROCESS_STATUS_COMPLETED;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool  = NULL;
+#endif
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->sample_scheduler == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing sample scheduler.",
+		 function );
+
+		return( -1 );
+	}
+	if( verification_handle->chunk_size > (size32_t) INT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->number_of_threads != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( verification_handle->number_of_threads > 0 )
+	{
+		number_of_samplers = verification_handle->number_of_threads;
+	}
+	/* Sorting the chunk indexes orders the reads by segment file and offset
+	 */
+	if( sample_scheduler_sort(
+	     verification_handle->sample_scheduler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to sort sample scheduler.",
+		 function );
+
+		goto on_error;
+	}
+	/* The chunk data buffer can contain the uncompressed and compressed chunk data
+	 */
+	chunk_data_size = (size_t) verification_handle->chunk_size * 2;
+
+	samplers = (verification_handle_sampler_t *) memory_allocate(
+	                                              sizeof( verification_handle_sampler_t ) * number_of_samplers );
+
+	if( samplers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create samplers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     samplers,
+	     0,
+	     sizeof( verification_handle_sampler_t ) * number_of_samplers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear samplers.",
+		 function );
+
+		goto on_error;
+	}
+	for( sampler_index = 0;
+	     sampler_index < number_of_samplers;
+	     sampler_index++ )
+	{
+		if( storage_media_buffer_initialize(
+		     &( samplers[ sampler_index ].storage_media_buffer ),
+		     verification_handle->input_handle,
+		     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+		     chunk_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer: %d.",
+			 function,
+			 sampler_index );
+
+			goto on_error;
+		}
+	}
+	verification_handle->number_of_sampled_chunks           = 0;
+	verification_handle->number_of_corrupted_sampled_chunks = 0;
+	verification_handle->last_offset_hashed                 = 0;
+
+	if( process_status_initialize(
+	     &( verification_handle->process_status ),
+	     _SYSTEM_STRING( "Verify" ),
+	     _SYSTEM_STRING( "verified" ),
+	     _SYSTEM_STRING( "Read" ),
+	     verification_handle->notify_stream,
+	     print_status_information,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process status.",
+		 function );
+
+		goto on_error;
+	}
+	if( process_status_set_stage_profiler(
+	     verification_handle->process_status,
+	     verification_handle->stage_profiler,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set process status stage profiler.",
+		 function );
+
+		goto on_error;
+	}
+	if( verification_handle->metrics_stream != NULL )
+	{
+		if( process_status_set_metrics_stream(
+		     verification_handle->process_status,
+		     verification_handle->metrics_stream,
+		     PROCESS_STATUS_METRICS_INTERVAL,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set process status metrics stream.",
 			 function );
 
 			goto on_error;
 		}
 	}
+	if( process_status_start(
+	     verification_handle->process_status,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to start process status.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->process_thread_pool != NULL )
+	if( verification_handle->number_of_threads > 0 )
 	{
-		if( libcthreads_thread_pool_join(
-		     &( verification_handle->process_thread_pool ),
+		if( libcthreads_mutex_initialize(
+		     &( verification_handle->sample_mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join process thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sample mutex.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( verification_handle->output_thread_pool != NULL )
-	{
-		if( libcthreads_thread_pool_join(
-		     &( verification_handle->output_thread_pool ),
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_samplers,
+		     number_of_samplers,
+		     (int (*)(intptr_t *, void *)) &verification_handle_sampler_callback,
+		     (void *) verification_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to join output thread pool.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize sample thread pool.",
 			 function );
 
 			goto on_error;
 		}
-	}
-	if( verification_handle->output_list != NULL )
-	{
-		if( verification_handle_empty_output_list(
-		     verification_handle,
+		for( sampler_index = 0;
+		     sampler_index < number_of_samplers;
+		     sampler_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( samplers[ sampler_index ] ),
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push sampler: %d onto sample thread pool queue.",
+				 function,
+				 sampler_index );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to empty output list.",
+			 "%s: unable to join sample thread pool.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_list_free(
-		     &( verification_handle->output_list ),
-		     NULL,
+		if( libcthreads_mutex_free(
+		     &( verification_handle->sample_mutex ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free output list.",
+			 "%s: unable to free sample mutex.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( verification_handle->storage_media_buffer_queue != NULL )
+	else
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 	{
-		if( storage_media_buffer_queue_free(
-		     &( verification_handle->storage_media_buffer_queue ),
+		if( verification_handle_sample_chunks(
+		     verification_handle,
+		     &( samplers[ 0 ] ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free storage media buffer queue.",
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify sampled chunks.",
 			 function );
 
 			goto on_error;
 		}
 	}
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
-	if( verification_handle_finalize_integrity_hash(
-	     verification_handle,
-	     error ) != 1 )
+	for( sampler_index = 0;
+	     sampler_index < number_of_samplers;
+	     sampler_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to finalize integrity hash(es).",
-		 function );
+		if( samplers[ sampler_index ].has_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: sampler: %d unable to verify sampled chunks.",
+			 function,
+			 sampler_index );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( storage_media_buffer_free(
+		     &( samplers[ sampler_index ].storage_media_buffer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer: %d.",
+			 function,
+			 sampler_index );
+
+			goto on_error;
+		}
 	}
+	memory_free(
+	 samplers );
+
+	samplers = NULL;
+
 	if( verification_handle->abort != 0 )
 	{
 		status = PROCESS_STATUS_ABORTED;
 	}
 	if( process_status_stop(
 	     verification_handle->process_status,
-	     verification_handle->last_offset_hashed,
+	     (size64_t) verification_handle->last_offset_hashed,
 	     status,
 	     error ) != 1 )
 	{
@@ -2289,222 +5793,226 @@ int verification_handle_verify_input(
 
 		goto on_error;
 	}
-	if( verification_handle->abort == 0 )
+	if( status == PROCESS_STATUS_ABORTED )
+	{
+		return( 0 );
+	}
+	if( print_status_information != 0 )
 	{
-		if( print_status_information != 0 )
-		{
-			fprintf(
-			 verification_handle->notify_stream,
-			 "\n" );
-		}
-		if( verification_handle_checksum_errors_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print checksum errors.",
-			 function );
-
-			goto on_error;
-		}
-		if( verification_handle_hash_values_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print hash values.",
-			 function );
-
-			goto on_error;
-		}
-		if( verification_handle_additional_hash_values_fprint(
-		     verification_handle,
-		     verification_handle->notify_stream,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-			 "%s: unable to print additional hash values.",
-			 function );
-
-			goto on_error;
-		}
 		fprintf(
 		 verification_handle->notify_stream,
 		 "\n" );
-
-		if( log_handle != NULL )
-		{
-			if( verification_handle_checksum_errors_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print checksum errors in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( verification_handle_hash_values_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print hash values in log handle.",
-				 function );
-
-				goto on_error;
-			}
-			if( verification_handle_additional_hash_values_fprint(
-			     verification_handle,
-			     log_handle->log_stream,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print additional hash values in log handle.",
-				 function );
-
-				goto on_error;
-			}
-		}
 	}
-	is_corrupted = libewf_handle_segment_files_corrupted(
-	                verification_handle->input_handle,
-	                error );
-
-	if( is_corrupted == -1 )
+	if( verification_handle_sample_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if segment files are corrupted.",
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print sample.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_handle_get_number_of_checksum_errors(
-	     verification_handle->input_handle,
-	     &number_of_checksum_errors,
-	     error ) == -1 )
+	if( verification_handle_checksum_errors_fprint(
+	     verification_handle,
+	     verification_handle->notify_stream,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of checksum errors.",
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print checksum errors.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( verification_handle->calculate_md5 != 0 )
-	 && ( verification_handle->stored_md5_hash_available != 0 ) )
-	{
-		md5_hash_compare = narrow_string_compare(
-		                    verification_handle->stored_md5_hash_string,
-		                    verification_handle->calculated_md5_hash_string,
-		                    33 );
-	}
-	if( ( verification_handle->calculate_sha1 != 0 )
-	 && ( verification_handle->stored_sha1_hash_available != 0 ) )
-	{
-		sha1_hash_compare = narrow_string_compare(
-		                     verification_handle->stored_sha1_hash_string,
-		                     verification_handle->calculated_sha1_hash_string,
-		                     41 );
-	}
-	if( ( verification_handle->calculate_sha256 != 0 )
-	 && ( verification_handle->stored_sha256_hash_available != 0 ) )
+	if( log_handle != NULL )
 	{
-		sha256_hash_compare = narrow_string_compare(
-		                       verification_handle->stored_sha256_hash_string,
-		                       verification_handle->calculated_sha256_hash_string,
-		                       65 );
-	}
-	/* Note that a set of EWF files can be verified without an integrity hash
-	 */
-	if( ( is_corrupted == 0 )
-	 && ( number_of_checksum_errors == 0 )
-	 && ( md5_hash_compare == 0 )
-	 && ( sha1_hash_compare == 0 )
-	 && ( sha256_hash_compare == 0 ) )
+		if( verification_handle_sample_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print sample in log handle.",
+			 function );
+
+			return( -1 );
+		}
+		if( verification_handle_checksum_errors_fprint(
+		     verification_handle,
+		     log_handle->log_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print checksum errors in log handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( verification_handle->number_of_corrupted_sampled_chunks != 0 )
 	{
-		return( 1 );
+		return( 0 );
 	}
-	return( 0 );
+	return( 1 );
 
 on_error:
-	if( ( verification_handle->number_of_threads == 0 )
-	 && ( storage_media_buffer != NULL ) )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
 	{
-		storage_media_buffer_free(
-		 &storage_media_buffer,
+		verification_handle_signal_abort(
+		 verification_handle,
+		 NULL );
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( verification_handle->sample_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( verification_handle->sample_mutex ),
 		 NULL );
 	}
+#endif
 	if( verification_handle->process_status != NULL )
 	{
 		process_status_stop(
 		 verification_handle->process_status,
-		 verification_handle->last_offset_hashed,
+		 (size64_t) verification_handle->last_offset_hashed,
 		 PROCESS_STATUS_FAILED,
 		 NULL );
 		process_status_free(
 		 &( verification_handle->process_status ),
 		 NULL );
 	}
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	if( verification_handle->process_thread_pool != NULL )
+	if( samplers != NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->process_thread_pool ),
-		 NULL );
+		for( sampler_index = 0;
+		     sampler_index < number_of_samplers;
+		     sampler_index++ )
+		{
+			if( samplers[ sampler_index ].storage_media_buffer != NULL )
+			{
+				storage_media_buffer_free(
+				 &( samplers[ sampler_index ].storage_media_buffer ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 samplers );
 	}
-	if( verification_handle->output_thread_pool != NULL )
+	return( -1 );
+}
+
+/* Prints the sample verification results to a stream
+ * If no corrupted chunks were sampled the upper bound of the corrupted chunk rate is
+ * estimated with 95% confidence using the rule of three: 3 / number of sampled chunks
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_sample_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "verification_handle_sample_fprint";
+	double corrupted_rate     = 0.0;
+	double sampled_percentage = 0.0;
+	uint64_t number_of_chunks = 0;
+
+	if( verification_handle == NULL )
 	{
-		libcthreads_thread_pool_join(
-		 &( verification_handle->output_thread_pool ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( verification_handle->output_list != NULL )
+	if( verification_handle->sample_scheduler == NULL )
 	{
-		verification_handle_empty_output_list(
-		 verification_handle,
-		 NULL );
-		libcdata_list_free(
-		 &( verification_handle->output_list ),
-		 NULL,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing sample scheduler.",
+		 function );
+
+		return( -1 );
 	}
-	if( verification_handle->storage_media_buffer_queue != NULL )
+	if( stream == NULL )
 	{
-		storage_media_buffer_queue_free(
-		 &( verification_handle->storage_media_buffer_queue ),
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
 	}
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+	number_of_chunks = verification_handle->sample_scheduler->number_of_chunks;
 
-	return( -1 );
+	if( number_of_chunks > 0 )
+	{
+		sampled_percentage = ( 100.0 * (double) verification_handle->number_of_sampled_chunks ) / (double) number_of_chunks;
+	}
+	fprintf(
+	 stream,
+	 "Sampled %" PRIu64 " out of %" PRIu64 " chunks (%.2f%%).\n",
+	 verification_handle->number_of_sampled_chunks,
+	 number_of_chunks,
+	 sampled_percentage );
+
+	fprintf(
+	 stream,
+	 "Number of corrupted sampled chunks: %" PRIu64 ".\n",
+	 verification_handle->number_of_corrupted_sampled_chunks );
+
+	if( verification_handle->number_of_sampled_chunks == 0 )
+	{
+		return( 1 );
+	}
+	if( verification_handle->number_of_corrupted_sampled_chunks != 0 )
+	{
+		corrupted_rate = ( 100.0 * (double) verification_handle->number_of_corrupted_sampled_chunks ) / (double) verification_handle->number_of_sampled_chunks;
+
+		fprintf(
+		 stream,
+		 "Estimated percentage of corrupted chunks: %.2f%%.\n",
+		 corrupted_rate );
+	}
+	else if( verification_handle->number_of_sampled_chunks < number_of_chunks )
+	{
+		corrupted_rate = 300.0 / (double) verification_handle->number_of_sampled_chunks;
+
+		if( corrupted_rate > 100.0 )
+		{
+			corrupted_rate = 100.0;
+		}
+		fprintf(
+		 stream,
+		 "No corrupted chunks found, with 95%% confidence at most %.2f%% of the chunks is corrupted.\n",
+		 corrupted_rate );
+	}
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
 }
 
 /* Verifies single files
@@ -3695,11 +7203,52 @@ int verification_handle_set_number_of_threads(
 
 		return( -1 );
 	}
-	if( string[ 0 ] != (system_character_t) '-' )
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 4 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "auto" ),
+	       4 ) == 0 ) )
 	{
-		string_length = system_string_length(
-				 string );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( system_resources_get_automatic_number_of_threads(
+		     &( verification_handle->number_of_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine automatic number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		if( system_resources_get_automatic_process_buffers_size(
+		     VERIFICATION_HANDLE_MAXIMUM_PROCESS_BUFFERS_SIZE,
+		     &( verification_handle->maximum_process_buffers_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine automatic process buffers size.",
+			 function );
 
+			return( -1 );
+		}
+		/* The process buffers size is an upper bound, the number of buffers in flight
+		 * is adapted at runtime
+		 */
+		verification_handle->adapt_number_of_buffers = 1;
+#endif
+		result = 1;
+	}
+	else if( string[ 0 ] != (system_character_t) '-' )
+	{
 		if( ewftools_system_string_decimal_copy_to_64_bit(
 		     string,
 		     string_length + 1,
@@ -3723,7 +7272,121 @@ int verification_handle_set_number_of_threads(
 		}
 		else
 		{
-			verification_handle->number_of_threads = (int) number_of_threads;
+			verification_handle->number_of_threads       = (int) number_of_threads;
+			verification_handle->adapt_number_of_buffers = 0;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of readers
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_number_of_readers(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "verification_handle_set_number_of_readers";
+	size_t string_length       = 0;
+	uint64_t number_of_readers = 0;
+	int result                 = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string[ 0 ] != (system_character_t) '-' )
+	{
+		string_length = system_string_length(
+		                 string );
+
+		if( ewftools_system_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_readers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of readers.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( ( number_of_readers == 0 )
+		 || ( number_of_readers > VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READERS ) )
+		{
+			result = 0;
+		}
+		else
+		{
+			verification_handle->number_of_readers = (int) number_of_readers;
+		}
+	}
+	return( result );
+}
+
+/* Sets the digest (hash) calculation backend
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verification_handle_set_hash_backend(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_hash_backend";
+	int hash_backend      = 0;
+	int result            = 0;
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_hash_backend(
+	          string,
+	          &hash_backend,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine hash backend.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The backend must be supported by the CPU
+		 */
+		result = digest_context_backend_is_supported(
+		          hash_backend );
+
+		if( result != 0 )
+		{
+			verification_handle->hash_backend = hash_backend;
 		}
 	}
 	return( result );
@@ -4024,6 +7687,33 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the metrics stream
+ * The metrics stream is not owned by the verification handle
+ * Returns 1 if successful or -1 on error
+ */
+int verification_handle_set_metrics_stream(
+     verification_handle_t *verification_handle,
+     FILE *metrics_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "verification_handle_set_metrics_stream";
+
+	if( verification_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	verification_handle->metrics_stream = metrics_stream;
+
+	return( 1 );
+}
+
 /* Sets the zero chunk on error
  * Returns 1 if successful or -1 on error
  */
@@ -4122,6 +7812,22 @@ int verification_handle_append_read_error(
 			return( -1 );
 		}
 	}
+	if( verification_handle->process_status != NULL )
+	{
+		if( process_status_add_read_error(
+		     verification_handle->process_status,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add read error to process status.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
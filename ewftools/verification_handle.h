@@ -25,14 +25,20 @@
 #include <common.h>
 #include <types.h>
 
+#include "buffer_limiter.h"
+#include "checkpoint_file.h"
+#include "digest_context.h"
 #include "digest_hash.h"
+#include "digest_stage.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
-#include "ewftools_libhmac.h"
 #include "log_handle.h"
 #include "process_status.h"
+#include "reorder_window.h"
+#include "sample_scheduler.h"
+#include "stage_profiler.h"
 #include "storage_media_buffer.h"
 
 #if defined( __cplusplus )
@@ -45,6 +51,40 @@ enum VERIFICATION_HANDLE_INPUT_FORMATS
 	VERIFICATION_HANDLE_INPUT_FORMAT_RAW	= (int) 'r'
 };
 
+/* The maximum number of readers
+ */
+#define VERIFICATION_HANDLE_MAXIMUM_NUMBER_OF_READERS	32
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct verification_handle_reader verification_handle_reader_t;
+
+struct verification_handle_reader
+{
+	/* The libewf input handle, that is opened on the same files as the input handle of the verification handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* Value to indicate the reader has failed
+	 */
+	uint8_t has_failed;
+};
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+typedef struct verification_handle_sampler verification_handle_sampler_t;
+
+struct verification_handle_sampler
+{
+	/* The storage media buffer, that contains the chunk data of the sampled chunk
+	 */
+	storage_media_buffer_t *storage_media_buffer;
+
+	/* Value to indicate the sampler has failed
+	 */
+	uint8_t has_failed;
+};
+
 typedef struct verification_handle verification_handle_t;
 
 struct verification_handle
@@ -67,7 +107,7 @@ struct verification_handle
 
 	/* The MD5 digest context
 	 */
-	libhmac_md5_context_t *md5_context;
+	digest_context_t *md5_context;
 
 	/* Value to indicate the MD5 digest context was initialized
 	 */
@@ -91,7 +131,7 @@ struct verification_handle
 
 	/* The SHA1 digest context
 	 */
-	libhmac_sha1_context_t *sha1_context;
+	digest_context_t *sha1_context;
 
 	/* Value to indicate the SHA1 digest context was initialized
 	 */
@@ -115,7 +155,7 @@ struct verification_handle
 
 	/* The SHA256 digest context
 	 */
-	libhmac_sha256_context_t *sha256_context;
+	digest_context_t *sha256_context;
 
 	/* Value to indicate the SHA256 digest context was initialized
 	 */
@@ -133,6 +173,10 @@ struct verification_handle
 	 */
 	char *stored_sha256_hash_string;
 
+	/* The digest (hash) calculation backend
+	 */
+	int hash_backend;
+
 	/* Value to indicate if the data chunk functions instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_data_chunk_functions;
@@ -145,24 +189,68 @@ struct verification_handle
 	 */
 	int number_of_threads;
 
+	/* The maximum size of the process buffers that can be in flight
+	 */
+	size64_t maximum_process_buffers_size;
+
+	/* Value to indicate the number of storage media buffers in flight should be adapted at runtime
+	 */
+	uint8_t adapt_number_of_buffers;
+
+	/* The number of readers, that read the input in parallel
+	 */
+	int number_of_readers;
+
+	/* The maximum number of (concurrent) open file handles
+	 */
+	int maximum_number_of_open_handles;
+
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
 	/* The process thread pool
 	 */
 	libcthreads_thread_pool_t *process_thread_pool;
 
-	/* The output thread pool
-	 */
-	libcthreads_thread_pool_t *output_thread_pool;
-
-	/* The output list
+	/* The output window, that passes the processed storage media buffers on in order
 	 */
-	libcdata_list_t *output_list;
+	reorder_window_t *output_window;
 
 	/* The storage media buffer queue
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The buffer limiter, that adapts the number of storage media buffers in flight
+	 */
+	buffer_limiter_t *buffer_limiter;
+
+	/* The digest stage, that calculates the integrity hash(es) in separate threads
+	 */
+	digest_stage_t *digest_stage;
+
+	/* The readers
+	 */
+	verification_handle_reader_t *readers;
+
+	/* The reader thread pool, that contains a thread per reader
+	 */
+	libcthreads_thread_pool_t *reader_thread_pool;
+
+	/* The reader mutex, that protects the read offset
+	 */
+	libcthreads_mutex_t *reader_mutex;
+
+	/* The offset of the next storage media buffer to read
+	 */
+	off64_t read_offset;
+
+	/* The read buffer size
+	 */
+	size_t read_buffer_size;
+
+	/* The sample mutex, that protects the sample scheduler and the sample counters
+	 */
+	libcthreads_mutex_t *sample_mutex;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -189,14 +277,38 @@ struct verification_handle
 	 */
 	off64_t last_offset_hashed;
 
+	/* The checkpoint file, that contains the integrity hash checkpoints to resume the verification
+	 */
+	checkpoint_file_t *checkpoint_file;
+
+	/* The sample scheduler, that determines the chunks to verify in sample mode
+	 */
+	sample_scheduler_t *sample_scheduler;
+
+	/* The number of sampled chunks
+	 */
+	uint64_t number_of_sampled_chunks;
+
+	/* The number of corrupted sampled chunks
+	 */
+	uint64_t number_of_corrupted_sampled_chunks;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
 
+	/* The metrics stream
+	 */
+	FILE *metrics_stream;
+
 	/* The process status information
 	 */
 	process_status_t *process_status;
 
+	/* The stage profiler
+	 */
+	stage_profiler_t *stage_profiler;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -230,6 +342,24 @@ int verification_handle_close(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_handle_open_readers(
+     verification_handle_t *verification_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int verification_handle_close_readers(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_free_readers(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 ssize_t verification_handle_process_storage_media_buffer(
          verification_handle_t *verification_handle,
          storage_media_buffer_t *storage_media_buffer,
@@ -251,6 +381,14 @@ int verification_handle_finalize_integrity_hash(
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 
+int verification_handle_append_digest_stage_digests(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_digest_stage_release_callback(
+     storage_media_buffer_t *storage_media_buffer,
+     verification_handle_t *verification_handle );
+
 int verification_handle_process_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
@@ -259,18 +397,95 @@ int verification_handle_output_storage_media_buffer_callback(
      storage_media_buffer_t *storage_media_buffer,
      verification_handle_t *verification_handle );
 
-int verification_handle_empty_output_list(
+int verification_handle_empty_output_window(
      verification_handle_t *verification_handle,
      libcerror_error_t **error );
 
+int verification_handle_reader_callback(
+     verification_handle_reader_t *reader,
+     verification_handle_t *verification_handle );
+
+int verification_handle_read_input_with_readers(
+     verification_handle_t *verification_handle,
+     off64_t storage_media_offset,
+     size_t process_buffer_size,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
+int verification_handle_open_checkpoint_file(
+     verification_handle_t *verification_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int verification_handle_restore_checkpoint(
+     verification_handle_t *verification_handle,
+     off64_t *checkpoint_offset,
+     libcerror_error_t **error );
+
+int verification_handle_write_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_update_checkpoint(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
 int verification_handle_verify_input(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
      log_handle_t *log_handle,
      libcerror_error_t **error );
 
+int verification_handle_verify_chunks_progress_callback(
+     verification_handle_t *verification_handle,
+     uint64_t number_of_verified_chunks,
+     uint64_t number_of_chunks );
+
+int verification_handle_verify_chunks(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_initialize_sample_scheduler(
+     verification_handle_t *verification_handle,
+     libcerror_error_t **error );
+
+int verification_handle_set_sample_size(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_sample_ranges(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_sample_chunks(
+     verification_handle_t *verification_handle,
+     verification_handle_sampler_t *sampler,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int verification_handle_sampler_callback(
+     verification_handle_sampler_t *sampler,
+     verification_handle_t *verification_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int verification_handle_verify_sample(
+     verification_handle_t *verification_handle,
+     uint8_t print_status_information,
+     log_handle_t *log_handle,
+     libcerror_error_t **error );
+
+int verification_handle_sample_fprint(
+     verification_handle_t *verification_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
 int verification_handle_verify_single_files(
      verification_handle_t *verification_handle,
      uint8_t print_status_information,
@@ -322,11 +537,26 @@ int verification_handle_set_number_of_threads(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_number_of_readers(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_hash_backend(
+     verification_handle_t *verification_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_set_digest_types(
      verification_handle_t *verification_handle,
      const system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_metrics_stream(
+     verification_handle_t *verification_handle,
+     FILE *metrics_stream,
+     libcerror_error_t **error );
+
 int verification_handle_set_zero_chunk_on_error(
      verification_handle_t *verification_handle,
      uint8_t zero_chunk_on_error,
@@ -0,0 +1,975 @@
+/*
+ * Output write stage
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+#include "write_stage.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a write stage
+ * Make sure the value write_stage is referencing, is set to NULL
+ * The release function is called, from one of the output threads, when all outputs
+ * have written a value. Values are released one at a time in the order they were pushed.
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_initialize(
+     write_stage_t **write_stage,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            intptr_t *value,
+            uint8_t is_written,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_initialize";
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_stage != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write stage value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_queued_values <= 0 )
+	 || ( maximum_number_of_queued_values > (int) ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of queued values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( release_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid release function.",
+		 function );
+
+		return( -1 );
+	}
+	*write_stage = memory_allocate_structure(
+	                 write_stage_t );
+
+	if( *write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write stage.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_stage,
+	     0,
+	     sizeof( write_stage_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write stage.",
+		 function );
+
+		memory_free(
+		 *write_stage );
+
+		*write_stage = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_stage )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *write_stage )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_stage )->maximum_number_of_queued_values = maximum_number_of_queued_values;
+	( *write_stage )->release_function                = release_function;
+	( *write_stage )->release_function_arguments      = release_function_arguments;
+
+	return( 1 );
+
+on_error:
+	if( *write_stage != NULL )
+	{
+		if( ( *write_stage )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *write_stage )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *write_stage );
+
+		*write_stage = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write stage
+ * The output threads are joined if this was not done before
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_free(
+     write_stage_t **write_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_free";
+	int output_index      = 0;
+	int result            = 1;
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_stage != NULL )
+	{
+		for( output_index = 0;
+		     output_index < ( *write_stage )->number_of_outputs;
+		     output_index++ )
+		{
+			if( ( *write_stage )->outputs[ output_index ].thread_pool != NULL )
+			{
+				if( libcthreads_thread_pool_join(
+				     &( ( *write_stage )->outputs[ output_index ].thread_pool ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join output: %d thread pool.",
+					 function,
+					 output_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *write_stage )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *write_stage )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *write_stage );
+
+		*write_stage = NULL;
+	}
+	return( result );
+}
+
+/* Appends an output to the write stage
+ * Every output is written by its own thread, so that the outputs are written concurrently
+ * This function should be called before any value is pushed onto the write stage
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_append_output(
+     write_stage_t *write_stage,
+     intptr_t *handle,
+     int (*write_function)(
+            intptr_t *handle,
+            intptr_t *value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error )
+{
+	write_stage_output_t *output = NULL;
+	static char *function        = "write_stage_append_output";
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_stage->number_of_outputs >= WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write stage - number of outputs value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_function == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write function.",
+		 function );
+
+		return( -1 );
+	}
+	output = &( write_stage->outputs[ write_stage->number_of_outputs ] );
+
+	output->write_stage    = write_stage;
+	output->handle         = handle;
+	output->write_function = write_function;
+
+	if( libcthreads_thread_pool_create(
+	     &( output->thread_pool ),
+	     NULL,
+	     1,
+	     write_stage->maximum_number_of_queued_values,
+	     (int (*)(intptr_t *, void *)) &write_stage_write_callback,
+	     (void *) output,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize output thread pool.",
+		 function );
+
+		output->write_stage    = NULL;
+		output->handle         = NULL;
+		output->write_function = NULL;
+
+		return( -1 );
+	}
+	write_stage->number_of_outputs += 1;
+
+	return( 1 );
+}
+
+/* Sets the stage profiler
+ * The output writes are profiled as the write stage, the number of bytes written
+ * is not known to the write stage and should be added by the release function
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_set_stage_profiler(
+     write_stage_t *write_stage,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_set_stage_profiler";
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	write_stage->stage_profiler = stage_profiler;
+
+	return( 1 );
+}
+
+/* Pushes a value onto the write stage
+ * The value is shared, read-only, by all outputs and must not be modified until it is released
+ * The value is always passed to the release function, also when pushing the value fails
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_push(
+     write_stage_t *write_stage,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	write_stage_value_t *write_stage_value = NULL;
+	static char *function                  = "write_stage_push";
+	int64_t start_timestamp                = 0;
+	int number_of_pending_values           = 0;
+	int output_index                       = 0;
+	uint8_t has_failed                     = 0;
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	write_stage->number_of_pending_values += 1;
+
+	number_of_pending_values = write_stage->number_of_pending_values;
+	has_failed               = write_stage->has_failed;
+
+	if( libcthreads_mutex_release(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to write output(s).",
+		 function );
+
+		goto on_error;
+	}
+	write_stage_value = memory_allocate_structure(
+	                     write_stage_value_t );
+
+	if( write_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write stage value.",
+		 function );
+
+		goto on_error;
+	}
+	write_stage_value->value                = value;
+	write_stage_value->number_of_references = write_stage->number_of_outputs;
+	write_stage_value->is_written           = 1;
+
+	/* Profiling is best effort and does not affect the outputs
+	 */
+	if( write_stage->stage_profiler != NULL )
+	{
+		stage_profiler_add_queue_depth(
+		 write_stage->stage_profiler,
+		 STAGE_PROFILER_QUEUE_WRITE,
+		 (uint64_t) number_of_pending_values,
+		 NULL );
+
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+	}
+	/* Note that the write stage value can be released by the output threads
+	 * as soon as it has been pushed onto the last output thread pool
+	 */
+	for( output_index = 0;
+	     output_index < write_stage->number_of_outputs;
+	     output_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     write_stage->outputs[ output_index ].thread_pool,
+		     (intptr_t *) write_stage_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push value onto output: %d thread pool queue.",
+			 function,
+			 output_index );
+
+			break;
+		}
+	}
+	/* Pushing blocks while the thread pool queue of an output is full
+	 */
+	if( write_stage->stage_profiler != NULL )
+	{
+		stage_profiler_add_wait(
+		 write_stage->stage_profiler,
+		 STAGE_PROFILER_STAGE_WRITE,
+		 start_timestamp,
+		 NULL );
+	}
+	if( ( output_index < write_stage->number_of_outputs )
+	 || ( write_stage->number_of_outputs == 0 ) )
+	{
+		/* Drop the references of the outputs the value was not pushed onto
+		 */
+		if( write_stage_release_value(
+		     write_stage,
+		     &write_stage_value,
+		     write_stage->number_of_outputs - output_index,
+		     (uint8_t) ( output_index == write_stage->number_of_outputs ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to release value.",
+			 function );
+
+			return( -1 );
+		}
+		if( output_index < write_stage->number_of_outputs )
+		{
+			if( libcthreads_mutex_grab(
+			     write_stage->mutex,
+			     NULL ) == 1 )
+			{
+				write_stage->has_failed = 1;
+
+				libcthreads_mutex_release(
+				 write_stage->mutex,
+				 NULL );
+			}
+			return( -1 );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( libcthreads_mutex_grab(
+	     write_stage->mutex,
+	     NULL ) == 1 )
+	{
+		write_stage->release_function(
+		 value,
+		 0,
+		 write_stage->release_function_arguments );
+
+		write_stage->number_of_pending_values -= 1;
+		write_stage->has_failed                = 1;
+
+		if( write_stage->number_of_pending_values == 0 )
+		{
+			libcthreads_condition_broadcast(
+			 write_stage->condition,
+			 NULL );
+		}
+		libcthreads_mutex_release(
+		 write_stage->mutex,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases references to a value of the write stage
+ * The release function is called and the write stage value is freed when no more references remain
+ * The release function is called with the mutex grabbed, so that the values are released one at a time
+ * and in the order they were pushed
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_release_value(
+     write_stage_t *write_stage,
+     write_stage_value_t **write_stage_value,
+     int number_of_references,
+     uint8_t is_written,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_release_value";
+	int result            = 1;
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage value.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing write stage value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	( *write_stage_value )->number_of_references -= number_of_references;
+
+	if( is_written == 0 )
+	{
+		( *write_stage_value )->is_written = 0;
+	}
+	if( ( *write_stage_value )->number_of_references > 0 )
+	{
+		*write_stage_value = NULL;
+	}
+	else
+	{
+		/* Since the outputs write the values in order, the last reference of a value
+		 * is always dropped after the last reference of the values pushed before it
+		 */
+		if( write_stage->release_function(
+		     ( *write_stage_value )->value,
+		     ( *write_stage_value )->is_written,
+		     write_stage->release_function_arguments ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to release value.",
+			 function );
+
+			write_stage->has_failed = 1;
+
+			result = -1;
+		}
+		memory_free(
+		 *write_stage_value );
+
+		*write_stage_value = NULL;
+
+		write_stage->number_of_pending_values -= 1;
+
+		if( write_stage->number_of_pending_values == 0 )
+		{
+			if( libcthreads_condition_broadcast(
+			     write_stage->condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Waits until all values pushed onto the write stage have been released
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_wait(
+     write_stage_t *write_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_wait";
+	uint8_t has_failed    = 0;
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( write_stage->number_of_pending_values > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     write_stage->condition,
+		     write_stage->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 write_stage->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	has_failed = write_stage->has_failed;
+
+	if( libcthreads_mutex_release(
+	     write_stage->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to write output(s).",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Joins the output threads
+ * The values that are still queued are written before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_join(
+     write_stage_t *write_stage,
+     libcerror_error_t **error )
+{
+	static char *function = "write_stage_join";
+	int output_index      = 0;
+	int result            = 1;
+
+	if( write_stage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage.",
+		 function );
+
+		return( -1 );
+	}
+	for( output_index = 0;
+	     output_index < write_stage->number_of_outputs;
+	     output_index++ )
+	{
+		if( write_stage->outputs[ output_index ].thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( write_stage->outputs[ output_index ].thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join output: %d thread pool.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+	}
+	if( result == 1 )
+	{
+		result = write_stage_wait(
+		          write_stage,
+		          error );
+	}
+	return( result );
+}
+
+/* Writes a value to an output
+ * Callback function for the output thread pools
+ * Returns 1 if successful or -1 on error
+ */
+int write_stage_write_callback(
+     write_stage_value_t *write_stage_value,
+     write_stage_output_t *output )
+{
+	write_stage_t *write_stage = NULL;
+	libcerror_error_t *error   = NULL;
+	static char *function      = "write_stage_write_callback";
+	int64_t start_timestamp    = 0;
+	int result                 = 1;
+
+	if( write_stage_value == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write stage value.",
+		 function );
+
+		goto on_error;
+	}
+	if( output == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output.",
+		 function );
+
+		goto on_error;
+	}
+	write_stage = output->write_stage;
+
+	if( write_stage->stage_profiler != NULL )
+	{
+		stage_profiler_get_timestamp(
+		 &start_timestamp,
+		 NULL );
+	}
+	/* Once an output failed the remaining values are only released
+	 */
+	if( write_stage->has_failed != 0 )
+	{
+		result = 0;
+	}
+	else if( output->write_function(
+	          output->handle,
+	          write_stage_value->value,
+	          &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write output.",
+		 function );
+
+		result = -1;
+
+		if( libcthreads_mutex_grab(
+		     write_stage->mutex,
+		     NULL ) == 1 )
+		{
+			write_stage->has_failed = 1;
+
+			libcthreads_mutex_release(
+			 write_stage->mutex,
+			 NULL );
+		}
+	}
+	else if( write_stage->stage_profiler != NULL )
+	{
+		stage_profiler_add_sample(
+		 write_stage->stage_profiler,
+		 STAGE_PROFILER_STAGE_WRITE,
+		 start_timestamp,
+		 0,
+		 NULL );
+	}
+	if( write_stage_release_value(
+	     write_stage,
+	     &write_stage_value,
+	     1,
+	     (uint8_t) ( result == 1 ),
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to release write stage value.",
+		 function );
+
+		goto on_error;
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,190 @@
+/*
+ * Output write stage
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _WRITE_STAGE_H )
+#define _WRITE_STAGE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "stage_profiler.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The maximum number of outputs written by a stage: the primary and secondary target
+ */
+#define WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS	2
+
+typedef struct write_stage write_stage_t;
+
+typedef struct write_stage_output write_stage_output_t;
+
+struct write_stage_output
+{
+	/* The write stage
+	 */
+	write_stage_t *write_stage;
+
+	/* The output handle
+	 */
+	intptr_t *handle;
+
+	/* The output write function
+	 */
+	int (*write_function)(
+	       intptr_t *handle,
+	       intptr_t *value,
+	       libcerror_error_t **error );
+
+	/* The thread pool, that contains a single thread to keep the writes in order
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+};
+
+typedef struct write_stage_value write_stage_value_t;
+
+struct write_stage_value
+{
+	/* The value, which is shared by the outputs and passed to the release function
+	 */
+	intptr_t *value;
+
+	/* The number of outputs that still reference the value
+	 */
+	int number_of_references;
+
+	/* Value to indicate the value was written to all outputs
+	 */
+	uint8_t is_written;
+};
+
+struct write_stage
+{
+	/* The outputs
+	 */
+	write_stage_output_t outputs[ WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS ];
+
+	/* The number of outputs
+	 */
+	int number_of_outputs;
+
+	/* The maximum number of queued values per output
+	 */
+	int maximum_number_of_queued_values;
+
+	/* The release function, which is called when all outputs have written a value
+	 */
+	int (*release_function)(
+	       intptr_t *value,
+	       uint8_t is_written,
+	       void *arguments );
+
+	/* The release function arguments
+	 */
+	void *release_function_arguments;
+
+	/* The number of values that are pending to be released
+	 */
+	int number_of_pending_values;
+
+	/* Value to indicate writing an output or releasing a value failed
+	 */
+	uint8_t has_failed;
+
+	/* The stage profiler, which is not owned by the write stage
+	 */
+	stage_profiler_t *stage_profiler;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when there are no more pending values
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int write_stage_initialize(
+     write_stage_t **write_stage,
+     int maximum_number_of_queued_values,
+     int (*release_function)(
+            intptr_t *value,
+            uint8_t is_written,
+            void *arguments ),
+     void *release_function_arguments,
+     libcerror_error_t **error );
+
+int write_stage_free(
+     write_stage_t **write_stage,
+     libcerror_error_t **error );
+
+int write_stage_append_output(
+     write_stage_t *write_stage,
+     intptr_t *handle,
+     int (*write_function)(
+            intptr_t *handle,
+            intptr_t *value,
+            libcerror_error_t **error ),
+     libcerror_error_t **error );
+
+int write_stage_set_stage_profiler(
+     write_stage_t *write_stage,
+     stage_profiler_t *stage_profiler,
+     libcerror_error_t **error );
+
+int write_stage_push(
+     write_stage_t *write_stage,
+     intptr_t *value,
+     libcerror_error_t **error );
+
+int write_stage_release_value(
+     write_stage_t *write_stage,
+     write_stage_value_t **write_stage_value,
+     int number_of_references,
+     uint8_t is_written,
+     libcerror_error_t **error );
+
+int write_stage_wait(
+     write_stage_t *write_stage,
+     libcerror_error_t **error );
+
+int write_stage_join(
+     write_stage_t *write_stage,
+     libcerror_error_t **error );
+
+int write_stage_write_callback(
+     write_stage_value_t *write_stage_value,
+     write_stage_output_t *output );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _WRITE_STAGE_H ) */
+
@@ -28,6 +28,7 @@
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_empty_block_cache.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
@@ -410,6 +411,7 @@ int libewf_chunk_data_pack_determine_pack_flags(
 {
 	static char *function   = "libewf_chunk_data_pack_determine_pack_flags";
 	uint64_t fill_pattern   = 0;
+	uint8_t fill_byte       = 0;
 	uint8_t safe_pack_flags = 0;
 	int result              = 0;
 
@@ -499,9 +501,10 @@ int libewf_chunk_data_pack_determine_pack_flags(
 	else if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
 	      || ( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE ) )
 	{
-		result = libewf_chunk_data_check_for_empty_block(
+		result = libewf_chunk_data_check_for_fill_byte(
 			  chunk_data->data,
 			  chunk_data->data_size,
+			  &fill_byte,
 			  error );
 
 		if( result == -1 )
@@ -515,11 +518,19 @@ int libewf_chunk_data_pack_determine_pack_flags(
 
 			return( -1 );
 		}
-		else if( ( result != 0 )
-		      && ( chunk_data->data[ 0 ] == 0 ) )
+		else if( result != 0 )
 		{
-			safe_pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-			safe_pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION | LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+			if( fill_byte == 0 )
+			{
+				safe_pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+				safe_pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION | LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+			}
+			/* Empty blocks with other fill bytes are only stored compressed when compression is used
+			 */
+			else if( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+			{
+				safe_pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+			}
 		}
 	}
 	*pack_flags = safe_pack_flags;
@@ -723,8 +734,9 @@ int libewf_chunk_data_unpack_with_64_bit_pattern_fill(
  */
 int libewf_chunk_data_pack_with_empty_block_compression(
      libewf_chunk_data_t *chunk_data,
-     const uint8_t *compressed_zero_byte_empty_block,
-     size_t compressed_zero_byte_empty_block_size,
+     const uint8_t *compressed_empty_block,
+     size_t compressed_empty_block_size,
+     uint16_t compression_method,
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_pack_with_empty_block_compression";
@@ -751,34 +763,34 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 
 		return( -1 );
 	}
-	if( compressed_zero_byte_empty_block == NULL )
+	if( compressed_empty_block == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed zero byte empty block.",
+		 "%s: invalid compressed empty block.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( compressed_zero_byte_empty_block_size < 4 )
-	 || ( compressed_zero_byte_empty_block_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	if( ( compressed_empty_block_size < 4 )
+	 || ( compressed_empty_block_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid compressed zero byte empty block size value out of bounds.",
+		 "%s: invalid compressed empty block size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	chunk_data->compressed_data_size = compressed_zero_byte_empty_block_size;
+	chunk_data->compressed_data_size = compressed_empty_block_size;
 
-	if( ( compressed_zero_byte_empty_block_size % 16 ) != 0 )
+	if( ( compressed_empty_block_size % 16 ) != 0 )
 	{
-		chunk_data->compressed_data_size += 16 - ( compressed_zero_byte_empty_block_size % 16 );
+		chunk_data->compressed_data_size += 16 - ( compressed_empty_block_size % 16 );
 	}
 	chunk_data->compressed_data = (uint8_t *) memory_allocate(
 	                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
@@ -796,21 +808,43 @@ int libewf_chunk_data_pack_with_empty_block_compression(
 	}
 	if( memory_copy(
 	     chunk_data->compressed_data,
-	     compressed_zero_byte_empty_block,
-	     compressed_zero_byte_empty_block_size ) == NULL )
+	     compressed_empty_block,
+	     compressed_empty_block_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy compressed 0-byte empty block to compressed chunk data.",
+		 "%s: unable to copy compressed empty block to compressed chunk data.",
 		 function );
 
 		goto on_error;
 	}
-	byte_stream_copy_to_uint32_little_endian(
-	 &( compressed_zero_byte_empty_block[ compressed_zero_byte_empty_block_size - 4 ] ),
-	 chunk_data->checksum );
+	if( chunk_data->compressed_data_size > compressed_empty_block_size )
+	{
+		if( memory_set(
+		     &( ( chunk_data->compressed_data )[ compressed_empty_block_size ] ),
+		     0,
+		     chunk_data->compressed_data_size - compressed_empty_block_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear compressed chunk data padding.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Only deflate compressed data ends with a checksum
+	 */
+	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( compressed_empty_block[ compressed_empty_block_size - 4 ] ),
+		 chunk_data->checksum );
+	}
 
 	chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
 
@@ -1009,11 +1043,14 @@ int libewf_chunk_data_pack(
      libewf_io_handle_t *io_handle,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
+     libewf_empty_block_cache_t *empty_block_cache,
      uint8_t pack_flags,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_chunk_data_pack";
-	int result            = 0;
+	const uint8_t *compressed_empty_block = NULL;
+	static char *function                 = "libewf_chunk_data_pack";
+	size_t compressed_empty_block_size    = 0;
+	int result                            = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1071,6 +1108,37 @@ int libewf_chunk_data_pack(
 	 */
 	chunk_data->range_flags = 0;
 
+	if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+	 && ( chunk_data->data_size == (size_t) chunk_data->chunk_size ) )
+	{
+		if( chunk_data->data[ 0 ] == 0 )
+		{
+			compressed_empty_block      = compressed_zero_byte_empty_block;
+			compressed_empty_block_size = compressed_zero_byte_empty_block_size;
+		}
+		else if( empty_block_cache != NULL )
+		{
+			/* If no compressed empty block is available the chunk data is compressed
+			 */
+			if( libewf_empty_block_cache_get_compressed_block(
+			     empty_block_cache,
+			     (uint32_t) chunk_data->chunk_size,
+			     chunk_data->data[ 0 ],
+			     &compressed_empty_block,
+			     &compressed_empty_block_size,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve compressed empty block from cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
 	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
 	{
@@ -1090,14 +1158,13 @@ int libewf_chunk_data_pack(
 				goto on_error;
 			}
 		}
-		else if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-		      && ( chunk_data->data_size == (size_t) chunk_data->chunk_size )
-		      && ( compressed_zero_byte_empty_block != NULL ) )
+		else if( compressed_empty_block != NULL )
 		{
 			if( libewf_chunk_data_pack_with_empty_block_compression(
 			     chunk_data,
-			     compressed_zero_byte_empty_block,
-			     compressed_zero_byte_empty_block_size,
+			     compressed_empty_block,
+			     compressed_empty_block_size,
+			     io_handle->compression_method,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1576,6 +1643,116 @@ int libewf_chunk_data_check_for_empty_block(
 	return( 1 );
 }
 
+/* Checks if a buffer containing the chunk data is filled with a single byte value (empty-block)
+ * Returns 1 if the buffer is filled with a single byte value, 0 if not or -1 on error
+ */
+int libewf_chunk_data_check_for_fill_byte(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fill_byte,
+     libcerror_error_t **error )
+{
+	libewf_aligned_t *aligned_data_index = NULL;
+	uint8_t *data_index                  = NULL;
+	static char *function                = "libewf_chunk_data_check_for_fill_byte";
+	libewf_aligned_t aligned_fill_value  = 0;
+	uint8_t safe_fill_byte               = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_byte == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill byte.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == 0 )
+	{
+		return( 0 );
+	}
+	safe_fill_byte = data[ 0 ];
+
+	/* Most chunks that are not empty blocks differ in the first or last byte
+	 */
+	if( data[ data_size - 1 ] != safe_fill_byte )
+	{
+		return( 0 );
+	}
+	data_index = (uint8_t *) data;
+
+	/* Only optimize for data larger than the alignment
+	 */
+	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	{
+		/* Align the data index
+		 */
+		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
+		{
+			if( *data_index != safe_fill_byte )
+			{
+				return( 0 );
+			}
+			data_index++;
+			data_size--;
+		}
+		/* Compare the data against an aligned value filled with the fill byte
+		 * which requires only a single read per aligned value
+		 * ~0 / 0xff results in an aligned value with all bytes set to 0x01
+		 */
+		aligned_fill_value = ( ~( (libewf_aligned_t) 0 ) / 0xff ) * (libewf_aligned_t) safe_fill_byte;
+		aligned_data_index = (libewf_aligned_t *) data_index;
+
+		while( data_size > sizeof( libewf_aligned_t ) )
+		{
+			if( *aligned_data_index != aligned_fill_value )
+			{
+				return( 0 );
+			}
+			aligned_data_index++;
+
+			data_size -= sizeof( libewf_aligned_t );
+		}
+		data_index = (uint8_t *) aligned_data_index;
+	}
+	while( data_size != 0 )
+	{
+		if( *data_index != safe_fill_byte )
+		{
+			return( 0 );
+		}
+		data_index++;
+		data_size--;
+	}
+	*fill_byte = safe_fill_byte;
+
+	return( 1 );
+}
+
 /* Checks if a buffer containing the chunk data is filled with a 64-bit pattern
  * Returns 1 if a pattern was found, 0 if not or -1 on error
  */
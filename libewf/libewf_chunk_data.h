@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_empty_block_cache.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -137,8 +138,9 @@ int libewf_chunk_data_unpack_with_64_bit_pattern_fill(
 
 int libewf_chunk_data_pack_with_empty_block_compression(
      libewf_chunk_data_t *chunk_data,
-     const uint8_t *compressed_zero_byte_empty_block,
-     size_t compressed_zero_byte_empty_block_size,
+     const uint8_t *compressed_empty_block,
+     size_t compressed_empty_block_size,
+     uint16_t compression_method,
      libcerror_error_t **error );
 
 int libewf_chunk_data_pack_with_compression(
@@ -151,6 +153,7 @@ int libewf_chunk_data_pack(
      libewf_io_handle_t *io_handle,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
+     libewf_empty_block_cache_t *empty_block_cache,
      uint8_t pack_flags,
      libcerror_error_t **error );
 
@@ -164,6 +167,12 @@ int libewf_chunk_data_check_for_empty_block(
      size_t data_size,
      libcerror_error_t **error );
 
+int libewf_chunk_data_check_for_fill_byte(
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *fill_byte,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_check_for_64_bit_pattern_fill(
      const uint8_t *data,
      size_t data_size,
@@ -0,0 +1,976 @@
+/*
+ * Chunk reorder window functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_reorder_window.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk reorder window
+ * Make sure the value chunk_reorder_window is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_initialize(
+     libewf_chunk_reorder_window_t **chunk_reorder_window,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_initialize";
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_reorder_window != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk reorder window value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > LIBEWF_MAXIMUM_CHUNK_REORDER_WINDOW_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_reorder_window = memory_allocate_structure(
+	                         libewf_chunk_reorder_window_t );
+
+	if( *chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk reorder window.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_reorder_window,
+	     0,
+	     sizeof( libewf_chunk_reorder_window_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk reorder window.",
+		 function );
+
+		memory_free(
+		 *chunk_reorder_window );
+
+		*chunk_reorder_window = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_reorder_window )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *chunk_reorder_window )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize condition.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *chunk_reorder_window )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_reorder_window != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_reorder_window )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_reorder_window )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *chunk_reorder_window );
+
+		*chunk_reorder_window = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk reorder window
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_free(
+     libewf_chunk_reorder_window_t **chunk_reorder_window,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_free";
+	int result            = 1;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_reorder_window != NULL )
+	{
+		if( libewf_chunk_reorder_window_empty(
+		     *chunk_reorder_window,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty chunk reorder window.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *chunk_reorder_window )->entries != NULL )
+		{
+			memory_free(
+			 ( *chunk_reorder_window )->entries );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_condition_free(
+		     &( ( *chunk_reorder_window )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_reorder_window )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *chunk_reorder_window );
+
+		*chunk_reorder_window = NULL;
+	}
+	return( result );
+}
+
+/* Empties the chunk reorder window
+ * Frees the chunk data of the entries that have not been written and deactivates the window
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_empty(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_empty";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_reorder_window->entries != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < chunk_reorder_window->maximum_number_of_entries;
+		     entry_index++ )
+		{
+			if( chunk_reorder_window->entries[ entry_index ].chunk_data != NULL )
+			{
+				if( libewf_chunk_data_free(
+				     &( chunk_reorder_window->entries[ entry_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free chunk data: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+			chunk_reorder_window->entries[ entry_index ].data_size = 0;
+		}
+	}
+	chunk_reorder_window->number_of_entries = 0;
+	chunk_reorder_window->first_chunk_index = 0;
+	chunk_reorder_window->is_active         = 0;
+	chunk_reorder_window->write_in_progress = 0;
+	chunk_reorder_window->write_failed      = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_get_maximum_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int *maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_get_maximum_number_of_entries";
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_entries = chunk_reorder_window->maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Sets the maximum number of entries
+ * The maximum number of entries cannot be changed when the window is in use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_set_maximum_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_set_maximum_number_of_entries";
+	int result            = 1;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > LIBEWF_MAXIMUM_CHUNK_REORDER_WINDOW_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_reorder_window->is_active != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: maximum number of entries cannot be changed while the window is in use.",
+		 function );
+
+		result = -1;
+	}
+	else if( maximum_number_of_entries != chunk_reorder_window->maximum_number_of_entries )
+	{
+		/* The entries are reallocated when the window is activated
+		 */
+		if( chunk_reorder_window->entries != NULL )
+		{
+			memory_free(
+			 chunk_reorder_window->entries );
+
+			chunk_reorder_window->entries = NULL;
+		}
+		chunk_reorder_window->maximum_number_of_entries = maximum_number_of_entries;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of entries that are waiting to be written
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_reorder_window_get_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_get_number_of_entries";
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_entries = chunk_reorder_window->number_of_entries;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Activates the chunk reorder window
+ * The first chunk index is the index of the next chunk to be written
+ * Returns 1 if successful, 0 if the window was already active or -1 on error
+ */
+int libewf_chunk_reorder_window_activate(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint64_t first_chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_activate";
+	size_t entries_size   = 0;
+	int result            = 0;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_reorder_window->is_active == 0 )
+	{
+		if( chunk_reorder_window->entries == NULL )
+		{
+			entries_size = sizeof( libewf_chunk_reorder_window_entry_t ) * chunk_reorder_window->maximum_number_of_entries;
+
+			chunk_reorder_window->entries = (libewf_chunk_reorder_window_entry_t *) memory_allocate(
+			                                                                         entries_size );
+
+			if( chunk_reorder_window->entries == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entries.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_set(
+			     chunk_reorder_window->entries,
+			     0,
+			     entries_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear entries.",
+				 function );
+
+				memory_free(
+				 chunk_reorder_window->entries );
+
+				chunk_reorder_window->entries = NULL;
+
+				goto on_error;
+			}
+		}
+		chunk_reorder_window->first_chunk_index = first_chunk_index;
+		chunk_reorder_window->is_active         = 1;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_reorder_window->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Pushes a chunk onto the chunk reorder window
+ * The window must have been activated before a chunk is pushed
+ * If the chunk is beyond the end of the window this function blocks until
+ * the window has moved far enough, when multi-threading is not supported
+ * this is considered an error
+ * Returns 1 if the chunk is the next chunk and must be written by the caller,
+ * 0 if the chunk was stored in the window or -1 on error
+ * If 0 is returned the chunk reorder window has taken over management of the chunk data
+ */
+int libewf_chunk_reorder_window_push(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_push";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_reorder_window->is_active == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk reorder window - not active.",
+		 function );
+
+		goto on_error;
+	}
+	while( chunk_reorder_window->write_failed == 0 )
+	{
+		if( chunk_index < chunk_reorder_window->first_chunk_index )
+		{
+			break;
+		}
+		if( ( chunk_index - chunk_reorder_window->first_chunk_index ) < (uint64_t) chunk_reorder_window->maximum_number_of_entries )
+		{
+			break;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* Wait until the chunks before the window have been written
+		 */
+		if( libcthreads_condition_wait(
+		     chunk_reorder_window->condition,
+		     chunk_reorder_window->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			goto on_error;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " outside of window.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+#endif
+	}
+	if( chunk_reorder_window->write_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to push chunk: %" PRIu64 " after previous write failure.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( chunk_index < chunk_reorder_window->first_chunk_index )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already written.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	entry_index = (int) ( chunk_index % chunk_reorder_window->maximum_number_of_entries );
+
+	if( ( chunk_reorder_window->entries[ entry_index ].chunk_data != NULL )
+	 || ( ( chunk_index == chunk_reorder_window->first_chunk_index )
+	  &&  ( chunk_reorder_window->write_in_progress != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: chunk: %" PRIu64 " already set.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( chunk_index == chunk_reorder_window->first_chunk_index )
+	{
+		chunk_reorder_window->write_in_progress = 1;
+
+		result = 1;
+	}
+	else
+	{
+		chunk_reorder_window->entries[ entry_index ].chunk_data = chunk_data;
+		chunk_reorder_window->entries[ entry_index ].data_size  = data_size;
+
+		chunk_reorder_window->number_of_entries += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_reorder_window->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Pops the next chunk from the chunk reorder window
+ * This function must be called after the caller has written the chunk for which
+ * libewf_chunk_reorder_window_push or libewf_chunk_reorder_window_pop returned 1
+ * Returns 1 if the next chunk is available and must be written by the caller,
+ * 0 if not available or -1 on error
+ * If 1 is returned the caller has taken over management of the chunk data
+ */
+int libewf_chunk_reorder_window_pop(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint8_t write_failed,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_reorder_window_pop";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( chunk_reorder_window == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( chunk_reorder_window->write_in_progress == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk reorder window - no write in progress.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_failed != 0 )
+	{
+		chunk_reorder_window->write_failed      = 1;
+		chunk_reorder_window->write_in_progress = 0;
+	}
+	else
+	{
+		chunk_reorder_window->first_chunk_index += 1;
+
+		entry_index = (int) ( chunk_reorder_window->first_chunk_index % chunk_reorder_window->maximum_number_of_entries );
+
+		if( chunk_reorder_window->entries[ entry_index ].chunk_data != NULL )
+		{
+			*chunk_index = chunk_reorder_window->first_chunk_index;
+			*chunk_data  = chunk_reorder_window->entries[ entry_index ].chunk_data;
+			*data_size   = chunk_reorder_window->entries[ entry_index ].data_size;
+
+			chunk_reorder_window->entries[ entry_index ].chunk_data = NULL;
+			chunk_reorder_window->entries[ entry_index ].data_size  = 0;
+
+			chunk_reorder_window->number_of_entries -= 1;
+
+			result = 1;
+		}
+		else
+		{
+			chunk_reorder_window->write_in_progress = 0;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Wake up the threads that are waiting for the window to move
+	 */
+	if( libcthreads_condition_broadcast(
+	     chunk_reorder_window->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_reorder_window->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 chunk_reorder_window->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
@@ -0,0 +1,145 @@
+/*
+ * Chunk reorder window functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_REORDER_WINDOW_H )
+#define _LIBEWF_CHUNK_REORDER_WINDOW_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_reorder_window_entry libewf_chunk_reorder_window_entry_t;
+
+struct libewf_chunk_reorder_window_entry
+{
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The (chunk) data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libewf_chunk_reorder_window libewf_chunk_reorder_window_t;
+
+struct libewf_chunk_reorder_window
+{
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The entries
+	 */
+	libewf_chunk_reorder_window_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the first chunk in the window, which is the next chunk to be written
+	 */
+	uint64_t first_chunk_index;
+
+	/* Value to indicate the window is in use
+	 */
+	uint8_t is_active;
+
+	/* Value to indicate a chunk is being written
+	 */
+	uint8_t write_in_progress;
+
+	/* Value to indicate writing a chunk failed
+	 */
+	uint8_t write_failed;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the window has moved
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+int libewf_chunk_reorder_window_initialize(
+     libewf_chunk_reorder_window_t **chunk_reorder_window,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_free(
+     libewf_chunk_reorder_window_t **chunk_reorder_window,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_empty(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_get_maximum_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int *maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_set_maximum_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_get_number_of_entries(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_activate(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint64_t first_chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_push(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_reorder_window_pop(
+     libewf_chunk_reorder_window_t *chunk_reorder_window,
+     uint8_t write_failed,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_REORDER_WINDOW_H ) */
+
@@ -0,0 +1,693 @@
+/*
+ * Chunk verifier functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_verifier.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfdata.h"
+#include "libewf_media_values.h"
+
+/* Creates a chunk verifier
+ * Make sure the value chunk_verifier is referencing, is set to NULL
+ * If number_of_threads is 0 the chunks are verified by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_initialize(
+     libewf_chunk_verifier_t **chunk_verifier,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libcdata_range_list_t *checksum_errors,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_verifier_initialize";
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_verifier != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk verifier value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media values - bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum errors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_VERIFY_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_verifier = memory_allocate_structure(
+	                   libewf_chunk_verifier_t );
+
+	if( *chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_verifier,
+	     0,
+	     sizeof( libewf_chunk_verifier_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk verifier.",
+		 function );
+
+		memory_free(
+		 *chunk_verifier );
+
+		*chunk_verifier = NULL;
+
+		return( -1 );
+	}
+	( *chunk_verifier )->io_handle       = io_handle;
+	( *chunk_verifier )->media_values    = media_values;
+	( *chunk_verifier )->checksum_errors = checksum_errors;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *chunk_verifier )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 0 )
+	{
+		/* Bound the number of chunks that are read ahead of the verification
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( ( *chunk_verifier )->thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     number_of_threads * 4,
+		     (int (*)(intptr_t *, void *)) &libewf_chunk_verifier_thread_pool_callback,
+		     (void *) *chunk_verifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_verifier != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_verifier )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *chunk_verifier )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *chunk_verifier );
+
+		*chunk_verifier = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk verifier
+ * Waits for the chunks that are still being verified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_free(
+     libewf_chunk_verifier_t **chunk_verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_verifier_free";
+	int result            = 1;
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_verifier != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *chunk_verifier )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *chunk_verifier )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *chunk_verifier )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		/* The IO handle, media values and checksum errors references are freed elsewhere
+		 */
+		memory_free(
+		 *chunk_verifier );
+
+		*chunk_verifier = NULL;
+	}
+	return( result );
+}
+
+/* Verifies the chunk data
+ * Unpacks the chunk data, which validates the checksum or the compressed data,
+ * and adds a checksum error if the chunk data is corrupted
+ * The chunk verifier takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_verify_chunk_data(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_verifier_verify_chunk_data";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+	uint8_t is_corrupted       = 0;
+	int result                 = 1;
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_unpack(
+	     chunk_data,
+	     chunk_verifier->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_data->chunk_index );
+
+		goto on_error;
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		start_sector      = chunk_data->range_start_offset / chunk_verifier->media_values->bytes_per_sector;
+		number_of_sectors = chunk_verifier->media_values->sectors_per_chunk;
+
+		if( ( start_sector + number_of_sectors ) > (uint64_t) chunk_verifier->media_values->number_of_sectors )
+		{
+			number_of_sectors = (uint64_t) chunk_verifier->media_values->number_of_sectors - start_sector;
+		}
+		is_corrupted = 1;
+	}
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_verifier->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( is_corrupted != 0 )
+	{
+		if( libcdata_range_list_insert_range(
+		     chunk_verifier->checksum_errors,
+		     start_sector,
+		     number_of_sectors,
+		     NULL,
+		     NULL,
+		     NULL,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert checksum error in range list.",
+			 function );
+
+			chunk_verifier->verify_failed = 1;
+
+			result = -1;
+		}
+	}
+	chunk_verifier->number_of_verified_chunks += 1;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_verifier->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the thread pool to verify chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_thread_pool_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_verifier_t *chunk_verifier )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_chunk_verifier_thread_pool_callback";
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_verifier_verify_chunk_data(
+	     chunk_verifier,
+	     chunk_data,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	/* The error is reported by libewf_chunk_verifier_join
+	 */
+	if( chunk_verifier != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     chunk_verifier->mutex,
+		     NULL ) == 1 )
+		{
+			chunk_verifier->verify_failed = 1;
+
+			libcthreads_mutex_release(
+			 chunk_verifier->mutex,
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Pushes chunk data to be verified
+ * The chunk verifier takes over management of the chunk data
+ * This function blocks if the thread pool queue is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_push(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_verifier_push";
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( chunk_verifier->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     chunk_verifier->thread_pool,
+		     (intptr_t *) chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk data onto thread pool queue.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+#endif
+	if( libewf_chunk_verifier_verify_chunk_data(
+	     chunk_verifier,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Waits until all the pushed chunk data has been verified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_join(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_verifier_join";
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( chunk_verifier->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( chunk_verifier->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( chunk_verifier->verify_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of chunks that have been verified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_verifier_get_number_of_verified_chunks(
+     libewf_chunk_verifier_t *chunk_verifier,
+     uint64_t *number_of_verified_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_verifier_get_number_of_verified_chunks";
+
+	if( chunk_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_verified_chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of verified chunks.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     chunk_verifier->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_verified_chunks = chunk_verifier->number_of_verified_chunks;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     chunk_verifier->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,118 @@
+/*
+ * Chunk verifier functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_VERIFIER_H )
+#define _LIBEWF_CHUNK_VERIFIER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_media_values.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_verifier libewf_chunk_verifier_t;
+
+struct libewf_chunk_verifier
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The checksum errors range list
+	 */
+	libcdata_range_list_t *checksum_errors;
+
+	/* The number of chunks that have been verified
+	 */
+	uint64_t number_of_verified_chunks;
+
+	/* Value to indicate verifying a chunk failed
+	 */
+	uint8_t verify_failed;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_chunk_verifier_initialize(
+     libewf_chunk_verifier_t **chunk_verifier,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libcdata_range_list_t *checksum_errors,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_chunk_verifier_free(
+     libewf_chunk_verifier_t **chunk_verifier,
+     libcerror_error_t **error );
+
+int libewf_chunk_verifier_verify_chunk_data(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_chunk_verifier_thread_pool_callback(
+     libewf_chunk_data_t *chunk_data,
+     libewf_chunk_verifier_t *chunk_verifier );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_chunk_verifier_push(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_verifier_join(
+     libewf_chunk_verifier_t *chunk_verifier,
+     libcerror_error_t **error );
+
+int libewf_chunk_verifier_get_number_of_verified_chunks(
+     libewf_chunk_verifier_t *chunk_verifier,
+     uint64_t *number_of_verified_chunks,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_VERIFIER_H ) */
+
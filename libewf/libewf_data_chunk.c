@@ -20,6 +20,7 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
@@ -288,6 +289,79 @@ int libewf_internal_data_chunk_set_chunk_data(
 	return( result );
 }
 
+/* Detaches the chunk data from the data chunk
+ * The chunk data is not freed, the caller takes over its management
+ * Returns 1 if successful, 0 if the chunk data is not set in the data chunk or -1 on error
+ */
+int libewf_internal_data_chunk_detach_chunk_data(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_data_chunk_detach_chunk_data";
+	int result            = 0;
+
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_data_chunk->chunk_data == chunk_data )
+	{
+		internal_data_chunk->chunk_data = NULL;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
 /* Determines if the data chunk is corrupted
  * Returns 1 if the data chunk is corrupted, 0 if not or -1 on error
  */
@@ -592,6 +666,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	     internal_data_chunk->io_handle,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
+	     internal_data_chunk->write_io_handle->empty_block_cache,
 	     internal_data_chunk->write_io_handle->pack_flags,
 	     error ) != 1 )
 	{
@@ -630,3 +705,624 @@ on_error:
 	return( -1 );
 }
 
+
+/* Retrieves the size of the stored (packed) data of the data chunk
+ * The stored data size includes the checksum but not the alignment padding
+ * This function should be used after libewf_handle_read_data_chunk and before libewf_data_chunk_read_buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_data_chunk_get_stored_data_size(
+     libewf_data_chunk_t *data_chunk,
+     size_t *stored_data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_get_stored_data_size";
+	int result                                        = 1;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( stored_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stored data size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid data chunk - chunk data is not packed.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		*stored_data_size = internal_data_chunk->chunk_data->data_size;
+
+		if( ( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+		 && ( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+		 && ( ( internal_data_chunk->chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 ) )
+		{
+			*stored_data_size += 4;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the stored (packed) data of the data chunk into a buffer
+ * The data is copied as stored, without decompression or checksum validation,
+ * the chunk data flags indicate how the data is stored
+ * This function should be used after libewf_handle_read_data_chunk and before libewf_data_chunk_read_buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_data_chunk_read_stored_buffer(
+         libewf_data_chunk_t *data_chunk,
+         void *buffer,
+         size_t buffer_size,
+         uint32_t *chunk_data_flags,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                   = NULL;
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_read_stored_buffer";
+	size_t stored_data_size                           = 0;
+	ssize_t read_count                                = 0;
+	uint32_t safe_chunk_data_flags                    = 0;
+	uint8_t has_separate_checksum                     = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	chunk_data = internal_data_chunk->chunk_data;
+
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid data chunk - chunk data is not packed.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		safe_chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED;
+
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			safe_chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL;
+		}
+	}
+	else if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		safe_chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM;
+
+		if( ( chunk_data->chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+		{
+			has_separate_checksum = 1;
+		}
+	}
+	stored_data_size = chunk_data->data_size;
+
+	if( has_separate_checksum != 0 )
+	{
+		stored_data_size += 4;
+	}
+	if( stored_data_size > buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid buffer size value too small.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     buffer,
+	     chunk_data->data,
+	     chunk_data->data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy stored data.",
+		 function );
+
+		goto on_error;
+	}
+	if( has_separate_checksum != 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 &( ( (uint8_t *) buffer )[ chunk_data->data_size ] ),
+		 chunk_data->checksum );
+	}
+	read_count = (ssize_t) stored_data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*chunk_data_flags = safe_chunk_data_flags;
+
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes stored (packed) data from a buffer to the data chunk
+ * The data is stored as-is, without compression or calculating a checksum,
+ * the chunk data flags indicate how the data is stored and data size
+ * contains the size of the media data the stored data represents
+ * This function should be used before libewf_handle_write_data_chunk
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_data_chunk_write_stored_buffer(
+         libewf_data_chunk_t *data_chunk,
+         const void *buffer,
+         size_t buffer_size,
+         size_t data_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                   = NULL;
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_write_stored_buffer";
+	size_t padding_size                               = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_data_chunk->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) internal_data_chunk->io_handle->chunk_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_flags & ~( LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED | LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM | LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chunk data flags: 0x%08" PRIx32 ".",
+		 function,
+		 chunk_data_flags );
+
+		return( -1 );
+	}
+	if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk data flags - compressed data with separate checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 )
+		 && ( internal_data_chunk->io_handle->format != LIBEWF_FORMAT_V2_ENCASE7 )
+		 && ( internal_data_chunk->io_handle->format != LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk data flags - pattern fill not supported by format.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk data flags - pattern fill without compression.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( internal_data_chunk->write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk data flags - format requires compressed data.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM ) == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chunk data flags - uncompressed data without checksum.",
+			 function );
+
+			return( -1 );
+		}
+		if( buffer_size != ( data_size + 4 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid buffer size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( ( internal_data_chunk->write_io_handle->pack_flags & LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING ) != 0 )
+	 && ( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) == 0 ) )
+	{
+		padding_size = buffer_size % 16;
+
+		if( padding_size != 0 )
+		{
+			padding_size = 16 - padding_size;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_data_chunk->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_data_chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_data_initialize(
+	     &( internal_data_chunk->chunk_data ),
+	     internal_data_chunk->io_handle->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_data = internal_data_chunk->chunk_data;
+
+	if( ( padding_size > chunk_data->allocated_data_size )
+	 || ( buffer_size > ( chunk_data->allocated_data_size - padding_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value exceeds allocated data size.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     chunk_data->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy stored data.",
+		 function );
+
+		goto on_error;
+	}
+	if( padding_size > 0 )
+	{
+		if( memory_set(
+		     &( ( chunk_data->data )[ buffer_size ] ),
+		     0,
+		     padding_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear alignment padding.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	chunk_data->data_size    = buffer_size;
+	chunk_data->padding_size = padding_size;
+	chunk_data->range_flags  = LIBEWF_RANGE_FLAG_IS_PACKED;
+
+	if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+
+		if( ( chunk_data_flags & LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			chunk_data->range_flags |= LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+		}
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( ( chunk_data->data )[ data_size ] ),
+		 chunk_data->checksum );
+
+		chunk_data->range_flags |= LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	internal_data_chunk->data_size = data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( (ssize_t) buffer_size );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
@@ -80,6 +80,11 @@ int libewf_internal_data_chunk_set_chunk_data(
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
+int libewf_internal_data_chunk_detach_chunk_data(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_data_chunk_is_corrupted(
      libewf_data_chunk_t *data_chunk,
@@ -99,6 +104,29 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_get_stored_data_size(
+     libewf_data_chunk_t *data_chunk,
+     size_t *stored_data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_data_chunk_read_stored_buffer(
+         libewf_data_chunk_t *data_chunk,
+         void *buffer,
+         size_t buffer_size,
+         uint32_t *chunk_data_flags,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_data_chunk_write_stored_buffer(
+         libewf_data_chunk_t *data_chunk,
+         const void *buffer,
+         size_t buffer_size,
+         size_t data_size,
+         uint32_t chunk_data_flags,
+         libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
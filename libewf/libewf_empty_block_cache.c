@@ -0,0 +1,572 @@
+/*
+ * Empty block cache functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compression.h"
+#include "libewf_definitions.h"
+#include "libewf_empty_block_cache.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates an empty block cache
+ * Make sure the value empty_block_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_empty_block_cache_initialize(
+     libewf_empty_block_cache_t **empty_block_cache,
+     uint32_t chunk_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_empty_block_cache_initialize";
+
+	if( empty_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid empty block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *empty_block_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid empty block cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( (size_t) chunk_size > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*empty_block_cache = memory_allocate_structure(
+	                      libewf_empty_block_cache_t );
+
+	if( *empty_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create empty block cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *empty_block_cache,
+	     0,
+	     sizeof( libewf_empty_block_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear empty block cache.",
+		 function );
+
+		memory_free(
+		 *empty_block_cache );
+
+		*empty_block_cache = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *empty_block_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *empty_block_cache )->chunk_size         = chunk_size;
+	( *empty_block_cache )->compression_method = compression_method;
+	( *empty_block_cache )->compression_level  = compression_level;
+
+	return( 1 );
+
+on_error:
+	if( *empty_block_cache != NULL )
+	{
+		memory_free(
+		 *empty_block_cache );
+
+		*empty_block_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an empty block cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_empty_block_cache_free(
+     libewf_empty_block_cache_t **empty_block_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_empty_block_cache_free";
+	int fill_byte         = 0;
+	int result            = 1;
+
+	if( empty_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid empty block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *empty_block_cache != NULL )
+	{
+		for( fill_byte = 0;
+		     fill_byte < 256;
+		     fill_byte++ )
+		{
+			if( ( *empty_block_cache )->compressed_blocks[ fill_byte ] != NULL )
+			{
+				memory_free(
+				 ( *empty_block_cache )->compressed_blocks[ fill_byte ] );
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *empty_block_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *empty_block_cache );
+
+		*empty_block_cache = NULL;
+	}
+	return( result );
+}
+
+/* Compresses an empty block filled with a specific byte value
+ * Returns 1 if successful, 0 if the empty block could not be compressed or -1 on error
+ */
+int libewf_empty_block_cache_compress_block(
+     libewf_empty_block_cache_t *empty_block_cache,
+     uint8_t fill_byte,
+     uint8_t **compressed_block,
+     size_t *compressed_block_size,
+     libcerror_error_t **error )
+{
+	uint8_t *empty_block           = NULL;
+	uint8_t *safe_compressed_block = NULL;
+	static char *function          = "libewf_empty_block_cache_compress_block";
+	void *reallocation             = NULL;
+	size_t safe_compressed_size    = 0;
+	int result                     = 0;
+
+	if( empty_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid empty block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block size.",
+		 function );
+
+		return( -1 );
+	}
+	empty_block = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * (size_t) empty_block_cache->chunk_size );
+
+	if( empty_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create empty block.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     empty_block,
+	     (int) fill_byte,
+	     sizeof( uint8_t ) * (size_t) empty_block_cache->chunk_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set empty block.",
+		 function );
+
+		goto on_error;
+	}
+	safe_compressed_size = 1024;
+
+	safe_compressed_block = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * safe_compressed_size );
+
+	if( safe_compressed_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed block.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_compress_data(
+	          safe_compressed_block,
+	          &safe_compressed_size,
+	          empty_block_cache->compression_method,
+	          empty_block_cache->compression_level,
+	          empty_block,
+	          (size_t) empty_block_cache->chunk_size,
+	          error );
+
+	/* Check if the compressed buffer was too small
+	 * and a new compressed data size buffer was passed back
+	 */
+	if( ( result == 0 )
+	 && ( safe_compressed_size > 1024 ) )
+	{
+#if !defined( HAVE_COMPRESS_BOUND ) && !defined( WINAPI )
+		/* The some version of zlib require a fairly large buffer
+		 * if compressBound() was not used but the factor 2 use the chunk size instead
+		 * in a worst case scenario the resulting chunk data is + 16 larger than the chunk size
+		 */
+		safe_compressed_size = (size_t) empty_block_cache->chunk_size + 16;
+#endif
+		reallocation = memory_reallocate(
+		                safe_compressed_block,
+		                sizeof( uint8_t ) * safe_compressed_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize compressed block.",
+			 function );
+
+			goto on_error;
+		}
+		safe_compressed_block = (uint8_t *) reallocation;
+
+		result = libewf_compress_data(
+		          safe_compressed_block,
+		          &safe_compressed_size,
+		          empty_block_cache->compression_method,
+		          empty_block_cache->compression_level,
+		          empty_block,
+		          (size_t) empty_block_cache->chunk_size,
+		          error );
+	}
+	memory_free(
+	 empty_block );
+
+	empty_block = NULL;
+
+	/* The compressed block must at least contain the checksum
+	 */
+	if( ( result != 1 )
+	 || ( safe_compressed_size < 4 ) )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_free(
+			 error );
+		}
+		memory_free(
+		 safe_compressed_block );
+
+		return( 0 );
+	}
+	*compressed_block      = safe_compressed_block;
+	*compressed_block_size = safe_compressed_size;
+
+	return( 1 );
+
+on_error:
+	if( safe_compressed_block != NULL )
+	{
+		memory_free(
+		 safe_compressed_block );
+	}
+	if( empty_block != NULL )
+	{
+		memory_free(
+		 empty_block );
+	}
+	return( -1 );
+}
+
+/* Retrieves the compressed empty block of a specific fill byte
+ * The compressed empty block is created on first use and is kept until the cache is freed
+ * Returns 1 if successful, 0 if no compressed empty block is available or -1 on error
+ */
+int libewf_empty_block_cache_get_compressed_block(
+     libewf_empty_block_cache_t *empty_block_cache,
+     uint32_t chunk_size,
+     uint8_t fill_byte,
+     const uint8_t **compressed_block,
+     size_t *compressed_block_size,
+     libcerror_error_t **error )
+{
+	uint8_t *new_compressed_block = NULL;
+	static char *function         = "libewf_empty_block_cache_get_compressed_block";
+	size_t new_compressed_size    = 0;
+	int result                    = 0;
+
+	if( empty_block_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid empty block cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed block size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The compressed empty blocks are only valid for the chunk size of the cache
+	 */
+	if( chunk_size != empty_block_cache->chunk_size )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     empty_block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( empty_block_cache->compressed_blocks[ fill_byte ] != NULL )
+	{
+		*compressed_block      = empty_block_cache->compressed_blocks[ fill_byte ];
+		*compressed_block_size = empty_block_cache->compressed_block_sizes[ fill_byte ];
+
+		result = 1;
+	}
+	else if( empty_block_cache->compression_failed[ fill_byte ] != 0 )
+	{
+		result = 0;
+	}
+	else
+	{
+		result = -2;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     empty_block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result != -2 )
+	{
+		return( result );
+	}
+	/* Compress the empty block without holding the mutex so that other
+	 * fill bytes can be looked up while the compression is in progress
+	 */
+	result = libewf_empty_block_cache_compress_block(
+	          empty_block_cache,
+	          fill_byte,
+	          &new_compressed_block,
+	          &new_compressed_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress empty block of fill byte: 0x%02" PRIx8 ".",
+		 function,
+		 fill_byte );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     empty_block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( result == 0 )
+	{
+		empty_block_cache->compression_failed[ fill_byte ] = 1;
+	}
+	else
+	{
+		/* Another thread could have stored the compressed empty block in the meantime
+		 */
+		if( empty_block_cache->compressed_blocks[ fill_byte ] == NULL )
+		{
+			empty_block_cache->compressed_blocks[ fill_byte ]      = new_compressed_block;
+			empty_block_cache->compressed_block_sizes[ fill_byte ] = new_compressed_size;
+
+			new_compressed_block = NULL;
+		}
+		*compressed_block      = empty_block_cache->compressed_blocks[ fill_byte ];
+		*compressed_block_size = empty_block_cache->compressed_block_sizes[ fill_byte ];
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     empty_block_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( new_compressed_block != NULL )
+	{
+		memory_free(
+		 new_compressed_block );
+	}
+	return( result );
+
+on_error:
+	if( new_compressed_block != NULL )
+	{
+		memory_free(
+		 new_compressed_block );
+	}
+	return( -1 );
+}
+
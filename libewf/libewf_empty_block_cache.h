@@ -0,0 +1,101 @@
+/*
+ * Empty block cache functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_EMPTY_BLOCK_CACHE_H )
+#define _LIBEWF_EMPTY_BLOCK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_empty_block_cache libewf_empty_block_cache_t;
+
+struct libewf_empty_block_cache
+{
+	/* The chunk size
+	 */
+	uint32_t chunk_size;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The compressed empty blocks per fill byte
+	 */
+	uint8_t *compressed_blocks[ 256 ];
+
+	/* The compressed empty block sizes per fill byte
+	 */
+	size_t compressed_block_sizes[ 256 ];
+
+	/* Value to indicate the empty block of a fill byte cannot be compressed
+	 */
+	uint8_t compression_failed[ 256 ];
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_empty_block_cache_initialize(
+     libewf_empty_block_cache_t **empty_block_cache,
+     uint32_t chunk_size,
+     uint16_t compression_method,
+     int8_t compression_level,
+     libcerror_error_t **error );
+
+int libewf_empty_block_cache_free(
+     libewf_empty_block_cache_t **empty_block_cache,
+     libcerror_error_t **error );
+
+int libewf_empty_block_cache_compress_block(
+     libewf_empty_block_cache_t *empty_block_cache,
+     uint8_t fill_byte,
+     uint8_t **compressed_block,
+     size_t *compressed_block_size,
+     libcerror_error_t **error );
+
+int libewf_empty_block_cache_get_compressed_block(
+     libewf_empty_block_cache_t *empty_block_cache,
+     uint32_t chunk_size,
+     uint8_t fill_byte,
+     const uint8_t **compressed_block,
+     size_t *compressed_block_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_EMPTY_BLOCK_CACHE_H ) */
+
@@ -29,7 +29,9 @@
 #include "libewf_case_data.h"
 #include "libewf_case_data_section.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_reorder_window.h"
 #include "libewf_chunk_table.h"
+#include "libewf_chunk_verifier.h"
 #include "libewf_codepage.h"
 #include "libewf_compression.h"
 #include "libewf_data_chunk.h"
@@ -223,6 +225,20 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
+	if( libewf_chunk_reorder_window_initialize(
+	     &( internal_handle->chunk_reorder_window ),
+	     LIBEWF_DEFAULT_CHUNK_REORDER_WINDOW_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk reorder window.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_initialize(
 	     &( internal_handle->read_write_lock ),
@@ -248,6 +264,18 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+		if( internal_handle->chunk_reorder_window != NULL )
+		{
+			libewf_chunk_reorder_window_free(
+			 &( internal_handle->chunk_reorder_window ),
+			 NULL );
+		}
+		if( internal_handle->segment_table != NULL )
+		{
+			libewf_segment_table_free(
+			 &( internal_handle->segment_table ),
+			 NULL );
+		}
 		if( internal_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -346,6 +374,19 @@ int libewf_handle_free(
 			result = -1;
 		}
 #endif
+		if( libewf_chunk_reorder_window_free(
+		     &( internal_handle->chunk_reorder_window ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk reorder window.",
+			 function );
+
+			result = -1;
+		}
 		if( libewf_segment_table_free(
 		     &( internal_handle->segment_table ),
 		     error ) != 1 )
@@ -4145,6 +4186,19 @@ int libewf_handle_close(
 			result = -1;
 		}
 	}
+	if( libewf_chunk_reorder_window_empty(
+	     internal_handle->chunk_reorder_window,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty chunk reorder window.",
+		 function );
+
+		result = -1;
+	}
 	if( internal_handle->chunk_table != NULL )
 	{
 		if( libewf_chunk_table_free(
@@ -5002,6 +5056,7 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
 			     internal_handle->io_handle,
 			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
 			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     internal_handle->write_io_handle->empty_block_cache,
 			     internal_handle->write_io_handle->pack_flags,
 			     error ) != 1 )
 			{
@@ -5678,18 +5733,18 @@ ssize_t libewf_handle_read_data_chunk(
 	return( read_count );
 }
 
-/* Writes a (media) data chunk at the current offset
+/* Writes (packed) chunk data at the current offset
  * This function is not multi-thread safe acquire write lock before call
  * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
-ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         libewf_internal_data_chunk_t *internal_data_chunk,
+         libewf_chunk_data_t *chunk_data,
+         size_t data_size,
          libcerror_error_t **error )
 {
-	static char *function        = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
-	size_t data_size             = 0;
+	static char *function        = "libewf_internal_handle_write_chunk_data_to_file_io_pool";
 	ssize_t write_count          = 0;
 	uint64_t current_chunk_index = 0;
 
@@ -5770,13 +5825,13 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_data_chunk == NULL )
+	if( chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid data chunk.",
+		 "%s: invalid chunk data.",
 		 function );
 
 		return( -1 );
@@ -5786,8 +5841,6 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 	{
 		return( 0 );
 	}
-	data_size = internal_data_chunk->data_size;
-
 	if( internal_handle->media_values->media_size != 0 )
 	{
 		if( (size64_t) ( internal_handle->current_offset + data_size ) > internal_handle->media_values->media_size )
@@ -5842,7 +5895,7 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 	               internal_handle->tracks,
 	               internal_handle->acquiry_errors,
 	               current_chunk_index,
-	               internal_data_chunk->chunk_data,
+	               chunk_data,
 	               data_size,
 	               error );
 
@@ -5862,6 +5915,51 @@ ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
 	return( write_count );
 }
 
+/* Writes a (media) data chunk at the current offset
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_write_data_chunk_to_file_io_pool";
+	ssize_t write_count   = 0;
+
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libewf_internal_handle_write_chunk_data_to_file_io_pool(
+	               internal_handle,
+	               file_io_pool,
+	               internal_data_chunk->chunk_data,
+	               internal_data_chunk->data_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
 /* Writes a (media) data chunk at the current offset
  * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
@@ -5948,24 +6046,18 @@ ssize_t libewf_handle_write_data_chunk(
 	return( write_count );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Writes (packed) chunk data of a specific chunk
+ * Returns the number of bytes written, 0 when no longer data can be written or -1 on error
  */
-ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+ssize_t libewf_internal_handle_write_chunk_data_at_index(
          libewf_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
+         libewf_chunk_data_t *chunk_data,
+         size_t data_size,
+         uint64_t chunk_index,
          libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
-	size64_t segment_file_size          = 0;
-	size_t input_data_size              = 0;
-	ssize_t write_count                 = 0;
-	ssize_t write_finalize_count        = 0;
-	uint64_t chunk_index                = 0;
-	uint32_t number_of_segments         = 0;
-	int file_io_pool_entry              = -1;
+	static char *function = "libewf_internal_handle_write_chunk_data_at_index";
+	ssize_t write_count   = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -5978,50 +6070,119 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+#endif
+	internal_handle->current_offset = (off64_t) chunk_index * (off64_t) internal_handle->media_values->chunk_size;
+
+	write_count = libewf_internal_handle_write_chunk_data_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->file_io_pool,
+	               chunk_data,
+	               data_size,
+	               error );
+
+	if( write_count < 0 )
 	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
 
-			return( -1 );
-		}
+		write_count = -1;
 	}
-	if( internal_handle->write_io_handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes a (media) data chunk of a specific chunk
+ * The chunks can be written in any order and from multiple threads, chunks that
+ * cannot be written yet are kept in the chunk reorder window until all preceding
+ * chunks have been written. If the chunk lies beyond the end of the window this
+ * function blocks until the preceding chunks have been written.
+ * If the chunk is kept in the window the data chunk no longer contains the chunk data
+ * and can be reused to write the next chunk
+ * Mixing this function with libewf_handle_write_buffer or libewf_handle_write_data_chunk
+ * is not supported
+ * Returns the number of bytes written or kept, 0 when no longer data can be written or -1 on error
+ */
+ssize_t libewf_handle_write_data_chunk_at_index(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         uint64_t chunk_index,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data                   = NULL;
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	libewf_internal_handle_t *internal_handle         = NULL;
+	static char *function                             = "libewf_handle_write_data_chunk_at_index";
+	size_t data_size                                  = 0;
+	ssize_t chunk_write_count                         = 0;
+	ssize_t write_count                               = 0;
+	uint64_t maximum_chunk_index                      = 0;
+	uint64_t write_chunk_index                        = 0;
+	int result                                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
@@ -6037,51 +6198,530 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: invalid handle - missing write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
+	if( data_chunk == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->media_values->chunk_size != 0 )
+	 && ( internal_handle->media_values->media_size != 0 ) )
+	{
+		maximum_chunk_index = ( internal_handle->media_values->media_size + internal_handle->media_values->chunk_size - 1 ) / internal_handle->media_values->chunk_size;
+	}
+	if( ( maximum_chunk_index != 0 )
+	 && ( chunk_index >= maximum_chunk_index ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk index value out of bounds.",
+		 function );
 
-			return( -1 );
-		}
-		input_data_size = internal_handle->chunk_data->data_size;
+		result = -1;
+	}
+	else
+	{
+		/* The handle is locked for writing while the window is activated
+		 * so that no chunk is written before the first chunk index is determined
+		 */
+		result = libewf_chunk_reorder_window_activate(
+		          internal_handle->chunk_reorder_window,
+		          internal_handle->write_io_handle->number_of_chunks_written,
+		          error );
 
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->io_handle,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
-		     error ) != 1 )
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to activate chunk reorder window.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	chunk_data = internal_data_chunk->chunk_data;
+	data_size  = internal_data_chunk->data_size;
+
+	result = libewf_chunk_reorder_window_push(
+	          internal_handle->chunk_reorder_window,
+	          chunk_index,
+	          chunk_data,
+	          data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto reorder window.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		/* The chunk reorder window has taken over management of the chunk data
+		 */
+		if( libewf_internal_data_chunk_detach_chunk_data(
+		     internal_data_chunk,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to detach chunk data from data chunk.",
+			 function );
+
+			return( -1 );
+		}
+		return( (ssize_t) data_size );
+	}
+	/* The chunk is the next chunk to be written, write it and
+	 * any directly following chunks that are kept in the window
+	 */
+	write_chunk_index = chunk_index;
+
+	while( result == 1 )
+	{
+		chunk_write_count = libewf_internal_handle_write_chunk_data_at_index(
+		                     internal_handle,
+		                     chunk_data,
+		                     data_size,
+		                     write_chunk_index,
+		                     error );
+
+		if( chunk_data != internal_data_chunk->chunk_data )
+		{
+			if( libewf_chunk_data_free(
+			     &chunk_data,
+			     NULL ) != 1 )
+			{
+				chunk_write_count = -1;
+			}
+		}
+		if( write_chunk_index == chunk_index )
+		{
+			write_count = chunk_write_count;
+		}
+		chunk_data = NULL;
+
+		result = libewf_chunk_reorder_window_pop(
+		          internal_handle->chunk_reorder_window,
+		          (uint8_t) ( chunk_write_count < 0 ),
+		          &write_chunk_index,
+		          &chunk_data,
+		          &data_size,
+		          error );
+
+		if( chunk_write_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 write_chunk_index );
+
+			return( -1 );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop chunk from reorder window.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( write_count );
+}
+
+/* Retrieves the chunk reorder window size
+ * The chunk reorder window size is the maximum number of chunks that are kept
+ * by libewf_handle_write_data_chunk_at_index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_chunk_reorder_window_size(
+     libewf_handle_t *handle,
+     int *number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_reorder_window_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libewf_chunk_reorder_window_get_maximum_number_of_entries(
+	     internal_handle->chunk_reorder_window,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve maximum number of entries from chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the chunk reorder window size
+ * The chunk reorder window size cannot be changed after libewf_handle_write_data_chunk_at_index was used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_chunk_reorder_window_size(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_chunk_reorder_window_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libewf_chunk_reorder_window_set_maximum_number_of_entries(
+	     internal_handle->chunk_reorder_window,
+	     number_of_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set maximum number of entries in chunk reorder window.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the progress callback
+ * The progress callback is called by write finalize after every segment file that has been corrected
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_progress_callback(
+     libewf_handle_t *handle,
+     int (*progress_callback)(
+            void *user_data,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *user_data,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_progress_callback";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->progress_callback           = progress_callback;
+	internal_handle->progress_callback_user_data = user_data;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize_file_io_pool";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	int file_io_pool_entry              = -1;
+	int number_of_pending_chunks        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_chunk_reorder_window_get_number_of_entries(
+	     internal_handle->chunk_reorder_window,
+	     &number_of_pending_chunks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_pending_chunks > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: unable to finalize write - %d chunks are waiting for preceding chunks.",
+		 function,
+		 number_of_pending_chunks );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->io_handle,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->empty_block_cache,
+		     internal_handle->write_io_handle->pack_flags,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -6202,6 +6842,7 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 		               internal_handle->media_values,
 		               internal_handle->header_values,
 		               internal_handle->write_io_handle->timestamp,
+		               internal_handle->write_io_handle->section_corrections,
 		               error );
 
 		if( write_count == -1 )
@@ -6345,6 +6986,7 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 		 */
 		if( libewf_write_io_handle_finalize_write_sections_corrections(
 		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
 		     file_io_pool,
 		     internal_handle->media_values,
 		     internal_handle->segment_table,
@@ -6354,6 +6996,8 @@ ssize_t libewf_internal_handle_write_finalize_file_io_pool(
 		     internal_handle->sessions,
 		     internal_handle->tracks,
 		     internal_handle->acquiry_errors,
+		     internal_handle->progress_callback,
+		     internal_handle->progress_callback_user_data,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -7372,14 +8016,219 @@ int libewf_handle_set_segment_filename_wide(
 	          filename_length,
 	          error );
 
-	if( result != 1 )
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment table basename.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Retrieves the maximum segment file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_maximum_segment_size(
+     libewf_handle_t *handle,
+     size64_t *maximum_segment_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_maximum_segment_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_segment_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum segment size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum segment file size
+ * A maximum segment file size of 0 represents the maximum possible size for the format
+ * If the maximum segment file size is smaller than the size needed to store a single chunk
+ * the size off the latter is enforced and not the maximum segment file size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_segment_size(
+     libewf_handle_t *handle,
+     size64_t maximum_segment_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_segment_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_segment_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum segment size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: maximum segment size cannot be changed.",
+		 function );
+
+		result = -1;
+	}
+	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set segment table basename.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment file size value out of bounds.",
 		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -7399,18 +8248,16 @@ int libewf_handle_set_segment_filename_wide(
 	return( result );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Retrieves the maximum segment file size
+/* Retrieves the write flags
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_maximum_segment_size(
+int libewf_handle_get_write_flags(
      libewf_handle_t *handle,
-     size64_t *maximum_segment_size,
+     uint8_t *write_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_maximum_segment_size";
+	static char *function                     = "libewf_handle_get_write_flags";
 
 	if( handle == NULL )
 	{
@@ -7425,24 +8272,24 @@ int libewf_handle_get_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->segment_table == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( maximum_segment_size == NULL )
+	if( write_flags == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid maximum segment size.",
+		 "%s: invalid write flags.",
 		 function );
 
 		return( -1 );
@@ -7462,7 +8309,7 @@ int libewf_handle_get_maximum_segment_size(
 		return( -1 );
 	}
 #endif
-	*maximum_segment_size = internal_handle->segment_table->maximum_segment_size;
+	*write_flags = internal_handle->io_handle->write_flags;
 
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -7482,19 +8329,19 @@ int libewf_handle_get_maximum_segment_size(
 	return( 1 );
 }
 
-/* Sets the maximum segment file size
- * A maximum segment file size of 0 represents the maximum possible size for the format
- * If the maximum segment file size is smaller than the size needed to store a single chunk
- * the size off the latter is enforced and not the maximum segment file size
+/* Sets the write flags
+ * The write flags control how segment files are created, e.g. preallocation and direct IO
+ * Flags that are not supported by the platform are ignored
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_segment_size(
+int libewf_handle_set_write_flags(
      libewf_handle_t *handle,
-     size64_t maximum_segment_size,
+     uint8_t write_flags,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_segment_size";
+	static char *function                     = "libewf_handle_set_write_flags";
+	uint8_t supported_flags                   = 0;
 	int result                                = 1;
 
 	if( handle == NULL )
@@ -7510,36 +8357,29 @@ int libewf_handle_set_maximum_segment_size(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->segment_table == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing segment table.",
-		 function );
+	supported_flags = LIBEWF_WRITE_FLAG_PREALLOCATE
+	                | LIBEWF_WRITE_FLAG_USE_DIRECT_IO;
 
-		return( -1 );
-	}
-	if( maximum_segment_size > (size64_t) INT64_MAX )
+	if( ( write_flags & ~( supported_flags ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid maximum segment size value exceeds maximum.",
-		 function );
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported write flags: 0x%02" PRIx8 ".",
+		 function,
+		 write_flags );
 
 		return( -1 );
 	}
@@ -7566,25 +8406,14 @@ int libewf_handle_set_maximum_segment_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: maximum segment size cannot be changed.",
-		 function );
-
-		result = -1;
-	}
-	else if( maximum_segment_size > internal_handle->write_io_handle->maximum_segment_file_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid segment file size value out of bounds.",
+		 "%s: write flags cannot be changed.",
 		 function );
 
 		result = -1;
 	}
 	else
 	{
-		internal_handle->segment_table->maximum_segment_size = maximum_segment_size;
+		internal_handle->io_handle->write_flags = write_flags;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -11226,18 +12055,226 @@ int libewf_handle_set_format(
 		internal_handle->write_io_handle->maximum_segment_file_size  = INT64_MAX;
 		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
 	}
-	else if( format == LIBEWF_FORMAT_EWFX )
+	else if( format == LIBEWF_FORMAT_EWFX )
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+	}
+	else
+	{
+		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
+		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the segment file version
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_segment_file_version(
+     libewf_handle_t *handle,
+     uint8_t *major_version,
+     uint8_t *minor_version,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_file_version";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( major_version == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid major version.",
+		 function );
+
+		return( -1 );
+	}
+	if( minor_version == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid minor version.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*major_version = internal_handle->io_handle->major_version;
+	*minor_version = internal_handle->io_handle->minor_version;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the segment file set identifier
+ * The identifier is a GUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_segment_file_set_identifier(
+     libewf_handle_t *handle,
+     uint8_t *set_identifier,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_segment_file_set_identifier";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( set_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: set identifier too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
-	else
+#endif
+	if( memory_copy(
+	     set_identifier,
+	     internal_handle->media_values->set_identifier,
+	     16 ) == NULL )
 	{
-		internal_handle->write_io_handle->maximum_segment_file_size  = INT32_MAX;
-		internal_handle->write_io_handle->maximum_chunks_per_section = LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set set identifier.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11245,7 +12282,7 @@ int libewf_handle_set_format(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -11255,24 +12292,25 @@ int libewf_handle_set_format(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the segment file version
+/* Sets the segment file set identifier
+ * The identifier is a GUID and is 16 bytes of size
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_segment_file_version(
+int libewf_handle_set_segment_file_set_identifier(
      libewf_handle_t *handle,
-     uint8_t *major_version,
-     uint8_t *minor_version,
+     const uint8_t *set_identifier,
+     size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_file_version";
+	static char *function                     = "libewf_handle_set_segment_file_set_identifier";
 
 	if( handle == NULL )
 	{
@@ -11287,41 +12325,41 @@ int libewf_handle_get_segment_file_version(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( major_version == NULL )
+	if( set_identifier == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid major version.",
+		 "%s: invalid set identifier.",
 		 function );
 
 		return( -1 );
 	}
-	if( minor_version == NULL )
+	if( size < 16 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid minor version.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: set identifier too small.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11329,17 +12367,41 @@ int libewf_handle_get_segment_file_version(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*major_version = internal_handle->io_handle->major_version;
-	*minor_version = internal_handle->io_handle->minor_version;
+	if( ( internal_handle->read_io_handle != NULL )
+	 || ( internal_handle->write_io_handle == NULL )
+	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: set identifier cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     internal_handle->media_values->set_identifier,
+	     set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set indentifier.",
+		 function );
 
+		goto on_error;
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11347,27 +12409,35 @@ int libewf_handle_get_segment_file_version(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the segment file set identifier
- * The identifier is a GUID and is 16 bytes of size
- * Returns 1 if successful or -1 on error
+/* Retrieves the MD5 hash
+ * Returns 1 if successful, 0 if not set or -1 on error
  */
-int libewf_handle_get_segment_file_set_identifier(
+int libewf_handle_get_md5_hash(
      libewf_handle_t *handle,
-     uint8_t *set_identifier,
+     uint8_t *md5_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_segment_file_set_identifier";
+	static char *function                     = "libewf_handle_get_md5_hash";
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -11382,24 +12452,24 @@ int libewf_handle_get_segment_file_set_identifier(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( set_identifier == NULL )
+	if( md5_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid set identifier.",
+		 "%s: invalid MD5 hash.",
 		 function );
 
 		return( -1 );
@@ -11410,13 +12480,13 @@ int libewf_handle_get_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: set identifier too small.",
+		 "%s: MD5 hash too small.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11424,28 +12494,70 @@ int libewf_handle_get_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( memory_copy(
-	     set_identifier,
-	     internal_handle->media_values->set_identifier,
-	     16 ) == NULL )
+	if( ( internal_handle->hash_sections->md5_hash_set == 0 )
+	 && ( internal_handle->hash_values != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set set identifier.",
-		 function );
+		if( libewf_hash_values_generate_md5_hash(
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections->md5_hash,
+		     16,
+		     &( internal_handle->hash_sections->md5_hash_set ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to parse MD5 hash value for its value.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+	}
+	if( internal_handle->hash_sections->md5_digest_set != 0 )
+	{
+		if( memory_copy(
+		     md5_hash,
+		     internal_handle->hash_sections->md5_digest,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 digest.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+	}
+	else if( internal_handle->hash_sections->md5_hash_set != 0 )
+	{
+		if( memory_copy(
+		     md5_hash,
+		     internal_handle->hash_sections->md5_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy MD5 hash.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11453,35 +12565,34 @@ int libewf_handle_get_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Sets the segment file set identifier
- * The identifier is a GUID and is 16 bytes of size
+/* Sets the MD5 hash
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_segment_file_set_identifier(
+int libewf_handle_set_md5_hash(
      libewf_handle_t *handle,
-     const uint8_t *set_identifier,
+     const uint8_t *md5_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_segment_file_set_identifier";
+	static char *function                     = "libewf_handle_set_md5_hash";
 
 	if( handle == NULL )
 	{
@@ -11496,24 +12607,24 @@ int libewf_handle_set_segment_file_set_identifier(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->hash_sections == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing hash sections.",
 		 function );
 
 		return( -1 );
 	}
-	if( set_identifier == NULL )
+	if( md5_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid set identifier.",
+		 "%s: invalid MD5 hash.",
 		 function );
 
 		return( -1 );
@@ -11524,7 +12635,7 @@ int libewf_handle_set_segment_file_set_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: set identifier too small.",
+		 "%s: MD5 hash too small.",
 		 function );
 
 		return( -1 );
@@ -11545,28 +12656,78 @@ int libewf_handle_set_segment_file_set_identifier(
 	}
 #endif
 	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->write_io_handle == NULL )
-	 || ( internal_handle->write_io_handle->values_initialized != 0 ) )
+	 || ( internal_handle->hash_sections->md5_hash_set != 0 )
+	 || ( internal_handle->hash_sections->md5_digest_set != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: MD5 hash cannot be changed.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle->hash_values == NULL )
+	{
+		if( libewf_hash_values_initialize(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash values.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->hash_values_parsed = 1;
+	}
+	if( memory_copy(
+	     internal_handle->hash_sections->md5_hash,
+	     md5_hash,
+	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: set identifier cannot be changed.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to set MD5 hash.",
 		 function );
 
 		goto on_error;
 	}
+	internal_handle->hash_sections->md5_hash_set = 1;
+
 	if( memory_copy(
-	     internal_handle->media_values->set_identifier,
-	     set_identifier,
+	     internal_handle->hash_sections->md5_digest,
+	     md5_hash,
 	     16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy set indentifier.",
+		 "%s: unable to set MD5 hash.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->hash_sections->md5_digest_set = 1;
+
+	if( libewf_hash_values_parse_md5_hash(
+	     internal_handle->hash_values,
+	     md5_hash,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to parse MD5 hash for its value.",
 		 function );
 
 		goto on_error;
@@ -11597,17 +12758,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the MD5 hash
+/* Retrieves the SHA1 hash
  * Returns 1 if successful, 0 if not set or -1 on error
  */
-int libewf_handle_get_md5_hash(
+int libewf_handle_get_sha1_hash(
      libewf_handle_t *handle,
-     uint8_t *md5_hash,
+     uint8_t *sha1_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_md5_hash";
+	static char *function                     = "libewf_handle_get_sha1_hash";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -11634,24 +12795,24 @@ int libewf_handle_get_md5_hash(
 
 		return( -1 );
 	}
-	if( md5_hash == NULL )
+	if( sha1_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MD5 hash.",
+		 "%s: invalid SHA1 hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( size < 20 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: MD5 hash too small.",
+		 "%s: SHA1 hash too small.",
 		 function );
 
 		return( -1 );
@@ -11671,14 +12832,14 @@ int libewf_handle_get_md5_hash(
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->hash_sections->md5_hash_set == 0 )
+	if( ( internal_handle->hash_sections->sha1_digest_set == 0 )
 	 && ( internal_handle->hash_values != NULL ) )
 	{
-		if( libewf_hash_values_generate_md5_hash(
+		if( libewf_hash_values_generate_sha1_hash(
 		     internal_handle->hash_values,
-		     internal_handle->hash_sections->md5_hash,
-		     16,
-		     &( internal_handle->hash_sections->md5_hash_set ),
+		     internal_handle->hash_sections->sha1_digest,
+		     20,
+		     &( internal_handle->hash_sections->sha1_digest_set ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -11691,36 +12852,36 @@ int libewf_handle_get_md5_hash(
 			goto on_error;
 		}
 	}
-	if( internal_handle->hash_sections->md5_digest_set != 0 )
+	if( internal_handle->hash_sections->sha1_digest_set != 0 )
 	{
 		if( memory_copy(
-		     md5_hash,
-		     internal_handle->hash_sections->md5_digest,
-		     16 ) == NULL )
+		     sha1_hash,
+		     internal_handle->hash_sections->sha1_digest,
+		     20 ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy MD5 digest.",
+			 "%s: unable to copy SHA1 digest.",
 			 function );
 
 			goto on_error;
 		}
 		result = 1;
 	}
-	else if( internal_handle->hash_sections->md5_hash_set != 0 )
+	else if( internal_handle->hash_sections->sha1_hash_set != 0 )
 	{
 		if( memory_copy(
-		     md5_hash,
-		     internal_handle->hash_sections->md5_hash,
-		     16 ) == NULL )
+		     sha1_hash,
+		     internal_handle->hash_sections->sha1_hash,
+		     20 ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_MEMORY,
 			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy MD5 hash.",
+			 "%s: unable to copy SHA1 hash.",
 			 function );
 
 			goto on_error;
@@ -11753,17 +12914,17 @@ on_error:
 	return( -1 );
 }
 
-/* Sets the MD5 hash
+/* Sets the SHA1 hash
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_md5_hash(
+int libewf_handle_set_sha1_hash(
      libewf_handle_t *handle,
-     const uint8_t *md5_hash,
+     const uint8_t *sha1_hash,
      size_t size,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_md5_hash";
+	static char *function                     = "libewf_handle_set_sha1_hash";
 
 	if( handle == NULL )
 	{
@@ -11789,24 +12950,24 @@ int libewf_handle_set_md5_hash(
 
 		return( -1 );
 	}
-	if( md5_hash == NULL )
+	if( sha1_hash == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid MD5 hash.",
+		 "%s: invalid SHA1 hash.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 16 )
+	if( size < 20 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: MD5 hash too small.",
+		 "%s: SHA1 hash too small.",
 		 function );
 
 		return( -1 );
@@ -11827,14 +12988,14 @@ int libewf_handle_set_md5_hash(
 	}
 #endif
 	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->hash_sections->md5_hash_set != 0 )
-	 || ( internal_handle->hash_sections->md5_digest_set != 0 ) )
+	 || ( internal_handle->hash_sections->sha1_hash_set != 0 )
+	 || ( internal_handle->hash_sections->sha1_digest_set != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: MD5 hash cannot be changed.",
+		 "%s: SHA1 hash cannot be changed.",
 		 function );
 
 		goto on_error;
@@ -11857,48 +13018,48 @@ int libewf_handle_set_md5_hash(
 		internal_handle->hash_values_parsed = 1;
 	}
 	if( memory_copy(
-	     internal_handle->hash_sections->md5_hash,
-	     md5_hash,
-	     16 ) == NULL )
+	     internal_handle->hash_sections->sha1_hash,
+	     sha1_hash,
+	     20 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set MD5 hash.",
+		 "%s: unable to set SHA1 hash.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->hash_sections->md5_hash_set = 1;
+	internal_handle->hash_sections->sha1_hash_set = 1;
 
 	if( memory_copy(
-	     internal_handle->hash_sections->md5_digest,
-	     md5_hash,
-	     16 ) == NULL )
+	     internal_handle->hash_sections->sha1_digest,
+	     sha1_hash,
+	     20 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set MD5 hash.",
+		 "%s: unable to set SHA1 hash.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->hash_sections->md5_digest_set = 1;
+	internal_handle->hash_sections->sha1_digest_set = 1;
 
-	if( libewf_hash_values_parse_md5_hash(
+	if( libewf_hash_values_parse_sha1_hash(
 	     internal_handle->hash_values,
-	     md5_hash,
-	     16,
+	     sha1_hash,
+	     20,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to parse MD5 hash for its value.",
+		 "%s: unable to parse SHA1 hash for its value.",
 		 function );
 
 		goto on_error;
@@ -11929,18 +13090,17 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the SHA1 hash
- * Returns 1 if successful, 0 if not set or -1 on error
+/* Sets the read zero chunk on error
+ * The chunk is not zeroed if read raw is used
+ * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_sha1_hash(
+int libewf_handle_set_read_zero_chunk_on_error(
      libewf_handle_t *handle,
-     uint8_t *sha1_hash,
-     size_t size,
+     uint8_t zero_on_error,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_sha1_hash";
-	int result                                = 0;
+	static char *function                     = "libewf_handle_set_read_zero_chunk_on_error";
 
 	if( handle == NULL )
 	{
@@ -11955,41 +13115,36 @@ int libewf_handle_get_sha1_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( sha1_hash == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid SHA1 hash.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( size < 20 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: SHA1 hash too small.",
-		 function );
+#endif
+	internal_handle->io_handle->zero_on_error = zero_on_error;
 
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -11997,105 +13152,102 @@ int libewf_handle_get_sha1_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->hash_sections->sha1_digest_set == 0 )
-	 && ( internal_handle->hash_values != NULL ) )
+	return( 1 );
+}
+
+/* Copies the media values from the source to the destination handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_copy_media_values(
+     libewf_handle_t *destination_handle,
+     libewf_handle_t *source_handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_destination_handle = NULL;
+	libewf_internal_handle_t *internal_source_handle      = NULL;
+	static char *function                                 = "libewf_handle_copy_media_values";
+
+	if( destination_handle == NULL )
 	{
-		if( libewf_hash_values_generate_sha1_hash(
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections->sha1_digest,
-		     20,
-		     &( internal_handle->hash_sections->sha1_digest_set ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to parse MD5 hash value for its value.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination handle.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	if( internal_handle->hash_sections->sha1_digest_set != 0 )
+	if( source_handle == NULL )
 	{
-		if( memory_copy(
-		     sha1_hash,
-		     internal_handle->hash_sections->sha1_digest,
-		     20 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy SHA1 digest.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source handle.",
+		 function );
 
-			goto on_error;
-		}
-		result = 1;
+		return( -1 );
 	}
-	else if( internal_handle->hash_sections->sha1_hash_set != 0 )
+	internal_destination_handle = (libewf_internal_handle_t *) destination_handle;
+	internal_source_handle      = (libewf_internal_handle_t *) source_handle;
+
+	if( internal_source_handle->media_values == NULL )
 	{
-		if( memory_copy(
-		     sha1_hash,
-		     internal_handle->hash_sections->sha1_hash,
-		     20 ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy SHA1 hash.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid source handle - missing media values.",
+		 function );
 
-			goto on_error;
-		}
-		result = 1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_destination_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid destination handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+	if( memory_copy(
+	     internal_destination_handle->media_values,
+	     internal_source_handle->media_values,
+	     sizeof( libewf_media_values_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy media values.",
+		 function );
 
-on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+		return( -1 );
+	}
+	return( 1 );
 }
 
-/* Sets the SHA1 hash
+/* Retrieves the number of acquiry errors
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_sha1_hash(
+int libewf_handle_get_number_of_acquiry_errors(
      libewf_handle_t *handle,
-     const uint8_t *sha1_hash,
-     size_t size,
+     uint32_t *number_of_errors,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_sha1_hash";
+	static char *function                     = "libewf_handle_get_number_of_acquiry_errors";
+	int number_of_elements                    = 0;
 
 	if( handle == NULL )
 	{
@@ -12110,41 +13262,19 @@ int libewf_handle_set_sha1_hash(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->hash_sections == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing hash sections.",
-		 function );
-
-		return( -1 );
-	}
-	if( sha1_hash == NULL )
+	if( number_of_errors == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid SHA1 hash.",
-		 function );
-
-		return( -1 );
-	}
-	if( size < 20 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
-		 "%s: SHA1 hash too small.",
+		 "%s: invalid number of errors.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12152,91 +13282,44 @@ int libewf_handle_set_sha1_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( ( internal_handle->read_io_handle != NULL )
-	 || ( internal_handle->hash_sections->sha1_hash_set != 0 )
-	 || ( internal_handle->hash_sections->sha1_digest_set != 0 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: SHA1 hash cannot be changed.",
-		 function );
-
-		goto on_error;
-	}
-	if( internal_handle->hash_values == NULL )
+	if( internal_handle->acquiry_errors != NULL )
 	{
-		if( libewf_hash_values_initialize(
-		     &( internal_handle->hash_values ),
+		if( libcdata_range_list_get_number_of_elements(
+		     internal_handle->acquiry_errors,
+		     &number_of_elements,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create hash values.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of elements from acquiry errors range list.",
 			 function );
 
 			goto on_error;
 		}
-		internal_handle->hash_values_parsed = 1;
-	}
-	if( memory_copy(
-	     internal_handle->hash_sections->sha1_hash,
-	     sha1_hash,
-	     20 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set SHA1 hash.",
-		 function );
-
-		goto on_error;
-	}
-	internal_handle->hash_sections->sha1_hash_set = 1;
-
-	if( memory_copy(
-	     internal_handle->hash_sections->sha1_digest,
-	     sha1_hash,
-	     20 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to set SHA1 hash.",
-		 function );
-
-		goto on_error;
 	}
-	internal_handle->hash_sections->sha1_digest_set = 1;
-
-	if( libewf_hash_values_parse_sha1_hash(
-	     internal_handle->hash_values,
-	     sha1_hash,
-	     20,
-	     error ) != 1 )
+	if( number_of_elements < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to parse SHA1 hash for its value.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of elements value out of bounds.",
 		 function );
 
 		goto on_error;
 	}
+	*number_of_errors = (uint32_t) number_of_elements;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12244,7 +13327,7 @@ int libewf_handle_set_sha1_hash(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
@@ -12254,24 +13337,27 @@ int libewf_handle_set_sha1_hash(
 
 on_error:
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Sets the read zero chunk on error
- * The chunk is not zeroed if read raw is used
+/* Retrieves an acquiry error
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_read_zero_chunk_on_error(
+int libewf_handle_get_acquiry_error(
      libewf_handle_t *handle,
-     uint8_t zero_on_error,
+     uint32_t index,
+     uint64_t *start_sector,
+     uint64_t *number_of_sectors,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_read_zero_chunk_on_error";
+	static char *function                     = "libewf_handle_get_acquiry_error";
+	intptr_t *value                           = NULL;
+	int result                                = 0;
 
 	if( handle == NULL )
 	{
@@ -12286,19 +13372,8 @@ int libewf_handle_set_read_zero_chunk_on_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12306,16 +13381,32 @@ int libewf_handle_set_read_zero_chunk_on_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	internal_handle->io_handle->zero_on_error = zero_on_error;
+	result = libcdata_range_list_get_range_by_index(
+	          internal_handle->acquiry_errors,
+	          (int) index,
+	          start_sector,
+	          number_of_sectors,
+	          &value,
+	          error );
 
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve acquiry error: %" PRIu32 ".",
+		 function,
+		 index );
+	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -12323,104 +13414,113 @@ int libewf_handle_set_read_zero_chunk_on_error(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Copies the media values from the source to the destination handle
+/* Append an acquiry error
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_copy_media_values(
-     libewf_handle_t *destination_handle,
-     libewf_handle_t *source_handle,
+int libewf_handle_append_acquiry_error(
+     libewf_handle_t *handle,
+     uint64_t start_sector,
+     uint64_t number_of_sectors,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_destination_handle = NULL;
-	libewf_internal_handle_t *internal_source_handle      = NULL;
-	static char *function                                 = "libewf_handle_copy_media_values";
-
-	if( destination_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid destination handle.",
-		 function );
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_append_acquiry_error";
+	int result                                = 0;
 
-		return( -1 );
-	}
-	if( source_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid source handle.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_destination_handle = (libewf_internal_handle_t *) destination_handle;
-	internal_source_handle      = (libewf_internal_handle_t *) source_handle;
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_source_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid source handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_destination_handle->media_values == NULL )
+#endif
+	result = libcdata_range_list_insert_range(
+	          internal_handle->acquiry_errors,
+	          start_sector,
+	          number_of_sectors,
+	          NULL,
+	          NULL,
+	          NULL,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid destination handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert acquiry error in range list.",
 		 function );
-
-		return( -1 );
 	}
-	if( memory_copy(
-	     internal_destination_handle->media_values,
-	     internal_source_handle->media_values,
-	     sizeof( libewf_media_values_t ) ) == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy media values.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+#endif
+	return( result );
 }
 
-/* Retrieves the number of acquiry errors
- * Returns 1 if successful or -1 on error
+/* Verifies the chunks of the (media) data
+ * The chunk data is read by the calling thread and validated by number_of_threads threads,
+ * corrupted chunks are added to the checksum errors
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if aborted or -1 on error
  */
-int libewf_handle_get_number_of_acquiry_errors(
-     libewf_handle_t *handle,
-     uint32_t *number_of_errors,
+int libewf_internal_handle_verify_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_threads,
      libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_number_of_acquiry_errors";
-	int number_of_elements                    = 0;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_chunk_verifier_t *chunk_verifier = NULL;
+	static char *function                   = "libewf_internal_handle_verify_chunks_from_file_io_pool";
+	off64_t chunk_data_offset               = 0;
+	off64_t offset                          = 0;
+	uint64_t number_of_verified_chunks      = 0;
+	int result                              = 1;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -12431,103 +13531,209 @@ int libewf_handle_get_number_of_acquiry_errors(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-	if( number_of_errors == NULL )
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid number of errors.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->acquiry_errors != NULL )
+	if( libewf_chunk_verifier_initialize(
+	     &chunk_verifier,
+	     internal_handle->io_handle,
+	     internal_handle->media_values,
+	     internal_handle->chunk_table->checksum_errors,
+	     number_of_threads,
+	     error ) != 1 )
 	{
-		if( libcdata_range_list_get_number_of_elements(
-		     internal_handle->acquiry_errors,
-		     &number_of_elements,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk verifier.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) offset < internal_handle->media_values->media_size )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		if( libewf_chunk_table_get_chunk_data_by_offset_no_cache(
+		     internal_handle->chunk_table,
+		     internal_handle->io_handle,
+		     file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     offset,
+		     &chunk_data_offset,
+		     &chunk_data,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve number of elements from acquiry errors range list.",
+			 "%s: unable to retrieve chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk data for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		offset = chunk_data->range_end_offset;
+
+		/* The chunk verifier takes over management of chunk_data
+		 */
+		if( libewf_chunk_verifier_push(
+		     chunk_verifier,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk data onto chunk verifier.",
 			 function );
 
+			chunk_data = NULL;
+
 			goto on_error;
 		}
+		chunk_data = NULL;
+
+		if( internal_handle->progress_callback != NULL )
+		{
+			if( libewf_chunk_verifier_get_number_of_verified_chunks(
+			     chunk_verifier,
+			     &number_of_verified_chunks,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of verified chunks.",
+				 function );
+
+				goto on_error;
+			}
+			if( internal_handle->progress_callback(
+			     internal_handle->progress_callback_user_data,
+			     number_of_verified_chunks,
+			     internal_handle->media_values->number_of_chunks ) == -1 )
+			{
+				result = 0;
+
+				break;
+			}
+		}
 	}
-	if( number_of_elements < 0 )
+	if( libewf_chunk_verifier_join(
+	     chunk_verifier,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of elements value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join chunk verifier.",
 		 function );
 
 		goto on_error;
 	}
-	*number_of_errors = (uint32_t) number_of_elements;
-
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	if( libewf_chunk_verifier_free(
+	     &chunk_verifier,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk verifier.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
+	internal_handle->io_handle->abort = 0;
+
+	return( result );
 
 on_error:
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( chunk_verifier != NULL )
+	{
+		libewf_chunk_verifier_free(
+		 &chunk_verifier,
+		 NULL );
+	}
+	internal_handle->io_handle->abort = 0;
+
 	return( -1 );
 }
 
-/* Retrieves an acquiry error
- * Returns 1 if successful or -1 on error
+/* Verifies the chunks of the (media) data
+ * The chunk data is read by the calling thread and validated by number_of_threads threads,
+ * if number_of_threads is 0 the chunk data is validated by the calling thread
+ * Corrupted chunks are added to the checksum errors, no media data is returned
+ * Returns 1 if successful, 0 if aborted or -1 on error
  */
-int libewf_handle_get_acquiry_error(
+int libewf_handle_verify_chunks(
      libewf_handle_t *handle,
-     uint32_t index,
-     uint64_t *start_sector,
-     uint64_t *number_of_sectors,
+     int number_of_threads,
      libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_acquiry_error";
-	intptr_t *value                           = NULL;
+	static char *function                     = "libewf_handle_verify_chunks";
 	int result                                = 0;
 
 	if( handle == NULL )
@@ -12543,83 +13749,40 @@ int libewf_handle_get_acquiry_error(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libcdata_range_list_get_range_by_index(
-	          internal_handle->acquiry_errors,
-	          (int) index,
-	          start_sector,
-	          number_of_sectors,
-	          &value,
-	          error );
-
-	if( result != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve acquiry error: %" PRIu32 ".",
-		 function,
-		 index );
-	}
-#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Append an acquiry error
- * Returns 1 if successful or -1 on error
- */
-int libewf_handle_append_acquiry_error(
-     libewf_handle_t *handle,
-     uint64_t start_sector,
-     uint64_t number_of_sectors,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_append_acquiry_error";
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_VERIFY_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
@@ -12635,22 +13798,19 @@ int libewf_handle_append_acquiry_error(
 		return( -1 );
 	}
 #endif
-	result = libcdata_range_list_insert_range(
-	          internal_handle->acquiry_errors,
-	          start_sector,
-	          number_of_sectors,
-	          NULL,
-	          NULL,
-	          NULL,
-	          error );
+	result = libewf_internal_handle_verify_chunks_from_file_io_pool(
+		  internal_handle,
+		  internal_handle->file_io_pool,
+		  number_of_threads,
+		  error );
 
-	if( result != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to insert acquiry error in range list.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to verify chunks.",
 		 function );
 	}
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
@@ -27,6 +27,7 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
+#include "libewf_chunk_reorder_window.h"
 #include "libewf_chunk_table.h"
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
@@ -110,6 +111,10 @@ struct libewf_internal_handle
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The chunk reorder window
+	 */
+	libewf_chunk_reorder_window_t *chunk_reorder_window;
+
 	/* The date format for certain header values
 	 */
 	int date_format;
@@ -138,6 +143,17 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The progress callback
+	 */
+	int (*progress_callback)(
+	       void *user_data,
+	       uint64_t value,
+	       uint64_t maximum_value );
+
+	/* The progress callback user data
+	 */
+	void *progress_callback_user_data;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -287,6 +303,13 @@ ssize_t libewf_handle_read_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_chunk_data_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_chunk_data_t *chunk_data,
+         size_t data_size,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -299,6 +322,42 @@ ssize_t libewf_handle_write_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_chunk_data_at_index(
+         libewf_internal_handle_t *internal_handle,
+         libewf_chunk_data_t *chunk_data,
+         size_t data_size,
+         uint64_t chunk_index,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_write_data_chunk_at_index(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         uint64_t chunk_index,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_reorder_window_size(
+     libewf_handle_t *handle,
+     int *number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_chunk_reorder_window_size(
+     libewf_handle_t *handle,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_progress_callback(
+     libewf_handle_t *handle,
+     int (*progress_callback)(
+            void *user_data,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *user_data,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -400,6 +459,18 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_write_flags(
+     libewf_handle_t *handle,
+     uint8_t *write_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_flags(
+     libewf_handle_t *handle,
+     uint8_t write_flags,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -693,6 +764,18 @@ int libewf_handle_append_acquiry_error(
      uint64_t number_of_sectors,
      libcerror_error_t **error );
 
+int libewf_internal_handle_verify_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_verify_chunks(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_get_number_of_checksum_errors(
      libewf_handle_t *handle,
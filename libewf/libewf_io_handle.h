@@ -79,6 +79,10 @@ struct libewf_io_handle
 	 */
 	uint8_t zero_on_error;
 
+	/* The write flags
+	 */
+	uint8_t write_flags;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -0,0 +1,348 @@
+/*
+ * Section correction functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_section_correction.h"
+#include "libewf_section_descriptor.h"
+
+/* Creates a section correction
+ * Make sure the value section_correction is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_initialize(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_initialize";
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_correction != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid section correction value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*section_correction = memory_allocate_structure(
+	                       libewf_section_correction_t );
+
+	if( *section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section correction.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *section_correction,
+	     0,
+	     sizeof( libewf_section_correction_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section correction.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *section_correction != NULL )
+	{
+		memory_free(
+		 *section_correction );
+
+		*section_correction = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a section correction
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_free(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_free";
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_correction != NULL )
+	{
+		memory_free(
+		 *section_correction );
+
+		*section_correction = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones the section correction
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_clone(
+     libewf_section_correction_t **destination_section_correction,
+     libewf_section_correction_t *source_section_correction,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_clone";
+
+	if( destination_section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_section_correction != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination section correction already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_section_correction == NULL )
+	{
+		*destination_section_correction = NULL;
+
+		return( 1 );
+	}
+	*destination_section_correction = memory_allocate_structure(
+		                           libewf_section_correction_t );
+
+	if( *destination_section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination section correction.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_section_correction,
+	     source_section_correction,
+	     sizeof( libewf_section_correction_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination section correction.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_section_correction != NULL )
+	{
+		memory_free(
+		 *destination_section_correction );
+
+		*destination_section_correction = NULL;
+	}
+	return( -1 );
+}
+
+/* Sets the section correction values from a section descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_set(
+     libewf_section_correction_t *section_correction,
+     uint32_t segment_number,
+     libewf_section_descriptor_t *section_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_correction_set";
+
+	if( section_correction == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_descriptor->type_string_length > 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid section descriptor - type string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     section_correction->type_string,
+	     section_descriptor->type_string,
+	     17 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy type string.",
+		 function );
+
+		return( -1 );
+	}
+	section_correction->segment_number     = segment_number;
+	section_correction->type               = section_descriptor->type;
+	section_correction->type_string_length = section_descriptor->type_string_length;
+	section_correction->start_offset       = section_descriptor->start_offset;
+	section_correction->data_size          = section_descriptor->data_size;
+
+	return( 1 );
+}
+
+/* Appends a section correction for a section descriptor to an array
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_correction_append(
+     libcdata_array_t *section_corrections,
+     uint32_t segment_number,
+     libewf_section_descriptor_t *section_descriptor,
+     libcerror_error_t **error )
+{
+	libewf_section_correction_t *section_correction = NULL;
+	static char *function                           = "libewf_section_correction_append";
+	int entry_index                                 = 0;
+
+	if( libewf_section_correction_initialize(
+	     &section_correction,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section correction.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_section_correction_set(
+	     section_correction,
+	     segment_number,
+	     section_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set section correction.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     section_corrections,
+	     &entry_index,
+	     (intptr_t *) section_correction,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append section correction to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( section_correction != NULL )
+	{
+		libewf_section_correction_free(
+		 &section_correction,
+		 NULL );
+	}
+	return( -1 );
+}
+
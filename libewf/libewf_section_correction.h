@@ -0,0 +1,97 @@
+/*
+ * Section correction functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBEWF_SECTION_CORRECTION_H )
+#define _LIBEWF_SECTION_CORRECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_section_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_section_correction libewf_section_correction_t;
+
+struct libewf_section_correction
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The section type
+	 */
+	uint32_t type;
+
+        /* The section type string
+         * consists of maximum 16 bytes
+         */
+        uint8_t type_string[ 17 ];
+
+	/* The section type string length
+	 */
+	size_t type_string_length;
+
+	/* The start offset of the section
+	 */
+	off64_t start_offset;
+
+	/* The data size
+	 */
+	size64_t data_size;
+};
+
+int libewf_section_correction_initialize(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error );
+
+int libewf_section_correction_free(
+     libewf_section_correction_t **section_correction,
+     libcerror_error_t **error );
+
+int libewf_section_correction_clone(
+     libewf_section_correction_t **destination_section_correction,
+     libewf_section_correction_t *source_section_correction,
+     libcerror_error_t **error );
+
+int libewf_section_correction_set(
+     libewf_section_correction_t *section_correction,
+     uint32_t segment_number,
+     libewf_section_descriptor_t *section_descriptor,
+     libcerror_error_t **error );
+
+int libewf_section_correction_append(
+     libcdata_array_t *section_corrections,
+     uint32_t segment_number,
+     libewf_section_descriptor_t *section_descriptor,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SECTION_CORRECTION_H ) */
+
@@ -0,0 +1,660 @@
+/*
+ * Section corrector functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_section_corrector.h"
+#include "libewf_write_io_handle.h"
+
+/* Creates a section corrector
+ * Make sure the value section_corrector is referencing, is set to NULL
+ * If number_of_threads is 0 the segment files are corrected by the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_initialize(
+     libewf_section_corrector_t **section_corrector,
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_corrector_initialize";
+
+	if( section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_corrector != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid section corrector value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_CORRECTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*section_corrector = memory_allocate_structure(
+	                      libewf_section_corrector_t );
+
+	if( *section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create section corrector.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *section_corrector,
+	     0,
+	     sizeof( libewf_section_corrector_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section corrector.",
+		 function );
+
+		memory_free(
+		 *section_corrector );
+
+		*section_corrector = NULL;
+
+		return( -1 );
+	}
+	( *section_corrector )->write_io_handle = write_io_handle;
+	( *section_corrector )->io_handle       = io_handle;
+	( *section_corrector )->media_values    = media_values;
+	( *section_corrector )->header_values   = header_values;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *section_corrector )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_threads > 0 )
+	{
+		/* Every queued job holds an open file IO handle, bound the number of queued jobs
+		 */
+		if( libcthreads_thread_pool_create(
+		     &( ( *section_corrector )->thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     number_of_threads,
+		     (int (*)(intptr_t *, void *)) &libewf_section_corrector_thread_pool_callback,
+		     (void *) *section_corrector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *section_corrector != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *section_corrector )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *section_corrector )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *section_corrector );
+
+		*section_corrector = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a section corrector
+ * Waits for the segment files that are still being corrected
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_free(
+     libewf_section_corrector_t **section_corrector,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_corrector_free";
+	int result            = 1;
+
+	if( section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section corrector.",
+		 function );
+
+		return( -1 );
+	}
+	if( *section_corrector != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( ( *section_corrector )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *section_corrector )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *section_corrector )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		/* The write IO handle, IO handle, media values and header values references are freed elsewhere
+		 */
+		memory_free(
+		 *section_corrector );
+
+		*section_corrector = NULL;
+	}
+	return( result );
+}
+
+/* Writes the recorded section corrections of a segment file
+ * The segment file is accessed through its own file IO handle, outside the file IO pool
+ * of the handle, which allows multiple segment files to be corrected concurrently
+ * The section corrector takes over management of the job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_correct_segment_file(
+     libewf_section_corrector_t *section_corrector,
+     libewf_section_corrector_job_t *job,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool = NULL;
+	static char *function        = "libewf_section_corrector_correct_segment_file";
+	int file_io_pool_entry       = 0;
+
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section corrector.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     0,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_append_handle(
+	     file_io_pool,
+	     &file_io_pool_entry,
+	     job->file_io_handle,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append file IO handle of segment file: %" PRIu32 " to pool.",
+		 function,
+		 job->segment_number );
+
+		goto on_error;
+	}
+	/* The file IO pool takes over management of the file IO handle
+	 */
+	job->file_io_handle = NULL;
+
+	if( libbfio_pool_open(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     LIBBFIO_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open segment file: %" PRIu32 " for write corrections.",
+		 function,
+		 job->segment_number );
+
+		goto on_error;
+	}
+	if( libewf_write_io_handle_write_segment_section_corrections(
+	     section_corrector->write_io_handle,
+	     section_corrector->io_handle,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     job->segment_number,
+	     section_corrector->media_values,
+	     section_corrector->header_values,
+	     &( job->section_correction_index ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write section corrections to segment file: %" PRIu32 ".",
+		 function,
+		 job->segment_number );
+
+		goto on_error;
+	}
+	if( libbfio_pool_close_all(
+	     file_io_pool,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close segment file: %" PRIu32 ".",
+		 function,
+		 job->segment_number );
+
+		goto on_error;
+	}
+	if( libbfio_pool_free(
+	     &file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 job );
+
+	return( 1 );
+
+on_error:
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( job->file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( job->file_io_handle ),
+		 NULL );
+	}
+	memory_free(
+	 job );
+
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Callback function for the thread pool to correct a segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_thread_pool_callback(
+     libewf_section_corrector_job_t *job,
+     libewf_section_corrector_t *section_corrector )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_section_corrector_thread_pool_callback";
+
+	if( libewf_section_corrector_correct_segment_file(
+	     section_corrector,
+	     job,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to correct segment file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	/* The error is reported by libewf_section_corrector_join
+	 */
+	if( section_corrector != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     section_corrector->mutex,
+		     NULL ) == 1 )
+		{
+			section_corrector->correct_failed = 1;
+
+			libcthreads_mutex_release(
+			 section_corrector->mutex,
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Pushes a segment file to be corrected
+ * The section corrector takes over management of the file IO handle,
+ * which should not be opened
+ * This function blocks if the thread pool queue is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_push(
+     libewf_section_corrector_t *section_corrector,
+     libbfio_handle_t *file_io_handle,
+     uint32_t segment_number,
+     int section_correction_index,
+     libcerror_error_t **error )
+{
+	libewf_section_corrector_job_t *job = NULL;
+	static char *function               = "libewf_section_corrector_push";
+
+	if( section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section corrector.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction_index < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid section correction index value less than zero.",
+		 function );
+
+		goto on_error;
+	}
+	job = memory_allocate_structure(
+	       libewf_section_corrector_job_t );
+
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create job.",
+		 function );
+
+		goto on_error;
+	}
+	job->file_io_handle           = file_io_handle;
+	job->segment_number           = segment_number;
+	job->section_correction_index = section_correction_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( section_corrector->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     section_corrector->thread_pool,
+		     (intptr_t *) job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job onto thread pool queue.",
+			 function );
+
+			memory_free(
+			 job );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+#endif
+	if( libewf_section_corrector_correct_segment_file(
+	     section_corrector,
+	     job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to correct segment file: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libbfio_handle_free(
+	 &file_io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Waits until all the pushed segment files have been corrected
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_section_corrector_join(
+     libewf_section_corrector_t *section_corrector,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_section_corrector_join";
+
+	if( section_corrector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section corrector.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( section_corrector->thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( section_corrector->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( section_corrector->correct_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to correct segment file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,134 @@
+/*
+ * Section corrector functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SECTION_CORRECTOR_H )
+#define _LIBEWF_SECTION_CORRECTOR_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+#include "libewf_libfvalue.h"
+#include "libewf_media_values.h"
+#include "libewf_write_io_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_section_corrector_job libewf_section_corrector_job_t;
+
+struct libewf_section_corrector_job
+{
+	/* The file IO handle of the segment file
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The index of the first section correction of the segment file
+	 */
+	int section_correction_index;
+};
+
+typedef struct libewf_section_corrector libewf_section_corrector_t;
+
+struct libewf_section_corrector
+{
+	/* The write IO handle
+	 */
+	libewf_write_io_handle_t *write_io_handle;
+
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The media values
+	 */
+	libewf_media_values_t *media_values;
+
+	/* The header values
+	 */
+	libfvalue_table_t *header_values;
+
+	/* Value to indicate correcting a segment file failed
+	 */
+	uint8_t correct_failed;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_section_corrector_initialize(
+     libewf_section_corrector_t **section_corrector,
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libewf_section_corrector_free(
+     libewf_section_corrector_t **section_corrector,
+     libcerror_error_t **error );
+
+int libewf_section_corrector_correct_segment_file(
+     libewf_section_corrector_t *section_corrector,
+     libewf_section_corrector_job_t *job,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_section_corrector_thread_pool_callback(
+     libewf_section_corrector_job_t *job,
+     libewf_section_corrector_t *section_corrector );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+int libewf_section_corrector_push(
+     libewf_section_corrector_t *section_corrector,
+     libbfio_handle_t *file_io_handle,
+     uint32_t segment_number,
+     int section_correction_index,
+     libcerror_error_t **error );
+
+int libewf_section_corrector_join(
+     libewf_section_corrector_t *section_corrector,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SECTION_CORRECTOR_H ) */
+
@@ -51,6 +51,7 @@
 #include "libewf_libuna.h"
 #include "libewf_md5_hash_section.h"
 #include "libewf_section.h"
+#include "libewf_section_correction.h"
 #include "libewf_section_descriptor.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
@@ -1917,6 +1918,7 @@ ssize_t libewf_segment_file_write_device_information_section(
          size_t *device_information_size,
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
@@ -2032,6 +2034,24 @@ ssize_t libewf_segment_file_write_device_information_section(
 	}
 	segment_file->current_offset += write_count;
 
+	if( section_corrections != NULL )
+	{
+		if( libewf_section_correction_append(
+		     section_corrections,
+		     segment_file->segment_number,
+		     section_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append device information section correction.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_section_descriptor_free(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -2087,6 +2107,7 @@ ssize_t libewf_segment_file_write_case_data_section(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
@@ -2204,6 +2225,24 @@ ssize_t libewf_segment_file_write_case_data_section(
 	}
 	segment_file->current_offset += write_count;
 
+	if( section_corrections != NULL )
+	{
+		if( libewf_section_correction_append(
+		     section_corrections,
+		     segment_file->segment_number,
+		     section_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append case data section correction.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_section_descriptor_free(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -3251,6 +3290,7 @@ ssize_t libewf_segment_file_write_start(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error )
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
@@ -3414,6 +3454,24 @@ ssize_t libewf_segment_file_write_start(
 
 				goto on_error;
 			}
+			if( section_corrections != NULL )
+			{
+				if( libewf_section_correction_append(
+				     section_corrections,
+				     segment_file->segment_number,
+				     section_descriptor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append section correction.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			segment_file->current_offset += write_count;
 			total_write_count            += write_count;
 		}
@@ -3441,6 +3499,7 @@ ssize_t libewf_segment_file_write_start(
 			       device_information_size,
 			       media_values,
 			       header_values,
+			       section_corrections,
 			       error );
 
 		if( write_count == -1 )
@@ -3465,6 +3524,7 @@ ssize_t libewf_segment_file_write_start(
 			       media_values,
 			       header_values,
 			       timestamp,
+			       section_corrections,
 			       error );
 
 		if( write_count == -1 )
@@ -5888,6 +5948,21 @@ int libewf_segment_file_write_sections_correction(
 						next_section_start_offset = section_descriptor->start_offset;
 					}
 					break;
+
+				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
+				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
+					/* The sections that need to be corrected are stored before the chunks sections
+					 * except for the next section, which is the last section
+					 */
+					if( last_segment_file == 0 )
+					{
+						section_index = number_of_sections;
+					}
+					else if( section_index < ( number_of_sections - 2 ) )
+					{
+						section_index = number_of_sections - 2;
+					}
+					break;
 			}
 		}
 		else if( section_descriptor->type_string_length == 6 )
@@ -235,6 +235,7 @@ ssize_t libewf_segment_file_write_device_information_section(
          size_t *device_information_size,
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_case_data_section(
@@ -246,6 +247,7 @@ ssize_t libewf_segment_file_write_case_data_section(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_header_section(
@@ -297,6 +299,7 @@ ssize_t libewf_segment_file_write_start(
          libewf_media_values_t *media_values,
          libfvalue_table_t *header_values,
          time_t timestamp,
+         libcdata_array_t *section_corrections,
          libcerror_error_t **error );
 
 ssize_t libewf_segment_file_write_chunks_section_start(
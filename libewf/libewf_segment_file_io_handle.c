@@ -0,0 +1,1662 @@
+/*
+ * Segment file IO handle functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT and fallocate require _GNU_SOURCE on Linux
+ */
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_segment_file_io_handle.h"
+
+#if defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE )
+
+/* Direct IO requires aligned buffers
+ */
+#if defined( O_DIRECT ) && defined( HAVE_POSIX_MEMALIGN )
+#define LIBEWF_SEGMENT_FILE_IO_HANDLE_HAVE_DIRECT_IO	1
+#endif
+
+/* Creates a segment file IO handle
+ * Make sure the value io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_initialize(
+     libewf_segment_file_io_handle_t **io_handle,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_initialize";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( preallocation_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid preallocation size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*io_handle = memory_allocate_structure(
+	              libewf_segment_file_io_handle_t );
+
+	if( *io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_handle,
+	     0,
+	     sizeof( libewf_segment_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *io_handle )->write_flags        = write_flags;
+	( *io_handle )->preallocation_size = preallocation_size;
+	( *io_handle )->file_descriptor    = -1;
+
+	return( 1 );
+
+on_error:
+	if( *io_handle != NULL )
+	{
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a file IO handle that uses a segment file IO handle
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_io_handle_t *io_handle = NULL;
+	static char *function                      = "libewf_segment_file_io_handle_initialize_file_io_handle";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_io_handle_initialize(
+	     &io_handle,
+	     write_flags,
+	     preallocation_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_io_handle_set_name(
+	     io_handle,
+	     name,
+	     name_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in segment file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_initialize(
+	     file_io_handle,
+	     (intptr_t *) io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_segment_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_segment_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_segment_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_segment_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_segment_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_segment_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_segment_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_segment_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_segment_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_segment_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( io_handle != NULL )
+	{
+		libewf_segment_file_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a segment file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_free(
+     libewf_segment_file_io_handle_t **io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_free";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_handle != NULL )
+	{
+		if( ( *io_handle )->file_descriptor != -1 )
+		{
+			if( libewf_segment_file_io_handle_close(
+			     *io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *io_handle )->block_buffer != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->block_buffer );
+		}
+		if( ( *io_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->buffer );
+		}
+		if( ( *io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *io_handle )->name );
+		}
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the segment file IO handle
+ * The clone is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_clone(
+     libewf_segment_file_io_handle_t **destination_io_handle,
+     libewf_segment_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_clone";
+
+	if( destination_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_io_handle == NULL )
+	{
+		*destination_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_segment_file_io_handle_initialize(
+	     destination_io_handle,
+	     source_io_handle->write_flags,
+	     source_io_handle->preallocation_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_io_handle->name != NULL )
+	{
+		if( libewf_segment_file_io_handle_set_name(
+		     *destination_io_handle,
+		     source_io_handle->name,
+		     source_io_handle->name_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_io_handle )->is_created = source_io_handle->is_created;
+
+	return( 1 );
+
+on_error:
+	if( *destination_io_handle != NULL )
+	{
+		libewf_segment_file_io_handle_free(
+		 destination_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_set_name(
+     libewf_segment_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_set_name";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_length == 0 )
+	 || ( name_length > (size_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name      = NULL;
+		io_handle->name_size = 0;
+	}
+	io_handle->name = narrow_string_allocate(
+	                   name_length + 1 );
+
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     io_handle->name,
+	     name,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->name[ name_length ] = 0;
+
+	io_handle->name_size = name_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( io_handle->name != NULL )
+	{
+		memory_free(
+		 io_handle->name );
+
+		io_handle->name = NULL;
+	}
+	io_handle->name_size = 0;
+
+	return( -1 );
+}
+
+/* Preallocates the segment file
+ * Preallocation is done on a best effort basis
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_segment_file_io_handle_preallocate(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_preallocate";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->preallocation_size <= io_handle->file_size )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_FALLOCATE ) && defined( FALLOC_FL_KEEP_SIZE )
+	/* Reserve the space without changing the size of the file
+	 */
+	if( fallocate(
+	     io_handle->file_descriptor,
+	     FALLOC_FL_KEEP_SIZE,
+	     0,
+	     (off_t) io_handle->preallocation_size ) == 0 )
+	{
+		result = 1;
+	}
+#elif defined( HAVE_POSIX_FALLOCATE )
+	/* posix_fallocate changes the size of the file, the additional
+	 * size is removed when the file is closed
+	 */
+	if( posix_fallocate(
+	     io_handle->file_descriptor,
+	     0,
+	     (off_t) io_handle->preallocation_size ) == 0 )
+	{
+		io_handle->stored_size = io_handle->preallocation_size;
+
+		result = 1;
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( result == 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to preallocate: %" PRIu64 " bytes.\n",
+			 function,
+			 io_handle->preallocation_size );
+		}
+	}
+#endif
+	io_handle->is_preallocated = (uint8_t) result;
+
+	return( result );
+}
+
+/* Opens the segment file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_open(
+     libewf_segment_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_segment_file_io_handle_open";
+	int file_io_flags     = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - file descriptor value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Read access is needed to merge partial blocks when using direct IO
+		 */
+		file_io_flags = O_RDWR | O_CREAT;
+
+		/* The file is only truncated when it is created, the file IO pool
+		 * can close and reopen the file with the same access flags
+		 */
+		if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+		 && ( io_handle->is_created == 0 ) )
+		{
+			file_io_flags |= O_TRUNC;
+		}
+	}
+	else if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+	{
+		file_io_flags = O_RDONLY;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
+#if defined( LIBEWF_SEGMENT_FILE_IO_HANDLE_HAVE_DIRECT_IO )
+	if( ( io_handle->write_flags & LIBEWF_WRITE_FLAG_USE_DIRECT_IO ) != 0 )
+	{
+		if( io_handle->buffer == NULL )
+		{
+			if( posix_memalign(
+			     (void **) &( io_handle->buffer ),
+			     LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT,
+			     LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create buffer.",
+				 function );
+
+				io_handle->buffer = NULL;
+
+				return( -1 );
+			}
+		}
+		if( io_handle->block_buffer == NULL )
+		{
+			if( posix_memalign(
+			     (void **) &( io_handle->block_buffer ),
+			     LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT,
+			     LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create block buffer.",
+				 function );
+
+				io_handle->block_buffer = NULL;
+
+				return( -1 );
+			}
+		}
+		io_handle->file_descriptor = open(
+		                              io_handle->name,
+		                              file_io_flags | O_DIRECT,
+		                              0644 );
+
+		/* Fall back to buffered IO if the file system does not support direct IO
+		 */
+		if( io_handle->file_descriptor != -1 )
+		{
+			io_handle->use_direct_io = 1;
+		}
+		else if( errno != EINVAL )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open file: %s.",
+			 function,
+			 io_handle->name );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( LIBEWF_SEGMENT_FILE_IO_HANDLE_HAVE_DIRECT_IO ) */
+
+	if( io_handle->file_descriptor == -1 )
+	{
+		io_handle->file_descriptor = open(
+		                              io_handle->name,
+		                              file_io_flags,
+		                              0644 );
+
+		if( io_handle->file_descriptor == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open file: %s.",
+			 function,
+			 io_handle->name );
+
+			return( -1 );
+		}
+	}
+	if( fstat(
+	     io_handle->file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	io_handle->access_flags     = access_flags;
+	io_handle->file_size        = (size64_t) file_statistics.st_size;
+	io_handle->stored_size      = (size64_t) file_statistics.st_size;
+	io_handle->current_offset   = 0;
+	io_handle->buffer_offset    = 0;
+	io_handle->buffer_data_size = 0;
+
+	if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		io_handle->is_created = 1;
+
+		if( ( io_handle->write_flags & LIBEWF_WRITE_FLAG_PREALLOCATE ) != 0 )
+		{
+			if( libewf_segment_file_io_handle_preallocate(
+			     io_handle,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to preallocate file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	close(
+	 io_handle->file_descriptor );
+
+	io_handle->file_descriptor = -1;
+	io_handle->use_direct_io   = 0;
+
+	return( -1 );
+}
+
+/* Closes the segment file IO handle
+ * Any buffered data is written and the unused preallocated space is released
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_close(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_close";
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_io_handle_flush_buffer(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		/* Remove the unused preallocated space and the direct IO block padding
+		 */
+		if( ( io_handle->is_preallocated != 0 )
+		 || ( io_handle->stored_size > io_handle->file_size ) )
+		{
+			if( ftruncate(
+			     io_handle->file_descriptor,
+			     (off_t) io_handle->file_size ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 errno,
+				 "%s: unable to truncate file to size: %" PRIu64 ".",
+				 function,
+				 io_handle->file_size );
+
+				result = -1;
+			}
+		}
+	}
+	if( close(
+	     io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file descriptor.",
+		 function );
+
+		result = -1;
+	}
+	io_handle->file_descriptor = -1;
+	io_handle->access_flags    = 0;
+	io_handle->use_direct_io   = 0;
+	io_handle->is_preallocated = 0;
+
+	return( result );
+}
+
+/* Reads an aligned block of stored data into the block buffer
+ * The part of the block that is not stored is set to 0
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_read_block(
+     libewf_segment_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_read_block";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->block_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing block buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) block_offset < io_handle->stored_size )
+	{
+		read_count = pread(
+		              io_handle->file_descriptor,
+		              io_handle->block_buffer,
+		              LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT,
+		              (off_t) block_offset );
+
+		if( read_count < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 block_offset,
+			 block_offset );
+
+			return( -1 );
+		}
+	}
+	if( read_count < LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT )
+	{
+		if( memory_set(
+		     &( io_handle->block_buffer[ read_count ] ),
+		     0,
+		     (size_t) ( LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT - read_count ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the data in the direct IO buffer
+ * A trailing partial block is merged with the stored data and padded to the alignment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_flush_buffer(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_segment_file_io_handle_flush_buffer";
+	size_t buffer_offset     = 0;
+	size_t remainder_size    = 0;
+	size_t write_size        = 0;
+	ssize_t write_count      = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->use_direct_io == 0 )
+	 || ( io_handle->buffer_data_size == 0 ) )
+	{
+		return( 1 );
+	}
+	write_size     = io_handle->buffer_data_size - ( io_handle->buffer_data_size % LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT );
+	remainder_size = io_handle->buffer_data_size - write_size;
+
+	if( remainder_size > 0 )
+	{
+		if( (size64_t) ( io_handle->buffer_offset + io_handle->buffer_data_size ) < io_handle->file_size )
+		{
+			if( libewf_segment_file_io_handle_read_block(
+			     io_handle,
+			     io_handle->buffer_offset + write_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read trailing block.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_copy(
+			     &( io_handle->buffer[ io_handle->buffer_data_size ] ),
+			     &( io_handle->block_buffer[ remainder_size ] ),
+			     LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT - remainder_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy trailing block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( memory_set(
+		          &( io_handle->buffer[ io_handle->buffer_data_size ] ),
+		          0,
+		          LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT - remainder_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear trailing block.",
+			 function );
+
+			return( -1 );
+		}
+		write_size += LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT;
+	}
+	while( buffer_offset < write_size )
+	{
+		write_count = pwrite(
+		               io_handle->file_descriptor,
+		               &( io_handle->buffer[ buffer_offset ] ),
+		               write_size - buffer_offset,
+		               (off_t) ( io_handle->buffer_offset + buffer_offset ) );
+
+		if( write_count <= 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 io_handle->buffer_offset + buffer_offset,
+			 io_handle->buffer_offset + buffer_offset );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	if( (size64_t) ( io_handle->buffer_offset + write_size ) > io_handle->stored_size )
+	{
+		io_handle->stored_size = (size64_t) ( io_handle->buffer_offset + write_size );
+	}
+	io_handle->buffer_data_size = 0;
+
+	return( 1 );
+}
+
+/* Reads a buffer from the segment file IO handle
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_segment_file_io_handle_read(
+     libewf_segment_file_io_handle_t *io_handle,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_read";
+	size_t block_offset   = 0;
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	off64_t read_offset   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) io_handle->current_offset >= io_handle->file_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) size > ( io_handle->file_size - io_handle->current_offset ) )
+	{
+		size = (size_t) ( io_handle->file_size - io_handle->current_offset );
+	}
+	if( libewf_segment_file_io_handle_flush_buffer(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( io_handle->use_direct_io == 0 )
+		{
+			read_count = pread(
+			              io_handle->file_descriptor,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              (off_t) io_handle->current_offset );
+
+			block_offset = 0;
+		}
+		else
+		{
+			/* Direct IO reads are done in aligned blocks using the direct IO buffer
+			 */
+			block_offset = (size_t) ( io_handle->current_offset % LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT );
+			read_offset  = io_handle->current_offset - block_offset;
+			read_size    = block_offset + ( size - buffer_offset );
+
+			if( ( read_size % LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT ) != 0 )
+			{
+				read_size += LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT - ( read_size % LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT );
+			}
+			if( read_size > LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE )
+			{
+				read_size = LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE;
+			}
+			read_count = pread(
+			              io_handle->file_descriptor,
+			              io_handle->buffer,
+			              read_size,
+			              (off_t) read_offset );
+		}
+		if( read_count < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 io_handle->current_offset,
+			 io_handle->current_offset );
+
+			return( -1 );
+		}
+		if( (size_t) read_count <= block_offset )
+		{
+			break;
+		}
+		read_size = (size_t) read_count - block_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		if( io_handle->use_direct_io != 0 )
+		{
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( io_handle->buffer[ block_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset             += read_size;
+		io_handle->current_offset += read_size;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the segment file IO handle
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_segment_file_io_handle_write(
+     libewf_segment_file_io_handle_t *io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_write";
+	size_t buffer_offset  = 0;
+	size_t prefix_size    = 0;
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid IO handle - not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		if( io_handle->use_direct_io == 0 )
+		{
+			write_count = pwrite(
+			               io_handle->file_descriptor,
+			               &( buffer[ buffer_offset ] ),
+			               size - buffer_offset,
+			               (off_t) io_handle->current_offset );
+
+			if( write_count <= 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 errno,
+				 "%s: unable to write at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 io_handle->current_offset,
+				 io_handle->current_offset );
+
+				return( -1 );
+			}
+			write_size = (size_t) write_count;
+
+			if( (size64_t) ( io_handle->current_offset + write_size ) > io_handle->stored_size )
+			{
+				io_handle->stored_size = (size64_t) ( io_handle->current_offset + write_size );
+			}
+		}
+		else
+		{
+			/* Start a new buffer when the data is not contiguous with the buffered data
+			 */
+			if( ( io_handle->buffer_data_size == 0 )
+			 || ( io_handle->current_offset != ( io_handle->buffer_offset + (off64_t) io_handle->buffer_data_size ) ) )
+			{
+				if( libewf_segment_file_io_handle_flush_buffer(
+				     io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to flush buffer.",
+					 function );
+
+					return( -1 );
+				}
+				prefix_size = (size_t) ( io_handle->current_offset % LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT );
+
+				io_handle->buffer_offset = io_handle->current_offset - prefix_size;
+
+				if( prefix_size > 0 )
+				{
+					if( libewf_segment_file_io_handle_read_block(
+					     io_handle,
+					     io_handle->buffer_offset,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read leading block.",
+						 function );
+
+						return( -1 );
+					}
+					if( memory_copy(
+					     io_handle->buffer,
+					     io_handle->block_buffer,
+					     prefix_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy leading block.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				io_handle->buffer_data_size = prefix_size;
+			}
+			write_size = LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE - io_handle->buffer_data_size;
+
+			if( write_size > ( size - buffer_offset ) )
+			{
+				write_size = size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( io_handle->buffer[ io_handle->buffer_data_size ] ),
+			     &( buffer[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+			io_handle->buffer_data_size += write_size;
+		}
+		buffer_offset             += write_size;
+		io_handle->current_offset += write_size;
+
+		if( (size64_t) io_handle->current_offset > io_handle->file_size )
+		{
+			io_handle->file_size = (size64_t) io_handle->current_offset;
+		}
+		if( io_handle->buffer_data_size == LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE )
+		{
+			if( libewf_segment_file_io_handle_flush_buffer(
+			     io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Seeks a certain offset within the segment file IO handle
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_segment_file_io_handle_seek_offset(
+     libewf_segment_file_io_handle_t *io_handle,
+     off64_t offset,
+     int whence,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_seek_offset";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) io_handle->file_size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	/* The buffered data is written when the next read or non-contiguous write is done
+	 */
+	io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_segment_file_io_handle_exists(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "libewf_segment_file_io_handle_exists";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     io_handle->name,
+	     &file_statistics ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics: %s.",
+		 function,
+		 io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the segment file IO handle is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_segment_file_io_handle_is_open(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_is_open";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the (logical) size of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_io_handle_get_size(
+     libewf_segment_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_segment_file_io_handle_get_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = io_handle->file_size;
+
+	return( 1 );
+}
+
+#endif /* defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE ) */
+
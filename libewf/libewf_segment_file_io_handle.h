@@ -0,0 +1,210 @@
+/*
+ * Segment file IO handle functions
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_SEGMENT_FILE_IO_HANDLE_H )
+#define _LIBEWF_SEGMENT_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The segment file IO handle uses POSIX file descriptors directly
+ * and is only available for narrow character POSIX systems
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_OPEN ) && defined( HAVE_PREAD ) && defined( HAVE_PWRITE ) && defined( HAVE_FTRUNCATE )
+#define LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE	1
+#endif
+
+/* The alignment of direct IO offsets, sizes and buffers
+ */
+#define LIBEWF_SEGMENT_FILE_IO_HANDLE_ALIGNMENT	4096
+
+/* The size of the direct IO write buffer
+ */
+#define LIBEWF_SEGMENT_FILE_IO_HANDLE_BUFFER_SIZE	( 1024 * 1024 )
+
+#if defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE )
+
+typedef struct libewf_segment_file_io_handle libewf_segment_file_io_handle_t;
+
+struct libewf_segment_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The write flags
+	 */
+	uint8_t write_flags;
+
+	/* The preallocation size
+	 */
+	size64_t preallocation_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* Value to indicate the file has been created
+	 */
+	uint8_t is_created;
+
+	/* Value to indicate direct IO is used
+	 */
+	uint8_t use_direct_io;
+
+	/* Value to indicate the file was preallocated
+	 */
+	uint8_t is_preallocated;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The (logical) file size
+	 */
+	size64_t file_size;
+
+	/* The (physical) size of the data stored on disk
+	 */
+	size64_t stored_size;
+
+	/* The aligned direct IO buffer
+	 */
+	uint8_t *buffer;
+
+	/* The aligned block buffer
+	 */
+	uint8_t *block_buffer;
+
+	/* The offset of the data in the direct IO buffer
+	 */
+	off64_t buffer_offset;
+
+	/* The size of the data in the direct IO buffer
+	 */
+	size_t buffer_data_size;
+};
+
+int libewf_segment_file_io_handle_initialize(
+     libewf_segment_file_io_handle_t **io_handle,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_initialize_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_free(
+     libewf_segment_file_io_handle_t **io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_clone(
+     libewf_segment_file_io_handle_t **destination_io_handle,
+     libewf_segment_file_io_handle_t *source_io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_set_name(
+     libewf_segment_file_io_handle_t *io_handle,
+     const char *name,
+     size_t name_length,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_preallocate(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_open(
+     libewf_segment_file_io_handle_t *io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_close(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_read_block(
+     libewf_segment_file_io_handle_t *io_handle,
+     off64_t block_offset,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_flush_buffer(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_file_io_handle_read(
+     libewf_segment_file_io_handle_t *io_handle,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+ssize_t libewf_segment_file_io_handle_write(
+     libewf_segment_file_io_handle_t *io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+off64_t libewf_segment_file_io_handle_seek_offset(
+     libewf_segment_file_io_handle_t *io_handle,
+     off64_t offset,
+     int whence,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_exists(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_is_open(
+     libewf_segment_file_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_segment_file_io_handle_get_size(
+     libewf_segment_file_io_handle_t *io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_SEGMENT_FILE_IO_HANDLE_H ) */
+
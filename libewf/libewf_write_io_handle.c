@@ -31,11 +31,14 @@
 
 #include <time.h>
 
+#include "libewf_case_data.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_descriptor.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
+#include "libewf_device_information.h"
+#include "libewf_empty_block_cache.h"
 #include "libewf_filename.h"
 #include "libewf_header_sections.h"
 #include "libewf_header_values.h"
@@ -50,9 +53,14 @@
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_section.h"
+#include "libewf_section_correction.h"
+#include "libewf_section_corrector.h"
+#include "libewf_section_descriptor.h"
 #include "libewf_segment_file.h"
+#include "libewf_segment_file_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_unused.h"
+#include "libewf_volume_section.h"
 #include "libewf_write_io_handle.h"
 
 #include "ewf_data.h"
@@ -150,6 +158,20 @@ int libewf_write_io_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *write_io_handle )->section_corrections ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section corrections array.",
+		 function );
+
+		goto on_error;
+	}
 	( *write_io_handle )->pack_flags                  = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
 	( *write_io_handle )->section_descriptor_size     = sizeof( ewf_section_descriptor_v1_t );
 	( *write_io_handle )->table_header_size           = sizeof( ewf_table_header_v1_t );
@@ -165,6 +187,13 @@ int libewf_write_io_handle_initialize(
 on_error:
 	if( *write_io_handle != NULL )
 	{
+		if( ( *write_io_handle )->chunks_section != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *write_io_handle )->chunks_section ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_descriptor_free,
+			 NULL );
+		}
 		memory_free(
 		 *write_io_handle );
 
@@ -221,6 +250,22 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
+		if( ( *write_io_handle )->empty_block_cache != NULL )
+		{
+			if( libewf_empty_block_cache_free(
+			     &( ( *write_io_handle )->empty_block_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free empty block cache.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcdata_array_free(
 		     &( ( *write_io_handle )->chunks_section ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_descriptor_free,
@@ -235,6 +280,20 @@ int libewf_write_io_handle_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *write_io_handle )->section_corrections ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section corrections array.",
+			 function );
+
+			result = -1;
+		}
 		if( ( *write_io_handle )->managed_segment_file != NULL )
 		{
 			if( libewf_segment_file_free(
@@ -336,6 +395,8 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data_size    = 0;
 	( *destination_write_io_handle )->number_of_table_entries    = 0;
 	( *destination_write_io_handle )->chunks_section             = NULL;
+	( *destination_write_io_handle )->section_corrections        = NULL;
+	( *destination_write_io_handle )->empty_block_cache          = NULL;
 	( *destination_write_io_handle )->current_file_io_pool_entry = -1;
 	( *destination_write_io_handle )->current_segment_file       = NULL;
 	( *destination_write_io_handle )->managed_segment_file       = NULL;
@@ -486,11 +547,34 @@ int libewf_write_io_handle_clone(
 
 		goto on_error;
 	}
+	if( libcdata_array_clone(
+	     &( ( *destination_write_io_handle )->section_corrections ),
+	     source_write_io_handle->section_corrections,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_correction_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) &libewf_section_correction_clone,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination section corrections array.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_write_io_handle != NULL )
 	{
+		if( ( *destination_write_io_handle )->chunks_section != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *destination_write_io_handle )->chunks_section ),
+			 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_descriptor_free,
+			 NULL );
+		}
 		if( ( *destination_write_io_handle )->table_section_data != NULL )
 		{
 			memory_free(
@@ -902,6 +986,28 @@ int libewf_write_io_handle_initialize_values(
 			zero_byte_empty_block = NULL;
 		}
 	}
+	/* Empty blocks with other fill bytes than 0 are only stored compressed when compression is used
+	 */
+	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_LEVEL_NONE )
+	 && ( write_io_handle->empty_block_cache == NULL ) )
+	{
+		if( libewf_empty_block_cache_initialize(
+		     &( write_io_handle->empty_block_cache ),
+		     media_values->chunk_size,
+		     io_handle->compression_method,
+		     io_handle->compression_level,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create empty block cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	write_io_handle->timestamp = time( NULL );
 
 	/* Flag that the write values were initialized
@@ -2495,41 +2601,66 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
-		 function );
+#if defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE )
+	if( io_handle->write_flags != 0 )
+	{
+		if( libewf_segment_file_io_handle_initialize_file_io_handle(
+		     &file_io_handle,
+		     io_handle->write_flags,
+		     segment_table->maximum_segment_size,
+		     filename,
+		     filename_size - 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
+	else
+#endif /* defined( LIBEWF_HAVE_SEGMENT_FILE_IO_HANDLE ) */
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size - 1,
-	     error ) != 1 )
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size - 1,
+		     error ) != 1 )
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size - 1,
-	     error ) != 1 )
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_size - 1,
+		     error ) != 1 )
 #endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
-		 function );
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	memory_free(
 	 filename );
@@ -3246,6 +3377,7 @@ ssize_t libewf_write_io_handle_write_new_chunk_create_segment_file(
 	               media_values,
 	               header_values,
 	               write_io_handle->timestamp,
+	               write_io_handle->section_corrections,
 	               error );
 
 	if( write_count < 0 )
@@ -3985,29 +4117,28 @@ on_error:
 	return( -1 );
 }
 
-/* Corrects sections after streamed write
- * Returns 1 if successful or -1 on error
+/* Writes the recorded section corrections of a specific segment file
+ * The corrections are applied directly to the recorded section offsets
+ * which prevents the segment file from having to be read again
+ * Returns 1 if successful, 0 if no corrections were recorded for the segment file or -1 on error
  */
-int libewf_write_io_handle_finalize_write_sections_corrections(
+int libewf_write_io_handle_write_segment_section_corrections(
      libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
      libewf_media_values_t *media_values,
-     libewf_segment_table_t *segment_table,
      libfvalue_table_t *header_values,
-     libfvalue_table_t *hash_values,
-     libewf_hash_sections_t *hash_sections,
-     libcdata_array_t *sessions,
-     libcdata_array_t *tracks,
-     libcdata_range_list_t *acquiry_errors,
+     int *section_correction_index,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_write_io_handle_finalize_write_sections_corrections";
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_section_correction_t *section_correction = NULL;
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	static char *function                           = "libewf_write_io_handle_write_segment_section_corrections";
+	ssize_t write_count                             = 0;
+	int number_of_section_corrections               = 0;
+	int result                                      = 0;
 
 	if( write_io_handle == NULL )
 	{
@@ -4020,112 +4151,837 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     segment_table,
-	     &number_of_segments,
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->section_corrections,
+	     &number_of_section_corrections,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 "%s: unable to retrieve number of section corrections.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
+	/* The section corrections are stored in order of segment number
+	 */
+	while( *section_correction_index < number_of_section_corrections )
 	{
-		if( segment_number == ( number_of_segments - 1 ) )
-		{
-			last_segment_file = 1;
-		}
-		if( libewf_segment_table_get_segment_by_index(
-		     segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->section_corrections,
+		     *section_correction_index,
+		     (intptr_t **) &section_correction,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve section correction: %d.",
 			 function,
-			 segment_number );
+			 *section_correction_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libbfio_pool_reopen(
-		     file_io_pool,
-		     file_io_pool_entry,
-		     LIBBFIO_OPEN_READ_WRITE,
-		     error ) != 1 )
+		if( section_correction == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to reopen segment file: %" PRIu32 " for write corrections.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section correction: %d.",
 			 function,
-			 segment_number );
+			 *section_correction_index );
 
-			return( -1 );
+			goto on_error;
+		}
+		if( section_correction->segment_number > segment_number )
+		{
+			break;
 		}
-		segment_file = NULL;
+		*section_correction_index += 1;
 
-		if( libewf_segment_table_get_segment_file_by_index(
-		     segment_table,
-		     segment_number,
+		if( section_correction->segment_number < segment_number )
+		{
+			continue;
+		}
+		if( section_descriptor == NULL )
+		{
+			if( libewf_section_descriptor_initialize(
+			     &section_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create section descriptor.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbfio_pool_seek_offset(
 		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
+		     file_io_pool_entry,
+		     section_correction->start_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek section correction offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".",
 			 function,
+			 section_correction->start_offset,
+			 section_correction->start_offset,
 			 segment_number );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libewf_segment_file_write_sections_correction(
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     write_io_handle->number_of_chunks_written_to_segment_file,
-		     last_segment_file,
-		     media_values,
-		     header_values,
-		     write_io_handle->timestamp,
-		     hash_values,
-		     hash_sections,
-		     sessions,
-		     tracks,
-		     acquiry_errors,
-		     &( write_io_handle->case_data ),
-		     &( write_io_handle->case_data_size ),
-		     &( write_io_handle->device_information ),
-		     &( write_io_handle->device_information_size ),
-		     &( write_io_handle->data_section ),
-		     error ) != 1 )
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: correcting section at offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".\n",
+			 function,
+			 section_correction->start_offset,
+			 section_correction->start_offset,
+			 segment_number );
+		}
+#endif
+		write_count = -1;
+
+		if( section_correction->type == LIBEWF_SECTION_TYPE_DEVICE_INFORMATION )
+		{
+			if( write_io_handle->device_information == NULL )
+			{
+				if( libewf_device_information_generate(
+				     &( write_io_handle->device_information ),
+				     &( write_io_handle->device_information_size ),
+				     media_values,
+				     header_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate device information.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* Do not include the end of string character in the compressed data
+			 */
+			write_count = libewf_section_write_compressed_string(
+				       section_descriptor,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       2,
+				       LIBEWF_SECTION_TYPE_DEVICE_INFORMATION,
+				       NULL,
+				       0,
+				       section_correction->start_offset,
+				       io_handle->compression_method,
+				       LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+				       write_io_handle->device_information,
+				       write_io_handle->device_information_size - 2,
+				       (size_t) section_correction->data_size,
+				       error );
+		}
+		else if( section_correction->type == LIBEWF_SECTION_TYPE_CASE_DATA )
+		{
+			if( write_io_handle->case_data == NULL )
+			{
+				if( libewf_case_data_generate(
+				     &( write_io_handle->case_data ),
+				     &( write_io_handle->case_data_size ),
+				     media_values,
+				     header_values,
+				     write_io_handle->timestamp,
+				     io_handle->format,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to generate case data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* Do not include the end of string character in the compressed data
+			 */
+			write_count = libewf_section_write_compressed_string(
+				       section_descriptor,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       2,
+				       LIBEWF_SECTION_TYPE_CASE_DATA,
+				       NULL,
+				       0,
+				       section_correction->start_offset,
+				       io_handle->compression_method,
+				       LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+				       write_io_handle->case_data,
+				       write_io_handle->case_data_size - 2,
+				       (size_t) section_correction->data_size,
+				       error );
+		}
+		else if( ( section_correction->type_string_length == 6 )
+		      && ( memory_compare(
+		            section_correction->type_string,
+		            "volume",
+		            6 ) == 0 ) )
+		{
+			if( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 )
+			{
+				write_count = libewf_volume_section_e01_write_file_io_pool(
+					       section_descriptor,
+					       io_handle,
+					       file_io_pool,
+					       file_io_pool_entry,
+					       section_correction->start_offset,
+					       media_values,
+					       error );
+			}
+			else if( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+			{
+				write_count = libewf_volume_section_s01_write_file_io_pool(
+					       section_descriptor,
+					       io_handle,
+					       file_io_pool,
+					       file_io_pool_entry,
+					       section_correction->start_offset,
+					       media_values,
+					       error );
+			}
+		}
+		else if( ( section_correction->type_string_length == 4 )
+		      && ( memory_compare(
+		            section_correction->type_string,
+		            "data",
+		            4 ) == 0 ) )
+		{
+			write_count = libewf_section_data_write(
+				       section_descriptor,
+				       io_handle,
+				       file_io_pool,
+				       file_io_pool_entry,
+				       section_correction->start_offset,
+				       media_values,
+				       &( write_io_handle->data_section ),
+				       error );
+		}
+		if( write_count == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections correction to segment file: %" PRIu32 ".",
+			 "%s: unable to correct section at offset: %" PRIi64 " (0x%08" PRIx64 ") in segment file: %" PRIu32 ".",
 			 function,
+			 section_correction->start_offset,
+			 section_correction->start_offset,
 			 segment_number );
 
-			return( -1 );
+			goto on_error;
 		}
+		result = 1;
 	}
-	return( 1 );
+	if( section_descriptor != NULL )
+	{
+		if( libewf_section_descriptor_free(
+		     &section_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( section_descriptor != NULL )
+	{
+		libewf_section_descriptor_free(
+		 &section_descriptor,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the position of the recorded section corrections of a specific segment file
+ * The section correction index is moved to the first section correction of the segment file
+ * Requires generated data is set if correcting the segment file would generate the device
+ * information, case data or data section that is shared with the other segment files
+ * Returns 1 if successful, 0 if no corrections were recorded for the segment file or -1 on error
+ */
+int libewf_write_io_handle_get_segment_section_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     uint32_t segment_number,
+     int *section_correction_index,
+     uint8_t *requires_generated_data,
+     libcerror_error_t **error )
+{
+	libewf_section_correction_t *section_correction = NULL;
+	static char *function                           = "libewf_write_io_handle_get_segment_section_corrections";
+	int correction_index                            = 0;
+	int number_of_section_corrections               = 0;
+	int result                                      = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( section_correction_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid section correction index.",
+		 function );
+
+		return( -1 );
+	}
+	if( requires_generated_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid requires generated data.",
+		 function );
+
+		return( -1 );
+	}
+	*requires_generated_data = 0;
+
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->section_corrections,
+	     &number_of_section_corrections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of section corrections.",
+		 function );
+
+		return( -1 );
+	}
+	/* The section corrections are stored in order of segment number
+	 */
+	for( correction_index = *section_correction_index;
+	     correction_index < number_of_section_corrections;
+	     correction_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->section_corrections,
+		     correction_index,
+		     (intptr_t **) &section_correction,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section correction: %d.",
+			 function,
+			 correction_index );
+
+			return( -1 );
+		}
+		if( section_correction == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section correction: %d.",
+			 function,
+			 correction_index );
+
+			return( -1 );
+		}
+		if( section_correction->segment_number > segment_number )
+		{
+			break;
+		}
+		if( section_correction->segment_number < segment_number )
+		{
+			*section_correction_index = correction_index + 1;
+
+			continue;
+		}
+		result = 1;
+
+		if( section_correction->type == LIBEWF_SECTION_TYPE_DEVICE_INFORMATION )
+		{
+			if( write_io_handle->device_information == NULL )
+			{
+				*requires_generated_data = 1;
+			}
+		}
+		else if( section_correction->type == LIBEWF_SECTION_TYPE_CASE_DATA )
+		{
+			if( write_io_handle->case_data == NULL )
+			{
+				*requires_generated_data = 1;
+			}
+		}
+		else if( ( section_correction->type_string_length == 4 )
+		      && ( memory_compare(
+		            section_correction->type_string,
+		            "data",
+		            4 ) == 0 ) )
+		{
+			if( write_io_handle->data_section == NULL )
+			{
+				*requires_generated_data = 1;
+			}
+		}
+	}
+	return( result );
+}
+
+/* Corrects sections after streamed write
+ * Segment files for which the section corrections were recorded on write are
+ * corrected without reading them again, segment files that do not contain
+ * sections that need to be corrected are skipped and not reopened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_finalize_write_sections_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfvalue_table_t *header_values,
+     libfvalue_table_t *hash_values,
+     libewf_hash_sections_t *hash_sections,
+     libcdata_array_t *sessions,
+     libcdata_array_t *tracks,
+     libcdata_range_list_t *acquiry_errors,
+     int (*progress_callback)(
+            void *user_data,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *progress_callback_user_data,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                = NULL;
+	libbfio_handle_t *segment_file_io_handle        = NULL;
+	libewf_section_corrector_t *section_corrector   = NULL;
+	libewf_segment_file_t *segment_file             = NULL;
+	static char *function                           = "libewf_write_io_handle_finalize_write_sections_corrections";
+	size64_t segment_file_size                      = 0;
+	uint32_t number_of_segments                     = 0;
+	uint32_t segment_number                         = 0;
+	uint8_t requires_generated_data                 = 0;
+	int file_io_pool_entry                          = 0;
+	int last_segment_file                           = 0;
+	int number_of_threads                           = 0;
+	int result                                      = 0;
+	int section_correction_index                    = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The last segment file is always corrected by the calling thread
+	 */
+	if( number_of_segments > 2 )
+	{
+		number_of_threads = (int) number_of_segments - 1;
+
+		if( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_CORRECTION_THREADS )
+		{
+			number_of_threads = LIBEWF_MAXIMUM_NUMBER_OF_CORRECTION_THREADS;
+		}
+		if( libewf_section_corrector_initialize(
+		     &section_corrector,
+		     write_io_handle,
+		     io_handle,
+		     media_values,
+		     header_values,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create section corrector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( segment_number == ( number_of_segments - 1 ) )
+		{
+			last_segment_file = 1;
+		}
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		result = 0;
+
+		/* The last segment file is always corrected using its sections list
+		 * since its next section needs to be replaced by a done section
+		 */
+		if( last_segment_file == 0 )
+		{
+			/* The section corrections use the segment number, which starts at 1
+			 */
+			result = libewf_write_io_handle_get_segment_section_corrections(
+			          write_io_handle,
+			          segment_number + 1,
+			          &section_correction_index,
+			          &requires_generated_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve section corrections of segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			/* Only the first segment file of a SMART (EWF-S01) image contains
+			 * a section that needs to be corrected
+			 */
+			else if( ( result == 0 )
+			      && ( segment_number > 0 )
+			      && ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART ) )
+			{
+				result = 2;
+			}
+		}
+		else if( section_corrector != NULL )
+		{
+			if( libewf_section_corrector_join(
+			     section_corrector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write section corrections to segment files.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The device information, case data and data section are generated once
+		 * and then shared, hence only segment files that do not require them to be
+		 * generated are corrected concurrently
+		 */
+		if( ( result == 1 )
+		 && ( requires_generated_data == 0 )
+		 && ( section_corrector != NULL ) )
+		{
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file IO handle of segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			if( libbfio_handle_clone(
+			     &file_io_handle,
+			     segment_file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create file IO handle of segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			/* The section corrector takes over management of the file IO handle
+			 */
+			result = libewf_section_corrector_push(
+			          section_corrector,
+			          file_io_handle,
+			          segment_number + 1,
+			          section_correction_index,
+			          error );
+
+			file_io_handle = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push segment file: %" PRIu32 " onto section corrector.",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+		}
+		else if( result != 2 )
+		{
+			if( libbfio_pool_reopen(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     LIBBFIO_OPEN_READ_WRITE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to reopen segment file: %" PRIu32 " for write corrections.",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			if( result == 1 )
+			{
+				if( libewf_write_io_handle_write_segment_section_corrections(
+				     write_io_handle,
+				     io_handle,
+				     file_io_pool,
+				     file_io_pool_entry,
+				     segment_number + 1,
+				     media_values,
+				     header_values,
+				     &section_correction_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write section corrections to segment file: %" PRIu32 ".",
+					 function,
+					 segment_number );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				segment_file = NULL;
+
+				if( libewf_segment_table_get_segment_file_by_index(
+				     segment_table,
+				     segment_number,
+				     file_io_pool,
+				     &segment_file,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+					 function,
+					 segment_number );
+
+					goto on_error;
+				}
+				if( libewf_segment_file_write_sections_correction(
+				     segment_file,
+				     file_io_pool,
+				     file_io_pool_entry,
+				     write_io_handle->number_of_chunks_written_to_segment_file,
+				     last_segment_file,
+				     media_values,
+				     header_values,
+				     write_io_handle->timestamp,
+				     hash_values,
+				     hash_sections,
+				     sessions,
+				     tracks,
+				     acquiry_errors,
+				     &( write_io_handle->case_data ),
+				     &( write_io_handle->case_data_size ),
+				     &( write_io_handle->device_information ),
+				     &( write_io_handle->device_information_size ),
+				     &( write_io_handle->data_section ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write sections correction to segment file: %" PRIu32 ".",
+					 function,
+					 segment_number );
+
+					goto on_error;
+				}
+			}
+		}
+		/* Segment files that are corrected concurrently are reported when queued
+		 */
+		if( progress_callback != NULL )
+		{
+			if( progress_callback(
+			     progress_callback_user_data,
+			     (uint64_t) segment_number + 1,
+			     (uint64_t) number_of_segments ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: progress callback failed for segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+		}
+	}
+	if( section_corrector != NULL )
+	{
+		if( libewf_section_corrector_free(
+		     &section_corrector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free section corrector.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( section_corrector != NULL )
+	{
+		libewf_section_corrector_free(
+		 &section_corrector,
+		 NULL );
+	}
+	return( -1 );
 }
 
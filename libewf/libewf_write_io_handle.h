@@ -34,6 +34,7 @@
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_empty_block_cache.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
@@ -149,6 +150,10 @@ struct libewf_write_io_handle
 	 */
 	libcdata_array_t *chunks_section;
 
+	/* The array of sections that need to be corrected after a streamed write
+	 */
+	libcdata_array_t *section_corrections;
+
 	/* The number of bytes written to a section containing chunks
 	 */
 	ssize64_t chunks_section_write_count;
@@ -220,6 +225,10 @@ struct libewf_write_io_handle
 	/* The size of the compressed zero byte empty block
 	 */
 	size_t compressed_zero_byte_empty_block_size;
+
+	/* The compressed empty block cache for other fill bytes
+	 */
+	libewf_empty_block_cache_t *empty_block_cache;
 };
 
 int libewf_write_io_handle_initialize(
@@ -370,8 +379,27 @@ ssize_t libewf_write_io_handle_write_new_chunk(
          size_t input_data_size,
          libcerror_error_t **error );
 
+int libewf_write_io_handle_write_segment_section_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libewf_media_values_t *media_values,
+     libfvalue_table_t *header_values,
+     int *section_correction_index,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_get_segment_section_corrections(
+     libewf_write_io_handle_t *write_io_handle,
+     uint32_t segment_number,
+     int *section_correction_index,
+     uint8_t *requires_generated_data,
+     libcerror_error_t **error );
+
 int libewf_write_io_handle_finalize_write_sections_corrections(
      libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
      libewf_media_values_t *media_values,
      libewf_segment_table_t *segment_table,
@@ -381,6 +409,11 @@ int libewf_write_io_handle_finalize_write_sections_corrections(
      libcdata_array_t *sessions,
      libcdata_array_t *tracks,
      libcdata_range_list_t *acquiry_errors,
+     int (*progress_callback)(
+            void *user_data,
+            uint64_t value,
+            uint64_t maximum_value ),
+     void *progress_callback_user_data,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -110,6 +110,14 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
   dnl Headers included in ewftools/ewfmount.c
   AC_CHECK_HEADERS([errno.h sys/time.h])
 
+  dnl Headers and functions included in ewftools/system_resources.c
+  AC_CHECK_HEADERS([sched.h])
+
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_FUNCS([sched_getaffinity sysconf])
+  ])
+
   dnl Functions included in ewftools/mount_file_system.c and ewftools/mount_file_entry.c
   AS_IF(
     [test "x$ac_cv_enable_winapi" = xno],
@@ -1657,6 +1657,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1725,6 +1726,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          NULL,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1745,6 +1747,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	chunk_data->compressed_data = NULL;
@@ -1765,6 +1768,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          NULL,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1783,6 +1787,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          (size_t) SSIZE_MAX + 1,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1801,6 +1806,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          0,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -1825,6 +1831,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	if( ewf_test_malloc_attempts_before_fail != -1 )
@@ -1855,6 +1862,7 @@ int ewf_test_chunk_data_pack_with_empty_block_compression(
 	          chunk_data,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
 	          &error );
 
 	if( ewf_test_memcpy_attempts_before_fail != -1 )
@@ -2369,6 +2377,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2402,6 +2411,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
 	          &error );
 
@@ -2477,6 +2487,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2554,6 +2565,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2640,6 +2652,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2717,6 +2730,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING,
 	          &error );
 
@@ -2792,6 +2806,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2816,6 +2831,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2838,6 +2854,7 @@ int ewf_test_chunk_data_pack(
 	          NULL,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2862,6 +2879,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          0,
 	          &error );
 
@@ -2894,6 +2912,7 @@ int ewf_test_chunk_data_pack(
 	          io_handle,
 	          compressed_zero_byte_empty_block,
 	          32,
+	          NULL,
 	          LIBEWF_PACK_FLAG_ADD_ALIGNMENT_PADDING,
 	          &error );
 
@@ -3776,6 +3795,202 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_check_for_fill_byte function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_check_for_fill_byte(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	void *memset_result      = NULL;
+	uint8_t fill_byte        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 buffer,
+	                 0xff,
+	                 512 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	/* Test regular cases
+	 */
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          512,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "fill_byte",
+	 fill_byte,
+	 (uint8_t) 0xff );
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          &( buffer[ 1 ] ),
+	          512 - 3,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer[ 500 ] = (uint8_t) 'A';
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          512,
+	          &fill_byte,
+	          &error );
+
+	buffer[ 500 ] = 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer[ 3 ] = (uint8_t) 'A';
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          512,
+	          &fill_byte,
+	          &error );
+
+	buffer[ 3 ] = 0xff;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          0,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          1,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_chunk_data_check_for_fill_byte(
+	          NULL,
+	          512,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          (size_t) SSIZE_MAX + 1,
+	          &fill_byte,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_check_for_fill_byte(
+	          buffer,
+	          512,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_check_for_64_bit_pattern_fill function
  * Returns 1 if successful or 0 if not
  */
@@ -5270,6 +5485,10 @@ int main(
 	 "libewf_chunk_data_check_for_empty_block",
 	 ewf_test_chunk_data_check_for_empty_block );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_check_for_fill_byte",
+	 ewf_test_chunk_data_check_for_fill_byte );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_check_for_64_bit_pattern_fill",
 	 ewf_test_chunk_data_check_for_64_bit_pattern_fill );
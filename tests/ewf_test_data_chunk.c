@@ -584,6 +584,130 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_data_chunk_get_stored_data_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_get_stored_data_size(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t stored_data_size  = 0;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_data_chunk_get_stored_data_size(
+	          NULL,
+	          &stored_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_data_chunk_read_stored_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_read_stored_buffer(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	ssize_t read_count        = 0;
+	uint32_t chunk_data_flags = 0;
+
+	/* Test error cases
+	 */
+	read_count = libewf_data_chunk_read_stored_buffer(
+	              NULL,
+	              NULL,
+	              0,
+	              &chunk_data_flags,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_data_chunk_write_stored_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_write_stored_buffer(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	ssize_t write_count      = 0;
+
+	/* Test error cases
+	 */
+	write_count = libewf_data_chunk_write_stored_buffer(
+	               NULL,
+	               NULL,
+	               0,
+	               0,
+	               0,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -627,6 +751,18 @@ int main(
 	 "libewf_data_chunk_write_buffer",
 	 ewf_test_data_chunk_write_buffer );
 
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_get_stored_data_size",
+	 ewf_test_data_chunk_get_stored_data_size );
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_read_stored_buffer",
+	 ewf_test_data_chunk_read_stored_buffer );
+
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_write_stored_buffer",
+	 ewf_test_data_chunk_write_stored_buffer );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -0,0 +1,563 @@
+/*
+ * Library empty_block_cache type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_empty_block_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_empty_block_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_empty_block_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_empty_block_cache_t *empty_block_cache = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libewf_empty_block_cache_initialize(
+	          &empty_block_cache,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "empty_block_cache",
+	 empty_block_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_empty_block_cache_free(
+	          &empty_block_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "empty_block_cache",
+	 empty_block_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_empty_block_cache_initialize(
+	          NULL,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	empty_block_cache = (libewf_empty_block_cache_t *) 0x12345678UL;
+
+	result = libewf_empty_block_cache_initialize(
+	          &empty_block_cache,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          &error );
+
+	empty_block_cache = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_empty_block_cache_initialize(
+	          &empty_block_cache,
+	          0,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "empty_block_cache",
+	 empty_block_cache );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_empty_block_cache_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = libewf_empty_block_cache_initialize(
+		          &empty_block_cache,
+		          32768,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( empty_block_cache != NULL )
+			{
+				libewf_empty_block_cache_free(
+				 &empty_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "empty_block_cache",
+			 empty_block_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libewf_empty_block_cache_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = libewf_empty_block_cache_initialize(
+		          &empty_block_cache,
+		          32768,
+		          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+		          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( empty_block_cache != NULL )
+			{
+				libewf_empty_block_cache_free(
+				 &empty_block_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "empty_block_cache",
+			 empty_block_cache );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( empty_block_cache != NULL )
+	{
+		libewf_empty_block_cache_free(
+		 &empty_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_empty_block_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_empty_block_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_empty_block_cache_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_empty_block_cache_get_compressed_block function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_empty_block_cache_get_compressed_block(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libewf_empty_block_cache_t *empty_block_cache = NULL;
+	const uint8_t *cached_compressed_block        = NULL;
+	const uint8_t *compressed_block               = NULL;
+	size_t compressed_block_size                  = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_empty_block_cache_initialize(
+	          &empty_block_cache,
+	          32768,
+	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
+	          LIBEWF_COMPRESSION_LEVEL_DEFAULT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "empty_block_cache",
+	 empty_block_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_empty_block_cache_get_compressed_block(
+	          empty_block_cache,
+	          32768,
+	          0xff,
+	          &compressed_block,
+	          &compressed_block_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "compressed_block",
+	 compressed_block );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "compressed_block_size",
+	 (int) compressed_block_size,
+	 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if the compressed block is reused
+	 */
+	cached_compressed_block = compressed_block;
+	compressed_block        = NULL;
+
+	result = libewf_empty_block_cache_get_compressed_block(
+	          empty_block_cache,
+	          32768,
+	          0xff,
+	          &compressed_block,
+	          &compressed_block_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INTPTR(
+	 "compressed_block",
+	 (intptr_t) compressed_block,
+	 (intptr_t) cached_compressed_block );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a different chunk size
+	 */
+	result = libewf_empty_block_cache_get_compressed_block(
+	          empty_block_cache,
+	          65536,
+	          0xff,
+	          &compressed_block,
+	          &compressed_block_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_empty_block_cache_get_compressed_block(
+	          NULL,
+	          32768,
+	          0xff,
+	          &compressed_block,
+	          &compressed_block_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_empty_block_cache_get_compressed_block(
+	          empty_block_cache,
+	          32768,
+	          0xff,
+	          NULL,
+	          &compressed_block_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_empty_block_cache_get_compressed_block(
+	          empty_block_cache,
+	          32768,
+	          0xff,
+	          &compressed_block,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_empty_block_cache_free(
+	          &empty_block_cache,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "empty_block_cache",
+	 empty_block_cache );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( empty_block_cache != NULL )
+	{
+		libewf_empty_block_cache_free(
+		 &empty_block_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_empty_block_cache_initialize",
+	 ewf_test_empty_block_cache_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_empty_block_cache_free",
+	 ewf_test_empty_block_cache_free );
+
+	/* TODO: add tests for libewf_empty_block_cache_compress_block */
+
+	EWF_TEST_RUN(
+	 "libewf_empty_block_cache_get_compressed_block",
+	 ewf_test_empty_block_cache_get_compressed_block );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+}
+
@@ -56,6 +56,8 @@
 
 #define EWF_TEST_HANDLE_READ_BUFFER_SIZE	4096
 
+#define EWF_TEST_HANDLE_WRITE_CHUNK_SIZE	32768
+
 #if !defined( LIBEWF_HAVE_BFIO )
 
 LIBEWF_EXTERN \
@@ -3042,6 +3044,516 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_write_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_write_flags(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	uint8_t write_flags      = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_write_flags(
+	          handle,
+	          &write_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_write_flags(
+	          NULL,
+	          &write_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_write_flags(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_write_data_chunk_at_index function
+ * Writes the chunks in shuffled order and reads the image back
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_write_data_chunk_at_index(
+     void )
+{
+	uint8_t chunk_buffer[ EWF_TEST_HANDLE_WRITE_CHUNK_SIZE ];
+
+	const system_character_t *filename      = _SYSTEM_STRING( "ewf_test_handle_write" );
+	const system_character_t *read_filename = _SYSTEM_STRING( "ewf_test_handle_write.E01" );
+	uint64_t chunk_indexes[ 8 ]             = { 3, 0, 5, 1, 7, 2, 6, 4 };
+	libcerror_error_t *error                = NULL;
+	libewf_data_chunk_t *data_chunk         = NULL;
+	libewf_handle_t *handle                 = NULL;
+	size_t buffer_index                     = 0;
+	ssize_t process_count                   = 0;
+	uint64_t chunk_index                    = 0;
+	int chunk_iterator                      = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_initialize(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) &filename,
+	          1,
+	          LIBEWF_OPEN_WRITE,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) &filename,
+	          1,
+	          LIBEWF_OPEN_WRITE,
+	          &error );
+#endif
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_sectors_per_chunk(
+	          handle,
+	          EWF_TEST_HANDLE_WRITE_CHUNK_SIZE / 512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_media_size(
+	          handle,
+	          8 * EWF_TEST_HANDLE_WRITE_CHUNK_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data_chunk",
+	 data_chunk );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_iterator = 0;
+	     chunk_iterator < 8;
+	     chunk_iterator++ )
+	{
+		chunk_index = chunk_indexes[ chunk_iterator ];
+
+		for( buffer_index = 0;
+		     buffer_index < EWF_TEST_HANDLE_WRITE_CHUNK_SIZE;
+		     buffer_index++ )
+		{
+			chunk_buffer[ buffer_index ] = (uint8_t) ( ( chunk_index * 7 ) + ( buffer_index / 512 ) );
+		}
+		process_count = libewf_data_chunk_write_buffer(
+		                 data_chunk,
+		                 chunk_buffer,
+		                 EWF_TEST_HANDLE_WRITE_CHUNK_SIZE,
+		                 &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "process_count",
+		 process_count,
+		 (ssize_t) EWF_TEST_HANDLE_WRITE_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		process_count = libewf_handle_write_data_chunk_at_index(
+		                 handle,
+		                 data_chunk,
+		                 chunk_index,
+		                 &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "process_count",
+		 process_count,
+		 (ssize_t) EWF_TEST_HANDLE_WRITE_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	process_count = libewf_handle_write_data_chunk_at_index(
+	                 NULL,
+	                 data_chunk,
+	                 0,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	process_count = libewf_handle_write_data_chunk_at_index(
+	                 handle,
+	                 NULL,
+	                 0,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	process_count = libewf_data_chunk_write_buffer(
+	                 data_chunk,
+	                 chunk_buffer,
+	                 EWF_TEST_HANDLE_WRITE_CHUNK_SIZE,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) EWF_TEST_HANDLE_WRITE_CHUNK_SIZE );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	process_count = libewf_handle_write_data_chunk_at_index(
+	                 handle,
+	                 data_chunk,
+	                 8,
+	                 &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "process_count",
+	 process_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the image contains the chunks in order
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libewf_handle_open_wide(
+	          handle,
+	          (wchar_t * const *) &read_filename,
+	          1,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#else
+	result = libewf_handle_open(
+	          handle,
+	          (char * const *) &read_filename,
+	          1,
+	          LIBEWF_OPEN_READ,
+	          &error );
+#endif
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( chunk_index = 0;
+	     chunk_index < 8;
+	     chunk_index++ )
+	{
+		process_count = libewf_handle_read_buffer(
+		                 handle,
+		                 chunk_buffer,
+		                 EWF_TEST_HANDLE_WRITE_CHUNK_SIZE,
+		                 &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "process_count",
+		 process_count,
+		 (ssize_t) EWF_TEST_HANDLE_WRITE_CHUNK_SIZE );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		for( buffer_index = 0;
+		     buffer_index < EWF_TEST_HANDLE_WRITE_CHUNK_SIZE;
+		     buffer_index += 512 )
+		{
+			EWF_TEST_ASSERT_EQUAL_UINT8(
+			 "chunk_buffer[ buffer_index ]",
+			 chunk_buffer[ buffer_index ],
+			 (uint8_t) ( ( chunk_index * 7 ) + ( buffer_index / 512 ) ) );
+		}
+	}
+	result = libewf_handle_close(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_free(
+	          &handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_reorder_window_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_reorder_window_size(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_chunks     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_reorder_window_size(
+	          handle,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_reorder_window_size(
+	          NULL,
+	          &number_of_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_reorder_window_size(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_filename_size function
  * Returns 1 if successful or 0 if not
  */
@@ -4197,6 +4709,95 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_verify_chunks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_verify_chunks(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_verify_chunks(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libewf_handle_verify_chunks(
+	          handle,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Test error cases
+	 */
+	result = libewf_handle_verify_chunks(
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_verify_chunks(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_number_of_checksum_errors function
  * Returns 1 if successful or 0 if not
  */
@@ -4700,6 +5301,10 @@ int main(
 	 "libewf_handle_clone",
 	 ewf_test_handle_clone );
 
+	EWF_TEST_RUN(
+	 "libewf_handle_write_data_chunk_at_index",
+	 ewf_test_handle_write_data_chunk_at_index );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -4925,12 +5530,29 @@ int main(
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
+		/* TODO: add tests for libewf_internal_handle_write_chunk_data_to_file_io_pool */
+
 		/* TODO: add tests for libewf_internal_handle_write_data_chunk_to_file_io_pool */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 		/* TODO: add tests for libewf_handle_write_data_chunk */
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_write_chunk_data_at_index */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_reorder_window_size",
+		 ewf_test_handle_get_chunk_reorder_window_size,
+		 handle );
+
+		/* TODO: add tests for libewf_handle_set_chunk_reorder_window_size */
+
+		/* TODO: add tests for libewf_handle_set_progress_callback */
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_finalize_file_io_pool */
@@ -4990,6 +5612,13 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_segment_size */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_write_flags",
+		 ewf_test_handle_get_write_flags,
+		 handle );
+
+		/* TODO: add tests for libewf_handle_set_write_flags */
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_filename_size",
 		 ewf_test_handle_get_filename_size,
@@ -5145,6 +5774,11 @@ int main(
 
 		/* TODO: add tests for libewf_handle_append_acquiry_error */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_verify_chunks",
+		 ewf_test_handle_verify_chunks,
+		 handle );
+
 		EWF_TEST_RUN_WITH_ARGS(
 		 "libewf_handle_get_number_of_checksum_errors",
 		 ewf_test_handle_get_number_of_checksum_errors,
@@ -0,0 +1,632 @@
+/*
+ * Tools batch_file functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/batch_file.h"
+
+/* Tests the batch_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_batch_file_initialize(
+     void )
+{
+	batch_file_t *batch_file        = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = batch_file_initialize(
+	          &batch_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "batch_file",
+	 batch_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "batch_file->number_of_jobs",
+	 batch_file->number_of_jobs,
+	 0 );
+
+	result = batch_file_free(
+	          &batch_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "batch_file",
+	 batch_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = batch_file_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	batch_file = (batch_file_t *) 0x12345678UL;
+
+	result = batch_file_initialize(
+	          &batch_file,
+	          &error );
+
+	batch_file = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test batch_file_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = batch_file_initialize(
+		          &batch_file,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( batch_file != NULL )
+			{
+				batch_file_free(
+				 &batch_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "batch_file",
+			 batch_file );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( batch_file != NULL )
+	{
+		batch_file_free(
+		 &batch_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the batch_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_batch_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = batch_file_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the batch_file_parse_line function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_batch_file_parse_line(
+     void )
+{
+	batch_file_t *batch_file = NULL;
+	batch_job_t *batch_job   = NULL;
+	libcerror_error_t *error = NULL;
+	int number_of_jobs       = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = batch_file_initialize(
+	          &batch_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "batch_file",
+	 batch_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "/dev/sdb\tcase1/sdb\tE001\tWorkstation disk" ),
+	          40,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "/dev/sdc\tcase1/sdc" ),
+	          18,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Comments and empty lines do not add a job
+	 */
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "# source\ttarget" ),
+	          15,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "" ),
+	          0,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = batch_file_get_number_of_jobs(
+	          batch_file,
+	          &number_of_jobs,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_jobs",
+	 number_of_jobs,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = batch_file_get_job_by_index(
+	          batch_file,
+	          0,
+	          &batch_job,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "batch_job",
+	 batch_job );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "batch_job->source_filename_size",
+	 batch_job->source_filename_size,
+	 (size_t) 9 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "batch_job->target_filename_size",
+	 batch_job->target_filename_size,
+	 (size_t) 10 );
+
+	result = system_string_compare(
+	          batch_job->target_filename,
+	          _SYSTEM_STRING( "case1/sdb" ),
+	          9 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "batch_job->evidence_number_size",
+	 batch_job->evidence_number_size,
+	 (size_t) 5 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "batch_job->description_size",
+	 batch_job->description_size,
+	 (size_t) 17 );
+
+	result = batch_file_get_job_by_index(
+	          batch_file,
+	          1,
+	          &batch_job,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "batch_job",
+	 batch_job );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "batch_job->evidence_number",
+	 batch_job->evidence_number );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "batch_job->description",
+	 batch_job->description );
+
+	/* Test error cases
+	 */
+	result = batch_file_parse_line(
+	          NULL,
+	          _SYSTEM_STRING( "/dev/sdd\tcase1/sdd" ),
+	          18,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = batch_file_parse_line(
+	          batch_file,
+	          NULL,
+	          18,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a line without a target
+	 */
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "/dev/sdd" ),
+	          8,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a line with too many values
+	 */
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "/dev/sdd\tcase1/sdd\tE003\tdisk\textra" ),
+	          34,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a line with a target that is already used
+	 */
+	result = batch_file_parse_line(
+	          batch_file,
+	          _SYSTEM_STRING( "/dev/sdd\tcase1/sdc" ),
+	          18,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = batch_file_get_number_of_jobs(
+	          batch_file,
+	          &number_of_jobs,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_jobs",
+	 number_of_jobs,
+	 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = batch_file_get_job_by_index(
+	          batch_file,
+	          2,
+	          &batch_job,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = batch_file_free(
+	          &batch_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "batch_file",
+	 batch_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( batch_file != NULL )
+	{
+		batch_file_free(
+		 &batch_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "batch_file_initialize",
+	 ewf_test_tools_batch_file_initialize );
+
+	EWF_TEST_RUN(
+	 "batch_file_free",
+	 ewf_test_tools_batch_file_free );
+
+	EWF_TEST_RUN(
+	 "batch_file_parse_line",
+	 ewf_test_tools_batch_file_parse_line );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1096 @@
+/*
+ * Tools buffer_limiter functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/buffer_limiter.h"
+#include "../ewftools/stage_profiler.h"
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Tests the buffer_limiter_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_buffer_limiter_initialize(
+     void )
+{
+	buffer_limiter_t *buffer_limiter                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	stage_profiler_t *stage_profiler                = NULL;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &storage_media_buffer_queue,
+	          NULL,
+	          8,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer_limiter",
+	 buffer_limiter );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The buffer limiter starts with the minimum number of buffers in flight
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_buffers",
+	 buffer_limiter->number_of_buffers,
+	 2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_reserved_buffers",
+	 buffer_limiter->number_of_reserved_buffers,
+	 6 );
+
+	result = buffer_limiter_free(
+	          &buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "buffer_limiter",
+	 buffer_limiter );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = buffer_limiter_initialize(
+	          NULL,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	buffer_limiter = (buffer_limiter_t *) 0x12345678UL;
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	buffer_limiter = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          NULL,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          NULL,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          0,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &buffer_limiter,
+		 NULL );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the buffer_limiter_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_buffer_limiter_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = buffer_limiter_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the buffer_limiter_set_number_of_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_buffer_limiter_set_number_of_buffers(
+     void )
+{
+	storage_media_buffer_t *storage_media_buffers[ 8 ];
+
+	buffer_limiter_t *buffer_limiter                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	stage_profiler_t *stage_profiler                = NULL;
+	int buffer_index                                = 0;
+	int number_of_buffers                           = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &storage_media_buffer_queue,
+	          NULL,
+	          8,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = buffer_limiter_set_number_of_buffers(
+	          buffer_limiter,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_get_number_of_buffers(
+	          buffer_limiter,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 5 );
+
+	/* The released buffers can be grabbed from the queue, while the reserved buffers cannot
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 5;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_queue_grab_buffer(
+		          storage_media_buffer_queue,
+		          &( storage_media_buffers[ buffer_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_reserved_buffers",
+	 buffer_limiter->number_of_reserved_buffers,
+	 3 );
+
+	for( buffer_index = 0;
+	     buffer_index < 5;
+	     buffer_index++ )
+	{
+		result = storage_media_buffer_queue_release_buffer(
+		          storage_media_buffer_queue,
+		          storage_media_buffers[ buffer_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = buffer_limiter_set_number_of_buffers(
+	          buffer_limiter,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_reserved_buffers",
+	 buffer_limiter->number_of_reserved_buffers,
+	 5 );
+
+	result = buffer_limiter_set_number_of_buffers(
+	          buffer_limiter,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_reserved_buffers",
+	 buffer_limiter->number_of_reserved_buffers,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = buffer_limiter_set_number_of_buffers(
+	          NULL,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_set_number_of_buffers(
+	          buffer_limiter,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_set_number_of_buffers(
+	          buffer_limiter,
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_get_number_of_buffers(
+	          NULL,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = buffer_limiter_get_number_of_buffers(
+	          buffer_limiter,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = buffer_limiter_free(
+	          &buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &buffer_limiter,
+		 NULL );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the buffer_limiter_adjust function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_buffer_limiter_adjust(
+     void )
+{
+	buffer_limiter_t *buffer_limiter                = NULL;
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	stage_profiler_t *stage_profiler                = NULL;
+	int64_t timestamp                               = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &storage_media_buffer_queue,
+	          NULL,
+	          8,
+	          STORAGE_MEDIA_BUFFER_MODE_BUFFERED,
+	          512,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_start(
+	          stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_initialize(
+	          &buffer_limiter,
+	          storage_media_buffer_queue,
+	          stage_profiler,
+	          2,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Adjust on every call
+	 */
+	buffer_limiter->adjustment_interval = 0;
+
+	/* Test that nothing is adjusted if no buffer was read
+	 */
+	result = buffer_limiter_adjust(
+	          buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that reading that stalled while all the buffers were in flight increases the number of buffers
+	 */
+	result = stage_profiler_get_timestamp(
+	          &timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_wait(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_READ,
+	          timestamp - ( 2 * STAGE_PROFILER_STALL_THRESHOLD ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_IN_FLIGHT,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_adjust(
+	          buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_buffers",
+	 buffer_limiter->number_of_buffers,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_reserved_buffers",
+	 buffer_limiter->number_of_reserved_buffers,
+	 5 );
+
+	/* Test that samples of the previous adjustment are not used again
+	 */
+	result = buffer_limiter_adjust(
+	          buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that reading that did not stall while few buffers were in flight decreases the number of buffers
+	 */
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_IN_FLIGHT,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_adjust(
+	          buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_buffers",
+	 buffer_limiter->number_of_buffers,
+	 2 );
+
+	/* Test that the adjustment waits for the interval to pass
+	 */
+	buffer_limiter->adjustment_interval = (uint64_t) 3600 * 1000000000UL;
+
+	result = stage_profiler_add_wait(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_READ,
+	          timestamp - ( 2 * STAGE_PROFILER_STALL_THRESHOLD ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_IN_FLIGHT,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = buffer_limiter_adjust(
+	          buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "buffer_limiter->number_of_buffers",
+	 buffer_limiter->number_of_buffers,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = buffer_limiter_adjust(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = buffer_limiter_free(
+	          &buffer_limiter,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer_limiter != NULL )
+	{
+		buffer_limiter_free(
+		 &buffer_limiter,
+		 NULL );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "buffer_limiter_initialize",
+	 ewf_test_tools_buffer_limiter_initialize );
+
+	EWF_TEST_RUN(
+	 "buffer_limiter_free",
+	 ewf_test_tools_buffer_limiter_free );
+
+	EWF_TEST_RUN(
+	 "buffer_limiter_set_number_of_buffers",
+	 ewf_test_tools_buffer_limiter_set_number_of_buffers );
+
+	EWF_TEST_RUN(
+	 "buffer_limiter_adjust",
+	 ewf_test_tools_buffer_limiter_adjust );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,1358 @@
+/*
+ * Tools checkpoint_file functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/checkpoint_file.h"
+#include "../ewftools/digest_context.h"
+
+#define EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET		512
+#define EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE		1048576
+
+/* The test writes ewf_test_checkpoint.checkpoint in the current working directory
+ */
+static system_character_t ewf_test_checkpoint_file_name[] = {
+	'e', 'w', 'f', '_', 't', 'e', 's', 't', '_', 'c', 'h', 'e', 'c', 'k', 'p', 'o', 'i', 'n', 't', 0 };
+
+static system_character_t ewf_test_checkpoint_file_full_name[] = {
+	'e', 'w', 'f', '_', 't', 'e', 's', 't', '_', 'c', 'h', 'e', 'c', 'k', 'p', 'o', 'i', 'n', 't',
+	'.', 'c', 'h', 'e', 'c', 'k', 'p', 'o', 'i', 'n', 't', 0 };
+
+static system_character_t ewf_test_checkpoint_file_temporary_name[] = {
+	'e', 'w', 'f', '_', 't', 'e', 's', 't', '_', 'c', 'h', 'e', 'c', 'k', 'p', 'o', 'i', 'n', 't',
+	'.', 'c', 'h', 'e', 'c', 'k', 'p', 'o', 'i', 'n', 't', '.', 't', 'm', 'p', 0 };
+
+/* Creates a checkpoint file with the test values
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_checkpoint_file_create(
+     checkpoint_file_t **checkpoint_file,
+     uint64_t acquiry_offset,
+     uint64_t acquiry_size,
+     uint32_t digest_flags,
+     libcerror_error_t **error )
+{
+	if( checkpoint_file_initialize(
+	     checkpoint_file,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( checkpoint_file_set_filename(
+	     *checkpoint_file,
+	     ewf_test_checkpoint_file_name,
+	     system_string_length(
+	      ewf_test_checkpoint_file_name ),
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( checkpoint_file_set_values(
+	     *checkpoint_file,
+	     acquiry_offset,
+	     acquiry_size,
+	     digest_flags,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	checkpoint_file_free(
+	 checkpoint_file,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Writes a checkpoint file with 2 entries of the MD5 digest of a test pattern
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_checkpoint_file_write_entries(
+     checkpoint_file_t *checkpoint_file,
+     digest_context_t *md5_context,
+     libcerror_error_t **error )
+{
+	uint8_t data[ 4096 ];
+
+	size_t data_offset = 0;
+	int entry_index    = 0;
+
+	for( data_offset = 0;
+	     data_offset < 4096;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		if( digest_context_update(
+		     md5_context,
+		     data,
+		     4096,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		if( checkpoint_file_append_entry(
+		     checkpoint_file,
+		     (uint64_t) ( entry_index + 1 ) * 4096,
+		     md5_context,
+		     NULL,
+		     NULL,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( checkpoint_file_write(
+	     checkpoint_file,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Modifies the checkpoint file on disk
+ * Inverts the byte at the offset if the offset is not negative
+ * Truncates the file by 1 byte if truncate is set
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_checkpoint_file_modify(
+     off64_t offset,
+     uint8_t truncate,
+     libcerror_error_t **error )
+{
+	uint8_t byte_value    = 0;
+	libcfile_file_t *file = NULL;
+	size64_t file_size    = 0;
+	int result            = 0;
+
+	if( libcfile_file_initialize(
+	     &file,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_open_wide(
+	          file,
+	          ewf_test_checkpoint_file_full_name,
+	          LIBCFILE_OPEN_READ_WRITE,
+	          error );
+#else
+	result = libcfile_file_open(
+	          file,
+	          ewf_test_checkpoint_file_full_name,
+	          LIBCFILE_OPEN_READ_WRITE,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( offset >= 0 )
+	{
+		if( libcfile_file_seek_offset(
+		     file,
+		     offset,
+		     SEEK_SET,
+		     error ) != offset )
+		{
+			goto on_error;
+		}
+		if( libcfile_file_read_buffer(
+		     file,
+		     &byte_value,
+		     1,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		byte_value ^= 0xff;
+
+		if( libcfile_file_seek_offset(
+		     file,
+		     offset,
+		     SEEK_SET,
+		     error ) != offset )
+		{
+			goto on_error;
+		}
+		if( libcfile_file_write_buffer(
+		     file,
+		     &byte_value,
+		     1,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( truncate != 0 )
+	{
+		if( libcfile_file_get_size(
+		     file,
+		     &file_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		if( libcfile_file_resize(
+		     file,
+		     file_size - 1,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	if( libcfile_file_close(
+	     file,
+	     error ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &file,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file != NULL )
+	{
+		libcfile_file_free(
+		 &file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the checkpoint_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_checkpoint_file_initialize(
+     void )
+{
+	checkpoint_file_t *checkpoint_file = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests    = 1;
+	int number_of_memset_fail_tests    = 1;
+	int test_number                    = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = checkpoint_file_initialize(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "checkpoint_file",
+	 checkpoint_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "checkpoint_file->number_of_entries",
+	 checkpoint_file->number_of_entries,
+	 0 );
+
+	result = checkpoint_file_free(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "checkpoint_file",
+	 checkpoint_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = checkpoint_file_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	checkpoint_file = (checkpoint_file_t *) 0x12345678UL;
+
+	result = checkpoint_file_initialize(
+	          &checkpoint_file,
+	          &error );
+
+	checkpoint_file = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test checkpoint_file_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = checkpoint_file_initialize(
+		          &checkpoint_file,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( checkpoint_file != NULL )
+			{
+				checkpoint_file_free(
+				 &checkpoint_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "checkpoint_file",
+			 checkpoint_file );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test checkpoint_file_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = checkpoint_file_initialize(
+		          &checkpoint_file,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( checkpoint_file != NULL )
+			{
+				checkpoint_file_free(
+				 &checkpoint_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "checkpoint_file",
+			 checkpoint_file );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the checkpoint_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_checkpoint_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = checkpoint_file_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the checkpoint_file_set_values function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_checkpoint_file_set_values(
+     void )
+{
+	checkpoint_file_t *checkpoint_file = NULL;
+	libcerror_error_t *error           = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = checkpoint_file_initialize(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "checkpoint_file",
+	 checkpoint_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = checkpoint_file_set_values(
+	          checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          CHECKPOINT_FILE_DIGEST_FLAG_MD5 | CHECKPOINT_FILE_DIGEST_FLAG_SHA256,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "checkpoint_file->acquiry_offset",
+	 checkpoint_file->acquiry_offset,
+	 (uint64_t) EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "checkpoint_file->acquiry_size",
+	 checkpoint_file->acquiry_size,
+	 (uint64_t) EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checkpoint_file->digest_flags",
+	 checkpoint_file->digest_flags,
+	 (uint32_t) ( CHECKPOINT_FILE_DIGEST_FLAG_MD5 | CHECKPOINT_FILE_DIGEST_FLAG_SHA256 ) );
+
+	/* Test error cases
+	 */
+	result = checkpoint_file_set_values(
+	          NULL,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = checkpoint_file_set_values(
+	          checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          0x08,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = checkpoint_file_free(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "checkpoint_file",
+	 checkpoint_file );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the checkpoint_file_write and checkpoint_file_read functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_checkpoint_file_write_read(
+     void )
+{
+	uint8_t expected_state[ DIGEST_CONTEXT_STATE_SIZE ];
+	uint8_t state[ DIGEST_CONTEXT_STATE_SIZE ];
+
+	checkpoint_file_t *checkpoint_file      = NULL;
+	checkpoint_file_t *read_checkpoint_file = NULL;
+	digest_context_t *md5_context           = NULL;
+	libcerror_error_t *error                = NULL;
+	uint64_t offset                         = 0;
+	int entry_index                         = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = digest_context_initialize(
+	          &md5_context,
+	          DIGEST_CONTEXT_TYPE_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_checkpoint_file_create(
+	          &checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = ewf_test_tools_checkpoint_file_write_entries(
+	          checkpoint_file,
+	          md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_get_state(
+	          md5_context,
+	          expected_state,
+	          DIGEST_CONTEXT_STATE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the temporary file was renamed over the checkpoint file
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libcfile_file_exists_wide(
+	          ewf_test_checkpoint_file_temporary_name,
+	          &error );
+#else
+	result = libcfile_file_exists(
+	          ewf_test_checkpoint_file_temporary_name,
+	          &error );
+#endif
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a round trip
+	 */
+	result = ewf_test_tools_checkpoint_file_create(
+	          &read_checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_read(
+	          read_checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_checkpoint_file->number_of_entries",
+	 read_checkpoint_file->number_of_entries,
+	 2 );
+
+	for( entry_index = 0;
+	     entry_index < 2;
+	     entry_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "read_checkpoint_file->entries[ entry_index ].offset",
+		 read_checkpoint_file->entries[ entry_index ].offset,
+		 checkpoint_file->entries[ entry_index ].offset );
+
+		result = memory_compare(
+		          read_checkpoint_file->entries[ entry_index ].digest_states[ 0 ],
+		          checkpoint_file->entries[ entry_index ].digest_states[ 0 ],
+		          DIGEST_CONTEXT_STATE_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test that restoring the last entry yields the digest state at that offset
+	 */
+	result = digest_context_reset(
+	          md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_restore_entry(
+	          read_checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          &offset,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "offset",
+	 offset,
+	 (uint64_t) 8192 );
+
+	result = digest_context_get_state(
+	          md5_context,
+	          state,
+	          DIGEST_CONTEXT_STATE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          state,
+	          expected_state,
+	          DIGEST_CONTEXT_STATE_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that an entry beyond the maximum offset is discarded
+	 */
+	result = checkpoint_file_restore_entry(
+	          read_checkpoint_file,
+	          8191,
+	          &offset,
+	          md5_context,
+	          NULL,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "offset",
+	 offset,
+	 (uint64_t) 4096 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "read_checkpoint_file->number_of_entries",
+	 read_checkpoint_file->number_of_entries,
+	 1 );
+
+	/* Test that writing replaces an existing checkpoint file
+	 */
+	result = checkpoint_file_write(
+	          read_checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_read(
+	          checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "checkpoint_file->number_of_entries",
+	 checkpoint_file->number_of_entries,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = checkpoint_file_write(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = checkpoint_file_read(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = checkpoint_file_remove(
+	          checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a missing checkpoint file does not apply
+	 */
+	result = checkpoint_file_read(
+	          checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_free(
+	          &read_checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_free(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &read_checkpoint_file,
+		 NULL );
+	}
+	if( checkpoint_file != NULL )
+	{
+		checkpoint_file_remove(
+		 checkpoint_file,
+		 NULL );
+		checkpoint_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		digest_context_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that checkpoint_file_read rejects a checkpoint file that does not apply
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_checkpoint_file_read_rejected(
+     void )
+{
+	uint64_t acquiry_offsets[ 5 ] = {
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET + 512,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET };
+
+	uint64_t acquiry_sizes[ 5 ] = {
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE * 2,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+		EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE };
+
+	uint32_t digest_flags[ 5 ] = {
+		CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+		CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+		CHECKPOINT_FILE_DIGEST_FLAG_MD5 | CHECKPOINT_FILE_DIGEST_FLAG_SHA1,
+		CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+		CHECKPOINT_FILE_DIGEST_FLAG_MD5 };
+
+	/* The entries checksum is corrupted by inverting a byte of the first entry
+	 * the size check by truncating the file
+	 */
+	off64_t modify_offsets[ 5 ] = { -1, -1, -1, CHECKPOINT_FILE_HEADER_SIZE + 8, -1 };
+	uint8_t modify_truncate[ 5 ] = { 0, 0, 0, 0, 1 };
+
+	checkpoint_file_t *checkpoint_file      = NULL;
+	checkpoint_file_t *read_checkpoint_file = NULL;
+	digest_context_t *md5_context           = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+	int test_index                          = 0;
+
+	/* Initialize test
+	 */
+	result = digest_context_initialize(
+	          &md5_context,
+	          DIGEST_CONTEXT_TYPE_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_checkpoint_file_create(
+	          &checkpoint_file,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+	          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+	          CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	for( test_index = 0;
+	     test_index < 5;
+	     test_index++ )
+	{
+		result = checkpoint_file_set_values(
+		          checkpoint_file,
+		          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_OFFSET,
+		          EWF_TEST_CHECKPOINT_FILE_ACQUIRY_SIZE,
+		          CHECKPOINT_FILE_DIGEST_FLAG_MD5,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = digest_context_reset(
+		          md5_context,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_tools_checkpoint_file_write_entries(
+		          checkpoint_file,
+		          md5_context,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( ( modify_offsets[ test_index ] >= 0 )
+		 || ( modify_truncate[ test_index ] != 0 ) )
+		{
+			result = ewf_test_tools_checkpoint_file_modify(
+			          modify_offsets[ test_index ],
+			          modify_truncate[ test_index ],
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		result = ewf_test_tools_checkpoint_file_create(
+		          &read_checkpoint_file,
+		          acquiry_offsets[ test_index ],
+		          acquiry_sizes[ test_index ],
+		          digest_flags[ test_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = checkpoint_file_read(
+		          read_checkpoint_file,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "read_checkpoint_file->number_of_entries",
+		 read_checkpoint_file->number_of_entries,
+		 0 );
+
+		result = checkpoint_file_free(
+		          &read_checkpoint_file,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Clean up
+	 */
+	result = checkpoint_file_remove(
+	          checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = checkpoint_file_free(
+	          &checkpoint_file,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_free(
+	          &md5_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_checkpoint_file != NULL )
+	{
+		checkpoint_file_free(
+		 &read_checkpoint_file,
+		 NULL );
+	}
+	if( checkpoint_file != NULL )
+	{
+		checkpoint_file_remove(
+		 checkpoint_file,
+		 NULL );
+		checkpoint_file_free(
+		 &checkpoint_file,
+		 NULL );
+	}
+	if( md5_context != NULL )
+	{
+		digest_context_free(
+		 &md5_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "checkpoint_file_initialize",
+	 ewf_test_tools_checkpoint_file_initialize );
+
+	EWF_TEST_RUN(
+	 "checkpoint_file_free",
+	 ewf_test_tools_checkpoint_file_free );
+
+	EWF_TEST_RUN(
+	 "checkpoint_file_set_values",
+	 ewf_test_tools_checkpoint_file_set_values );
+
+	EWF_TEST_RUN(
+	 "checkpoint_file_write_read",
+	 ewf_test_tools_checkpoint_file_write_read );
+
+	EWF_TEST_RUN(
+	 "checkpoint_file_read_rejected",
+	 ewf_test_tools_checkpoint_file_read_rejected );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -1079,6 +1079,59 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the device_handle_is_sparse function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_device_handle_is_sparse(
+     device_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = device_handle_is_sparse(
+	          handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = device_handle_is_sparse(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the device_handle_get_type function
  * Returns 1 if successful or 0 if not
  */
@@ -1671,6 +1724,11 @@ int main(
 	 "device_handle_close",
 	 ewf_test_tools_device_handle_close );
 
+	EWF_TEST_RUN_WITH_ARGS(
+	 "device_handle_is_sparse",
+	 ewf_test_tools_device_handle_is_sparse,
+	 device_handle );
+
 	/* TODO add tests for device_handle_read_storage_media_buffer */
 
 	/* TODO add tests for device_handle_seek_offset */
@@ -0,0 +1,293 @@
+/*
+ * Tools digest (hash) calculation backend benchmark program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <time.h>
+
+#include "ewf_test_libcerror.h"
+
+#include "../ewftools/digest_context.h"
+
+/* The benchmark is not part of the test suite, run it manually:
+ * ./ewf_test_tools_digest_benchmark [ size_in_mebibytes ]
+ */
+
+#define EWF_TEST_DIGEST_BENCHMARK_DEFAULT_SIZE		256
+#define EWF_TEST_DIGEST_BENCHMARK_BUFFER_SIZE		( 1024 * 1024 )
+
+const char *ewf_test_tools_digest_benchmark_type_names[ 4 ] = {
+	NULL, "MD5", "SHA1", "SHA256" };
+
+const char *ewf_test_tools_digest_benchmark_backend_names[ 4 ] = {
+	"auto", "generic", "sha-ni", "armv8" };
+
+/* Calculates a digest hash with a specific backend and prints the throughput
+ * Returns 1 if successful, 0 if the backend is not supported or -1 on error
+ */
+int ewf_test_tools_digest_benchmark_run(
+     int type,
+     int backend,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     size_t number_of_buffers,
+     uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	digest_context_t *digest_context = NULL;
+	clock_t end_time                 = 0;
+	clock_t start_time               = 0;
+	double elapsed_time              = 0.0;
+	double throughput                = 0.0;
+	size_t buffer_index              = 0;
+	int result                       = 0;
+
+	if( digest_context_initialize(
+	     &digest_context,
+	     type,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = digest_context_set_backend(
+	          digest_context,
+	          backend,
+	          error );
+
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		start_time = clock();
+
+		for( buffer_index = 0;
+		     buffer_index < number_of_buffers;
+		     buffer_index++ )
+		{
+			if( digest_context_update(
+			     digest_context,
+			     buffer,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+		if( digest_context_finalize(
+		     digest_context,
+		     hash,
+		     hash_size,
+		     error ) != 1 )
+		{
+			goto on_error;
+		}
+		end_time = clock();
+
+		elapsed_time = (double) ( end_time - start_time ) / (double) CLOCKS_PER_SEC;
+
+		if( elapsed_time > 0.0 )
+		{
+			throughput = (double) ( buffer_size * number_of_buffers ) / ( elapsed_time * 1024.0 * 1024.0 );
+		}
+		fprintf(
+		 stdout,
+		 "%-8s %-8s %10.1f MiB/s\n",
+		 ewf_test_tools_digest_benchmark_type_names[ type ],
+		 ewf_test_tools_digest_benchmark_backend_names[ backend ],
+		 throughput );
+	}
+	if( digest_context_free(
+	     &digest_context,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( digest_context != NULL )
+	{
+		digest_context_free(
+		 &digest_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	uint8_t generic_hash[ 32 ];
+	uint8_t hash[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t *buffer          = NULL;
+	size_t buffer_offset     = 0;
+	size_t number_of_buffers = EWF_TEST_DIGEST_BENCHMARK_DEFAULT_SIZE;
+	int backend              = 0;
+	int result               = 0;
+	int type                 = 0;
+
+	if( argc > 1 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		number_of_buffers = (size_t) wcstoul( argv[ 1 ], NULL, 10 );
+#else
+		number_of_buffers = (size_t) strtoul( argv[ 1 ], NULL, 10 );
+#endif
+		if( number_of_buffers == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Invalid size.\n" );
+
+			goto on_error;
+		}
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * EWF_TEST_DIGEST_BENCHMARK_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < EWF_TEST_DIGEST_BENCHMARK_BUFFER_SIZE;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( buffer_offset * 7 ) + ( buffer_offset >> 8 ) );
+	}
+	fprintf(
+	 stdout,
+	 "Calculating digest hashes of %" PRIzd " MiB\n\n",
+	 number_of_buffers );
+
+	for( type = DIGEST_CONTEXT_TYPE_MD5;
+	     type <= DIGEST_CONTEXT_TYPE_SHA256;
+	     type++ )
+	{
+		for( backend = DIGEST_CONTEXT_BACKEND_GENERIC;
+		     backend <= DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO;
+		     backend++ )
+		{
+			/* MD5 has no accelerated backend
+			 */
+			if( ( type == DIGEST_CONTEXT_TYPE_MD5 )
+			 && ( backend != DIGEST_CONTEXT_BACKEND_GENERIC ) )
+			{
+				continue;
+			}
+			memory_set(
+			 hash,
+			 0,
+			 32 );
+
+			result = ewf_test_tools_digest_benchmark_run(
+			          type,
+			          backend,
+			          buffer,
+			          EWF_TEST_DIGEST_BENCHMARK_BUFFER_SIZE,
+			          number_of_buffers,
+			          hash,
+			          32,
+			          &error );
+
+			if( result == -1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to calculate %s digest hash with %s backend.\n",
+				 ewf_test_tools_digest_benchmark_type_names[ type ],
+				 ewf_test_tools_digest_benchmark_backend_names[ backend ] );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			if( backend == DIGEST_CONTEXT_BACKEND_GENERIC )
+			{
+				memory_copy(
+				 generic_hash,
+				 hash,
+				 32 );
+			}
+			else if( memory_compare(
+			          generic_hash,
+			          hash,
+			          32 ) != 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Mismatch in %s digest hash calculated with %s backend.\n",
+				 ewf_test_tools_digest_benchmark_type_names[ type ],
+				 ewf_test_tools_digest_benchmark_backend_names[ backend ] );
+
+				goto on_error;
+			}
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1006 @@
+/*
+ * Tools digest_context functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_context.h"
+
+uint8_t ewf_test_tools_digest_context_md5_hash[ 16 ] = {
+	0x90, 0x01, 0x50, 0x98, 0x3c, 0xd2, 0x4f, 0xb0, 0xd6, 0x96, 0x3f, 0x7d, 0x28, 0xe1, 0x7f, 0x72 };
+
+uint8_t ewf_test_tools_digest_context_sha1_hash[ 20 ] = {
+	0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c,
+	0x9c, 0xd0, 0xd8, 0x9d };
+
+uint8_t ewf_test_tools_digest_context_sha256_hash[ 32 ] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+/* Tests the digest_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_context_initialize(
+     void )
+{
+	digest_context_t *digest_context = NULL;
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = digest_context_initialize(
+	          &digest_context,
+	          DIGEST_CONTEXT_TYPE_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_free(
+	          &digest_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_context_initialize(
+	          NULL,
+	          DIGEST_CONTEXT_TYPE_MD5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_context = (digest_context_t *) 0x12345678UL;
+
+	result = digest_context_initialize(
+	          &digest_context,
+	          DIGEST_CONTEXT_TYPE_MD5,
+	          &error );
+
+	digest_context = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_context_initialize(
+	          &digest_context,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test digest_context_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = digest_context_initialize(
+		          &digest_context,
+		          DIGEST_CONTEXT_TYPE_MD5,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( digest_context != NULL )
+			{
+				digest_context_free(
+				 &digest_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "digest_context",
+			 digest_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test digest_context_initialize with memset failing
+		 */
+		ewf_test_memset_attempts_before_fail = test_number;
+
+		result = digest_context_initialize(
+		          &digest_context,
+		          DIGEST_CONTEXT_TYPE_MD5,
+		          &error );
+
+		if( ewf_test_memset_attempts_before_fail != -1 )
+		{
+			ewf_test_memset_attempts_before_fail = -1;
+
+			if( digest_context != NULL )
+			{
+				digest_context_free(
+				 &digest_context,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "digest_context",
+			 digest_context );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_context != NULL )
+	{
+		digest_context_free(
+		 &digest_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_context_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_context_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_context_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_context_update and digest_context_finalize functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_context_calculate(
+     int type,
+     const uint8_t *expected_hash,
+     size_t expected_hash_size )
+{
+	uint8_t hash[ 32 ];
+
+	digest_context_t *digest_context = NULL;
+	libcerror_error_t *error         = NULL;
+	size_t hash_size                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = digest_context_initialize(
+	          &digest_context,
+	          type,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = digest_context_get_hash_size(
+	          digest_context,
+	          &hash_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "hash_size",
+	 hash_size,
+	 expected_hash_size );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_update(
+	          digest_context,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_finalize(
+	          digest_context,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          expected_hash_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_context_update(
+	          NULL,
+	          (uint8_t *) "abc",
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_context_update(
+	          digest_context,
+	          NULL,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_context_finalize(
+	          digest_context,
+	          hash,
+	          expected_hash_size - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_context_free(
+	          &digest_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_context != NULL )
+	{
+		digest_context_free(
+		 &digest_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_context_get_state and digest_context_set_state functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_context_state(
+     int type,
+     const uint8_t *expected_hash,
+     size_t expected_hash_size )
+{
+	uint8_t hash[ 32 ];
+	uint8_t state[ DIGEST_CONTEXT_STATE_SIZE ];
+
+	digest_context_t *digest_context = NULL;
+	libcerror_error_t *error         = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = digest_context_initialize(
+	          &digest_context,
+	          type,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_update(
+	          digest_context,
+	          (uint8_t *) "a",
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = digest_context_get_state(
+	          digest_context,
+	          state,
+	          DIGEST_CONTEXT_STATE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_reset(
+	          digest_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_set_state(
+	          digest_context,
+	          state,
+	          DIGEST_CONTEXT_STATE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_update(
+	          digest_context,
+	          (uint8_t *) "bc",
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_finalize(
+	          digest_context,
+	          hash,
+	          32,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          hash,
+	          expected_hash,
+	          expected_hash_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_context_get_state(
+	          digest_context,
+	          state,
+	          DIGEST_CONTEXT_STATE_SIZE - 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The state of a different digest type cannot be set
+	 */
+	state[ 0 ] = 0xff;
+
+	result = digest_context_set_state(
+	          digest_context,
+	          state,
+	          DIGEST_CONTEXT_STATE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_context_free(
+	          &digest_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_context",
+	 digest_context );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_context != NULL )
+	{
+		digest_context_free(
+		 &digest_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_context_set_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_context_set_backend(
+     int type )
+{
+	uint8_t buffer[ 1000 ];
+	uint8_t generic_hash[ 32 ];
+	uint8_t hash[ 32 ];
+
+	digest_context_t *digest_context = NULL;
+	libcerror_error_t *error         = NULL;
+	size_t buffer_offset             = 0;
+	int backend                      = 0;
+	int result                       = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < 1000;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = (uint8_t) ( ( buffer_offset * 7 ) + 3 );
+	}
+	/* Test regular cases
+	 */
+	for( backend = DIGEST_CONTEXT_BACKEND_GENERIC;
+	     backend <= DIGEST_CONTEXT_BACKEND_ARMV8_CRYPTO;
+	     backend++ )
+	{
+		result = digest_context_initialize(
+		          &digest_context,
+		          type,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = digest_context_set_backend(
+		          digest_context,
+		          backend,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 digest_context_backend_is_supported( backend ) );
+
+		if( result == 1 )
+		{
+			/* Update with a size that is not a multiple of the block size
+			 * and with the remainder to test the buffered blocks
+			 */
+			result = digest_context_update(
+			          digest_context,
+			          buffer,
+			          333,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = digest_context_update(
+			          digest_context,
+			          &( buffer[ 333 ] ),
+			          1000 - 333,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = digest_context_finalize(
+			          digest_context,
+			          hash,
+			          32,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( backend == DIGEST_CONTEXT_BACKEND_GENERIC )
+			{
+				memory_copy(
+				 generic_hash,
+				 hash,
+				 32 );
+			}
+			else
+			{
+				result = memory_compare(
+				          hash,
+				          generic_hash,
+				          32 );
+
+				EWF_TEST_ASSERT_EQUAL_INT(
+				 "result",
+				 result,
+				 0 );
+			}
+		}
+		result = digest_context_free(
+		          &digest_context,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = digest_context_initialize(
+	          &digest_context,
+	          type,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_context_set_backend(
+	          NULL,
+	          DIGEST_CONTEXT_BACKEND_GENERIC,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_context_set_backend(
+	          digest_context,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_context_free(
+	          &digest_context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_context != NULL )
+	{
+		digest_context_free(
+		 &digest_context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "digest_context_initialize",
+	 ewf_test_tools_digest_context_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_context_free",
+	 ewf_test_tools_digest_context_free );
+
+#if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_calculate",
+	 ewf_test_tools_digest_context_calculate,
+	 DIGEST_CONTEXT_TYPE_MD5,
+	 ewf_test_tools_digest_context_md5_hash,
+	 DIGEST_CONTEXT_MD5_HASH_SIZE );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_calculate",
+	 ewf_test_tools_digest_context_calculate,
+	 DIGEST_CONTEXT_TYPE_SHA1,
+	 ewf_test_tools_digest_context_sha1_hash,
+	 DIGEST_CONTEXT_SHA1_HASH_SIZE );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_calculate",
+	 ewf_test_tools_digest_context_calculate,
+	 DIGEST_CONTEXT_TYPE_SHA256,
+	 ewf_test_tools_digest_context_sha256_hash,
+	 DIGEST_CONTEXT_SHA256_HASH_SIZE );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_state",
+	 ewf_test_tools_digest_context_state,
+	 DIGEST_CONTEXT_TYPE_SHA256,
+	 ewf_test_tools_digest_context_sha256_hash,
+	 DIGEST_CONTEXT_SHA256_HASH_SIZE );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_set_backend",
+	 ewf_test_tools_digest_context_set_backend,
+	 DIGEST_CONTEXT_TYPE_MD5 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_set_backend",
+	 ewf_test_tools_digest_context_set_backend,
+	 DIGEST_CONTEXT_TYPE_SHA1 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "digest_context_set_backend",
+	 ewf_test_tools_digest_context_set_backend,
+	 DIGEST_CONTEXT_TYPE_SHA256 );
+
+#endif /* !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
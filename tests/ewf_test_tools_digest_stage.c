@@ -0,0 +1,1334 @@
+/*
+ * Tools digest_stage type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/digest_stage.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES		256
+#define EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES	8
+
+typedef struct ewf_test_digest_stage_context ewf_test_digest_stage_context_t;
+
+struct ewf_test_digest_stage_context
+{
+	/* The sum of the data bytes
+	 */
+	uint64_t sum;
+
+	/* The number of updates
+	 */
+	int number_of_updates;
+
+	/* The number of iterations to delay an update, to vary the progress of the digest threads
+	 */
+	int delay;
+
+	/* The update at which the update fails or -1 if the updates do not fail
+	 */
+	int failing_update;
+};
+
+typedef struct ewf_test_digest_stage_release_values ewf_test_digest_stage_release_values_t;
+
+struct ewf_test_digest_stage_release_values
+{
+	/* The contexts
+	 */
+	ewf_test_digest_stage_context_t *contexts;
+
+	/* The number of contexts
+	 */
+	int number_of_contexts;
+
+	/* The number of released values
+	 */
+	int number_of_released_values;
+
+	/* The number of values that were released out of order
+	 */
+	int number_of_out_of_order_values;
+
+	/* The number of values that were released before all digests were updated
+	 */
+	int number_of_early_released_values;
+};
+
+/* Updates the test context
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_digest_stage_update(
+     intptr_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	ewf_test_digest_stage_context_t *test_context = NULL;
+	static char *function                         = "ewf_test_digest_stage_update";
+	volatile int delay_iterator                   = 0;
+	size_t buffer_offset                          = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	test_context = (ewf_test_digest_stage_context_t *) context;
+
+	if( test_context->number_of_updates == test_context->failing_update )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		return( -1 );
+	}
+	for( delay_iterator = 0;
+	     delay_iterator < ( test_context->delay * ( test_context->number_of_updates % 7 ) );
+	     delay_iterator++ )
+	{
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		test_context->sum += buffer[ buffer_offset ];
+	}
+	test_context->number_of_updates += 1;
+
+	return( 1 );
+}
+
+/* Releases a test value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_digest_stage_release(
+     intptr_t *value,
+     void *arguments )
+{
+	ewf_test_digest_stage_release_values_t *release_values = NULL;
+	int context_index                                      = 0;
+	int value_index                                        = 0;
+
+	if( ( value == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	release_values = (ewf_test_digest_stage_release_values_t *) arguments;
+
+	value_index = *( (int *) value );
+
+	if( value_index != release_values->number_of_released_values )
+	{
+		release_values->number_of_out_of_order_values += 1;
+	}
+	/* A value should only be released after every digest was updated with it
+	 */
+	for( context_index = 0;
+	     context_index < release_values->number_of_contexts;
+	     context_index++ )
+	{
+		if( release_values->contexts[ context_index ].number_of_updates <= value_index )
+		{
+			release_values->number_of_early_released_values += 1;
+
+			break;
+		}
+	}
+	release_values->number_of_released_values += 1;
+
+	return( 1 );
+}
+
+/* Tests the digest_stage_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_initialize(
+     void )
+{
+	ewf_test_digest_stage_release_values_t release_values;
+
+	digest_stage_t *digest_stage    = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_digest_stage_release_values_t ) );
+
+	/* Test regular cases
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_stage->number_of_digests",
+	 digest_stage->number_of_digests,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_stage->maximum_number_of_queued_values",
+	 digest_stage->maximum_number_of_queued_values,
+	 EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES );
+
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_stage_initialize(
+	          NULL,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	digest_stage = (digest_stage_t *) 0x12345678UL;
+
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	digest_stage = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          0,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          NULL,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test digest_stage_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = digest_stage_initialize(
+		          &digest_stage,
+		          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+		          &ewf_test_digest_stage_release,
+		          (void *) &release_values,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( digest_stage != NULL )
+			{
+				digest_stage_free(
+				 &digest_stage,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "digest_stage",
+			 digest_stage );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &digest_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_stage_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = digest_stage_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_stage_append_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_append_digest(
+     void )
+{
+	ewf_test_digest_stage_context_t contexts[ DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS + 1 ];
+	ewf_test_digest_stage_release_values_t release_values;
+
+	digest_stage_t *digest_stage = NULL;
+	libcerror_error_t *error     = NULL;
+	int context_index            = 0;
+	int result                   = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_digest_stage_context_t ) * ( DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS + 1 ) );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_digest_stage_release_values_t ) );
+
+	/* Initialize test
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		result = digest_stage_append_digest(
+		          digest_stage,
+		          (intptr_t *) &( contexts[ context_index ] ),
+		          &ewf_test_digest_stage_update,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_stage->number_of_digests",
+	 digest_stage->number_of_digests,
+	 DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS );
+
+	/* Test error cases
+	 */
+	result = digest_stage_append_digest(
+	          digest_stage,
+	          (intptr_t *) &( contexts[ DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS ] ),
+	          &ewf_test_digest_stage_update,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_append_digest(
+	          NULL,
+	          (intptr_t *) &( contexts[ 0 ] ),
+	          &ewf_test_digest_stage_update,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = digest_stage_append_digest(
+	          digest_stage,
+	          NULL,
+	          &ewf_test_digest_stage_update,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_append_digest(
+	          digest_stage,
+	          (intptr_t *) &( contexts[ 0 ] ),
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_stage->number_of_digests",
+	 digest_stage->number_of_digests,
+	 0 );
+
+	/* Clean up
+	 */
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &digest_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_stage_push function
+ * The values must be released in the order they were pushed and only after every digest was updated
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_push(
+     void )
+{
+	ewf_test_digest_stage_context_t contexts[ DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS ];
+	ewf_test_digest_stage_release_values_t release_values;
+	uint8_t data[ EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES ];
+	int values[ EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES ];
+
+	digest_stage_t *digest_stage = NULL;
+	libcerror_error_t *error     = NULL;
+	uint64_t expected_sum        = 0;
+	int context_index            = 0;
+	int result                   = 0;
+	int value_index              = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_digest_stage_context_t ) * DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_digest_stage_release_values_t ) );
+
+	for( value_index = 0;
+	     value_index < EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		data[ value_index ]   = (uint8_t) value_index;
+		values[ value_index ] = value_index;
+
+		expected_sum += (uint64_t) value_index;
+	}
+	/* The digests are updated at a different pace so that the reference
+	 * to a value is dropped last by varying digest threads
+	 */
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		contexts[ context_index ].delay          = ( context_index + 1 ) * 1000;
+		contexts[ context_index ].failing_update = -1;
+	}
+	contexts[ 1 ].delay = 0;
+
+	release_values.contexts           = contexts;
+	release_values.number_of_contexts = DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+
+	/* Initialize test
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_stage",
+	 digest_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		result = digest_stage_append_digest(
+		          digest_stage,
+		          (intptr_t *) &( contexts[ context_index ] ),
+		          &ewf_test_digest_stage_update,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		result = digest_stage_push(
+		          digest_stage,
+		          (intptr_t *) &( values[ value_index ] ),
+		          &( data[ value_index ] ),
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = digest_stage_wait(
+	          digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_out_of_order_values",
+	 release_values.number_of_out_of_order_values,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_early_released_values",
+	 release_values.number_of_early_released_values,
+	 0 );
+
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "contexts[ context_index ].number_of_updates",
+		 contexts[ context_index ].number_of_updates,
+		 EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "contexts[ context_index ].sum",
+		 contexts[ context_index ].sum,
+		 expected_sum );
+	}
+	/* Test error cases
+	 */
+	result = digest_stage_push(
+	          NULL,
+	          (intptr_t *) &( values[ 0 ] ),
+	          &( data[ 0 ] ),
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_stage_join(
+	          digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &digest_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_stage_push function when updating a digest fails
+ * Every value must still be released exactly once
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_push_failed(
+     void )
+{
+	ewf_test_digest_stage_context_t contexts[ DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS ];
+	ewf_test_digest_stage_release_values_t release_values;
+	uint8_t data[ EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES ];
+	int values[ EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES ];
+
+	digest_stage_t *digest_stage = NULL;
+	libcerror_error_t *error     = NULL;
+	int context_index            = 0;
+	int number_of_failed_pushes  = 0;
+	int result                   = 0;
+	int value_index              = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_digest_stage_context_t ) * DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_digest_stage_release_values_t ) );
+
+	for( value_index = 0;
+	     value_index < EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		data[ value_index ]   = (uint8_t) value_index;
+		values[ value_index ] = value_index;
+	}
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		contexts[ context_index ].failing_update = -1;
+	}
+	contexts[ 1 ].failing_update = 16;
+
+	/* The order is not checked since values that are pushed after the failure
+	 * are released by the pushing thread
+	 */
+	release_values.contexts           = NULL;
+	release_values.number_of_contexts = 0;
+
+	/* Initialize test
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( context_index = 0;
+	     context_index < DIGEST_STAGE_MAXIMUM_NUMBER_OF_DIGESTS;
+	     context_index++ )
+	{
+		result = digest_stage_append_digest(
+		          digest_stage,
+		          (intptr_t *) &( contexts[ context_index ] ),
+		          &ewf_test_digest_stage_update,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		result = digest_stage_push(
+		          digest_stage,
+		          (intptr_t *) &( values[ value_index ] ),
+		          &( data[ value_index ] ),
+		          1,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_free(
+			 &error );
+
+			number_of_failed_pushes++;
+		}
+	}
+	result = digest_stage_wait(
+	          digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 EWF_TEST_DIGEST_STAGE_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 1 ].number_of_updates",
+	 contexts[ 1 ].number_of_updates,
+	 16 );
+
+	/* Values pushed after the failure was detected are refused
+	 */
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_failed_pushes",
+	 number_of_failed_pushes,
+	 0 );
+
+	/* Clean up
+	 */
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &digest_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the digest_stage_release_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_digest_stage_release_value(
+     void )
+{
+	ewf_test_digest_stage_release_values_t release_values;
+
+	digest_stage_t *digest_stage                       = NULL;
+	digest_stage_value_t *digest_stage_value           = NULL;
+	digest_stage_value_t *referenced_digest_stage_value = NULL;
+	libcerror_error_t *error                           = NULL;
+	int value                                          = 0;
+	int result                                         = 0;
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_digest_stage_release_values_t ) );
+
+	/* Initialize test
+	 */
+	result = digest_stage_initialize(
+	          &digest_stage,
+	          EWF_TEST_DIGEST_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_digest_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	digest_stage_value = (digest_stage_value_t *) memory_allocate(
+	                                               sizeof( digest_stage_value_t ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "digest_stage_value",
+	 digest_stage_value );
+
+	digest_stage_value->value                = (intptr_t *) &value;
+	digest_stage_value->data                 = NULL;
+	digest_stage_value->data_size            = 0;
+	digest_stage_value->number_of_references = 3;
+
+	digest_stage->number_of_pending_values = 1;
+
+	referenced_digest_stage_value = digest_stage_value;
+
+	/* Test regular cases
+	 */
+	result = digest_stage_release_value(
+	          digest_stage,
+	          &digest_stage_value,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_stage_value",
+	 digest_stage_value );
+
+	/* The value is still referenced and not released
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 0 );
+
+	/* Dropping the last references releases and frees the value
+	 */
+	digest_stage_value = referenced_digest_stage_value;
+
+	referenced_digest_stage_value = NULL;
+
+	result = digest_stage_release_value(
+	          digest_stage,
+	          &digest_stage_value,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "digest_stage_value",
+	 digest_stage_value );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "digest_stage->number_of_pending_values",
+	 digest_stage->number_of_pending_values,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = digest_stage_release_value(
+	          digest_stage,
+	          &digest_stage_value,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_release_value(
+	          NULL,
+	          &digest_stage_value,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = digest_stage_release_value(
+	          digest_stage,
+	          NULL,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = digest_stage_free(
+	          &digest_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( referenced_digest_stage_value != NULL )
+	{
+		memory_free(
+		 referenced_digest_stage_value );
+	}
+	else if( digest_stage_value != NULL )
+	{
+		memory_free(
+		 digest_stage_value );
+	}
+	if( digest_stage != NULL )
+	{
+		digest_stage_free(
+		 &digest_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "digest_stage_initialize",
+	 ewf_test_tools_digest_stage_initialize );
+
+	EWF_TEST_RUN(
+	 "digest_stage_free",
+	 ewf_test_tools_digest_stage_free );
+
+	EWF_TEST_RUN(
+	 "digest_stage_append_digest",
+	 ewf_test_tools_digest_stage_append_digest );
+
+	EWF_TEST_RUN(
+	 "digest_stage_push",
+	 ewf_test_tools_digest_stage_push );
+
+	EWF_TEST_RUN(
+	 "digest_stage_push_failed",
+	 ewf_test_tools_digest_stage_push_failed );
+
+	EWF_TEST_RUN(
+	 "digest_stage_release_value",
+	 ewf_test_tools_digest_stage_release_value );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
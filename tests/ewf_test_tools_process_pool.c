@@ -0,0 +1,1591 @@
+/*
+ * Tools process_pool type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/process_pool.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES		256
+#define EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES	8
+#define EWF_TEST_PROCESS_POOL_MAXIMUM_ORDER_SIZE	64
+
+typedef struct ewf_test_process_pool_order ewf_test_process_pool_order_t;
+
+struct ewf_test_process_pool_order
+{
+	/* The identifiers of the clients in the order their values were processed
+	 */
+	int client_identifiers[ EWF_TEST_PROCESS_POOL_MAXIMUM_ORDER_SIZE ];
+
+	/* The values in the order they were processed
+	 */
+	intptr_t values[ EWF_TEST_PROCESS_POOL_MAXIMUM_ORDER_SIZE ];
+
+	/* The number of processed values
+	 */
+	int number_of_values;
+};
+
+typedef struct ewf_test_process_pool_context ewf_test_process_pool_context_t;
+
+struct ewf_test_process_pool_context
+{
+	/* The mutex, which is not owned by the context
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The order, which is not owned by the context
+	 */
+	ewf_test_process_pool_order_t *order;
+
+	/* The client identifier
+	 */
+	int client_identifier;
+
+	/* The sum of the processed values
+	 */
+	uint64_t sum;
+
+	/* The number of processed values
+	 */
+	int number_of_processed_values;
+
+	/* The number of values that were skipped after the abort
+	 */
+	int number_of_skipped_values;
+
+	/* The number of processed values after which the context aborts or 0 if the context does not abort
+	 */
+	int abort_after;
+
+	/* Value to indicate the context was aborted
+	 */
+	int abort;
+
+	/* The number of iterations to delay processing, to vary the progress of the process threads
+	 */
+	int delay;
+};
+
+/* Processes a test value
+ * Like the handles, values are skipped instead of failed after an abort
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_process_pool_process(
+     intptr_t *value,
+     void *arguments )
+{
+	ewf_test_process_pool_context_t *context = NULL;
+	volatile int delay_iterator              = 0;
+	int order_index                          = 0;
+
+	if( ( value == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	context = (ewf_test_process_pool_context_t *) arguments;
+
+	for( delay_iterator = 0;
+	     delay_iterator < ( context->delay * ( (int) (intptr_t) value % 7 ) );
+	     delay_iterator++ )
+	{
+	}
+	if( libcthreads_mutex_grab(
+	     context->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( context->abort != 0 )
+	{
+		context->number_of_skipped_values += 1;
+	}
+	else
+	{
+		context->sum                        += (uint64_t) (intptr_t) value;
+		context->number_of_processed_values += 1;
+
+		if( context->order != NULL )
+		{
+			order_index = context->order->number_of_values;
+
+			if( order_index < EWF_TEST_PROCESS_POOL_MAXIMUM_ORDER_SIZE )
+			{
+				context->order->client_identifiers[ order_index ] = context->client_identifier;
+				context->order->values[ order_index ]             = (intptr_t) value;
+			}
+			context->order->number_of_values += 1;
+		}
+		if( ( context->abort_after > 0 )
+		 && ( context->number_of_processed_values >= context->abort_after ) )
+		{
+			context->abort = 1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     context->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the process_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	process_pool_t *process_pool    = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "process_pool",
+	 process_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "process_pool->number_of_clients",
+	 process_pool->number_of_clients,
+	 2 );
+
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "process_pool",
+	 process_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = process_pool_initialize(
+	          NULL,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	process_pool = (process_pool_t *) 0x12345678UL;
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	process_pool = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          0,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          0,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test process_pool_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = process_pool_initialize(
+		          &process_pool,
+		          2,
+		          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+		          1024,
+		          2,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( process_pool != NULL )
+			{
+				process_pool_free(
+				 &process_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "process_pool",
+			 process_pool );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the process_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = process_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the process_pool_get_client_buffers_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_get_client_buffers_size(
+     void )
+{
+	libcerror_error_t *error     = NULL;
+	process_pool_t *process_pool = NULL;
+	size64_t client_buffers_size = 0;
+	int result                   = 0;
+
+	/* Initialize test
+	 */
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1000,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = process_pool_get_client_buffers_size(
+	          process_pool,
+	          &client_buffers_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The memory budget is divided evenly between the clients
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "client_buffers_size",
+	 (uint64_t) client_buffers_size,
+	 (uint64_t) 333 );
+
+	/* Test error cases
+	 */
+	result = process_pool_get_client_buffers_size(
+	          NULL,
+	          &client_buffers_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_get_client_buffers_size(
+	          process_pool,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the process_pool_client_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_client_initialize(
+     void )
+{
+	ewf_test_process_pool_context_t context;
+
+	libcerror_error_t *error                   = NULL;
+	process_pool_t *process_pool               = NULL;
+	process_pool_client_t *process_pool_client = NULL;
+	int result                                 = 0;
+
+	memory_set(
+	 &context,
+	 0,
+	 sizeof( ewf_test_process_pool_context_t ) );
+
+	/* Initialize test
+	 */
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = process_pool_client_initialize(
+	          &process_pool_client,
+	          process_pool,
+	          &ewf_test_process_pool_process,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "process_pool_client",
+	 process_pool_client );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "process_pool_client->number_of_pending_values",
+	 process_pool_client->number_of_pending_values,
+	 0 );
+
+	result = process_pool_client_free(
+	          &process_pool_client,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "process_pool_client",
+	 process_pool_client );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = process_pool_client_initialize(
+	          NULL,
+	          process_pool,
+	          &ewf_test_process_pool_process,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	process_pool_client = (process_pool_client_t *) 0x12345678UL;
+
+	result = process_pool_client_initialize(
+	          &process_pool_client,
+	          process_pool,
+	          &ewf_test_process_pool_process,
+	          (void *) &context,
+	          &error );
+
+	process_pool_client = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_client_initialize(
+	          &process_pool_client,
+	          NULL,
+	          &ewf_test_process_pool_process,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_client_initialize(
+	          &process_pool_client,
+	          process_pool,
+	          NULL,
+	          (void *) &context,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( process_pool_client != NULL )
+	{
+		process_pool_client_free(
+		 &process_pool_client,
+		 NULL );
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the process_pool_client_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_client_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = process_pool_client_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the process_pool_client_push function with values of multiple clients
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_client_push(
+     void )
+{
+	ewf_test_process_pool_context_t contexts[ 3 ];
+
+	process_pool_client_t *process_pool_clients[ 3 ] = { NULL, NULL, NULL };
+	libcerror_error_t *error                         = NULL;
+	libcthreads_mutex_t *mutex                       = NULL;
+	process_pool_t *process_pool                     = NULL;
+	uint64_t expected_sum                            = 0;
+	int client_index                                 = 0;
+	int result                                       = 0;
+	int value_index                                  = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_process_pool_context_t ) * 3 );
+
+	/* Initialize test
+	 */
+	result = libcthreads_mutex_initialize(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          4,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( client_index = 0;
+	     client_index < 3;
+	     client_index++ )
+	{
+		contexts[ client_index ].mutex             = mutex;
+		contexts[ client_index ].client_identifier = client_index;
+		contexts[ client_index ].delay             = 1000 * client_index;
+
+		result = process_pool_client_initialize(
+		          &( process_pool_clients[ client_index ] ),
+		          process_pool,
+		          &ewf_test_process_pool_process,
+		          (void *) &( contexts[ client_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( value_index = 1;
+	     value_index <= EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		for( client_index = 0;
+		     client_index < 3;
+		     client_index++ )
+		{
+			result = process_pool_client_push(
+			          process_pool_clients[ client_index ],
+			          (intptr_t *) (intptr_t) value_index,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		expected_sum += (uint64_t) value_index;
+	}
+	/* Waiting for a client only returns after all its values were processed
+	 */
+	for( client_index = 0;
+	     client_index < 3;
+	     client_index++ )
+	{
+		result = process_pool_client_wait(
+		          process_pool_clients[ client_index ],
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "process_pool_clients[ client_index ]->number_of_pending_values",
+		 process_pool_clients[ client_index ]->number_of_pending_values,
+		 0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "contexts[ client_index ].number_of_processed_values",
+		 contexts[ client_index ].number_of_processed_values,
+		 EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "contexts[ client_index ].sum",
+		 contexts[ client_index ].sum,
+		 expected_sum );
+	}
+	/* Test error cases
+	 */
+	result = process_pool_client_push(
+	          NULL,
+	          (intptr_t *) 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = process_pool_client_wait(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( client_index = 0;
+	     client_index < 3;
+	     client_index++ )
+	{
+		result = process_pool_client_free(
+		          &( process_pool_clients[ client_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( client_index = 0;
+	     client_index < 3;
+	     client_index++ )
+	{
+		if( process_pool_clients[ client_index ] != NULL )
+		{
+			process_pool_client_free(
+			 &( process_pool_clients[ client_index ] ),
+			 NULL );
+		}
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that the process_pool processes the values of the clients in the order they were pushed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_client_push_fairness(
+     void )
+{
+	ewf_test_process_pool_context_t contexts[ 2 ];
+	ewf_test_process_pool_order_t order;
+
+	process_pool_client_t *process_pool_clients[ 2 ] = { NULL, NULL };
+	libcerror_error_t *error                         = NULL;
+	libcthreads_mutex_t *mutex                       = NULL;
+	process_pool_t *process_pool                     = NULL;
+	int client_index                                 = 0;
+	int result                                       = 0;
+	int value_index                                  = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_process_pool_context_t ) * 2 );
+
+	memory_set(
+	 &order,
+	 0,
+	 sizeof( ewf_test_process_pool_order_t ) );
+
+	/* Initialize test
+	 */
+	result = libcthreads_mutex_initialize(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A single process thread makes the processing order deterministic
+	 */
+	result = process_pool_initialize(
+	          &process_pool,
+	          1,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( client_index = 0;
+	     client_index < 2;
+	     client_index++ )
+	{
+		contexts[ client_index ].mutex             = mutex;
+		contexts[ client_index ].order             = &order;
+		contexts[ client_index ].client_identifier = client_index;
+
+		result = process_pool_client_initialize(
+		          &( process_pool_clients[ client_index ] ),
+		          process_pool,
+		          &ewf_test_process_pool_process,
+		          (void *) &( contexts[ client_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+
+	/* The first client pushes a backlog of values before and after the value of the second client
+	 */
+	for( value_index = 1;
+	     value_index <= 33;
+	     value_index++ )
+	{
+		client_index = ( value_index == 17 ) ? 1 : 0;
+
+		result = process_pool_client_push(
+		          process_pool_clients[ client_index ],
+		          (intptr_t *) (intptr_t) value_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = process_pool_client_wait(
+	          process_pool_clients[ 1 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = process_pool_client_wait(
+	          process_pool_clients[ 0 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "order.number_of_values",
+	 order.number_of_values,
+	 33 );
+
+	/* The value of the second client is processed before the backlog the first client pushed after it
+	 */
+	for( value_index = 0;
+	     value_index < 33;
+	     value_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "order.values[ value_index ]",
+		 (int) order.values[ value_index ],
+		 value_index + 1 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "order.client_identifiers[ value_index ]",
+		 order.client_identifiers[ value_index ],
+		 ( value_index == 16 ) ? 1 : 0 );
+	}
+	/* Clean up
+	 */
+	for( client_index = 0;
+	     client_index < 2;
+	     client_index++ )
+	{
+		result = process_pool_client_free(
+		          &( process_pool_clients[ client_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( client_index = 0;
+	     client_index < 2;
+	     client_index++ )
+	{
+		if( process_pool_clients[ client_index ] != NULL )
+		{
+			process_pool_client_free(
+			 &( process_pool_clients[ client_index ] ),
+			 NULL );
+		}
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests that a client that aborts does not affect the other clients of the process_pool
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_process_pool_client_push_abort(
+     void )
+{
+	ewf_test_process_pool_context_t contexts[ 2 ];
+
+	process_pool_client_t *process_pool_clients[ 2 ] = { NULL, NULL };
+	libcerror_error_t *error                         = NULL;
+	libcthreads_mutex_t *mutex                       = NULL;
+	process_pool_t *process_pool                     = NULL;
+	uint64_t expected_sum                            = 0;
+	int client_index                                 = 0;
+	int result                                       = 0;
+	int value_index                                  = 0;
+
+	memory_set(
+	 contexts,
+	 0,
+	 sizeof( ewf_test_process_pool_context_t ) * 2 );
+
+	/* Initialize test
+	 */
+	result = libcthreads_mutex_initialize(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = process_pool_initialize(
+	          &process_pool,
+	          2,
+	          EWF_TEST_PROCESS_POOL_NUMBER_OF_QUEUED_VALUES,
+	          1024,
+	          2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( client_index = 0;
+	     client_index < 2;
+	     client_index++ )
+	{
+		contexts[ client_index ].mutex             = mutex;
+		contexts[ client_index ].client_identifier = client_index;
+		contexts[ client_index ].delay             = 1000;
+
+		result = process_pool_client_initialize(
+		          &( process_pool_clients[ client_index ] ),
+		          process_pool,
+		          &ewf_test_process_pool_process,
+		          (void *) &( contexts[ client_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The first client aborts after processing 16 values
+	 */
+	contexts[ 0 ].abort_after = 16;
+
+	/* Test regular cases
+	 */
+	for( value_index = 1;
+	     value_index <= EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		for( client_index = 0;
+		     client_index < 2;
+		     client_index++ )
+		{
+			result = process_pool_client_push(
+			          process_pool_clients[ client_index ],
+			          (intptr_t *) (intptr_t) value_index,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		expected_sum += (uint64_t) value_index;
+	}
+	/* Freeing the aborted client waits for its pending values
+	 */
+	result = process_pool_client_free(
+	          &( process_pool_clients[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 0 ].abort",
+	 contexts[ 0 ].abort,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 0 ].number_of_processed_values",
+	 contexts[ 0 ].number_of_processed_values,
+	 16 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 0 ].number_of_skipped_values",
+	 contexts[ 0 ].number_of_skipped_values,
+	 EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES - 16 );
+
+	/* The other client is not affected by the abort
+	 */
+	result = process_pool_client_wait(
+	          process_pool_clients[ 1 ],
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 1 ].number_of_processed_values",
+	 contexts[ 1 ].number_of_processed_values,
+	 EWF_TEST_PROCESS_POOL_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "contexts[ 1 ].number_of_skipped_values",
+	 contexts[ 1 ].number_of_skipped_values,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "contexts[ 1 ].sum",
+	 contexts[ 1 ].sum,
+	 expected_sum );
+
+	/* Clean up
+	 */
+	result = process_pool_client_free(
+	          &( process_pool_clients[ 1 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = process_pool_free(
+	          &process_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &mutex,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( client_index = 0;
+	     client_index < 2;
+	     client_index++ )
+	{
+		if( process_pool_clients[ client_index ] != NULL )
+		{
+			process_pool_client_free(
+			 &( process_pool_clients[ client_index ] ),
+			 NULL );
+		}
+	}
+	if( process_pool != NULL )
+	{
+		process_pool_free(
+		 &process_pool,
+		 NULL );
+	}
+	if( mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &mutex,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "process_pool_initialize",
+	 ewf_test_tools_process_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "process_pool_free",
+	 ewf_test_tools_process_pool_free );
+
+	EWF_TEST_RUN(
+	 "process_pool_get_client_buffers_size",
+	 ewf_test_tools_process_pool_get_client_buffers_size );
+
+	EWF_TEST_RUN(
+	 "process_pool_client_initialize",
+	 ewf_test_tools_process_pool_client_initialize );
+
+	EWF_TEST_RUN(
+	 "process_pool_client_free",
+	 ewf_test_tools_process_pool_client_free );
+
+	EWF_TEST_RUN(
+	 "process_pool_client_push",
+	 ewf_test_tools_process_pool_client_push );
+
+	EWF_TEST_RUN(
+	 "process_pool_client_push_fairness",
+	 ewf_test_tools_process_pool_client_push_fairness );
+
+	EWF_TEST_RUN(
+	 "process_pool_client_push_abort",
+	 ewf_test_tools_process_pool_client_push_abort );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
@@ -0,0 +1,1195 @@
+/*
+ * Tools reorder_window type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/reorder_window.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS		16
+#define EWF_TEST_REORDER_WINDOW_NUMBER_OF_VALUES	4096
+#define EWF_TEST_REORDER_WINDOW_NUMBER_OF_THREADS	4
+#define EWF_TEST_REORDER_WINDOW_BATCH_SIZE		8
+
+typedef struct ewf_test_reorder_window_output_values ewf_test_reorder_window_output_values_t;
+
+struct ewf_test_reorder_window_output_values
+{
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a value was output
+	 */
+	libcthreads_condition_t *condition;
+
+	/* The reorder window
+	 */
+	reorder_window_t *reorder_window;
+
+	/* The number of output values
+	 */
+	int number_of_output_values;
+
+	/* The number of values that were output out of order
+	 */
+	int number_of_out_of_order_values;
+
+	/* The number of values that could not be pushed
+	 */
+	int number_of_failed_values;
+};
+
+/* Outputs a test value
+ * The value is the sequence number + 1
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_reorder_window_output(
+     intptr_t *value,
+     void *arguments )
+{
+	ewf_test_reorder_window_output_values_t *output_values = NULL;
+	int result                                             = 1;
+
+	if( ( value == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	output_values = (ewf_test_reorder_window_output_values_t *) arguments;
+
+	if( output_values->mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     output_values->mutex,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( (intptr_t) value != (intptr_t) ( output_values->number_of_output_values + 1 ) )
+	{
+		output_values->number_of_out_of_order_values += 1;
+	}
+	output_values->number_of_output_values += 1;
+
+	if( output_values->mutex != NULL )
+	{
+		if( libcthreads_condition_broadcast(
+		     output_values->condition,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     output_values->mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Pushes a test value onto the reorder window
+ * Callback function for the push thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_reorder_window_push_callback(
+     intptr_t *value,
+     void *arguments )
+{
+	ewf_test_reorder_window_output_values_t *output_values = NULL;
+	volatile int delay_iterator                            = 0;
+
+	if( ( value == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	output_values = (ewf_test_reorder_window_output_values_t *) arguments;
+
+	/* Vary the progress of the push threads
+	 */
+	for( delay_iterator = 0;
+	     delay_iterator < ( 100 * ( (int) (intptr_t) value % 5 ) );
+	     delay_iterator++ )
+	{
+	}
+	if( reorder_window_push(
+	     output_values->reorder_window,
+	     (uint64_t) ( (intptr_t) value - 1 ),
+	     value,
+	     NULL ) != 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     output_values->mutex,
+		     NULL ) == 1 )
+		{
+			output_values->number_of_failed_values += 1;
+
+			libcthreads_condition_broadcast(
+			 output_values->condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 output_values->mutex,
+			 NULL );
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits until the number of values that were not yet output is at most the maximum
+ * The reorder window is not queried since, in the mutex build, the output function
+ * is called while the reorder window mutex is held
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_reorder_window_wait_for_output_values(
+     ewf_test_reorder_window_output_values_t *output_values,
+     int number_of_sequence_numbers,
+     int maximum_number_of_pending_values )
+{
+	int result = 1;
+
+	if( libcthreads_mutex_grab(
+	     output_values->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	while( ( number_of_sequence_numbers - output_values->number_of_output_values ) > maximum_number_of_pending_values )
+	{
+		/* Values that could not be pushed are never output
+		 */
+		if( output_values->number_of_failed_values != 0 )
+		{
+			result = -1;
+
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     output_values->condition,
+		     output_values->mutex,
+		     NULL ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     output_values->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Tests the reorder_window_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_reorder_window_initialize(
+     void )
+{
+	ewf_test_reorder_window_output_values_t output_values;
+
+	libcerror_error_t *error         = NULL;
+	reorder_window_t *reorder_window = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int test_number                  = 0;
+#endif
+
+	memory_set(
+	 &output_values,
+	 0,
+	 sizeof( ewf_test_reorder_window_output_values_t ) );
+
+	/* Test regular cases
+	 */
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reorder_window",
+	 reorder_window );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "reorder_window->number_of_slots",
+	 reorder_window->number_of_slots,
+	 EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS );
+
+#if defined( REORDER_WINDOW_USE_MUTEX )
+	/* The mutex fallback is used instead of the atomic operations
+	 */
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "reorder_window->mutex",
+	 reorder_window->mutex );
+#endif
+
+	result = reorder_window_free(
+	          &reorder_window,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "reorder_window",
+	 reorder_window );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = reorder_window_initialize(
+	          NULL,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reorder_window = (reorder_window_t *) 0x12345678UL;
+
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	reorder_window = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          0,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          NULL,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test reorder_window_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = reorder_window_initialize(
+		          &reorder_window,
+		          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+		          &ewf_test_reorder_window_output,
+		          (void *) &output_values,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( reorder_window != NULL )
+			{
+				reorder_window_free(
+				 &reorder_window,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "reorder_window",
+			 reorder_window );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_window != NULL )
+	{
+		reorder_window_free(
+		 &reorder_window,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the reorder_window_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_reorder_window_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = reorder_window_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the reorder_window_push function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_reorder_window_push(
+     void )
+{
+	ewf_test_reorder_window_output_values_t output_values;
+
+	/* The order in which the values of a window are pushed
+	 */
+	int push_order[ EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS ] = {
+		5, 3, 15, 0, 1, 2, 9, 4, 14, 7, 6, 13, 8, 12, 11, 10 };
+
+	/* The number of values that can be output after each push
+	 */
+	int expected_number_of_output_values[ EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS ] = {
+		0, 0, 0, 1, 2, 4, 4, 6, 6, 6, 8, 8, 10, 10, 10, 16 };
+
+	libcerror_error_t *error          = NULL;
+	reorder_window_t *reorder_window  = NULL;
+	uint64_t number_of_pending_values = 0;
+	uint64_t sequence_number          = 0;
+	int push_index                    = 0;
+	int result                        = 0;
+	int window_index                  = 0;
+
+	memory_set(
+	 &output_values,
+	 0,
+	 sizeof( ewf_test_reorder_window_output_values_t ) );
+
+	/* Initialize test
+	 */
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* Values that are pushed out of order are output in sequence order,
+	 * as soon as all the values before them were pushed.
+	 * The window wraps around the slots multiple times.
+	 */
+	for( window_index = 0;
+	     window_index < 3;
+	     window_index++ )
+	{
+		for( push_index = 0;
+		     push_index < EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS;
+		     push_index++ )
+		{
+			result = reorder_window_get_next_sequence_number(
+			          reorder_window,
+			          &sequence_number,
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			EWF_TEST_ASSERT_EQUAL_UINT64(
+			 "sequence_number",
+			 sequence_number,
+			 (uint64_t) ( ( window_index * EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS ) + push_index ) );
+		}
+		result = reorder_window_get_number_of_pending_values(
+		          reorder_window,
+		          &number_of_pending_values,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_pending_values",
+		 number_of_pending_values,
+		 (uint64_t) EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS );
+
+		for( push_index = 0;
+		     push_index < EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS;
+		     push_index++ )
+		{
+			sequence_number = (uint64_t) ( ( window_index * EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS ) + push_order[ push_index ] );
+
+			result = reorder_window_push(
+			          reorder_window,
+			          sequence_number,
+			          (intptr_t *) (intptr_t) ( sequence_number + 1 ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "output_values.number_of_output_values",
+			 output_values.number_of_output_values,
+			 ( window_index * EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS ) + expected_number_of_output_values[ push_index ] );
+		}
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_values.number_of_out_of_order_values",
+	 output_values.number_of_out_of_order_values,
+	 0 );
+
+	result = reorder_window_get_number_of_pending_values(
+	          reorder_window,
+	          &number_of_pending_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_pending_values",
+	 number_of_pending_values,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = reorder_window_push(
+	          NULL,
+	          0,
+	          (intptr_t *) 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = reorder_window_push(
+	          reorder_window,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = reorder_window_free(
+	          &reorder_window,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_window != NULL )
+	{
+		reorder_window_free(
+		 &reorder_window,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the reorder_window_push function with a slot that is occupied
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_reorder_window_push_slot_occupied(
+     void )
+{
+	ewf_test_reorder_window_output_values_t output_values;
+
+	intptr_t *value                  = NULL;
+	libcerror_error_t *error         = NULL;
+	reorder_window_t *reorder_window = NULL;
+	uint64_t sequence_number         = 0;
+	int result                       = 0;
+	int value_index                  = 0;
+
+	memory_set(
+	 &output_values,
+	 0,
+	 sizeof( ewf_test_reorder_window_output_values_t ) );
+
+	/* Initialize test
+	 */
+	result = reorder_window_initialize(
+	          &reorder_window,
+	          4,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( value_index = 0;
+	     value_index < 6;
+	     value_index++ )
+	{
+		result = reorder_window_get_next_sequence_number(
+		          reorder_window,
+		          &sequence_number,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Sequence number 1 cannot be output until sequence number 0 was pushed
+	 */
+	result = reorder_window_push(
+	          reorder_window,
+	          1,
+	          (intptr_t *) 2,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+
+	/* Sequence number 5 maps onto the slot of sequence number 1, which happens when
+	 * more values are in flight than the window has slots
+	 */
+	result = reorder_window_push(
+	          reorder_window,
+	          5,
+	          (intptr_t *) 6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_values.number_of_output_values",
+	 output_values.number_of_output_values,
+	 0 );
+
+	/* The value in the occupied slot is not overwritten
+	 */
+	result = reorder_window_remove_value(
+	          reorder_window,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "value",
+	 (int) (intptr_t) value,
+	 2 );
+
+	result = reorder_window_remove_value(
+	          reorder_window,
+	          &value,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = reorder_window_free(
+	          &reorder_window,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reorder_window != NULL )
+	{
+		reorder_window_free(
+		 &reorder_window,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the reorder_window_push function with multiple threads that push values out of order
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_reorder_window_push_threaded(
+     void )
+{
+	ewf_test_reorder_window_output_values_t output_values;
+
+	uint64_t batch[ EWF_TEST_REORDER_WINDOW_BATCH_SIZE ];
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	uint64_t random_number                 = 0x1234567890abcdefULL;
+	uint64_t sequence_number               = 0;
+	int batch_index                        = 0;
+	int other_batch_index                  = 0;
+	int result                             = 0;
+	int value_index                        = 0;
+
+	memory_set(
+	 &output_values,
+	 0,
+	 sizeof( ewf_test_reorder_window_output_values_t ) );
+
+	/* Initialize test
+	 */
+	result = libcthreads_mutex_initialize(
+	          &( output_values.mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_initialize(
+	          &( output_values.condition ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = reorder_window_initialize(
+	          &( output_values.reorder_window ),
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_output,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_thread_pool_create(
+	          &thread_pool,
+	          NULL,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_THREADS,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_SLOTS,
+	          &ewf_test_reorder_window_push_callback,
+	          (void *) &output_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* The sequence numbers of every batch are shuffled so that the push threads
+	 * publish values out of order and hand over outputting to each other.
+	 * Every batch is output before the next batch is pushed, so that a value
+	 * that was not picked up after a hand over stalls the test.
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_REORDER_WINDOW_NUMBER_OF_VALUES;
+	     value_index += EWF_TEST_REORDER_WINDOW_BATCH_SIZE )
+	{
+		result = ewf_test_reorder_window_wait_for_output_values(
+		          &output_values,
+		          value_index,
+		          0 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		for( batch_index = 0;
+		     batch_index < EWF_TEST_REORDER_WINDOW_BATCH_SIZE;
+		     batch_index++ )
+		{
+			result = reorder_window_get_next_sequence_number(
+			          output_values.reorder_window,
+			          &( batch[ batch_index ] ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		for( batch_index = EWF_TEST_REORDER_WINDOW_BATCH_SIZE - 1;
+		     batch_index > 0;
+		     batch_index-- )
+		{
+			random_number = ( random_number * 6364136223846793005ULL ) + 1442695040888963407ULL;
+
+			other_batch_index = (int) ( ( random_number >> 33 ) % (uint64_t) ( batch_index + 1 ) );
+
+			sequence_number            = batch[ batch_index ];
+			batch[ batch_index ]       = batch[ other_batch_index ];
+			batch[ other_batch_index ] = sequence_number;
+		}
+		for( batch_index = 0;
+		     batch_index < EWF_TEST_REORDER_WINDOW_BATCH_SIZE;
+		     batch_index++ )
+		{
+			result = libcthreads_thread_pool_push(
+			          thread_pool,
+			          (intptr_t *) (intptr_t) ( batch[ batch_index ] + 1 ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	result = ewf_test_reorder_window_wait_for_output_values(
+	          &output_values,
+	          EWF_TEST_REORDER_WINDOW_NUMBER_OF_VALUES,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libcthreads_thread_pool_join(
+	          &thread_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_values.number_of_output_values",
+	 output_values.number_of_output_values,
+	 EWF_TEST_REORDER_WINDOW_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_values.number_of_out_of_order_values",
+	 output_values.number_of_out_of_order_values,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_values.number_of_failed_values",
+	 output_values.number_of_failed_values,
+	 0 );
+
+	/* Clean up
+	 */
+	result = reorder_window_free(
+	          &( output_values.reorder_window ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_free(
+	          &( output_values.condition ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &( output_values.mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( output_values.reorder_window != NULL )
+	{
+		reorder_window_free(
+		 &( output_values.reorder_window ),
+		 NULL );
+	}
+	if( output_values.condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( output_values.condition ),
+		 NULL );
+	}
+	if( output_values.mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( output_values.mutex ),
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "reorder_window_initialize",
+	 ewf_test_tools_reorder_window_initialize );
+
+	EWF_TEST_RUN(
+	 "reorder_window_free",
+	 ewf_test_tools_reorder_window_free );
+
+	EWF_TEST_RUN(
+	 "reorder_window_push",
+	 ewf_test_tools_reorder_window_push );
+
+	EWF_TEST_RUN(
+	 "reorder_window_push_slot_occupied",
+	 ewf_test_tools_reorder_window_push_slot_occupied );
+
+	EWF_TEST_RUN(
+	 "reorder_window_push_threaded",
+	 ewf_test_tools_reorder_window_push_threaded );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
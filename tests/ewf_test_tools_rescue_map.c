@@ -0,0 +1,993 @@
+/*
+ * Tools rescue_map functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/rescue_map.h"
+
+/* Tests the rescue_map_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_rescue_map_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	rescue_map_t *rescue_map         = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 2;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          0,
+	          1048576,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "rescue_map->number_of_ranges",
+	 rescue_map->number_of_ranges,
+	 1 );
+
+	result = rescue_map_free(
+	          &rescue_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = rescue_map_initialize(
+	          NULL,
+	          0,
+	          1048576,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	rescue_map = (rescue_map_t *) 0x12345678UL;
+
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          0,
+	          1048576,
+	          &error );
+
+	rescue_map = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test rescue_map_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = rescue_map_initialize(
+		          &rescue_map,
+		          0,
+		          1048576,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( rescue_map != NULL )
+			{
+				rescue_map_free(
+				 &rescue_map,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "rescue_map",
+			 rescue_map );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &rescue_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the rescue_map_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_rescue_map_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = rescue_map_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the rescue_map_set_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_rescue_map_set_range(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	rescue_map_t *rescue_map = NULL;
+	uint64_t range_offset    = 0;
+	uint64_t range_size      = 0;
+	uint8_t range_status     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          4096,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test splitting a range into 3 ranges
+	 */
+	result = rescue_map_set_range(
+	          rescue_map,
+	          8192,
+	          4096,
+	          RESCUE_MAP_STATUS_FINISHED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "rescue_map->number_of_ranges",
+	 rescue_map->number_of_ranges,
+	 3 );
+
+	result = rescue_map_get_range_by_index(
+	          rescue_map,
+	          1,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 8192 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 4096 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "range_status",
+	 range_status,
+	 RESCUE_MAP_STATUS_FINISHED );
+
+	/* Test merging adjacent ranges with the same status
+	 */
+	result = rescue_map_set_range(
+	          rescue_map,
+	          4096,
+	          4096,
+	          RESCUE_MAP_STATUS_FINISHED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "rescue_map->number_of_ranges",
+	 rescue_map->number_of_ranges,
+	 2 );
+
+	result = rescue_map_get_range_by_index(
+	          rescue_map,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 4096 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 8192 );
+
+	/* Test a range that spans multiple ranges
+	 */
+	result = rescue_map_set_range(
+	          rescue_map,
+	          32768,
+	          4096,
+	          RESCUE_MAP_STATUS_BAD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "rescue_map->number_of_ranges",
+	 rescue_map->number_of_ranges,
+	 4 );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          8192,
+	          61440,
+	          RESCUE_MAP_STATUS_NON_SPLIT,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "rescue_map->number_of_ranges",
+	 rescue_map->number_of_ranges,
+	 2 );
+
+	result = rescue_map_get_range_at_offset(
+	          rescue_map,
+	          65536,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 8192 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 61440 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "range_status",
+	 range_status,
+	 RESCUE_MAP_STATUS_NON_SPLIT );
+
+	/* Test error cases
+	 */
+	result = rescue_map_set_range(
+	          NULL,
+	          8192,
+	          4096,
+	          RESCUE_MAP_STATUS_FINISHED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          0,
+	          4096,
+	          RESCUE_MAP_STATUS_FINISHED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          65536,
+	          8192,
+	          RESCUE_MAP_STATUS_FINISHED,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          8192,
+	          4096,
+	          0xff,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = rescue_map_free(
+	          &rescue_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &rescue_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the rescue_map_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_rescue_map_get_range_at_offset(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	rescue_map_t *rescue_map = NULL;
+	uint64_t range_offset    = 0;
+	uint64_t range_size      = 0;
+	uint8_t range_status     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          0,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          16384,
+	          512,
+	          RESCUE_MAP_STATUS_BAD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = rescue_map_get_range_at_offset(
+	          rescue_map,
+	          16895,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 16384 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 512 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "range_status",
+	 range_status,
+	 RESCUE_MAP_STATUS_BAD );
+
+	result = rescue_map_get_range_at_offset(
+	          rescue_map,
+	          16896,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 16896 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "range_status",
+	 range_status,
+	 RESCUE_MAP_STATUS_NON_TRIED );
+
+	result = rescue_map_get_range_at_offset(
+	          rescue_map,
+	          65536,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = rescue_map_get_range_at_offset(
+	          NULL,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_get_range_at_offset(
+	          rescue_map,
+	          0,
+	          NULL,
+	          &range_size,
+	          &range_status,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = rescue_map_free(
+	          &rescue_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &rescue_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the rescue_map_get_range_by_status function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_rescue_map_get_range_by_status(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	rescue_map_t *rescue_map = NULL;
+	uint64_t range_offset    = 0;
+	uint64_t range_size      = 0;
+	int number_of_ranges     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = rescue_map_initialize(
+	          &rescue_map,
+	          0,
+	          65536,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          4096,
+	          512,
+	          RESCUE_MAP_STATUS_BAD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = rescue_map_set_range(
+	          rescue_map,
+	          32768,
+	          1024,
+	          RESCUE_MAP_STATUS_BAD,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = rescue_map_get_number_of_ranges_by_status(
+	          rescue_map,
+	          RESCUE_MAP_STATUS_BAD,
+	          &number_of_ranges,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_ranges",
+	 number_of_ranges,
+	 2 );
+
+	result = rescue_map_get_range_by_status(
+	          rescue_map,
+	          RESCUE_MAP_STATUS_BAD,
+	          1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_offset",
+	 range_offset,
+	 (uint64_t) 32768 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = rescue_map_get_range_by_status(
+	          rescue_map,
+	          RESCUE_MAP_STATUS_BAD,
+	          2,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = rescue_map_get_number_of_ranges_by_status(
+	          rescue_map,
+	          RESCUE_MAP_STATUS_BAD,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = rescue_map_free(
+	          &rescue_map,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "rescue_map",
+	 rescue_map );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( rescue_map != NULL )
+	{
+		rescue_map_free(
+		 &rescue_map,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "rescue_map_initialize",
+	 ewf_test_tools_rescue_map_initialize );
+
+	EWF_TEST_RUN(
+	 "rescue_map_free",
+	 ewf_test_tools_rescue_map_free );
+
+	EWF_TEST_RUN(
+	 "rescue_map_set_range",
+	 ewf_test_tools_rescue_map_set_range );
+
+	EWF_TEST_RUN(
+	 "rescue_map_get_range_at_offset",
+	 ewf_test_tools_rescue_map_get_range_at_offset );
+
+	EWF_TEST_RUN(
+	 "rescue_map_get_range_by_status",
+	 ewf_test_tools_rescue_map_get_range_by_status );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
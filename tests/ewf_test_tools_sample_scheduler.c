@@ -0,0 +1,774 @@
+/*
+ * Tools sample_scheduler functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/sample_scheduler.h"
+
+/* Tests the sample_scheduler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sample_scheduler_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	sample_scheduler_t *sample_scheduler = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = sample_scheduler_initialize(
+	          &sample_scheduler,
+	          1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_free(
+	          &sample_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sample_scheduler_initialize(
+	          NULL,
+	          1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sample_scheduler = (sample_scheduler_t *) 0x12345678UL;
+
+	result = sample_scheduler_initialize(
+	          &sample_scheduler,
+	          1024,
+	          0,
+	          &error );
+
+	sample_scheduler = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test sample_scheduler_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = sample_scheduler_initialize(
+		          &sample_scheduler,
+		          1024,
+		          0,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( sample_scheduler != NULL )
+			{
+				sample_scheduler_free(
+				 &sample_scheduler,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "sample_scheduler",
+			 sample_scheduler );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sample_scheduler != NULL )
+	{
+		sample_scheduler_free(
+		 &sample_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sample_scheduler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sample_scheduler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = sample_scheduler_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the sample_scheduler_append_random_sample function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sample_scheduler_append_random_sample(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	sample_scheduler_t *sample_scheduler = NULL;
+	uint64_t chunk_index                 = 0;
+	uint64_t number_of_chunk_indexes     = 0;
+	uint64_t previous_chunk_index        = 0;
+	int number_of_iterations             = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = sample_scheduler_initialize(
+	          &sample_scheduler,
+	          1000,
+	          12345,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = sample_scheduler_append_random_sample(
+	          sample_scheduler,
+	          50,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_get_number_of_chunk_indexes(
+	          sample_scheduler,
+	          &number_of_chunk_indexes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunk_indexes",
+	 number_of_chunk_indexes,
+	 (uint64_t) 50 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The random sample is in ascending order without duplicates
+	 */
+	do
+	{
+		result = sample_scheduler_get_next_chunk_index(
+		          sample_scheduler,
+		          &chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result != 0 )
+		{
+			EWF_TEST_ASSERT_LESS_THAN_UINT64(
+			 "chunk_index",
+			 chunk_index,
+			 (uint64_t) 1000 );
+
+			if( number_of_iterations > 0 )
+			{
+				EWF_TEST_ASSERT_LESS_THAN_UINT64(
+				 "previous_chunk_index",
+				 previous_chunk_index,
+				 chunk_index );
+			}
+			previous_chunk_index = chunk_index;
+
+			number_of_iterations++;
+		}
+	}
+	while( result != 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_iterations",
+	 number_of_iterations,
+	 50 );
+
+	/* A sample larger than the number of chunks is truncated
+	 */
+	result = sample_scheduler_append_random_sample(
+	          sample_scheduler,
+	          5000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_sort(
+	          sample_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_get_number_of_chunk_indexes(
+	          sample_scheduler,
+	          &number_of_chunk_indexes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunk_indexes",
+	 number_of_chunk_indexes,
+	 (uint64_t) 1000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sample_scheduler_append_random_sample(
+	          NULL,
+	          50,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = sample_scheduler_free(
+	          &sample_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sample_scheduler != NULL )
+	{
+		sample_scheduler_free(
+		 &sample_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the sample_scheduler_append_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_sample_scheduler_append_range(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	sample_scheduler_t *sample_scheduler = NULL;
+	uint64_t chunk_index                 = 0;
+	uint64_t expected_chunk_index        = 0;
+	uint64_t number_of_chunk_indexes     = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = sample_scheduler_initialize(
+	          &sample_scheduler,
+	          100,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = sample_scheduler_append_range(
+	          sample_scheduler,
+	          20,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Overlapping ranges are merged by sort
+	 */
+	result = sample_scheduler_append_range(
+	          sample_scheduler,
+	          10,
+	          15,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A range beyond the last chunk is truncated
+	 */
+	result = sample_scheduler_append_range(
+	          sample_scheduler,
+	          95,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_sort(
+	          sample_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = sample_scheduler_get_number_of_chunk_indexes(
+	          sample_scheduler,
+	          &number_of_chunk_indexes,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_chunk_indexes",
+	 number_of_chunk_indexes,
+	 (uint64_t) 25 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( expected_chunk_index = 10;
+	     expected_chunk_index < 30;
+	     expected_chunk_index++ )
+	{
+		result = sample_scheduler_get_next_chunk_index(
+		          sample_scheduler,
+		          &chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_index",
+		 chunk_index,
+		 expected_chunk_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( expected_chunk_index = 95;
+	     expected_chunk_index < 100;
+	     expected_chunk_index++ )
+	{
+		result = sample_scheduler_get_next_chunk_index(
+		          sample_scheduler,
+		          &chunk_index,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_index",
+		 chunk_index,
+		 expected_chunk_index );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = sample_scheduler_get_next_chunk_index(
+	          sample_scheduler,
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = sample_scheduler_append_range(
+	          NULL,
+	          20,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sample_scheduler_append_range(
+	          sample_scheduler,
+	          100,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sample_scheduler_get_next_chunk_index(
+	          NULL,
+	          &chunk_index,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = sample_scheduler_get_next_chunk_index(
+	          sample_scheduler,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = sample_scheduler_free(
+	          &sample_scheduler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "sample_scheduler",
+	 sample_scheduler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sample_scheduler != NULL )
+	{
+		sample_scheduler_free(
+		 &sample_scheduler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "sample_scheduler_initialize",
+	 ewf_test_tools_sample_scheduler_initialize );
+
+	EWF_TEST_RUN(
+	 "sample_scheduler_free",
+	 ewf_test_tools_sample_scheduler_free );
+
+	EWF_TEST_RUN(
+	 "sample_scheduler_append_random_sample",
+	 ewf_test_tools_sample_scheduler_append_random_sample );
+
+	EWF_TEST_RUN(
+	 "sample_scheduler_append_range",
+	 ewf_test_tools_sample_scheduler_append_range );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1436 @@
+/*
+ * Tools split_raw_writer type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/split_raw_writer.h"
+
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+/* The test writes ewf_test_split_raw.raw.### segment files in the current working directory
+ */
+#define EWF_TEST_SPLIT_RAW_WRITER_BASENAME		"ewf_test_split_raw"
+
+#define EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE		10000
+#define EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE		4096
+
+/* Retrieves the size of a segment file
+ * Returns 1 if successful, 0 if the segment file does not exist or -1 on error
+ */
+int ewf_test_tools_split_raw_writer_get_segment_file_size(
+     split_raw_writer_t *split_raw_writer,
+     int segment_file_index,
+     size64_t *file_size )
+{
+	struct stat file_statistics;
+
+	char filename[ 64 ];
+
+	if( file_size == NULL )
+	{
+		return( -1 );
+	}
+	if( split_raw_writer_get_segment_filename(
+	     split_raw_writer,
+	     segment_file_index,
+	     filename,
+	     64,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( stat(
+	     filename,
+	     &file_statistics ) != 0 )
+	{
+		return( 0 );
+	}
+	*file_size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+/* Removes the segment files
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_tools_split_raw_writer_remove_segment_files(
+     split_raw_writer_t *split_raw_writer )
+{
+	char filename[ 64 ];
+
+	int segment_file_index = 0;
+
+	if( split_raw_writer == NULL )
+	{
+		return( -1 );
+	}
+	for( segment_file_index = 0;
+	     segment_file_index < split_raw_writer->number_of_segment_files;
+	     segment_file_index++ )
+	{
+		if( split_raw_writer_get_segment_filename(
+		     split_raw_writer,
+		     segment_file_index,
+		     filename,
+		     64,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+		unlink(
+		 filename );
+	}
+	return( 1 );
+}
+
+/* Tests the split_raw_writer_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	split_raw_writer_t *split_raw_writer = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 2;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "split_raw_writer",
+	 split_raw_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "split_raw_writer",
+	 split_raw_writer );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_initialize(
+	          NULL,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	split_raw_writer = (split_raw_writer_t *) 0x12345678UL;
+
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	split_raw_writer = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          "",
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "split_raw_writer",
+	 split_raw_writer );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test split_raw_writer_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = split_raw_writer_initialize(
+		          &split_raw_writer,
+		          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( split_raw_writer != NULL )
+			{
+				split_raw_writer_free(
+				 &split_raw_writer,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "split_raw_writer",
+			 split_raw_writer );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_raw_writer != NULL )
+	{
+		split_raw_writer_free(
+		 &split_raw_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the split_raw_writer_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the split_raw_writer_set_media_values function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_set_media_values(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	split_raw_writer_t *split_raw_writer = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->number_of_segment_files",
+	 split_raw_writer->number_of_segment_files,
+	 3 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_remaining_sizes[ 0 ]",
+	 split_raw_writer->segment_file_remaining_sizes[ 0 ],
+	 (uint64_t) EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE );
+
+	/* The last segment file contains the remainder of the media
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_remaining_sizes[ 2 ]",
+	 split_raw_writer->segment_file_remaining_sizes[ 2 ],
+	 (uint64_t) ( EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE - ( 2 * EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE ) ) );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 2 ]",
+	 split_raw_writer->segment_file_descriptors[ 2 ],
+	 -1 );
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A maximum segment size of 0 represents a single segment file
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->number_of_segment_files",
+	 split_raw_writer->number_of_segment_files,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_size",
+	 split_raw_writer->segment_file_size,
+	 (uint64_t) EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_set_media_values(
+	          NULL,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          0,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_raw_writer != NULL )
+	{
+		split_raw_writer_free(
+		 &split_raw_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the split_raw_writer_get_segment_filename function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_get_segment_filename(
+     void )
+{
+	char filename[ 64 ];
+
+	libcerror_error_t *error             = NULL;
+	split_raw_writer_t *split_raw_writer = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = split_raw_writer_get_segment_filename(
+	          split_raw_writer,
+	          2,
+	          filename,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          filename,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME ".raw.002",
+	          narrow_string_length( EWF_TEST_SPLIT_RAW_WRITER_BASENAME ".raw.002" ) + 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_get_segment_filename(
+	          NULL,
+	          2,
+	          filename,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_get_segment_filename(
+	          split_raw_writer,
+	          3,
+	          filename,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_get_segment_filename(
+	          split_raw_writer,
+	          2,
+	          NULL,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_get_segment_filename(
+	          split_raw_writer,
+	          2,
+	          filename,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = split_raw_writer_get_segment_filename(
+	          split_raw_writer,
+	          0,
+	          filename,
+	          64,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A single segment file has no segment number extension
+	 */
+	result = narrow_string_compare(
+	          filename,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME ".raw",
+	          narrow_string_length( EWF_TEST_SPLIT_RAW_WRITER_BASENAME ".raw" ) + 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_raw_writer != NULL )
+	{
+		split_raw_writer_free(
+		 &split_raw_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the split_raw_writer_write_range function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_write_range(
+     void )
+{
+	uint8_t data[ EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE ];
+
+	libcerror_error_t *error             = NULL;
+	split_raw_writer_t *split_raw_writer = NULL;
+	size64_t file_size                   = 0;
+	size_t data_offset                   = 0;
+	int result                           = 0;
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE;
+	     data_offset++ )
+	{
+		data[ data_offset ] = (uint8_t) ( ( data_offset % 251 ) + 1 );
+	}
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* A range that crosses a segment file boundary is split over both segment files
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          4000,
+	          &( data[ 4000 ] ),
+	          200,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_remaining_sizes[ 0 ]",
+	 split_raw_writer->segment_file_remaining_sizes[ 0 ],
+	 (uint64_t) 4000 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_remaining_sizes[ 1 ]",
+	 split_raw_writer->segment_file_remaining_sizes[ 1 ],
+	 (uint64_t) ( EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE - 104 ) );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 0 ]",
+	 split_raw_writer->segment_file_descriptors[ 0 ],
+	 -1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 1 ]",
+	 split_raw_writer->segment_file_descriptors[ 1 ],
+	 -1 );
+
+	/* The segment file that was not written is not opened
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 2 ]",
+	 split_raw_writer->segment_file_descriptors[ 2 ],
+	 -1 );
+
+	/* A segment file is closed as soon as it was completely written
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          0,
+	          data,
+	          4000,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "split_raw_writer->segment_file_remaining_sizes[ 0 ]",
+	 split_raw_writer->segment_file_remaining_sizes[ 0 ],
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 0 ]",
+	 split_raw_writer->segment_file_descriptors[ 0 ],
+	 -1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 1 ]",
+	 split_raw_writer->segment_file_descriptors[ 1 ],
+	 -1 );
+
+	result = ewf_test_tools_split_raw_writer_get_segment_file_size(
+	          split_raw_writer,
+	          0,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 file_size,
+	 (uint64_t) EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE );
+
+	/* Test error cases
+	 */
+	result = split_raw_writer_write_range(
+	          NULL,
+	          0,
+	          data,
+	          4000,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE - 100,
+	          data,
+	          200,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          0,
+	          NULL,
+	          4000,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Releasing more than remains of a segment file is an error
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          0,
+	          data,
+	          4000,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = split_raw_writer_close_segment_files(
+	          split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 1 ]",
+	 split_raw_writer->segment_file_descriptors[ 1 ],
+	 -1 );
+
+	ewf_test_tools_split_raw_writer_remove_segment_files(
+	 split_raw_writer );
+
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_raw_writer != NULL )
+	{
+		split_raw_writer_close_segment_files(
+		 split_raw_writer,
+		 NULL );
+
+		ewf_test_tools_split_raw_writer_remove_segment_files(
+		 split_raw_writer );
+
+		split_raw_writer_free(
+		 &split_raw_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the split_raw_writer_write_range function with sparse output
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_split_raw_writer_write_range_sparse(
+     void )
+{
+	uint8_t data[ EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE ];
+
+	libcerror_error_t *error             = NULL;
+	split_raw_writer_t *split_raw_writer = NULL;
+	size64_t file_size                   = 0;
+	int result                           = 0;
+
+	memory_set(
+	 data,
+	 0,
+	 EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE );
+
+	data[ 16 ] = 0xff;
+
+	/* Initialize test
+	 */
+	result = split_raw_writer_initialize(
+	          &split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_BASENAME,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_set_media_values(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+
+	/* A segment file that only contains empty ranges is created and sized when completed
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          data,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "split_raw_writer->segment_file_descriptors[ 1 ]",
+	 split_raw_writer->segment_file_descriptors[ 1 ],
+	 -1 );
+
+	result = ewf_test_tools_split_raw_writer_get_segment_file_size(
+	          split_raw_writer,
+	          1,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 file_size,
+	 (uint64_t) EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE );
+
+	/* A segment file of which the trailing range is empty is extended to its full size
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          0,
+	          data,
+	          32,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          32,
+	          data,
+	          EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE - 32,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_split_raw_writer_get_segment_file_size(
+	          split_raw_writer,
+	          0,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 file_size,
+	 (uint64_t) EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE );
+
+	/* The last segment file is sized to the remainder of the media
+	 */
+	result = split_raw_writer_write_range(
+	          split_raw_writer,
+	          2 * EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE,
+	          data,
+	          EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE - ( 2 * EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE ),
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ewf_test_tools_split_raw_writer_get_segment_file_size(
+	          split_raw_writer,
+	          2,
+	          &file_size );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "file_size",
+	 file_size,
+	 (uint64_t) ( EWF_TEST_SPLIT_RAW_WRITER_MEDIA_SIZE - ( 2 * EWF_TEST_SPLIT_RAW_WRITER_SEGMENT_SIZE ) ) );
+
+	/* Clean up
+	 */
+	ewf_test_tools_split_raw_writer_remove_segment_files(
+	 split_raw_writer );
+
+	result = split_raw_writer_free(
+	          &split_raw_writer,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( split_raw_writer != NULL )
+	{
+		split_raw_writer_close_segment_files(
+		 split_raw_writer,
+		 NULL );
+
+		ewf_test_tools_split_raw_writer_remove_segment_files(
+		 split_raw_writer );
+
+		split_raw_writer_free(
+		 &split_raw_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_initialize",
+	 ewf_test_tools_split_raw_writer_initialize );
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_free",
+	 ewf_test_tools_split_raw_writer_free );
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_set_media_values",
+	 ewf_test_tools_split_raw_writer_set_media_values );
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_get_segment_filename",
+	 ewf_test_tools_split_raw_writer_get_segment_filename );
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_write_range",
+	 ewf_test_tools_split_raw_writer_write_range );
+
+	EWF_TEST_RUN(
+	 "split_raw_writer_write_range_sparse",
+	 ewf_test_tools_split_raw_writer_write_range_sparse );
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( SPLIT_RAW_WRITER_HAVE_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( SPLIT_RAW_WRITER_HAVE_SUPPORT ) */
+}
+
@@ -0,0 +1,1231 @@
+/*
+ * Tools stage_profiler functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/stage_profiler.h"
+
+/* Tests the stage_profiler_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_initialize(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stage_profiler = (stage_profiler_t *) 0x12345678UL;
+
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	stage_profiler = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test stage_profiler_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = stage_profiler_initialize(
+		          &stage_profiler,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( stage_profiler != NULL )
+			{
+				stage_profiler_free(
+				 &stage_profiler,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "stage_profiler",
+			 stage_profiler );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = stage_profiler_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_get_timestamp function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_get_timestamp(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int64_t timestamp        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_get_timestamp(
+	          &timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_get_timestamp(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_add_sample function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_add_sample(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	int64_t start_timestamp          = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_get_timestamp(
+	          &start_timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_add_sample(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_HASH,
+	          start_timestamp,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_sample(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_HASH,
+	          start_timestamp,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_HASH ].number_of_samples",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_HASH ].number_of_samples,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_HASH ].number_of_bytes",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_HASH ].number_of_bytes,
+	 (uint64_t) 65536 );
+
+	result = stage_profiler_add_bytes(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_WRITE,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_samples",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_samples,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_bytes",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_bytes,
+	 (uint64_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_add_sample(
+	          NULL,
+	          STAGE_PROFILER_STAGE_HASH,
+	          start_timestamp,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_add_sample(
+	          stage_profiler,
+	          STAGE_PROFILER_NUMBER_OF_STAGES,
+	          start_timestamp,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_add_bytes(
+	          stage_profiler,
+	          -1,
+	          4096,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_add_wait function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_add_wait(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	int64_t start_timestamp          = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_get_timestamp(
+	          &start_timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_add_wait(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_WRITE,
+	          start_timestamp - 1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_stalls",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_WRITE ].number_of_stalls,
+	 (uint64_t) 1 );
+
+	/* A wait that ends before it started is not counted as a stall
+	 */
+	result = stage_profiler_add_wait(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_READ,
+	          start_timestamp + 1000000000,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls",
+	 stage_profiler->stages[ STAGE_PROFILER_STAGE_READ ].number_of_stalls,
+	 (uint64_t) 0 );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_add_wait(
+	          NULL,
+	          STAGE_PROFILER_STAGE_WRITE,
+	          start_timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_add_wait(
+	          stage_profiler,
+	          STAGE_PROFILER_NUMBER_OF_STAGES,
+	          start_timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_add_queue_depth function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_add_queue_depth(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_DIGEST,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_DIGEST,
+	          7,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].number_of_samples",
+	 stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].number_of_samples,
+	 (uint64_t) 2 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].total_depth",
+	 stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].total_depth,
+	 (uint64_t) 10 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].maximum_depth",
+	 stage_profiler->queues[ STAGE_PROFILER_QUEUE_DIGEST ].maximum_depth,
+	 (uint64_t) 7 );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_add_queue_depth(
+	          NULL,
+	          STAGE_PROFILER_QUEUE_DIGEST,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_NUMBER_OF_QUEUES,
+	          3,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_get_samples function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_get_samples(
+     void )
+{
+	stage_profiler_queue_t queues[ STAGE_PROFILER_NUMBER_OF_QUEUES ];
+	stage_profiler_stage_t stages[ STAGE_PROFILER_NUMBER_OF_STAGES ];
+
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	uint64_t elapsed_time            = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_bytes(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_PACK,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_output_bytes(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_PACK,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_WRITE,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_get_samples(
+	          stage_profiler,
+	          stages,
+	          queues,
+	          &elapsed_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stages[ STAGE_PROFILER_STAGE_PACK ].number_of_bytes",
+	 stages[ STAGE_PROFILER_STAGE_PACK ].number_of_bytes,
+	 (uint64_t) 32768 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "stages[ STAGE_PROFILER_STAGE_PACK ].number_of_output_bytes",
+	 stages[ STAGE_PROFILER_STAGE_PACK ].number_of_output_bytes,
+	 (uint64_t) 8192 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "queues[ STAGE_PROFILER_QUEUE_WRITE ].maximum_depth",
+	 queues[ STAGE_PROFILER_QUEUE_WRITE ].maximum_depth,
+	 (uint64_t) 5 );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_get_samples(
+	          NULL,
+	          stages,
+	          queues,
+	          &elapsed_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_get_samples(
+	          stage_profiler,
+	          NULL,
+	          queues,
+	          &elapsed_time,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_add_output_bytes(
+	          stage_profiler,
+	          STAGE_PROFILER_NUMBER_OF_STAGES,
+	          8192,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the stage_profiler_fprint function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_stage_profiler_fprint(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	stage_profiler_t *stage_profiler = NULL;
+	int64_t start_timestamp          = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = stage_profiler_initialize(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_start(
+	          stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_get_timestamp(
+	          &start_timestamp,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_sample(
+	          stage_profiler,
+	          STAGE_PROFILER_STAGE_READ,
+	          start_timestamp,
+	          32768,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = stage_profiler_add_queue_depth(
+	          stage_profiler,
+	          STAGE_PROFILER_QUEUE_IN_FLIGHT,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = stage_profiler_fprint(
+	          stage_profiler,
+	          stdout,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = stage_profiler_fprint(
+	          NULL,
+	          stdout,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = stage_profiler_fprint(
+	          stage_profiler,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = stage_profiler_free(
+	          &stage_profiler,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "stage_profiler",
+	 stage_profiler );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stage_profiler != NULL )
+	{
+		stage_profiler_free(
+		 &stage_profiler,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	EWF_TEST_RUN(
+	 "stage_profiler_initialize",
+	 ewf_test_tools_stage_profiler_initialize );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_free",
+	 ewf_test_tools_stage_profiler_free );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_get_timestamp",
+	 ewf_test_tools_stage_profiler_get_timestamp );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_add_sample",
+	 ewf_test_tools_stage_profiler_add_sample );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_add_wait",
+	 ewf_test_tools_stage_profiler_add_wait );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_add_queue_depth",
+	 ewf_test_tools_stage_profiler_add_queue_depth );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_get_samples",
+	 ewf_test_tools_stage_profiler_get_samples );
+
+	EWF_TEST_RUN(
+	 "stage_profiler_fprint",
+	 ewf_test_tools_stage_profiler_fprint );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1072 @@
+/*
+ * Tools system_resources functions test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/system_resources.h"
+
+#if !defined( WINAPI )
+
+/* Tests the system_resources_copy_from_decimal_string function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_copy_from_decimal_string(
+     void )
+{
+	uint64_t value      = 0;
+	size_t string_index = 0;
+	int result          = 0;
+
+	/* Test regular cases
+	 */
+	result = system_resources_copy_from_decimal_string(
+	          "  200000 100000\n",
+	          16,
+	          &value,
+	          &string_index );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 200000 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "string_index",
+	 string_index,
+	 (size_t) 8 );
+
+	/* Test a string that does not start with a decimal value
+	 */
+	result = system_resources_copy_from_decimal_string(
+	          "max 100000\n",
+	          11,
+	          &value,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test a value that does not fit in 64-bit
+	 */
+	result = system_resources_copy_from_decimal_string(
+	          "99999999999999999999\n",
+	          21,
+	          &value,
+	          NULL );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the system_resources_get_number_of_processors_from_quota function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_number_of_processors_from_quota(
+     void )
+{
+	int number_of_processors = 0;
+	int result               = 0;
+
+	/* Test a quota of 2 processors
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_quota(
+	          200000,
+	          100000,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 2 );
+
+	/* Test that a partial processor is rounded up
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_quota(
+	          150000,
+	          100000,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 2 );
+
+	/* Test a quota of less than 1 processor
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_quota(
+	          50000,
+	          100000,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 1 );
+
+	/* Test a quota of 0
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_quota(
+	          0,
+	          100000,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	/* Test a period of 0
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_quota(
+	          100000,
+	          0,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the system_resources_get_number_of_processors_from_cpu_max function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_number_of_processors_from_cpu_max(
+     void )
+{
+	int number_of_processors = 0;
+	int result               = 0;
+
+	/* Test a cpu.max with a quota of 2 processors
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "200000 100000\n",
+	          15,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 2 );
+
+	/* Test a cpu.max with a quota of 2.5 processors
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "250000 100000\n",
+	          15,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 3 );
+
+	/* Test a cpu.max with a quota of half a processor
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "50000 100000\n",
+	          14,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 1 );
+
+	/* Test a cpu.max without a quota
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "max 100000\n",
+	          11,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	/* Test a cpu.max without a period
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "200000\n",
+	          7,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	/* Test an empty cpu.max
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cpu_max(
+	          "",
+	          0,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the system_resources_get_number_of_processors_from_cfs_quota function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_number_of_processors_from_cfs_quota(
+     void )
+{
+	int number_of_processors = 0;
+	int result               = 0;
+
+	/* Test a cpu.cfs_quota_us with a quota of 3 processors
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cfs_quota(
+	          "300000\n",
+	          7,
+	          "100000\n",
+	          7,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 3 );
+
+	/* Test a cpu.cfs_quota_us with a quota of a quarter processor
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cfs_quota(
+	          "25000\n",
+	          6,
+	          "100000\n",
+	          7,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 1 );
+
+	/* Test a cpu.cfs_quota_us without a quota
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cfs_quota(
+	          "-1\n",
+	          3,
+	          "100000\n",
+	          7,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	/* Test a cpu.cfs_period_us of 0
+	 */
+	number_of_processors = -1;
+
+	result = system_resources_get_number_of_processors_from_cfs_quota(
+	          "300000\n",
+	          7,
+	          "0\n",
+	          2,
+	          &number_of_processors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_processors",
+	 number_of_processors,
+	 -1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the system_resources_get_memory_limit_from_string function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_memory_limit_from_string(
+     void )
+{
+	size64_t memory_limit = 0;
+	int result            = 0;
+
+	/* Test a memory.max with a limit of 512 MiB
+	 */
+	memory_limit = 0;
+
+	result = system_resources_get_memory_limit_from_string(
+	          "536870912\n",
+	          10,
+	          &memory_limit );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_limit",
+	 memory_limit,
+	 (uint64_t) 536870912 );
+
+	/* Test a memory.max without a limit
+	 */
+	memory_limit = 0;
+
+	result = system_resources_get_memory_limit_from_string(
+	          "max\n",
+	          4,
+	          &memory_limit );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_limit",
+	 memory_limit,
+	 (uint64_t) 0 );
+
+	/* Test a memory.limit_in_bytes without a limit
+	 */
+	memory_limit = 0;
+
+	result = system_resources_get_memory_limit_from_string(
+	          "9223372036854771712\n",
+	          20,
+	          &memory_limit );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_limit",
+	 memory_limit,
+	 (uint64_t) 0 );
+
+	/* Test a memory.max of 0
+	 */
+	memory_limit = 0;
+
+	result = system_resources_get_memory_limit_from_string(
+	          "0\n",
+	          2,
+	          &memory_limit );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "memory_limit",
+	 memory_limit,
+	 (uint64_t) 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* !defined( WINAPI ) */
+
+/* Tests the system_resources_get_number_of_processors function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_number_of_processors(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_processors = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = system_resources_get_number_of_processors(
+	          &number_of_processors,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 1 )
+	{
+		EWF_TEST_ASSERT_GREATER_THAN_INT(
+		 "number_of_processors",
+		 number_of_processors,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = system_resources_get_number_of_processors(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the system_resources_get_automatic_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_automatic_number_of_threads(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_threads    = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = system_resources_get_automatic_number_of_threads(
+	          &number_of_threads,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	EWF_TEST_ASSERT_LESS_THAN_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 SYSTEM_RESOURCES_MAXIMUM_NUMBER_OF_THREADS + 1 );
+
+	/* Test error cases
+	 */
+	result = system_resources_get_automatic_number_of_threads(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the system_resources_get_automatic_process_buffers_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_automatic_process_buffers_size(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	size64_t process_buffers_size  = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = system_resources_get_automatic_process_buffers_size(
+	          SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE,
+	          &process_buffers_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "process_buffers_size",
+	 process_buffers_size,
+	 (uint64_t) SYSTEM_RESOURCES_MAXIMUM_PROCESS_BUFFERS_SIZE + 1 );
+
+	EWF_TEST_ASSERT_LESS_THAN_UINT64(
+	 "process_buffers_size",
+	 (uint64_t) SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE - 1,
+	 process_buffers_size );
+
+	/* Test error cases
+	 */
+	result = system_resources_get_automatic_process_buffers_size(
+	          SYSTEM_RESOURCES_MINIMUM_PROCESS_BUFFERS_SIZE,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the system_resources_get_adaptive_number_of_buffers function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_system_resources_get_adaptive_number_of_buffers(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_buffers    = 0;
+	int result               = 0;
+
+	/* Test that reading that stalled while the buffers were in flight increases the number by a quarter
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          32,
+	          (uint64_t) 3,
+	          (uint64_t) 8,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 10 );
+
+	/* Test that a small number is increased by 1
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          3,
+	          2,
+	          32,
+	          (uint64_t) 1,
+	          (uint64_t) 3,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 4 );
+
+	/* Test that the number is not increased beyond the maximum
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          30,
+	          2,
+	          32,
+	          (uint64_t) 1,
+	          (uint64_t) 30,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 32 );
+
+	/* Test that reading that stalled while few buffers were in flight does not change the number
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          32,
+	          (uint64_t) 3,
+	          (uint64_t) 5,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 8 );
+
+	/* Test that reading that did not stall while few buffers were in flight decreases the number by 1
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 3,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 7 );
+
+	/* Test that reading that did not stall while half of the buffers were in flight does not change the number
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 4,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 8 );
+
+	/* Test that the number is not decreased below the minimum
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          2,
+	          2,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 0,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 2 );
+
+	/* Test that a number beyond the maximum is bounded
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          40,
+	          2,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 32,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "number_of_buffers",
+	 number_of_buffers,
+	 32 );
+
+	/* Test error cases
+	 */
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          0,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 0,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          1,
+	          (uint64_t) 0,
+	          (uint64_t) 0,
+	          &number_of_buffers,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = system_resources_get_adaptive_number_of_buffers(
+	          8,
+	          2,
+	          32,
+	          (uint64_t) 0,
+	          (uint64_t) 0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if !defined( WINAPI )
+	EWF_TEST_RUN(
+	 "system_resources_copy_from_decimal_string",
+	 ewf_test_tools_system_resources_copy_from_decimal_string );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_number_of_processors_from_quota",
+	 ewf_test_tools_system_resources_get_number_of_processors_from_quota );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_number_of_processors_from_cpu_max",
+	 ewf_test_tools_system_resources_get_number_of_processors_from_cpu_max );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_number_of_processors_from_cfs_quota",
+	 ewf_test_tools_system_resources_get_number_of_processors_from_cfs_quota );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_memory_limit_from_string",
+	 ewf_test_tools_system_resources_get_memory_limit_from_string );
+
+#endif /* !defined( WINAPI ) */
+
+	EWF_TEST_RUN(
+	 "system_resources_get_number_of_processors",
+	 ewf_test_tools_system_resources_get_number_of_processors );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_automatic_number_of_threads",
+	 ewf_test_tools_system_resources_get_automatic_number_of_threads );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_automatic_process_buffers_size",
+	 ewf_test_tools_system_resources_get_automatic_process_buffers_size );
+
+	EWF_TEST_RUN(
+	 "system_resources_get_adaptive_number_of_buffers",
+	 ewf_test_tools_system_resources_get_adaptive_number_of_buffers );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
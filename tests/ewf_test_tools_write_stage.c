@@ -0,0 +1,1353 @@
+/*
+ * Tools write_stage type test program
+ *
+ * Copyright (C) 2006-2026, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/write_stage.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+#define EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES		256
+#define EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES	8
+
+typedef struct ewf_test_write_stage_output ewf_test_write_stage_output_t;
+
+struct ewf_test_write_stage_output
+{
+	/* The number of writes
+	 */
+	int number_of_writes;
+
+	/* The number of values that were written out of order
+	 */
+	int number_of_out_of_order_writes;
+
+	/* The number of iterations to delay a write, to vary the progress of the output threads
+	 */
+	int delay;
+
+	/* The write at which the write fails or -1 if the writes do not fail
+	 */
+	int failing_write;
+};
+
+typedef struct ewf_test_write_stage_release_values ewf_test_write_stage_release_values_t;
+
+struct ewf_test_write_stage_release_values
+{
+	/* The outputs
+	 */
+	ewf_test_write_stage_output_t *outputs;
+
+	/* The number of outputs
+	 */
+	int number_of_outputs;
+
+	/* The number of released values
+	 */
+	int number_of_released_values;
+
+	/* The number of values that were released as not written
+	 */
+	int number_of_unwritten_values;
+
+	/* The number of values that were released out of order
+	 */
+	int number_of_out_of_order_values;
+
+	/* The number of values that were released before all outputs were written
+	 */
+	int number_of_early_released_values;
+};
+
+/* Writes a value to the test output
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_stage_write(
+     intptr_t *handle,
+     intptr_t *value,
+     libcerror_error_t **error )
+{
+	ewf_test_write_stage_output_t *output = NULL;
+	static char *function                 = "ewf_test_write_stage_write";
+	volatile int delay_iterator           = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	output = (ewf_test_write_stage_output_t *) handle;
+
+	if( output->number_of_writes == output->failing_write )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write value.",
+		 function );
+
+		return( -1 );
+	}
+	for( delay_iterator = 0;
+	     delay_iterator < ( output->delay * ( ( output->number_of_writes + output->delay ) % 7 ) );
+	     delay_iterator++ )
+	{
+	}
+	/* Every output should write the values in the order they were pushed
+	 */
+	if( *( (int *) value ) != output->number_of_writes )
+	{
+		output->number_of_out_of_order_writes += 1;
+	}
+	output->number_of_writes += 1;
+
+	return( 1 );
+}
+
+/* Releases a test value
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_stage_release(
+     intptr_t *value,
+     uint8_t is_written,
+     void *arguments )
+{
+	ewf_test_write_stage_release_values_t *release_values = NULL;
+	int output_index                                      = 0;
+	int value_index                                       = 0;
+
+	if( ( value == NULL )
+	 || ( arguments == NULL ) )
+	{
+		return( -1 );
+	}
+	release_values = (ewf_test_write_stage_release_values_t *) arguments;
+
+	value_index = *( (int *) value );
+
+	if( value_index != release_values->number_of_released_values )
+	{
+		release_values->number_of_out_of_order_values += 1;
+	}
+	if( is_written == 0 )
+	{
+		release_values->number_of_unwritten_values += 1;
+	}
+	/* A value should only be released after every output has written it
+	 */
+	for( output_index = 0;
+	     output_index < release_values->number_of_outputs;
+	     output_index++ )
+	{
+		if( release_values->outputs[ output_index ].number_of_writes <= value_index )
+		{
+			release_values->number_of_early_released_values += 1;
+
+			break;
+		}
+	}
+	release_values->number_of_released_values += 1;
+
+	return( 1 );
+}
+
+/* Tests the write_stage_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_initialize(
+     void )
+{
+	ewf_test_write_stage_release_values_t release_values;
+
+	write_stage_t *write_stage      = NULL;
+	libcerror_error_t *error        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_write_stage_release_values_t ) );
+
+	/* Test regular cases
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_stage->number_of_outputs",
+	 write_stage->number_of_outputs,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_stage->maximum_number_of_queued_values",
+	 write_stage->maximum_number_of_queued_values,
+	 EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES );
+
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = write_stage_initialize(
+	          NULL,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_stage = (write_stage_t *) 0x12345678UL;
+
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	write_stage = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_initialize(
+	          &write_stage,
+	          0,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          NULL,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test write_stage_initialize with malloc failing
+		 */
+		ewf_test_malloc_attempts_before_fail = test_number;
+
+		result = write_stage_initialize(
+		          &write_stage,
+		          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+		          &ewf_test_write_stage_release,
+		          (void *) &release_values,
+		          &error );
+
+		if( ewf_test_malloc_attempts_before_fail != -1 )
+		{
+			ewf_test_malloc_attempts_before_fail = -1;
+
+			if( write_stage != NULL )
+			{
+				write_stage_free(
+				 &write_stage,
+				 NULL );
+			}
+		}
+		else
+		{
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "write_stage",
+			 write_stage );
+
+			EWF_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_EWF_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_stage != NULL )
+	{
+		write_stage_free(
+		 &write_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the write_stage_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = write_stage_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the write_stage_append_output function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_append_output(
+     void )
+{
+	ewf_test_write_stage_output_t outputs[ WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS + 1 ];
+	ewf_test_write_stage_release_values_t release_values;
+
+	write_stage_t *write_stage = NULL;
+	libcerror_error_t *error   = NULL;
+	int output_index           = 0;
+	int result                 = 0;
+
+	memory_set(
+	 outputs,
+	 0,
+	 sizeof( ewf_test_write_stage_output_t ) * ( WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS + 1 ) );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_write_stage_release_values_t ) );
+
+	/* Initialize test
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		result = write_stage_append_output(
+		          write_stage,
+		          (intptr_t *) &( outputs[ output_index ] ),
+		          &ewf_test_write_stage_write,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_stage->number_of_outputs",
+	 write_stage->number_of_outputs,
+	 WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS );
+
+	/* Test error cases
+	 */
+	result = write_stage_append_output(
+	          write_stage,
+	          (intptr_t *) &( outputs[ WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS ] ),
+	          &ewf_test_write_stage_write,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_append_output(
+	          NULL,
+	          (intptr_t *) &( outputs[ 0 ] ),
+	          &ewf_test_write_stage_write,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Initialize test
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = write_stage_append_output(
+	          write_stage,
+	          NULL,
+	          &ewf_test_write_stage_write,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_append_output(
+	          write_stage,
+	          (intptr_t *) &( outputs[ 0 ] ),
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_stage->number_of_outputs",
+	 write_stage->number_of_outputs,
+	 0 );
+
+	/* Clean up
+	 */
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_stage != NULL )
+	{
+		write_stage_free(
+		 &write_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the write_stage_push function
+ * The values must be written to both outputs and released in the order they were pushed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_push(
+     void )
+{
+	ewf_test_write_stage_output_t outputs[ WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS ];
+	ewf_test_write_stage_release_values_t release_values;
+	int values[ EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES ];
+
+	write_stage_t *write_stage = NULL;
+	libcerror_error_t *error   = NULL;
+	int output_index           = 0;
+	int result                 = 0;
+	int value_index            = 0;
+
+	memory_set(
+	 outputs,
+	 0,
+	 sizeof( ewf_test_write_stage_output_t ) * WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_write_stage_release_values_t ) );
+
+	for( value_index = 0;
+	     value_index < EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		values[ value_index ] = value_index;
+	}
+	/* The outputs are written at a different pace so that the reference
+	 * to a value is dropped last by varying output threads
+	 */
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		outputs[ output_index ].delay         = ( output_index + 1 ) * 1000;
+		outputs[ output_index ].failing_write = -1;
+	}
+
+	release_values.outputs           = outputs;
+	release_values.number_of_outputs = WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+
+	/* Initialize test
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_stage",
+	 write_stage );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		result = write_stage_append_output(
+		          write_stage,
+		          (intptr_t *) &( outputs[ output_index ] ),
+		          &ewf_test_write_stage_write,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		result = write_stage_push(
+		          write_stage,
+		          (intptr_t *) &( values[ value_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = write_stage_wait(
+	          write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_out_of_order_values",
+	 release_values.number_of_out_of_order_values,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_early_released_values",
+	 release_values.number_of_early_released_values,
+	 0 );
+
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "outputs[ output_index ].number_of_writes",
+		 outputs[ output_index ].number_of_writes,
+		 EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "outputs[ output_index ].number_of_out_of_order_writes",
+		 outputs[ output_index ].number_of_out_of_order_writes,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = write_stage_push(
+	          NULL,
+	          (intptr_t *) &( values[ 0 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = write_stage_join(
+	          write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_stage != NULL )
+	{
+		write_stage_free(
+		 &write_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the write_stage_push function when writing an output fails
+ * Every value must still be released exactly once
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_push_failed(
+     void )
+{
+	ewf_test_write_stage_output_t outputs[ WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS ];
+	ewf_test_write_stage_release_values_t release_values;
+	int values[ EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES ];
+
+	write_stage_t *write_stage  = NULL;
+	libcerror_error_t *error    = NULL;
+	int number_of_failed_pushes = 0;
+	int output_index            = 0;
+	int result                  = 0;
+	int value_index             = 0;
+
+	memory_set(
+	 outputs,
+	 0,
+	 sizeof( ewf_test_write_stage_output_t ) * WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS );
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_write_stage_release_values_t ) );
+
+	for( value_index = 0;
+	     value_index < EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		values[ value_index ] = value_index;
+	}
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		outputs[ output_index ].failing_write = -1;
+	}
+	outputs[ 1 ].failing_write = 16;
+
+	/* The order is not checked since values that are pushed after the failure
+	 * are released by the pushing thread
+	 */
+	release_values.outputs           = NULL;
+	release_values.number_of_outputs = 0;
+
+	/* Initialize test
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_index = 0;
+	     output_index < WRITE_STAGE_MAXIMUM_NUMBER_OF_OUTPUTS;
+	     output_index++ )
+	{
+		result = write_stage_append_output(
+		          write_stage,
+		          (intptr_t *) &( outputs[ output_index ] ),
+		          &ewf_test_write_stage_write,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	for( value_index = 0;
+	     value_index < EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES;
+	     value_index++ )
+	{
+		result = write_stage_push(
+		          write_stage,
+		          (intptr_t *) &( values[ value_index ] ),
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_free(
+			 &error );
+
+			number_of_failed_pushes++;
+		}
+	}
+	result = write_stage_wait(
+	          write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 EWF_TEST_WRITE_STAGE_NUMBER_OF_VALUES );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "outputs[ 1 ].number_of_writes",
+	 outputs[ 1 ].number_of_writes,
+	 16 );
+
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "release_values.number_of_unwritten_values",
+	 release_values.number_of_unwritten_values,
+	 0 );
+
+	/* Values pushed after the failure was detected are refused
+	 */
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "number_of_failed_pushes",
+	 number_of_failed_pushes,
+	 0 );
+
+	/* Clean up
+	 */
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_stage != NULL )
+	{
+		write_stage_free(
+		 &write_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the write_stage_release_value function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_tools_write_stage_release_value(
+     void )
+{
+	ewf_test_write_stage_release_values_t release_values;
+
+	write_stage_t *write_stage                        = NULL;
+	write_stage_value_t *write_stage_value            = NULL;
+	write_stage_value_t *referenced_write_stage_value = NULL;
+	libcerror_error_t *error                          = NULL;
+	int value                                         = 0;
+	int result                                        = 0;
+
+	memory_set(
+	 &release_values,
+	 0,
+	 sizeof( ewf_test_write_stage_release_values_t ) );
+
+	/* Initialize test
+	 */
+	result = write_stage_initialize(
+	          &write_stage,
+	          EWF_TEST_WRITE_STAGE_NUMBER_OF_QUEUED_VALUES,
+	          &ewf_test_write_stage_release,
+	          (void *) &release_values,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_stage_value = (write_stage_value_t *) memory_allocate(
+	                                             sizeof( write_stage_value_t ) );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_stage_value",
+	 write_stage_value );
+
+	write_stage_value->value                = (intptr_t *) &value;
+	write_stage_value->number_of_references = 3;
+	write_stage_value->is_written           = 1;
+
+	write_stage->number_of_pending_values = 1;
+
+	referenced_write_stage_value = write_stage_value;
+
+	/* Test regular cases
+	 */
+	result = write_stage_release_value(
+	          write_stage,
+	          &write_stage_value,
+	          1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_stage_value",
+	 write_stage_value );
+
+	/* The value is still referenced and not released
+	 */
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 0 );
+
+	/* Dropping the last references releases and frees the value, which remains
+	 * marked as not written since one of the outputs did not write it
+	 */
+	write_stage_value = referenced_write_stage_value;
+
+	referenced_write_stage_value = NULL;
+
+	result = write_stage_release_value(
+	          write_stage,
+	          &write_stage_value,
+	          2,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_stage_value",
+	 write_stage_value );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_released_values",
+	 release_values.number_of_released_values,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "release_values.number_of_unwritten_values",
+	 release_values.number_of_unwritten_values,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_stage->number_of_pending_values",
+	 write_stage->number_of_pending_values,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = write_stage_release_value(
+	          write_stage,
+	          &write_stage_value,
+	          1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_release_value(
+	          NULL,
+	          &write_stage_value,
+	          1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = write_stage_release_value(
+	          write_stage,
+	          NULL,
+	          1,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = write_stage_free(
+	          &write_stage,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( referenced_write_stage_value != NULL )
+	{
+		memory_free(
+		 referenced_write_stage_value );
+	}
+	else if( write_stage_value != NULL )
+	{
+		memory_free(
+		 write_stage_value );
+	}
+	if( write_stage != NULL )
+	{
+		write_stage_free(
+		 &write_stage,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "write_stage_initialize",
+	 ewf_test_tools_write_stage_initialize );
+
+	EWF_TEST_RUN(
+	 "write_stage_free",
+	 ewf_test_tools_write_stage_free );
+
+	EWF_TEST_RUN(
+	 "write_stage_append_output",
+	 ewf_test_tools_write_stage_append_output );
+
+	EWF_TEST_RUN(
+	 "write_stage_push",
+	 ewf_test_tools_write_stage_push );
+
+	EWF_TEST_RUN(
+	 "write_stage_push_failed",
+	 ewf_test_tools_write_stage_push_failed );
+
+	EWF_TEST_RUN(
+	 "write_stage_release_value",
+	 ewf_test_tools_write_stage_release_value );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
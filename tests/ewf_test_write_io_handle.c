@@ -2706,6 +2706,8 @@ int main(
 
 	/* TODO: add tests for libewf_write_io_handle_write_new_chunk */
 
+	/* TODO: add tests for libewf_write_io_handle_write_segment_section_corrections */
+
 	/* TODO: add tests for libewf_write_io_handle_finalize_write_sections_corrections */
 
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
@@ -1,6 +1,6 @@
 # Tests tools functions and types.
 
-$ToolsTests = "bodyfile byte_size_string device_handle digest_hash export_handle guid imaging_handle info_handle log_handle mount_path_string output path_string platform signal storage_media_buffer system_string verification_handle"
+$ToolsTests = "batch_file bodyfile buffer_limiter byte_size_string checkpoint_file device_handle digest_benchmark digest_context digest_hash digest_stage export_handle guid imaging_handle info_handle log_handle mount_path_string output path_string platform process_pool read_queue reorder_window reorder_window_mutex rescue_map sample_scheduler signal split_raw_writer stage_profiler storage_media_buffer system_resources system_string verification_handle write_stage"
 $OptionSets = "" -split " "
 
 . .\test_functions.ps1